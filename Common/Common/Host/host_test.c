@@ -0,0 +1,187 @@
+/****************************************************************************
+ *
+ * MODULE :Host Test functions source file
+ *
+ * CREATED:2026/10/19 19:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境のテストプログラムの共通関数群
+ *   Host Test functions (source file)
+ *   ・timer_util.cとframework.cの代わりにリンクし、テスト対象のモジュールが
+ *     参照する関数のみを実装する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <jendefs.h>
+
+#include "framework.h"
+#include "timer_util.h"
+#include "i2c_replay.h"
+#include "host_test.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 検査件数
+PRIVATE uint32 u32HostTest_checkCnt = 0;
+// 失敗件数
+PRIVATE uint32 u32HostTest_failCnt = 0;
+// シーケンシャルイベントの登録件数
+PRIVATE uint32 u32HostTest_evtCnt = 0;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vHostTest_check
+ *
+ * DESCRIPTION:検査結果の集計
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bResult         R   検査結果
+ *   const char*    pcFile          R   ファイル名
+ *   int            iLine           R   行番号
+ *   const char*    pcCond          R   検査条件
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vHostTest_check(bool_t bResult, const char* pcFile, int iLine, const char* pcCond) {
+	u32HostTest_checkCnt++;
+	if (!bResult) {
+		u32HostTest_failCnt++;
+		printf("%s:%d: FAILED: %s\n", pcFile, iLine, pcCond);
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: iHostTest_result
+ *
+ * DESCRIPTION:結果の表示と終了コードの取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   const char*    pcName          R   テスト名
+ *
+ * RETURNS:
+ *   int            終了コード（0：全て成功、1：失敗あり）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC int iHostTest_result(const char* pcName) {
+	printf("%s: %u checks, %u failed\n", pcName, u32HostTest_checkCnt, u32HostTest_failCnt);
+	return (u32HostTest_failCnt == 0) ? 0 : 1;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32HostTest_seqEvtCnt
+ *
+ * DESCRIPTION:登録されたシーケンシャルイベントの件数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32         iEntrySeqEvtの呼び出し回数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint32 u32HostTest_seqEvtCnt() {
+	return u32HostTest_evtCnt;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iEntrySeqEvt
+ *
+ * DESCRIPTION:シーケンシャルイベントの登録（件数の記録のみ）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   teFwkEvent     eEvt            R   イベント
+ *
+ * RETURNS:
+ *   int            イベントID
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC int iEntrySeqEvt(teFwkEvent eEvt) {
+	(void)eEvt;
+	return (int)(++u32HostTest_evtCnt);
+}
+
+/*****************************************************************************
+ *
+ * NAME: u64TimerUtil_readUsec
+ *
+ * DESCRIPTION:現在時刻の参照（i2c_replayの仮想時刻）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint64         仮想時刻（マイクロ秒）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint64 u64TimerUtil_readUsec() {
+	return u64I2CReplay_readUsec();
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32TimerUtil_waitUntil
+ *
+ * DESCRIPTION:指定時刻までの待機（仮想時刻を進める）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint64         u64JoinUsec     R   待機終了時刻（仮想時刻）
+ *
+ * RETURNS:
+ *   uint32         0固定
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint32 u32TimerUtil_waitUntil(uint64 u64JoinUsec) {
+	vI2CReplay_waitUntil(u64JoinUsec);
+	return 0;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * MODULE :Host Test functions header file
+ *
+ * CREATED:2026/10/19 19:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境のテストプログラムの共通関数群
+ *   Host Test functions (header file)
+ *   ・timer_utilとframeworkの代替（時刻はi2c_replayの仮想時刻）
+ *   ・検査マクロと結果の集計
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  HOSTTEST_H_INCLUDED
+#define  HOSTTEST_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 検査（失敗時は位置と条件を表示して失敗件数を加算）
+#define HOST_CHECK(bCond) \
+	vHostTest_check((bCond) ? TRUE : FALSE, __FILE__, __LINE__, #bCond)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+// 検査結果の集計
+PUBLIC void vHostTest_check(bool_t bResult, const char* pcFile, int iLine, const char* pcCond);
+// 結果の表示と終了コードの取得
+PUBLIC int iHostTest_result(const char* pcName);
+// 登録されたシーケンシャルイベントの件数
+PUBLIC uint32 u32HostTest_seqEvtCnt();
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* HOSTTEST_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ * MODULE :Host AppHardwareApi header file
+ *
+ * CREATED:2026/10/19 19:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ペリフェラルAPIの代替（ホスト対象のモジュールはAPIを呼び出さない）
+ *   ホスト環境でCommon/Sourceをビルドする為の最小限の代替ヘッダ
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  APPHARDWAREAPI_H_INCLUDED
+#define  APPHARDWAREAPI_H_INCLUDED
+
+#include <jendefs.h>
+
+#endif  /* APPHARDWAREAPI_H_INCLUDED */
@@ -0,0 +1,45 @@
+/****************************************************************************
+ *
+ * MODULE :Host ToCoNet header file
+ *
+ * CREATED:2026/10/19 19:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ToCoNetの代替（framework.hが参照する定義のみ）
+ *   ホスト環境でCommon/Sourceをビルドする為の最小限の代替ヘッダ
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  TOCONET_H_INCLUDED
+#define  TOCONET_H_INCLUDED
+
+#include <jendefs.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// アプリケーションのイベント番号の開始値
+#define ToCoNet_EVENT_APP_BASE     (0x100)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// シリアル出力ストリーム
+typedef struct {
+	uint8 u8Device;
+} tsFILE;
+
+// シリアルポート設定
+typedef struct {
+	uint8 u8SerialPort;
+} tsSerialPortSetup;
+
+#endif  /* TOCONET_H_INCLUDED */
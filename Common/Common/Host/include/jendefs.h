@@ -0,0 +1,52 @@
+/****************************************************************************
+ *
+ * MODULE :Host jendefs header file
+ *
+ * CREATED:2026/10/19 19:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   SDKの基本型定義の代替
+ *   ホスト環境でCommon/Sourceをビルドする為の最小限の代替ヘッダ
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  JENDEFS_H_INCLUDED
+#define  JENDEFS_H_INCLUDED
+
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+#ifndef TRUE
+#define TRUE                       (1)
+#endif
+#ifndef FALSE
+#define FALSE                      (0)
+#endif
+#define PUBLIC
+#define PRIVATE                    static
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+typedef int8_t   int8;
+typedef int16_t  int16;
+typedef int32_t  int32;
+typedef int64_t  int64;
+typedef uint8    bool_t;
+
+#endif  /* JENDEFS_H_INCLUDED */
@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ * MODULE :Host utils header file
+ *
+ * CREATED:2026/10/19 19:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ToCoNet SDKのutils.hの代替（定義無し）
+ *   ホスト環境でCommon/Sourceをビルドする為の最小限の代替ヘッダ
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  UTILS_H_INCLUDED
+#define  UTILS_H_INCLUDED
+
+#include <ToCoNet.h>
+
+#endif  /* UTILS_H_INCLUDED */
@@ -0,0 +1,288 @@
+/****************************************************************************
+ *
+ * MODULE :EEPROM test source file
+ *
+ * CREATED:2026/10/19 20:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   eeprom.cの一括読み込みと先読みのホスト環境のテスト（EEPROMシミュレータ使用）
+ *   ・読み書き、ページキャッシュの先読み、先読みストリーム、キャッシュの破棄を
+ *     ランダムに実行し、参照用のメモリと比較する
+ *   ・ページキャッシュの有無と、直接通信／I2Cスケジューラ経由の組み合わせで実行する
+ *   ・先読みストリームによる全レコードの走査の読み込みトランザクション数
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <jendefs.h>
+
+#include "i2c_util.h"
+#include "i2c_sched.h"
+#include "i2c_recorder.h"
+#include "i2c_replay.h"
+#include "eeprom.h"
+#include "eeprom_sim.h"
+#include "host_test.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// EEPROMシミュレータのI2Cアドレス
+#define TEST_EEPROM_ADDRESS        (0x50)
+// EEPROMシミュレータのメモリサイズ
+#define TEST_EEPROM_SIZE           (0x8000)
+// EEPROMシミュレータのページサイズ
+#define TEST_EEPROM_PAGE_SIZE      (64)
+// EEPROMシミュレータのバッキングファイル
+#define TEST_EEPROM_PATH           "test_eeprom.bin"
+// ランダム操作の回数（組み合わせ毎）
+#ifndef TEST_EEPROM_ITERATIONS
+	#define TEST_EEPROM_ITERATIONS (50000)
+#endif
+// 先読みストリームのレコード領域
+#define TEST_STREAM_TOP            (0x0080)
+#define TEST_STREAM_REC_SIZE       (128)
+#define TEST_STREAM_REC_CNT        (32)
+// 先読みストリームのバッファのレコード数
+#define TEST_STREAM_WIN_CNT        (4)
+// ランダムな読み書きの最大長
+#define TEST_READ_MAX              (600)
+#define TEST_WRITE_MAX             (100)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 参照用のメモリ
+PRIVATE uint8 u8TestRef[TEST_EEPROM_SIZE];
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// EEPROMシミュレータとeeprom.cの初期化
+PRIVATE bool_t bTest_open(tsEEPROMSim* psSim, tsEEPROM_status* psStatus, bool_t bCacheFlg, bool_t bSchedFlg);
+// ランダム操作と参照用のメモリの比較
+PRIVATE void vTest_random(bool_t bCacheFlg, bool_t bSchedFlg);
+// 先読みストリームによる全レコードの走査
+PRIVATE void vTest_streamScan(bool_t bCacheFlg, bool_t bSchedFlg);
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+int main() {
+	int iMode;
+	for (iMode = 0; iMode < 4; iMode++) {
+		vTest_random((iMode & 0x01) != 0, (iMode & 0x02) != 0);
+		vTest_streamScan((iMode & 0x01) != 0, (iMode & 0x02) != 0);
+	}
+	unlink(TEST_EEPROM_PATH);
+	return iHostTest_result("test_eeprom");
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: bTest_open
+ *
+ * DESCRIPTION:EEPROMシミュレータとeeprom.cの初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           W   EEPROMシミュレータ
+ *   tsEEPROM_status* psStatus      W   デバイスステータス情報
+ *   bool_t         bCacheFlg       R   ページキャッシュ使用フラグ
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:初期化成功
+ *
+ * NOTES:
+ * EEPROMと参照用のメモリは同じ乱数で初期化する
+ *****************************************************************************/
+PRIVATE bool_t bTest_open(tsEEPROMSim* psSim, tsEEPROM_status* psStatus, bool_t bCacheFlg, bool_t bSchedFlg) {
+	vI2CReplay_init();
+	unlink(TEST_EEPROM_PATH);
+	if (!bEEPROMSim_open(psSim, TEST_EEPROM_PATH, TEST_EEPROM_ADDRESS,
+			TEST_EEPROM_SIZE, TEST_EEPROM_PAGE_SIZE, 2)) {
+		return FALSE;
+	}
+	int iIdx;
+	for (iIdx = 0; iIdx < TEST_EEPROM_SIZE; iIdx++) {
+		u8TestRef[iIdx] = (uint8)rand();
+	}
+	memcpy(psSim->pu8Mem, u8TestRef, TEST_EEPROM_SIZE);
+	// I2Cスケジューラ
+	vI2CSched_init(NULL, NULL);
+	uint8 u8DevIdx = I2C_SCHED_DEVICE_NONE;
+	if (bSchedFlg) {
+		int iDevIdx = iI2CSched_registDevice("EEPROM", TEST_EEPROM_ADDRESS,
+				I2C_SCHED_PRIORITY_NORMAL, I2C_SCHED_BUS_NONE);
+		HOST_CHECK(iDevIdx >= 0);
+		u8DevIdx = (uint8)iDevIdx;
+	}
+	vEEPROM_setSchedDevice(u8DevIdx);
+	// デバイス選択
+	memset(psStatus, 0x00, sizeof(tsEEPROM_status));
+	psStatus->u8DevAddress  = TEST_EEPROM_ADDRESS;
+	psStatus->b2ByteAddrFlg = TRUE;
+	psStatus->u8PageSize    = TEST_EEPROM_PAGE_SIZE;
+	psStatus->bCacheFlg     = bCacheFlg;
+	return bEEPROM_deviceSelect(psStatus);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_random
+ *
+ * DESCRIPTION:ランダム操作と参照用のメモリの比較
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bCacheFlg       R   ページキャッシュ使用フラグ
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 書き込みの後は先読みストリームの内容が破棄され、読み込み結果が常に
+ * 最新の書き込み内容と一致する事を確認する
+ *****************************************************************************/
+PRIVATE void vTest_random(bool_t bCacheFlg, bool_t bSchedFlg) {
+	tsEEPROMSim sSim;
+	tsEEPROM_status sStatus;
+	tsEEPROM_stream sStream;
+	uint8 u8StreamBuff[TEST_STREAM_REC_SIZE * TEST_STREAM_WIN_CNT];
+	uint8 u8Buff[TEST_READ_MAX];
+	uint32 u32ReadErr = 0;
+	uint32 u32StreamErr = 0;
+	uint16 u16Addr;
+	uint16 u16Len;
+	uint16 u16Idx;
+	int iCnt;
+	srand(7);
+	HOST_CHECK(bTest_open(&sSim, &sStatus, bCacheFlg, bSchedFlg));
+	vEEPROM_streamInit(&sStream, TEST_STREAM_TOP, TEST_STREAM_REC_SIZE, TEST_STREAM_REC_CNT,
+			u8StreamBuff, sizeof(u8StreamBuff));
+	for (iCnt = 0; iCnt < TEST_EEPROM_ITERATIONS; iCnt++) {
+		int iOp = rand() % 10;
+		if (iOp == 0) {
+			// 書き込み
+			u16Addr = (uint16)(rand() % (TEST_EEPROM_SIZE - TEST_READ_MAX));
+			u16Len  = (uint16)(1 + rand() % TEST_WRITE_MAX);
+			for (u16Idx = 0; u16Idx < u16Len; u16Idx++) {
+				u8Buff[u16Idx] = (uint8)rand();
+			}
+			HOST_CHECK(bEEPROM_writeData(u16Addr, u16Len, u8Buff));
+			memcpy(&u8TestRef[u16Addr], u8Buff, u16Len);
+		} else if (iOp == 1) {
+			// 読み込み（255バイトを超える読み込みを含む）
+			u16Addr = (uint16)(rand() % (TEST_EEPROM_SIZE - TEST_READ_MAX));
+			u16Len  = (uint16)(1 + rand() % TEST_READ_MAX);
+			if (!bEEPROM_readData(u16Addr, u16Len, u8Buff) || memcmp(u8Buff, &u8TestRef[u16Addr], u16Len) != 0) {
+				u32ReadErr++;
+			}
+		} else if (iOp <= 6) {
+			// 先読みストリームの読み込み
+			u16Idx = (uint16)(rand() % TEST_STREAM_REC_CNT);
+			bool_t bForwardFlg = (rand() % 2) != 0;
+			if (!bEEPROM_streamRead(&sStream, u16Idx, bForwardFlg, u8Buff)
+					|| memcmp(u8Buff, &u8TestRef[TEST_STREAM_TOP + TEST_STREAM_REC_SIZE * u16Idx], TEST_STREAM_REC_SIZE) != 0) {
+				u32StreamErr++;
+			}
+		} else if (iOp == 7) {
+			// 先読みストリームの先読み
+			u16Idx = (uint16)(rand() % TEST_STREAM_REC_CNT);
+			bEEPROM_streamPrefetch(&sStream, u16Idx, (rand() % 2) != 0);
+		} else if (iOp == 8) {
+			// ページキャッシュの先読み
+			u16Addr = (uint16)(rand() % (TEST_EEPROM_SIZE - TEST_READ_MAX));
+			bEEPROM_prefetch(u16Addr, (uint16)(1 + rand() % 200));
+		} else {
+			// 書き込みの確定とキャッシュの破棄
+			HOST_CHECK(bEEPROM_commit());
+			if (rand() % 2) {
+				vEEPROM_cacheInvalidate();
+			}
+		}
+	}
+	HOST_CHECK(bEEPROM_commit());
+	HOST_CHECK(u32ReadErr == 0);
+	HOST_CHECK(u32StreamErr == 0);
+	HOST_CHECK(memcmp(sSim.pu8Mem, u8TestRef, TEST_EEPROM_SIZE) == 0);
+	HOST_CHECK(sSim.sStats.u32WrapCnt == 0);
+	printf("random cache=%d sched=%d: stream read=%u hit=%u fill=%u\n", bCacheFlg, bSchedFlg,
+			sStream.u32ReadCnt, sStream.u32HitCnt, sStream.u32FillCnt);
+	vEEPROMSim_close(&sSim);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_streamScan
+ *
+ * DESCRIPTION:先読みストリームによる全レコードの走査
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bCacheFlg       R   ページキャッシュ使用フラグ
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 読み込みトランザクション（アドレス書き込みとリピートスタート）の数は
+ * 先読みバッファのレコード数単位となる
+ *****************************************************************************/
+PRIVATE void vTest_streamScan(bool_t bCacheFlg, bool_t bSchedFlg) {
+	tsEEPROMSim sSim;
+	tsEEPROM_status sStatus;
+	tsEEPROM_stream sStream;
+	uint8 u8StreamBuff[TEST_STREAM_REC_SIZE * TEST_STREAM_WIN_CNT];
+	uint8 u8Rec[TEST_STREAM_REC_SIZE];
+	uint32 u32Err = 0;
+	uint16 u16Idx;
+	srand(11);
+	HOST_CHECK(bTest_open(&sSim, &sStatus, bCacheFlg, bSchedFlg));
+	vEEPROM_streamInit(&sStream, TEST_STREAM_TOP, TEST_STREAM_REC_SIZE, TEST_STREAM_REC_CNT,
+			u8StreamBuff, sizeof(u8StreamBuff));
+	vI2CRec_start();
+	for (u16Idx = 0; u16Idx < TEST_STREAM_REC_CNT; u16Idx++) {
+		if (!bEEPROM_streamRead(&sStream, u16Idx, TRUE, u8Rec)
+				|| memcmp(u8Rec, &u8TestRef[TEST_STREAM_TOP + TEST_STREAM_REC_SIZE * u16Idx], TEST_STREAM_REC_SIZE) != 0) {
+			u32Err++;
+		}
+	}
+	vI2CRec_stop();
+	const tsI2C_RecSummary* psSummary = psI2CRec_getSummary();
+	HOST_CHECK(u32Err == 0);
+	HOST_CHECK(psSummary->u32ErrCnt == 0);
+	HOST_CHECK(psSummary->u32WriteBytes == psSummary->u32StartCnt);
+	HOST_CHECK(psSummary->u32StartCnt / 2 == TEST_STREAM_REC_CNT / TEST_STREAM_WIN_CNT);
+	HOST_CHECK(psSummary->u32ReadBytes == TEST_STREAM_REC_SIZE * TEST_STREAM_REC_CNT);
+	HOST_CHECK(sStream.u32FillCnt == TEST_STREAM_REC_CNT / TEST_STREAM_WIN_CNT);
+	vEEPROMSim_close(&sSim);
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,324 @@
+/****************************************************************************
+ *
+ * MODULE :I2C Replay test source file
+ *
+ * CREATED:2026/10/19 19:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   i2c_replay、i2c_recorder、eeprom_simのホスト環境のテスト
+ *   ・読み込みの終端ACK/NACK返信
+ *   ・非同期トランザクションのアドレスNACK
+ *   ・記録した通信のスクリプトによる再生
+ *   ・EEPROMシミュレータの書き込みサイクルとeeprom.cの読み書き
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <jendefs.h>
+
+#include "i2c_util.h"
+#include "i2c_recorder.h"
+#include "i2c_replay.h"
+#include "eeprom.h"
+#include "eeprom_sim.h"
+#include "host_test.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// メモリ型デバイスモデルのI2Cアドレス
+#define TEST_MEM_ADDRESS           (0x3C)
+// EEPROMシミュレータのI2Cアドレス
+#define TEST_EEPROM_ADDRESS        (0x50)
+// 応答するデバイスが無いI2Cアドレス
+#define TEST_ABSENT_ADDRESS        (0x20)
+// EEPROMシミュレータのバッキングファイル
+#define TEST_EEPROM_PATH           "test_i2c_replay.bin"
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// メモリ型デバイスモデルのメモリ
+PRIVATE uint8 u8TestMem[256];
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// メモリ型デバイスモデルの初期化
+PRIVATE void vTest_initMem();
+// 同期処理によるメモリアドレスの指定と読み込み開始
+PRIVATE void vTest_startMemRead(uint8 u8MemAddr);
+// 読み込みの終端ACK/NACK返信
+PRIVATE void vTest_readAckEnd();
+// 非同期トランザクションのアドレスNACK
+PRIVATE void vTest_trnsAddrNack();
+// 記録した通信のスクリプトによる再生
+PRIVATE void vTest_script();
+// EEPROMシミュレータ
+PRIVATE void vTest_eepromSim();
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+int main() {
+	vTest_readAckEnd();
+	vTest_trnsAddrNack();
+	vTest_script();
+	vTest_eepromSim();
+	return iHostTest_result("test_i2c_replay");
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vTest_initMem
+ *
+ * DESCRIPTION:メモリ型デバイスモデルの初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * メモリの内容はアドレスと同じ値
+ *****************************************************************************/
+PRIVATE void vTest_initMem() {
+	int iIdx;
+	for (iIdx = 0; iIdx < (int)sizeof(u8TestMem); iIdx++) {
+		u8TestMem[iIdx] = (uint8)iIdx;
+	}
+	vI2CReplay_init();
+	HOST_CHECK(bI2CReplay_registMemModel(TEST_MEM_ADDRESS, u8TestMem, sizeof(u8TestMem), 1));
+	vI2CRec_start();
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_startMemRead
+ *
+ * DESCRIPTION:同期処理によるメモリアドレスの指定と読み込み開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8MemAddr       R   メモリアドレス
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vTest_startMemRead(uint8 u8MemAddr) {
+	HOST_CHECK(bI2C_startWrite(TEST_MEM_ADDRESS));
+	HOST_CHECK(u8I2C_write(u8MemAddr) == I2CUTIL_STS_ACK);
+	HOST_CHECK(bI2C_startRead(TEST_MEM_ADDRESS));
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_readAckEnd
+ *
+ * DESCRIPTION:読み込みの終端ACK/NACK返信
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ACK返信で終えた読み込みは継続出来て、NACK返信で終えた読み込みを開始条件無しで
+ * 継続した場合はバスが解放されている（0xFF、エラー記録、デバイスのアドレスは不変）
+ *****************************************************************************/
+PRIVATE void vTest_readAckEnd() {
+	uint8 u8Buff[4];
+	vTest_initMem();
+	// ACK返信で終えた読み込みの継続
+	vTest_startMemRead(0x10);
+	HOST_CHECK(bI2C_read(&u8Buff[0], 2, TRUE));
+	HOST_CHECK(bI2C_read(&u8Buff[2], 2, FALSE));
+	HOST_CHECK(bI2C_stopNACK());
+	HOST_CHECK(u8Buff[0] == 0x10 && u8Buff[1] == 0x11 && u8Buff[2] == 0x12 && u8Buff[3] == 0x13);
+	HOST_CHECK(psI2CRec_getSummary()->u32ErrCnt == 0);
+	// NACK返信で終えた読み込みの継続
+	vTest_startMemRead(0x20);
+	HOST_CHECK(bI2C_read(&u8Buff[0], 1, FALSE));
+	HOST_CHECK(bI2C_read(&u8Buff[1], 2, FALSE) == FALSE);
+	HOST_CHECK(bI2C_stopNACK());
+	HOST_CHECK(u8Buff[0] == 0x20 && u8Buff[1] == 0xFF && u8Buff[2] == 0xFF);
+	HOST_CHECK(psI2CRec_getSummary()->u32ErrCnt == 2);
+	// 開始条件で読み込みを再開（アドレスは進んでいない）
+	HOST_CHECK(bI2C_startRead(TEST_MEM_ADDRESS));
+	HOST_CHECK(bI2C_read(&u8Buff[0], 1, FALSE));
+	HOST_CHECK(bI2C_stopNACK());
+	HOST_CHECK(u8Buff[0] == 0x21);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_trnsAddrNack
+ *
+ * DESCRIPTION:非同期トランザクションのアドレスNACK
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 書き込みデータの無いトランザクション（ACKポーリング）もアドレスのNACKを通知する
+ *****************************************************************************/
+PRIVATE void vTest_trnsAddrNack() {
+	uint8 u8Addr = 0x30;
+	uint8 u8Buff[3];
+	tsI2C_Trns sTrns;
+	vTest_initMem();
+	// アドレスのみ
+	memset(&sTrns, 0x00, sizeof(tsI2C_Trns));
+	sTrns.u8Address   = TEST_ABSENT_ADDRESS;
+	sTrns.u8PreScaler = I2C_PRESCALER_DEFAULT;
+	sTrns.eCompEvt    = E_EVENT_FWK_EMPTY;
+	HOST_CHECK(u8I2C_execTrns(&sTrns) == I2CUTIL_STS_NACK);
+	sTrns.u8Address   = TEST_MEM_ADDRESS;
+	HOST_CHECK(u8I2C_execTrns(&sTrns) == I2CUTIL_STS_ACK);
+	// 書き込みと読み込み
+	sTrns.pu8WriteData = &u8Addr;
+	sTrns.u16WriteLen  = 1;
+	sTrns.pu8ReadData  = u8Buff;
+	sTrns.u16ReadLen   = sizeof(u8Buff);
+	HOST_CHECK(u8I2C_execTrns(&sTrns) == I2CUTIL_STS_ACK);
+	HOST_CHECK(u8Buff[0] == 0x30 && u8Buff[1] == 0x31 && u8Buff[2] == 0x32);
+	// 読み込みのみ
+	sTrns.u8Address   = TEST_ABSENT_ADDRESS;
+	sTrns.u16WriteLen = 0;
+	HOST_CHECK(u8I2C_execTrns(&sTrns) == I2CUTIL_STS_NACK);
+	sTrns.u8Address   = TEST_MEM_ADDRESS;
+	HOST_CHECK(u8I2C_execTrns(&sTrns) == I2CUTIL_STS_ACK);
+	HOST_CHECK(u8Buff[0] == 0x33 && u8Buff[2] == 0x35);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_script
+ *
+ * DESCRIPTION:記録した通信のスクリプトによる再生
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * デバイスモデル無しでも記録した読み込みデータで応答し、通信が異なれば不一致となる
+ *****************************************************************************/
+PRIVATE void vTest_script() {
+	static tsI2C_Record sScript[I2C_RECORD_SIZE];
+	uint8 u8Buff[4];
+	uint16 u16Cnt;
+	uint16 u16Idx;
+	// 記録
+	vTest_initMem();
+	vTest_startMemRead(0x40);
+	bI2C_read(u8Buff, sizeof(u8Buff), FALSE);
+	bI2C_stopNACK();
+	vI2CRec_stop();
+	u16Cnt = u16I2CRec_count();
+	for (u16Idx = 0; u16Idx < u16Cnt; u16Idx++) {
+		sScript[u16Idx] = *psI2CRec_get(u16Idx);
+	}
+	// デバイスモデル無しで再生
+	vI2CReplay_init();
+	vI2CReplay_loadScript(sScript, u16Cnt);
+	memset(u8Buff, 0x00, sizeof(u8Buff));
+	vTest_startMemRead(0x40);
+	HOST_CHECK(bI2C_read(u8Buff, sizeof(u8Buff), FALSE));
+	bI2C_stopNACK();
+	HOST_CHECK(u8Buff[0] == 0x40 && u8Buff[3] == 0x43);
+	HOST_CHECK(u32I2CReplay_getMismatch() == 0);
+	// 異なる通信の再生
+	vI2CReplay_loadScript(sScript, u16Cnt);
+	vTest_startMemRead(0x41);
+	bI2C_read(u8Buff, sizeof(u8Buff), FALSE);
+	bI2C_stopNACK();
+	HOST_CHECK(u32I2CReplay_getMismatch() == 1);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_eepromSim
+ *
+ * DESCRIPTION:EEPROMシミュレータ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 書き込みサイクル中はアドレスにNACK応答し、eeprom.cの読み書きはACKポーリングで
+ * 書き込みサイクルを待って整合する
+ *****************************************************************************/
+PRIVATE void vTest_eepromSim() {
+	tsEEPROMSim sSim;
+	tsEEPROM_status sStatus;
+	tsI2C_Trns sTrns;
+	uint8 u8Data[200];
+	uint8 u8Buff[200];
+	int iIdx;
+	vI2CReplay_init();
+	unlink(TEST_EEPROM_PATH);
+	HOST_CHECK(bEEPROMSim_open(&sSim, TEST_EEPROM_PATH, TEST_EEPROM_ADDRESS, 0x8000, 64, 2));
+	// 直接の書き込みで書き込みサイクルを開始
+	HOST_CHECK(bI2C_startWrite(TEST_EEPROM_ADDRESS));
+	HOST_CHECK(u8I2C_write(0x00) == I2CUTIL_STS_ACK);
+	HOST_CHECK(u8I2C_write(0x00) == I2CUTIL_STS_ACK);
+	HOST_CHECK(u8I2C_writeStop(0xA5) == I2CUTIL_STS_ACK);
+	// 書き込みサイクル中のACKポーリング
+	memset(&sTrns, 0x00, sizeof(tsI2C_Trns));
+	sTrns.u8Address   = TEST_EEPROM_ADDRESS;
+	sTrns.u8PreScaler = I2C_PRESCALER_DEFAULT;
+	sTrns.eCompEvt    = E_EVENT_FWK_EMPTY;
+	HOST_CHECK(u8I2C_execTrns(&sTrns) == I2CUTIL_STS_NACK);
+	HOST_CHECK(sSim.sStats.u32BusyNackCnt == 1);
+	vI2CReplay_waitUntil(u64I2CReplay_readUsec() + EEPROM_SIM_CYCLE_USEC);
+	HOST_CHECK(u8I2C_execTrns(&sTrns) == I2CUTIL_STS_ACK);
+	HOST_CHECK(sSim.pu8Mem[0] == 0xA5 && sSim.sStats.u32CycleCnt == 1);
+	// eeprom.cによるページ跨ぎの読み書き
+	memset(&sStatus, 0x00, sizeof(tsEEPROM_status));
+	sStatus.u8DevAddress  = TEST_EEPROM_ADDRESS;
+	sStatus.b2ByteAddrFlg = TRUE;
+	sStatus.u8PageSize    = 64;
+	HOST_CHECK(bEEPROM_deviceSelect(&sStatus));
+	for (iIdx = 0; iIdx < (int)sizeof(u8Data); iIdx++) {
+		u8Data[iIdx] = (uint8)(iIdx * 7 + 1);
+	}
+	HOST_CHECK(bEEPROM_writeData(0x0030, sizeof(u8Data), u8Data));
+	HOST_CHECK(bEEPROM_commit());
+	HOST_CHECK(bEEPROM_readData(0x0030, sizeof(u8Buff), u8Buff));
+	HOST_CHECK(memcmp(u8Buff, u8Data, sizeof(u8Data)) == 0);
+	HOST_CHECK(memcmp(&sSim.pu8Mem[0x0030], u8Data, sizeof(u8Data)) == 0);
+	HOST_CHECK(sSim.sStats.u32WrapCnt == 0);
+	vEEPROMSim_close(&sSim);
+	unlink(TEST_EEPROM_PATH);
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,269 @@
+/****************************************************************************
+ *
+ * MODULE :Log Query test source file
+ *
+ * CREATED:2026/10/19 21:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   log_queryのホスト環境のテスト（EEPROMシミュレータ使用）
+ *   ・追記、消去、再復元を挟みながら、分類と日付、範囲のランダムな検索を行い、
+ *     iLogRing_readによる全件走査の結果と比較する
+ *   ・集計情報による読み込みの省略（検索毎のブロック読み込み回数）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <jendefs.h>
+
+#include "i2c_replay.h"
+#include "eeprom.h"
+#include "eeprom_sim.h"
+#include "log_ring.h"
+#include "log_query.h"
+#include "host_test.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// EEPROMシミュレータのI2Cアドレス
+#define TEST_EEPROM_ADDRESS        (0x50)
+// EEPROMシミュレータのバッキングファイル
+#define TEST_EEPROM_PATH           "test_log_query.bin"
+// ログリングの配置（Managerのイベントログと同じ構成）
+#define TEST_LOG_TOP               (0x1080)
+#define TEST_LOG_BLOCK_CNT         (32)
+#define TEST_LOG_BLOCK_SIZE        (64)
+#define TEST_LOG_DATA_SIZE         (3)
+// 分類のマスクとキー無効フラグ（データの先頭バイト）
+#define TEST_LOG_CLASS_MASK        (0x7F)
+#define TEST_LOG_KEY_INVALID       (0x80)
+// 分類の数（1〜）
+#define TEST_LOG_CLASS_CNT         (21)
+// 繰り返し回数（繰り返し毎に3回検索）
+#ifndef TEST_LOG_ITERATIONS
+	#define TEST_LOG_ITERATIONS    (20000)
+#endif
+#define TEST_LOG_QUERY_CNT         (3)
+// 検索毎のブロック読み込み回数の上限（平均）
+#define TEST_LOG_READ_PER_QUERY    (1.5)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 全件走査による検索
+PRIVATE int iTest_bruteFind(tsLogRing* psRing, const tsLogQueryCond* psCond, uint16 u16Pos, bool_t bForwardFlg);
+// ランダムな検索条件の編集
+PRIVATE void vTest_randomCond(tsLogQueryCond* psCond, uint32 u32Key);
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+int main() {
+	tsEEPROMSim sSim;
+	tsEEPROM_status sStatus;
+	tsLogRing sRing;
+	tsLogQuery sQuery;
+	tsLogQueryCond sCond;
+	uint32 u32Key = 100000000;
+	uint32 u32Mismatch = 0;
+	uint32 u32QueryCnt = 0;
+	uint32 u32ReadCnt = 0;
+	uint32 u32FoundCnt = 0;
+	int iCnt;
+	int iIdx;
+	srand(1);
+	// EEPROMシミュレータとログリング
+	vI2CReplay_init();
+	unlink(TEST_EEPROM_PATH);
+	HOST_CHECK(bEEPROMSim_open(&sSim, TEST_EEPROM_PATH, TEST_EEPROM_ADDRESS, 0x8000, 64, 2));
+	memset(&sStatus, 0x00, sizeof(tsEEPROM_status));
+	sStatus.u8DevAddress  = TEST_EEPROM_ADDRESS;
+	sStatus.b2ByteAddrFlg = TRUE;
+	sStatus.u8PageSize    = 64;
+	sStatus.bCacheFlg     = TRUE;
+	HOST_CHECK(bEEPROM_deviceSelect(&sStatus));
+	vLogRing_init(&sRing, TEST_LOG_TOP, TEST_LOG_BLOCK_CNT, TEST_LOG_BLOCK_SIZE, TEST_LOG_DATA_SIZE, FALSE);
+	HOST_CHECK(bLogRing_recover(&sRing));
+	vLogQuery_init(&sQuery, &sRing, 0, TEST_LOG_CLASS_MASK, TEST_LOG_KEY_INVALID);
+	for (iCnt = 0; iCnt < TEST_LOG_ITERATIONS; iCnt++) {
+		// 追記（時々日を跨ぐ、時刻の無いエントリを含む）
+		int iAppendCnt = rand() % 5;
+		for (iIdx = 0; iIdx < iAppendCnt; iIdx++) {
+			u32Key += rand() % ((rand() % 4 == 0) ? 200000 : 3000);
+			uint8 u8Data[TEST_LOG_DATA_SIZE];
+			u8Data[0] = (uint8)(1 + rand() % TEST_LOG_CLASS_CNT);
+			u8Data[1] = (uint8)rand();
+			u8Data[2] = (uint8)rand();
+			uint32 u32AppendKey = u32Key;
+			if (rand() % 10 == 0) {
+				u8Data[0] |= TEST_LOG_KEY_INVALID;
+				u32AppendKey = LOG_RING_KEY_NONE;
+			}
+			HOST_CHECK(iLogRing_append(&sRing, u32AppendKey, u8Data, TEST_LOG_DATA_SIZE) >= 0);
+		}
+		// 消去
+		if (rand() % 500 == 0) {
+			HOST_CHECK(bLogRing_clear(&sRing));
+		}
+		// 再復元（デバイスの再選択相当）
+		if (rand() % 300 == 0) {
+			HOST_CHECK(bEEPROM_commit());
+			vEEPROM_cacheInvalidate();
+			HOST_CHECK(bLogRing_recover(&sRing));
+			if (rand() % 2) {
+				vLogQuery_invalidate(&sQuery);
+			}
+		}
+		// 検索と全件走査の比較
+		for (iIdx = 0; iIdx < TEST_LOG_QUERY_CNT; iIdx++) {
+			vTest_randomCond(&sCond, u32Key);
+			uint16 u16Pos = (uint16)(rand() % 300);
+			bool_t bForwardFlg = (rand() % 2) != 0;
+			uint32 u32FindKey;
+			uint8 u8FindData[TEST_LOG_DATA_SIZE];
+			uint32 u32BefRead = sQuery.u32ReadCnt;
+			int iFind = iLogQuery_find(&sQuery, &sCond, u16Pos, bForwardFlg,
+					&u32FindKey, u8FindData, TEST_LOG_DATA_SIZE, NULL);
+			u32ReadCnt += sQuery.u32ReadCnt - u32BefRead;
+			u32QueryCnt++;
+			int iBrute = iTest_bruteFind(&sRing, &sCond, u16Pos, bForwardFlg);
+			if (iFind != iBrute) {
+				u32Mismatch++;
+			} else if (iFind >= 0) {
+				uint32 u32BruteKey;
+				uint8 u8BruteData[TEST_LOG_DATA_SIZE];
+				iLogRing_read(&sRing, (uint16)iBrute, &u32BruteKey, u8BruteData, TEST_LOG_DATA_SIZE, NULL);
+				if (u32FindKey != u32BruteKey || memcmp(u8FindData, u8BruteData, TEST_LOG_DATA_SIZE) != 0) {
+					u32Mismatch++;
+				}
+				u32FoundCnt++;
+			}
+		}
+	}
+	HOST_CHECK(u32Mismatch == 0);
+	HOST_CHECK(u32FoundCnt > 0 && u32FoundCnt < u32QueryCnt);
+	HOST_CHECK((double)u32ReadCnt / u32QueryCnt < TEST_LOG_READ_PER_QUERY);
+	printf("queries=%u found=%u block reads/query=%.2f skipped=%u\n", u32QueryCnt, u32FoundCnt,
+			(double)u32ReadCnt / u32QueryCnt, sQuery.u32SkipCnt);
+	vEEPROMSim_close(&sSim);
+	unlink(TEST_EEPROM_PATH);
+	return iHostTest_result("test_log_query");
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: iTest_bruteFind
+ *
+ * DESCRIPTION:全件走査による検索
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   tsLogQueryCond* psCond         R   検索条件
+ *   uint16         u16Pos          R   探索開始エントリ位置
+ *   bool_t         bForwardFlg     R   順方向探索フラグ
+ *
+ * RETURNS:
+ *   int            一致したエントリ位置、-3:対象データなし
+ *
+ * NOTES:
+ * iLogQuery_findと同じ仕様を、エントリ毎のiLogRing_readで実装する
+ *****************************************************************************/
+PRIVATE int iTest_bruteFind(tsLogRing* psRing, const tsLogQueryCond* psCond, uint16 u16Pos, bool_t bForwardFlg) {
+	int iCnt = psRing->u16Cnt;
+	int iPos = u16Pos;
+	if (iCnt == 0) {
+		return -3;
+	}
+	if (iPos >= iCnt) {
+		if (bForwardFlg) {
+			return -3;
+		}
+		iPos = iCnt - 1;
+	}
+	for (; iPos >= 0 && iPos < iCnt; iPos += bForwardFlg ? 1 : -1) {
+		uint32 u32Key;
+		uint8 u8Data[TEST_LOG_DATA_SIZE];
+		if (iLogRing_read(psRing, (uint16)iPos, &u32Key, u8Data, TEST_LOG_DATA_SIZE, NULL) < 0) {
+			continue;
+		}
+		if ((psCond->u32ClassMap & LOG_QUERY_CLASS_BIT(u8Data[0] & TEST_LOG_CLASS_MASK)) == 0) {
+			continue;
+		}
+		if (psCond->u16DayFrom != LOG_QUERY_DAY_NONE) {
+			if (u8Data[0] & TEST_LOG_KEY_INVALID) {
+				continue;
+			}
+			uint16 u16Day = LOG_QUERY_KEY_TO_DAY(u32Key);
+			if (u16Day < psCond->u16DayFrom || u16Day > psCond->u16DayTo) {
+				continue;
+			}
+		}
+		return iPos;
+	}
+	return -3;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_randomCond
+ *
+ * DESCRIPTION:ランダムな検索条件の編集
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQueryCond* psCond         W   検索条件
+ *   uint32         u32Key          R   最新のキー
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 分類のみ、1日の全分類、数日の一部分類のいずれか
+ *****************************************************************************/
+PRIVATE void vTest_randomCond(tsLogQueryCond* psCond, uint32 u32Key) {
+	uint16 u16Day = LOG_QUERY_KEY_TO_DAY(u32Key) - rand() % 30;
+	switch (rand() % 3) {
+	case 0:
+		vLogQuery_setCond(psCond, LOG_QUERY_DAY_NONE, LOG_QUERY_DAY_NONE,
+				LOG_QUERY_CLASS_BIT(1 + rand() % TEST_LOG_CLASS_CNT) | LOG_QUERY_CLASS_BIT(1 + rand() % TEST_LOG_CLASS_CNT));
+		break;
+	case 1:
+		vLogQuery_setCond(psCond, u16Day, u16Day, LOG_QUERY_CLASS_ALL);
+		break;
+	default:
+		vLogQuery_setCond(psCond, u16Day, u16Day + rand() % 3, 0x00F0F0F0);
+		break;
+	}
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
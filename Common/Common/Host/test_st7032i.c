@@ -0,0 +1,919 @@
+/****************************************************************************
+ *
+ * MODULE :ST7032i LCD test source file
+ *
+ * CREATED:2026/10/19 23:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   st7032i.cの差分描画のホスト環境のテスト（LCDモデル使用）
+ *   ・LCDモデルは制御バイトとコマンド、データを解釈してDDRAMとアドレスカウンタを
+ *     再現し、送信バイト数とコマンド実行時間の違反、トランザクションの形式の誤りを数える
+ *   ・一致区間の連結、カーソル移動の省略、行の終端での折り返し、
+ *     表示内容の写しとDDRAMの一致、描画毎の送信バイト数
+ *   ・非同期実行のキューの詰め直しと空きが無い場合の同期的な送信、
+ *     クリアとホーム復帰後のトランザクション間の実行時間待ち、
+ *     送信失敗時の表示内容の写しの破棄
+ *   ・直接通信／I2Cスケジューラ経由の組み合わせで実行する
+ *   ・トランザクションバッファを縮小（ST7032i_TRNS_BUFF_SIZE）してもビルドする
+ *
+ * CHANGE HISTORY:
+ * 2026/10/20 00:00:00 非同期実行のキュー、送信失敗、トランザクションバッファの縮小のテストを追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <jendefs.h>
+
+#include "i2c_util.h"
+#include "i2c_sched.h"
+#include "i2c_replay.h"
+#include "st7032i.h"
+#include "host_test.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// LCDモデル：解析状態
+#define TEST_LCD_PARSE_CTRL        (0)	// 制御バイト待ち
+#define TEST_LCD_PARSE_CMD         (1)	// コマンド待ち
+#define TEST_LCD_PARSE_DATA_TOP    (2)	// データ待ち（データ無し）
+#define TEST_LCD_PARSE_DATA        (3)	// データ
+// LCDモデル：書き込み先
+#define TEST_LCD_TARGET_DD         (0)
+#define TEST_LCD_TARGET_CG         (1)
+#define TEST_LCD_TARGET_ICON       (2)
+// LCDモデル：コマンド実行時間（マイクロ秒）
+#define TEST_LCD_EXEC_USEC         (27)
+#define TEST_LCD_EXEC_LONG_USEC    (1080)
+// ランダムな描画の回数（組み合わせ毎）
+#ifndef TEST_LCD_REDRAWS
+	#define TEST_LCD_REDRAWS       (600)
+#endif
+// データ送信のバイト数（アドレスと制御バイトを含む、トランザクションバッファ毎に分割）
+#define TEST_LCD_DATA_BYTES(n)     ((n) + 2 * (((n) + ST7032i_TRNS_BUFF_SIZE - 2) / (ST7032i_TRNS_BUFF_SIZE - 1)))
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：LCDモデル
+typedef struct {
+	// DDRAM
+	uint8 u8DDRAM[0x80];
+	// CGRAM
+	uint8 u8CGRAM[0x40];
+	// アイコンRAM
+	uint8 u8IconRAM[ST7032i_ICON_DATA_SIZE];
+	// アドレスカウンタ
+	uint8 u8AC;
+	// 書き込み先
+	uint8 u8Target;
+	// 拡張命令セット（IS=1）
+	bool_t bISFlg;
+	// 解析状態
+	uint8 u8Parse;
+	// 次の命令を受け付け可能な時刻
+	uint64 u64BusyUntil;
+	// 送信バイト数（アドレスを含む）
+	uint32 u32TxBytes;
+	// トランザクション数
+	uint32 u32TrnsCnt;
+	// 形式の誤り（制御バイトの不正、コマンドの無い制御バイト、データの無いデータ送信）
+	uint32 u32ProtoErrCnt;
+	// コマンド実行時間の違反
+	uint32 u32BusyErrCnt;
+	// 開始条件にNACK応答する回数
+	uint32 u32FailCnt;
+} tsTestLcd;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// LCDモデル
+PRIVATE tsTestLcd sTestLcd;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// LCDモデル：開始条件
+PRIVATE bool_t bTestLcd_start(void* pvContext, bool_t bReadFlg);
+// LCDモデル：1バイト書き込み
+PRIVATE uint8 u8TestLcd_write(void* pvContext, uint8 u8Data);
+// LCDモデル：1バイト読み込み
+PRIVATE uint8 u8TestLcd_read(void* pvContext);
+// LCDモデル：停止条件
+PRIVATE void vTestLcd_stop(void* pvContext);
+// LCDモデル：命令の受け付け（実行時間の確認）
+PRIVATE void vTestLcd_accept(uint32 u32ExecUsec);
+// LCDモデル：コマンドの実行
+PRIVATE void vTestLcd_command(uint8 u8Cmd);
+// LCDモデル：データの書き込み
+PRIVATE void vTestLcd_data(uint8 u8Data);
+// LCDモデルとst7032i.cの初期化
+PRIVATE bool_t bTest_open(ST7032i_state* psState, bool_t bSchedFlg);
+// 表示行とDDRAMの比較
+PRIVATE bool_t bTest_rowMatch(uint8 u8RowNo, const char* pcRow);
+// 表示行と表示内容の写しの比較
+PRIVATE bool_t bTest_frameMatch(ST7032i_state* psState, char cRows[][ST7032i_COL_SIZE + 1]);
+// 送信バイト数の差分の取得
+PRIVATE uint32 u32Test_txBytes(ST7032i_state* psState, uint32* pu32Before);
+// 次の描画内容の生成
+PRIVATE uint8 u8Test_nextRow(char cRows[][ST7032i_COL_SIZE + 1], char* pcStr);
+// 差分描画の個別ケース
+PRIVATE void vTest_drawCases(bool_t bSchedFlg);
+// ランダムな描画（TRUE：差分描画、FALSE：行全体の書き込み）
+PRIVATE uint32 u32Test_redraw(bool_t bSchedFlg, bool_t bDiffFlg);
+// 非同期実行のランダムな描画
+PRIVATE void vTest_asyncRedraw(bool_t bSchedFlg);
+// 非同期実行のキュー
+PRIVATE void vTest_asyncQueue(bool_t bSchedFlg);
+// 送信失敗
+PRIVATE void vTest_failure(bool_t bSchedFlg);
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+int main() {
+	int iMode;
+	for (iMode = 0; iMode < 2; iMode++) {
+		bool_t bSchedFlg = (iMode != 0);
+		vTest_drawCases(bSchedFlg);
+		uint32 u32FullBytes = u32Test_redraw(bSchedFlg, FALSE);
+		uint32 u32DiffBytes = u32Test_redraw(bSchedFlg, TRUE);
+		HOST_CHECK(u32DiffBytes * 3 < u32FullBytes * 2);
+		printf("redraw sched=%d trns buff=%d: full=%.1f diff=%.1f bytes/redraw\n", bSchedFlg, ST7032i_TRNS_BUFF_SIZE,
+				(double)u32FullBytes / TEST_LCD_REDRAWS, (double)u32DiffBytes / TEST_LCD_REDRAWS);
+		vTest_asyncRedraw(bSchedFlg);
+		vTest_asyncQueue(bSchedFlg);
+		vTest_failure(bSchedFlg);
+	}
+	return iHostTest_result("test_st7032i");
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: bTestLcd_start
+ *
+ * DESCRIPTION:LCDモデル：開始条件
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       R   未使用
+ *   bool_t         bReadFlg        R   読み込みフラグ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:ACK応答 FALSE:NACK応答
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE bool_t bTestLcd_start(void* pvContext, bool_t bReadFlg) {
+	sTestLcd.u32TxBytes++;
+	sTestLcd.u8Parse = TEST_LCD_PARSE_CTRL;
+	if (sTestLcd.u32FailCnt > 0) {
+		sTestLcd.u32FailCnt--;
+		return FALSE;
+	}
+	sTestLcd.u32TrnsCnt++;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8TestLcd_write
+ *
+ * DESCRIPTION:LCDモデル：1バイト書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       R   未使用
+ *   uint8          u8Data          R   書き込みデータ
+ *
+ * RETURNS:
+ *   uint8          I2CUTIL_STS_ACK固定
+ *
+ * NOTES:
+ * 制御バイト（0x00：コマンド、0x40：以降は全てデータ）に従って解釈する
+ *****************************************************************************/
+PRIVATE uint8 u8TestLcd_write(void* pvContext, uint8 u8Data) {
+	sTestLcd.u32TxBytes++;
+	switch (sTestLcd.u8Parse) {
+	case TEST_LCD_PARSE_CTRL:
+		if (u8Data == 0x00) {
+			sTestLcd.u8Parse = TEST_LCD_PARSE_CMD;
+		} else if (u8Data == 0x40) {
+			sTestLcd.u8Parse = TEST_LCD_PARSE_DATA_TOP;
+		} else {
+			sTestLcd.u32ProtoErrCnt++;
+		}
+		break;
+	case TEST_LCD_PARSE_CMD:
+		vTestLcd_command(u8Data);
+		sTestLcd.u8Parse = TEST_LCD_PARSE_CTRL;
+		break;
+	default:
+		vTestLcd_data(u8Data);
+		sTestLcd.u8Parse = TEST_LCD_PARSE_DATA;
+		break;
+	}
+	return I2CUTIL_STS_ACK;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8TestLcd_read
+ *
+ * DESCRIPTION:LCDモデル：1バイト読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       R   未使用
+ *
+ * RETURNS:
+ *   uint8          0xFF固定（読み込みは未対応）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8TestLcd_read(void* pvContext) {
+	sTestLcd.u32ProtoErrCnt++;
+	return 0xFF;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTestLcd_stop
+ *
+ * DESCRIPTION:LCDモデル：停止条件
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       R   未使用
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * コマンドの無い制御バイト、データの無いデータ送信で終わった場合は形式の誤り
+ *****************************************************************************/
+PRIVATE void vTestLcd_stop(void* pvContext) {
+	if (sTestLcd.u8Parse == TEST_LCD_PARSE_CMD || sTestLcd.u8Parse == TEST_LCD_PARSE_DATA_TOP) {
+		sTestLcd.u32ProtoErrCnt++;
+	}
+	sTestLcd.u8Parse = TEST_LCD_PARSE_CTRL;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTestLcd_accept
+ *
+ * DESCRIPTION:LCDモデル：命令の受け付け（実行時間の確認）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32ExecUsec     R   受け付けた命令の実行時間
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 前の命令の実行中に受け付けた場合は違反として数える
+ *****************************************************************************/
+PRIVATE void vTestLcd_accept(uint32 u32ExecUsec) {
+	uint64 u64Now = u64I2CReplay_readUsec();
+	if (u64Now < sTestLcd.u64BusyUntil) {
+		sTestLcd.u32BusyErrCnt++;
+	}
+	sTestLcd.u64BusyUntil = u64Now + u32ExecUsec;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTestLcd_command
+ *
+ * DESCRIPTION:LCDモデル：コマンドの実行
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Cmd           R   コマンド
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 表示制御と電源、コントラストのコマンドは実行時間のみ確認する
+ *****************************************************************************/
+PRIVATE void vTestLcd_command(uint8 u8Cmd) {
+	if (u8Cmd == 0x01) {
+		// Clear Display
+		vTestLcd_accept(TEST_LCD_EXEC_LONG_USEC);
+		memset(sTestLcd.u8DDRAM, ' ', sizeof(sTestLcd.u8DDRAM));
+		sTestLcd.u8AC     = 0x00;
+		sTestLcd.u8Target = TEST_LCD_TARGET_DD;
+		return;
+	}
+	if ((u8Cmd & 0xFE) == 0x02) {
+		// Return Home
+		vTestLcd_accept(TEST_LCD_EXEC_LONG_USEC);
+		sTestLcd.u8AC     = 0x00;
+		sTestLcd.u8Target = TEST_LCD_TARGET_DD;
+		return;
+	}
+	vTestLcd_accept(TEST_LCD_EXEC_USEC);
+	if ((u8Cmd & 0x80) != 0) {
+		// Set DDRAM Address
+		sTestLcd.u8AC     = u8Cmd & 0x7F;
+		sTestLcd.u8Target = TEST_LCD_TARGET_DD;
+	} else if ((u8Cmd & 0xE0) == 0x20) {
+		// Function Set
+		sTestLcd.bISFlg = (u8Cmd & 0x01) != 0;
+	} else if (!sTestLcd.bISFlg && (u8Cmd & 0xC0) == 0x40) {
+		// Set CGRAM Address
+		sTestLcd.u8AC     = u8Cmd & 0x3F;
+		sTestLcd.u8Target = TEST_LCD_TARGET_CG;
+	} else if (sTestLcd.bISFlg && (u8Cmd & 0xF0) == 0x40) {
+		// Set ICON Address
+		sTestLcd.u8AC     = u8Cmd & 0x0F;
+		sTestLcd.u8Target = TEST_LCD_TARGET_ICON;
+	} else if (!sTestLcd.bISFlg && (u8Cmd & 0xF8) == 0x10) {
+		// Cursor Shift（右：0x14、左：0x10）
+		if ((u8Cmd & 0x04) != 0) {
+			sTestLcd.u8AC = (sTestLcd.u8AC == 0x27) ? 0x40 : (sTestLcd.u8AC == 0x67) ? 0x00 : sTestLcd.u8AC + 1;
+		} else {
+			sTestLcd.u8AC = (sTestLcd.u8AC == 0x00) ? 0x67 : (sTestLcd.u8AC == 0x40) ? 0x27 : sTestLcd.u8AC - 1;
+		}
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTestLcd_data
+ *
+ * DESCRIPTION:LCDモデル：データの書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Data          R   データ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * DDRAMのアドレスカウンタは１行目の終端（0x27）で２行目の先頭、
+ * ２行目の終端（0x67）で１行目の先頭に移動する
+ *****************************************************************************/
+PRIVATE void vTestLcd_data(uint8 u8Data) {
+	vTestLcd_accept(TEST_LCD_EXEC_USEC);
+	switch (sTestLcd.u8Target) {
+	case TEST_LCD_TARGET_DD:
+		sTestLcd.u8DDRAM[sTestLcd.u8AC] = u8Data;
+		sTestLcd.u8AC = (sTestLcd.u8AC == 0x27) ? 0x40 : (sTestLcd.u8AC == 0x67) ? 0x00 : sTestLcd.u8AC + 1;
+		break;
+	case TEST_LCD_TARGET_CG:
+		sTestLcd.u8CGRAM[sTestLcd.u8AC] = u8Data;
+		sTestLcd.u8AC = (sTestLcd.u8AC + 1) & 0x3F;
+		break;
+	default:
+		sTestLcd.u8IconRAM[sTestLcd.u8AC] = u8Data;
+		sTestLcd.u8AC = (sTestLcd.u8AC + 1) & 0x0F;
+		break;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: bTest_open
+ *
+ * DESCRIPTION:LCDモデルとst7032i.cの初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   ST7032i_state* psState         W   LCDの状態情報
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:初期化成功
+ *
+ * NOTES:
+ * 電源投入直後のDDRAMの内容は不定なので乱数で初期化する
+ *****************************************************************************/
+PRIVATE bool_t bTest_open(ST7032i_state* psState, bool_t bSchedFlg) {
+	static const tsI2CReplay_DevIF sDevIF = {
+		bTestLcd_start, u8TestLcd_write, u8TestLcd_read, vTestLcd_stop
+	};
+	vI2CReplay_init();
+	memset(&sTestLcd, 0x00, sizeof(tsTestLcd));
+	int iIdx;
+	for (iIdx = 0; iIdx < sizeof(sTestLcd.u8DDRAM); iIdx++) {
+		sTestLcd.u8DDRAM[iIdx] = (uint8)(0x21 + rand() % 0x5E);
+	}
+	if (!bI2CReplay_registDevModel(I2C_ADDR_ST7032I, &sDevIF, NULL)) {
+		return FALSE;
+	}
+	// I2Cスケジューラ
+	vI2CSched_init(NULL, NULL);
+	uint8 u8DevIdx = I2C_SCHED_DEVICE_NONE;
+	if (bSchedFlg) {
+		int iDevIdx = iI2CSched_registDevice("LCD", I2C_ADDR_ST7032I,
+				I2C_SCHED_PRIORITY_NORMAL, I2C_SCHED_BUS_NONE);
+		HOST_CHECK(iDevIdx >= 0);
+		u8DevIdx = (uint8)iDevIdx;
+	}
+	vST7032i_setSchedDevice(u8DevIdx);
+	// デバイス選択と初期化
+	memset(psState, 0x00, sizeof(ST7032i_state));
+	psState->u8Address = I2C_ADDR_ST7032I;
+	if (!bST7032i_deviceSelect(psState) || !bST7032i_init()) {
+		return FALSE;
+	}
+	// 初期化後は空白
+	return bTest_rowMatch(0, "                ") && bTest_rowMatch(1, "                ");
+}
+
+/*****************************************************************************
+ *
+ * NAME: bTest_rowMatch
+ *
+ * DESCRIPTION:表示行とDDRAMの比較
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8RowNo         R   行
+ *   char*          pcRow           R   表示行（表示桁数）
+ *
+ * RETURNS:
+ *   bool_t         TRUE:一致
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE bool_t bTest_rowMatch(uint8 u8RowNo, const char* pcRow) {
+	return memcmp(&sTestLcd.u8DDRAM[0x40 * u8RowNo], pcRow, ST7032i_COL_SIZE) == 0;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bTest_frameMatch
+ *
+ * DESCRIPTION:表示行と表示内容の写しの比較
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   ST7032i_state* psState         R   LCDの状態情報
+ *   char[][]       cRows           R   表示行
+ *
+ * RETURNS:
+ *   bool_t         TRUE:一致
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE bool_t bTest_frameMatch(ST7032i_state* psState, char cRows[][ST7032i_COL_SIZE + 1]) {
+	uint8 u8RowNo;
+	for (u8RowNo = 0; u8RowNo < ST7032i_ROW_SIZE; u8RowNo++) {
+		if (memcmp(psState->cFrame[u8RowNo], cRows[u8RowNo], ST7032i_COL_SIZE) != 0) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32Test_txBytes
+ *
+ * DESCRIPTION:送信バイト数の差分の取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   ST7032i_state* psState         R   LCDの状態情報
+ *   uint32*        pu32Before      RW  前回の送信バイト数（更新する）
+ *
+ * RETURNS:
+ *   uint32         前回からの送信バイト数
+ *
+ * NOTES:
+ * st7032i.cの統計情報とLCDモデルが受信したバイト数の一致も確認する
+ *****************************************************************************/
+PRIVATE uint32 u32Test_txBytes(ST7032i_state* psState, uint32* pu32Before) {
+	HOST_CHECK(psState->u32TxByteCnt == sTestLcd.u32TxBytes);
+	uint32 u32Bytes = psState->u32TxByteCnt - *pu32Before;
+	*pu32Before = psState->u32TxByteCnt;
+	return u32Bytes;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8Test_nextRow
+ *
+ * DESCRIPTION:次の描画内容の生成
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   char[][]       cRows           RW  表示行（描画内容を反映する）
+ *   char*          pcStr           W   描画する文字列
+ *
+ * RETURNS:
+ *   uint8          描画する行
+ *
+ * NOTES:
+ * 数文字を変更し、時々文字列の置き換え、表示桁数より短い文字列とする
+ *****************************************************************************/
+PRIVATE uint8 u8Test_nextRow(char cRows[][ST7032i_COL_SIZE + 1], char* pcStr) {
+	uint8 u8RowNo = (uint8)(rand() % ST7032i_ROW_SIZE);
+	int iIdx;
+	memcpy(pcStr, cRows[u8RowNo], ST7032i_COL_SIZE + 1);
+	if (rand() % 20 == 0) {
+		for (iIdx = 0; iIdx < ST7032i_COL_SIZE; iIdx++) {
+			pcStr[iIdx] = (char)(0x20 + rand() % 0x5F);
+		}
+	} else {
+		int iChgCnt = 1 + rand() % 4;
+		for (iIdx = 0; iIdx < iChgCnt; iIdx++) {
+			pcStr[rand() % ST7032i_COL_SIZE] = (char)(0x20 + rand() % 0x5F);
+		}
+	}
+	int iLen = (rand() % 10 == 0) ? 1 + rand() % ST7032i_COL_SIZE : ST7032i_COL_SIZE;
+	pcStr[iLen] = '\0';
+	memcpy(cRows[u8RowNo], pcStr, iLen);
+	return u8RowNo;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_drawCases
+ *
+ * DESCRIPTION:差分描画の個別ケース
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 送信バイト数はアドレスを含む（カーソル移動：3、データ：2＋文字数をトランザクションバッファ毎に分割）
+ *****************************************************************************/
+PRIVATE void vTest_drawCases(bool_t bSchedFlg) {
+	ST7032i_state sState;
+	char cRows[ST7032i_ROW_SIZE][ST7032i_COL_SIZE + 1] = {"                ", "                "};
+	uint32 u32Before = 0;
+	uint32 u32Trns;
+	HOST_CHECK(bTest_open(&sState, bSchedFlg));
+	u32Test_txBytes(&sState, &u32Before);
+	// 初期化直後はカーソルが先頭なので移動しない（データのみ）
+	strcpy(cRows[0], "AAAAAAAAAAAAAAAA");
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == TEST_LCD_DATA_BYTES(16));
+	// 一致区間（3文字）を挟む変更区間は連結（カーソル移動＋5文字）
+	strcpy(cRows[0], "AAxAAAxAAAAAAAAA");
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 3 + TEST_LCD_DATA_BYTES(5));
+	// カーソルが変更区間の先頭にある場合は移動しない
+	strcpy(cRows[0], "AAxAAAxyAAAAAAAA");
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == TEST_LCD_DATA_BYTES(1));
+	// 一致区間がST7032i_DRAW_MERGE_GAP（5文字）の場合は連結（カーソル移動＋7文字）
+	strcpy(cRows[0], "AAxAAAxyAzAAAAAw");
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 3 + TEST_LCD_DATA_BYTES(7));
+	// 一致区間が6文字の場合は分割（カーソル移動とデータ送信を２回）
+	strcpy(cRows[0], "BAxAAAxzAzAAAAAw");
+	u32Trns = sTestLcd.u32TrnsCnt;
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == (3 + TEST_LCD_DATA_BYTES(1)) * 2);
+	HOST_CHECK(sTestLcd.u32TrnsCnt - u32Trns == 4);
+	// 変更の無い描画は送信しない
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 0);
+	// 表示桁数より短い文字列は後ろの桁を書き換えない
+	memcpy(cRows[1], "abc", 3);
+	HOST_CHECK(bST7032i_drawRow(1, "abc"));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 3 + TEST_LCD_DATA_BYTES(3));
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]) && bTest_rowMatch(1, cRows[1]));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows));
+	// １行目の終端（0x27）で２行目の先頭に折り返す
+	HOST_CHECK(bST7032i_setCursor(0, 0x26));
+	HOST_CHECK(bST7032i_writeString("0123"));
+	memcpy(cRows[1], "23", 2);
+	HOST_CHECK(bTest_rowMatch(1, cRows[1]));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows));
+	u32Test_txBytes(&sState, &u32Before);
+	HOST_CHECK(bST7032i_drawRow(1, cRows[1]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 0);
+	// 折り返し後のアドレスカウンタの位置へのカーソル移動は送信しない
+	HOST_CHECK(bST7032i_setCursor(1, 2));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 0);
+	// ２行目の終端（0x67）で１行目の先頭に折り返す
+	HOST_CHECK(bST7032i_setCursor(1, 0x26));
+	HOST_CHECK(bST7032i_writeString("wxyz"));
+	memcpy(cRows[0], "yz", 2);
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows));
+	u32Test_txBytes(&sState, &u32Before);
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(bST7032i_setCursor(0, 2));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 0);
+	// アドレスカウンタが不明になった後はカーソル移動を送信する
+	HOST_CHECK(bST7032i_writeIcon(1));
+	u32Test_txBytes(&sState, &u32Before);
+	cRows[0][2] = '!';
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == 3 + TEST_LCD_DATA_BYTES(1));
+	// クリア後は空白との差分を送信する
+	HOST_CHECK(bST7032i_clearScreen());
+	u32Test_txBytes(&sState, &u32Before);
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(u32Test_txBytes(&sState, &u32Before) == TEST_LCD_DATA_BYTES(16));
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]) && bTest_rowMatch(1, "                "));
+	HOST_CHECK(sTestLcd.u32ProtoErrCnt == 0);
+	HOST_CHECK(sTestLcd.u32BusyErrCnt == 0);
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32Test_redraw
+ *
+ * DESCRIPTION:ランダムな描画
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *   bool_t         bDiffFlg        R   TRUE:差分描画 FALSE:行全体の書き込み
+ *
+ * RETURNS:
+ *   uint32         描画の送信バイト数の合計
+ *
+ * NOTES:
+ * 描画の合間に時々アイコン、クリアを挟む
+ * 差分描画と行全体の書き込みで同じ操作列となる様に乱数を初期化する
+ *****************************************************************************/
+PRIVATE uint32 u32Test_redraw(bool_t bSchedFlg, bool_t bDiffFlg) {
+	ST7032i_state sState;
+	char cRows[ST7032i_ROW_SIZE][ST7032i_COL_SIZE + 1] = {"                ", "                "};
+	char cStr[ST7032i_COL_SIZE + 1];
+	uint32 u32Before = 0;
+	uint32 u32Total = 0;
+	uint32 u32Mismatch = 0;
+	int iCnt;
+	srand(2);
+	HOST_CHECK(bTest_open(&sState, bSchedFlg));
+	u32Test_txBytes(&sState, &u32Before);
+	for (iCnt = 0; iCnt < TEST_LCD_REDRAWS; iCnt++) {
+		// 描画内容
+		uint8 u8RowNo = u8Test_nextRow(cRows, cStr);
+		// 描画
+		u32Test_txBytes(&sState, &u32Before);
+		if (bDiffFlg) {
+			HOST_CHECK(bST7032i_drawRow(u8RowNo, cStr));
+		} else {
+			HOST_CHECK(bST7032i_setCursor(u8RowNo, 0));
+			HOST_CHECK(bST7032i_writeString(cStr));
+		}
+		u32Total += u32Test_txBytes(&sState, &u32Before);
+		// アイコン、クリア（描画の送信バイト数には含めない）
+		if (rand() % 40 == 0) {
+			HOST_CHECK(bST7032i_writeIcon((uint8)(1 + rand() % 80)));
+		}
+		if (rand() % 100 == 0) {
+			HOST_CHECK(bST7032i_clearScreen());
+			strcpy(cRows[0], "                ");
+			strcpy(cRows[1], "                ");
+		}
+		// DDRAMと表示内容の写しの比較
+		if (!bTest_rowMatch(0, cRows[0]) || !bTest_rowMatch(1, cRows[1]) || !bTest_frameMatch(&sState, cRows)) {
+			u32Mismatch++;
+		}
+	}
+	HOST_CHECK(u32Mismatch == 0);
+	HOST_CHECK(sTestLcd.u32ProtoErrCnt == 0);
+	HOST_CHECK(sTestLcd.u32BusyErrCnt == 0);
+	return u32Total;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_asyncRedraw
+ *
+ * DESCRIPTION:非同期実行のランダムな描画
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 描画、クリア、ホーム復帰はキューへの登録のみで時間が進まない事（キューに空きが
+ * 無い場合を除く）、時間を進めながらの進行と完了待ちの後にDDRAMが一致する事を確認する
+ *****************************************************************************/
+PRIVATE void vTest_asyncRedraw(bool_t bSchedFlg) {
+	ST7032i_state sState;
+	char cRows[ST7032i_ROW_SIZE][ST7032i_COL_SIZE + 1] = {"                ", "                "};
+	char cStr[ST7032i_COL_SIZE + 1];
+	uint32 u32Before = 0;
+	uint32 u32Mismatch = 0;
+	uint32 u32TimeErr = 0;
+	int iCnt;
+	srand(3);
+	HOST_CHECK(bTest_open(&sState, bSchedFlg));
+	HOST_CHECK(bST7032i_setAsync(TRUE));
+	for (iCnt = 0; iCnt < TEST_LCD_REDRAWS; iCnt++) {
+		uint64 u64Now = u64I2CReplay_readUsec();
+		uint32 u32FullCnt = sState.u32QueueFullCnt;
+		// 描画内容
+		uint8 u8RowNo = u8Test_nextRow(cRows, cStr);
+		// 描画、クリア、ホーム復帰（キューへの登録）
+		HOST_CHECK(bST7032i_drawRow(u8RowNo, cStr));
+		if (rand() % 40 == 0) {
+			HOST_CHECK(bST7032i_clearScreen());
+			strcpy(cRows[0], "                ");
+			strcpy(cRows[1], "                ");
+		}
+		if (rand() % 40 == 0) {
+			HOST_CHECK(bST7032i_returnHome());
+		}
+		if (sState.u32QueueFullCnt == u32FullCnt && u64I2CReplay_readUsec() != u64Now) {
+			u32TimeErr++;
+		}
+		if (!bTest_frameMatch(&sState, cRows)) {
+			u32Mismatch++;
+		}
+		// 時間を進めて進行
+		vI2CReplay_waitUntil(u64I2CReplay_readUsec() + rand() % 300);
+		HOST_CHECK(bST7032i_asyncProceed());
+		// 時々完了待ち
+		if (rand() % 16 == 0) {
+			HOST_CHECK(bST7032i_asyncWait());
+			if (!bTest_rowMatch(0, cRows[0]) || !bTest_rowMatch(1, cRows[1])) {
+				u32Mismatch++;
+			}
+		}
+	}
+	HOST_CHECK(bST7032i_setAsync(FALSE));
+	HOST_CHECK(!bST7032i_asyncIsBusy());
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]) && bTest_rowMatch(1, cRows[1]));
+	HOST_CHECK(u32Mismatch == 0);
+	HOST_CHECK(u32TimeErr == 0);
+	u32Test_txBytes(&sState, &u32Before);
+	HOST_CHECK(sTestLcd.u32ProtoErrCnt == 0);
+	HOST_CHECK(sTestLcd.u32BusyErrCnt == 0);
+	printf("async sched=%d trns buff=%d: queue full=%u\n", bSchedFlg, ST7032i_TRNS_BUFF_SIZE, sState.u32QueueFullCnt);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_asyncQueue
+ *
+ * DESCRIPTION:非同期実行のキュー
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ・クリア後は実行時間（1.08ミリ秒）が経過するまで次のトランザクションを送信しない
+ * ・末尾に空きが無い場合は実行済みの領域を詰めて登録する（時間は進まない）
+ * ・詰めても空きが無い場合は実行待ちのトランザクションを同期的に送信する
+ *****************************************************************************/
+PRIVATE void vTest_asyncQueue(bool_t bSchedFlg) {
+	ST7032i_state sState;
+	char cRows[ST7032i_ROW_SIZE][ST7032i_COL_SIZE + 1] = {"                ", "                "};
+	uint32 u32Before = 0;
+	uint32 u32Trns;
+	uint64 u64Now;
+	bool_t bCompactFlg = FALSE;
+	uint8 u8Cnt;
+	HOST_CHECK(bTest_open(&sState, bSchedFlg));
+	HOST_CHECK(bST7032i_setAsync(TRUE));
+	// 初期化のクリアの実行時間の経過を待つ
+	vI2CReplay_waitUntil(sState.u64nextExec);
+	// 描画、クリア、描画を登録して進行（クリアまで送信）
+	HOST_CHECK(bST7032i_drawRow(0, "AAAAAAAAAAAAAAAA"));
+	HOST_CHECK(bST7032i_clearScreen());
+	HOST_CHECK(bST7032i_drawRow(1, "BBBBBBBBBBBBBBBB"));
+	strcpy(cRows[1], "BBBBBBBBBBBBBBBB");
+	HOST_CHECK(bST7032i_asyncProceed());
+	u32Trns = sTestLcd.u32TrnsCnt;
+	HOST_CHECK(sState.u16QueueHead > 0 && bST7032i_asyncIsBusy());
+	HOST_CHECK(sState.u64nextExec > u64I2CReplay_readUsec() + ST7032i_ASYNC_SPIN_USEC);
+	// 実行時間の経過前は送信しない
+	vI2CReplay_waitUntil(sState.u64nextExec - ST7032i_ASYNC_SPIN_USEC - 1);
+	HOST_CHECK(bST7032i_asyncProceed());
+	HOST_CHECK(sTestLcd.u32TrnsCnt == u32Trns);
+	// １文字ずつの変更を登録（末尾の空きが無くなったら詰める）
+	u64Now = u64I2CReplay_readUsec();
+	for (u8Cnt = 0; u8Cnt < ST7032i_COL_SIZE * 2 && !bCompactFlg; u8Cnt++) {
+		uint8 u8RowNo = u8Cnt % ST7032i_ROW_SIZE;
+		cRows[u8RowNo][u8Cnt / 2] = (char)('a' + u8Cnt % 26);
+		HOST_CHECK(bST7032i_drawRow(u8RowNo, cRows[u8RowNo]));
+		bCompactFlg = (sState.u16QueueHead == 0);
+	}
+	HOST_CHECK(bCompactFlg);
+	HOST_CHECK(sState.u32QueueFullCnt == 0);
+	HOST_CHECK(u64I2CReplay_readUsec() == u64Now);
+	HOST_CHECK(sTestLcd.u32TrnsCnt == u32Trns);
+	// 詰めても空きが無くなるまで登録（実行待ちのトランザクションを同期的に送信）
+	for (u8Cnt = 0; u8Cnt < ST7032i_COL_SIZE * 2 && sState.u32QueueFullCnt == 0; u8Cnt++) {
+		uint8 u8RowNo = u8Cnt % ST7032i_ROW_SIZE;
+		cRows[u8RowNo][u8Cnt / 2] = (char)('A' + u8Cnt % 26);
+		HOST_CHECK(bST7032i_drawRow(u8RowNo, cRows[u8RowNo]));
+	}
+	HOST_CHECK(sState.u32QueueFullCnt == 1);
+	HOST_CHECK(u64I2CReplay_readUsec() > u64Now);
+	HOST_CHECK(sTestLcd.u32TrnsCnt > u32Trns);
+	// 完了待ち
+	HOST_CHECK(bST7032i_asyncWait());
+	HOST_CHECK(sState.u16QueueHead == 0 && sState.u16QueueTail == 0);
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]) && bTest_rowMatch(1, cRows[1]));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows));
+	// ホーム復帰後も実行時間の経過前は送信しない
+	HOST_CHECK(bST7032i_returnHome());
+	HOST_CHECK(bST7032i_writeChar('#'));
+	cRows[0][0] = '#';
+	u32Trns = sTestLcd.u32TrnsCnt;
+	HOST_CHECK(bST7032i_asyncProceed());
+	HOST_CHECK(sTestLcd.u32TrnsCnt - u32Trns == 1);
+	vI2CReplay_waitUntil(sState.u64nextExec - ST7032i_ASYNC_SPIN_USEC);
+	HOST_CHECK(bST7032i_asyncProceed());
+	HOST_CHECK(sTestLcd.u32TrnsCnt - u32Trns == 2);
+	HOST_CHECK(!bST7032i_asyncIsBusy());
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]));
+	HOST_CHECK(bST7032i_setAsync(FALSE));
+	u32Test_txBytes(&sState, &u32Before);
+	HOST_CHECK(sTestLcd.u32ProtoErrCnt == 0);
+	HOST_CHECK(sTestLcd.u32BusyErrCnt == 0);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_failure
+ *
+ * DESCRIPTION:送信失敗
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bSchedFlg       R   I2Cスケジューラ経由フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 送信に失敗した場合は表示内容の写しとアドレスカウンタを破棄し、
+ * 次の描画で行全体をカーソル移動から送信し直す
+ * （失敗したトランザクションの送信バイト数はLCDモデルと一致しないので比較しない）
+ *****************************************************************************/
+PRIVATE void vTest_failure(bool_t bSchedFlg) {
+	ST7032i_state sState;
+	char cRows[ST7032i_ROW_SIZE][ST7032i_COL_SIZE + 1] = {"0123456789ABCDEF", "fedcba9876543210"};
+	uint32 u32Before;
+	uint8 u8RowNo;
+	uint8 u8Col;
+	HOST_CHECK(bTest_open(&sState, bSchedFlg));
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(bST7032i_drawRow(1, cRows[1]));
+	//=========================================================================
+	// 同期実行
+	//=========================================================================
+	sTestLcd.u32FailCnt = 1;
+	HOST_CHECK(!bST7032i_drawRow(0, "X"));
+	HOST_CHECK(sState.u8DDAddr == ST7032i_ADDR_UNKNOWN);
+	for (u8RowNo = 0; u8RowNo < ST7032i_ROW_SIZE; u8RowNo++) {
+		for (u8Col = 0; u8Col < ST7032i_COL_SIZE; u8Col++) {
+			HOST_CHECK(sState.cFrame[u8RowNo][u8Col] == '\0');
+		}
+	}
+	// 写しが無いので変更の無い行も全体を送信し直す
+	u32Before = sState.u32TxByteCnt;
+	HOST_CHECK(bST7032i_drawRow(1, cRows[1]));
+	HOST_CHECK(sState.u32TxByteCnt - u32Before == 3 + TEST_LCD_DATA_BYTES(ST7032i_COL_SIZE));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows) == FALSE);
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows));
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]) && bTest_rowMatch(1, cRows[1]));
+	//=========================================================================
+	// 非同期実行
+	//=========================================================================
+	HOST_CHECK(bST7032i_setAsync(TRUE));
+	cRows[0][5] = '*';
+	cRows[1][9] = '*';
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(bST7032i_drawRow(1, cRows[1]));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows));
+	// 登録済みのトランザクションの先頭（カーソル移動）が失敗
+	sTestLcd.u32FailCnt = 1;
+	HOST_CHECK(!bST7032i_asyncWait());
+	HOST_CHECK(sState.cFrame[0][5] == '\0' && sState.cFrame[1][9] == '\0');
+	HOST_CHECK(sState.u8DDAddr == ST7032i_ADDR_UNKNOWN);
+	// 描画し直すと一致する
+	HOST_CHECK(bST7032i_drawRow(0, cRows[0]));
+	HOST_CHECK(bST7032i_drawRow(1, cRows[1]));
+	HOST_CHECK(bST7032i_asyncWait());
+	HOST_CHECK(bST7032i_setAsync(FALSE));
+	HOST_CHECK(bTest_frameMatch(&sState, cRows));
+	HOST_CHECK(bTest_rowMatch(0, cRows[0]) && bTest_rowMatch(1, cRows[1]));
+	HOST_CHECK(sTestLcd.u32ProtoErrCnt == 0);
+	HOST_CHECK(sTestLcd.u32BusyErrCnt == 0);
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -9,10 +9,19 @@
  *             AES暗号の暗号化と復号化を行う関数群です。
  *             対応するキーサイズは128bit、192bit、256bit
  *             ブロック暗号なので、余白分の対応としてPKCS#7の機能を提供する。
+ *             任意長のデータを分割して処理するストリーム処理の機能を提供する。
+ *             ブロック単位の暗号化／復号化はバックエンドとして差し替え可能
  *             仕様書はNISTのサイトを参照
  *             FIPS-197(http://csrc.nist.gov/publications/fips/fips197/fips-197.pdf)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 13:00:00 認証付き暗号（CCMモード）を追加
+ * 2026/10/18 14:00:00 CTRモードと任意長データのストリーム処理を追加
+ * 2026/10/18 15:00:00 ブロック暗号処理のバックエンドを差し替え可能にし、テーブル参照による高速版を追加
+ * 2026/10/18 16:00:00 定数時間で複数ブロックを並列処理するビットスライス版のバックエンドを追加
+ * 2026/10/19 12:00:00 ストリーム処理の残りサイズ比較の符号不一致警告を修正
+ * 2026/10/19 13:00:00 テーブル参照版の復号化で最終ラウンドをループ外に分離し、未初期化変数の警告を解消
+ * 2026/10/19 23:00:00 パディング付きの復号化で入力と出力に同じバッファを指定した場合に保留ブロックが入力を上書きする不具合を修正
  *
  * LAST MODIFIED BY:
  *
@@ -52,6 +61,13 @@
 #define Nk_256                 (8)
 #define Nr_256                 (14)
 
+/** 32bitワードの右ローテート */
+#define AES_ROTR(x, n)         (((x) >> (n)) | ((x) << (32 - (n))))
+/** ビッグエンディアンで32bitワードを読み込む */
+#define AES_LOAD32(p)          (((uint32)(p)[0] << 24) | ((uint32)(p)[1] << 16) | ((uint32)(p)[2] << 8) | (uint32)(p)[3])
+/** ビッグエンディアンで32bitワードを書き込む */
+#define AES_STORE32(p, v)      { (p)[0] = (uint8)((v) >> 24); (p)[1] = (uint8)((v) >> 16); (p)[2] = (uint8)((v) >> 8); (p)[3] = (uint8)(v); }
+
 /*****************************************************************************/
 /***        Type Definitions                                               ***/
 /*****************************************************************************/
@@ -121,6 +137,87 @@ static const uint8 RCON[11] = {
     0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
 };
 
+/**
+ * Encryption table.
+ * テーブル参照版の暗号化で利用するテーブル（SubBytesとMixColumnsの合成）
+ * 各要素は行0～3の順に {02}・S[x]、S[x]、S[x]、{03}・S[x] を上位バイトから格納
+ * 行1～3の列は右ローテートで求める
+ */
+static const uint32 TE_TABLE[256] = {
+    0xc66363a5, 0xf87c7c84, 0xee777799, 0xf67b7b8d, 0xfff2f20d, 0xd66b6bbd, 0xde6f6fb1, 0x91c5c554,
+    0x60303050, 0x02010103, 0xce6767a9, 0x562b2b7d, 0xe7fefe19, 0xb5d7d762, 0x4dababe6, 0xec76769a,
+    0x8fcaca45, 0x1f82829d, 0x89c9c940, 0xfa7d7d87, 0xeffafa15, 0xb25959eb, 0x8e4747c9, 0xfbf0f00b,
+    0x41adadec, 0xb3d4d467, 0x5fa2a2fd, 0x45afafea, 0x239c9cbf, 0x53a4a4f7, 0xe4727296, 0x9bc0c05b,
+    0x75b7b7c2, 0xe1fdfd1c, 0x3d9393ae, 0x4c26266a, 0x6c36365a, 0x7e3f3f41, 0xf5f7f702, 0x83cccc4f,
+    0x6834345c, 0x51a5a5f4, 0xd1e5e534, 0xf9f1f108, 0xe2717193, 0xabd8d873, 0x62313153, 0x2a15153f,
+    0x0804040c, 0x95c7c752, 0x46232365, 0x9dc3c35e, 0x30181828, 0x379696a1, 0x0a05050f, 0x2f9a9ab5,
+    0x0e070709, 0x24121236, 0x1b80809b, 0xdfe2e23d, 0xcdebeb26, 0x4e272769, 0x7fb2b2cd, 0xea75759f,
+    0x1209091b, 0x1d83839e, 0x582c2c74, 0x341a1a2e, 0x361b1b2d, 0xdc6e6eb2, 0xb45a5aee, 0x5ba0a0fb,
+    0xa45252f6, 0x763b3b4d, 0xb7d6d661, 0x7db3b3ce, 0x5229297b, 0xdde3e33e, 0x5e2f2f71, 0x13848497,
+    0xa65353f5, 0xb9d1d168, 0x00000000, 0xc1eded2c, 0x40202060, 0xe3fcfc1f, 0x79b1b1c8, 0xb65b5bed,
+    0xd46a6abe, 0x8dcbcb46, 0x67bebed9, 0x7239394b, 0x944a4ade, 0x984c4cd4, 0xb05858e8, 0x85cfcf4a,
+    0xbbd0d06b, 0xc5efef2a, 0x4faaaae5, 0xedfbfb16, 0x864343c5, 0x9a4d4dd7, 0x66333355, 0x11858594,
+    0x8a4545cf, 0xe9f9f910, 0x04020206, 0xfe7f7f81, 0xa05050f0, 0x783c3c44, 0x259f9fba, 0x4ba8a8e3,
+    0xa25151f3, 0x5da3a3fe, 0x804040c0, 0x058f8f8a, 0x3f9292ad, 0x219d9dbc, 0x70383848, 0xf1f5f504,
+    0x63bcbcdf, 0x77b6b6c1, 0xafdada75, 0x42212163, 0x20101030, 0xe5ffff1a, 0xfdf3f30e, 0xbfd2d26d,
+    0x81cdcd4c, 0x180c0c14, 0x26131335, 0xc3ecec2f, 0xbe5f5fe1, 0x359797a2, 0x884444cc, 0x2e171739,
+    0x93c4c457, 0x55a7a7f2, 0xfc7e7e82, 0x7a3d3d47, 0xc86464ac, 0xba5d5de7, 0x3219192b, 0xe6737395,
+    0xc06060a0, 0x19818198, 0x9e4f4fd1, 0xa3dcdc7f, 0x44222266, 0x542a2a7e, 0x3b9090ab, 0x0b888883,
+    0x8c4646ca, 0xc7eeee29, 0x6bb8b8d3, 0x2814143c, 0xa7dede79, 0xbc5e5ee2, 0x160b0b1d, 0xaddbdb76,
+    0xdbe0e03b, 0x64323256, 0x743a3a4e, 0x140a0a1e, 0x924949db, 0x0c06060a, 0x4824246c, 0xb85c5ce4,
+    0x9fc2c25d, 0xbdd3d36e, 0x43acacef, 0xc46262a6, 0x399191a8, 0x319595a4, 0xd3e4e437, 0xf279798b,
+    0xd5e7e732, 0x8bc8c843, 0x6e373759, 0xda6d6db7, 0x018d8d8c, 0xb1d5d564, 0x9c4e4ed2, 0x49a9a9e0,
+    0xd86c6cb4, 0xac5656fa, 0xf3f4f407, 0xcfeaea25, 0xca6565af, 0xf47a7a8e, 0x47aeaee9, 0x10080818,
+    0x6fbabad5, 0xf0787888, 0x4a25256f, 0x5c2e2e72, 0x381c1c24, 0x57a6a6f1, 0x73b4b4c7, 0x97c6c651,
+    0xcbe8e823, 0xa1dddd7c, 0xe874749c, 0x3e1f1f21, 0x964b4bdd, 0x61bdbddc, 0x0d8b8b86, 0x0f8a8a85,
+    0xe0707090, 0x7c3e3e42, 0x71b5b5c4, 0xcc6666aa, 0x904848d8, 0x06030305, 0xf7f6f601, 0x1c0e0e12,
+    0xc26161a3, 0x6a35355f, 0xae5757f9, 0x69b9b9d0, 0x17868691, 0x99c1c158, 0x3a1d1d27, 0x279e9eb9,
+    0xd9e1e138, 0xebf8f813, 0x2b9898b3, 0x22111133, 0xd26969bb, 0xa9d9d970, 0x078e8e89, 0x339494a7,
+    0x2d9b9bb6, 0x3c1e1e22, 0x15878792, 0xc9e9e920, 0x87cece49, 0xaa5555ff, 0x50282878, 0xa5dfdf7a,
+    0x038c8c8f, 0x59a1a1f8, 0x09898980, 0x1a0d0d17, 0x65bfbfda, 0xd7e6e631, 0x844242c6, 0xd06868b8,
+    0x824141c3, 0x299999b0, 0x5a2d2d77, 0x1e0f0f11, 0x7bb0b0cb, 0xa85454fc, 0x6dbbbbd6, 0x2c16163a
+};
+
+/**
+ * Inverse MixColumns table.
+ * テーブル参照版の復号化で利用するテーブル（InvMixColumns）
+ * 各要素は行0～3の順に {0e}・x、{09}・x、{0d}・x、{0b}・x を上位バイトから格納
+ */
+static const uint32 INV_MIX_TABLE[256] = {
+    0x00000000, 0x0e090d0b, 0x1c121a16, 0x121b171d, 0x3824342c, 0x362d3927, 0x24362e3a, 0x2a3f2331,
+    0x70486858, 0x7e416553, 0x6c5a724e, 0x62537f45, 0x486c5c74, 0x4665517f, 0x547e4662, 0x5a774b69,
+    0xe090d0b0, 0xee99ddbb, 0xfc82caa6, 0xf28bc7ad, 0xd8b4e49c, 0xd6bde997, 0xc4a6fe8a, 0xcaaff381,
+    0x90d8b8e8, 0x9ed1b5e3, 0x8ccaa2fe, 0x82c3aff5, 0xa8fc8cc4, 0xa6f581cf, 0xb4ee96d2, 0xbae79bd9,
+    0xdb3bbb7b, 0xd532b670, 0xc729a16d, 0xc920ac66, 0xe31f8f57, 0xed16825c, 0xff0d9541, 0xf104984a,
+    0xab73d323, 0xa57ade28, 0xb761c935, 0xb968c43e, 0x9357e70f, 0x9d5eea04, 0x8f45fd19, 0x814cf012,
+    0x3bab6bcb, 0x35a266c0, 0x27b971dd, 0x29b07cd6, 0x038f5fe7, 0x0d8652ec, 0x1f9d45f1, 0x119448fa,
+    0x4be30393, 0x45ea0e98, 0x57f11985, 0x59f8148e, 0x73c737bf, 0x7dce3ab4, 0x6fd52da9, 0x61dc20a2,
+    0xad766df6, 0xa37f60fd, 0xb16477e0, 0xbf6d7aeb, 0x955259da, 0x9b5b54d1, 0x894043cc, 0x87494ec7,
+    0xdd3e05ae, 0xd33708a5, 0xc12c1fb8, 0xcf2512b3, 0xe51a3182, 0xeb133c89, 0xf9082b94, 0xf701269f,
+    0x4de6bd46, 0x43efb04d, 0x51f4a750, 0x5ffdaa5b, 0x75c2896a, 0x7bcb8461, 0x69d0937c, 0x67d99e77,
+    0x3daed51e, 0x33a7d815, 0x21bccf08, 0x2fb5c203, 0x058ae132, 0x0b83ec39, 0x1998fb24, 0x1791f62f,
+    0x764dd68d, 0x7844db86, 0x6a5fcc9b, 0x6456c190, 0x4e69e2a1, 0x4060efaa, 0x527bf8b7, 0x5c72f5bc,
+    0x0605bed5, 0x080cb3de, 0x1a17a4c3, 0x141ea9c8, 0x3e218af9, 0x302887f2, 0x223390ef, 0x2c3a9de4,
+    0x96dd063d, 0x98d40b36, 0x8acf1c2b, 0x84c61120, 0xaef93211, 0xa0f03f1a, 0xb2eb2807, 0xbce2250c,
+    0xe6956e65, 0xe89c636e, 0xfa877473, 0xf48e7978, 0xdeb15a49, 0xd0b85742, 0xc2a3405f, 0xccaa4d54,
+    0x41ecdaf7, 0x4fe5d7fc, 0x5dfec0e1, 0x53f7cdea, 0x79c8eedb, 0x77c1e3d0, 0x65daf4cd, 0x6bd3f9c6,
+    0x31a4b2af, 0x3fadbfa4, 0x2db6a8b9, 0x23bfa5b2, 0x09808683, 0x07898b88, 0x15929c95, 0x1b9b919e,
+    0xa17c0a47, 0xaf75074c, 0xbd6e1051, 0xb3671d5a, 0x99583e6b, 0x97513360, 0x854a247d, 0x8b432976,
+    0xd134621f, 0xdf3d6f14, 0xcd267809, 0xc32f7502, 0xe9105633, 0xe7195b38, 0xf5024c25, 0xfb0b412e,
+    0x9ad7618c, 0x94de6c87, 0x86c57b9a, 0x88cc7691, 0xa2f355a0, 0xacfa58ab, 0xbee14fb6, 0xb0e842bd,
+    0xea9f09d4, 0xe49604df, 0xf68d13c2, 0xf8841ec9, 0xd2bb3df8, 0xdcb230f3, 0xcea927ee, 0xc0a02ae5,
+    0x7a47b13c, 0x744ebc37, 0x6655ab2a, 0x685ca621, 0x42638510, 0x4c6a881b, 0x5e719f06, 0x5078920d,
+    0x0a0fd964, 0x0406d46f, 0x161dc372, 0x1814ce79, 0x322bed48, 0x3c22e043, 0x2e39f75e, 0x2030fa55,
+    0xec9ab701, 0xe293ba0a, 0xf088ad17, 0xfe81a01c, 0xd4be832d, 0xdab78e26, 0xc8ac993b, 0xc6a59430,
+    0x9cd2df59, 0x92dbd252, 0x80c0c54f, 0x8ec9c844, 0xa4f6eb75, 0xaaffe67e, 0xb8e4f163, 0xb6edfc68,
+    0x0c0a67b1, 0x02036aba, 0x10187da7, 0x1e1170ac, 0x342e539d, 0x3a275e96, 0x283c498b, 0x26354480,
+    0x7c420fe9, 0x724b02e2, 0x605015ff, 0x6e5918f4, 0x44663bc5, 0x4a6f36ce, 0x587421d3, 0x567d2cd8,
+    0x37a10c7a, 0x39a80171, 0x2bb3166c, 0x25ba1b67, 0x0f853856, 0x018c355d, 0x13972240, 0x1d9e2f4b,
+    0x47e96422, 0x49e06929, 0x5bfb7e34, 0x55f2733f, 0x7fcd500e, 0x71c45d05, 0x63df4a18, 0x6dd64713,
+    0xd731dcca, 0xd938d1c1, 0xcb23c6dc, 0xc52acbd7, 0xef15e8e6, 0xe11ce5ed, 0xf307f2f0, 0xfd0efffb,
+    0xa779b492, 0xa970b999, 0xbb6bae84, 0xb562a38f, 0x9f5d80be, 0x91548db5, 0x834f9aa8, 0x8d4697a3
+};
+
 /*****************************************************************************/
 /***        Local Function Prototypes                                      ***/
 /*****************************************************************************/
@@ -130,6 +227,44 @@ static void vInitRoundKey(tsAES_state* sState, uint8* u8Key);
 static void vCiphertext(tsAES_state* sState, uint8* u8Buff);
 /** Series of transformations that converts ciphertext to plaintext using the Cipher Key. */
 static void vInvCipher(tsAES_state* sState, uint8* u8Buff);
+/** Encryption processing (table lookup version). */
+static void vCiphertextTbl(tsAES_state* sState, uint8* u8Buff);
+/** Decryption processing (table lookup version). */
+static void vInvCipherTbl(tsAES_state* sState, uint8* u8Buff);
+/** Encryption processing (bitsliced version). */
+static void vCiphertextBs(tsAES_state* sState, uint8* u8Buff);
+/** Decryption processing (bitsliced version). */
+static void vInvCipherBs(tsAES_state* sState, uint8* u8Buff);
+/** Multiple block encryption (bitsliced version). */
+static void vCiphertextBsBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt);
+/** Multiple block decryption (bitsliced version). */
+static void vInvCipherBsBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt);
+/** Block encryption by backend */
+static void vEncryptBlock(tsAES_state* sState, uint8* u8Buff);
+/** Block decryption by backend */
+static void vDecryptBlock(tsAES_state* sState, uint8* u8Buff);
+/** Multiple block encryption by backend */
+static void vEncryptBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt);
+/** Multiple block decryption by backend */
+static void vDecryptBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt);
+/** Bitsliced processing of 8 blocks */
+static void vBsCipher8(tsAES_state* sState, uint8* u8Blocks);
+static void vBsInvCipher8(tsAES_state* sState, uint8* u8Blocks);
+/** Bitsliced conversion */
+static void vBsPack(uint32 q[4][8], uint8* u8Blocks);
+static void vBsUnpack(uint8* u8Blocks, uint32 q[4][8]);
+static uint64 u64BsTranspose(uint64 x);
+/** Bitsliced round transformations */
+static void vBsAddRoundKey(uint32 q[4][8], uint8* u8Key);
+static void vBsSubBytes(uint32 q[4][8]);
+static void vBsInvSubBytes(uint32 q[4][8]);
+static void vBsShiftRows(uint32 q[4][8]);
+static void vBsInvShiftRows(uint32 q[4][8]);
+static void vBsXtime(uint32* u32Out, uint32* u32In);
+static void vBsMixColumns(uint32 q[4][8]);
+static void vBsInvMixColumns(uint32 q[4][8]);
+static void vBsSbox(uint32* q);
+static void vBsInvSbox(uint32* q);
 /** Transformation in the Cipher and Inverse Cipher in which a Round Key is added to the State using an XOR operation. */
 static void vAddRoundKey(uint8* u8Buff, tsAES_state* sState, uint8 u8Round);
 /** Block unit XOR */
@@ -157,6 +292,32 @@ static void vInvShiftRows(uint8* u8Buff);
 static void vInvMixColumns(uint8* u8Buff);
 /**  */
 static uint8 vMultiply(uint8 x, uint8 y);
+/** CCM Initialize CBC-MAC (B0 and associated data) */
+static void vCCMInitMac(tsAES_state* sState, uint8* u8Mac, uint8* u8Nonce, uint8 u8NonceLen,
+	uint8* u8Aad, uint32 u32AadLen, uint32 u32Len, uint8 u8TagLen);
+/** CCM Format Counter Block */
+static void vCCMSetCounter(uint8* u8Ctr, uint8* u8Nonce, uint8 u8NonceLen, uint32 u32Cnt);
+/** CCM Encryption / Decryption and CBC-MAC update */
+static void vCCMCrypt(tsAES_state* sState, uint8* u8Mac, uint8* u8Nonce, uint8 u8NonceLen,
+	uint8* u8Buff, uint32 u32Len, bool_t bEncrypt);
+/** CTR Encryption / Decryption */
+static void vCTRCrypt(tsAES_state* sState, uint8* u8Buff, uint32 u32Len);
+/** CTR Increment Counter */
+static void vIncCounter(uint8* u8Ctr);
+/** Stream Block Encryption / Decryption (ECB / CBC) */
+static void vStreamBlock(tsAES_stream* psStream, uint8* u8Block);
+
+/**
+ * 組込みのバックエンド
+ */
+static const tsAES_backend AES_BACKENDS[AES_BACKEND_CNT] = {
+	{"REF",      vCiphertext,    vInvCipher,    NULL,                NULL},
+	{"TABLE",    vCiphertextTbl, vInvCipherTbl, NULL,                NULL},
+	{"BITSLICE", vCiphertextBs,  vInvCipherBs,  vCiphertextBsBlocks, vInvCipherBsBlocks}
+};
+
+/** デフォルトバックエンド */
+static const tsAES_backend* psDefaultBackend = &AES_BACKENDS[AES_DEFAULT_BACKEND];
 
 /*****************************************************************************/
 /***        Exported Functions                                             ***/
@@ -191,6 +352,8 @@ PUBLIC tsAES_state vAES_newECBState(teAES_KeyLength eKeyLen, uint8* u8Key) {
 		sState.u8Nr = Nr_256;
 		break;
 	}
+	// バックエンドの初期化
+	sState.psBackend = psDefaultBackend;
 	// ラウンドキーの初期化
 	vInitRoundKey(&sState, u8Key);
 	// ベクトルの初期化
@@ -229,6 +392,8 @@ PUBLIC tsAES_state vAES_newCBCState(teAES_KeyLength eKeyLen, uint8* u8Key, uint8
 		sState.u8Nr = Nr_256;
 		break;
 	}
+	// バックエンドの初期化
+	sState.psBackend = psDefaultBackend;
 	// ラウンドキーの初期化
 	vInitRoundKey(&sState, u8Key);
 	// ベクトルの初期化
@@ -259,15 +424,16 @@ PUBLIC void vAES_encrypt(tsAES_state* sState, uint8* u8Buff, uint32 u32Len) {
 	// 最終ブロック直前まで暗号化
 	uint32 u32Idx;
 	if (sState->mode == AES_CIPHER_MODE_ECB) {
-		// ECBモード
-		for (u32Idx = 0; u32Idx < u32Len; u32Idx = u32Idx + AES_BLOCK_LEN) {
-			vCiphertext(sState, &u8Buff[u32Idx]);
-		}
+		// ECBモード（ブロック間の依存が無いので一括で処理）
+		vEncryptBlocks(sState, u8Buff, (u32Len + AES_BLOCK_LEN - 1) / AES_BLOCK_LEN);
+	} else if (sState->mode == AES_CIPHER_MODE_CTR) {
+		// CTRモード
+		vCTRCrypt(sState, u8Buff, u32Len);
 	} else {
 		// CBCモード
 		for (u32Idx = 0; u32Idx < u32Len; u32Idx = u32Idx + AES_BLOCK_LEN) {
 			vXorWithBlk(&u8Buff[u32Idx], sState->u8Vector);
-			vCiphertext(sState, &u8Buff[u32Idx]);
+			vEncryptBlock(sState, &u8Buff[u32Idx]);
 			memcpy(sState->u8Vector, &u8Buff[u32Idx], AES_BLOCK_LEN);
 		}
 	}
@@ -302,25 +468,330 @@ PUBLIC void vAES_encryptPad(tsAES_state* sState, uint8* u8Buff, uint32 u32Len) {
 PUBLIC void vAES_decrypt(tsAES_state* sState, uint8* u8Buff, uint32 u32Len) {
 	// 最終ブロック直前まで暗号化
 	if (sState->mode == AES_CIPHER_MODE_ECB) {
-		// ECBモード
-		uint32 u32Idx;
-		for (u32Idx = 0; u32Idx < u32Len; u32Idx += AES_BLOCK_LEN) {
-			vInvCipher(sState, &u8Buff[u32Idx]);
-		}
+		// ECBモード（ブロック間の依存が無いので一括で処理）
+		vDecryptBlocks(sState, u8Buff, (u32Len + AES_BLOCK_LEN - 1) / AES_BLOCK_LEN);
+	} else if (sState->mode == AES_CIPHER_MODE_CTR) {
+		// CTRモード（暗号化と同じ処理）
+		vCTRCrypt(sState, u8Buff, u32Len);
 	} else {
-		// CBCモード
-		uint8 u8StoreNextIv[AES_BLOCK_LEN];
+		// CBCモード（復号化はブロック間の依存が無いので、暗号文を退避して複数ブロック単位に処理）
+		uint8 u8Cipher[AES_BATCH_BLOCKS * AES_BLOCK_LEN];
 		uint32 u32Idx;
-		for (u32Idx = 0; u32Idx < u32Len; u32Idx += AES_BLOCK_LEN) {
-			memcpy(u8StoreNextIv, &u8Buff[u32Idx], AES_BLOCK_LEN);
-			vInvCipher(sState, &u8Buff[u32Idx]);
+		uint32 u32Size;
+		uint32 u32Pos;
+		for (u32Idx = 0; u32Idx < u32Len; u32Idx += u32Size) {
+			u32Size = (u32Len - u32Idx + AES_BLOCK_LEN - 1) & ~(uint32)(AES_BLOCK_LEN - 1);
+			if (u32Size > sizeof(u8Cipher)) {
+				u32Size = sizeof(u8Cipher);
+			}
+			memcpy(u8Cipher, &u8Buff[u32Idx], u32Size);
+			vDecryptBlocks(sState, &u8Buff[u32Idx], u32Size / AES_BLOCK_LEN);
 			vXorWithBlk(&u8Buff[u32Idx], sState->u8Vector);
-			memcpy(sState->u8Vector, u8StoreNextIv, AES_BLOCK_LEN);
+			for (u32Pos = AES_BLOCK_LEN; u32Pos < u32Size; u32Pos += AES_BLOCK_LEN) {
+				vXorWithBlk(&u8Buff[u32Idx + u32Pos], &u8Cipher[u32Pos - AES_BLOCK_LEN]);
+			}
+			memcpy(sState->u8Vector, &u8Cipher[u32Size - AES_BLOCK_LEN], AES_BLOCK_LEN);
 		}
 	}
 	// 末尾のパディング部のクリアはしない
 }
 
+/**
+ * AES処理ステータスを保持する変数の生成（CCMモード）
+ *
+ * @param teAES_KeyLength 鍵長
+ * @param uint8* 鍵
+ * @return tsAES_state ステータス
+ */
+PUBLIC tsAES_state vAES_newCCMState(teAES_KeyLength eKeyLen, uint8* u8Key) {
+	// ECBモードと同じ鍵の初期化を行う
+	tsAES_state sState = vAES_newECBState(eKeyLen, u8Key);
+	// CCMモード
+	sState.mode = AES_CIPHER_MODE_CCM;
+	// 初期化した値を返却
+	return sState;
+}
+
+/**
+ * 認証付き暗号化処理（CCMモード）
+ *
+ * @param tsAES_state ステータス
+ * @param uint8* ノンス
+ * @param uint8 ノンス長
+ * @param uint8* 追加認証データ
+ * @param uint32 追加認証データ長
+ * @param uint8* 暗号化対象
+ * @param uint32 暗号化対象バイト数
+ * @param uint8* 認証タグの出力先
+ * @param uint8 認証タグ長
+ */
+PUBLIC void vAES_encryptCCM(tsAES_state* sState, uint8* u8Nonce, uint8 u8NonceLen,
+		uint8* u8Aad, uint32 u32AadLen, uint8* u8Buff, uint32 u32Len, uint8* u8Tag, uint8 u8TagLen) {
+	// CBC-MACの初期化
+	uint8 u8Mac[AES_BLOCK_LEN];
+	vCCMInitMac(sState, u8Mac, u8Nonce, u8NonceLen, u8Aad, u32AadLen, u32Len, u8TagLen);
+	// 平文でCBC-MACを更新しながらCTRモードで暗号化
+	vCCMCrypt(sState, u8Mac, u8Nonce, u8NonceLen, u8Buff, u32Len, TRUE);
+	// 認証タグの算出（CBC-MACをカウンタ0の鍵ストリームで暗号化）
+	uint8 u8Ctr[AES_BLOCK_LEN];
+	vCCMSetCounter(u8Ctr, u8Nonce, u8NonceLen, 0);
+	vEncryptBlock(sState, u8Ctr);
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < u8TagLen; u8Idx++) {
+		u8Tag[u8Idx] = u8Mac[u8Idx] ^ u8Ctr[u8Idx];
+	}
+}
+
+/**
+ * 認証付き復号化処理（CCMモード）
+ *
+ * @param tsAES_state ステータス
+ * @param uint8* ノンス
+ * @param uint8 ノンス長
+ * @param uint8* 追加認証データ
+ * @param uint32 追加認証データ長
+ * @param uint8* 復号化対象
+ * @param uint32 復号化対象バイト数
+ * @param uint8* 受信した認証タグ
+ * @param uint8 認証タグ長
+ * @return bool_t TRUE:認証成功
+ */
+PUBLIC bool_t bAES_decryptCCM(tsAES_state* sState, uint8* u8Nonce, uint8 u8NonceLen,
+		uint8* u8Aad, uint32 u32AadLen, uint8* u8Buff, uint32 u32Len, uint8* u8Tag, uint8 u8TagLen) {
+	// CBC-MACの初期化
+	uint8 u8Mac[AES_BLOCK_LEN];
+	vCCMInitMac(sState, u8Mac, u8Nonce, u8NonceLen, u8Aad, u32AadLen, u32Len, u8TagLen);
+	// CTRモードで復号化しながら平文でCBC-MACを更新
+	vCCMCrypt(sState, u8Mac, u8Nonce, u8NonceLen, u8Buff, u32Len, FALSE);
+	// 認証タグの算出
+	uint8 u8Ctr[AES_BLOCK_LEN];
+	vCCMSetCounter(u8Ctr, u8Nonce, u8NonceLen, 0);
+	vEncryptBlock(sState, u8Ctr);
+	// 認証タグの比較（処理時間から一致バイト数が推測されない様に全バイトを比較）
+	uint8 u8Diff = 0;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < u8TagLen; u8Idx++) {
+		u8Diff |= u8Tag[u8Idx] ^ u8Mac[u8Idx] ^ u8Ctr[u8Idx];
+	}
+	if (u8Diff != 0) {
+		// 改竄された平文を利用されない様にクリア
+		memset(u8Buff, 0x00, u32Len);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/**
+ * AES処理ステータスを保持する変数の生成（CTRモード）
+ *
+ * @param teAES_KeyLength 鍵長
+ * @param uint8* 鍵
+ * @param uint8* カウンタ初期値
+ * @return tsAES_state ステータス
+ */
+PUBLIC tsAES_state vAES_newCTRState(teAES_KeyLength eKeyLen, uint8* u8Key, uint8* u8Counter) {
+	// ECBモードと同じ鍵の初期化を行う
+	tsAES_state sState = vAES_newECBState(eKeyLen, u8Key);
+	// CTRモード
+	sState.mode = AES_CIPHER_MODE_CTR;
+	// カウンタの初期化
+	vAES_setVector(&sState, u8Counter);
+	// 初期化した値を返却
+	return sState;
+}
+
+/**
+ * ストリーム処理の開始
+ *
+ * @param tsAES_stream ストリーム処理状態
+ * @param tsAES_state ステータス
+ * @param bool_t TRUE:暗号化、FALSE:復号化
+ * @param bool_t TRUE:PKCS#7でパディング
+ */
+PUBLIC void vAES_streamInit(tsAES_stream* psStream, tsAES_state* psState, bool_t bEncrypt, bool_t bPadding) {
+	psStream->psState  = psState;
+	psStream->bEncrypt = bEncrypt;
+	psStream->bPadding = bPadding;
+	memset(psStream->u8Block, 0x00, AES_BLOCK_LEN);
+	// ブロックバッファのバイト数
+	// CTRモードでは鍵ストリームの使用済みバイト数（初期状態は鍵ストリーム無し）
+	if (psState->mode == AES_CIPHER_MODE_CTR) {
+		psStream->u8BlockLen = AES_BLOCK_LEN;
+	} else {
+		psStream->u8BlockLen = 0;
+	}
+}
+
+/**
+ * ストリーム処理（データの追加）
+ *
+ * @param tsAES_stream ストリーム処理状態
+ * @param uint8* 入力データ
+ * @param uint8* 出力先
+ * @param uint32 入力バイト数
+ * @return uint32 出力バイト数
+ */
+PUBLIC uint32 u32AES_streamUpdate(tsAES_stream* psStream, uint8* u8In, uint8* u8Out, uint32 u32Len) {
+	tsAES_state* sState = psStream->psState;
+	uint32 u32InIdx = 0;
+	uint32 u32OutIdx = 0;
+	//--------------------------------------------------------------------------
+	// CTRモード（鍵ストリームとXORするだけなので入力と同じ位置に出力）
+	//--------------------------------------------------------------------------
+	if (sState->mode == AES_CIPHER_MODE_CTR) {
+		while (u32InIdx < u32Len) {
+			// 鍵ストリームの生成
+			if (psStream->u8BlockLen == AES_BLOCK_LEN) {
+				memcpy(psStream->u8Block, sState->u8Vector, AES_BLOCK_LEN);
+				vEncryptBlock(sState, psStream->u8Block);
+				vIncCounter(sState->u8Vector);
+				psStream->u8BlockLen = 0;
+			}
+			u8Out[u32InIdx] = u8In[u32InIdx] ^ psStream->u8Block[psStream->u8BlockLen++];
+			u32InIdx++;
+		}
+		return u32Len;
+	}
+	//--------------------------------------------------------------------------
+	// ECB / CBCモード
+	//--------------------------------------------------------------------------
+	// パディング付きの復号化の場合、パディングを除去する為に最終ブロックを保留する
+	uint8 u8Hold = (psStream->bEncrypt == FALSE && psStream->bPadding) ? 1 : 0;
+	uint32 u32Remain;
+	uint8 u8CpyLen;
+	uint8 u8Next[AES_BLOCK_LEN];
+	while (u32InIdx < u32Len) {
+		u32Remain = u32Len - u32InIdx;
+		// 端数無し：入力から出力へ直接処理
+		if (psStream->u8BlockLen == 0 && u32Remain >= (uint32)(AES_BLOCK_LEN + u8Hold)) {
+			if (&u8Out[u32OutIdx] != &u8In[u32InIdx]) {
+				memmove(&u8Out[u32OutIdx], &u8In[u32InIdx], AES_BLOCK_LEN);
+			}
+			vStreamBlock(psStream, &u8Out[u32OutIdx]);
+			u32InIdx  += AES_BLOCK_LEN;
+			u32OutIdx += AES_BLOCK_LEN;
+			continue;
+		}
+		// 保留中のブロックを出力
+		// 入力と出力が同じバッファの場合に上書きされない様、次の入力を先に退避してから出力する
+		if (psStream->u8BlockLen == AES_BLOCK_LEN) {
+			u8CpyLen = (u32Remain < AES_BLOCK_LEN) ? (uint8)u32Remain : AES_BLOCK_LEN;
+			memcpy(u8Next, &u8In[u32InIdx], u8CpyLen);
+			vStreamBlock(psStream, psStream->u8Block);
+			memcpy(&u8Out[u32OutIdx], psStream->u8Block, AES_BLOCK_LEN);
+			u32OutIdx += AES_BLOCK_LEN;
+			memcpy(psStream->u8Block, u8Next, u8CpyLen);
+			psStream->u8BlockLen = u8CpyLen;
+			u32InIdx += u8CpyLen;
+			continue;
+		}
+		// 端数をブロックバッファに蓄積
+		u8CpyLen = AES_BLOCK_LEN - psStream->u8BlockLen;
+		if (u32Remain < u8CpyLen) {
+			u8CpyLen = u32Remain;
+		}
+		memcpy(&psStream->u8Block[psStream->u8BlockLen], &u8In[u32InIdx], u8CpyLen);
+		psStream->u8BlockLen += u8CpyLen;
+		u32InIdx += u8CpyLen;
+		// ブロックが揃った時点で出力
+		if (psStream->u8BlockLen == AES_BLOCK_LEN && u8Hold == 0) {
+			vStreamBlock(psStream, psStream->u8Block);
+			memcpy(&u8Out[u32OutIdx], psStream->u8Block, AES_BLOCK_LEN);
+			u32OutIdx += AES_BLOCK_LEN;
+			psStream->u8BlockLen = 0;
+		}
+	}
+	return u32OutIdx;
+}
+
+/**
+ * ストリーム処理の終了
+ *
+ * @param tsAES_stream ストリーム処理状態
+ * @param uint8* 出力先
+ * @return int 出力バイト数、端数ブロックやパディングが不正な場合は-1
+ */
+PUBLIC int iAES_streamFinal(tsAES_stream* psStream, uint8* u8Out) {
+	int iResult = 0;
+	uint8 u8PadSize;
+	uint8 u8Idx;
+	if (psStream->psState->mode == AES_CIPHER_MODE_CTR) {
+		// CTRモードは出力済み
+		iResult = 0;
+	} else if (psStream->bEncrypt) {
+		if (psStream->bPadding) {
+			// パディング処理(PKCS#7)
+			u8PadSize = AES_BLOCK_LEN - psStream->u8BlockLen;
+			memset(&psStream->u8Block[psStream->u8BlockLen], u8PadSize, u8PadSize);
+			vStreamBlock(psStream, psStream->u8Block);
+			memcpy(u8Out, psStream->u8Block, AES_BLOCK_LEN);
+			iResult = AES_BLOCK_LEN;
+		} else if (psStream->u8BlockLen > 0) {
+			// 端数ブロックエラー
+			iResult = -1;
+		}
+	} else if (psStream->bPadding) {
+		// 保留中の最終ブロックを復号化してパディングを除去
+		if (psStream->u8BlockLen != AES_BLOCK_LEN) {
+			iResult = -1;
+		} else {
+			vStreamBlock(psStream, psStream->u8Block);
+			u8PadSize = psStream->u8Block[AES_BLOCK_LEN - 1];
+			iResult = AES_BLOCK_LEN - u8PadSize;
+			if (u8PadSize == 0 || u8PadSize > AES_BLOCK_LEN) {
+				iResult = -1;
+			}
+			for (u8Idx = 1; iResult >= 0 && u8Idx < u8PadSize; u8Idx++) {
+				if (psStream->u8Block[AES_BLOCK_LEN - 1 - u8Idx] != u8PadSize) {
+					iResult = -1;
+				}
+			}
+			if (iResult > 0) {
+				memcpy(u8Out, psStream->u8Block, iResult);
+			}
+		}
+	} else if (psStream->u8BlockLen > 0) {
+		// 端数ブロックエラー
+		iResult = -1;
+	}
+	// ブロックバッファのクリア
+	memset(psStream->u8Block, 0x00, AES_BLOCK_LEN);
+	psStream->u8BlockLen = 0;
+	return iResult;
+}
+
+/**
+ * 組込みバックエンドの取得
+ *
+ * @param teAES_Backend バックエンド種別
+ * @return tsAES_backend* バックエンド、種別が不正な場合はNULL
+ */
+PUBLIC const tsAES_backend* psAES_getBackend(teAES_Backend eBackend) {
+	if (eBackend >= AES_BACKEND_CNT) {
+		return NULL;
+	}
+	return &AES_BACKENDS[eBackend];
+}
+
+/**
+ * デフォルトバックエンドの設定
+ *
+ * @param tsAES_backend* バックエンド
+ */
+PUBLIC void vAES_setDefaultBackend(const tsAES_backend* psBackend) {
+	psDefaultBackend = psBackend;
+}
+
+/**
+ * バックエンドの設定
+ *
+ * @param tsAES_state ステータス
+ * @param tsAES_backend* バックエンド
+ */
+PUBLIC void vAES_setBackend(tsAES_state* sState, const tsAES_backend* psBackend) {
+	sState->psBackend = psBackend;
+}
+
 /*****************************************************************************/
 /***        Local Functions                                                ***/
 /*****************************************************************************/
@@ -446,6 +917,680 @@ static void vInvCipher(tsAES_state* sState, uint8* u8Buff) {
 	vAddRoundKey(u8Buff, sState, u8Round);
 }
 
+/**
+ * ブロック単位の暗号化処理（テーブル参照版）
+ * 列毎の32bitワード単位にSubBytes、ShiftRows、MixColumnsをテーブル参照で一括して行う
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 暗号化対象
+ */
+static void vCiphertextTbl(tsAES_state* sState, uint8* u8Buff) {
+	uint8* u8Key = sState->u8RoundKey;
+	// 列単位に読み込み、ラウンドキーの値をXOR
+	uint32 s0 = AES_LOAD32(&u8Buff[0])  ^ AES_LOAD32(&u8Key[0]);
+	uint32 s1 = AES_LOAD32(&u8Buff[4])  ^ AES_LOAD32(&u8Key[4]);
+	uint32 s2 = AES_LOAD32(&u8Buff[8])  ^ AES_LOAD32(&u8Key[8]);
+	uint32 s3 = AES_LOAD32(&u8Buff[12]) ^ AES_LOAD32(&u8Key[12]);
+	uint32 t0, t1, t2, t3;
+	uint8 u8Round;
+	for (u8Round = 1; u8Round < sState->u8Nr; u8Round++) {
+		u8Key += AES_BLOCK_LEN;
+		t0 = TE_TABLE[s0 >> 24] ^ AES_ROTR(TE_TABLE[(s1 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(TE_TABLE[(s2 >> 8) & 0xff], 16) ^ AES_ROTR(TE_TABLE[s3 & 0xff], 24) ^ AES_LOAD32(&u8Key[0]);
+		t1 = TE_TABLE[s1 >> 24] ^ AES_ROTR(TE_TABLE[(s2 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(TE_TABLE[(s3 >> 8) & 0xff], 16) ^ AES_ROTR(TE_TABLE[s0 & 0xff], 24) ^ AES_LOAD32(&u8Key[4]);
+		t2 = TE_TABLE[s2 >> 24] ^ AES_ROTR(TE_TABLE[(s3 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(TE_TABLE[(s0 >> 8) & 0xff], 16) ^ AES_ROTR(TE_TABLE[s1 & 0xff], 24) ^ AES_LOAD32(&u8Key[8]);
+		t3 = TE_TABLE[s3 >> 24] ^ AES_ROTR(TE_TABLE[(s0 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(TE_TABLE[(s1 >> 8) & 0xff], 16) ^ AES_ROTR(TE_TABLE[s2 & 0xff], 24) ^ AES_LOAD32(&u8Key[12]);
+		s0 = t0;
+		s1 = t1;
+		s2 = t2;
+		s3 = t3;
+	}
+	// 最終ラウンド（MixColumnsは行わない）
+	u8Key += AES_BLOCK_LEN;
+	t0 = ((uint32)S_BOX[s0 >> 24] << 24) | ((uint32)S_BOX[(s1 >> 16) & 0xff] << 16)
+	   | ((uint32)S_BOX[(s2 >> 8) & 0xff] << 8) | (uint32)S_BOX[s3 & 0xff];
+	t1 = ((uint32)S_BOX[s1 >> 24] << 24) | ((uint32)S_BOX[(s2 >> 16) & 0xff] << 16)
+	   | ((uint32)S_BOX[(s3 >> 8) & 0xff] << 8) | (uint32)S_BOX[s0 & 0xff];
+	t2 = ((uint32)S_BOX[s2 >> 24] << 24) | ((uint32)S_BOX[(s3 >> 16) & 0xff] << 16)
+	   | ((uint32)S_BOX[(s0 >> 8) & 0xff] << 8) | (uint32)S_BOX[s1 & 0xff];
+	t3 = ((uint32)S_BOX[s3 >> 24] << 24) | ((uint32)S_BOX[(s0 >> 16) & 0xff] << 16)
+	   | ((uint32)S_BOX[(s1 >> 8) & 0xff] << 8) | (uint32)S_BOX[s2 & 0xff];
+	t0 ^= AES_LOAD32(&u8Key[0]);
+	t1 ^= AES_LOAD32(&u8Key[4]);
+	t2 ^= AES_LOAD32(&u8Key[8]);
+	t3 ^= AES_LOAD32(&u8Key[12]);
+	AES_STORE32(&u8Buff[0],  t0);
+	AES_STORE32(&u8Buff[4],  t1);
+	AES_STORE32(&u8Buff[8],  t2);
+	AES_STORE32(&u8Buff[12], t3);
+}
+
+/**
+ * ブロック単位の復号化処理（テーブル参照版）
+ * InvShiftRowsとInvSubBytesは列単位のバイト置換、InvMixColumnsはテーブル参照で行う
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 復号化対象
+ */
+static void vInvCipherTbl(tsAES_state* sState, uint8* u8Buff) {
+	uint8* u8Key = &sState->u8RoundKey[sState->u8Nr * AES_BLOCK_LEN];
+	// 列単位に読み込み、最終ラウンドのラウンドキーの値をXOR
+	uint32 s0 = AES_LOAD32(&u8Buff[0])  ^ AES_LOAD32(&u8Key[0]);
+	uint32 s1 = AES_LOAD32(&u8Buff[4])  ^ AES_LOAD32(&u8Key[4]);
+	uint32 s2 = AES_LOAD32(&u8Buff[8])  ^ AES_LOAD32(&u8Key[8]);
+	uint32 s3 = AES_LOAD32(&u8Buff[12]) ^ AES_LOAD32(&u8Key[12]);
+	uint32 t0, t1, t2, t3;
+	uint8 u8Round;
+	for (u8Round = sState->u8Nr; u8Round > 1; u8Round--) {
+		u8Key -= AES_BLOCK_LEN;
+		// InvShiftRows、InvSubBytes、AddRoundKey
+		t0 = (((uint32)INV_S_BOX[s0 >> 24] << 24) | ((uint32)INV_S_BOX[(s3 >> 16) & 0xff] << 16)
+		   | ((uint32)INV_S_BOX[(s2 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s1 & 0xff]) ^ AES_LOAD32(&u8Key[0]);
+		t1 = (((uint32)INV_S_BOX[s1 >> 24] << 24) | ((uint32)INV_S_BOX[(s0 >> 16) & 0xff] << 16)
+		   | ((uint32)INV_S_BOX[(s3 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s2 & 0xff]) ^ AES_LOAD32(&u8Key[4]);
+		t2 = (((uint32)INV_S_BOX[s2 >> 24] << 24) | ((uint32)INV_S_BOX[(s1 >> 16) & 0xff] << 16)
+		   | ((uint32)INV_S_BOX[(s0 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s3 & 0xff]) ^ AES_LOAD32(&u8Key[8]);
+		t3 = (((uint32)INV_S_BOX[s3 >> 24] << 24) | ((uint32)INV_S_BOX[(s2 >> 16) & 0xff] << 16)
+		   | ((uint32)INV_S_BOX[(s1 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s0 & 0xff]) ^ AES_LOAD32(&u8Key[12]);
+		// InvMixColumns
+		s0 = INV_MIX_TABLE[t0 >> 24] ^ AES_ROTR(INV_MIX_TABLE[(t0 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(INV_MIX_TABLE[(t0 >> 8) & 0xff], 16) ^ AES_ROTR(INV_MIX_TABLE[t0 & 0xff], 24);
+		s1 = INV_MIX_TABLE[t1 >> 24] ^ AES_ROTR(INV_MIX_TABLE[(t1 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(INV_MIX_TABLE[(t1 >> 8) & 0xff], 16) ^ AES_ROTR(INV_MIX_TABLE[t1 & 0xff], 24);
+		s2 = INV_MIX_TABLE[t2 >> 24] ^ AES_ROTR(INV_MIX_TABLE[(t2 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(INV_MIX_TABLE[(t2 >> 8) & 0xff], 16) ^ AES_ROTR(INV_MIX_TABLE[t2 & 0xff], 24);
+		s3 = INV_MIX_TABLE[t3 >> 24] ^ AES_ROTR(INV_MIX_TABLE[(t3 >> 16) & 0xff], 8)
+		   ^ AES_ROTR(INV_MIX_TABLE[(t3 >> 8) & 0xff], 16) ^ AES_ROTR(INV_MIX_TABLE[t3 & 0xff], 24);
+	}
+	// 最終ラウンド（InvMixColumnsは行わない）
+	u8Key -= AES_BLOCK_LEN;
+	t0 = (((uint32)INV_S_BOX[s0 >> 24] << 24) | ((uint32)INV_S_BOX[(s3 >> 16) & 0xff] << 16)
+	   | ((uint32)INV_S_BOX[(s2 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s1 & 0xff]) ^ AES_LOAD32(&u8Key[0]);
+	t1 = (((uint32)INV_S_BOX[s1 >> 24] << 24) | ((uint32)INV_S_BOX[(s0 >> 16) & 0xff] << 16)
+	   | ((uint32)INV_S_BOX[(s3 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s2 & 0xff]) ^ AES_LOAD32(&u8Key[4]);
+	t2 = (((uint32)INV_S_BOX[s2 >> 24] << 24) | ((uint32)INV_S_BOX[(s1 >> 16) & 0xff] << 16)
+	   | ((uint32)INV_S_BOX[(s0 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s3 & 0xff]) ^ AES_LOAD32(&u8Key[8]);
+	t3 = (((uint32)INV_S_BOX[s3 >> 24] << 24) | ((uint32)INV_S_BOX[(s2 >> 16) & 0xff] << 16)
+	   | ((uint32)INV_S_BOX[(s1 >> 8) & 0xff] << 8) | (uint32)INV_S_BOX[s0 & 0xff]) ^ AES_LOAD32(&u8Key[12]);
+	AES_STORE32(&u8Buff[0],  t0);
+	AES_STORE32(&u8Buff[4],  t1);
+	AES_STORE32(&u8Buff[8],  t2);
+	AES_STORE32(&u8Buff[12], t3);
+}
+
+/**
+ * ブロック単位の暗号化処理（バックエンドの呼び出し）
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 暗号化対象
+ */
+static void vEncryptBlock(tsAES_state* sState, uint8* u8Buff) {
+	sState->psBackend->pfEncryptBlock(sState, u8Buff);
+}
+
+/**
+ * ブロック単位の復号化処理（バックエンドの呼び出し）
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 復号化対象
+ */
+static void vDecryptBlock(tsAES_state* sState, uint8* u8Buff) {
+	sState->psBackend->pfDecryptBlock(sState, u8Buff);
+}
+
+/**
+ * 複数ブロックの暗号化処理（バックエンドの呼び出し）
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 暗号化対象
+ * @param uint32 ブロック数
+ */
+static void vEncryptBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt) {
+	if (sState->psBackend->pfEncryptBlocks != NULL) {
+		sState->psBackend->pfEncryptBlocks(sState, u8Buff, u32BlockCnt);
+		return;
+	}
+	for (; u32BlockCnt > 0; u32BlockCnt--, u8Buff += AES_BLOCK_LEN) {
+		sState->psBackend->pfEncryptBlock(sState, u8Buff);
+	}
+}
+
+/**
+ * 複数ブロックの復号化処理（バックエンドの呼び出し）
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 復号化対象
+ * @param uint32 ブロック数
+ */
+static void vDecryptBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt) {
+	if (sState->psBackend->pfDecryptBlocks != NULL) {
+		sState->psBackend->pfDecryptBlocks(sState, u8Buff, u32BlockCnt);
+		return;
+	}
+	for (; u32BlockCnt > 0; u32BlockCnt--, u8Buff += AES_BLOCK_LEN) {
+		sState->psBackend->pfDecryptBlock(sState, u8Buff);
+	}
+}
+
+/**
+ * ブロック単位の暗号化処理（ビットスライス版）
+ * 1ブロックのみの場合も8ブロック分の処理を行うので、複数ブロックをまとめて処理する事
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 暗号化対象
+ */
+static void vCiphertextBs(tsAES_state* sState, uint8* u8Buff) {
+	vCiphertextBsBlocks(sState, u8Buff, 1);
+}
+
+/**
+ * ブロック単位の復号化処理（ビットスライス版）
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 復号化対象
+ */
+static void vInvCipherBs(tsAES_state* sState, uint8* u8Buff) {
+	vInvCipherBsBlocks(sState, u8Buff, 1);
+}
+
+/**
+ * 複数ブロックの暗号化処理（ビットスライス版）
+ * 8ブロック単位に並列処理し、端数は作業領域で8ブロックに拡張して処理する
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 暗号化対象
+ * @param uint32 ブロック数
+ */
+static void vCiphertextBsBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt) {
+	uint8 u8Work[AES_BATCH_BLOCKS * AES_BLOCK_LEN];
+	for (; u32BlockCnt >= AES_BATCH_BLOCKS; u32BlockCnt -= AES_BATCH_BLOCKS) {
+		vBsCipher8(sState, u8Buff);
+		u8Buff += AES_BATCH_BLOCKS * AES_BLOCK_LEN;
+	}
+	if (u32BlockCnt > 0) {
+		memset(u8Work, 0x00, sizeof(u8Work));
+		memcpy(u8Work, u8Buff, u32BlockCnt * AES_BLOCK_LEN);
+		vBsCipher8(sState, u8Work);
+		memcpy(u8Buff, u8Work, u32BlockCnt * AES_BLOCK_LEN);
+	}
+}
+
+/**
+ * 複数ブロックの復号化処理（ビットスライス版）
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 復号化対象
+ * @param uint32 ブロック数
+ */
+static void vInvCipherBsBlocks(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt) {
+	uint8 u8Work[AES_BATCH_BLOCKS * AES_BLOCK_LEN];
+	for (; u32BlockCnt >= AES_BATCH_BLOCKS; u32BlockCnt -= AES_BATCH_BLOCKS) {
+		vBsInvCipher8(sState, u8Buff);
+		u8Buff += AES_BATCH_BLOCKS * AES_BLOCK_LEN;
+	}
+	if (u32BlockCnt > 0) {
+		memset(u8Work, 0x00, sizeof(u8Work));
+		memcpy(u8Work, u8Buff, u32BlockCnt * AES_BLOCK_LEN);
+		vBsInvCipher8(sState, u8Work);
+		memcpy(u8Buff, u8Work, u32BlockCnt * AES_BLOCK_LEN);
+	}
+}
+
+/**
+ * 8ブロック単位の暗号化処理（ビットスライス版）
+ * 全ての処理がビット演算のみで、テーブル参照や入力値による分岐が無いので、
+ * 処理時間やキャッシュの挙動から鍵や平文が推測されない
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 暗号化対象（8ブロック）
+ */
+static void vBsCipher8(tsAES_state* sState, uint8* u8Blocks) {
+	uint32 q[4][8];
+	uint8 u8Round;
+	vBsPack(q, u8Blocks);
+	vBsAddRoundKey(q, &sState->u8RoundKey[0]);
+	for (u8Round = 1; u8Round < sState->u8Nr; u8Round++) {
+		vBsSubBytes(q);
+		vBsShiftRows(q);
+		vBsMixColumns(q);
+		vBsAddRoundKey(q, &sState->u8RoundKey[u8Round * AES_BLOCK_LEN]);
+	}
+	vBsSubBytes(q);
+	vBsShiftRows(q);
+	vBsAddRoundKey(q, &sState->u8RoundKey[sState->u8Nr * AES_BLOCK_LEN]);
+	vBsUnpack(u8Blocks, q);
+}
+
+/**
+ * 8ブロック単位の復号化処理（ビットスライス版）
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 復号化対象（8ブロック）
+ */
+static void vBsInvCipher8(tsAES_state* sState, uint8* u8Blocks) {
+	uint32 q[4][8];
+	uint8 u8Round;
+	vBsPack(q, u8Blocks);
+	vBsAddRoundKey(q, &sState->u8RoundKey[sState->u8Nr * AES_BLOCK_LEN]);
+	for (u8Round = (sState->u8Nr - 1); u8Round > 0; u8Round--) {
+		vBsInvShiftRows(q);
+		vBsInvSubBytes(q);
+		vBsAddRoundKey(q, &sState->u8RoundKey[u8Round * AES_BLOCK_LEN]);
+		vBsInvMixColumns(q);
+	}
+	vBsInvShiftRows(q);
+	vBsInvSubBytes(q);
+	vBsAddRoundKey(q, &sState->u8RoundKey[0]);
+	vBsUnpack(u8Blocks, q);
+}
+
+/**
+ * 8ブロック分のビットスライス表現への変換
+ * q[行][ビット]の各32bitワードには、列c（8c～8c+7ビット目）の位置に8ブロック分の同じビットを格納する
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ * @param uint8* 変換対象（8ブロック）
+ */
+static void vBsPack(uint32 q[4][8], uint8* u8Blocks) {
+	uint8 u8Row, u8Col, u8Idx;
+	uint64 x;
+	memset(q, 0x00, sizeof(uint32) * 4 * 8);
+	for (u8Row = 0; u8Row < 4; u8Row++) {
+		for (u8Col = 0; u8Col < 4; u8Col++) {
+			// 8ブロック分の同じ位置のバイトを集めて、ビット単位に転置
+			x = 0;
+			for (u8Idx = 0; u8Idx < AES_BATCH_BLOCKS; u8Idx++) {
+				x |= (uint64)u8Blocks[u8Idx * AES_BLOCK_LEN + u8Col * 4 + u8Row] << (u8Idx * 8);
+			}
+			x = u64BsTranspose(x);
+			for (u8Idx = 0; u8Idx < 8; u8Idx++) {
+				q[u8Row][u8Idx] |= (uint32)((x >> (u8Idx * 8)) & 0xff) << (u8Col * 8);
+			}
+		}
+	}
+}
+
+/**
+ * ビットスライス表現から8ブロック分のバイト列への変換
+ *
+ * @param uint8* 変換結果（8ブロック）
+ * @param uint32 q[4][8] ビットスライス表現
+ */
+static void vBsUnpack(uint8* u8Blocks, uint32 q[4][8]) {
+	uint8 u8Row, u8Col, u8Idx;
+	uint64 x;
+	for (u8Row = 0; u8Row < 4; u8Row++) {
+		for (u8Col = 0; u8Col < 4; u8Col++) {
+			x = 0;
+			for (u8Idx = 0; u8Idx < 8; u8Idx++) {
+				x |= (uint64)((q[u8Row][u8Idx] >> (u8Col * 8)) & 0xff) << (u8Idx * 8);
+			}
+			x = u64BsTranspose(x);
+			for (u8Idx = 0; u8Idx < AES_BATCH_BLOCKS; u8Idx++) {
+				u8Blocks[u8Idx * AES_BLOCK_LEN + u8Col * 4 + u8Row] = (uint8)(x >> (u8Idx * 8));
+			}
+		}
+	}
+}
+
+/**
+ * 8×8ビット行列の転置（iバイト目のjビット目とjバイト目のiビット目を入れ替える）
+ *
+ * @param uint64 転置対象
+ * @return uint64 転置結果
+ */
+static uint64 u64BsTranspose(uint64 x) {
+	uint64 t;
+	t = (x ^ (x >> 7))  & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+	return x;
+}
+
+/**
+ * ビットスライス表現でのAddRoundKey
+ * ラウンドキーの各ビットを分岐無しのマスクに変換して8ブロック分に展開する
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ * @param uint8* ラウンドキー（1ブロック分）
+ */
+static void vBsAddRoundKey(uint32 q[4][8], uint8* u8Key) {
+	uint8 u8Row, u8Col, u8Bit;
+	uint32 u32Key;
+	for (u8Row = 0; u8Row < 4; u8Row++) {
+		for (u8Col = 0; u8Col < 4; u8Col++) {
+			u32Key = u8Key[u8Col * 4 + u8Row];
+			for (u8Bit = 0; u8Bit < 8; u8Bit++) {
+				q[u8Row][u8Bit] ^= ((0 - ((u32Key >> u8Bit) & 0x01)) & 0xff) << (u8Col * 8);
+			}
+		}
+	}
+}
+
+/**
+ * ビットスライス表現でのSubBytes
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ */
+static void vBsSubBytes(uint32 q[4][8]) {
+	uint8 u8Row;
+	for (u8Row = 0; u8Row < 4; u8Row++) {
+		vBsSbox(q[u8Row]);
+	}
+}
+
+/**
+ * ビットスライス表現でのInvSubBytes
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ */
+static void vBsInvSubBytes(uint32 q[4][8]) {
+	uint8 u8Row;
+	for (u8Row = 0; u8Row < 4; u8Row++) {
+		vBsInvSbox(q[u8Row]);
+	}
+}
+
+/**
+ * ビットスライス表現でのShiftRows（行毎に列単位でローテート）
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ */
+static void vBsShiftRows(uint32 q[4][8]) {
+	uint8 u8Row, u8Bit;
+	for (u8Row = 1; u8Row < 4; u8Row++) {
+		for (u8Bit = 0; u8Bit < 8; u8Bit++) {
+			q[u8Row][u8Bit] = AES_ROTR(q[u8Row][u8Bit], u8Row * 8);
+		}
+	}
+}
+
+/**
+ * ビットスライス表現でのInvShiftRows
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ */
+static void vBsInvShiftRows(uint32 q[4][8]) {
+	uint8 u8Row, u8Bit;
+	for (u8Row = 1; u8Row < 4; u8Row++) {
+		for (u8Bit = 0; u8Bit < 8; u8Bit++) {
+			q[u8Row][u8Bit] = AES_ROTR(q[u8Row][u8Bit], 32 - u8Row * 8);
+		}
+	}
+}
+
+/**
+ * ビットスライス表現での{02}倍（既約多項式0x11bによる剰余）
+ *
+ * @param uint32* 結果（8ビット分）
+ * @param uint32* 対象（8ビット分）
+ */
+static void vBsXtime(uint32* u32Out, uint32* u32In) {
+	uint32 u32Msb = u32In[7];
+	u32Out[7] = u32In[6];
+	u32Out[6] = u32In[5];
+	u32Out[5] = u32In[4];
+	u32Out[4] = u32In[3] ^ u32Msb;
+	u32Out[3] = u32In[2] ^ u32Msb;
+	u32Out[2] = u32In[1];
+	u32Out[1] = u32In[0] ^ u32Msb;
+	u32Out[0] = u32Msb;
+}
+
+/**
+ * ビットスライス表現でのMixColumns
+ * 行rの結果は {02}・(a[r] ^ a[r+1]) ^ a[r+1] ^ a[r+2] ^ a[r+3]
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ */
+static void vBsMixColumns(uint32 q[4][8]) {
+	uint32 a[4][8];
+	uint32 t[8];
+	uint8 u8Row, u8Bit;
+	memcpy(a, q, sizeof(a));
+	for (u8Row = 0; u8Row < 4; u8Row++) {
+		for (u8Bit = 0; u8Bit < 8; u8Bit++) {
+			t[u8Bit] = a[u8Row][u8Bit] ^ a[(u8Row + 1) & 3][u8Bit];
+		}
+		vBsXtime(q[u8Row], t);
+		for (u8Bit = 0; u8Bit < 8; u8Bit++) {
+			q[u8Row][u8Bit] ^= a[(u8Row + 1) & 3][u8Bit] ^ a[(u8Row + 2) & 3][u8Bit] ^ a[(u8Row + 3) & 3][u8Bit];
+		}
+	}
+}
+
+/**
+ * ビットスライス表現でのInvMixColumns
+ * InvMixColumnsの行列は MixColumns × {05, 00, 04, 00} の巡回行列に分解できるので、
+ * 前処理として a[r] ^ {04}・(a[r] ^ a[r+2]) を行ってからMixColumnsを適用する
+ *
+ * @param uint32 q[4][8] ビットスライス表現
+ */
+static void vBsInvMixColumns(uint32 q[4][8]) {
+	uint32 t[2][8];
+	uint8 u8Row, u8Bit;
+	for (u8Row = 0; u8Row < 2; u8Row++) {
+		for (u8Bit = 0; u8Bit < 8; u8Bit++) {
+			t[0][u8Bit] = q[u8Row][u8Bit] ^ q[u8Row + 2][u8Bit];
+		}
+		vBsXtime(t[1], t[0]);
+		vBsXtime(t[0], t[1]);
+		// a[r+2] ^ a[r]は行rと行r+2で共通
+		for (u8Bit = 0; u8Bit < 8; u8Bit++) {
+			q[u8Row][u8Bit]     ^= t[0][u8Bit];
+			q[u8Row + 2][u8Bit] ^= t[0][u8Bit];
+		}
+	}
+	vBsMixColumns(q);
+}
+
+/**
+ * ビットスライス表現でのS-BOX（1行分の8ビット）
+ * Boyar and Peralta "A new combinational logic minimization technique with
+ * applications to cryptology"(https://eprint.iacr.org/2009/191.pdf)の回路をそのまま実装
+ * テーブル参照が無いので、処理時間は入力値に依存しない
+ * 変数x*（入力）とs*（出力）は上位ビットから順に付番（x0が最上位ビット）
+ *
+ * @param uint32* 対象（8ビット分）
+ */
+static void vBsSbox(uint32* q) {
+	uint32 x0, x1, x2, x3, x4, x5, x6, x7;
+	uint32 y1, y2, y3, y4, y5, y6, y7, y8, y9;
+	uint32 y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+	uint32 y20, y21;
+	uint32 z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+	uint32 z10, z11, z12, z13, z14, z15, z16, z17;
+	uint32 t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+	uint32 t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+	uint32 t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+	uint32 t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+	uint32 t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+	uint32 t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+	uint32 t60, t61, t62, t63, t64, t65, t66, t67;
+	uint32 s0, s1, s2, s3, s4, s5, s6, s7;
+
+	x0 = q[7];
+	x1 = q[6];
+	x2 = q[5];
+	x3 = q[4];
+	x4 = q[3];
+	x5 = q[2];
+	x6 = q[1];
+	x7 = q[0];
+
+	// 入力側の線形変換
+	y14 = x3 ^ x5;
+	y13 = x0 ^ x6;
+	y9 = x0 ^ x3;
+	y8 = x0 ^ x5;
+	t0 = x1 ^ x2;
+	y1 = t0 ^ x7;
+	y4 = y1 ^ x3;
+	y12 = y13 ^ y14;
+	y2 = y1 ^ x0;
+	y5 = y1 ^ x6;
+	y3 = y5 ^ y8;
+	t1 = x4 ^ y12;
+	y15 = t1 ^ x5;
+	y20 = t1 ^ x1;
+	y6 = y15 ^ x7;
+	y10 = y15 ^ t0;
+	y11 = y20 ^ y9;
+	y7 = x7 ^ y11;
+	y17 = y10 ^ y11;
+	y19 = y10 ^ y8;
+	y16 = t0 ^ y11;
+	y21 = y13 ^ y16;
+	y18 = x0 ^ y16;
+
+	// 非線形部（GF(2^8)の逆元）
+	t2 = y12 & y15;
+	t3 = y3 & y6;
+	t4 = t3 ^ t2;
+	t5 = y4 & x7;
+	t6 = t5 ^ t2;
+	t7 = y13 & y16;
+	t8 = y5 & y1;
+	t9 = t8 ^ t7;
+	t10 = y2 & y7;
+	t11 = t10 ^ t7;
+	t12 = y9 & y11;
+	t13 = y14 & y17;
+	t14 = t13 ^ t12;
+	t15 = y8 & y10;
+	t16 = t15 ^ t12;
+	t17 = t4 ^ t14;
+	t18 = t6 ^ t16;
+	t19 = t9 ^ t14;
+	t20 = t11 ^ t16;
+	t21 = t17 ^ y20;
+	t22 = t18 ^ y19;
+	t23 = t19 ^ y21;
+	t24 = t20 ^ y18;
+
+	t25 = t21 ^ t22;
+	t26 = t21 & t23;
+	t27 = t24 ^ t26;
+	t28 = t25 & t27;
+	t29 = t28 ^ t22;
+	t30 = t23 ^ t24;
+	t31 = t22 ^ t26;
+	t32 = t31 & t30;
+	t33 = t32 ^ t24;
+	t34 = t23 ^ t33;
+	t35 = t27 ^ t33;
+	t36 = t24 & t35;
+	t37 = t36 ^ t34;
+	t38 = t27 ^ t36;
+	t39 = t29 & t38;
+	t40 = t25 ^ t39;
+
+	t41 = t40 ^ t37;
+	t42 = t29 ^ t33;
+	t43 = t29 ^ t40;
+	t44 = t33 ^ t37;
+	t45 = t42 ^ t41;
+	z0 = t44 & y15;
+	z1 = t37 & y6;
+	z2 = t33 & x7;
+	z3 = t43 & y16;
+	z4 = t40 & y1;
+	z5 = t29 & y7;
+	z6 = t42 & y11;
+	z7 = t45 & y17;
+	z8 = t41 & y10;
+	z9 = t44 & y12;
+	z10 = t37 & y3;
+	z11 = t33 & y4;
+	z12 = t43 & y13;
+	z13 = t40 & y5;
+	z14 = t29 & y2;
+	z15 = t42 & y9;
+	z16 = t45 & y14;
+	z17 = t41 & y8;
+
+	// 出力側の線形変換
+	t46 = z15 ^ z16;
+	t47 = z10 ^ z11;
+	t48 = z5 ^ z13;
+	t49 = z9 ^ z10;
+	t50 = z2 ^ z12;
+	t51 = z2 ^ z5;
+	t52 = z7 ^ z8;
+	t53 = z0 ^ z3;
+	t54 = z6 ^ z7;
+	t55 = z16 ^ z17;
+	t56 = z12 ^ t48;
+	t57 = t50 ^ t53;
+	t58 = z4 ^ t46;
+	t59 = z3 ^ t54;
+	t60 = t46 ^ t57;
+	t61 = z14 ^ t57;
+	t62 = t52 ^ t58;
+	t63 = t49 ^ t58;
+	t64 = z4 ^ t59;
+	t65 = t61 ^ t62;
+	t66 = z1 ^ t63;
+	s0 = t59 ^ t63;
+	s6 = t56 ^ ~t62;
+	s7 = t48 ^ ~t60;
+	t67 = t64 ^ t65;
+	s3 = t53 ^ t66;
+	s4 = t51 ^ t66;
+	s5 = t47 ^ t65;
+	s1 = t64 ^ ~s3;
+	s2 = t55 ^ ~t67;
+
+	q[7] = s0;
+	q[6] = s1;
+	q[5] = s2;
+	q[4] = s3;
+	q[3] = s4;
+	q[2] = s5;
+	q[1] = s6;
+	q[0] = s7;
+}
+
+/**
+ * ビットスライス表現での逆S-BOX（1行分の8ビット）
+ * S(x) = A(I(x)) ^ 0x63（I:逆元、A:アフィン変換の線形部）なので、
+ * Aの逆変換Bを用いて iS(x) = B(S(B(x ^ 0x63)) ^ 0x63) で求める
+ *
+ * @param uint32* 対象（8ビット分）
+ */
+static void vBsInvSbox(uint32* q) {
+	uint32 q0, q1, q2, q3, q4, q5, q6, q7;
+	uint8 u8Cnt;
+	for (u8Cnt = 0; u8Cnt < 2; u8Cnt++) {
+		// 0x63とのXORと逆アフィン変換（2回目はS-BOXの後）
+		q0 = ~q[0];
+		q1 = ~q[1];
+		q2 = q[2];
+		q3 = q[3];
+		q4 = q[4];
+		q5 = ~q[5];
+		q6 = ~q[6];
+		q7 = q[7];
+		q[7] = q1 ^ q4 ^ q6;
+		q[6] = q0 ^ q3 ^ q5;
+		q[5] = q7 ^ q2 ^ q4;
+		q[4] = q6 ^ q1 ^ q3;
+		q[3] = q5 ^ q0 ^ q2;
+		q[2] = q4 ^ q7 ^ q1;
+		q[1] = q3 ^ q6 ^ q0;
+		q[0] = q2 ^ q5 ^ q7;
+		if (u8Cnt == 0) {
+			vBsSbox(q);
+		}
+	}
+}
+
 /**
  * This function adds the round key to buffer.
  * 暗号化対象のラウンド数に対応したブロックにラウンドキーの値をXOR
@@ -701,3 +1846,196 @@ static uint8 vMultiply(uint8 u8x, uint8 u8y) {
 		 ((u8y>>3 & 1) * vXtime(vXtime(vXtime(u8x)))) ^
 		 ((u8y>>4 & 1) * vXtime(vXtime(vXtime(vXtime(u8x))))));
 }
+
+/**
+ * CCM CBC-MACの初期化処理
+ * 先頭ブロック（B0）と追加認証データでCBC-MACを算出する
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* CBC-MAC（出力）
+ * @param uint8* ノンス
+ * @param uint8 ノンス長
+ * @param uint8* 追加認証データ
+ * @param uint32 追加認証データ長
+ * @param uint32 メッセージ長
+ * @param uint8 認証タグ長
+ */
+static void vCCMInitMac(tsAES_state* sState, uint8* u8Mac, uint8* u8Nonce, uint8 u8NonceLen,
+		uint8* u8Aad, uint32 u32AadLen, uint32 u32Len, uint8 u8TagLen) {
+	// メッセージ長のフィールド長
+	uint8 u8L = AES_BLOCK_LEN - 1 - u8NonceLen;
+	// B0：フラグ（Adata | M' | L'）、ノンス、メッセージ長（ビッグエンディアン）
+	memset(u8Mac, 0x00, AES_BLOCK_LEN);
+	u8Mac[0] = (((u32AadLen > 0) ? 0x40 : 0x00) | (((u8TagLen - 2) / 2) << 3) | (u8L - 1));
+	memcpy(&u8Mac[1], u8Nonce, u8NonceLen);
+	uint8 u8Idx;
+	uint32 u32WkLen = u32Len;
+	for (u8Idx = AES_BLOCK_LEN - 1; u8Idx > u8NonceLen; u8Idx--) {
+		u8Mac[u8Idx] = (uint8)u32WkLen;
+		u32WkLen = u32WkLen >> 8;
+	}
+	vEncryptBlock(sState, u8Mac);
+	// 追加認証データ無し
+	if (u32AadLen == 0) {
+		return;
+	}
+	// 追加認証データ：先頭2バイトにデータ長を付加してブロック単位にXOR
+	u8Mac[0] ^= (uint8)(u32AadLen >> 8);
+	u8Mac[1] ^= (uint8)u32AadLen;
+	uint32 u32AadIdx = 0;
+	u8Idx = 2;
+	while (u32AadIdx < u32AadLen) {
+		u8Mac[u8Idx++] ^= u8Aad[u32AadIdx++];
+		if (u8Idx == AES_BLOCK_LEN) {
+			vEncryptBlock(sState, u8Mac);
+			u8Idx = 0;
+		}
+	}
+	// 端数ブロック（ゼロパディング）
+	if (u8Idx > 0) {
+		vEncryptBlock(sState, u8Mac);
+	}
+}
+
+/**
+ * CCM カウンタブロックの編集処理
+ *
+ * @param uint8* カウンタブロック（出力）
+ * @param uint8* ノンス
+ * @param uint8 ノンス長
+ * @param uint32 カウンタ値
+ */
+static void vCCMSetCounter(uint8* u8Ctr, uint8* u8Nonce, uint8 u8NonceLen, uint32 u32Cnt) {
+	memset(u8Ctr, 0x00, AES_BLOCK_LEN);
+	// フラグ（L'）
+	u8Ctr[0] = AES_BLOCK_LEN - 2 - u8NonceLen;
+	// ノンス
+	memcpy(&u8Ctr[1], u8Nonce, u8NonceLen);
+	// カウンタ値（ビッグエンディアン）
+	uint8 u8Idx;
+	for (u8Idx = AES_BLOCK_LEN - 1; u8Idx > u8NonceLen; u8Idx--) {
+		u8Ctr[u8Idx] = (uint8)u32Cnt;
+		u32Cnt = u32Cnt >> 8;
+	}
+}
+
+/**
+ * CCM 暗号化／復号化処理
+ * ブロック毎にCTRモードの変換とCBC-MACの更新をまとめて行う
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* CBC-MAC
+ * @param uint8* ノンス
+ * @param uint8 ノンス長
+ * @param uint8* 処理対象
+ * @param uint32 処理対象バイト数
+ * @param bool_t TRUE:暗号化、FALSE:復号化
+ */
+static void vCCMCrypt(tsAES_state* sState, uint8* u8Mac, uint8* u8Nonce, uint8 u8NonceLen,
+		uint8* u8Buff, uint32 u32Len, bool_t bEncrypt) {
+	uint8 u8Ctr[AES_BLOCK_LEN];
+	uint32 u32Cnt = 1;
+	uint32 u32Idx = 0;
+	uint8 u8BlkLen;
+	uint8 u8Idx;
+	while (u32Idx < u32Len) {
+		// ブロック長
+		u8BlkLen = AES_BLOCK_LEN;
+		if ((u32Len - u32Idx) < AES_BLOCK_LEN) {
+			u8BlkLen = u32Len - u32Idx;
+		}
+		// 鍵ストリームの生成
+		vCCMSetCounter(u8Ctr, u8Nonce, u8NonceLen, u32Cnt++);
+		vEncryptBlock(sState, u8Ctr);
+		// 平文でCBC-MACを更新し、鍵ストリームとXOR
+		for (u8Idx = 0; u8Idx < u8BlkLen; u8Idx++) {
+			if (bEncrypt) {
+				u8Mac[u8Idx] ^= u8Buff[u32Idx + u8Idx];
+				u8Buff[u32Idx + u8Idx] ^= u8Ctr[u8Idx];
+			} else {
+				u8Buff[u32Idx + u8Idx] ^= u8Ctr[u8Idx];
+				u8Mac[u8Idx] ^= u8Buff[u32Idx + u8Idx];
+			}
+		}
+		vEncryptBlock(sState, u8Mac);
+		u32Idx += u8BlkLen;
+	}
+}
+
+/**
+ * CTR 暗号化／復号化処理
+ * 端数ブロックも処理するが、端数ブロックの残りの鍵ストリームは破棄する
+ *
+ * @param tsAES_state* ステータス
+ * @param uint8* 処理対象
+ * @param uint32 処理対象バイト数
+ */
+static void vCTRCrypt(tsAES_state* sState, uint8* u8Buff, uint32 u32Len) {
+	uint8 u8Key[AES_BATCH_BLOCKS * AES_BLOCK_LEN];
+	uint32 u32Idx;
+	uint32 u32Size;
+	uint32 u32Pos;
+	uint8 u8Blocks;
+	uint8 u8Idx;
+	for (u32Idx = 0; u32Idx < u32Len; u32Idx += u32Size) {
+		// 鍵ストリームの生成（複数ブロック分のカウンタをまとめて暗号化）
+		u32Size = u32Len - u32Idx;
+		if (u32Size > sizeof(u8Key)) {
+			u32Size = sizeof(u8Key);
+		}
+		u8Blocks = (u32Size + AES_BLOCK_LEN - 1) / AES_BLOCK_LEN;
+		for (u8Idx = 0; u8Idx < u8Blocks; u8Idx++) {
+			memcpy(&u8Key[u8Idx * AES_BLOCK_LEN], sState->u8Vector, AES_BLOCK_LEN);
+			vIncCounter(sState->u8Vector);
+		}
+		vEncryptBlocks(sState, u8Key, u8Blocks);
+		// 鍵ストリームとXOR
+		for (u32Pos = 0; u32Pos < u32Size; u32Pos++) {
+			u8Buff[u32Idx + u32Pos] ^= u8Key[u32Pos];
+		}
+	}
+}
+
+/**
+ * CTR カウンタのインクリメント（ビッグエンディアン128bit）
+ *
+ * @param uint8* カウンタ
+ */
+static void vIncCounter(uint8* u8Ctr) {
+	uint8 u8Idx = AES_BLOCK_LEN;
+	while (u8Idx > 0) {
+		u8Idx--;
+		if (++u8Ctr[u8Idx] != 0) {
+			break;
+		}
+	}
+}
+
+/**
+ * ストリーム処理のブロック単位の暗号化／復号化処理（ECB / CBC）
+ *
+ * @param tsAES_stream* ストリーム処理状態
+ * @param uint8* 処理対象ブロック
+ */
+static void vStreamBlock(tsAES_stream* psStream, uint8* u8Block) {
+	tsAES_state* sState = psStream->psState;
+	if (psStream->bEncrypt) {
+		// 暗号化
+		if (sState->mode == AES_CIPHER_MODE_CBC) {
+			vXorWithBlk(u8Block, sState->u8Vector);
+		}
+		vEncryptBlock(sState, u8Block);
+		if (sState->mode == AES_CIPHER_MODE_CBC) {
+			memcpy(sState->u8Vector, u8Block, AES_BLOCK_LEN);
+		}
+	} else {
+		// 復号化
+		uint8 u8StoreNextIv[AES_BLOCK_LEN];
+		memcpy(u8StoreNextIv, u8Block, AES_BLOCK_LEN);
+		vDecryptBlock(sState, u8Block);
+		if (sState->mode == AES_CIPHER_MODE_CBC) {
+			vXorWithBlk(u8Block, sState->u8Vector);
+			memcpy(sState->u8Vector, u8StoreNextIv, AES_BLOCK_LEN);
+		}
+	}
+}
@@ -9,10 +9,16 @@
  *             AES暗号の暗号化と復号化を行う関数群です。
  *             対応するキーサイズは128bit、192bit、256bit
  *             ブロック暗号なので、余白分の対応としてPKCS#7の機能を提供する。
+ *             任意長のデータを分割して処理するストリーム処理の機能を提供する。
+ *             ブロック単位の暗号化／復号化はバックエンドとして差し替え可能
  *             仕様書はNISTのサイトを参照
  *             FIPS-197(http://csrc.nist.gov/publications/fips/fips197/fips-197.pdf)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 13:00:00 認証付き暗号（CCMモード）を追加
+ * 2026/10/18 14:00:00 CTRモードと任意長データのストリーム処理を追加
+ * 2026/10/18 15:00:00 ブロック暗号処理のバックエンドを差し替え可能にし、テーブル参照による高速版を追加
+ * 2026/10/18 16:00:00 定数時間で複数ブロックを並列処理するビットスライス版のバックエンドを追加
  *
  * LAST MODIFIED BY:
  *
@@ -40,6 +46,15 @@ extern "C" {
 /****************************************************************************/
 /** Block Length (Fixed length) */
 #define AES_BLOCK_LEN          (16)
+/** CCM Nonce Length (7～13) */
+#define AES_CCM_NONCE_LEN_MIN  (7)
+#define AES_CCM_NONCE_LEN_MAX  (13)
+/** 複数ブロック処理の並列ブロック数（ビットスライス版） */
+#define AES_BATCH_BLOCKS       (8)
+/** デフォルトバックエンド（ビルド時に変更可能） */
+#ifndef AES_DEFAULT_BACKEND
+#define AES_DEFAULT_BACKEND    AES_BACKEND_TABLE
+#endif
 
 /****************************************************************************/
 /***        Type Definitions                                              ***/
@@ -51,6 +66,8 @@ extern "C" {
 typedef enum {
     AES_CIPHER_MODE_ECB        // ECB Mode
   , AES_CIPHER_MODE_CBC        // CBC Mode
+  , AES_CIPHER_MODE_CCM        // CCM Mode
+  , AES_CIPHER_MODE_CTR        // CTR Mode
 } teAES_CipherMode;
 
 /**
@@ -63,17 +80,60 @@ typedef enum {
   , AES_KEY_LEN_256 = 32       // 256bit
 } teAES_KeyLength;
 
+/**
+ * 組込みのバックエンド
+ */
+typedef enum {
+	AES_BACKEND_REF = 0        // 参照実装（FIPS-197の手順をバイト単位に実行）
+  , AES_BACKEND_TABLE          // テーブル参照による高速実装（32bitワード単位に実行）
+  , AES_BACKEND_BITSLICE       // ビットスライスによる定数時間実装（8ブロック単位に並列実行）
+  , AES_BACKEND_CNT            // バックエンド数
+} teAES_Backend;
+
 /**
  * AESによる暗号化処理状態
  */
+typedef struct tsAES_stateTag tsAES_state;
+
+/**
+ * ブロック暗号処理のバックエンド
+ * ラウンドキーはバックエンドに依らず共通の形式（u8RoundKey）で保持する
+ */
 typedef struct {
+	// バックエンド名
+	const char* pcName;
+	// 1ブロックの暗号化処理
+	void (*pfEncryptBlock)(tsAES_state* sState, uint8* u8Buff);
+	// 1ブロックの復号化処理
+	void (*pfDecryptBlock)(tsAES_state* sState, uint8* u8Buff);
+	// 複数ブロックの暗号化処理（NULLの場合は1ブロック毎に処理）
+	void (*pfEncryptBlocks)(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt);
+	// 複数ブロックの復号化処理（NULLの場合は1ブロック毎に処理）
+	void (*pfDecryptBlocks)(tsAES_state* sState, uint8* u8Buff, uint32 u32BlockCnt);
+} tsAES_backend;
+
+struct tsAES_stateTag {
 	teAES_CipherMode mode;
 	teAES_KeyLength keyLen;
 	uint8 u8Nk;
 	uint8 u8Nr;
 	uint8 u8RoundKey[240];
 	uint8 u8Vector[AES_BLOCK_LEN];
-} tsAES_state;
+	const tsAES_backend* psBackend;
+};
+
+/**
+ * AESによるストリーム処理状態
+ * ブロック単位に満たない端数をブロックバッファに保持して、次回の処理に引き継ぐ
+ * （連鎖状態はtsAES_stateのベクトルに保持される）
+ */
+typedef struct {
+	tsAES_state* psState;
+	bool_t bEncrypt;
+	bool_t bPadding;
+	uint8 u8Block[AES_BLOCK_LEN];
+	uint8 u8BlockLen;
+} tsAES_stream;
 
 
 /****************************************************************************/
@@ -137,6 +197,121 @@ PUBLIC void vAES_encryptPad(tsAES_state* sState, uint8* u8Buff, const uint32 u32
  */
 PUBLIC void vAES_decrypt(tsAES_state* sState, uint8* u8Buff, const uint32 u32Len);
 
+/**
+ * AES処理ステータスを保持する変数の生成（CCMモード）
+ * CCMモードはブロックの暗号化処理のみ利用するので、復号化用の逆変換は行わない
+ *
+ * @param teAES_KeyLength 鍵長
+ * @param uint8_t* 鍵
+ * @return tsAES_state ステータス
+ */
+PUBLIC tsAES_state vAES_newCCMState(teAES_KeyLength eKeyLen, uint8* u8Key);
+
+/**
+ * 認証付き暗号化処理（CCMモード、RFC3610）
+ * ブロック毎にCBC-MACの更新とCTRモードの暗号化を行い、1回の走査で処理する
+ *
+ * @param tsAES_state ステータス
+ * @param uint8_t* ノンス
+ * @param uint8 ノンス長（7～13バイト）
+ * @param uint8_t* 追加認証データ（暗号化はしないが改竄検知の対象とするデータ）
+ * @param uint32 追加認証データ長（0xFF00バイト未満）
+ * @param uint8_t* 暗号化対象
+ * @param uint32 暗号化対象バイト数
+ * @param uint8_t* 認証タグの出力先
+ * @param uint8 認証タグ長（4,6,8,10,12,14,16）
+ */
+PUBLIC void vAES_encryptCCM(tsAES_state* sState, uint8* u8Nonce, uint8 u8NonceLen,
+	uint8* u8Aad, uint32 u32AadLen, uint8* u8Buff, uint32 u32Len, uint8* u8Tag, uint8 u8TagLen);
+
+/**
+ * 認証付き復号化処理（CCMモード、RFC3610）
+ * 認証タグが一致しない場合には、復号化した領域をゼロクリアする
+ *
+ * @param tsAES_state ステータス
+ * @param uint8_t* ノンス
+ * @param uint8 ノンス長（7～13バイト）
+ * @param uint8_t* 追加認証データ
+ * @param uint32 追加認証データ長（0xFF00バイト未満）
+ * @param uint8_t* 復号化対象
+ * @param uint32 復号化対象バイト数
+ * @param uint8_t* 受信した認証タグ
+ * @param uint8 認証タグ長（4,6,8,10,12,14,16）
+ * @return bool_t TRUE:認証成功
+ */
+PUBLIC bool_t bAES_decryptCCM(tsAES_state* sState, uint8* u8Nonce, uint8 u8NonceLen,
+	uint8* u8Aad, uint32 u32AadLen, uint8* u8Buff, uint32 u32Len, uint8* u8Tag, uint8 u8TagLen);
+
+/**
+ * AES処理ステータスを保持する変数の生成（CTRモード）
+ * CTRモードは暗号化と復号化が同じ処理で、任意長のデータを処理可能
+ *
+ * @param teAES_KeyLength 鍵長
+ * @param uint8_t* 鍵
+ * @param uint8_t* カウンタ初期値（ビッグエンディアン128bit）
+ * @return tsAES_state ステータス
+ */
+PUBLIC tsAES_state vAES_newCTRState(teAES_KeyLength eKeyLen, uint8* u8Key, uint8* u8Counter);
+
+/**
+ * ストリーム処理の開始
+ * 対象のモードはECB、CBC、CTR（CTRモードではパディングは無視される）
+ *
+ * @param tsAES_stream ストリーム処理状態
+ * @param tsAES_state ステータス
+ * @param bool_t TRUE:暗号化、FALSE:復号化
+ * @param bool_t TRUE:PKCS#7でパディング
+ */
+PUBLIC void vAES_streamInit(tsAES_stream* psStream, tsAES_state* psState, bool_t bEncrypt, bool_t bPadding);
+
+/**
+ * ストリーム処理（データの追加）
+ * 出力先には入力バイト数＋ブロック長の領域が必要
+ * 入力と出力に同じバッファを指定する場合、CTRモード以外ではブロック長の倍数で入力する事
+ *
+ * @param tsAES_stream ストリーム処理状態
+ * @param uint8_t* 入力データ
+ * @param uint8_t* 出力先
+ * @param uint32 入力バイト数
+ * @return uint32 出力バイト数
+ */
+PUBLIC uint32 u32AES_streamUpdate(tsAES_stream* psStream, uint8* u8In, uint8* u8Out, uint32 u32Len);
+
+/**
+ * ストリーム処理の終了
+ * 端数ブロックのパディング（暗号化）、またはパディングの除去（復号化）を行う
+ *
+ * @param tsAES_stream ストリーム処理状態
+ * @param uint8_t* 出力先（ブロック長の領域が必要）
+ * @return int 出力バイト数、端数ブロックやパディングが不正な場合は-1
+ */
+PUBLIC int iAES_streamFinal(tsAES_stream* psStream, uint8* u8Out);
+
+/**
+ * 組込みバックエンドの取得
+ *
+ * @param teAES_Backend バックエンド種別
+ * @return tsAES_backend* バックエンド、種別が不正な場合はNULL
+ */
+PUBLIC const tsAES_backend* psAES_getBackend(teAES_Backend eBackend);
+
+/**
+ * デフォルトバックエンドの設定
+ * 以降に生成するステータスに適用される
+ *
+ * @param tsAES_backend* バックエンド
+ */
+PUBLIC void vAES_setDefaultBackend(const tsAES_backend* psBackend);
+
+/**
+ * バックエンドの設定
+ * 鍵の再初期化は不要
+ *
+ * @param tsAES_state ステータス
+ * @param tsAES_backend* バックエンド
+ */
+PUBLIC void vAES_setBackend(tsAES_state* sState, const tsAES_backend* psBackend);
+
 #if defined __cplusplus
 }
 #endif
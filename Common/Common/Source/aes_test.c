@@ -13,6 +13,11 @@
  *             FIPS-197(http://csrc.nist.gov/publications/fips/fips197/fips-197.pdf)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 13:00:00 CCMモードのテストケースと処理時間の比較を追加
+ * 2026/10/18 14:00:00 ストリーム処理のテストケースを追加
+ * 2026/10/18 15:00:00 テストケースを全バックエンドで実行し、バックエンド毎の性能測定を追加
+ * 2026/10/18 18:00:00 CRCの性能測定を追加
+ * 2026/10/19 23:00:00 入力と出力に同じバッファを指定したストリーム処理のテストケースを追加
  *
  * LAST MODIFIED BY:
  *
@@ -28,20 +33,141 @@
 #include "aes_test.h"
 #include "framework.h"
 #include "aes.h"
+#include "sha256.h"
+#include "crc.h"
+#include "ccitt8.h"
 #include "timer_util.h"
 
+/** 性能測定用バッファサイズ（4Kbyteのメッセージは分割して処理） */
+#define BENCH_BUFF_LEN       (256)
+/** 性能測定の最低処理バイト数（短いメッセージは繰り返して測定） */
+#define BENCH_TOTAL_LEN      (4096)
+/** CPUクロック（MHz） */
+#define BENCH_CPU_MHZ        (32)
+
 static void test_128();
 static void test_192();
 static void test_256();
+static void test_ccm();
+static void test_stream();
 static void dispBytes(char* pPrefix, uint8* bytes, uint8 u8Len);
+static uint32 u32BenchAES(tsAES_state* psState, bool_t bEncrypt, uint32 u32Len, uint32 u32Rep);
+static uint32 u32BenchSHA256(const SHA256_backend* psBackend, uint32 u32Len, uint32 u32Rep);
+static uint32 u32BenchCRC(uint8 u8Type, uint32 u32Len, uint32 u32Rep);
+static void dispBench(uint32 u32Len, uint32 u32Rep, uint32 u32Usec);
+
+/** 性能測定用バッファ */
+static uint8 u8BenchBuff[BENCH_BUFF_LEN];
+// 性能測定時のCRC算出結果（最適化による処理の削除対策）
+static volatile uint32 u32BenchCRCVal;
 
 PUBLIC void vAES_test() {
-	// AES 128bit
-	test_128();
-	// AES 192bit
-	test_192();
-	// AES 256bit
-	test_256();
+	// 全てのバックエンドで同じテストケースを実行
+	uint8 u8Backend;
+	for (u8Backend = 0; u8Backend < AES_BACKEND_CNT; u8Backend++) {
+		vAES_setDefaultBackend(psAES_getBackend(u8Backend));
+		vfPrintf(&sSerStream, "\nMS:%08d Backend:%s", u32TickCount_ms, psAES_getBackend(u8Backend)->pcName);
+		SERIAL_vFlush(sSerStream.u8Device);
+		// AES 128bit
+		test_128();
+		// AES 192bit
+		test_192();
+		// AES 256bit
+		test_256();
+		// AES CCM
+		test_ccm();
+		// AES Stream
+		test_stream();
+	}
+	// デフォルトバックエンドを戻す
+	vAES_setDefaultBackend(psAES_getBackend(AES_DEFAULT_BACKEND));
+}
+
+PUBLIC void vAES_benchmark() {
+	const teAES_KeyLength eKeyLens[] = {AES_KEY_LEN_128, AES_KEY_LEN_192, AES_KEY_LEN_256};
+	const uint32 u32MsgLens[] = {16, 80, 4096};
+	uint8 u8Key[32];
+	uint8 u8Iv[AES_BLOCK_LEN];
+	tsAES_state sState;
+	uint8 u8Backend, u8KeyIdx, u8LenIdx, u8Mode, u8Idx;
+	uint32 u32Rep, u32Usec;
+	for (u8Idx = 0; u8Idx < 32; u8Idx++) {
+		u8Key[u8Idx] = u8Idx;
+	}
+	memset(u8Iv, 0x00, AES_BLOCK_LEN);
+	memset(u8BenchBuff, 0x5A, BENCH_BUFF_LEN);
+	vfPrintf(&sSerStream, "\n");
+	vfPrintf(&sSerStream, "================================================================================\n");
+	vfPrintf(&sSerStream, "= Benchmark (usec/msg, cycles/byte @%dMHz, byte/msec)\n", BENCH_CPU_MHZ);
+	vfPrintf(&sSerStream, "================================================================================\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	//**********************************************************************
+	// AES（鍵の初期化は測定対象外）
+	//**********************************************************************
+	for (u8Backend = 0; u8Backend < AES_BACKEND_CNT; u8Backend++) {
+		for (u8KeyIdx = 0; u8KeyIdx < 3; u8KeyIdx++) {
+			// モード（0:ECB、1:CBC、2:CTR）
+			for (u8Mode = 0; u8Mode < 3; u8Mode++) {
+				for (u8LenIdx = 0; u8LenIdx < 3; u8LenIdx++) {
+					if (u8Mode == 0) {
+						sState = vAES_newECBState(eKeyLens[u8KeyIdx], u8Key);
+					} else if (u8Mode == 1) {
+						sState = vAES_newCBCState(eKeyLens[u8KeyIdx], u8Key, u8Iv);
+					} else {
+						sState = vAES_newCTRState(eKeyLens[u8KeyIdx], u8Key, u8Iv);
+					}
+					vAES_setBackend(&sState, psAES_getBackend(u8Backend));
+					u32Rep = BENCH_TOTAL_LEN / u32MsgLens[u8LenIdx];
+					// 暗号化
+					u32Usec = u32BenchAES(&sState, TRUE, u32MsgLens[u8LenIdx], u32Rep);
+					vfPrintf(&sSerStream, "\nMS:%08d AES %s %d %s Enc %4dB",
+						u32TickCount_ms, sState.psBackend->pcName, eKeyLens[u8KeyIdx] * 8,
+						(u8Mode == 0) ? "ECB" : ((u8Mode == 1) ? "CBC" : "CTR"), u32MsgLens[u8LenIdx]);
+					dispBench(u32MsgLens[u8LenIdx], u32Rep, u32Usec);
+					if (u8Mode == 2) {
+						// CTRモードの復号化は暗号化と同じ処理
+						continue;
+					}
+					// 復号化
+					u32Usec = u32BenchAES(&sState, FALSE, u32MsgLens[u8LenIdx], u32Rep);
+					vfPrintf(&sSerStream, "\nMS:%08d AES %s %d %s Dec %4dB",
+						u32TickCount_ms, sState.psBackend->pcName, eKeyLens[u8KeyIdx] * 8,
+						(u8Mode == 0) ? "ECB" : "CBC", u32MsgLens[u8LenIdx]);
+					dispBench(u32MsgLens[u8LenIdx], u32Rep, u32Usec);
+				}
+			}
+		}
+	}
+	//**********************************************************************
+	// SHA256（終端処理を含む）
+	//**********************************************************************
+	for (u8Backend = 0; u8Backend < SHA256_BACKEND_CNT; u8Backend++) {
+		for (u8LenIdx = 0; u8LenIdx < 3; u8LenIdx++) {
+			u32Rep = BENCH_TOTAL_LEN / u32MsgLens[u8LenIdx];
+			u32Usec = u32BenchSHA256(psSHA256_getBackend(u8Backend), u32MsgLens[u8LenIdx], u32Rep);
+			vfPrintf(&sSerStream, "\nMS:%08d SHA256 %s %4dB",
+				u32TickCount_ms, psSHA256_getBackend(u8Backend)->pcName, u32MsgLens[u8LenIdx]);
+			dispBench(u32MsgLens[u8LenIdx], u32Rep, u32Usec);
+		}
+	}
+	//**********************************************************************
+	// CRC（CCITT8のメッセージ長は255バイトまで）
+	//**********************************************************************
+	const uint32 u32CrcLens[] = {16, 90, 240};
+	const char* pcCrcNames[] = {"CCITT8", "CRC16", "CRC32"};
+	vfPrintf(&sSerStream, "\nMS:%08d CRC16(123456789)=%04X CRC32(123456789)=%08X",
+		u32TickCount_ms, u16CRC16_calc((uint8*)"123456789", 9), u32CRC32_calc((uint8*)"123456789", 9));
+	for (u8Mode = 0; u8Mode < 3; u8Mode++) {
+		for (u8LenIdx = 0; u8LenIdx < 3; u8LenIdx++) {
+			u32Rep = BENCH_TOTAL_LEN / u32CrcLens[u8LenIdx];
+			u32Usec = u32BenchCRC(u8Mode, u32CrcLens[u8LenIdx], u32Rep);
+			vfPrintf(&sSerStream, "\nMS:%08d CRC %s %4dB",
+				u32TickCount_ms, pcCrcNames[u8Mode], u32CrcLens[u8LenIdx]);
+			dispBench(u32CrcLens[u8LenIdx], u32Rep, u32Usec);
+		}
+	}
+	vfPrintf(&sSerStream, "\n");
+	SERIAL_vFlush(sSerStream.u8Device);
 }
 
 /**
@@ -681,6 +807,400 @@ static void test_256() {
 	}
 }
 
+/**
+ * CCM Mode Test
+ */
+static void test_ccm() {
+	//**********************************************************************
+	// Case No.11（RFC3610 Packet Vector #1）
+	//**********************************************************************
+	vfPrintf(&sSerStream, "\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	vfPrintf(&sSerStream, "================================================================================\n");
+	vfPrintf(&sSerStream, "= No.11\n");
+	vfPrintf(&sSerStream, "================================================================================\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	// キー
+	uint8 u8Key11[] =
+		{(uint8)0xC0, (uint8)0xC1, (uint8)0xC2, (uint8)0xC3, (uint8)0xC4, (uint8)0xC5, (uint8)0xC6, (uint8)0xC7
+	   , (uint8)0xC8, (uint8)0xC9, (uint8)0xCA, (uint8)0xCB, (uint8)0xCC, (uint8)0xCD, (uint8)0xCE, (uint8)0xCF};
+	dispBytes("key    :", u8Key11, 16);
+	// ノンス
+	uint8 u8Nonce11[] =
+		{(uint8)0x00, (uint8)0x00, (uint8)0x00, (uint8)0x03, (uint8)0x02, (uint8)0x01, (uint8)0x00, (uint8)0xA0
+	   , (uint8)0xA1, (uint8)0xA2, (uint8)0xA3, (uint8)0xA4, (uint8)0xA5};
+	dispBytes("nonce  :", u8Nonce11, 13);
+	// 追加認証データ
+	uint8 u8Aad11[] =
+		{(uint8)0x00, (uint8)0x01, (uint8)0x02, (uint8)0x03, (uint8)0x04, (uint8)0x05, (uint8)0x06, (uint8)0x07};
+	// データ
+	uint8 u8Data11[] =
+		{(uint8)0x08, (uint8)0x09, (uint8)0x0A, (uint8)0x0B, (uint8)0x0C, (uint8)0x0D, (uint8)0x0E, (uint8)0x0F
+	   , (uint8)0x10, (uint8)0x11, (uint8)0x12, (uint8)0x13, (uint8)0x14, (uint8)0x15, (uint8)0x16, (uint8)0x17
+	   , (uint8)0x18, (uint8)0x19, (uint8)0x1A, (uint8)0x1B, (uint8)0x1C, (uint8)0x1D, (uint8)0x1E};
+	uint8 u8TestData11[23];
+	memcpy(u8TestData11, u8Data11, 23);
+	dispBytes("data   :", u8TestData11, 23);
+	// CCMモードで暗号化
+	uint8 u8Tag11[8];
+	tsAES_state sState = vAES_newCCMState(AES_KEY_LEN_128, u8Key11);
+	vAES_encryptCCM(&sState, u8Nonce11, 13, u8Aad11, 8, u8TestData11, 23, u8Tag11, 8);
+	dispBytes("crypt  :", u8TestData11, 23);
+	dispBytes("tag    :", u8Tag11, 8);
+	// 暗号文答え合わせ
+	uint8 u8TestResult11[] = {
+		(uint8)0x58, (uint8)0x8C, (uint8)0x97, (uint8)0x9A, (uint8)0x61, (uint8)0xC6, (uint8)0x63, (uint8)0xD2
+	  , (uint8)0xF0, (uint8)0x66, (uint8)0xD0, (uint8)0xC2, (uint8)0xC0, (uint8)0xF9, (uint8)0x89, (uint8)0x80
+	  , (uint8)0x6D, (uint8)0x5F, (uint8)0x6B, (uint8)0x61, (uint8)0xDA, (uint8)0xC3, (uint8)0x84
+	};
+	uint8 u8TestTag11[] = {
+		(uint8)0x17, (uint8)0xE8, (uint8)0xD1, (uint8)0x2C, (uint8)0xFD, (uint8)0xF9, (uint8)0x26, (uint8)0xE0
+	};
+	if (memcmp(u8TestResult11, u8TestData11, 23) == 0 && memcmp(u8TestTag11, u8Tag11, 8) == 0) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.11 Ciphertext OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.11 Ciphertext NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+	// CCMモードで復号化
+	bool_t bResult = bAES_decryptCCM(&sState, u8Nonce11, 13, u8Aad11, 8, u8TestData11, 23, u8Tag11, 8);
+	dispBytes("decrypt:", u8TestData11, 23);
+	// 平文答え合わせ
+	if (bResult && memcmp(u8Data11, u8TestData11, 23) == 0) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.11 Plaintext  OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.11 Plaintext  NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+	// 改竄検知（暗号文を1bit反転）
+	vAES_encryptCCM(&sState, u8Nonce11, 13, u8Aad11, 8, u8TestData11, 23, u8Tag11, 8);
+	u8TestData11[0] ^= 0x01;
+	if (bAES_decryptCCM(&sState, u8Nonce11, 13, u8Aad11, 8, u8TestData11, 23, u8Tag11, 8) == FALSE) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.11 Forgery    OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.11 Forgery    NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+
+	//**********************************************************************
+	// Case No.12（無線電文1件あたりの処理時間比較：CBC 80byte / CCM 76byte+タグ4byte）
+	//**********************************************************************
+	vfPrintf(&sSerStream, "\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	vfPrintf(&sSerStream, "================================================================================\n");
+	vfPrintf(&sSerStream, "= No.12\n");
+	vfPrintf(&sSerStream, "================================================================================\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	uint8 u8Key12[32];
+	uint8 u8Msg12[90];
+	uint8 u8Tag12[4];
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < 32; u8Idx++) {
+		u8Key12[u8Idx] = u8Idx;
+	}
+	for (u8Idx = 0; u8Idx < 90; u8Idx++) {
+		u8Msg12[u8Idx] = u8Idx;
+	}
+	uint32 u32Cnt;
+	uint64 u64Before;
+	uint32 u32CbcEnc, u32CbcDec, u32CcmEnc, u32CcmDec;
+	// CBC（鍵生成を含む）
+	u64Before = u64TimerUtil_readUsec();
+	for (u32Cnt = 0; u32Cnt < 10; u32Cnt++) {
+		sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key12, u8Key12);
+		vAES_encrypt(&sState, &u8Msg12[9], 80);
+	}
+	u32CbcEnc = (uint32)(u64TimerUtil_readUsec() - u64Before) / 10;
+	u64Before = u64TimerUtil_readUsec();
+	for (u32Cnt = 0; u32Cnt < 10; u32Cnt++) {
+		sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key12, u8Key12);
+		vAES_decrypt(&sState, &u8Msg12[9], 80);
+	}
+	u32CbcDec = (uint32)(u64TimerUtil_readUsec() - u64Before) / 10;
+	// CCM（鍵生成を含む）
+	u64Before = u64TimerUtil_readUsec();
+	for (u32Cnt = 0; u32Cnt < 10; u32Cnt++) {
+		sState = vAES_newCCMState(AES_KEY_LEN_256, u8Key12);
+		vAES_encryptCCM(&sState, u8Msg12, 9, NULL, 0, &u8Msg12[9], 76, u8Tag12, 4);
+	}
+	u32CcmEnc = (uint32)(u64TimerUtil_readUsec() - u64Before) / 10;
+	u64Before = u64TimerUtil_readUsec();
+	for (u32Cnt = 0; u32Cnt < 10; u32Cnt++) {
+		sState = vAES_newCCMState(AES_KEY_LEN_256, u8Key12);
+		bAES_decryptCCM(&sState, u8Msg12, 9, NULL, 0, &u8Msg12[9], 76, u8Tag12, 4);
+	}
+	u32CcmDec = (uint32)(u64TimerUtil_readUsec() - u64Before) / 10;
+	// 処理時間とサイクル数（CPUクロック32MHz換算）
+	vfPrintf(&sSerStream, "\nMS:%08d No.12 CBC Enc %d usec %d cycles", u32TickCount_ms, u32CbcEnc, u32CbcEnc * 32);
+	vfPrintf(&sSerStream, "\nMS:%08d No.12 CBC Dec %d usec %d cycles", u32TickCount_ms, u32CbcDec, u32CbcDec * 32);
+	SERIAL_vFlush(sSerStream.u8Device);
+	vfPrintf(&sSerStream, "\nMS:%08d No.12 CCM Enc %d usec %d cycles", u32TickCount_ms, u32CcmEnc, u32CcmEnc * 32);
+	vfPrintf(&sSerStream, "\nMS:%08d No.12 CCM Dec %d usec %d cycles", u32TickCount_ms, u32CcmDec, u32CcmDec * 32);
+	SERIAL_vFlush(sSerStream.u8Device);
+}
+
+/**
+ * Stream Test
+ */
+static void test_stream() {
+	//**********************************************************************
+	// Case No.13（NIST SP800-38A F.5.5 CTR-AES256.Encrypt、不揃いな分割で入力）
+	//**********************************************************************
+	vfPrintf(&sSerStream, "\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	vfPrintf(&sSerStream, "================================================================================\n");
+	vfPrintf(&sSerStream, "= No.13\n");
+	vfPrintf(&sSerStream, "================================================================================\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	// キー
+	uint8 u8Key13[] =
+		{(uint8)0x60, (uint8)0x3D, (uint8)0xEB, (uint8)0x10, (uint8)0x15, (uint8)0xCA, (uint8)0x71, (uint8)0xBE
+	   , (uint8)0x2B, (uint8)0x73, (uint8)0xAE, (uint8)0xF0, (uint8)0x85, (uint8)0x7D, (uint8)0x77, (uint8)0x81
+	   , (uint8)0x1F, (uint8)0x35, (uint8)0x2C, (uint8)0x07, (uint8)0x3B, (uint8)0x61, (uint8)0x08, (uint8)0xD7
+	   , (uint8)0x2D, (uint8)0x98, (uint8)0x10, (uint8)0xA3, (uint8)0x09, (uint8)0x14, (uint8)0xDF, (uint8)0xF4};
+	dispBytes("key    :", u8Key13, 32);
+	// カウンタ初期値
+	uint8 u8Ctr13[] =
+		{(uint8)0xF0, (uint8)0xF1, (uint8)0xF2, (uint8)0xF3, (uint8)0xF4, (uint8)0xF5, (uint8)0xF6, (uint8)0xF7
+	   , (uint8)0xF8, (uint8)0xF9, (uint8)0xFA, (uint8)0xFB, (uint8)0xFC, (uint8)0xFD, (uint8)0xFE, (uint8)0xFF};
+	dispBytes("counter:", u8Ctr13, 16);
+	// データ
+	uint8 u8Data13[] =
+		{(uint8)0x6B, (uint8)0xC1, (uint8)0xBE, (uint8)0xE2, (uint8)0x2E, (uint8)0x40, (uint8)0x9F, (uint8)0x96
+	   , (uint8)0xE9, (uint8)0x3D, (uint8)0x7E, (uint8)0x11, (uint8)0x73, (uint8)0x93, (uint8)0x17, (uint8)0x2A
+	   , (uint8)0xAE, (uint8)0x2D, (uint8)0x8A, (uint8)0x57, (uint8)0x1E, (uint8)0x03, (uint8)0xAC, (uint8)0x9C
+	   , (uint8)0x9E, (uint8)0xB7, (uint8)0x6F, (uint8)0xAC, (uint8)0x45, (uint8)0xAF, (uint8)0x8E, (uint8)0x51
+	   , (uint8)0x30, (uint8)0xC8, (uint8)0x1C, (uint8)0x46, (uint8)0xA3, (uint8)0x5C, (uint8)0xE4, (uint8)0x11
+	   , (uint8)0xE5, (uint8)0xFB, (uint8)0xC1, (uint8)0x19, (uint8)0x1A, (uint8)0x0A, (uint8)0x52, (uint8)0xEF
+	   , (uint8)0xF6, (uint8)0x9F, (uint8)0x24, (uint8)0x45, (uint8)0xDF, (uint8)0x4F, (uint8)0x9B, (uint8)0x17
+	   , (uint8)0xAD, (uint8)0x2B, (uint8)0x41, (uint8)0x7B, (uint8)0xE6, (uint8)0x6C, (uint8)0x37, (uint8)0x10};
+	dispBytes("data   :", u8Data13, 64);
+	// ストリーム処理で暗号化（1byte、7byte、16byte、40byteに分割）
+	uint8 u8TestData13[64];
+	tsAES_state sState = vAES_newCTRState(AES_KEY_LEN_256, u8Key13, u8Ctr13);
+	tsAES_stream sStream;
+	vAES_streamInit(&sStream, &sState, TRUE, FALSE);
+	uint32 u32OutLen = 0;
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8Data13[0],  &u8TestData13[u32OutLen], 1);
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8Data13[1],  &u8TestData13[u32OutLen], 7);
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8Data13[8],  &u8TestData13[u32OutLen], 16);
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8Data13[24], &u8TestData13[u32OutLen], 40);
+	u32OutLen += iAES_streamFinal(&sStream, &u8TestData13[u32OutLen]);
+	dispBytes("crypt  :", u8TestData13, 64);
+	// 暗号文答え合わせ
+	uint8 u8TestResult13[] = {
+		(uint8)0x60, (uint8)0x1E, (uint8)0xC3, (uint8)0x13, (uint8)0x77, (uint8)0x57, (uint8)0x89, (uint8)0xA5
+	  , (uint8)0xB7, (uint8)0xA7, (uint8)0xF5, (uint8)0x04, (uint8)0xBB, (uint8)0xF3, (uint8)0xD2, (uint8)0x28
+	  , (uint8)0xF4, (uint8)0x43, (uint8)0xE3, (uint8)0xCA, (uint8)0x4D, (uint8)0x62, (uint8)0xB5, (uint8)0x9A
+	  , (uint8)0xCA, (uint8)0x84, (uint8)0xE9, (uint8)0x90, (uint8)0xCA, (uint8)0xCA, (uint8)0xF5, (uint8)0xC5
+	  , (uint8)0x2B, (uint8)0x09, (uint8)0x30, (uint8)0xDA, (uint8)0xA2, (uint8)0x3D, (uint8)0xE9, (uint8)0x4C
+	  , (uint8)0xE8, (uint8)0x70, (uint8)0x17, (uint8)0xBA, (uint8)0x2D, (uint8)0x84, (uint8)0x98, (uint8)0x8D
+	  , (uint8)0xDF, (uint8)0xC9, (uint8)0xC5, (uint8)0x8D, (uint8)0xB6, (uint8)0x7A, (uint8)0xAD, (uint8)0xA6
+	  , (uint8)0x13, (uint8)0xC2, (uint8)0xDD, (uint8)0x08, (uint8)0x45, (uint8)0x79, (uint8)0x41, (uint8)0xA6
+	};
+	if (u32OutLen == 64 && memcmp(u8TestResult13, u8TestData13, 64) == 0) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.13 Ciphertext OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.13 Ciphertext NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+
+	//**********************************************************************
+	// Case No.14（CBC+PKCS#7：一括処理とストリーム処理の結果比較）
+	//**********************************************************************
+	vfPrintf(&sSerStream, "\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	vfPrintf(&sSerStream, "================================================================================\n");
+	vfPrintf(&sSerStream, "= No.14\n");
+	vfPrintf(&sSerStream, "================================================================================\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	// 一括処理（50byteをパディングして64byte）
+	uint8 u8Oneshot14[64];
+	memcpy(u8Oneshot14, u8Data13, 50);
+	sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key13, u8Ctr13);
+	vAES_encryptPad(&sState, u8Oneshot14, 50);
+	// ストリーム処理（5byte、20byte、25byteに分割）
+	uint8 u8TestData14[64 + AES_BLOCK_LEN];
+	sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key13, u8Ctr13);
+	vAES_streamInit(&sStream, &sState, TRUE, TRUE);
+	u32OutLen = 0;
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8Data13[0],  &u8TestData14[u32OutLen], 5);
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8Data13[5],  &u8TestData14[u32OutLen], 20);
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8Data13[25], &u8TestData14[u32OutLen], 25);
+	u32OutLen += iAES_streamFinal(&sStream, &u8TestData14[u32OutLen]);
+	dispBytes("crypt  :", u8TestData14, 64);
+	if (u32OutLen == 64 && memcmp(u8Oneshot14, u8TestData14, 64) == 0) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.14 Ciphertext OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.14 Ciphertext NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+	// ストリーム処理で復号化（33byte、31byteに分割）
+	uint8 u8Plain14[64 + AES_BLOCK_LEN];
+	sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key13, u8Ctr13);
+	vAES_streamInit(&sStream, &sState, FALSE, TRUE);
+	u32OutLen = 0;
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8TestData14[0],  &u8Plain14[u32OutLen], 33);
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8TestData14[33], &u8Plain14[u32OutLen], 31);
+	int iFinalLen = iAES_streamFinal(&sStream, &u8Plain14[u32OutLen]);
+	dispBytes("decrypt:", u8Plain14, 50);
+	if (iFinalLen >= 0 && (u32OutLen + iFinalLen) == 50 && memcmp(u8Data13, u8Plain14, 50) == 0) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.14 Plaintext  OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.14 Plaintext  NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+
+	//**********************************************************************
+	// Case No.15（CBC+PKCS#7：入力と出力に同じバッファを指定したストリーム処理）
+	//**********************************************************************
+	vfPrintf(&sSerStream, "\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	vfPrintf(&sSerStream, "================================================================================\n");
+	vfPrintf(&sSerStream, "= No.15\n");
+	vfPrintf(&sSerStream, "================================================================================\n");
+	SERIAL_vFlush(sSerStream.u8Device);
+	// 一括処理（64byteをパディングして80byte）
+	uint8 u8Cipher15[64 + AES_BLOCK_LEN];
+	memcpy(u8Cipher15, u8Data13, 64);
+	sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key13, u8Ctr13);
+	vAES_encryptPad(&sState, u8Cipher15, 64);
+	// 同じバッファで暗号化（16byte、48byteに分割）
+	uint8 u8TestData15[64 + AES_BLOCK_LEN];
+	memcpy(u8TestData15, u8Data13, 64);
+	sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key13, u8Ctr13);
+	vAES_streamInit(&sStream, &sState, TRUE, TRUE);
+	u32OutLen = 0;
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8TestData15[0],  &u8TestData15[0],  16);
+	u32OutLen += u32AES_streamUpdate(&sStream, &u8TestData15[16], &u8TestData15[16], 48);
+	u32OutLen += iAES_streamFinal(&sStream, &u8TestData15[u32OutLen]);
+	dispBytes("crypt  :", u8TestData15, 80);
+	if (u32OutLen == 80 && memcmp(u8Cipher15, u8TestData15, 80) == 0) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.15 Ciphertext OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.15 Ciphertext NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+	// 同じバッファで復号化（32byte、48byteに分割）
+	// 最終ブロックを保留する為、各呼び出しの出力は入力位置から始まり、2回目は保留分を含む
+	sState = vAES_newCBCState(AES_KEY_LEN_256, u8Key13, u8Ctr13);
+	vAES_streamInit(&sStream, &sState, FALSE, TRUE);
+	uint32 u32OutLen1 = u32AES_streamUpdate(&sStream, &u8TestData15[0],  &u8TestData15[0],  32);
+	uint32 u32OutLen2 = u32AES_streamUpdate(&sStream, &u8TestData15[32], &u8TestData15[32], 48);
+	iFinalLen = iAES_streamFinal(&sStream, &u8TestData15[32 + u32OutLen2]);
+	uint8 u8Plain15[64];
+	memset(u8Plain15, 0x00, 64);
+	if (u32OutLen1 == 16 && u32OutLen2 == 48 && iFinalLen == 0) {
+		memcpy(&u8Plain15[0],  &u8TestData15[0],  16);
+		memcpy(&u8Plain15[16], &u8TestData15[32], 48);
+	}
+	dispBytes("decrypt:", u8Plain15, 64);
+	if (iFinalLen == 0 && memcmp(u8Data13, u8Plain15, 64) == 0) {
+		vfPrintf(&sSerStream, "\nMS:%08d No.15 Plaintext  OK", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	} else {
+		vfPrintf(&sSerStream, "\nMS:%08d No.15 Plaintext  NG", u32TickCount_ms);
+		SERIAL_vFlush(sSerStream.u8Device);
+	}
+}
+
+/**
+ * AESの性能測定（測定用バッファをメッセージ長分繰り返して処理）
+ *
+ * @param tsAES_state* ステータス
+ * @param bool_t TRUE:暗号化
+ * @param uint32 メッセージ長
+ * @param uint32 繰り返し回数
+ * @return uint32 処理時間（usec）
+ */
+static uint32 u32BenchAES(tsAES_state* psState, bool_t bEncrypt, uint32 u32Len, uint32 u32Rep) {
+	uint32 u32Cnt, u32Remain, u32Size;
+	uint64 u64Before = u64TimerUtil_readUsec();
+	for (u32Cnt = 0; u32Cnt < u32Rep; u32Cnt++) {
+		for (u32Remain = u32Len; u32Remain > 0; u32Remain -= u32Size) {
+			u32Size = (u32Remain < BENCH_BUFF_LEN) ? u32Remain : BENCH_BUFF_LEN;
+			if (bEncrypt) {
+				vAES_encrypt(psState, u8BenchBuff, u32Size);
+			} else {
+				vAES_decrypt(psState, u8BenchBuff, u32Size);
+			}
+		}
+	}
+	return (uint32)(u64TimerUtil_readUsec() - u64Before);
+}
+
+/**
+ * SHA256の性能測定（測定用バッファをメッセージ長分繰り返して追加）
+ *
+ * @param SHA256_backend* バックエンド
+ * @param uint32 メッセージ長
+ * @param uint32 繰り返し回数
+ * @return uint32 処理時間（usec）
+ */
+static uint32 u32BenchSHA256(const SHA256_backend* psBackend, uint32 u32Len, uint32 u32Rep) {
+	SHA256_state sState;
+	uint8 u8Hash[32];
+	uint32 u32Cnt, u32Remain, u32Size;
+	uint64 u64Before = u64TimerUtil_readUsec();
+	for (u32Cnt = 0; u32Cnt < u32Rep; u32Cnt++) {
+		sState = sSHA256_newState();
+		vSHA256_setBackend(&sState, psBackend);
+		for (u32Remain = u32Len; u32Remain > 0; u32Remain -= u32Size) {
+			u32Size = (u32Remain < BENCH_BUFF_LEN) ? u32Remain : BENCH_BUFF_LEN;
+			vSHA256_append(&sState, u8BenchBuff, u32Size);
+		}
+		vSHA256_generateHash(&sState, u8Hash);
+	}
+	return (uint32)(u64TimerUtil_readUsec() - u64Before);
+}
+
+/**
+ * CRCの性能測定
+ *
+ * @param uint8 種別（0:CCITT8、1:CRC16、2:CRC32）
+ * @param uint32 メッセージ長（255バイト以下）
+ * @param uint32 繰り返し回数
+ * @return uint32 処理時間（usec）
+ */
+static uint32 u32BenchCRC(uint8 u8Type, uint32 u32Len, uint32 u32Rep) {
+	uint32 u32Cnt;
+	uint64 u64Before = u64TimerUtil_readUsec();
+	for (u32Cnt = 0; u32Cnt < u32Rep; u32Cnt++) {
+		if (u8Type == 0) {
+			u32BenchCRCVal = u8CCITT8(u8BenchBuff, (uint8)u32Len);
+		} else if (u8Type == 1) {
+			u32BenchCRCVal = u16CRC16_calc(u8BenchBuff, u32Len);
+		} else {
+			u32BenchCRCVal = u32CRC32_calc(u8BenchBuff, u32Len);
+		}
+	}
+	return (uint32)(u64TimerUtil_readUsec() - u64Before);
+}
+
+/**
+ * 性能測定結果の表示
+ *
+ * @param uint32 メッセージ長
+ * @param uint32 繰り返し回数
+ * @param uint32 処理時間（usec）
+ */
+static void dispBench(uint32 u32Len, uint32 u32Rep, uint32 u32Usec) {
+	uint64 u64Bytes = (uint64)u32Len * u32Rep;
+	if (u32Usec == 0) {
+		u32Usec = 1;
+	}
+	vfPrintf(&sSerStream, " %6d usec %4d cyc/B %6d B/ms",
+		u32Usec / u32Rep, (uint32)((uint64)u32Usec * BENCH_CPU_MHZ / u64Bytes), (uint32)(u64Bytes * 1000 / u32Usec));
+	SERIAL_vFlush(sSerStream.u8Device);
+}
+
 /**
  * 配列表示
  */
@@ -13,6 +13,8 @@
  *             FIPS-197(http://csrc.nist.gov/publications/fips/fips197/fips-197.pdf)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 15:00:00 バックエンド毎の性能測定を追加
+ * 2026/10/18 18:00:00 CRCの性能測定を追加
  *
  * LAST MODIFIED BY:
  *
@@ -55,6 +57,14 @@ extern "C" {
  */
 PUBLIC void vAES_test();
 
+/**
+ * 暗号処理の性能測定
+ * バックエンド、鍵長、モード、メッセージ長（16byte、80byte、4Kbyte）毎に
+ * 処理時間、1バイトあたりのサイクル数、スループットを出力する
+ * CRCはCCITT8、CRC16、CRC32をメッセージ長（16byte、90byte、240byte）毎に出力する
+ */
+PUBLIC void vAES_benchmark();
+
 #if defined __cplusplus
 }
 #endif
@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ * MODULE :CRC functions header file
+ *
+ * CREATED:2026/10/18 18:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:CRC-16/CRC-32のチェックサムを算出する関数群
+ *             CRC functions (header file)
+ *             4バイト単位で分割テーブルを参照する（Slicing-by-4）
+ *             CRC-16：CRC-16/CCITT-FALSE（多項式0x1021、初期値0xFFFF、最終XORなし）
+ *             CRC-32：CRC-32/ISO-HDLC（多項式0x04C11DB7反転、初期値と最終XORは0xFFFFFFFF）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef CRC_H_INCLUDED
+#define CRC_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// CRC-16の初期値
+#define CRC16_INIT                 (0xFFFF)
+// CRC-32の初期値
+#define CRC32_INIT                 (0xFFFFFFFF)
+// CRC-32の終端処理（最終XOR）
+#define CRC32_FINAL(u32Crc)        ((u32Crc) ^ 0xFFFFFFFF)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/**
+ * CRC-16の途中結果にデータを追加する
+ * 分割したデータを順に追加した結果は、連結したデータを一括で算出した結果と一致する
+ *
+ *	@param u16Crc 途中結果（最初はCRC16_INIT）
+ *	@param pu8Data 追加データの先頭のポインタ
+ *	@param u32Len 追加データの長さ
+ *	@return 追加後の途中結果（そのままCRC値として使用可能）
+ */
+PUBLIC uint16 u16CRC16_update(uint16 u16Crc, const uint8 *pu8Data, uint32 u32Len);
+
+/**
+ * CRC-16の算出
+ *
+ *	@param pu8Data データの先頭のポインタ
+ *	@param u32Len データの長さ
+ *	@return CRC値
+ */
+PUBLIC uint16 u16CRC16_calc(const uint8 *pu8Data, uint32 u32Len);
+
+/**
+ * CRC-32の途中結果にデータを追加する
+ * 分割したデータを順に追加した結果は、連結したデータを一括で算出した結果と一致する
+ *
+ *	@param u32Crc 途中結果（最初はCRC32_INIT）
+ *	@param pu8Data 追加データの先頭のポインタ
+ *	@param u32Len 追加データの長さ
+ *	@return 追加後の途中結果（CRC値はCRC32_FINALで求める）
+ */
+PUBLIC uint32 u32CRC32_update(uint32 u32Crc, const uint8 *pu8Data, uint32 u32Len);
+
+/**
+ * CRC-32の算出
+ *
+ *	@param pu8Data データの先頭のポインタ
+ *	@param u32Len データの長さ
+ *	@return CRC値
+ */
+PUBLIC uint32 u32CRC32_calc(const uint8 *pu8Data, uint32 u32Len);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* CRC_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
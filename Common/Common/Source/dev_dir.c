@@ -0,0 +1,317 @@
+/****************************************************************************
+ *
+ * MODULE :Device Directory functions source file
+ *
+ * CREATED:2026/10/19 01:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   EEPROM上のリモートデバイス情報のデバイスIDとレコード位置の対応を
+ *   RAM上のハッシュテーブルで管理する関数群
+ *   Device Directory functions (source file)
+ *   ・レコードの先頭４バイトをデバイスIDとして扱う
+ *   ・オープンアドレス法（線形探索）で管理し、削除時は後続のエントリを詰める
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <jendefs.h>
+
+#include "eeprom.h"
+#include "dev_dir.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// ハッシュ値のマスク
+#define DEV_DIR_HASH_MASK      (DEV_DIR_HASH_SIZE - 1)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// ハッシュ値の算出
+PRIVATE uint8 u8DevDir_hash(uint32 u32DevID);
+// エントリ位置の検索
+PRIVATE int iDevDir_find(tsDevDir* psDir, uint32 u32DevID);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: vDevDir_init
+ *
+ * DESCRIPTION:初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsDevDir*      psDir           W   デバイスディレクトリ
+ *   uint8          u8SlotCnt       R   レコード数（最大DEV_DIR_SLOT_MAX）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 全てのエントリを空にする
+ *****************************************************************************/
+PUBLIC void vDevDir_init(tsDevDir* psDir, uint8 u8SlotCnt) {
+	psDir->bValid     = FALSE;
+	psDir->u8SlotCnt  = (u8SlotCnt < DEV_DIR_SLOT_MAX) ? u8SlotCnt : DEV_DIR_SLOT_MAX;
+	psDir->u8EntryCnt = 0;
+	psDir->u32SlotMap = 0;
+	memset(psDir->u8Slot, DEV_DIR_SLOT_EMPTY, DEV_DIR_HASH_SIZE);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bDevDir_build
+ *
+ * DESCRIPTION:EEPROMからの構築
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsDevDir*      psDir           RW  デバイスディレクトリ
+ *   uint16         u16TopAddr      R   レコード領域の先頭アドレス
+ *   uint16         u16RecSize      R   レコードサイズ
+ *   uint32         u32SlotMap      R   使用中レコードのマップ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:構築成功
+ *
+ * NOTES:
+ * 事前にvDevDir_initでレコード数を設定しておく事
+ * 選択中のEEPROMから、使用中レコードのデバイスIDのみを読み込んで登録する
+ *****************************************************************************/
+PUBLIC bool_t bDevDir_build(tsDevDir* psDir, uint16 u16TopAddr, uint16 u16RecSize, uint32 u32SlotMap) {
+	vDevDir_init(psDir, psDir->u8SlotCnt);
+	uint32 u32DevID;
+	uint8 u8Slot;
+	for (u8Slot = 0; u8Slot < psDir->u8SlotCnt; u8Slot++) {
+		// レコード有無判定
+		if ((u32SlotMap & ((uint32)0x01 << u8Slot)) == 0) {
+			continue;
+		}
+		// デバイスIDの読み込み
+		if (bEEPROM_readData(u16TopAddr + u16RecSize * u8Slot, sizeof(uint32), (uint8*)&u32DevID) == FALSE) {
+			return FALSE;
+		}
+		bDevDir_add(psDir, u32DevID, u8Slot);
+	}
+	psDir->bValid = TRUE;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iDevDir_indexOf
+ *
+ * DESCRIPTION:デバイスIDの検索
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsDevDir*      psDir           R   デバイスディレクトリ
+ *   uint32         u32DevID        R   デバイスID
+ *
+ * RETURNS:
+ *   int            レコード位置、登録されていない場合は-1
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC int iDevDir_indexOf(tsDevDir* psDir, uint32 u32DevID) {
+	int iPos = iDevDir_find(psDir, u32DevID);
+	if (iPos < 0) {
+		return -1;
+	}
+	return psDir->u8Slot[iPos];
+}
+
+/*****************************************************************************
+ *
+ * NAME: bDevDir_add
+ *
+ * DESCRIPTION:登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsDevDir*      psDir           RW  デバイスディレクトリ
+ *   uint32         u32DevID        R   デバイスID
+ *   uint8          u8Slot          R   レコード位置
+ *
+ * RETURNS:
+ *   bool_t         TRUE:登録成功
+ *
+ * NOTES:
+ * 登録済みのデバイスIDの場合はレコード位置を更新する
+ *****************************************************************************/
+PUBLIC bool_t bDevDir_add(tsDevDir* psDir, uint32 u32DevID, uint8 u8Slot) {
+	// 入力チェック
+	if (u8Slot >= psDir->u8SlotCnt) {
+		return FALSE;
+	}
+	// 登録済みの場合は更新
+	int iPos = iDevDir_find(psDir, u32DevID);
+	if (iPos >= 0) {
+		psDir->u32SlotMap &= ~((uint32)0x01 << psDir->u8Slot[iPos]);
+		psDir->u32SlotMap |= ((uint32)0x01 << u8Slot);
+		psDir->u8Slot[iPos] = u8Slot;
+		return TRUE;
+	}
+	// 空きエントリの探索（探索が途切れないように１エントリは空ける）
+	if (psDir->u8EntryCnt >= DEV_DIR_HASH_SIZE - 1) {
+		return FALSE;
+	}
+	uint8 u8Pos = u8DevDir_hash(u32DevID);
+	while (psDir->u8Slot[u8Pos] != DEV_DIR_SLOT_EMPTY) {
+		u8Pos = (u8Pos + 1) & DEV_DIR_HASH_MASK;
+	}
+	psDir->u32DevID[u8Pos] = u32DevID;
+	psDir->u8Slot[u8Pos]   = u8Slot;
+	psDir->u32SlotMap |= ((uint32)0x01 << u8Slot);
+	psDir->u8EntryCnt++;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iDevDir_remove
+ *
+ * DESCRIPTION:削除
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsDevDir*      psDir           RW  デバイスディレクトリ
+ *   uint32         u32DevID        R   デバイスID
+ *
+ * RETURNS:
+ *   int            削除したエントリのレコード位置、登録されていない場合は-1
+ *
+ * NOTES:
+ * 削除位置以降の探索が途切れないように、後続のエントリを詰める
+ *****************************************************************************/
+PUBLIC int iDevDir_remove(tsDevDir* psDir, uint32 u32DevID) {
+	int iPos = iDevDir_find(psDir, u32DevID);
+	if (iPos < 0) {
+		return -1;
+	}
+	uint8 u8Slot = psDir->u8Slot[iPos];
+	psDir->u32SlotMap &= ~((uint32)0x01 << u8Slot);
+	psDir->u8EntryCnt--;
+	// 後続エントリの移動
+	uint8 u8Hole = (uint8)iPos;
+	uint8 u8Pos  = u8Hole;
+	uint8 u8Home;
+	while (TRUE) {
+		u8Pos = (u8Pos + 1) & DEV_DIR_HASH_MASK;
+		if (psDir->u8Slot[u8Pos] == DEV_DIR_SLOT_EMPTY) {
+			break;
+		}
+		// 本来の位置から空き位置までの距離が、現在位置までの距離以下なら移動
+		u8Home = u8DevDir_hash(psDir->u32DevID[u8Pos]);
+		if (((u8Pos - u8Home) & DEV_DIR_HASH_MASK) >= ((u8Pos - u8Hole) & DEV_DIR_HASH_MASK)) {
+			psDir->u32DevID[u8Hole] = psDir->u32DevID[u8Pos];
+			psDir->u8Slot[u8Hole]   = psDir->u8Slot[u8Pos];
+			u8Hole = u8Pos;
+		}
+	}
+	psDir->u8Slot[u8Hole] = DEV_DIR_SLOT_EMPTY;
+	return u8Slot;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iDevDir_freeSlot
+ *
+ * DESCRIPTION:空きレコードの検索
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsDevDir*      psDir           R   デバイスディレクトリ
+ *
+ * RETURNS:
+ *   int            空きレコードの位置、空きが無い場合は-1
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC int iDevDir_freeSlot(tsDevDir* psDir) {
+	uint8 u8Slot;
+	for (u8Slot = 0; u8Slot < psDir->u8SlotCnt; u8Slot++) {
+		if ((psDir->u32SlotMap & ((uint32)0x01 << u8Slot)) == 0) {
+			return u8Slot;
+		}
+	}
+	return -1;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: u8DevDir_hash
+ *
+ * DESCRIPTION:ハッシュ値の算出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32DevID        R   デバイスID
+ *
+ * RETURNS:
+ *   uint8          ハッシュ値（0～DEV_DIR_HASH_SIZE-1）
+ *
+ * NOTES:
+ * 連番のデバイスIDでも偏らないように、乗算ハッシュの上位ビットを使用する
+ *****************************************************************************/
+PRIVATE uint8 u8DevDir_hash(uint32 u32DevID) {
+	return (uint8)((u32DevID * 0x9E3779B1) >> (32 - DEV_DIR_HASH_BITS));
+}
+
+/*****************************************************************************
+ *
+ * NAME: iDevDir_find
+ *
+ * DESCRIPTION:エントリ位置の検索
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsDevDir*      psDir           R   デバイスディレクトリ
+ *   uint32         u32DevID        R   デバイスID
+ *
+ * RETURNS:
+ *   int            エントリ位置、登録されていない場合は-1
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE int iDevDir_find(tsDevDir* psDir, uint32 u32DevID) {
+	uint8 u8Pos = u8DevDir_hash(u32DevID);
+	uint8 u8Cnt;
+	for (u8Cnt = 0; u8Cnt < DEV_DIR_HASH_SIZE; u8Cnt++) {
+		if (psDir->u8Slot[u8Pos] == DEV_DIR_SLOT_EMPTY) {
+			break;
+		}
+		if (psDir->u32DevID[u8Pos] == u32DevID) {
+			return u8Pos;
+		}
+		u8Pos = (u8Pos + 1) & DEV_DIR_HASH_MASK;
+	}
+	return -1;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ * MODULE :Device Directory functions header file
+ *
+ * CREATED:2026/10/19 01:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   EEPROM上のリモートデバイス情報のデバイスIDとレコード位置の対応を
+ *   RAM上のハッシュテーブルで管理する関数群
+ *   Device Directory functions (header file)
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  DEVDIR_H_INCLUDED
+#define  DEVDIR_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// ハッシュテーブルサイズ（2のべき乗、レコード数の２倍以上を推奨）
+#ifndef DEV_DIR_HASH_BITS
+	#define DEV_DIR_HASH_BITS      (6)
+#endif
+#define DEV_DIR_HASH_SIZE      (0x01 << DEV_DIR_HASH_BITS)
+// 最大レコード数（レコードマップのビット数）
+#define DEV_DIR_SLOT_MAX       (32)
+// 空きエントリ
+#define DEV_DIR_SLOT_EMPTY     (0xFF)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：デバイスディレクトリ
+typedef struct {
+	// 構築済みフラグ
+	bool_t bValid;
+	// レコード数（領域のサイズ）
+	uint8 u8SlotCnt;
+	// 登録件数
+	uint8 u8EntryCnt;
+	// 使用中レコードのマップ
+	uint32 u32SlotMap;
+	// エントリ：デバイスID
+	uint32 u32DevID[DEV_DIR_HASH_SIZE];
+	// エントリ：レコード位置（DEV_DIR_SLOT_EMPTYの場合は空き）
+	uint8 u8Slot[DEV_DIR_HASH_SIZE];
+} tsDevDir;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/** 初期化 */
+PUBLIC void vDevDir_init(tsDevDir* psDir, uint8 u8SlotCnt);
+/** EEPROMからの構築 */
+PUBLIC bool_t bDevDir_build(tsDevDir* psDir, uint16 u16TopAddr, uint16 u16RecSize, uint32 u32SlotMap);
+/** デバイスIDの検索 */
+PUBLIC int iDevDir_indexOf(tsDevDir* psDir, uint32 u32DevID);
+/** 登録 */
+PUBLIC bool_t bDevDir_add(tsDevDir* psDir, uint32 u32DevID, uint8 u8Slot);
+/** 削除 */
+PUBLIC int iDevDir_remove(tsDevDir* psDir, uint32 u32DevID);
+/** 空きレコードの検索 */
+PUBLIC int iDevDir_freeSlot(tsDevDir* psDir);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* DEVDIR_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
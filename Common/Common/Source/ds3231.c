@@ -8,6 +8,7 @@
  * DESCRIPTION:DS3231 RTC draiver
  *
  * CHANGE HISTORY:
+ * 2026/10/19 17:00:00 I2Cスケジューラ経由の読み書きを追加
  *
  * LAST MODIFIED BY:
  *
@@ -20,6 +21,7 @@
 /****************************************************************************/
 /***        Include files                                                 ***/
 /****************************************************************************/
+#include <string.h>
 #include <jendefs.h>
 #include <AppHardwareApi.h>
 
@@ -27,6 +29,7 @@
 
 #include "ds3231.h"
 #include "i2c_util.h"
+#include "i2c_sched.h"
 #include "framework.h"
 
 /****************************************************************************/
@@ -74,6 +77,8 @@ PRIVATE const char DS3231_WEEKDAY[8][10] =
 	{"Err      ", "Sunday   ", "Monday   ", "Tuesday  ", "Wednesday", "Thursday ", "Friday   ", "Saturday "};
 /** デバイスアドレス */
 PRIVATE uint8 u8DS3231_device_addr = I2C_ADDR_DS3231;
+// I2Cスケジューラのデバイスインデックス（I2C_SCHED_DEVICE_NONE：直接通信）
+PRIVATE uint8 u8DS3231_schedDevIdx = I2C_SCHED_DEVICE_NONE;
 
 /****************************************************************************/
 /***        Local Function Prototypes                                     ***/
@@ -123,6 +128,24 @@ PUBLIC bool_t bDS3231_deviceSelect(uint8 address) {
 	return TRUE;
 }
 
+/*****************************************************************************
+ *
+ * NAME: vDS3231_setSchedDevice
+ *
+ * DESCRIPTION:I2Cスケジューラのデバイスの設定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8DevIdx        R   デバイスインデックス（I2C_SCHED_DEVICE_NONE：直接通信）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 設定以降の読み書きは、I2Cスケジューラに登録したデバイスのアドレスで実行する
+ *****************************************************************************/
+PUBLIC void vDS3231_setSchedDevice(uint8 u8DevIdx) {
+	u8DS3231_schedDevIdx = u8DevIdx;
+}
+
 /*****************************************************************************
  *
  * NAME: bDS3231_getAlarm1
@@ -583,6 +606,12 @@ PUBLIC const char* cpDS3231_convWeekday(uint8 wday) {
  * None.
  *****************************************************************************/
 PRIVATE bool_t bDS3231_readData(uint8 address, uint8 *data, uint8 len) {
+	// I2Cスケジューラ経由の場合は参照アドレスの書き込みと読み込みを１回の要求で実行
+	if (u8DS3231_schedDevIdx != I2C_SCHED_DEVICE_NONE) {
+		tsI2CSched_Req sReq;
+		vI2CSched_editReq(&sReq, &address, 1, data, len, 1);
+		return (u8I2CSched_exec(u8DS3231_schedDevIdx, &sReq) == I2CUTIL_STS_ACK);
+	}
 	// 書き込み開始宣言
 	if (!bI2C_startWrite(u8DS3231_device_addr)) {
 		bI2C_stopACK();
@@ -640,6 +669,16 @@ PRIVATE bool_t bDS3231_readData(uint8 address, uint8 *data, uint8 len) {
 PRIVATE bool_t bDS3231_writeData(uint8 address, const uint8 *data, uint8 len) {
 	// 入力チェック
 	if (len == 0) return TRUE;
+	// I2Cスケジューラ経由の場合はアドレスとデータを１回の要求で送信
+	if (u8DS3231_schedDevIdx != I2C_SCHED_DEVICE_NONE) {
+		if (len > DS3231_ADDR_TEMPERATURE2 + 1) return FALSE;
+		uint8 u8Trns[DS3231_ADDR_TEMPERATURE2 + 2];
+		u8Trns[0] = address;
+		memcpy(&u8Trns[1], data, len);
+		tsI2CSched_Req sReq;
+		vI2CSched_editReq(&sReq, u8Trns, 1 + len, NULL, 0, 0);
+		return (u8I2CSched_exec(u8DS3231_schedDevIdx, &sReq) == I2CUTIL_STS_ACK);
+	}
 	// 書き込み開始宣言
 	if (!bI2C_startWrite(u8DS3231_device_addr)) {
 		bI2C_stopACK();
@@ -8,6 +8,7 @@
  * DESCRIPTION:DS3231 RTC draiver
  *
  * CHANGE HISTORY:
+ * 2026/10/19 17:00:00 I2Cスケジューラのデバイスの設定を追加
  *
  * LAST MODIFIED BY:
  *
@@ -96,6 +97,8 @@ typedef struct {
 /****************************************************************************/
 /** デバイス選択 */
 PUBLIC bool_t bDS3231_deviceSelect(uint8 address);
+/** I2Cスケジューラのデバイスの設定 */
+PUBLIC void vDS3231_setSchedDevice(uint8 u8DevIdx);
 /** アラーム日時１情報取得 */
 PUBLIC bool_t bDS3231_getAlarm1(DS3231_datetime *datetime);
 /** アラーム日時２情報取得 */
@@ -8,6 +8,10 @@
  * DESCRIPTION:Microchip EEPROM driver
  *
  * CHANGE HISTORY:
+ * 2026/10/18 23:00:00 ページ単位の書き戻しキャッシュを追加し、書き込みをページ境界で分割
+ * 2026/10/19 00:00:00 ACKポーリングによる書き込み完了判定と非同期書き込みを追加
+ * 2026/10/19 05:00:00 連続読み込みによるページの先読みと、固定長レコードの先読みストリームを追加
+ * 2026/10/19 17:00:00 I2Cスケジューラ経由の読み書きとACKポーリングを追加
  *
  * LAST MODIFIED BY:
  *
@@ -20,65 +24,990 @@
 /****************************************************************************/
 /***        Include files                                                 ***/
 /****************************************************************************/
+#include <string.h>
 #include <jendefs.h>
 #include "eeprom.h"
 #include "i2c_util.h"
+#include "i2c_sched.h"
 #include "timer_util.h"
 #include "framework.h"
 
 /****************************************************************************/
 /***        Macro Definitions                                             ***/
 /****************************************************************************/
+// I2C読み込み１回当たりの最大バイト数（bI2C_readの読み込み長の上限）
+#define EEPROM_READ_CHUNK_SIZE (255)
 
 /****************************************************************************/
 /***        Type Definitions                                              ***/
 /****************************************************************************/
+/**
+ * キャッシュライン
+ */
+typedef struct {
+	tsEEPROM_status *spStatus;	// デバイス（NULL：無効）
+	uint16 u16PageAddr;			// ページの先頭アドレス
+	bool_t bDirty;				// 書き戻し要否
+	uint8 u8DirtyFrom;			// 書き戻し範囲（開始位置）
+	uint8 u8DirtyTo;			// 書き戻し範囲（終了位置の次）
+	uint32 u32LastUse;			// 最終使用順
+	uint8 u8Data[EEPROM_CACHE_LINE_SIZE];	// ページデータ
+} tsEEPROM_cacheLine;
+
+/**
+ * 非同期書き込み要求
+ */
+typedef struct {
+	tsEEPROM_status *spStatus;	// デバイス
+	teEEPROM_asyncStatus eStatus;	// 状態
+	teFwkEvent eCompEvt;		// 完了イベント
+	uint16 u16Addr;				// 書き込み先アドレス
+	uint16 u16Len;				// 書き込みデータ長
+	uint16 u16Idx;				// 書き込み済みデータ長
+	uint64 u64LastPoll;			// 最終ポーリング時刻
+	uint8 u8Data[EEPROM_ASYNC_BUFF_SIZE];	// 書き込みデータ
+} tsEEPROM_asyncReq;
 
 /****************************************************************************/
 /***        Local Function Prototypes                                     ***/
 /****************************************************************************/
+// キャッシュ使用判定
+PRIVATE bool_t bEEPROM_useCache();
+// キャッシュラインの検索
+PRIVATE tsEEPROM_cacheLine* psEEPROM_cacheFind(uint16 u16PageAddr);
+// キャッシュラインの確保
+PRIVATE tsEEPROM_cacheLine* psEEPROM_cacheAlloc(uint16 u16PageAddr, bool_t bFill);
+// キャッシュラインの書き戻し
+PRIVATE bool_t bEEPROM_cacheFlush(tsEEPROM_cacheLine* psLine);
+// データ読み込み（キャッシュ不使用）
+PRIVATE bool_t bEEPROM_readDirect(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff);
+// データ書き込み（キャッシュ不使用）
+PRIVATE bool_t bEEPROM_writeDirect(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, uint8 *pu8Data);
+// ページ書き込み
+PRIVATE bool_t bEEPROM_writePage(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, const uint8 *pu8Data);
+// 書き込みサイクルの完了判定（ACKポーリング）
+PRIVATE bool_t bEEPROM_pollAck(tsEEPROM_status *spStatus);
+// 書き込みサイクルの完了待ち
+PRIVATE bool_t bEEPROM_waitReady(tsEEPROM_status *spStatus);
+// キャッシュラインの破棄（範囲指定）
+PRIVATE void vEEPROM_cacheDrop(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len);
+// 非同期書き込みの終了処理
+PRIVATE void vEEPROM_asyncEnd(teEEPROM_asyncStatus eStatus);
+// 連続読み込みの開始
+PRIVATE bool_t bEEPROM_readBegin(tsEEPROM_status *spStatus, uint16 u16Addr);
+// 連続読み込み
+PRIVATE bool_t bEEPROM_readNext(uint8 *pu8Buff, uint16 u16Len, bool_t bLastFlg);
+// メモリアドレスの編集（I2Cスケジューラ経由の送信データ）
+PRIVATE uint8 u8EEPROM_editAddr(tsEEPROM_status *spStatus, uint16 u16Addr, uint8 *pu8Buff);
+// キャッシュラインの内容の反映（範囲指定）
+PRIVATE void vEEPROM_cacheOverlay(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff);
+// 先読みストリームのレコードの先読み済み判定
+PRIVATE bool_t bEEPROM_streamHit(tsEEPROM_stream *psStream, uint16 u16RecIdx);
+// 先読みストリームの一括読み込み
+PRIVATE bool_t bEEPROM_streamFill(tsEEPROM_stream *psStream, uint16 u16RecIdx, bool_t bForwardFlg);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// デバイス情報
+PRIVATE tsEEPROM_status *spEEPROM_status;
+// キャッシュライン
+PRIVATE tsEEPROM_cacheLine sEEPROM_cacheLines[EEPROM_CACHE_LINE_CNT];
+// キャッシュの使用順カウンタ
+PRIVATE uint32 u32EEPROM_useCnt = 0;
+// キャッシュの統計情報
+PRIVATE tsEEPROM_cacheStats sEEPROM_cacheStats;
+// 非同期書き込み要求
+PRIVATE tsEEPROM_asyncReq sEEPROM_asyncReq;
+// 書き込みの統計情報
+PRIVATE tsEEPROM_writeStats sEEPROM_writeStats;
+// 書き込み世代（書き込みとキャッシュの破棄の度に更新、先読みストリームの有効判定に使用）
+PRIVATE uint32 u32EEPROM_writeGen = 0;
+// I2Cスケジューラのデバイスインデックス（I2C_SCHED_DEVICE_NONE：直接通信）
+PRIVATE uint8 u8EEPROM_schedDevIdx = I2C_SCHED_DEVICE_NONE;
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_deviceSelect
+ *
+ * DESCRIPTION:デバイス選択
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       R   デバイスステータス情報
+ *
+ * RETURNS:
+ *   bool_t         TRUE:デバイス選択成功
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_deviceSelect(tsEEPROM_status *spStatus) {
+	// デバイスステータス情報
+	spEEPROM_status = spStatus;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROM_setSchedDevice
+ *
+ * DESCRIPTION:I2Cスケジューラのデバイスの設定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス（I2C_SCHED_DEVICE_NONE：直接通信）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 設定以降の読み書きとACKポーリングは、I2Cスケジューラへの要求として実行する
+ * 選択中のデバイスと同じアドレスとバスで登録したデバイスを指定する事
+ *****************************************************************************/
+PUBLIC void vEEPROM_setSchedDevice(uint8 u8DevIdx) {
+	u8EEPROM_schedDevIdx = u8DevIdx;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_readData
+ *
+ * DESCRIPTION:データ読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint16         u16Len          R   読み込み長
+ *   uint8*         pu8Buff         R   読み込みバッファ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:読み込み成功
+ *
+ * NOTES:
+ * キャッシュ使用時はページ単位でキャッシュから読み込む
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_readData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff) {
+	// 入力チェック
+	if (u16Len <= 0) return TRUE;
+	// キャッシュ不使用
+	if (bEEPROM_useCache() == FALSE) {
+		return bEEPROM_readDirect(spEEPROM_status, u16Addr, u16Len, pu8Buff);
+	}
+	// ページ単位の読み込み
+	tsEEPROM_cacheLine* psLine;
+	uint16 u16PageSize = spEEPROM_status->u8PageSize;
+	uint16 u16Offset;
+	uint16 u16Size;
+	uint16 u16Idx = 0;
+	while (u16Idx < u16Len) {
+		u16Offset = (u16Addr + u16Idx) % u16PageSize;
+		u16Size = u16PageSize - u16Offset;
+		if (u16Size > u16Len - u16Idx) {
+			u16Size = u16Len - u16Idx;
+		}
+		sEEPROM_cacheStats.u32ReadCnt++;
+		psLine = psEEPROM_cacheFind(u16Addr + u16Idx - u16Offset);
+		if (psLine != NULL) {
+			sEEPROM_cacheStats.u32ReadHitCnt++;
+		} else {
+			psLine = psEEPROM_cacheAlloc(u16Addr + u16Idx - u16Offset, TRUE);
+			if (psLine == NULL) {
+				return FALSE;
+			}
+		}
+		memcpy(&pu8Buff[u16Idx], &psLine->u8Data[u16Offset], u16Size);
+		psLine->u32LastUse = ++u32EEPROM_useCnt;
+		u16Idx += u16Size;
+	}
+	// 読み込み完了
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_writeData
+ *
+ * DESCRIPTION:データ書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint16         u16Len          R   書き込みデータ長
+ *   uint8*         pu8Data         R   書き込みデータ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:読み込み成功
+ *
+ * NOTES:
+ * キャッシュ使用時はキャッシュに書き込み、bEEPROM_commit等で書き戻すまで
+ * EEPROMには書き込まない
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_writeData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Data) {
+	// 入力チェック
+	if (u16Len <= 0) return TRUE;
+	// 先読み済みデータの無効化
+	u32EEPROM_writeGen++;
+	// キャッシュ不使用
+	if (bEEPROM_useCache() == FALSE) {
+		return bEEPROM_writeDirect(spEEPROM_status, u16Addr, u16Len, pu8Data);
+	}
+	// ページ単位の書き込み
+	tsEEPROM_cacheLine* psLine;
+	uint16 u16PageSize = spEEPROM_status->u8PageSize;
+	uint16 u16Offset;
+	uint16 u16Size;
+	uint16 u16Idx = 0;
+	while (u16Idx < u16Len) {
+		u16Offset = (u16Addr + u16Idx) % u16PageSize;
+		u16Size = u16PageSize - u16Offset;
+		if (u16Size > u16Len - u16Idx) {
+			u16Size = u16Len - u16Idx;
+		}
+		sEEPROM_cacheStats.u32WriteCnt++;
+		psLine = psEEPROM_cacheFind(u16Addr + u16Idx - u16Offset);
+		if (psLine != NULL) {
+			sEEPROM_cacheStats.u32WriteHitCnt++;
+		} else {
+			// ページ全体を書き込む場合は読み込み不要
+			psLine = psEEPROM_cacheAlloc(u16Addr + u16Idx - u16Offset, (u16Size < u16PageSize));
+			if (psLine == NULL) {
+				return FALSE;
+			}
+		}
+		memcpy(&psLine->u8Data[u16Offset], &pu8Data[u16Idx], u16Size);
+		// 書き戻し範囲の更新
+		if (psLine->bDirty == FALSE) {
+			psLine->bDirty      = TRUE;
+			psLine->u8DirtyFrom = u16Offset;
+			psLine->u8DirtyTo   = u16Offset + u16Size;
+		} else {
+			if (u16Offset < psLine->u8DirtyFrom) {
+				psLine->u8DirtyFrom = u16Offset;
+			}
+			if (u16Offset + u16Size > psLine->u8DirtyTo) {
+				psLine->u8DirtyTo = u16Offset + u16Size;
+			}
+		}
+		psLine->u32LastUse = ++u32EEPROM_useCnt;
+		u16Idx += u16Size;
+	}
+	// 書き込み完了
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_commit
+ *
+ * DESCRIPTION:キャッシュの書き戻し
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き戻し成功
+ *
+ * NOTES:
+ * 全てのデバイスの書き戻しが必要なページを、ページ毎に１回の書き込みで書き戻す
+ * I2Cバスを切り替える場合は、切り替える前に呼び出す事
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_commit() {
+	bool_t bResult = TRUE;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < EEPROM_CACHE_LINE_CNT; u8Idx++) {
+		if (bEEPROM_cacheFlush(&sEEPROM_cacheLines[u8Idx]) == FALSE) {
+			bResult = FALSE;
+		}
+	}
+	return bResult;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_flushIdle
+ *
+ * DESCRIPTION:キャッシュの書き戻し（書き込み待ちが不要な場合のみ）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き戻しが必要なページが無い
+ *
+ * NOTES:
+ * 書き込みサイクルの経過を待たずに書き込めるページを、最も古いものから１ページ書き戻す
+ * アイドル時に繰り返し呼び出す事を想定
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_flushIdle() {
+	tsEEPROM_cacheLine* psLine;
+	tsEEPROM_cacheLine* psOldest = NULL;
+	uint8 u8DirtyCnt = 0;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < EEPROM_CACHE_LINE_CNT; u8Idx++) {
+		psLine = &sEEPROM_cacheLines[u8Idx];
+		if (psLine->spStatus == NULL || psLine->bDirty == FALSE) {
+			continue;
+		}
+		u8DirtyCnt++;
+		if (psOldest == NULL || psLine->u32LastUse < psOldest->u32LastUse) {
+			psOldest = psLine;
+		}
+	}
+	if (psOldest == NULL) {
+		return TRUE;
+	}
+	// 非同期書き込み中もしくは書き込みサイクル中の場合は何もしない
+	if (bEEPROM_asyncIsBusy() || bEEPROM_pollAck(psOldest->spStatus) == FALSE) {
+		return FALSE;
+	}
+	if (bEEPROM_cacheFlush(psOldest) == FALSE) {
+		return FALSE;
+	}
+	return (u8DirtyCnt <= 1);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROM_cacheInvalidate
+ *
+ * DESCRIPTION:キャッシュの破棄
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 書き戻しが必要なページも破棄するので、必要に応じてbEEPROM_commitを先に呼び出す事
+ *****************************************************************************/
+PUBLIC void vEEPROM_cacheInvalidate() {
+	// 先読み済みデータの無効化
+	u32EEPROM_writeGen++;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < EEPROM_CACHE_LINE_CNT; u8Idx++) {
+		sEEPROM_cacheLines[u8Idx].spStatus = NULL;
+		sEEPROM_cacheLines[u8Idx].bDirty   = FALSE;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: psEEPROM_getCacheStats
+ *
+ * DESCRIPTION:キャッシュの統計情報の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsEEPROM_cacheStats* 統計情報
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC const tsEEPROM_cacheStats* psEEPROM_getCacheStats() {
+	return &sEEPROM_cacheStats;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROM_resetCacheStats
+ *
+ * DESCRIPTION:キャッシュの統計情報の初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vEEPROM_resetCacheStats() {
+	memset(&sEEPROM_cacheStats, 0x00, sizeof(tsEEPROM_cacheStats));
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_writeAsync
+ *
+ * DESCRIPTION:非同期データ書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint16         u16Len          R   書き込みデータ長
+ *   uint8*         pu8Data         R   書き込みデータ
+ *   teFwkEvent     eCompEvt        R   完了イベント（E_EVENT_FWK_EMPTYの場合は通知しない）
+ *
+ * RETURNS:
+ *   bool_t         TRUE:受付成功
+ *
+ * NOTES:
+ * 選択中のデバイスへの書き込みを受け付けて即座に復帰する
+ * 実行中の要求がある場合は、その完了を待ってから受け付ける
+ * 書き込みデータは内部バッファに複写するので、呼び出し元で保持する必要は無い
+ * 実際の書き込みはeEEPROM_asyncProceedの呼び出し毎に１ページずつ行う
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_writeAsync(uint16 u16Addr, uint16 u16Len, const uint8 *pu8Data, teFwkEvent eCompEvt) {
+	// 入力チェック
+	if (u16Len <= 0 || u16Len > EEPROM_ASYNC_BUFF_SIZE) return FALSE;
+	// 先読み済みデータの無効化
+	u32EEPROM_writeGen++;
+	// 実行中の要求の完了待ち
+	bEEPROM_asyncWait();
+	// 書き込み範囲のキャッシュを書き戻して破棄
+	if (bEEPROM_commit() == FALSE) return FALSE;
+	vEEPROM_cacheDrop(spEEPROM_status, u16Addr, u16Len);
+	// 要求の登録
+	sEEPROM_asyncReq.spStatus    = spEEPROM_status;
+	sEEPROM_asyncReq.eStatus     = E_EEPROM_ASYNC_WRITE;
+	sEEPROM_asyncReq.eCompEvt    = eCompEvt;
+	sEEPROM_asyncReq.u16Addr     = u16Addr;
+	sEEPROM_asyncReq.u16Len      = u16Len;
+	sEEPROM_asyncReq.u16Idx      = 0;
+	sEEPROM_asyncReq.u64LastPoll = 0;
+	memcpy(sEEPROM_asyncReq.u8Data, pu8Data, u16Len);
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: eEEPROM_asyncProceed
+ *
+ * DESCRIPTION:非同期書き込みの進行
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   teEEPROM_asyncStatus 処理後の状態
+ *
+ * NOTES:
+ * イベントループから繰り返し呼び出す事
+ * 書き込みサイクル中はEEPROM_POLL_INTERVAL間隔でACKポーリングのみを行い、
+ * 完了を検知したら次のページを書き込んで復帰する
+ *****************************************************************************/
+PUBLIC teEEPROM_asyncStatus eEEPROM_asyncProceed() {
+	tsEEPROM_asyncReq* psReq = &sEEPROM_asyncReq;
+	uint64 u64Now = u64TimerUtil_readUsec();
+	// 書き込みサイクルの完了判定
+	if (psReq->eStatus == E_EEPROM_ASYNC_POLL) {
+		if (u64Now < psReq->u64LastPoll + EEPROM_POLL_INTERVAL) {
+			return psReq->eStatus;
+		}
+		psReq->u64LastPoll = u64Now;
+		if (bEEPROM_pollAck(psReq->spStatus) == FALSE) {
+			return psReq->eStatus;
+		}
+		// 全データの書き込み完了
+		if (psReq->u16Idx >= psReq->u16Len) {
+			vEEPROM_asyncEnd(E_EEPROM_ASYNC_IDLE);
+			return psReq->eStatus;
+		}
+		psReq->eStatus = E_EEPROM_ASYNC_WRITE;
+	}
+	// 次のページの書き込み
+	if (psReq->eStatus == E_EEPROM_ASYNC_WRITE) {
+		// 書き込みサイクル中の場合
+		if (bEEPROM_pollAck(psReq->spStatus) == FALSE) {
+			psReq->eStatus     = E_EEPROM_ASYNC_POLL;
+			psReq->u64LastPoll = u64Now;
+			return psReq->eStatus;
+		}
+		// 書き込みサイズの判定（ページ境界を越えない）
+		uint16 u16Addr = psReq->u16Addr + psReq->u16Idx;
+		uint16 u16Size = psReq->spStatus->u8PageSize - (u16Addr % psReq->spStatus->u8PageSize);
+		if (u16Size > psReq->u16Len - psReq->u16Idx) {
+			u16Size = psReq->u16Len - psReq->u16Idx;
+		}
+		if (bEEPROM_writePage(psReq->spStatus, u16Addr, u16Size, &psReq->u8Data[psReq->u16Idx]) == FALSE) {
+			vEEPROM_asyncEnd(E_EEPROM_ASYNC_ERROR);
+			return psReq->eStatus;
+		}
+		psReq->u16Idx     += u16Size;
+		psReq->eStatus     = E_EEPROM_ASYNC_POLL;
+		psReq->u64LastPoll = u64TimerUtil_readUsec();
+	}
+	return psReq->eStatus;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_asyncIsBusy
+ *
+ * DESCRIPTION:非同期書き込みの実行中判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:実行中
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_asyncIsBusy() {
+	return (sEEPROM_asyncReq.eStatus == E_EEPROM_ASYNC_WRITE
+		|| sEEPROM_asyncReq.eStatus == E_EEPROM_ASYNC_POLL);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_asyncWait
+ *
+ * DESCRIPTION:非同期書き込みの完了待ち
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き込み成功もしくは実行中の要求無し
+ *
+ * NOTES:
+ * 同期読み書きの前にも呼び出され、実行中の要求を同期的に完了させる
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_asyncWait() {
+	if (bEEPROM_asyncIsBusy() == FALSE) {
+		return TRUE;
+	}
+	while (bEEPROM_asyncIsBusy()) {
+		// 次のポーリング時刻まで待機
+		if (sEEPROM_asyncReq.eStatus == E_EEPROM_ASYNC_POLL) {
+			u32TimerUtil_waitUntil(sEEPROM_asyncReq.u64LastPoll + EEPROM_POLL_INTERVAL);
+		}
+		eEEPROM_asyncProceed();
+	}
+	return (sEEPROM_asyncReq.eStatus != E_EEPROM_ASYNC_ERROR);
+}
+
+/*****************************************************************************
+ *
+ * NAME: psEEPROM_getWriteStats
+ *
+ * DESCRIPTION:書き込みの統計情報の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsEEPROM_writeStats* 統計情報
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC const tsEEPROM_writeStats* psEEPROM_getWriteStats() {
+	return &sEEPROM_writeStats;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROM_resetWriteStats
+ *
+ * DESCRIPTION:書き込みの統計情報の初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vEEPROM_resetWriteStats() {
+	memset(&sEEPROM_writeStats, 0x00, sizeof(tsEEPROM_writeStats));
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_prefetch
+ *
+ * DESCRIPTION:ページの先読み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint16         u16Len          R   先読み長
+ *
+ * RETURNS:
+ *   bool_t         TRUE:先読み成功もしくは先読み不要
+ *
+ * NOTES:
+ * 指定範囲のページの内、キャッシュに無い連続したページを１回の連続読み込みでキャッシュに読み込む
+ * キャッシュ不使用時は何もしない
+ * 先読みするページ数はキャッシュライン数までとする
+ * I2Cスケジューラ経由の場合は、１回の要求がキャッシュライン単位となる様にページ毎に読み込む
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_prefetch(uint16 u16Addr, uint16 u16Len) {
+	// 入力チェック
+	if (u16Len <= 0 || bEEPROM_useCache() == FALSE) return TRUE;
+	uint16 u16PageSize = spEEPROM_status->u8PageSize;
+	uint16 u16Page = u16Addr - (u16Addr % u16PageSize);
+	uint16 u16PageCnt = (u16Addr + u16Len - u16Page + u16PageSize - 1) / u16PageSize;
+	if (u16PageCnt > EEPROM_CACHE_LINE_CNT) {
+		u16PageCnt = EEPROM_CACHE_LINE_CNT;
+	}
+	// キャッシュに無いページの範囲
+	tsEEPROM_cacheLine* psLines[EEPROM_CACHE_LINE_CNT];
+	uint16 u16From = u16PageCnt;
+	uint16 u16To = 0;
+	uint16 u16Idx;
+	for (u16Idx = 0; u16Idx < u16PageCnt; u16Idx++) {
+		if (psEEPROM_cacheFind(u16Page + u16PageSize * u16Idx) == NULL) {
+			if (u16From > u16Idx) {
+				u16From = u16Idx;
+			}
+			u16To = u16Idx + 1;
+		}
+	}
+	if (u16From >= u16To) {
+		return TRUE;
+	}
+	// キャッシュラインの確保（書き戻しを伴うので連続読み込みの開始前に行う）
+	bool_t bFill[EEPROM_CACHE_LINE_CNT];
+	bool_t bAlloc = TRUE;
+	for (u16Idx = u16From; u16Idx < u16To; u16Idx++) {
+		// 範囲内のキャッシュ済みページは再利用されない様に使用順を更新して読み飛ばす
+		psLines[u16Idx] = psEEPROM_cacheFind(u16Page + u16PageSize * u16Idx);
+		bFill[u16Idx] = (psLines[u16Idx] == NULL);
+		if (bFill[u16Idx]) {
+			psLines[u16Idx] = psEEPROM_cacheAlloc(u16Page + u16PageSize * u16Idx, FALSE);
+		}
+		if (psLines[u16Idx] == NULL) {
+			bAlloc = FALSE;
+			u16To  = u16Idx;
+			break;
+		}
+		psLines[u16Idx]->u32LastUse = ++u32EEPROM_useCnt;
+	}
+	// 連続読み込み
+	uint8 u8Skip[EEPROM_CACHE_LINE_SIZE];
+	bool_t bResult;
+	if (u8EEPROM_schedDevIdx != I2C_SCHED_DEVICE_NONE) {
+		// I2Cスケジューラ経由の場合は、キャッシュに無いページ毎に読み込み要求を実行
+		bResult = (u16From < u16To);
+		for (u16Idx = u16From; u16Idx < u16To && bResult; u16Idx++) {
+			if (bFill[u16Idx]) {
+				bResult = bEEPROM_readDirect(spEEPROM_status, u16Page + u16PageSize * u16Idx,
+						u16PageSize, psLines[u16Idx]->u8Data);
+			}
+		}
+	} else {
+		bResult = (u16From < u16To) && bEEPROM_readBegin(spEEPROM_status, u16Page + u16PageSize * u16From);
+		for (u16Idx = u16From; u16Idx < u16To && bResult; u16Idx++) {
+			bResult = bEEPROM_readNext(bFill[u16Idx] ? psLines[u16Idx]->u8Data : u8Skip,
+					u16PageSize, (u16Idx + 1 >= u16To));
+		}
+	}
+	// 読み込んだキャッシュラインの確定（失敗時は破棄）
+	for (u16Idx = u16From; u16Idx < u16To; u16Idx++) {
+		if (bFill[u16Idx] == FALSE) {
+			continue;
+		}
+		if (bResult) {
+			sEEPROM_cacheStats.u32FillCnt++;
+		} else {
+			psLines[u16Idx]->spStatus = NULL;
+		}
+	}
+	return (bAlloc && bResult);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROM_streamInit
+ *
+ * DESCRIPTION:先読みストリームの初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_stream  *psStream       W   先読みストリーム
+ *   uint16         u16TopAddr      R   レコード領域の先頭アドレス
+ *   uint16         u16RecSize      R   レコードサイズ
+ *   uint16         u16RecCnt       R   レコード数
+ *   uint8*         pu8Buff         R   先読みバッファ
+ *   uint16         u16BuffSize     R   先読みバッファサイズ（レコードサイズ以上）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 先読みバッファは呼び出し元で確保し、ストリームの使用中は保持する事
+ *****************************************************************************/
+PUBLIC void vEEPROM_streamInit(tsEEPROM_stream *psStream, uint16 u16TopAddr, uint16 u16RecSize, uint16 u16RecCnt, uint8 *pu8Buff, uint16 u16BuffSize) {
+	memset(psStream, 0x00, sizeof(tsEEPROM_stream));
+	psStream->spStatus   = NULL;
+	psStream->u16TopAddr = u16TopAddr;
+	psStream->u16RecSize = u16RecSize;
+	psStream->u16RecCnt  = u16RecCnt;
+	psStream->pu8Buff    = pu8Buff;
+	psStream->u16WinCnt  = u16BuffSize / u16RecSize;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_streamRead
+ *
+ * DESCRIPTION:先読みストリームからのレコード読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_stream  *psStream       RW  先読みストリーム
+ *   uint16         u16RecIdx       R   レコードインデックス
+ *   bool_t         bForwardFlg     R   順方向探索フラグ
+ *   uint8*         pu8Rec          W   読み込みバッファ（レコードサイズ）
+ *
+ * RETURNS:
+ *   bool_t         TRUE:読み込み成功
+ *
+ * NOTES:
+ * 選択中のデバイスから読み込む
+ * 先読みされていない場合は、探索方向に先読みバッファ分のレコードを１回の連続読み込みで読み込む
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_streamRead(tsEEPROM_stream *psStream, uint16 u16RecIdx, bool_t bForwardFlg, uint8 *pu8Rec) {
+	// 入力チェック
+	if (u16RecIdx >= psStream->u16RecCnt) return FALSE;
+	uint64 u64Start = u64TimerUtil_readUsec();
+	psStream->u32ReadCnt++;
+	if (bEEPROM_streamHit(psStream, u16RecIdx)) {
+		psStream->u32HitCnt++;
+	} else if (bEEPROM_streamFill(psStream, u16RecIdx, bForwardFlg) == FALSE) {
+		return FALSE;
+	}
+	memcpy(pu8Rec, &psStream->pu8Buff[psStream->u16RecSize * (u16RecIdx - psStream->u16WinTop)], psStream->u16RecSize);
+	// 読み込み時間の集計
+	psStream->u32LastUsec = (uint32)(u64TimerUtil_readUsec() - u64Start);
+	if (psStream->u32LastUsec > psStream->u32MaxUsec) {
+		psStream->u32MaxUsec = psStream->u32LastUsec;
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_streamPrefetch
+ *
+ * DESCRIPTION:先読みストリームの先読み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_stream  *psStream       RW  先読みストリーム
+ *   uint16         u16RecIdx       R   次に読み込むレコードインデックス
+ *   bool_t         bForwardFlg     R   順方向探索フラグ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:先読み成功もしくは先読み不要
+ *
+ * NOTES:
+ * 選択中のデバイスから読み込む
+ * 画面描画後のアイドル時等に呼び出して、次の読み込みを先読みバッファから行える様にする
+ *****************************************************************************/
+PUBLIC bool_t bEEPROM_streamPrefetch(tsEEPROM_stream *psStream, uint16 u16RecIdx, bool_t bForwardFlg) {
+	// 入力チェック
+	if (u16RecIdx >= psStream->u16RecCnt) return FALSE;
+	if (bEEPROM_streamHit(psStream, u16RecIdx)) {
+		return TRUE;
+	}
+	return bEEPROM_streamFill(psStream, u16RecIdx, bForwardFlg);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROM_streamInvalidate
+ *
+ * DESCRIPTION:先読みストリームの破棄
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_stream  *psStream       RW  先読みストリーム
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 本モジュール経由の書き込みは自動的に検知するので、それ以外の要因で内容が変わる場合に呼び出す
+ *****************************************************************************/
+PUBLIC void vEEPROM_streamInvalidate(tsEEPROM_stream *psStream) {
+	psStream->spStatus  = NULL;
+	psStream->u16WinLen = 0;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_useCache
+ *
+ * DESCRIPTION:キャッシュ使用判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:選択中のデバイスでキャッシュを使用する
+ *
+ * NOTES:
+ * ページサイズがキャッシュラインより大きい場合は使用しない
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_useCache() {
+	return (spEEPROM_status->bCacheFlg
+		&& spEEPROM_status->u8PageSize > 0
+		&& spEEPROM_status->u8PageSize <= EEPROM_CACHE_LINE_SIZE);
+}
+
+/*****************************************************************************
+ *
+ * NAME: psEEPROM_cacheFind
+ *
+ * DESCRIPTION:キャッシュラインの検索
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16PageAddr     R   ページの先頭アドレス
+ *
+ * RETURNS:
+ *   tsEEPROM_cacheLine* 選択中のデバイスのキャッシュライン、無い場合はNULL
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE tsEEPROM_cacheLine* psEEPROM_cacheFind(uint16 u16PageAddr) {
+	tsEEPROM_cacheLine* psLine;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < EEPROM_CACHE_LINE_CNT; u8Idx++) {
+		psLine = &sEEPROM_cacheLines[u8Idx];
+		if (psLine->spStatus == spEEPROM_status && psLine->u16PageAddr == u16PageAddr) {
+			return psLine;
+		}
+	}
+	return NULL;
+}
 
-/****************************************************************************/
-/***        Exported Variables                                            ***/
-/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: psEEPROM_cacheAlloc
+ *
+ * DESCRIPTION:キャッシュラインの確保
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16PageAddr     R   ページの先頭アドレス
+ *   bool_t         bFill           R   ページをEEPROMから読み込む
+ *
+ * RETURNS:
+ *   tsEEPROM_cacheLine* 確保したキャッシュライン、エラー時はNULL
+ *
+ * NOTES:
+ * 空きが無い場合は最も長く使用されていないラインを書き戻して再利用する
+ *****************************************************************************/
+PRIVATE tsEEPROM_cacheLine* psEEPROM_cacheAlloc(uint16 u16PageAddr, bool_t bFill) {
+	// 再利用するラインの選択
+	tsEEPROM_cacheLine* psLine;
+	tsEEPROM_cacheLine* psVictim = &sEEPROM_cacheLines[0];
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < EEPROM_CACHE_LINE_CNT; u8Idx++) {
+		psLine = &sEEPROM_cacheLines[u8Idx];
+		if (psLine->spStatus == NULL) {
+			psVictim = psLine;
+			break;
+		}
+		if (psLine->u32LastUse < psVictim->u32LastUse) {
+			psVictim = psLine;
+		}
+	}
+	if (bEEPROM_cacheFlush(psVictim) == FALSE) {
+		return NULL;
+	}
+	psVictim->spStatus = NULL;
+	// ページの読み込み
+	if (bFill) {
+		sEEPROM_cacheStats.u32FillCnt++;
+		if (bEEPROM_readDirect(spEEPROM_status, u16PageAddr, spEEPROM_status->u8PageSize, psVictim->u8Data) == FALSE) {
+			return NULL;
+		}
+	}
+	psVictim->spStatus    = spEEPROM_status;
+	psVictim->u16PageAddr = u16PageAddr;
+	psVictim->bDirty      = FALSE;
+	psVictim->u32LastUse  = ++u32EEPROM_useCnt;
+	return psVictim;
+}
 
-/****************************************************************************/
-/***        Local Variables                                               ***/
-/****************************************************************************/
-// デバイス情報
-PRIVATE tsEEPROM_status *spEEPROM_status;
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_cacheFlush
+ *
+ * DESCRIPTION:キャッシュラインの書き戻し
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROM_cacheLine* psLine     RW  キャッシュライン
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き戻し成功もしくは書き戻し不要
+ *
+ * NOTES:
+ * 変更範囲のみを１回のページ書き込みで書き戻す
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_cacheFlush(tsEEPROM_cacheLine* psLine) {
+	if (psLine->spStatus == NULL || psLine->bDirty == FALSE) {
+		return TRUE;
+	}
+	sEEPROM_cacheStats.u32FlushCnt++;
+	if (bEEPROM_writeDirect(psLine->spStatus, psLine->u16PageAddr + psLine->u8DirtyFrom,
+			psLine->u8DirtyTo - psLine->u8DirtyFrom, &psLine->u8Data[psLine->u8DirtyFrom]) == FALSE) {
+		return FALSE;
+	}
+	psLine->bDirty = FALSE;
+	return TRUE;
+}
 
-/****************************************************************************/
-/***        Exported Functions                                            ***/
-/****************************************************************************/
 /*****************************************************************************
  *
- * NAME: bEEPROM_deviceSelect
+ * NAME: vEEPROM_cacheDrop
  *
- * DESCRIPTION:デバイス選択
+ * DESCRIPTION:キャッシュラインの破棄（範囲指定）
  *
  * PARAMETERS:      Name            RW  Usage
  * tsEEPROM_status  *spStatus       R   デバイスステータス情報
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint16         u16Len          R   データ長
  *
  * RETURNS:
- *   bool_t         TRUE:デバイス選択成功
  *
  * NOTES:
- * None.
+ * 指定範囲を含むラインを書き戻さずに破棄する
  *****************************************************************************/
-PUBLIC bool_t bEEPROM_deviceSelect(tsEEPROM_status *spStatus) {
-	// デバイスステータス情報
-	spEEPROM_status = spStatus;
-	return TRUE;
+PRIVATE void vEEPROM_cacheDrop(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len) {
+	tsEEPROM_cacheLine* psLine;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < EEPROM_CACHE_LINE_CNT; u8Idx++) {
+		psLine = &sEEPROM_cacheLines[u8Idx];
+		if (psLine->spStatus != spStatus) {
+			continue;
+		}
+		if (psLine->u16PageAddr < u16Addr + u16Len
+			&& u16Addr < psLine->u16PageAddr + spStatus->u8PageSize) {
+			psLine->spStatus = NULL;
+			psLine->bDirty   = FALSE;
+		}
+	}
 }
 
 /*****************************************************************************
  *
- * NAME: bEEPROM_readData
+ * NAME: vEEPROM_asyncEnd
  *
- * DESCRIPTION:データ読み込み
+ * DESCRIPTION:非同期書き込みの終了処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * teEEPROM_asyncStatus eStatus     R   終了後の状態
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 完了イベントを通知する
+ *****************************************************************************/
+PRIVATE void vEEPROM_asyncEnd(teEEPROM_asyncStatus eStatus) {
+	sEEPROM_asyncReq.eStatus = eStatus;
+	if (eStatus == E_EEPROM_ASYNC_ERROR) {
+		sEEPROM_writeStats.u32ErrCnt++;
+	}
+	if (sEEPROM_asyncReq.eCompEvt != E_EVENT_FWK_EMPTY) {
+		iEntrySeqEvt(sEEPROM_asyncReq.eCompEvt);
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_readDirect
+ *
+ * DESCRIPTION:データ読み込み（キャッシュ不使用）
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       R   デバイスステータス情報
  *   uint16         u16Addr         R   メモリアドレス
  *   uint16         u16Len          R   読み込み長
  *   uint8*         pu8Buff         R   読み込みバッファ
@@ -87,18 +1016,57 @@ PUBLIC bool_t bEEPROM_deviceSelect(tsEEPROM_status *spStatus) {
  *   bool_t         TRUE:読み込み成功
  *
  * NOTES:
- * None.
+ * I2Cスケジューラ経由の場合は、スケジューラに登録したデバイスのアドレスで通信する
  *****************************************************************************/
-PUBLIC bool_t bEEPROM_readData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff) {
-	// 入力チェック
-	if (u16Len <= 0) return TRUE;
+PRIVATE bool_t bEEPROM_readDirect(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff) {
+	// I2Cスケジューラ経由の場合は参照開始アドレスの書き込みと読み込みを１回の要求で実行
+	if (u8EEPROM_schedDevIdx != I2C_SCHED_DEVICE_NONE) {
+		// 非同期書き込みと書き込みサイクルの完了待ち
+		bEEPROM_asyncWait();
+		bEEPROM_waitReady(spStatus);
+		uint8 u8Addr[2];
+		uint8 u8AddrLen = u8EEPROM_editAddr(spStatus, u16Addr, u8Addr);
+		tsI2CSched_Req sReq;
+		vI2CSched_editReq(&sReq, u8Addr, u8AddrLen, pu8Buff, u16Len, u8AddrLen);
+		return (u8I2CSched_exec(u8EEPROM_schedDevIdx, &sReq) == I2CUTIL_STS_ACK);
+	}
+	// 読み込み開始
+	if (bEEPROM_readBegin(spStatus, u16Addr) == FALSE) {
+		return FALSE;
+	}
+	// データの読み込み処理（I2C通信完了まで）
+	return bEEPROM_readNext(pu8Buff, u16Len, TRUE);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_readBegin
+ *
+ * DESCRIPTION:連続読み込みの開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       R   デバイスステータス情報
+ *   uint16         u16Addr         R   メモリアドレス
+ *
+ * RETURNS:
+ *   bool_t         TRUE:開始成功
+ *
+ * NOTES:
+ * 参照開始アドレスを送信して読み込み開始宣言まで行う
+ * 以降はbEEPROM_readNextで、アドレスを再送せずに後続のデータを読み込む
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_readBegin(tsEEPROM_status *spStatus, uint16 u16Addr) {
+	// 非同期書き込みの完了待ち（結果は完了イベントで通知済み）
+	bEEPROM_asyncWait();
+	// 書き込みサイクル中は応答しないので完了を待つ
+	bEEPROM_waitReady(spStatus);
 	// 書き込み開始宣言
-	if (bI2C_startWrite(spEEPROM_status->u8DevAddress) == FALSE) {
+	if (bI2C_startWrite(spStatus->u8DevAddress) == FALSE) {
 		bI2C_stopACK();
 		return FALSE;
 	}
 	// 参照開始アドレス（上位バイト）書き込み
-	if (spEEPROM_status->b2ByteAddrFlg) {
+	if (spStatus->b2ByteAddrFlg) {
 		if (u8I2C_write((uint8)(u16Addr >> 8)) != I2CUTIL_STS_ACK) {
 			bI2C_stopACK();
 			return FALSE;
@@ -110,30 +1078,205 @@ PUBLIC bool_t bEEPROM_readData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff) {
 		return FALSE;
 	}
 	// 読み込み開始宣言
-	if(bI2C_startRead(spEEPROM_status->u8DevAddress) == FALSE) {
+	if(bI2C_startRead(spStatus->u8DevAddress) == FALSE) {
 		bI2C_stopNACK();
 		return FALSE;
 	}
-	// データの読み込み処理
-	if (bI2C_read(pu8Buff, u16Len, FALSE) == FALSE) {
-		bI2C_stopNACK();
-		return FALSE;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_readNext
+ *
+ * DESCRIPTION:連続読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8*         pu8Buff         W   読み込みバッファ
+ *   uint16         u16Len          R   読み込み長
+ *   bool_t         bLastFlg        R   最終読み込みフラグ（TRUE:読み込み後にI2C通信を完了）
+ *
+ * RETURNS:
+ *   bool_t         TRUE:読み込み成功
+ *
+ * NOTES:
+ * EEPROM_READ_CHUNK_SIZE毎に分割して読み込み、最終バイト以外はACKを返して読み込みを継続する
+ * エラー時はI2C通信を完了する
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_readNext(uint8 *pu8Buff, uint16 u16Len, bool_t bLastFlg) {
+	uint16 u16Size;
+	uint16 u16Idx = 0;
+	while (u16Idx < u16Len) {
+		u16Size = u16Len - u16Idx;
+		if (u16Size > EEPROM_READ_CHUNK_SIZE) {
+			u16Size = EEPROM_READ_CHUNK_SIZE;
+		}
+		// データの読み込み処理
+		if (bI2C_read(&pu8Buff[u16Idx], (uint8)u16Size, (u16Idx + u16Size < u16Len) || !bLastFlg) == FALSE) {
+			bI2C_stopNACK();
+			return FALSE;
+		}
+		u16Idx += u16Size;
 	}
 	// I2C通信完了
-	if (bI2C_stopNACK() == FALSE) {
+	if (bLastFlg) {
+		return bI2C_stopNACK();
+	}
+	// 読み込み継続
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8EEPROM_editAddr
+ *
+ * DESCRIPTION:メモリアドレスの編集（I2Cスケジューラ経由の送信データ）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       R   デバイスステータス情報
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint8*         pu8Buff         W   編集先（2バイト以上）
+ *
+ * RETURNS:
+ *   uint8          メモリアドレス長
+ *
+ * NOTES:
+ * 2Byteアドレスの場合は上位バイトから編集する
+ *****************************************************************************/
+PRIVATE uint8 u8EEPROM_editAddr(tsEEPROM_status *spStatus, uint16 u16Addr, uint8 *pu8Buff) {
+	if (spStatus->b2ByteAddrFlg) {
+		pu8Buff[0] = (uint8)(u16Addr >> 8);
+		pu8Buff[1] = (uint8)u16Addr;
+		return 2;
+	}
+	pu8Buff[0] = (uint8)u16Addr;
+	return 1;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROM_cacheOverlay
+ *
+ * DESCRIPTION:キャッシュラインの内容の反映（範囲指定）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       R   デバイスステータス情報
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint16         u16Len          R   データ長
+ *   uint8*         pu8Buff         RW  EEPROMから直接読み込んだデータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 書き戻し前のキャッシュラインの内容で上書きして、キャッシュ経由の読み込みと同じ内容にする
+ *****************************************************************************/
+PRIVATE void vEEPROM_cacheOverlay(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff) {
+	tsEEPROM_cacheLine* psLine;
+	uint16 u16From;
+	uint16 u16To;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < EEPROM_CACHE_LINE_CNT; u8Idx++) {
+		psLine = &sEEPROM_cacheLines[u8Idx];
+		if (psLine->spStatus != spStatus || psLine->bDirty == FALSE) {
+			continue;
+		}
+		u16From = psLine->u16PageAddr + psLine->u8DirtyFrom;
+		u16To   = psLine->u16PageAddr + psLine->u8DirtyTo;
+		if (u16From < u16Addr) {
+			u16From = u16Addr;
+		}
+		if (u16To > u16Addr + u16Len) {
+			u16To = u16Addr + u16Len;
+		}
+		if (u16From < u16To) {
+			memcpy(&pu8Buff[u16From - u16Addr], &psLine->u8Data[u16From - psLine->u16PageAddr], u16To - u16From);
+		}
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_streamHit
+ *
+ * DESCRIPTION:先読みストリームのレコードの先読み済み判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_stream  *psStream       R   先読みストリーム
+ *   uint16         u16RecIdx       R   レコードインデックス
+ *
+ * RETURNS:
+ *   bool_t         TRUE:選択中のデバイスから先読み済みで、以降に書き込みが無い
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_streamHit(tsEEPROM_stream *psStream, uint16 u16RecIdx) {
+	return (psStream->spStatus == spEEPROM_status
+		&& psStream->u32WriteGen == u32EEPROM_writeGen
+		&& u16RecIdx >= psStream->u16WinTop
+		&& u16RecIdx < psStream->u16WinTop + psStream->u16WinLen);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_streamFill
+ *
+ * DESCRIPTION:先読みストリームの一括読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_stream  *psStream       RW  先読みストリーム
+ *   uint16         u16RecIdx       R   レコードインデックス
+ *   bool_t         bForwardFlg     R   順方向探索フラグ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:読み込み成功
+ *
+ * NOTES:
+ * 対象レコードから探索方向に先読みバッファ分のレコードを１回の連続読み込みで読み込む
+ * レコード領域の端では、先読みバッファが埋まる様に逆方向に広げる
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_streamFill(tsEEPROM_stream *psStream, uint16 u16RecIdx, bool_t bForwardFlg) {
+	vEEPROM_streamInvalidate(psStream);
+	if (psStream->u16WinCnt == 0) {
 		return FALSE;
 	}
-	// 読み込み完了
+	// 読み込み範囲
+	uint16 u16WinLen = psStream->u16WinCnt;
+	if (u16WinLen > psStream->u16RecCnt) {
+		u16WinLen = psStream->u16RecCnt;
+	}
+	uint16 u16WinTop;
+	if (bForwardFlg) {
+		u16WinTop = u16RecIdx;
+		if (u16WinTop + u16WinLen > psStream->u16RecCnt) {
+			u16WinTop = psStream->u16RecCnt - u16WinLen;
+		}
+	} else {
+		u16WinTop = (u16RecIdx + 1 > u16WinLen) ? u16RecIdx + 1 - u16WinLen : 0;
+	}
+	// 連続読み込み（書き戻し前のキャッシュの内容を反映）
+	uint16 u16Addr = psStream->u16TopAddr + psStream->u16RecSize * u16WinTop;
+	uint16 u16Len  = psStream->u16RecSize * u16WinLen;
+	psStream->u32FillCnt++;
+	if (bEEPROM_readDirect(spEEPROM_status, u16Addr, u16Len, psStream->pu8Buff) == FALSE) {
+		return FALSE;
+	}
+	vEEPROM_cacheOverlay(spEEPROM_status, u16Addr, u16Len, psStream->pu8Buff);
+	psStream->spStatus    = spEEPROM_status;
+	psStream->u32WriteGen = u32EEPROM_writeGen;
+	psStream->u16WinTop   = u16WinTop;
+	psStream->u16WinLen   = u16WinLen;
 	return TRUE;
 }
 
 /*****************************************************************************
  *
- * NAME: bEEPROM_writeData
+ * NAME: bEEPROM_writeDirect
  *
- * DESCRIPTION:データ書き込み
+ * DESCRIPTION:データ書き込み（キャッシュ不使用）
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       RW  デバイスステータス情報
  *   uint16         u16Addr         R   メモリアドレス
  *   uint16         u16Len          R   書き込みデータ長
  *   uint8*         pu8Data         R   書き込みデータ
@@ -142,66 +1285,180 @@ PUBLIC bool_t bEEPROM_readData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff) {
  *   bool_t         TRUE:読み込み成功
  *
  * NOTES:
- * None.
+ * ページ境界で分割して書き込む
  *****************************************************************************/
-PUBLIC bool_t bEEPROM_writeData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Data) {
-	// 入力チェック
-	if (u16Len <= 0) return TRUE;
+PRIVATE bool_t bEEPROM_writeDirect(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, uint8 *pu8Data) {
+	// 非同期書き込みの完了待ち（結果は完了イベントで通知済み）
+	bEEPROM_asyncWait();
 	// 書き込みループ
-	uint16 u16End;
+	uint16 u16Size;
 	uint16 u16Idx = 0;
 	while (u16Idx < u16Len)  {
-		// 書き込み間隔制御
-		u32TimerUtil_waitUntil(spEEPROM_status->u64LastWrite + EEPROM_WRITE_CYCLE);
+		// 書き込み完了待ち
+		bEEPROM_waitReady(spStatus);
+		// 書き込みサイズの判定（ページ境界を越えない）
+		u16Size = spStatus->u8PageSize - ((u16Addr + u16Idx) % spStatus->u8PageSize);
+		if (u16Size > u16Len - u16Idx) {
+			u16Size = u16Len - u16Idx;
+		}
+		// ページ書き込み
+		if (bEEPROM_writePage(spStatus, u16Addr + u16Idx, u16Size, pu8Data + u16Idx) == FALSE) {
+			return FALSE;
+		}
+		// インデックスの移動
+		u16Idx += u16Size;
+	}
+	// 書き込み完了
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_writePage
+ *
+ * DESCRIPTION:ページ書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       RW  デバイスステータス情報
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint16         u16Len          R   書き込みデータ長（ページ境界を越えない事）
+ *   uint8*         pu8Data         R   書き込みデータ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き込み成功
+ *
+ * NOTES:
+ * 書き込みサイクルの完了は待たない
+ * I2Cスケジューラ経由の場合は、スケジューラに登録したデバイスのアドレスで通信する
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_writePage(tsEEPROM_status *spStatus, uint16 u16Addr, uint16 u16Len, const uint8 *pu8Data) {
+	if (u8EEPROM_schedDevIdx != I2C_SCHED_DEVICE_NONE) {
+		// I2Cスケジューラ経由の場合は、アドレスとデータを１回の要求で送信
+		if (u16Len > EEPROM_PAGE_SIZE_128B) {
+			return FALSE;
+		}
+		uint8 u8Trns[2 + EEPROM_PAGE_SIZE_128B];
+		uint8 u8AddrLen = u8EEPROM_editAddr(spStatus, u16Addr, u8Trns);
+		memcpy(&u8Trns[u8AddrLen], pu8Data, u16Len);
+		tsI2CSched_Req sReq;
+		vI2CSched_editReq(&sReq, u8Trns, u8AddrLen + u16Len, NULL, 0, 0);
+		if (u8I2CSched_exec(u8EEPROM_schedDevIdx, &sReq) != I2CUTIL_STS_ACK) {
+			return FALSE;
+		}
+	} else {
 		// 書き込み開始宣言
-		if (bI2C_startWrite(spEEPROM_status->u8DevAddress) == FALSE) {
+		if (bI2C_startWrite(spStatus->u8DevAddress) == FALSE) {
 			bI2C_stopACK();
 			return FALSE;
 		}
 		// 参照開始アドレス（上位バイト）書き込み
-		if (spEEPROM_status->b2ByteAddrFlg) {
-			if (u8I2C_write((uint8)((u16Addr + u16Idx) >> 8)) != I2CUTIL_STS_ACK) {
+		if (spStatus->b2ByteAddrFlg) {
+			if (u8I2C_write((uint8)(u16Addr >> 8)) != I2CUTIL_STS_ACK) {
 				bI2C_stopACK();
 				return FALSE;
 			}
 		}
 		// 参照開始アドレス（下位バイト）書き込み
-		if (u8I2C_write((uint8)(u16Addr + u16Idx)) != I2CUTIL_STS_ACK) {
+		if (u8I2C_write((uint8)u16Addr) != I2CUTIL_STS_ACK) {
 			bI2C_stopACK();
 			return FALSE;
 		}
-		// 書き込みサイズの判定
-		if ((u16Len - u16Idx) >= spEEPROM_status->u8PageSize) {
-			u16End = u16Idx + spEEPROM_status->u8PageSize - 1;
-		} else {
-			u16End = u16Len - 1;
-		}
 		// 書き込みデータの送信
-		while (u16Idx < u16End) {
-			if (u8I2C_write(*(pu8Data + u16Idx)) != I2CUTIL_STS_ACK) {
+		uint16 u16Idx;
+		for (u16Idx = 0; u16Idx < u16Len - 1; u16Idx++) {
+			if (u8I2C_write(pu8Data[u16Idx]) != I2CUTIL_STS_ACK) {
 				bI2C_stopACK();
 				return FALSE;
 			}
-			// インデックスの移動
-			u16Idx++;
 		}
 		// 終端データの送信
-		if (u8I2C_writeStop(*(pu8Data + u16Idx)) != I2CUTIL_STS_ACK) {
+		if (u8I2C_writeStop(pu8Data[u16Idx]) != I2CUTIL_STS_ACK) {
 			bI2C_stopACK();
 			return FALSE;
 		}
-		// インデックスの移動
-		u16Idx++;
-		// 最終書き込み時刻更新
-		spEEPROM_status->u64LastWrite = u64TimerUtil_readUsec();
 	}
-	// 書き込み完了
+	// 最終書き込み時刻更新
+	spStatus->u64LastWrite = u64TimerUtil_readUsec();
+	sEEPROM_writeStats.u32PageCnt++;
+	sEEPROM_writeStats.u32ByteCnt += u16Len;
 	return TRUE;
 }
 
-/****************************************************************************/
-/***        Local Functions                                               ***/
-/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_pollAck
+ *
+ * DESCRIPTION:書き込みサイクルの完了判定（ACKポーリング）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       RW  デバイスステータス情報
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き込みサイクル完了
+ *
+ * NOTES:
+ * 書き込みサイクル中のデバイスはアドレスに応答しない
+ * 書き込みサイクルの上限時間を経過している場合は、ポーリングせずに完了とする
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_pollAck(tsEEPROM_status *spStatus) {
+	// 書き込みサイクルの経過判定
+	uint64 u64Now = u64TimerUtil_readUsec();
+	if (u64Now >= spStatus->u64LastWrite + EEPROM_WRITE_CYCLE) {
+		return TRUE;
+	}
+	// アドレスの応答判定（アドレスに対するNACKは後続の書き込みの結果で判定）
+	sEEPROM_writeStats.u32PollCnt++;
+	bool_t bResult;
+	if (u8EEPROM_schedDevIdx != I2C_SCHED_DEVICE_NONE) {
+		// I2Cスケジューラ経由の場合も直接通信と同じ内容を送信（応答無しはスケジューラのエラー件数に計上）
+		uint8 u8Poll = 0x00;
+		tsI2CSched_Req sReq;
+		vI2CSched_editReq(&sReq, &u8Poll, 1, NULL, 0, 0);
+		bResult = (u8I2CSched_exec(u8EEPROM_schedDevIdx, &sReq) == I2CUTIL_STS_ACK);
+	} else {
+		bResult = (bI2C_startWrite(spStatus->u8DevAddress)
+			&& u8I2C_write(0x00) == I2CUTIL_STS_ACK);
+		bI2C_stopACK();
+	}
+	if (bResult == FALSE) {
+		return FALSE;
+	}
+	// 書き込みサイクル時間の集計
+	uint32 u32Cycle = (uint32)(u64Now - spStatus->u64LastWrite);
+	sEEPROM_writeStats.u32CycleCnt++;
+	sEEPROM_writeStats.u32CycleUsec += u32Cycle;
+	if (u32Cycle > sEEPROM_writeStats.u32MaxCycleUsec) {
+		sEEPROM_writeStats.u32MaxCycleUsec = u32Cycle;
+	}
+	sEEPROM_writeStats.u32ReclaimUsec += EEPROM_WRITE_CYCLE - u32Cycle;
+	// 書き込みサイクル完了
+	spStatus->u64LastWrite = 0;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROM_waitReady
+ *
+ * DESCRIPTION:書き込みサイクルの完了待ち
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsEEPROM_status  *spStatus       RW  デバイスステータス情報
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き込みサイクル完了
+ *
+ * NOTES:
+ * EEPROM_POLL_INTERVAL間隔でACKポーリングし、最長でEEPROM_WRITE_CYCLE待つ
+ *****************************************************************************/
+PRIVATE bool_t bEEPROM_waitReady(tsEEPROM_status *spStatus) {
+	uint64 u64Start = u64TimerUtil_readUsec();
+	while (bEEPROM_pollAck(spStatus) == FALSE) {
+		u32TimerUtil_waitUntil(u64TimerUtil_readUsec() + EEPROM_POLL_INTERVAL);
+	}
+	sEEPROM_writeStats.u32WaitUsec += (uint32)(u64TimerUtil_readUsec() - u64Start);
+	return TRUE;
+}
 
 /****************************************************************************/
 /***        END OF FILE                                                   ***/
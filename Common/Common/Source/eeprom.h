@@ -8,6 +8,10 @@
  * DESCRIPTION:Microchip EEPROM driver
  *
  * CHANGE HISTORY:
+ * 2026/10/18 23:00:00 ページ単位の書き戻しキャッシュを追加
+ * 2026/10/19 00:00:00 ACKポーリングによる書き込み完了判定と非同期書き込みを追加
+ * 2026/10/19 05:00:00 連続読み込みによるページの先読みと、固定長レコードの先読みストリームを追加
+ * 2026/10/19 17:00:00 I2Cスケジューラのデバイスの設定を追加
  *
  * LAST MODIFIED BY:
  *
@@ -27,6 +31,7 @@ extern "C" {
 /***        Include files                                                 ***/
 /****************************************************************************/
 #include <jendefs.h>
+#include "framework.h"
 
 /****************************************************************************/
 /***        Macro Definitions                                             ***/
@@ -54,6 +59,21 @@ extern "C" {
 
 // EEPROM Address Size
 #define EEPROM_WRITE_CYCLE     (5000)
+// EEPROM ACK Polling Interval
+#define EEPROM_POLL_INTERVAL   (200)
+// EEPROM Async Write Buffer Size
+#ifndef EEPROM_ASYNC_BUFF_SIZE
+	#define EEPROM_ASYNC_BUFF_SIZE (128)
+#endif
+
+// EEPROM Cache Line Size（ページサイズの最大値）
+#ifndef EEPROM_CACHE_LINE_SIZE
+	#define EEPROM_CACHE_LINE_SIZE (EEPROM_PAGE_SIZE_64B)
+#endif
+// EEPROM Cache Line Count
+#ifndef EEPROM_CACHE_LINE_CNT
+	#define EEPROM_CACHE_LINE_CNT  (4)
+#endif
 
 /****************************************************************************/
 /***        Type Definitions                                              ***/
@@ -66,8 +86,66 @@ typedef struct {
 	bool_t b2ByteAddrFlg;	// 2Byteアドレスフラグ
 	uint8 u8PageSize;		// ページサイズ
 	uint64 u64LastWrite;	// 最終書き込み時刻
+	bool_t bCacheFlg;		// ページキャッシュ使用フラグ
 } tsEEPROM_status;
 
+/**
+ * EEPROMのページキャッシュの統計情報
+ */
+typedef struct {
+	uint32 u32ReadCnt;		// 読み込みページ数
+	uint32 u32ReadHitCnt;	// 読み込みページ数（キャッシュヒット）
+	uint32 u32WriteCnt;		// 書き込みページ数
+	uint32 u32WriteHitCnt;	// 書き込みページ数（キャッシュヒット）
+	uint32 u32FillCnt;		// EEPROMからのページ読み込み回数
+	uint32 u32FlushCnt;		// EEPROMへのページ書き込み回数
+} tsEEPROM_cacheStats;
+
+/**
+ * EEPROMの非同期書き込みの状態
+ */
+typedef enum {
+	E_EEPROM_ASYNC_IDLE = 0,	// 要求無し（完了）
+	E_EEPROM_ASYNC_WRITE,		// ページ書き込み待ち
+	E_EEPROM_ASYNC_POLL,		// 書き込みサイクル完了待ち
+	E_EEPROM_ASYNC_ERROR		// エラー終了
+} teEEPROM_asyncStatus;
+
+/**
+ * EEPROMの書き込みの統計情報
+ */
+typedef struct {
+	uint32 u32PageCnt;		// ページ書き込み回数
+	uint32 u32ByteCnt;		// 書き込みバイト数
+	uint32 u32PollCnt;		// ACKポーリング回数
+	uint32 u32CycleCnt;		// ACKポーリングで完了を検知した回数
+	uint32 u32CycleUsec;	// 検知した書き込みサイクル時間の合計
+	uint32 u32MaxCycleUsec;	// 検知した書き込みサイクル時間の最大値
+	uint32 u32ReclaimUsec;	// 固定待ち時間（EEPROM_WRITE_CYCLE）に対する短縮時間の合計
+	uint32 u32WaitUsec;		// 同期処理で完了を待った時間の合計
+	uint32 u32ErrCnt;		// 非同期書き込みのエラー回数
+} tsEEPROM_writeStats;
+
+/**
+ * EEPROMの先読みストリーム（連続する固定長レコードの一括読み込み）
+ */
+typedef struct {
+	tsEEPROM_status *spStatus;	// 先読み済みのデバイス（NULL：無効）
+	uint32 u32WriteGen;		// 先読み時の書き込み世代
+	uint16 u16TopAddr;		// レコード領域の先頭アドレス
+	uint16 u16RecSize;		// レコードサイズ
+	uint16 u16RecCnt;		// レコード数
+	uint8 *pu8Buff;			// 先読みバッファ（呼び出し元で確保）
+	uint16 u16WinCnt;		// 先読みバッファのレコード数
+	uint16 u16WinTop;		// 先読み済みの先頭レコード
+	uint16 u16WinLen;		// 先読み済みのレコード数
+	uint32 u32ReadCnt;		// 読み込みレコード数
+	uint32 u32HitCnt;		// 読み込みレコード数（先読み済み）
+	uint32 u32FillCnt;		// EEPROMからの一括読み込み回数
+	uint32 u32LastUsec;		// 直近の読み込み時間
+	uint32 u32MaxUsec;		// 読み込み時間の最大値
+} tsEEPROM_stream;
+
 /****************************************************************************/
 /***        Local Function Prototypes                                     ***/
 /****************************************************************************/
@@ -85,10 +163,44 @@ typedef struct {
 /****************************************************************************/
 /** デバイス選択 */
 PUBLIC bool_t bEEPROM_deviceSelect(tsEEPROM_status *spStatus);
+/** I2Cスケジューラのデバイスの設定 */
+PUBLIC void vEEPROM_setSchedDevice(uint8 u8DevIdx);
 /** データ読み込み */
 PUBLIC bool_t bEEPROM_readData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Buff);
 /** データ書き込み */
 PUBLIC bool_t bEEPROM_writeData(uint16 u16Addr, uint16 u16Len, uint8 *pu8Data);
+/** キャッシュの書き戻し */
+PUBLIC bool_t bEEPROM_commit();
+/** キャッシュの書き戻し（書き込み待ちが不要な場合のみ） */
+PUBLIC bool_t bEEPROM_flushIdle();
+/** キャッシュの破棄 */
+PUBLIC void vEEPROM_cacheInvalidate();
+/** キャッシュの統計情報の参照 */
+PUBLIC const tsEEPROM_cacheStats* psEEPROM_getCacheStats();
+/** キャッシュの統計情報の初期化 */
+PUBLIC void vEEPROM_resetCacheStats();
+/** 非同期データ書き込み */
+PUBLIC bool_t bEEPROM_writeAsync(uint16 u16Addr, uint16 u16Len, const uint8 *pu8Data, teFwkEvent eCompEvt);
+/** 非同期書き込みの進行 */
+PUBLIC teEEPROM_asyncStatus eEEPROM_asyncProceed();
+/** 非同期書き込みの実行中判定 */
+PUBLIC bool_t bEEPROM_asyncIsBusy();
+/** 非同期書き込みの完了待ち */
+PUBLIC bool_t bEEPROM_asyncWait();
+/** 書き込みの統計情報の参照 */
+PUBLIC const tsEEPROM_writeStats* psEEPROM_getWriteStats();
+/** 書き込みの統計情報の初期化 */
+PUBLIC void vEEPROM_resetWriteStats();
+/** ページの先読み */
+PUBLIC bool_t bEEPROM_prefetch(uint16 u16Addr, uint16 u16Len);
+/** 先読みストリームの初期化 */
+PUBLIC void vEEPROM_streamInit(tsEEPROM_stream *psStream, uint16 u16TopAddr, uint16 u16RecSize, uint16 u16RecCnt, uint8 *pu8Buff, uint16 u16BuffSize);
+/** 先読みストリームからのレコード読み込み */
+PUBLIC bool_t bEEPROM_streamRead(tsEEPROM_stream *psStream, uint16 u16RecIdx, bool_t bForwardFlg, uint8 *pu8Rec);
+/** 先読みストリームの先読み */
+PUBLIC bool_t bEEPROM_streamPrefetch(tsEEPROM_stream *psStream, uint16 u16RecIdx, bool_t bForwardFlg);
+/** 先読みストリームの破棄 */
+PUBLIC void vEEPROM_streamInvalidate(tsEEPROM_stream *psStream);
 
 /****************************************************************************/
 /***        Local Functions                                               ***/
@@ -0,0 +1,510 @@
+/****************************************************************************
+ *
+ * MODULE :EEPROM Simulator functions source file
+ *
+ * CREATED:2026/10/19 07:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境でeeprom.cとアプリケーションの保存処理を評価する為の
+ *   24AAxxシリーズEEPROMのシミュレータ（i2c_replayのデバイスモデル）
+ *   EEPROM Simulator functions (source file)
+ *   ・メモリはmmapしたバッキングファイルに保持し、実行を跨いで内容と
+ *     セル毎の書き換え回数を引き継ぐ（ファイルはメモリの後ろに書き換え回数を持つ）
+ *   ・書き込みはページバッファに取り込み、停止条件で書き込みサイクルを開始する
+ *     （ページ境界を越える書き込みはページ先頭に折り返して上書きする）
+ *   ・書き込みサイクル中はアドレスにNACK応答する（時刻はi2c_replayの仮想時刻）
+ *   ・書き込みサイクル毎に、取り込んだセルの書き換え回数を加算し、
+ *     論理操作（ログ追記、リモートデバイス更新等）毎の書き込み量と
+ *     最も書き換えたセルからの寿命の予測値を算出出来る
+ *   ・ホスト環境専用（POSIXのファイルとmmapを使用する）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <jendefs.h>
+
+#include "i2c_util.h"
+#include "i2c_replay.h"
+#include "eeprom_sim.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// １日の秒数
+#define EEPROM_SIM_DAY_SEC         (86400)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 開始条件
+PRIVATE bool_t bEEPROMSim_start(void* pvContext, bool_t bReadFlg);
+// 1バイト書き込み
+PRIVATE uint8 u8EEPROMSim_write(void* pvContext, uint8 u8Data);
+// 1バイト読み込み
+PRIVATE uint8 u8EEPROMSim_read(void* pvContext);
+// 停止条件
+PRIVATE void vEEPROMSim_stop(void* pvContext);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// i2c_replayへの応答関数
+PRIVATE const tsI2CReplay_DevIF sEEPROMSim_devIF = {
+	bEEPROMSim_start,
+	u8EEPROMSim_write,
+	u8EEPROMSim_read,
+	vEEPROMSim_stop
+};
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: bEEPROMSim_open
+ *
+ * DESCRIPTION:バッキングファイルを開いてi2c_replayに登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           W   シミュレータ
+ *   char*          pcPath          R   バッキングファイルのパス
+ *   uint8          u8Address       R   I2Cアドレス
+ *   uint32         u32MemSize      R   メモリサイズ
+ *   uint16         u16PageSize     R   ページサイズ（２のべき乗）
+ *   uint8          u8AddrLen       R   メモリアドレス長（1 or 2）
+ *
+ * RETURNS:
+ *   TRUE:登録した
+ *
+ * NOTES:
+ * ファイルが無い場合、もしくはサイズが異なる場合は作成し直して消去状態（0xFF）にする
+ * vI2CReplay_initはデバイスモデルを初期化するので、初期化後に呼び出す事
+ * 書き込みサイクル時間と書き換え回数の保証値は既定値で初期化するので、
+ * 必要に応じて呼び出し後に変更する
+ *****************************************************************************/
+PUBLIC bool_t bEEPROMSim_open(tsEEPROMSim* psSim, const char* pcPath, uint8 u8Address,
+							  uint32 u32MemSize, uint16 u16PageSize, uint8 u8AddrLen) {
+	// 構成のチェック
+	if (u8AddrLen < 1 || u8AddrLen > 2 || u32MemSize == 0 || u32MemSize > EEPROM_SIM_MEM_MAX) {
+		return FALSE;
+	}
+	if (u8AddrLen == 1 && u32MemSize > 0x100) {
+		return FALSE;
+	}
+	if (u16PageSize == 0 || u16PageSize > EEPROM_SIM_PAGE_MAX
+			|| (u16PageSize & (u16PageSize - 1)) != 0 || (u32MemSize % u16PageSize) != 0) {
+		return FALSE;
+	}
+	memset(psSim, 0x00, sizeof(tsEEPROMSim));
+	psSim->u8Address    = u8Address;
+	psSim->u8AddrLen    = u8AddrLen;
+	psSim->u16PageSize  = u16PageSize;
+	psSim->u32MemSize   = u32MemSize;
+	psSim->u32CycleUsec = EEPROM_SIM_CYCLE_USEC;
+	psSim->u32Endurance = EEPROM_SIM_ENDURANCE;
+	psSim->u32MapSize   = u32MemSize + u32MemSize * sizeof(uint32);
+	// バッキングファイルのオープン
+	psSim->iFd = open(pcPath, O_RDWR | O_CREAT, 0644);
+	if (psSim->iFd < 0) {
+		return FALSE;
+	}
+	struct stat sStat;
+	bool_t bNewFlg = FALSE;
+	if (fstat(psSim->iFd, &sStat) != 0) {
+		close(psSim->iFd);
+		return FALSE;
+	}
+	if (sStat.st_size != (off_t)psSim->u32MapSize) {
+		if (ftruncate(psSim->iFd, 0) != 0 || ftruncate(psSim->iFd, psSim->u32MapSize) != 0) {
+			close(psSim->iFd);
+			return FALSE;
+		}
+		bNewFlg = TRUE;
+	}
+	// マッピング
+	void* pvMap = mmap(NULL, psSim->u32MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, psSim->iFd, 0);
+	if (pvMap == MAP_FAILED) {
+		close(psSim->iFd);
+		return FALSE;
+	}
+	psSim->pu8Mem   = (uint8*)pvMap;
+	psSim->pu32Wear = (uint32*)(psSim->pu8Mem + u32MemSize);
+	if (bNewFlg) {
+		vEEPROMSim_erase(psSim, TRUE);
+	}
+	// デバイスモデルの登録
+	if (bI2CReplay_registDevModel(u8Address, &sEEPROMSim_devIF, psSim) == FALSE) {
+		vEEPROMSim_close(psSim);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROMSim_sync
+ *
+ * DESCRIPTION:バッキングファイルへの同期
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           R   シミュレータ
+ *
+ * RETURNS:
+ *   TRUE:同期した
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bEEPROMSim_sync(tsEEPROMSim* psSim) {
+	if (psSim->pu8Mem == NULL) {
+		return FALSE;
+	}
+	return (msync(psSim->pu8Mem, psSim->u32MapSize, MS_SYNC) == 0);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMSim_close
+ *
+ * DESCRIPTION:バッキングファイルを閉じる
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           RW  シミュレータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * i2c_replayへの登録は解除しないので、閉じた後はvI2CReplay_initで初期化する事
+ *****************************************************************************/
+PUBLIC void vEEPROMSim_close(tsEEPROMSim* psSim) {
+	if (psSim->pu8Mem != NULL) {
+		bEEPROMSim_sync(psSim);
+		munmap(psSim->pu8Mem, psSim->u32MapSize);
+		psSim->pu8Mem   = NULL;
+		psSim->pu32Wear = NULL;
+	}
+	if (psSim->iFd >= 0) {
+		close(psSim->iFd);
+		psSim->iFd = -1;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMSim_erase
+ *
+ * DESCRIPTION:メモリの消去（0xFF）と書き換え回数のクリア
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           RW  シミュレータ
+ *   bool_t         bWearFlg        R   TRUE:書き換え回数もクリアする
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 消去は書き込みサイクルとして扱わない（出荷状態への初期化）
+ *****************************************************************************/
+PUBLIC void vEEPROMSim_erase(tsEEPROMSim* psSim, bool_t bWearFlg) {
+	memset(psSim->pu8Mem, 0xFF, psSim->u32MemSize);
+	if (bWearFlg) {
+		memset(psSim->pu32Wear, 0x00, psSim->u32MemSize * sizeof(uint32));
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMSim_clearStats
+ *
+ * DESCRIPTION:統計情報のクリア
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           RW  シミュレータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vEEPROMSim_clearStats(tsEEPROMSim* psSim) {
+	memset(&psSim->sStats, 0x00, sizeof(tsEEPROMSim_stats));
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMSim_beginOp
+ *
+ * DESCRIPTION:論理操作の開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           R   シミュレータ
+ *   tsEEPROMSim_op* psOp           RW  論理操作の集計
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 集計は呼び出し元でゼロクリアしておき、操作毎に開始と終了を呼び出して累積する
+ *****************************************************************************/
+PUBLIC void vEEPROMSim_beginOp(tsEEPROMSim* psSim, tsEEPROMSim_op* psOp) {
+	psOp->sBegin = psSim->sStats;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMSim_endOp
+ *
+ * DESCRIPTION:論理操作の終了（書き込み量の集計）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           R   シミュレータ
+ *   tsEEPROMSim_op* psOp           RW  論理操作の集計
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ページキャッシュや非同期書き込みを使用している場合は、
+ * 書き戻しと完了待ちの後に呼び出す事
+ *****************************************************************************/
+PUBLIC void vEEPROMSim_endOp(tsEEPROMSim* psSim, tsEEPROMSim_op* psOp) {
+	uint32 u32ByteCnt = psSim->sStats.u32ByteCnt - psOp->sBegin.u32ByteCnt;
+	psOp->u32OpCnt++;
+	psOp->u32CycleCnt += psSim->sStats.u32CycleCnt - psOp->sBegin.u32CycleCnt;
+	psOp->u32ByteCnt  += u32ByteCnt;
+	if (u32ByteCnt > psOp->u32MaxByteCnt) {
+		psOp->u32MaxByteCnt = u32ByteCnt;
+	}
+	psOp->sBegin = psSim->sStats;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32EEPROMSim_maxWear
+ *
+ * DESCRIPTION:最大の書き換え回数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           R   シミュレータ
+ *   uint16*        pu16Addr        W   最大のセルのアドレス（NULL可）
+ *
+ * RETURNS:
+ *   uint32         最も書き換えたセルの書き換え回数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint32 u32EEPROMSim_maxWear(tsEEPROMSim* psSim, uint16* pu16Addr) {
+	uint32 u32Max = 0;
+	uint32 u32MaxAddr = 0;
+	uint32 u32Addr;
+	for (u32Addr = 0; u32Addr < psSim->u32MemSize; u32Addr++) {
+		if (psSim->pu32Wear[u32Addr] > u32Max) {
+			u32Max = psSim->pu32Wear[u32Addr];
+			u32MaxAddr = u32Addr;
+		}
+	}
+	if (pu16Addr != NULL) {
+		*pu16Addr = (uint16)u32MaxAddr;
+	}
+	return u32Max;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32EEPROMSim_projectLife
+ *
+ * DESCRIPTION:寿命の予測（日数）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsEEPROMSim*   psSim           R   シミュレータ
+ *   uint32         u32Sec          R   評価で模擬した運用期間（秒）
+ *   uint32         u32BaseWear     R   評価開始時の最大の書き換え回数
+ *
+ * RETURNS:
+ *   uint32         最も書き換えたセルが保証値に達するまでの日数
+ *                  （EEPROM_SIM_LIFE_INFINITE：評価中の書き込み無し）
+ *
+ * NOTES:
+ * 運用時の書き込み頻度で論理操作を実行した後に呼び出し、評価中の最大の書き換え回数の
+ * 増分を書き込み速度として、現在の書き換え回数から保証値までの残りの日数を算出する
+ *****************************************************************************/
+PUBLIC uint32 u32EEPROMSim_projectLife(tsEEPROMSim* psSim, uint32 u32Sec, uint32 u32BaseWear) {
+	uint32 u32MaxWear = u32EEPROMSim_maxWear(psSim, NULL);
+	if (u32MaxWear <= u32BaseWear) {
+		return EEPROM_SIM_LIFE_INFINITE;
+	}
+	if (u32MaxWear >= psSim->u32Endurance) {
+		return 0;
+	}
+	uint64 u64Days = (uint64)(psSim->u32Endurance - u32MaxWear) * u32Sec
+		/ (u32MaxWear - u32BaseWear) / EEPROM_SIM_DAY_SEC;
+	if (u64Days >= EEPROM_SIM_LIFE_INFINITE) {
+		return EEPROM_SIM_LIFE_INFINITE - 1;
+	}
+	return (uint32)u64Days;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROMSim_start
+ *
+ * DESCRIPTION:開始条件
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       RW  シミュレータ
+ *   bool_t         bReadFlg        R   TRUE:読み込み
+ *
+ * RETURNS:
+ *   TRUE:アドレスにACK応答
+ *
+ * NOTES:
+ * 書き込みサイクル中はNACK応答する
+ * 書き込みの開始条件でページバッファを破棄し、読み込み（リピートスタート）では
+ * アドレスカウンタを引き継ぐ
+ *****************************************************************************/
+PRIVATE bool_t bEEPROMSim_start(void* pvContext, bool_t bReadFlg) {
+	tsEEPROMSim* psSim = (tsEEPROMSim*)pvContext;
+	if (u64I2CReplay_readUsec() < psSim->u64BusyEnd) {
+		psSim->sStats.u32BusyNackCnt++;
+		return FALSE;
+	}
+	if (bReadFlg == FALSE) {
+		psSim->u8AddrCnt  = 0;
+		psSim->u8LatchCnt = 0;
+		memset(psSim->u8Latch, 0x00, sizeof(psSim->u8Latch));
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8EEPROMSim_write
+ *
+ * DESCRIPTION:1バイト書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       RW  シミュレータ
+ *   uint8          u8Data          R   書き込みデータ
+ *
+ * RETURNS:
+ *   I2CUTIL_STS_ACK:ACK応答
+ *
+ * NOTES:
+ * メモリアドレスの受信後はページバッファに取り込み、
+ * アドレスカウンタはページ内で折り返す
+ *****************************************************************************/
+PRIVATE uint8 u8EEPROMSim_write(void* pvContext, uint8 u8Data) {
+	tsEEPROMSim* psSim = (tsEEPROMSim*)pvContext;
+	// メモリアドレス
+	if (psSim->u8AddrCnt < psSim->u8AddrLen) {
+		psSim->u16Ptr = (psSim->u8AddrCnt == 0) ? u8Data : ((psSim->u16Ptr << 8) | u8Data);
+		psSim->u8AddrCnt++;
+		if (psSim->u8AddrCnt == psSim->u8AddrLen) {
+			psSim->u16Ptr     = (uint16)(psSim->u16Ptr % psSim->u32MemSize);
+			psSim->u16PageTop = psSim->u16Ptr & ~(psSim->u16PageSize - 1);
+		}
+		return I2CUTIL_STS_ACK;
+	}
+	// ページバッファへの取り込み
+	uint8 u8Offset = (uint8)(psSim->u16Ptr - psSim->u16PageTop);
+	uint8 u8Bit = (uint8)(0x01 << (u8Offset & 0x07));
+	if ((psSim->u8Latch[u8Offset >> 3] & u8Bit) != 0) {
+		psSim->sStats.u32WrapCnt++;
+	} else {
+		psSim->u8Latch[u8Offset >> 3] |= u8Bit;
+		psSim->u8LatchCnt++;
+	}
+	psSim->u8Page[u8Offset] = u8Data;
+	psSim->u16Ptr = psSim->u16PageTop + ((u8Offset + 1) & (psSim->u16PageSize - 1));
+	return I2CUTIL_STS_ACK;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8EEPROMSim_read
+ *
+ * DESCRIPTION:1バイト読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       RW  シミュレータ
+ *
+ * RETURNS:
+ *   uint8          読み込みデータ
+ *
+ * NOTES:
+ * アドレスカウンタはメモリ全体で折り返す
+ *****************************************************************************/
+PRIVATE uint8 u8EEPROMSim_read(void* pvContext) {
+	tsEEPROMSim* psSim = (tsEEPROMSim*)pvContext;
+	uint8 u8Data = psSim->pu8Mem[psSim->u16Ptr];
+	psSim->u16Ptr = (uint16)((psSim->u16Ptr + 1) % psSim->u32MemSize);
+	psSim->sStats.u32ReadCnt++;
+	return u8Data;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMSim_stop
+ *
+ * DESCRIPTION:停止条件
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvContext       RW  シミュレータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ページバッファに取り込んだデータがある場合は書き込みサイクルを開始し、
+ * 取り込んだセルのみを書き換えて書き換え回数を加算する
+ * （ACKポーリング等のアドレスのみの書き込みでは書き込みサイクルを開始しない）
+ *****************************************************************************/
+PRIVATE void vEEPROMSim_stop(void* pvContext) {
+	tsEEPROMSim* psSim = (tsEEPROMSim*)pvContext;
+	if (psSim->u8LatchCnt == 0) {
+		return;
+	}
+	uint16 u16Offset;
+	for (u16Offset = 0; u16Offset < psSim->u16PageSize; u16Offset++) {
+		if ((psSim->u8Latch[u16Offset >> 3] & (0x01 << (u16Offset & 0x07))) == 0) {
+			continue;
+		}
+		psSim->pu8Mem[psSim->u16PageTop + u16Offset] = psSim->u8Page[u16Offset];
+		if (psSim->pu32Wear[psSim->u16PageTop + u16Offset] < 0xFFFFFFFF) {
+			psSim->pu32Wear[psSim->u16PageTop + u16Offset]++;
+		}
+	}
+	psSim->sStats.u32CycleCnt++;
+	psSim->sStats.u32ByteCnt += psSim->u8LatchCnt;
+	psSim->u8LatchCnt = 0;
+	memset(psSim->u8Latch, 0x00, sizeof(psSim->u8Latch));
+	psSim->u64BusyEnd = u64I2CReplay_readUsec() + psSim->u32CycleUsec;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,145 @@
+/****************************************************************************
+ *
+ * MODULE :EEPROM Simulator functions header file
+ *
+ * CREATED:2026/10/19 07:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境でeeprom.cとアプリケーションの保存処理を評価する為の
+ *   24AAxxシリーズEEPROMのシミュレータ（i2c_replayのデバイスモデル）
+ *   EEPROM Simulator functions (header file)
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  EEPROMSIM_H_INCLUDED
+#define  EEPROMSIM_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+#include "i2c_replay.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 最大メモリサイズ（2バイトアドレスの範囲）
+#define EEPROM_SIM_MEM_MAX         (0x10000)
+// 最大ページサイズ
+#define EEPROM_SIM_PAGE_MAX        (128)
+// 書き込みサイクル時間の既定値（24AAxxの最大値、マイクロ秒）
+#define EEPROM_SIM_CYCLE_USEC      (5000)
+// 書き換え回数の既定値（24AAxxの保証値）
+#define EEPROM_SIM_ENDURANCE       (1000000)
+// 寿命の予測値：書き込み無し
+#define EEPROM_SIM_LIFE_INFINITE   (0xFFFFFFFF)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+/**
+ * シミュレータの統計情報
+ */
+typedef struct {
+	uint32 u32CycleCnt;		// 書き込みサイクル回数
+	uint32 u32ByteCnt;		// 書き込みバイト数（書き込みサイクルで書き換えたセル数）
+	uint32 u32ReadCnt;		// 読み込みバイト数
+	uint32 u32BusyNackCnt;	// 書き込みサイクル中のアドレスに対するNACK回数
+	uint32 u32WrapCnt;		// ページ内の折り返しで上書きされたバイト数
+} tsEEPROMSim_stats;
+
+/**
+ * 論理操作毎の書き込み量の集計
+ */
+typedef struct {
+	uint32 u32OpCnt;		// 操作回数
+	uint32 u32CycleCnt;		// 書き込みサイクル回数の合計
+	uint32 u32ByteCnt;		// 書き込みバイト数の合計
+	uint32 u32MaxByteCnt;	// １操作の書き込みバイト数の最大値
+	tsEEPROMSim_stats sBegin;	// 操作開始時の統計情報
+} tsEEPROMSim_op;
+
+/**
+ * シミュレータ
+ */
+typedef struct {
+	uint8 u8Address;		// I2Cアドレス
+	uint8 u8AddrLen;		// メモリアドレス長（1 or 2）
+	uint16 u16PageSize;		// ページサイズ
+	uint32 u32MemSize;		// メモリサイズ
+	uint32 u32CycleUsec;	// 書き込みサイクル時間
+	uint32 u32Endurance;	// 書き換え回数の保証値
+	int iFd;				// バッキングファイル
+	uint32 u32MapSize;		// マッピングサイズ
+	uint8* pu8Mem;			// メモリ（ファイルの先頭）
+	uint32* pu32Wear;		// セル毎の書き換え回数（メモリの後ろ）
+	uint8 u8AddrCnt;		// 受信済みのメモリアドレスのバイト数
+	uint16 u16Ptr;			// アドレスカウンタ
+	uint16 u16PageTop;		// ページバッファのページ先頭アドレス
+	uint8 u8Page[EEPROM_SIM_PAGE_MAX];			// ページバッファ
+	uint8 u8Latch[EEPROM_SIM_PAGE_MAX / 8];		// ページバッファの書き込み済みビットマップ
+	uint8 u8LatchCnt;		// ページバッファの書き込み済みバイト数
+	uint64 u64BusyEnd;		// 書き込みサイクルの終了時刻（仮想時刻）
+	tsEEPROMSim_stats sStats;	// 統計情報
+} tsEEPROMSim;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/** バッキングファイルを開いてi2c_replayに登録 */
+PUBLIC bool_t bEEPROMSim_open(tsEEPROMSim* psSim, const char* pcPath, uint8 u8Address,
+							  uint32 u32MemSize, uint16 u16PageSize, uint8 u8AddrLen);
+/** バッキングファイルへの同期 */
+PUBLIC bool_t bEEPROMSim_sync(tsEEPROMSim* psSim);
+/** バッキングファイルを閉じる */
+PUBLIC void vEEPROMSim_close(tsEEPROMSim* psSim);
+/** メモリの消去（0xFF）と書き換え回数のクリア */
+PUBLIC void vEEPROMSim_erase(tsEEPROMSim* psSim, bool_t bWearFlg);
+/** 統計情報のクリア */
+PUBLIC void vEEPROMSim_clearStats(tsEEPROMSim* psSim);
+/** 論理操作の開始 */
+PUBLIC void vEEPROMSim_beginOp(tsEEPROMSim* psSim, tsEEPROMSim_op* psOp);
+/** 論理操作の終了（書き込み量の集計） */
+PUBLIC void vEEPROMSim_endOp(tsEEPROMSim* psSim, tsEEPROMSim_op* psOp);
+/** 最大の書き換え回数 */
+PUBLIC uint32 u32EEPROMSim_maxWear(tsEEPROMSim* psSim, uint16* pu16Addr);
+/** 寿命の予測（日数） */
+PUBLIC uint32 u32EEPROMSim_projectLife(tsEEPROMSim* psSim, uint32 u32Sec, uint32 u32BaseWear);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* EEPROMSIM_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -8,6 +8,7 @@
  * DESCRIPTION:基本的な機能と処理フローを提供するフレームワーク
  *
  * CHANGE HISTORY:
+ * 2026/10/18 19:00:00 割り込み後にタスクコンテキストで実行するハードウェアイベント処理の登録を追加
  *
  * LAST MODIFIED BY:
  *
@@ -49,6 +50,10 @@
 /****************************************************************************/
 /***        Macro Definitions                                             ***/
 /****************************************************************************/
+// ハードウェアイベント処理（割り込み後の遅延処理）の最大登録数
+#ifndef APP_HW_EVT_TASK_SIZE
+	#define APP_HW_EVT_TASK_SIZE   (4)
+#endif
 
 /****************************************************************************/
 /***        Type Definitions                                              ***/
@@ -93,6 +98,14 @@ typedef struct {
 	uint8 (*pInfraredTask)(uint32 u32DeviceId, uint32 u32ItemBitmap);
 } tsHwIntTask;
 
+// 構造体：ハードウェアイベント処理情報（割り込みハンドラがFALSEを返した場合の遅延処理）
+typedef struct {
+	// デバイスID
+	uint32 u32DeviceId;
+	// 処理タスク関数ポインタ
+	void (*vpFunc)(uint32 u32DeviceId, uint32 u32ItemBitmap);
+} tsHwEvtTask;
+
 // 構造体：イベントタスク情報
 typedef struct {
 	// イベント種別
@@ -169,6 +182,8 @@ typedef struct {
 /****************************************************************************/
 // ハードウェア割り込みハンドラ（即時実行）
 PRIVATE tsHwIntTask sHwEventTask;
+// ハードウェアイベント処理（遅延実行）
+PRIVATE tsHwEvtTask sHwEvtTaskList[APP_HW_EVT_TASK_SIZE];
 // イベントタスク情報リスト
 PRIVATE tsEventTask sEventTaskList[APP_EVENT_TASK_SIZE];
 // スケジュールイベント情報
@@ -403,6 +418,13 @@ uint8 cbToCoNet_u8HwInt(uint32 u32DeviceId, uint32 u32ItemBitmap) {
  *
  ****************************************************************************/
 void cbToCoNet_vHwEvent(uint32 u32DeviceId, uint32 u32ItemBitmap) {
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < APP_HW_EVT_TASK_SIZE; u8Idx++) {
+		if (sHwEvtTaskList[u8Idx].vpFunc != NULL
+				&& sHwEvtTaskList[u8Idx].u32DeviceId == u32DeviceId) {
+			(*sHwEvtTaskList[u8Idx].vpFunc)(u32DeviceId, u32ItemBitmap);
+		}
+	}
 }
 
 /****************************************************************************
@@ -487,6 +509,46 @@ PUBLIC bool_t vRegisterHwIntTask(uint32 u32DeviceId
 	return TRUE;
 }
 
+/****************************************************************************
+ * NAME:bRegisterHwEvtTask
+ *
+ * DESCRIPTION:ハードウェアイベント処理の登録処理
+ *             割り込み処理がFALSEを返した場合に、タスクコンテキストで実行される
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32DeviceId     R   デバイスID
+ *   void*          vpFunc          R   処理関数のポインタ（NULLの場合は登録解除）
+ *
+ * RETURNS:
+ *     bool_t       登録結果、登録出来なかった場合にはFALSE
+ *
+ * NOTES:
+ ****************************************************************************/
+PUBLIC bool_t bRegisterHwEvtTask(uint32 u32DeviceId
+			,void (*vpFunc)(uint32 u32DeviceId, uint32 u32ItemBitmap)) {
+	tsHwEvtTask *psTask;
+	tsHwEvtTask *psEmpty = NULL;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < APP_HW_EVT_TASK_SIZE; u8Idx++) {
+		psTask = &sHwEvtTaskList[u8Idx];
+		// 登録済みの場合は上書き
+		if (psTask->vpFunc != NULL && psTask->u32DeviceId == u32DeviceId) {
+			psTask->vpFunc = vpFunc;
+			return TRUE;
+		}
+		if (psEmpty == NULL && psTask->vpFunc == NULL) {
+			psEmpty = psTask;
+		}
+	}
+	// 登録解除の場合、もしくは空きが無い場合
+	if (vpFunc == NULL || psEmpty == NULL) {
+		return (vpFunc == NULL);
+	}
+	psEmpty->u32DeviceId = u32DeviceId;
+	psEmpty->vpFunc = vpFunc;
+	return TRUE;
+}
+
 /****************************************************************************
  * NAME:bRegisterEvtTask
  *
@@ -716,6 +778,12 @@ PRIVATE void vInitHWEvtTask() {
 	vRegisterHwIntTask(E_AHI_DEVICE_TICK_TIMER, u8EmptyHwIntTask);	// 関数ポインタ：Tick timer
 	vRegisterHwIntTask(E_AHI_DEVICE_FEC, u8EmptyHwIntTask);			// 関数ポインタ：Flash and EEPROM Controller
 	vRegisterHwIntTask(E_AHI_DEVICE_INFRARED, u8EmptyHwIntTask);	// 関数ポインタ：Infrared
+	// ハードウェアイベント処理（遅延実行）の初期化
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < APP_HW_EVT_TASK_SIZE; u8Idx++) {
+		sHwEvtTaskList[u8Idx].u32DeviceId = 0;
+		sHwEvtTaskList[u8Idx].vpFunc = NULL;
+	}
 }
 
 /****************************************************************************
@@ -8,6 +8,7 @@
  * DESCRIPTION:基本的な機能と処理フローを提供するフレームワーク
  *
  * CHANGE HISTORY:
+ * 2026/10/18 19:00:00 割り込み後にタスクコンテキストで実行するハードウェアイベント処理の登録を追加
  *
  * LAST MODIFIED BY:
  *
@@ -65,6 +66,8 @@ PUBLIC tsSerialPortSetup sSerPort;
 /****************************************************************************/
 /** タスク登録処理：ハードウェア割り込み処理 */
 PUBLIC bool_t vRegisterHwIntTask(uint32 u32DeviceId, uint8 (*u8pFunc)(uint32 u32DeviceId, uint32 u32ItemBitmap));
+/** タスク登録処理：ハードウェアイベント処理（割り込み処理がFALSEを返した場合に実行） */
+PUBLIC bool_t bRegisterHwEvtTask(uint32 u32DeviceId, void (*vpFunc)(uint32 u32DeviceId, uint32 u32ItemBitmap));
 /** イベントタスク登録処理 */
 PUBLIC bool_t bRegisterEvtTask(teFwkEvent eEvt, void (*vpFunc)(uint32 u32EvtTimeMs));
 /** イベントタスク登録解除処理 */
@@ -0,0 +1,323 @@
+/****************************************************************************
+ *
+ * MODULE :I2C Recorder functions source file
+ *
+ * CREATED:2026/10/18 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   I2Cバスの通信内容を時刻付きで記録し、集計する関数群
+ *   I2C Recorder functions (source file)
+ *   ・i2c_utilをI2C_USE_RECORDERを定義してビルドした場合と、
+ *     ホスト環境用のi2c_replayから呼び出される
+ *   ・記録はリングバッファに保持し、溢れた場合は古い記録から上書きする
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <jendefs.h>
+
+#include "i2c_util.h"
+#include "i2c_recorder.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+/**
+ * 記録情報
+ */
+typedef struct {
+	bool_t bRecording;				// 記録中
+	uint16 u16Head;					// 最も古い記録の位置
+	uint16 u16Cnt;					// 記録件数
+	tsI2C_RecSummary sSummary;		// 集計情報
+	tsI2C_Record sRecords[I2C_RECORD_SIZE];	// 記録
+} tsI2CRec_state;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 記録情報
+PRIVATE tsI2CRec_state sI2CRec_state;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 記録領域の確保
+PRIVATE tsI2C_Record* psI2CRec_alloc();
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vI2CRec_start
+ *
+ * DESCRIPTION:記録の開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 記録内容と集計情報を初期化する
+ *****************************************************************************/
+PUBLIC void vI2CRec_start() {
+	memset(&sI2CRec_state, 0x00, sizeof(tsI2CRec_state));
+	sI2CRec_state.bRecording = TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CRec_stop
+ *
+ * DESCRIPTION:記録の停止
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 記録内容と集計情報は保持する
+ *****************************************************************************/
+PUBLIC void vI2CRec_stop() {
+	sI2CRec_state.bRecording = FALSE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CRec_append
+ *
+ * DESCRIPTION:記録の追加
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32Usec         R   時刻（マイクロ秒）
+ *   teI2C_RecType  eType           R   記録種別
+ *   uint8          u8Address       R   I2Cアドレス
+ *   uint8          u8Data          R   データ
+ *   uint8          u8Result        R   結果
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vI2CRec_append(uint32 u32Usec, teI2C_RecType eType, uint8 u8Address, uint8 u8Data, uint8 u8Result) {
+	tsI2C_Record* psRec = psI2CRec_alloc();
+	if (psRec == NULL) {
+		return;
+	}
+	psRec->u32Usec   = u32Usec;
+	psRec->u8Type    = (uint8)eType;
+	psRec->u8Address = u8Address;
+	psRec->u8Data    = u8Data;
+	psRec->u8Result  = u8Result;
+	psRec->u16Value  = 0;
+	// 集計
+	tsI2C_RecSummary* psSummary = &sI2CRec_state.sSummary;
+	switch (eType) {
+	case E_I2C_REC_START_W:
+	case E_I2C_REC_START_R:
+		psSummary->u32StartCnt++;
+		break;
+	case E_I2C_REC_WRITE:
+		psSummary->u32WriteBytes++;
+		break;
+	case E_I2C_REC_READ:
+		psSummary->u32ReadBytes++;
+		break;
+	case E_I2C_REC_STOP:
+		psSummary->u32StopCnt++;
+		break;
+	default:
+		break;
+	}
+	if (u8Result != I2CUTIL_STS_ACK) {
+		psSummary->u32ErrCnt++;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CRec_appendWait
+ *
+ * DESCRIPTION:待機時間の記録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32Usec         R   時刻（マイクロ秒）
+ *   uint32         u32WaitUsec     R   待機時間（マイクロ秒）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 待機しなかった場合は記録しない
+ *****************************************************************************/
+PUBLIC void vI2CRec_appendWait(uint32 u32Usec, uint32 u32WaitUsec) {
+	if (u32WaitUsec == 0) {
+		return;
+	}
+	tsI2C_Record* psRec = psI2CRec_alloc();
+	if (psRec == NULL) {
+		return;
+	}
+	psRec->u32Usec   = u32Usec;
+	psRec->u8Type    = E_I2C_REC_WAIT;
+	psRec->u8Address = 0;
+	psRec->u8Data    = 0;
+	psRec->u8Result  = I2CUTIL_STS_ACK;
+	psRec->u16Value  = (u32WaitUsec > 0xFFFF) ? 0xFFFF : (uint16)u32WaitUsec;
+	sI2CRec_state.sSummary.u32WaitUsec += u32WaitUsec;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CRec_appendTrns
+ *
+ * DESCRIPTION:非同期トランザクションの記録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32Usec         R   時刻（マイクロ秒）
+ *   uint8          u8Address       R   I2Cアドレス
+ *   uint16         u16WriteLen     R   書き込みバイト数
+ *   uint16         u16ReadLen      R   読み込みバイト数
+ *   uint8          u8Result        R   結果
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * バイト毎の内容は記録せずに、トランザクション単位で記録する
+ *****************************************************************************/
+PUBLIC void vI2CRec_appendTrns(uint32 u32Usec, uint8 u8Address, uint16 u16WriteLen, uint16 u16ReadLen, uint8 u8Result) {
+	tsI2C_Record* psRec = psI2CRec_alloc();
+	if (psRec == NULL) {
+		return;
+	}
+	psRec->u32Usec   = u32Usec;
+	psRec->u8Type    = E_I2C_REC_TRNS;
+	psRec->u8Address = u8Address;
+	psRec->u8Data    = 0;
+	psRec->u8Result  = u8Result;
+	psRec->u16Value  = u16WriteLen + u16ReadLen;
+	// 集計（読み込みがある場合はリピートスタート）
+	tsI2C_RecSummary* psSummary = &sI2CRec_state.sSummary;
+	psSummary->u32StartCnt += (u16WriteLen > 0 && u16ReadLen > 0) ? 2 : 1;
+	psSummary->u32StopCnt++;
+	psSummary->u32WriteBytes += u16WriteLen;
+	psSummary->u32ReadBytes  += u16ReadLen;
+	if (u8Result != I2CUTIL_STS_ACK) {
+		psSummary->u32ErrCnt++;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: u16I2CRec_count
+ *
+ * DESCRIPTION:記録件数の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint16         保持している記録件数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint16 u16I2CRec_count() {
+	return sI2CRec_state.u16Cnt;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psI2CRec_get
+ *
+ * DESCRIPTION:記録の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16Idx          R   インデックス（0が最も古い記録）
+ *
+ * RETURNS:
+ *   tsI2C_Record*  記録、範囲外の場合はNULL
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC const tsI2C_Record* psI2CRec_get(uint16 u16Idx) {
+	if (u16Idx >= sI2CRec_state.u16Cnt) {
+		return NULL;
+	}
+	return &sI2CRec_state.sRecords[(sI2CRec_state.u16Head + u16Idx) % I2C_RECORD_SIZE];
+}
+
+/*****************************************************************************
+ *
+ * NAME: psI2CRec_getSummary
+ *
+ * DESCRIPTION:集計情報の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsI2C_RecSummary* 記録開始からの集計情報
+ *
+ * NOTES:
+ * 集計情報はリングバッファから溢れた記録も含む
+ *****************************************************************************/
+PUBLIC const tsI2C_RecSummary* psI2CRec_getSummary() {
+	return &sI2CRec_state.sSummary;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: psI2CRec_alloc
+ *
+ * DESCRIPTION:記録領域の確保
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsI2C_Record*  記録領域、記録停止中の場合はNULL
+ *
+ * NOTES:
+ * 溢れた場合は最も古い記録を上書きする
+ *****************************************************************************/
+PRIVATE tsI2C_Record* psI2CRec_alloc() {
+	if (sI2CRec_state.bRecording == FALSE) {
+		return NULL;
+	}
+	uint16 u16Pos = (sI2CRec_state.u16Head + sI2CRec_state.u16Cnt) % I2C_RECORD_SIZE;
+	if (sI2CRec_state.u16Cnt < I2C_RECORD_SIZE) {
+		sI2CRec_state.u16Cnt++;
+	} else {
+		sI2CRec_state.u16Head = (sI2CRec_state.u16Head + 1) % I2C_RECORD_SIZE;
+		sI2CRec_state.sSummary.u32LostCnt++;
+	}
+	return &sI2CRec_state.sRecords[u16Pos];
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ * MODULE :I2C Recorder functions header file
+ *
+ * CREATED:2026/10/18 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   I2Cバスの通信内容を時刻付きで記録し、集計する関数群
+ *   I2C Recorder functions (header file)
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  I2CRECORDER_H_INCLUDED
+#define  I2CRECORDER_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 記録件数（リングバッファ）
+#ifndef I2C_RECORD_SIZE
+	#define I2C_RECORD_SIZE        (256)
+#endif
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 列挙型：記録種別
+typedef enum {
+	E_I2C_REC_START_W = 0,		// 書き込み開始（u8Data：なし）
+	E_I2C_REC_START_R,			// 読み込み開始（u8Data：なし）
+	E_I2C_REC_WRITE,			// 書き込み（u8Data：書き込みデータ）
+	E_I2C_REC_READ,				// 読み込み（u8Data：読み込みデータ）
+	E_I2C_REC_STOP,				// 停止条件
+	E_I2C_REC_WAIT,				// 通信間隔の待機（u8Data：なし、u16Value：待機時間）
+	E_I2C_REC_TRNS				// 非同期トランザクション（u8Data：なし、u16Value：送受信バイト数）
+} teI2C_RecType;
+
+// 構造体：記録
+typedef struct {
+	// 時刻（マイクロ秒）
+	uint32 u32Usec;
+	// 記録種別
+	uint8 u8Type;
+	// I2Cアドレス
+	uint8 u8Address;
+	// データ
+	uint8 u8Data;
+	// 結果（I2CUTIL_STS_ACK/NACK/ERR）
+	uint8 u8Result;
+	// 待機時間もしくはバイト数
+	uint16 u16Value;
+} tsI2C_Record;
+
+// 構造体：集計情報
+typedef struct {
+	// 開始条件の回数（リピートスタート含む）
+	uint32 u32StartCnt;
+	// 停止条件の回数（非同期トランザクション含む）
+	uint32 u32StopCnt;
+	// 書き込みバイト数
+	uint32 u32WriteBytes;
+	// 読み込みバイト数
+	uint32 u32ReadBytes;
+	// NACKもしくはエラーの回数
+	uint32 u32ErrCnt;
+	// 通信間隔の待機時間の合計（マイクロ秒）
+	uint32 u32WaitUsec;
+	// 上書きにより失われた記録件数
+	uint32 u32LostCnt;
+} tsI2C_RecSummary;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+// 記録の開始（記録内容と集計情報を初期化）
+PUBLIC void vI2CRec_start();
+// 記録の停止
+PUBLIC void vI2CRec_stop();
+// 記録の追加
+PUBLIC void vI2CRec_append(uint32 u32Usec, teI2C_RecType eType, uint8 u8Address, uint8 u8Data, uint8 u8Result);
+// 待機時間の記録
+PUBLIC void vI2CRec_appendWait(uint32 u32Usec, uint32 u32WaitUsec);
+// 非同期トランザクションの記録
+PUBLIC void vI2CRec_appendTrns(uint32 u32Usec, uint8 u8Address, uint16 u16WriteLen, uint16 u16ReadLen, uint8 u8Result);
+// 記録件数の参照
+PUBLIC uint16 u16I2CRec_count();
+// 記録の参照（古い順）
+PUBLIC const tsI2C_Record* psI2CRec_get(uint16 u16Idx);
+// 集計情報の参照
+PUBLIC const tsI2C_RecSummary* psI2CRec_getSummary();
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* I2CRECORDER_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,915 @@
+/****************************************************************************
+ *
+ * MODULE :I2C Replay functions source file
+ *
+ * CREATED:2026/10/18 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境でI2Cデバイスのドライバを評価する為のi2c_utilの代替実装
+ *   I2C Replay functions (source file)
+ *   ・i2c_util.cの代わりにリンクし、i2c_util.hの関数を実装する
+ *   ・通信相手は、登録したメモリ型のデバイスモデル（EEPROM、レジスタ型のセンサー等）、
+ *     コールバック型のデバイスモデル（eeprom_sim等）、
+ *     もしくは読み込んだスクリプト（i2c_recorderの記録）で応答する
+ *   ・バスの転送時間と通信間隔の待機は仮想時刻で計算し、実際には待機しない
+ *   ・通信内容はi2c_recorderに記録されるので、トランザクション毎のバイト数や
+ *     待機時間、冗長な通信の評価に使用出来る
+ *
+ * CHANGE HISTORY:
+ * 2026/10/19 07:00:00 コールバック型のデバイスモデル（EEPROMシミュレータ等）の登録を追加
+ * 2026/10/19 19:00:00 読み込みの終端ACK/NACK返信とトランザクションのアドレスNACKを反映
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <jendefs.h>
+
+#include "i2c_util.h"
+#include "i2c_recorder.h"
+#include "i2c_replay.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// I2C Acceess Interval（i2c_utilと同じ値）
+#define I2C_INTERVAL               (100)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+/**
+ * メモリ型デバイスモデル
+ */
+typedef struct {
+	uint8 u8Address;		// I2Cアドレス
+	uint8* pu8Mem;			// メモリ
+	uint16 u16MemSize;		// メモリサイズ
+	uint8 u8AddrLen;		// メモリアドレス長（0：書き込みのみのデバイス）
+	uint8 u8AddrCnt;		// 受信済みのメモリアドレスのバイト数
+	uint16 u16Ptr;			// メモリアドレス
+	const tsI2CReplay_DevIF* psDevIF;	// 応答関数（NULL：メモリ型）
+	void* pvContext;		// 応答関数に渡す値
+} tsI2CReplay_Model;
+
+/**
+ * 代替実装の状態
+ */
+typedef struct {
+	uint8 u8PreScaler;					// 動作周波数
+	uint64 u64Usec;						// 仮想時刻
+	uint64 u64LastStart;				// 最終アクセス時刻（仮想時刻）
+	uint8 u8Address;					// 通信中のI2Cアドレス
+	tsI2CReplay_Model* psModel;			// 通信中のデバイスモデル
+	bool_t bAddrNack;					// 通信中のデバイスモデルがアドレスにNACK応答した
+	bool_t bReadEnd;					// マスターのNACK返信で読み込みを終了した
+	uint8 u8ModelCnt;					// デバイスモデル数
+	const tsI2C_Record* psScript;		// スクリプト
+	uint16 u16ScriptCnt;				// スクリプト件数
+	uint16 u16ScriptIdx;				// スクリプトの実行位置
+	uint32 u32Mismatch;					// スクリプトとの不一致件数
+	tsI2CReplay_Model sModels[I2C_REPLAY_MODEL_SIZE];	// デバイスモデル
+} tsI2CReplay_state;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 代替実装の状態
+PRIVATE tsI2CReplay_state sI2CReplay_state;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 通信間隔制御
+PRIVATE void vI2CReplay_waitInterval();
+// バス転送時間の加算
+PRIVATE void vI2CReplay_elapse(uint32 u32Bits);
+// 開始条件
+PRIVATE bool_t bI2CReplay_start(uint8 u8Address, teI2C_RecType eType);
+// 1バイト書き込み
+PRIVATE uint8 u8I2CReplay_write(uint8 u8Data);
+// 1バイト読み込み
+PRIVATE uint8 u8I2CReplay_read(bool_t bAckFlg);
+// 停止条件
+PRIVATE void vI2CReplay_stop();
+// スクリプトの照合
+PRIVATE const tsI2C_Record* psI2CReplay_script(teI2C_RecType eType, uint8 u8Data);
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vI2CReplay_init
+ *
+ * DESCRIPTION:初期化処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * デバイスモデルとスクリプト、仮想時刻を初期化する
+ *****************************************************************************/
+PUBLIC void vI2CReplay_init() {
+	memset(&sI2CReplay_state, 0x00, sizeof(tsI2CReplay_state));
+	sI2CReplay_state.u8PreScaler = I2C_PRESCALER_100KHZ;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2CReplay_registMemModel
+ *
+ * DESCRIPTION:メモリ型デバイスモデルの登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Address       R   I2Cアドレス
+ *   uint8*         pu8Mem          RW  メモリ
+ *   uint16         u16MemSize      R   メモリサイズ
+ *   uint8          u8AddrLen       R   メモリアドレス長（0：書き込みのみのデバイス）
+ *
+ * RETURNS:
+ *   TRUE:登録した
+ *
+ * NOTES:
+ * 書き込み開始後のメモリアドレス長分のデータをメモリアドレスとし、
+ * 以降の読み書きはメモリアドレスを自動的に進める（メモリサイズで折り返す）
+ *****************************************************************************/
+PUBLIC bool_t bI2CReplay_registMemModel(uint8 u8Address, uint8* pu8Mem, uint16 u16MemSize, uint8 u8AddrLen) {
+	if (sI2CReplay_state.u8ModelCnt >= I2C_REPLAY_MODEL_SIZE) {
+		return FALSE;
+	}
+	if (u8AddrLen > 0 && (pu8Mem == NULL || u16MemSize == 0)) {
+		return FALSE;
+	}
+	tsI2CReplay_Model* psModel = &sI2CReplay_state.sModels[sI2CReplay_state.u8ModelCnt++];
+	psModel->u8Address  = u8Address;
+	psModel->pu8Mem     = pu8Mem;
+	psModel->u16MemSize = u16MemSize;
+	psModel->u8AddrLen  = u8AddrLen;
+	psModel->u8AddrCnt  = 0;
+	psModel->u16Ptr     = 0;
+	psModel->psDevIF    = NULL;
+	psModel->pvContext  = NULL;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2CReplay_registDevModel
+ *
+ * DESCRIPTION:コールバック型デバイスモデルの登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Address       R   I2Cアドレス
+ *   tsI2CReplay_DevIF* psDevIF     R   応答関数
+ *   void*          pvContext       R   応答関数に渡す値
+ *
+ * RETURNS:
+ *   TRUE:登録した
+ *
+ * NOTES:
+ * 書き込み周期やページバッファ等、メモリ型では表現出来ない動作のデバイスを
+ * 応答関数で模擬する（応答関数は仮想時刻をu64I2CReplay_readUsecで参照出来る）
+ *****************************************************************************/
+PUBLIC bool_t bI2CReplay_registDevModel(uint8 u8Address, const tsI2CReplay_DevIF* psDevIF, void* pvContext) {
+	if (sI2CReplay_state.u8ModelCnt >= I2C_REPLAY_MODEL_SIZE) {
+		return FALSE;
+	}
+	if (psDevIF == NULL || psDevIF->pfStart == NULL || psDevIF->pfWrite == NULL
+			|| psDevIF->pfRead == NULL || psDevIF->pfStop == NULL) {
+		return FALSE;
+	}
+	tsI2CReplay_Model* psModel = &sI2CReplay_state.sModels[sI2CReplay_state.u8ModelCnt++];
+	memset(psModel, 0x00, sizeof(tsI2CReplay_Model));
+	psModel->u8Address = u8Address;
+	psModel->psDevIF   = psDevIF;
+	psModel->pvContext = pvContext;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CReplay_loadScript
+ *
+ * DESCRIPTION:スクリプトの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsI2C_Record*  psRecords       R   スクリプト（記録の配列）
+ *   uint16         u16Cnt          R   件数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * スクリプトの実行中は、開始条件と書き込みを記録と照合し、
+ * 読み込みと結果は記録の内容で応答する（待機と非同期トランザクションの記録は読み飛ばす）
+ * スクリプトの終了後はデバイスモデルで応答する
+ *****************************************************************************/
+PUBLIC void vI2CReplay_loadScript(const tsI2C_Record* psRecords, uint16 u16Cnt) {
+	sI2CReplay_state.psScript     = psRecords;
+	sI2CReplay_state.u16ScriptCnt = u16Cnt;
+	sI2CReplay_state.u16ScriptIdx = 0;
+	sI2CReplay_state.u32Mismatch  = 0;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32I2CReplay_getMismatch
+ *
+ * DESCRIPTION:スクリプトとの不一致件数の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32         不一致件数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint32 u32I2CReplay_getMismatch() {
+	return sI2CReplay_state.u32Mismatch;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u64I2CReplay_readUsec
+ *
+ * DESCRIPTION:仮想時刻の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint64         初期化からの仮想時刻（マイクロ秒）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint64 u64I2CReplay_readUsec() {
+	return sI2CReplay_state.u64Usec;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CReplay_waitUntil
+ *
+ * DESCRIPTION:仮想時刻の待機
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint64         u64Usec         R   待機終了時刻（仮想時刻）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ホスト環境のtimer_utilの代替から呼び出し、バス通信を伴わない待機（ACKポーリングの
+ * 間隔等）でも仮想時刻を進める（過去の時刻の場合は何もしない）
+ *****************************************************************************/
+PUBLIC void vI2CReplay_waitUntil(uint64 u64Usec) {
+	if (sI2CReplay_state.u64Usec < u64Usec) {
+		sI2CReplay_state.u64Usec = u64Usec;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_init
+ *
+ * DESCRIPTION:マスターとしてI2Cバス接続する際の初期設定処理
+ *
+ * PARAMETERS:      Name            RW Usage
+ *   uint8          u8PreScaler     R  動作周波数 = 16/[(u8PreScaler + 1) x 5] MHz
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * デバイスモデルとスクリプトは初期化しない
+ *****************************************************************************/
+PUBLIC void vI2C_init(uint8 u8PreScaler) {
+	sI2CReplay_state.u8PreScaler = u8PreScaler;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_startRead
+ *
+ * DESCRIPTION:I2Cバスからの読み込み開始処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *                  u8Address		R	I2Cアドレス
+ *
+ * RETURNS:
+ *     TRUE ：通信が成功した
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bI2C_startRead(uint8 u8Address) {
+	bI2CReplay_start(u8Address, E_I2C_REC_START_R);
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_startWrite
+ *
+ * DESCRIPTION:I2Cバスへの書き込み開始処理
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            u8Address		R	I2Cアドレス
+ *
+ * RETURNS:
+ *     TRUE ：通信が成功した
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bI2C_startWrite(uint8 u8Address) {
+	bI2CReplay_start(u8Address, E_I2C_REC_START_W);
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_read
+ *
+ * DESCRIPTION:I2Cバスからの読み込み処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *                  pu8Data         W   読み込み先データ領域へのポインタ
+ *                  u8Length        R   読み出しバイト数 (0 なら、付随データなし)
+ *                  bAckEndFlg      R   終端ACK返信フラグ（TRUE:ACK返信で終了）
+ *
+ * RETURNS:
+ *     TRUE ：通信が成功した
+ *     FALSE：NACK返信で終了した読み込みを、開始条件無しで継続した
+ *
+ * NOTES:
+ * 最終バイト以外はACK、最終バイトはbAckEndFlgに従って返信する
+ *****************************************************************************/
+PUBLIC bool_t bI2C_read(uint8* pu8Data, uint8 u8Length, bool_t bAckEndFlg) {
+	bool_t bResult = !sI2CReplay_state.bReadEnd;
+	int idx;
+	for (idx = 0; idx < u8Length; idx++) {
+		pu8Data[idx] = u8I2CReplay_read((idx < u8Length - 1) || bAckEndFlg);
+	}
+	return bResult;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_write
+ *
+ * DESCRIPTION:I2Cバスへの書き込み処理、後続の書き込みがある前提で書き込みを行う
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            pu8Data 		R	書き込みデータ
+ *
+ * RETURNS:
+ *     I2CUTIL_STS_ACK (TRUE) ：ACK返信
+ *     I2CUTIL_STS_NACK(FALSE)：NACK返信
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint8 u8I2C_write(uint8 u8Data) {
+	return u8I2CReplay_write(u8Data);
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_writeStop
+ *
+ * DESCRIPTION:I2Cバスへの書き込み処理、後続の書き込みが無い終端バイトとして書き込みを行う
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            pu8Data 		R	書き込みデータ
+ *
+ * RETURNS:
+ *     I2CUTIL_STS_ACK (TRUE) ：ACK返信
+ *     I2CUTIL_STS_NACK(FALSE)：NACK返信
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint8 u8I2C_writeStop(uint8 u8Data) {
+	uint8 u8Result = u8I2CReplay_write(u8Data);
+	vI2CReplay_stop();
+	return u8Result;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_stopACK
+ *
+ * DESCRIPTION:I2Cバスとの通信完了処理（ACK返信）
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *     TRUE ：通信が成功した
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bI2C_stopACK() {
+	vI2CReplay_stop();
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_stopNACK
+ *
+ * DESCRIPTION:I2Cバスとの通信完了処理（NACK返信）
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *     TRUE ：通信が成功した
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bI2C_stopNACK() {
+	vI2CReplay_stop();
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32I2C_getFrequency
+ *
+ * DESCRIPTION:I2Cバス駆動周波数の取得処理
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *     uint32：駆動周波数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint32 u32I2C_getFrequency() {
+	return u32I2C_toFrequency(sI2CReplay_state.u8PreScaler);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_setPreScaler
+ *
+ * DESCRIPTION:バス駆動周波数の既定値変更
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            u8PreScaler   R   動作周波数 = 16/[(u8PreScaler + 1) x 5] MHz
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vI2C_setPreScaler(uint8 u8PreScaler) {
+	sI2CReplay_state.u8PreScaler = u8PreScaler;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32I2C_toFrequency
+ *
+ * DESCRIPTION:動作周波数からバス駆動周波数への変換
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            u8PreScaler   R   動作周波数
+ *
+ * RETURNS:
+ *     uint32：駆動周波数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint32 u32I2C_toFrequency(uint8 u8PreScaler) {
+	return 3200000 / (u8PreScaler + 1);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_initAsync
+ *
+ * DESCRIPTION:非同期処理の初期化処理
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 非同期トランザクションは登録時に同期的に実行する
+ *****************************************************************************/
+PUBLIC void vI2C_initAsync() {
+	return;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_entryTrns
+ *
+ * DESCRIPTION:非同期トランザクションの登録処理
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            psTrns        RW  トランザクション
+ *
+ * RETURNS:
+ *     TRUE ：登録した
+ *     FALSE：登録済み
+ *
+ * NOTES:
+ * 登録時に実行し、完了時のコールバックと完了イベントの登録まで行う
+ *****************************************************************************/
+PUBLIC bool_t bI2C_entryTrns(tsI2C_Trns* psTrns) {
+	if (psTrns == NULL) {
+		return FALSE;
+	}
+	if (psTrns->eStatus == E_I2C_TRNS_STS_QUEUED || psTrns->eStatus == E_I2C_TRNS_STS_BUSY) {
+		return FALSE;
+	}
+	psTrns->eStatus = E_I2C_TRNS_STS_BUSY;
+	psTrns->psNext  = NULL;
+	uint8 u8BefPreScaler = sI2CReplay_state.u8PreScaler;
+	if (psTrns->u8PreScaler != I2C_PRESCALER_DEFAULT) {
+		sI2CReplay_state.u8PreScaler = psTrns->u8PreScaler;
+	}
+	// 書き込み
+	teI2C_TrnsStatus eStatus = E_I2C_TRNS_STS_ACK;
+	uint16 u16Idx;
+	if (psTrns->u16WriteLen > 0 || psTrns->u16ReadLen == 0) {
+		if (!bI2CReplay_start(psTrns->u8Address, E_I2C_REC_START_W)) {
+			eStatus = E_I2C_TRNS_STS_NACK;
+		}
+		for (u16Idx = 0; eStatus == E_I2C_TRNS_STS_ACK && u16Idx < psTrns->u16WriteLen; u16Idx++) {
+			if (u8I2CReplay_write(psTrns->pu8WriteData[u16Idx]) != I2CUTIL_STS_ACK) {
+				eStatus = E_I2C_TRNS_STS_NACK;
+				break;
+			}
+		}
+	}
+	// 読み込み（リピートスタート）
+	if (eStatus == E_I2C_TRNS_STS_ACK && psTrns->u16ReadLen > 0) {
+		if (!bI2CReplay_start(psTrns->u8Address, E_I2C_REC_START_R)) {
+			eStatus = E_I2C_TRNS_STS_NACK;
+		} else {
+			// 最終バイトはNACK返信
+			for (u16Idx = 0; u16Idx < psTrns->u16ReadLen; u16Idx++) {
+				psTrns->pu8ReadData[u16Idx] = u8I2CReplay_read(u16Idx < psTrns->u16ReadLen - 1);
+			}
+		}
+	}
+	vI2CReplay_stop();
+	sI2CReplay_state.u8PreScaler = u8BefPreScaler;
+	// 完了通知
+	psTrns->eStatus = eStatus;
+	if (psTrns->pfCallback != NULL) {
+		(*psTrns->pfCallback)(psTrns);
+	}
+	if (psTrns->eCompEvt != E_EVENT_FWK_EMPTY) {
+		iEntrySeqEvt(psTrns->eCompEvt);
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_isBusy
+ *
+ * DESCRIPTION:非同期トランザクションの実行中判定
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *     FALSE：登録時に実行するので常に実行中では無い
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bI2C_isBusy() {
+	return FALSE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_execTrns
+ *
+ * DESCRIPTION:トランザクションの実行処理（完了まで待機）
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            psTrns        RW  トランザクション
+ *
+ * RETURNS:
+ *     I2CUTIL_STS_ACK (TRUE) ：正常終了
+ *     I2CUTIL_STS_NACK(FALSE)：NACK返信
+ *     I2CUTIL_STS_ERR (0xFF) ：通信エラー発生
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint8 u8I2C_execTrns(tsI2C_Trns* psTrns) {
+	if (bI2C_entryTrns(psTrns) == FALSE) {
+		return I2CUTIL_STS_ERR;
+	}
+	if (psTrns->eStatus == E_I2C_TRNS_STS_ACK) {
+		return I2CUTIL_STS_ACK;
+	}
+	if (psTrns->eStatus == E_I2C_TRNS_STS_NACK) {
+		return I2CUTIL_STS_NACK;
+	}
+	return I2CUTIL_STS_ERR;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_waitIdle
+ *
+ * DESCRIPTION:非同期トランザクションの完了待ち
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 登録時に実行するので待機しない
+ *****************************************************************************/
+PUBLIC void vI2C_waitIdle() {
+	return;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vI2CReplay_waitInterval
+ *
+ * DESCRIPTION:前回の通信開始からの通信間隔の待機（仮想時刻）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * i2c_utilの通信間隔制御と同じ時間を仮想時刻に加算し、待機時間として記録する
+ *****************************************************************************/
+PRIVATE void vI2CReplay_waitInterval() {
+	uint64 u64EndTime = sI2CReplay_state.u64LastStart + I2C_INTERVAL;
+	if (sI2CReplay_state.u64Usec < u64EndTime) {
+		uint32 u32Wait = (uint32)(u64EndTime - sI2CReplay_state.u64Usec);
+		sI2CReplay_state.u64Usec = u64EndTime;
+		vI2CRec_appendWait((uint32)sI2CReplay_state.u64Usec, u32Wait);
+	}
+	sI2CReplay_state.u64LastStart = sI2CReplay_state.u64Usec;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CReplay_elapse
+ *
+ * DESCRIPTION:バス転送時間の加算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32Bits         R   転送ビット数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vI2CReplay_elapse(uint32 u32Bits) {
+	sI2CReplay_state.u64Usec += (uint64)u32Bits * 1000000 / u32I2C_getFrequency();
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2CReplay_start
+ *
+ * DESCRIPTION:開始条件
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Address       R   I2Cアドレス
+ *   teI2C_RecType  eType           R   E_I2C_REC_START_W/R
+ *
+ * RETURNS:
+ *     TRUE ：アドレスにACK応答した
+ *     FALSE：アドレスにNACK応答した
+ *
+ * NOTES:
+ * 同期処理では実機と同様に、アドレスに対するNACKは後続の書き込みの結果で通知する
+ * 非同期処理（bI2C_entryTrns）は戻り値でアドレスに対するNACKを判定する
+ *****************************************************************************/
+PRIVATE bool_t bI2CReplay_start(uint8 u8Address, teI2C_RecType eType) {
+	// 通信間隔制御と開始条件、アドレスの送信時間
+	vI2CReplay_waitInterval();
+	vI2CReplay_elapse(10);
+	// デバイスモデルの選択
+	sI2CReplay_state.u8Address = u8Address;
+	sI2CReplay_state.psModel   = NULL;
+	sI2CReplay_state.bReadEnd  = FALSE;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < sI2CReplay_state.u8ModelCnt; u8Idx++) {
+		if (sI2CReplay_state.sModels[u8Idx].u8Address == u8Address) {
+			sI2CReplay_state.psModel = &sI2CReplay_state.sModels[u8Idx];
+			break;
+		}
+	}
+	if (sI2CReplay_state.psModel != NULL && eType == E_I2C_REC_START_W) {
+		sI2CReplay_state.psModel->u8AddrCnt = 0;
+	}
+	// コールバック型デバイスモデルの開始条件（書き込みサイクル中等はNACK）
+	sI2CReplay_state.bAddrNack = FALSE;
+	tsI2CReplay_Model* psModel = sI2CReplay_state.psModel;
+	if (psModel != NULL && psModel->psDevIF != NULL) {
+		sI2CReplay_state.bAddrNack =
+			!(*psModel->psDevIF->pfStart)(psModel->pvContext, (eType == E_I2C_REC_START_R));
+	}
+	// スクリプトとの照合
+	uint8 u8Result = (psModel != NULL && !sI2CReplay_state.bAddrNack) ? I2CUTIL_STS_ACK : I2CUTIL_STS_NACK;
+	const tsI2C_Record* psRec = psI2CReplay_script(eType, 0);
+	if (psRec != NULL) {
+		u8Result = psRec->u8Result;
+	}
+	vI2CRec_append((uint32)sI2CReplay_state.u64Usec, eType, u8Address, 0, u8Result);
+	return (u8Result == I2CUTIL_STS_ACK);
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CReplay_write
+ *
+ * DESCRIPTION:1バイト書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Data          R   書き込みデータ
+ *
+ * RETURNS:
+ *     I2CUTIL_STS_ACK (TRUE) ：ACK返信
+ *     I2CUTIL_STS_NACK(FALSE)：NACK返信
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8I2CReplay_write(uint8 u8Data) {
+	vI2CReplay_elapse(9);
+	uint8 u8Result = I2CUTIL_STS_NACK;
+	tsI2CReplay_Model* psModel = sI2CReplay_state.psModel;
+	if (psModel != NULL && sI2CReplay_state.bAddrNack) {
+		// アドレスにNACK応答したデバイスは応答しない
+	} else if (psModel != NULL && psModel->psDevIF != NULL) {
+		u8Result = (*psModel->psDevIF->pfWrite)(psModel->pvContext, u8Data);
+	} else if (psModel != NULL) {
+		if (psModel->u8AddrCnt < psModel->u8AddrLen) {
+			// メモリアドレス
+			psModel->u16Ptr = (psModel->u8AddrCnt == 0) ? u8Data : ((psModel->u16Ptr << 8) | u8Data);
+			psModel->u8AddrCnt++;
+		} else if (psModel->u8AddrLen > 0) {
+			// データ
+			psModel->u16Ptr = psModel->u16Ptr % psModel->u16MemSize;
+			psModel->pu8Mem[psModel->u16Ptr] = u8Data;
+			psModel->u16Ptr++;
+		}
+		u8Result = I2CUTIL_STS_ACK;
+	}
+	// スクリプトとの照合
+	const tsI2C_Record* psRec = psI2CReplay_script(E_I2C_REC_WRITE, u8Data);
+	if (psRec != NULL) {
+		u8Result = psRec->u8Result;
+	}
+	vI2CRec_append((uint32)sI2CReplay_state.u64Usec, E_I2C_REC_WRITE, sI2CReplay_state.u8Address, u8Data, u8Result);
+	return u8Result;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CReplay_read
+ *
+ * DESCRIPTION:1バイト読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bAckFlg         R   マスターの返信（TRUE:ACK、FALSE:NACK）
+ *
+ * RETURNS:
+ *   uint8          読み込みデータ（応答するデバイスが無い場合は0xFF）
+ *
+ * NOTES:
+ * NACK返信後のスレーブはバスを解放するので、開始条件までの読み込みは0xFFとなり、
+ * デバイスモデルのアドレスも進まない（エラーとして記録する）
+ *****************************************************************************/
+PRIVATE uint8 u8I2CReplay_read(bool_t bAckFlg) {
+	vI2CReplay_elapse(9);
+	uint8 u8Data = 0xFF;
+	uint8 u8Result = I2CUTIL_STS_ACK;
+	tsI2CReplay_Model* psModel = sI2CReplay_state.psModel;
+	if (sI2CReplay_state.bReadEnd) {
+		// NACK返信で読み込みを終了したデバイスは応答しない
+		u8Result = I2CUTIL_STS_ERR;
+	} else if (psModel != NULL && sI2CReplay_state.bAddrNack) {
+		// アドレスにNACK応答したデバイスは応答しない
+	} else if (psModel != NULL && psModel->psDevIF != NULL) {
+		u8Data = (*psModel->psDevIF->pfRead)(psModel->pvContext);
+	} else if (psModel != NULL && psModel->u8AddrLen > 0) {
+		psModel->u16Ptr = psModel->u16Ptr % psModel->u16MemSize;
+		u8Data = psModel->pu8Mem[psModel->u16Ptr];
+		psModel->u16Ptr++;
+	}
+	// スクリプトの読み込みデータで応答
+	const tsI2C_Record* psRec = psI2CReplay_script(E_I2C_REC_READ, 0);
+	if (psRec != NULL) {
+		u8Data = psRec->u8Data;
+	}
+	vI2CRec_append((uint32)sI2CReplay_state.u64Usec, E_I2C_REC_READ, sI2CReplay_state.u8Address, u8Data, u8Result);
+	if (!bAckFlg) {
+		sI2CReplay_state.bReadEnd = TRUE;
+	}
+	return u8Data;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CReplay_stop
+ *
+ * DESCRIPTION:停止条件
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vI2CReplay_stop() {
+	vI2CReplay_elapse(1);
+	psI2CReplay_script(E_I2C_REC_STOP, 0);
+	vI2CRec_append((uint32)sI2CReplay_state.u64Usec, E_I2C_REC_STOP, sI2CReplay_state.u8Address, 0, I2CUTIL_STS_ACK);
+	// コールバック型デバイスモデルの停止条件（書き込みサイクルの開始等）
+	tsI2CReplay_Model* psModel = sI2CReplay_state.psModel;
+	if (psModel != NULL && psModel->psDevIF != NULL && !sI2CReplay_state.bAddrNack) {
+		(*psModel->psDevIF->pfStop)(psModel->pvContext);
+	}
+	sI2CReplay_state.psModel   = NULL;
+	sI2CReplay_state.bAddrNack = FALSE;
+	sI2CReplay_state.bReadEnd  = FALSE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psI2CReplay_script
+ *
+ * DESCRIPTION:スクリプトの照合
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   teI2C_RecType  eType           R   記録種別
+ *   uint8          u8Data          R   書き込みデータ
+ *
+ * RETURNS:
+ *   tsI2C_Record*  対応する記録、スクリプトが無い場合はNULL
+ *
+ * NOTES:
+ * 記録種別とアドレス、書き込みデータが一致しない場合は不一致件数を加算する
+ *****************************************************************************/
+PRIVATE const tsI2C_Record* psI2CReplay_script(teI2C_RecType eType, uint8 u8Data) {
+	if (sI2CReplay_state.psScript == NULL) {
+		return NULL;
+	}
+	// 待機と非同期トランザクションの記録は読み飛ばす
+	const tsI2C_Record* psRec;
+	while (sI2CReplay_state.u16ScriptIdx < sI2CReplay_state.u16ScriptCnt) {
+		psRec = &sI2CReplay_state.psScript[sI2CReplay_state.u16ScriptIdx];
+		if (psRec->u8Type != E_I2C_REC_WAIT && psRec->u8Type != E_I2C_REC_TRNS) {
+			break;
+		}
+		sI2CReplay_state.u16ScriptIdx++;
+	}
+	// スクリプトの終了
+	if (sI2CReplay_state.u16ScriptIdx >= sI2CReplay_state.u16ScriptCnt) {
+		sI2CReplay_state.psScript = NULL;
+		sI2CReplay_state.u32Mismatch++;
+		return NULL;
+	}
+	psRec = &sI2CReplay_state.psScript[sI2CReplay_state.u16ScriptIdx++];
+	if (psRec->u8Type != (uint8)eType || psRec->u8Address != sI2CReplay_state.u8Address
+			|| (eType == E_I2C_REC_WRITE && psRec->u8Data != u8Data)) {
+		sI2CReplay_state.u32Mismatch++;
+	}
+	return psRec;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ * MODULE :I2C Replay functions header file
+ *
+ * CREATED:2026/10/18 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境でI2Cデバイスのドライバを評価する為のi2c_utilの代替実装
+ *   I2C Replay functions (header file)
+ *
+ * CHANGE HISTORY:
+ * 2026/10/19 07:00:00 コールバック型のデバイスモデル（EEPROMシミュレータ等）の登録を追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  I2CREPLAY_H_INCLUDED
+#define  I2CREPLAY_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include "i2c_util.h"
+#include "i2c_recorder.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 登録可能なデバイスモデル数
+#ifndef I2C_REPLAY_MODEL_SIZE
+	#define I2C_REPLAY_MODEL_SIZE  (8)
+#endif
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+/**
+ * コールバック型デバイスモデルの応答関数
+ * ・pfStart：開始条件（戻り値FALSEでアドレスにNACK応答、以降の書き込みもNACK）
+ * ・pfWrite：1バイト書き込み（戻り値はACK/NACK）
+ * ・pfRead ：1バイト読み込み
+ * ・pfStop ：停止条件
+ * pvContextには登録時に指定した値が渡される
+ */
+typedef struct {
+	bool_t (*pfStart)(void* pvContext, bool_t bReadFlg);
+	uint8 (*pfWrite)(void* pvContext, uint8 u8Data);
+	uint8 (*pfRead)(void* pvContext);
+	void (*pfStop)(void* pvContext);
+} tsI2CReplay_DevIF;
+
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+// 初期化処理（デバイスモデルとスクリプト、仮想時刻を初期化）
+PUBLIC void vI2CReplay_init();
+// メモリ型デバイスモデルの登録
+PUBLIC bool_t bI2CReplay_registMemModel(uint8 u8Address, uint8* pu8Mem, uint16 u16MemSize, uint8 u8AddrLen);
+// コールバック型デバイスモデルの登録
+PUBLIC bool_t bI2CReplay_registDevModel(uint8 u8Address, const tsI2CReplay_DevIF* psDevIF, void* pvContext);
+// スクリプトの読み込み
+PUBLIC void vI2CReplay_loadScript(const tsI2C_Record* psRecords, uint16 u16Cnt);
+// スクリプトとの不一致件数の参照
+PUBLIC uint32 u32I2CReplay_getMismatch();
+// 仮想時刻の参照
+PUBLIC uint64 u64I2CReplay_readUsec();
+// 仮想時刻の待機
+PUBLIC void vI2CReplay_waitUntil(uint64 u64Usec);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* I2CREPLAY_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
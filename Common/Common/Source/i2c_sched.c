@@ -0,0 +1,719 @@
+/****************************************************************************
+ *
+ * MODULE :I2C Scheduler functions source file
+ *
+ * CREATED:2026/10/18 20:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   I2Cバスを共有するデバイス毎の要求キューと実行順序の制御を行う関数群
+ *   I2C Scheduler functions (source file)
+ *   ・デバイス毎に要求をキューイングし、優先度の高いデバイスから順に実行する
+ *     同じ優先度のデバイス間はラウンドロビンで実行する
+ *   ・同一デバイスのメモリアドレスが連続する読み込み要求は１回の読み込みに結合する
+ *   ・バスへの要求は１件ずつ非同期トランザクションとして実行し、
+ *     完了時のコールバックで次の要求を実行する
+ *
+ * CHANGE HISTORY:
+ * 2026/10/18 21:00:00 デバイス毎の動作周波数と自動調整処理を追加
+ * 2026/10/19 17:00:00 要求の編集処理を追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <jendefs.h>
+#include <AppHardwareApi.h>
+
+#include "i2c_util.h"
+#include "i2c_sched.h"
+#include "timer_util.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+/**
+ * デバイス情報
+ */
+typedef struct {
+	const char* pcName;			// デバイス名
+	uint8 u8Address;			// I2Cアドレス
+	uint8 u8Priority;			// 優先度（0が最優先）
+	uint8 u8Bus;				// バス番号
+	uint8 u8PreScaler;			// 動作周波数
+	tsI2CSched_Req* psHead;		// 要求キュー：先頭
+	tsI2CSched_Req* psTail;		// 要求キュー：末尾
+	tsI2CSched_Stats sStats;	// 統計情報
+} tsI2CSched_Device;
+
+/**
+ * スケジューラ情報
+ */
+typedef struct {
+	void (*pfBusSelect)(uint8 u8Bus);	// バス切替処理
+	uint8 (*pfBusCurrent)();			// 選択中のバス参照処理
+	uint8 u8DevCnt;				// 登録デバイス数
+	uint8 u8LastDevIdx;			// 前回実行したデバイス
+	bool_t bBusy;				// 実行中
+	uint8 u8ExecDevIdx;			// 実行中のデバイス
+	uint8 u8ExecReqCnt;			// 実行中の要求件数（結合した件数）
+	uint8 u8SavedBus;			// 実行前に選択されていたバス
+	uint64 u64ExecStart;		// 実行開始時刻
+	uint64 u64StatsStart;		// 統計情報の集計開始時刻
+	tsI2C_Trns sTrns;			// 実行中のトランザクション
+	uint8 u8MergeBuff[I2C_SCHED_MERGE_BUFF_SIZE];	// 結合した読み込みのバッファ
+} tsI2CSched_state;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 自動調整で試行する動作周波数（高速な順）
+//   7:400KHz, 9:320KHz, 11:266KHz, 15:200KHz, 23:133KHz, 31:100KHz, 47:66KHz
+PRIVATE const uint8 I2C_SCHED_TUNE_PRESCALER[] = {7, 9, 11, 15, 23, 31, 47};
+// デバイス情報
+PRIVATE tsI2CSched_Device sI2CSched_devices[I2C_SCHED_DEVICE_SIZE];
+// スケジューラ情報
+PRIVATE tsI2CSched_state sI2CSched_state;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 次の要求の実行
+PRIVATE void vI2CSched_dispatch();
+// 結合可能な要求数の判定
+PRIVATE uint8 u8I2CSched_mergeCnt(tsI2CSched_Req* psReq, uint16* pu16ReadLen);
+// メモリアドレスの取得
+PRIVATE uint16 u16I2CSched_memAddr(tsI2CSched_Req* psReq);
+// トランザクション完了時の処理
+PRIVATE void vI2CSched_complete(tsI2C_Trns* psTrns);
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vI2CSched_init
+ *
+ * DESCRIPTION:初期化処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pfBusSelect     R   バス切替処理（NULL：切替なし）
+ *   uint8*         pfBusCurrent    R   選択中のバス参照処理（NULL：切替なし）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * vI2C_initAsyncの後に呼び出す事
+ *****************************************************************************/
+PUBLIC void vI2CSched_init(void (*pfBusSelect)(uint8 u8Bus), uint8 (*pfBusCurrent)()) {
+	memset(sI2CSched_devices, 0x00, sizeof(sI2CSched_devices));
+	memset(&sI2CSched_state, 0x00, sizeof(tsI2CSched_state));
+	sI2CSched_state.pfBusSelect  = pfBusSelect;
+	sI2CSched_state.pfBusCurrent = pfBusCurrent;
+	sI2CSched_state.u64StatsStart = u64TimerUtil_readUsec();
+}
+
+/*****************************************************************************
+ *
+ * NAME: iI2CSched_registDevice
+ *
+ * DESCRIPTION:デバイスの登録処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   char*          pcName          R   デバイス名（統計表示用）
+ *   uint8          u8Address       R   I2Cアドレス
+ *   uint8          u8Priority      R   優先度（I2C_SCHED_PRIORITY_*、0が最優先）
+ *   uint8          u8Bus           R   バス番号（I2C_SCHED_BUS_NONE：切替なし）
+ *
+ * RETURNS:
+ *   int            デバイスインデックス、登録出来ない場合は-1
+ *
+ * NOTES:
+ * 同じアドレスでもバスが異なる場合は別のデバイスとして登録する
+ *****************************************************************************/
+PUBLIC int iI2CSched_registDevice(const char* pcName, uint8 u8Address, uint8 u8Priority, uint8 u8Bus) {
+	if (sI2CSched_state.u8DevCnt >= I2C_SCHED_DEVICE_SIZE) {
+		return -1;
+	}
+	tsI2CSched_Device* psDev = &sI2CSched_devices[sI2CSched_state.u8DevCnt];
+	memset(psDev, 0x00, sizeof(tsI2CSched_Device));
+	psDev->pcName     = pcName;
+	psDev->u8Address  = u8Address;
+	psDev->u8Priority = u8Priority;
+	psDev->u8Bus      = u8Bus;
+	psDev->u8PreScaler = I2C_PRESCALER_DEFAULT;
+	return sI2CSched_state.u8DevCnt++;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2CSched_entry
+ *
+ * DESCRIPTION:要求の登録処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス
+ *   tsI2CSched_Req* psReq          RW  要求
+ *
+ * RETURNS:
+ *   TRUE:登録した
+ *
+ * NOTES:
+ * 完了時にはsTrns.eStatusに結果を設定し、sTrns.eCompEvtを登録する
+ *****************************************************************************/
+PUBLIC bool_t bI2CSched_entry(uint8 u8DevIdx, tsI2CSched_Req* psReq) {
+	if (u8DevIdx >= sI2CSched_state.u8DevCnt || psReq == NULL) {
+		return FALSE;
+	}
+	if (psReq->sTrns.eStatus == E_I2C_TRNS_STS_QUEUED || psReq->sTrns.eStatus == E_I2C_TRNS_STS_BUSY) {
+		return FALSE;
+	}
+	tsI2CSched_Device* psDev = &sI2CSched_devices[u8DevIdx];
+	// デバイスの要求キューに追加
+	psReq->sTrns.u8Address = psDev->u8Address;
+	psReq->sTrns.eStatus   = E_I2C_TRNS_STS_QUEUED;
+	psReq->u64EntryUsec    = u64TimerUtil_readUsec();
+	psReq->psNext          = NULL;
+	if (psDev->psTail == NULL) {
+		psDev->psHead = psReq;
+	} else {
+		psDev->psTail->psNext = psReq;
+	}
+	psDev->psTail = psReq;
+	psDev->sStats.u32ReqCnt++;
+	// 実行中で無ければ実行
+	vI2CSched_dispatch();
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CSched_exec
+ *
+ * DESCRIPTION:要求の実行処理（完了まで待機）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス
+ *   tsI2CSched_Req* psReq          RW  要求
+ *
+ * RETURNS:
+ *     I2CUTIL_STS_ACK (TRUE) ：正常終了
+ *     I2CUTIL_STS_NACK(FALSE)：NACK返信
+ *     I2CUTIL_STS_ERR (0xFF) ：通信エラー発生
+ *
+ * NOTES:
+ * 優先度の高い他の要求が先に実行される場合がある
+ *****************************************************************************/
+PUBLIC uint8 u8I2CSched_exec(uint8 u8DevIdx, tsI2CSched_Req* psReq) {
+	if (bI2CSched_entry(u8DevIdx, psReq) == FALSE) {
+		return I2CUTIL_STS_ERR;
+	}
+	while (psReq->sTrns.eStatus == E_I2C_TRNS_STS_QUEUED || psReq->sTrns.eStatus == E_I2C_TRNS_STS_BUSY) {
+		vI2C_waitIdle();
+	}
+	if (psReq->sTrns.eStatus == E_I2C_TRNS_STS_ACK) {
+		return I2CUTIL_STS_ACK;
+	}
+	if (psReq->sTrns.eStatus == E_I2C_TRNS_STS_NACK) {
+		return I2CUTIL_STS_NACK;
+	}
+	return I2CUTIL_STS_ERR;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CSched_editReq
+ *
+ * DESCRIPTION:要求の編集処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsI2CSched_Req* psReq          W   要求
+ *   uint8*         pu8WriteData    R   書き込みデータ
+ *   uint16         u16WriteLen     R   書き込みバイト数
+ *   uint8*         pu8ReadData     W   読み込み先データ領域
+ *   uint16         u16ReadLen      R   読み込みバイト数
+ *   uint8          u8MemAddrLen    R   書き込みデータのメモリアドレス長（0：結合しない）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 動作周波数はデバイス毎の設定、完了イベントとコールバックは無しで編集する
+ *****************************************************************************/
+PUBLIC void vI2CSched_editReq(tsI2CSched_Req* psReq, const uint8* pu8WriteData, uint16 u16WriteLen,
+		uint8* pu8ReadData, uint16 u16ReadLen, uint8 u8MemAddrLen) {
+	memset(psReq, 0x00, sizeof(tsI2CSched_Req));
+	psReq->sTrns.u8PreScaler  = I2C_PRESCALER_DEFAULT;
+	psReq->sTrns.pu8WriteData = pu8WriteData;
+	psReq->sTrns.u16WriteLen  = u16WriteLen;
+	psReq->sTrns.pu8ReadData  = pu8ReadData;
+	psReq->sTrns.u16ReadLen   = u16ReadLen;
+	psReq->sTrns.eCompEvt     = E_EVENT_FWK_EMPTY;
+	psReq->sTrns.pfCallback   = NULL;
+	psReq->sTrns.eStatus      = E_I2C_TRNS_STS_IDLE;
+	psReq->u8MemAddrLen       = u8MemAddrLen;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2CSched_isBusy
+ *
+ * DESCRIPTION:実行中判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   TRUE:実行中もしくは実行待ちの要求がある
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bI2CSched_isBusy() {
+	return sI2CSched_state.bBusy;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2CSched_setPreScaler
+ *
+ * DESCRIPTION:動作周波数の設定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス
+ *   uint8          u8PreScaler     R   動作周波数（I2C_PRESCALER_DEFAULT：バスの既定値）
+ *
+ * RETURNS:
+ *   TRUE:設定した
+ *
+ * NOTES:
+ * 以降に実行するトランザクションから適用する
+ *****************************************************************************/
+PUBLIC bool_t bI2CSched_setPreScaler(uint8 u8DevIdx, uint8 u8PreScaler) {
+	if (u8DevIdx >= sI2CSched_state.u8DevCnt) {
+		return FALSE;
+	}
+	sI2CSched_devices[u8DevIdx].u8PreScaler = u8PreScaler;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CSched_getPreScaler
+ *
+ * DESCRIPTION:動作周波数の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス
+ *
+ * RETURNS:
+ *   uint8          動作周波数、未登録の場合はI2C_PRESCALER_DEFAULT
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint8 u8I2CSched_getPreScaler(uint8 u8DevIdx) {
+	if (u8DevIdx >= sI2CSched_state.u8DevCnt) {
+		return I2C_PRESCALER_DEFAULT;
+	}
+	return sI2CSched_devices[u8DevIdx].u8PreScaler;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CSched_autotune
+ *
+ * DESCRIPTION:動作周波数の自動調整
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス
+ *   tsI2CSched_Req* psReq          RW  検証用の読み込み要求
+ *   uint8          u8SafePreScaler R   確実に通信可能な動作周波数
+ *
+ * RETURNS:
+ *   uint8          設定した動作周波数、調整出来ない場合はI2C_PRESCALER_DEFAULT
+ *
+ * NOTES:
+ * 確実に通信可能な周波数で読み込んだ内容を基準として、高速な周波数から順に
+ * 試行回数分の読み込みを行い、全て基準と一致した最速の周波数から
+ * I2C_SCHED_TUNE_MARGIN段階下げた周波数を設定する
+ * 検証用の読み込み要求は、内容が変化しない領域を読み込む事
+ * 調整出来ない場合は、デバイスの動作周波数を変更しない
+ *****************************************************************************/
+PUBLIC uint8 u8I2CSched_autotune(uint8 u8DevIdx, tsI2CSched_Req* psReq, uint8 u8SafePreScaler) {
+	if (u8DevIdx >= sI2CSched_state.u8DevCnt || psReq == NULL) {
+		return I2C_PRESCALER_DEFAULT;
+	}
+	uint16 u16Len = psReq->sTrns.u16ReadLen;
+	if (u16Len == 0 || u16Len > I2C_SCHED_TUNE_BUFF_SIZE) {
+		return I2C_PRESCALER_DEFAULT;
+	}
+	tsI2CSched_Device* psDev = &sI2CSched_devices[u8DevIdx];
+	uint8 u8BefPreScaler = psDev->u8PreScaler;
+	// 基準データの読み込み
+	uint8 u8RefData[I2C_SCHED_TUNE_BUFF_SIZE];
+	psDev->u8PreScaler = u8SafePreScaler;
+	if (u8I2CSched_exec(u8DevIdx, psReq) != I2CUTIL_STS_ACK) {
+		psDev->u8PreScaler = u8BefPreScaler;
+		return I2C_PRESCALER_DEFAULT;
+	}
+	memcpy(u8RefData, psReq->sTrns.pu8ReadData, u16Len);
+	// 高速な周波数から順に試行
+	uint8 u8TuneCnt = sizeof(I2C_SCHED_TUNE_PRESCALER);
+	uint8 u8TuneIdx;
+	uint8 u8Trial;
+	for (u8TuneIdx = 0; u8TuneIdx < u8TuneCnt; u8TuneIdx++) {
+		if (I2C_SCHED_TUNE_PRESCALER[u8TuneIdx] >= u8SafePreScaler) {
+			break;
+		}
+		psDev->u8PreScaler = I2C_SCHED_TUNE_PRESCALER[u8TuneIdx];
+		for (u8Trial = 0; u8Trial < I2C_SCHED_TUNE_TRIAL; u8Trial++) {
+			memset(psReq->sTrns.pu8ReadData, ~u8RefData[0], u16Len);
+			if (u8I2CSched_exec(u8DevIdx, psReq) != I2CUTIL_STS_ACK) {
+				break;
+			}
+			if (memcmp(psReq->sTrns.pu8ReadData, u8RefData, u16Len) != 0) {
+				break;
+			}
+		}
+		if (u8Trial >= I2C_SCHED_TUNE_TRIAL) {
+			break;
+		}
+	}
+	// 安定動作した周波数から余裕を持たせた周波数を設定
+	u8TuneIdx += I2C_SCHED_TUNE_MARGIN;
+	if (u8TuneIdx < u8TuneCnt && I2C_SCHED_TUNE_PRESCALER[u8TuneIdx] < u8SafePreScaler) {
+		psDev->u8PreScaler = I2C_SCHED_TUNE_PRESCALER[u8TuneIdx];
+	} else {
+		psDev->u8PreScaler = u8SafePreScaler;
+	}
+	return psDev->u8PreScaler;
+}
+
+/*****************************************************************************
+ *
+ * NAME: pcI2CSched_getName
+ *
+ * DESCRIPTION:デバイス名の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス
+ *
+ * RETURNS:
+ *   const char*    デバイス名、未登録の場合はNULL
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC const char* pcI2CSched_getName(uint8 u8DevIdx) {
+	if (u8DevIdx >= sI2CSched_state.u8DevCnt) {
+		return NULL;
+	}
+	return sI2CSched_devices[u8DevIdx].pcName;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psI2CSched_getStats
+ *
+ * DESCRIPTION:統計情報の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8DevIdx        R   デバイスインデックス
+ *
+ * RETURNS:
+ *   tsI2CSched_Stats* 統計情報、未登録の場合はNULL
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC const tsI2CSched_Stats* psI2CSched_getStats(uint8 u8DevIdx) {
+	if (u8DevIdx >= sI2CSched_state.u8DevCnt) {
+		return NULL;
+	}
+	return &sI2CSched_devices[u8DevIdx].sStats;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u16I2CSched_getUtilization
+ *
+ * DESCRIPTION:バス使用率の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint16         統計情報の集計開始からのバス使用率（1/1000単位）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint16 u16I2CSched_getUtilization() {
+	uint64 u64Elapsed = u64TimerUtil_readUsec() - sI2CSched_state.u64StatsStart;
+	uint64 u64Busy = 0;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < sI2CSched_state.u8DevCnt; u8Idx++) {
+		u64Busy += sI2CSched_devices[u8Idx].sStats.u32BusyUsec;
+	}
+	if (u64Elapsed == 0) {
+		return 0;
+	}
+	return (uint16)(u64Busy * 1000 / u64Elapsed);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CSched_resetStats
+ *
+ * DESCRIPTION:統計情報の初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vI2CSched_resetStats() {
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < sI2CSched_state.u8DevCnt; u8Idx++) {
+		memset(&sI2CSched_devices[u8Idx].sStats, 0x00, sizeof(tsI2CSched_Stats));
+	}
+	sI2CSched_state.u64StatsStart = u64TimerUtil_readUsec();
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vI2CSched_dispatch
+ *
+ * DESCRIPTION:次の要求の実行
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 優先度が最も高いデバイスの先頭の要求を実行する
+ * 同じ優先度のデバイスは、前回実行したデバイスの次から順に選択する
+ *****************************************************************************/
+PRIVATE void vI2CSched_dispatch() {
+	if (sI2CSched_state.bBusy) {
+		return;
+	}
+	// 実行するデバイスの選択
+	tsI2CSched_Device* psDev;
+	tsI2CSched_Device* psSelDev = NULL;
+	uint8 u8SelIdx = 0;
+	uint8 u8Cnt;
+	uint8 u8Idx = sI2CSched_state.u8LastDevIdx;
+	for (u8Cnt = 0; u8Cnt < sI2CSched_state.u8DevCnt; u8Cnt++) {
+		u8Idx = (u8Idx + 1) % sI2CSched_state.u8DevCnt;
+		psDev = &sI2CSched_devices[u8Idx];
+		if (psDev->psHead == NULL) {
+			continue;
+		}
+		if (psSelDev == NULL || psDev->u8Priority < psSelDev->u8Priority) {
+			psSelDev = psDev;
+			u8SelIdx = u8Idx;
+		}
+	}
+	if (psSelDev == NULL) {
+		return;
+	}
+	// 結合可能な要求数の判定
+	tsI2CSched_Req* psReq = psSelDev->psHead;
+	uint16 u16ReadLen;
+	uint8 u8ReqCnt = u8I2CSched_mergeCnt(psReq, &u16ReadLen);
+	// 待ち時間の集計
+	uint64 u64Now = u64TimerUtil_readUsec();
+	uint32 u32Wait;
+	tsI2CSched_Req* psWk = psReq;
+	for (u8Cnt = 0; u8Cnt < u8ReqCnt; u8Cnt++) {
+		u32Wait = (uint32)(u64Now - psWk->u64EntryUsec);
+		psSelDev->sStats.u32WaitUsec += u32Wait;
+		if (u32Wait > psSelDev->sStats.u32MaxWaitUsec) {
+			psSelDev->sStats.u32MaxWaitUsec = u32Wait;
+		}
+		psWk->sTrns.eStatus = E_I2C_TRNS_STS_BUSY;
+		psWk = psWk->psNext;
+	}
+	psSelDev->sStats.u32TrnsCnt++;
+	psSelDev->sStats.u32MergeCnt += u8ReqCnt - 1;
+	// トランザクションの編集（結合時は結合バッファに読み込む）
+	tsI2C_Trns* psTrns = &sI2CSched_state.sTrns;
+	memcpy(psTrns, &psReq->sTrns, sizeof(tsI2C_Trns));
+	psTrns->u8PreScaler = psSelDev->u8PreScaler;
+	psTrns->eCompEvt   = E_EVENT_FWK_EMPTY;
+	psTrns->pfCallback = vI2CSched_complete;
+	psTrns->eStatus    = E_I2C_TRNS_STS_IDLE;
+	psTrns->psNext     = NULL;
+	if (u8ReqCnt > 1) {
+		psTrns->pu8ReadData = sI2CSched_state.u8MergeBuff;
+		psTrns->u16ReadLen  = u16ReadLen;
+	}
+	sI2CSched_state.bBusy        = TRUE;
+	sI2CSched_state.u8LastDevIdx = u8SelIdx;
+	sI2CSched_state.u8ExecDevIdx = u8SelIdx;
+	sI2CSched_state.u8ExecReqCnt = u8ReqCnt;
+	// バス切替
+	if (sI2CSched_state.pfBusSelect != NULL && sI2CSched_state.pfBusCurrent != NULL
+			&& psSelDev->u8Bus != I2C_SCHED_BUS_NONE) {
+		sI2CSched_state.u8SavedBus = (*sI2CSched_state.pfBusCurrent)();
+		if (sI2CSched_state.u8SavedBus != psSelDev->u8Bus) {
+			(*sI2CSched_state.pfBusSelect)(psSelDev->u8Bus);
+		}
+	} else {
+		sI2CSched_state.u8SavedBus = I2C_SCHED_BUS_NONE;
+	}
+	// 実行
+	sI2CSched_state.u64ExecStart = u64TimerUtil_readUsec();
+	if (bI2C_entryTrns(psTrns) == FALSE) {
+		psTrns->eStatus = E_I2C_TRNS_STS_ERR;
+		vI2CSched_complete(psTrns);
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CSched_mergeCnt
+ *
+ * DESCRIPTION:結合可能な要求数の判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsI2CSched_Req* psReq          R   先頭の要求
+ *   uint16*        pu16ReadLen     W   結合後の読み込みバイト数
+ *
+ * RETURNS:
+ *   uint8          結合する要求数（先頭の要求を含む）
+ *
+ * NOTES:
+ * 書き込みデータがメモリアドレスのみの読み込み要求で、
+ * 前の要求の読み込み範囲の直後を読み込む要求を結合する
+ *****************************************************************************/
+PRIVATE uint8 u8I2CSched_mergeCnt(tsI2CSched_Req* psReq, uint16* pu16ReadLen) {
+	uint8 u8Cnt = 1;
+	*pu16ReadLen = psReq->sTrns.u16ReadLen;
+	if (psReq->u8MemAddrLen == 0 || psReq->sTrns.u16WriteLen != psReq->u8MemAddrLen
+			|| psReq->sTrns.u16ReadLen == 0) {
+		return u8Cnt;
+	}
+	uint16 u16NextAddr = u16I2CSched_memAddr(psReq) + psReq->sTrns.u16ReadLen;
+	tsI2CSched_Req* psNext = psReq->psNext;
+	while (psNext != NULL && u8Cnt < 0xFF) {
+		if (psNext->u8MemAddrLen != psReq->u8MemAddrLen
+				|| psNext->sTrns.u16WriteLen != psNext->u8MemAddrLen
+				|| psNext->sTrns.u16ReadLen == 0
+				|| u16I2CSched_memAddr(psNext) != u16NextAddr
+				|| *pu16ReadLen + psNext->sTrns.u16ReadLen > I2C_SCHED_MERGE_BUFF_SIZE) {
+			break;
+		}
+		*pu16ReadLen += psNext->sTrns.u16ReadLen;
+		u16NextAddr  += psNext->sTrns.u16ReadLen;
+		psNext = psNext->psNext;
+		u8Cnt++;
+	}
+	// 結合しない場合は結合バッファのサイズに関係無く実行
+	if (u8Cnt == 1) {
+		*pu16ReadLen = psReq->sTrns.u16ReadLen;
+	}
+	return u8Cnt;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u16I2CSched_memAddr
+ *
+ * DESCRIPTION:メモリアドレスの取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsI2CSched_Req* psReq          R   要求
+ *
+ * RETURNS:
+ *   uint16         書き込みデータ先頭のメモリアドレス（ビッグエンディアン）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint16 u16I2CSched_memAddr(tsI2CSched_Req* psReq) {
+	const uint8* pu8Addr = psReq->sTrns.pu8WriteData;
+	if (psReq->u8MemAddrLen == 1) {
+		return pu8Addr[0];
+	}
+	return ((uint16)pu8Addr[0] << 8) | pu8Addr[1];
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CSched_complete
+ *
+ * DESCRIPTION:トランザクション完了時の処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsI2C_Trns*    psTrns          R   完了したトランザクション
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * タスクコンテキストで実行される
+ *****************************************************************************/
+PRIVATE void vI2CSched_complete(tsI2C_Trns* psTrns) {
+	tsI2CSched_Device* psDev = &sI2CSched_devices[sI2CSched_state.u8ExecDevIdx];
+	// バス占有時間の集計
+	psDev->sStats.u32BusyUsec += (uint32)(u64TimerUtil_readUsec() - sI2CSched_state.u64ExecStart);
+	if (psTrns->eStatus != E_I2C_TRNS_STS_ACK) {
+		psDev->sStats.u32ErrCnt++;
+	}
+	// バスを元に戻す
+	if (sI2CSched_state.u8SavedBus != I2C_SCHED_BUS_NONE
+			&& sI2CSched_state.u8SavedBus != psDev->u8Bus) {
+		(*sI2CSched_state.pfBusSelect)(sI2CSched_state.u8SavedBus);
+	}
+	// 要求毎の結果通知（結合時は結合バッファから分配）
+	tsI2CSched_Req* psReq;
+	uint16 u16Offset = 0;
+	uint8 u8Cnt;
+	for (u8Cnt = 0; u8Cnt < sI2CSched_state.u8ExecReqCnt; u8Cnt++) {
+		psReq = psDev->psHead;
+		psDev->psHead = psReq->psNext;
+		if (psDev->psHead == NULL) {
+			psDev->psTail = NULL;
+		}
+		psReq->psNext = NULL;
+		if (sI2CSched_state.u8ExecReqCnt > 1 && psTrns->eStatus == E_I2C_TRNS_STS_ACK) {
+			memcpy(psReq->sTrns.pu8ReadData, &sI2CSched_state.u8MergeBuff[u16Offset], psReq->sTrns.u16ReadLen);
+		}
+		u16Offset += psReq->sTrns.u16ReadLen;
+		psReq->sTrns.eStatus = psTrns->eStatus;
+		if (psReq->sTrns.pfCallback != NULL) {
+			(*psReq->sTrns.pfCallback)(&psReq->sTrns);
+		}
+		if (psReq->sTrns.eCompEvt != E_EVENT_FWK_EMPTY) {
+			iEntrySeqEvt(psReq->sTrns.eCompEvt);
+		}
+	}
+	// 次の要求を実行
+	sI2CSched_state.bBusy = FALSE;
+	vI2CSched_dispatch();
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
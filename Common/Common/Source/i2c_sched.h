@@ -0,0 +1,164 @@
+/****************************************************************************
+ *
+ * MODULE :I2C Scheduler functions header file
+ *
+ * CREATED:2026/10/18 20:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   I2Cバスを共有するデバイス毎の要求キューと実行順序の制御を行う関数群
+ *   I2C Scheduler functions (header file)
+ *
+ * CHANGE HISTORY:
+ * 2026/10/18 21:00:00 デバイス毎の動作周波数と自動調整処理を追加
+ * 2026/10/19 17:00:00 未登録のデバイスインデックスと要求の編集処理を追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  I2CSCHED_H_INCLUDED
+#define  I2CSCHED_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include "i2c_util.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 登録可能なデバイス数
+#ifndef I2C_SCHED_DEVICE_SIZE
+	#define I2C_SCHED_DEVICE_SIZE    (8)
+#endif
+
+// 読み込み要求の結合バッファサイズ
+#ifndef I2C_SCHED_MERGE_BUFF_SIZE
+	#define I2C_SCHED_MERGE_BUFF_SIZE  (64)
+#endif
+
+// 優先度：最優先（認証情報の読み書き等）
+#define I2C_SCHED_PRIORITY_HIGH    (0)
+// 優先度：通常
+#define I2C_SCHED_PRIORITY_NORMAL  (1)
+// 優先度：低（画面表示等）
+#define I2C_SCHED_PRIORITY_LOW     (2)
+
+// バス番号：バス切替なし
+#define I2C_SCHED_BUS_NONE         (0)
+
+// デバイスインデックス：未登録（スケジューラを経由せずに直接通信）
+#define I2C_SCHED_DEVICE_NONE      (0xFF)
+
+// 動作周波数の自動調整：読み込みバッファサイズ
+#ifndef I2C_SCHED_TUNE_BUFF_SIZE
+	#define I2C_SCHED_TUNE_BUFF_SIZE   (16)
+#endif
+// 動作周波数の自動調整：周波数毎の試行回数
+#ifndef I2C_SCHED_TUNE_TRIAL
+	#define I2C_SCHED_TUNE_TRIAL       (8)
+#endif
+// 動作周波数の自動調整：安定動作した最速の周波数から下げる段階数
+#ifndef I2C_SCHED_TUNE_MARGIN
+	#define I2C_SCHED_TUNE_MARGIN      (1)
+#endif
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：デバイス毎の統計情報
+typedef struct {
+	// 要求件数
+	uint32 u32ReqCnt;
+	// 実行したトランザクション数（結合後）
+	uint32 u32TrnsCnt;
+	// 他の要求に結合した要求件数
+	uint32 u32MergeCnt;
+	// エラー件数（NACK含む）
+	uint32 u32ErrCnt;
+	// バス占有時間の合計（マイクロ秒）
+	uint32 u32BusyUsec;
+	// 待ち時間の合計（マイクロ秒）
+	uint32 u32WaitUsec;
+	// 最大待ち時間（マイクロ秒）
+	uint32 u32MaxWaitUsec;
+} tsI2CSched_Stats;
+
+// 構造体：スケジューラへの要求
+// 要求内容と結果、完了イベントはsTrnsを使用する（u8Addressはデバイスのアドレスで上書き）
+// 完了するまでは、呼び出し元で構造体とデータ領域を保持する事
+typedef struct tsI2CSched_ReqTag {
+	// トランザクション
+	tsI2C_Trns sTrns;
+	// 書き込みデータのメモリアドレス長（1～2：アドレスが連続する読み込み要求を結合、0：結合しない）
+	uint8 u8MemAddrLen;
+	// 登録時刻（スケジューラ内部で使用）
+	uint64 u64EntryUsec;
+	// 次の要求（スケジューラ内部で使用）
+	struct tsI2CSched_ReqTag* psNext;
+} tsI2CSched_Req;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+// 初期化処理（バス切替が無い場合はNULLを指定）
+PUBLIC void vI2CSched_init(void (*pfBusSelect)(uint8 u8Bus), uint8 (*pfBusCurrent)());
+// デバイスの登録処理
+PUBLIC int iI2CSched_registDevice(const char* pcName, uint8 u8Address, uint8 u8Priority, uint8 u8Bus);
+// 要求の登録処理
+PUBLIC bool_t bI2CSched_entry(uint8 u8DevIdx, tsI2CSched_Req* psReq);
+// 要求の実行処理（完了まで待機）
+PUBLIC uint8 u8I2CSched_exec(uint8 u8DevIdx, tsI2CSched_Req* psReq);
+// 要求の編集処理
+PUBLIC void vI2CSched_editReq(tsI2CSched_Req* psReq, const uint8* pu8WriteData, uint16 u16WriteLen,
+		uint8* pu8ReadData, uint16 u16ReadLen, uint8 u8MemAddrLen);
+// 実行中判定
+PUBLIC bool_t bI2CSched_isBusy();
+// 動作周波数の設定
+PUBLIC bool_t bI2CSched_setPreScaler(uint8 u8DevIdx, uint8 u8PreScaler);
+// 動作周波数の参照
+PUBLIC uint8 u8I2CSched_getPreScaler(uint8 u8DevIdx);
+// 動作周波数の自動調整
+PUBLIC uint8 u8I2CSched_autotune(uint8 u8DevIdx, tsI2CSched_Req* psReq, uint8 u8SafePreScaler);
+// デバイス名の参照
+PUBLIC const char* pcI2CSched_getName(uint8 u8DevIdx);
+// 統計情報の参照
+PUBLIC const tsI2CSched_Stats* psI2CSched_getStats(uint8 u8DevIdx);
+// バス使用率の参照（1/1000単位）
+PUBLIC uint16 u16I2CSched_getUtilization();
+// 統計情報の初期化
+PUBLIC void vI2CSched_resetStats();
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* I2CSCHED_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -10,6 +10,10 @@
  *   I2C Utility functions (source file)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 19:00:00 割り込み駆動の非同期トランザクション処理を追加
+ * 2026/10/18 20:00:00 トランザクション完了時のコールバックと完了待ち処理を追加
+ * 2026/10/18 21:00:00 トランザクション毎の動作周波数指定と既定値の変更処理を追加
+ * 2026/10/18 22:00:00 I2C_USE_RECORDER定義時に通信内容を記録する処理を追加
  *
  * LAST MODIFIED BY:
  *
@@ -26,6 +30,9 @@
 
 #include "i2c_util.h"
 #include "timer_util.h"
+#ifdef I2C_USE_RECORDER
+#include "i2c_recorder.h"
+#endif
 
 /****************************************************************************/
 /***        Macro Definitions                                             ***/
@@ -33,15 +40,47 @@
 // I2C Acceess Interval
 #define I2C_INTERVAL               (100)
 
+// 通信内容の記録（I2C_USE_RECORDERを定義した場合のみ）
+#ifdef I2C_USE_RECORDER
+	#define I2C_RECORD(eType, u8Data, u8Result) \
+		vI2CRec_append((uint32)u64TimerUtil_readUsec(), eType, sI2C_state.u8RecAddress, u8Data, u8Result)
+#else
+	#define I2C_RECORD(eType, u8Data, u8Result)
+#endif
+
 /****************************************************************************/
 /***        Type Definitions                                              ***/
 /****************************************************************************/
+/**
+ * 非同期トランザクションの処理段階
+ */
+typedef enum {
+	E_I2C_PHASE_ADDR_W = 0,	// アドレス送信（書き込み）
+	E_I2C_PHASE_WRITE,		// データ送信
+	E_I2C_PHASE_ADDR_R,		// アドレス送信（読み込み）
+	E_I2C_PHASE_READ,		// データ受信
+	E_I2C_PHASE_STOP		// 停止条件送信
+} teI2C_Phase;
+
 /**
  * I2Cバス情報
  */
 typedef struct {
-	uint8 u8PreScaler;		// 動作周波数
+	uint8 u8PreScaler;		// 動作周波数（既定値）
+	uint8 u8CurPreScaler;	// 動作周波数（設定中）
 	uint64 u64LastStart;	// 最終アクセス時刻
+	bool_t bAsyncEnable;	// 非同期処理の有効化
+	bool_t bIntEnable;		// 割り込み有効
+	tsI2C_Trns* psHead;		// トランザクションキュー：先頭（実行中）
+	tsI2C_Trns* psTail;		// トランザクションキュー：末尾
+	volatile bool_t bCompleted;	// 先頭トランザクションの完了（後処理待ち）
+	teI2C_Phase ePhase;		// 処理段階
+	uint16 u16Idx;			// 送受信済みバイト数
+	bool_t bStopSent;		// 停止条件送信済み
+	teI2C_TrnsStatus eResult;	// 停止条件送信後の結果
+#ifdef I2C_USE_RECORDER
+	uint8 u8RecAddress;		// 通信中のI2Cアドレス（記録用）
+#endif
 } tsI2C_state;
 
 /****************************************************************************/
@@ -112,6 +151,43 @@ PRIVATE const bool_t I2C_STOP_NACK[] = {
 		E_AHI_SI_SEND_NACK, E_AHI_SI_NO_IRQ_ACK				// ACK/NACKとタイプ
 };
 
+// 非同期通信設定：書き込み開始
+PRIVATE const bool_t I2C_ASYNC_START_WRITE[] = {
+		E_AHI_SI_START_BIT, E_AHI_SI_NO_STOP_BIT,			// 開始終了
+		E_AHI_SI_NO_SLAVE_READ, E_AHI_SI_SLAVE_WRITE,		// 読み書き
+		E_AHI_SI_SEND_ACK, E_AHI_SI_IRQ_ACK					// ACK/NACKとタイプ
+};
+// 非同期通信設定：書き込み
+PRIVATE const bool_t I2C_ASYNC_WRITE[] = {
+		E_AHI_SI_NO_START_BIT, E_AHI_SI_NO_STOP_BIT,		// 開始終了
+		E_AHI_SI_NO_SLAVE_READ, E_AHI_SI_SLAVE_WRITE,		// 読み書き
+		E_AHI_SI_SEND_ACK, E_AHI_SI_IRQ_ACK					// ACK/NACKとタイプ
+};
+// 非同期通信設定：書き込み停止
+PRIVATE const bool_t I2C_ASYNC_WRITE_STOP[] = {
+		E_AHI_SI_NO_START_BIT, E_AHI_SI_STOP_BIT,			// 開始終了
+		E_AHI_SI_NO_SLAVE_READ, E_AHI_SI_SLAVE_WRITE,		// 読み書き
+		E_AHI_SI_SEND_ACK, E_AHI_SI_IRQ_ACK					// ACK/NACKとタイプ
+};
+// 非同期通信設定：読み込みACK返信
+PRIVATE const bool_t I2C_ASYNC_READ_ACK[] = {
+		E_AHI_SI_NO_START_BIT, E_AHI_SI_NO_STOP_BIT,		// 開始終了
+		E_AHI_SI_SLAVE_READ, E_AHI_SI_NO_SLAVE_WRITE,		// 読み書き
+		E_AHI_SI_SEND_ACK, E_AHI_SI_IRQ_ACK					// ACK/NACKとタイプ
+};
+// 非同期通信設定：読み込みNACK返信、停止
+PRIVATE const bool_t I2C_ASYNC_READ_NACK_STOP[] = {
+		E_AHI_SI_NO_START_BIT, E_AHI_SI_STOP_BIT,			// 開始終了
+		E_AHI_SI_SLAVE_READ, E_AHI_SI_NO_SLAVE_WRITE,		// 読み書き
+		E_AHI_SI_SEND_NACK, E_AHI_SI_IRQ_ACK				// ACK/NACKとタイプ
+};
+// 非同期通信設定：停止
+PRIVATE const bool_t I2C_ASYNC_STOP[] = {
+		E_AHI_SI_NO_START_BIT, E_AHI_SI_STOP_BIT,			// 開始終了
+		E_AHI_SI_NO_SLAVE_READ, E_AHI_SI_NO_SLAVE_WRITE,	// 読み書き
+		E_AHI_SI_SEND_NACK, E_AHI_SI_IRQ_ACK				// ACK/NACKとタイプ
+};
+
 // I2Cバス情報
 PRIVATE tsI2C_state sI2C_state;
 
@@ -122,6 +198,24 @@ PRIVATE tsI2C_state sI2C_state;
 PRIVATE void vI2C_intervalWait();
 // 送受信確定
 PRIVATE bool_t bI2C_transmit(const bool_t* pbPrms);
+// 通信間隔の待機
+PRIVATE void vI2C_waitInterval();
+// 非同期処理：トランザクションキューの進行
+PRIVATE void vI2C_asyncProceed();
+// 非同期処理：トランザクション開始
+PRIVATE void vI2C_asyncStart(tsI2C_Trns* psTrns);
+// 非同期処理：コマンド発行
+PRIVATE bool_t bI2C_asyncCmd(const bool_t* pbPrms);
+// 非同期処理：データ送信もしくは読み込み開始
+PRIVATE uint8 u8I2C_asyncNextWrite(tsI2C_Trns* psTrns);
+// 非同期処理：停止条件を送信して終了
+PRIVATE uint8 u8I2C_asyncStop(teI2C_TrnsStatus eResult);
+// 非同期処理：トランザクション完了
+PRIVATE uint8 u8I2C_asyncFinish(teI2C_TrnsStatus eResult);
+// 割り込み処理：SI
+PRIVATE uint8 u8I2C_asyncIntTask(uint32 u32DeviceId, uint32 u32ItemBitmap);
+// ハードウェアイベント処理：SI
+PRIVATE void vI2C_asyncEvtTask(uint32 u32DeviceId, uint32 u32ItemBitmap);
 
 /****************************************************************************/
 /***        Exported Functions                                            ***/
@@ -143,9 +237,16 @@ PRIVATE bool_t bI2C_transmit(const bool_t* pbPrms);
  *****************************************************************************/
 PUBLIC void vI2C_init(uint8 u8PreScaler) {
 	// バス駆動周波数設定
-	sI2C_state.u8PreScaler  = u8PreScaler;
+	sI2C_state.u8PreScaler    = u8PreScaler;
+	sI2C_state.u8CurPreScaler = u8PreScaler;
 	// 最終アクセス開始時刻
 	sI2C_state.u64LastStart = u64TimerUtil_readUsec();
+	// 非同期処理は無効
+	sI2C_state.bAsyncEnable = FALSE;
+	sI2C_state.bIntEnable   = FALSE;
+	sI2C_state.psHead       = NULL;
+	sI2C_state.psTail       = NULL;
+	sI2C_state.bCompleted   = FALSE;
 	// マスターとしてI2C接続設定
 	// 割り込み無し
 	// 16/[(PreScaler + 1) x 5]MHz
@@ -175,7 +276,12 @@ PUBLIC bool_t bI2C_startRead(uint8 u8Address) {
 	// 通信相手のスレーブ選択
 	vAHI_SiMasterWriteSlaveAddr(u8Address, TRUE);
 	// I2Cバスの通信処理：受信対象アドレス送信し、読み込みを開始する
-	return bI2C_transmit(I2C_START_WRITE_ACK);
+	bool_t bResult = bI2C_transmit(I2C_START_WRITE_ACK);
+#ifdef I2C_USE_RECORDER
+	sI2C_state.u8RecAddress = u8Address;
+#endif
+	I2C_RECORD(E_I2C_REC_START_R, 0, bResult ? I2CUTIL_STS_ACK : I2CUTIL_STS_ERR);
+	return bResult;
 }
 
 /*****************************************************************************
@@ -200,7 +306,12 @@ PUBLIC bool_t bI2C_startWrite(uint8 u8Address) {
 	// 送信先のスレーブアドレス指定
 	vAHI_SiMasterWriteSlaveAddr(u8Address, FALSE);
 	// I2Cバスの通信処理：送信開始通知
-	return bI2C_transmit(I2C_START_WRITE_ACK);
+	bool_t bResult = bI2C_transmit(I2C_START_WRITE_ACK);
+#ifdef I2C_USE_RECORDER
+	sI2C_state.u8RecAddress = u8Address;
+#endif
+	I2C_RECORD(E_I2C_REC_START_W, 0, bResult ? I2CUTIL_STS_ACK : I2CUTIL_STS_ERR);
+	return bResult;
 }
 
 /*****************************************************************************
@@ -230,6 +341,7 @@ PUBLIC bool_t bI2C_read(uint8* pu8Data, uint8 u8Length, bool_t bAckEndFlg) {
 		if(!bI2C_transmit(I2C_CONT_READ_ACK)) return FALSE;
 		// データの読み込み
 		pu8Data[idx] = u8AHI_SiMasterReadData8();
+		I2C_RECORD(E_I2C_REC_READ, pu8Data[idx], I2CUTIL_STS_ACK);
 	}
 	if (bAckEndFlg) {
 		// I2Cバスの通信処理：受信通知（ACK返信）
@@ -240,6 +352,7 @@ PUBLIC bool_t bI2C_read(uint8* pu8Data, uint8 u8Length, bool_t bAckEndFlg) {
 	}
 	// 最終データの読み込み
 	pu8Data[idx] = u8AHI_SiMasterReadData8();
+	I2C_RECORD(E_I2C_REC_READ, pu8Data[idx], I2CUTIL_STS_ACK);
 	return TRUE;
 }
 
@@ -264,8 +377,13 @@ PUBLIC uint8 u8I2C_write(uint8 u8Data) {
 	// データの送信
 	vAHI_SiMasterWriteData8(u8Data);
 	// I2Cバスの通信処理：送信通知
-	if (!bI2C_transmit(I2C_CONT_WRITE_ACK)) return I2CUTIL_STS_ERR;
-	return (bAHI_SiMasterCheckRxNack() == FALSE);
+	if (!bI2C_transmit(I2C_CONT_WRITE_ACK)) {
+		I2C_RECORD(E_I2C_REC_WRITE, u8Data, I2CUTIL_STS_ERR);
+		return I2CUTIL_STS_ERR;
+	}
+	uint8 u8Result = (bAHI_SiMasterCheckRxNack() == FALSE);
+	I2C_RECORD(E_I2C_REC_WRITE, u8Data, u8Result);
+	return u8Result;
 }
 
 /*****************************************************************************
@@ -289,8 +407,15 @@ PUBLIC uint8 u8I2C_writeStop(uint8 u8Data) {
 	// データの送信
 	vAHI_SiMasterWriteData8(u8Data);
 	// I2Cバスの通信処理：送信通知
-	if (!bI2C_transmit(I2C_STOP_ACK)) return I2CUTIL_STS_ERR;
-	return (bAHI_SiMasterCheckRxNack() == FALSE);
+	if (!bI2C_transmit(I2C_STOP_ACK)) {
+		I2C_RECORD(E_I2C_REC_WRITE, u8Data, I2CUTIL_STS_ERR);
+		I2C_RECORD(E_I2C_REC_STOP, 0, I2CUTIL_STS_ERR);
+		return I2CUTIL_STS_ERR;
+	}
+	uint8 u8Result = (bAHI_SiMasterCheckRxNack() == FALSE);
+	I2C_RECORD(E_I2C_REC_WRITE, u8Data, u8Result);
+	I2C_RECORD(E_I2C_REC_STOP, 0, I2CUTIL_STS_ACK);
+	return u8Result;
 }
 
 /*****************************************************************************
@@ -310,7 +435,9 @@ PUBLIC uint8 u8I2C_writeStop(uint8 u8Data) {
  *****************************************************************************/
 PUBLIC bool_t bI2C_stopACK() {
 	// I2Cバスの通信処理：読み書き完了通知
-	return bI2C_transmit(I2C_STOP_ACK);
+	bool_t bResult = bI2C_transmit(I2C_STOP_ACK);
+	I2C_RECORD(E_I2C_REC_STOP, 0, bResult ? I2CUTIL_STS_ACK : I2CUTIL_STS_ERR);
+	return bResult;
 }
 
 /*****************************************************************************
@@ -330,7 +457,9 @@ PUBLIC bool_t bI2C_stopACK() {
  *****************************************************************************/
 PUBLIC bool_t bI2C_stopNACK() {
 	// I2Cバスの通信処理：読み書き完了通知
-	return bI2C_transmit(I2C_STOP_NACK);
+	bool_t bResult = bI2C_transmit(I2C_STOP_NACK);
+	I2C_RECORD(E_I2C_REC_STOP, 0, bResult ? I2CUTIL_STS_ACK : I2CUTIL_STS_ERR);
+	return bResult;
 }
 
 /*****************************************************************************
@@ -349,7 +478,186 @@ PUBLIC bool_t bI2C_stopNACK() {
  *****************************************************************************/
 PUBLIC uint32 u32I2C_getFrequency() {
 	// バス駆動周波数設定
-	return 3200000 / (sI2C_state.u8PreScaler + 1);
+	return u32I2C_toFrequency(sI2C_state.u8PreScaler);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_setPreScaler
+ *
+ * DESCRIPTION:バス駆動周波数の既定値変更
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            u8PreScaler   R   動作周波数 = 16/[(u8PreScaler + 1) x 5] MHz
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 実行中の非同期トランザクションの完了を待ってから変更する
+ *****************************************************************************/
+PUBLIC void vI2C_setPreScaler(uint8 u8PreScaler) {
+	// 非同期トランザクションの完了待ち（完了後は既定値で割り込み無し）
+	vI2C_waitIdle();
+	sI2C_state.u8PreScaler = u8PreScaler;
+	if (sI2C_state.u8CurPreScaler != u8PreScaler) {
+		vAHI_SiMasterConfigure(TRUE, FALSE, u8PreScaler);
+		sI2C_state.u8CurPreScaler = u8PreScaler;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32I2C_toFrequency
+ *
+ * DESCRIPTION:動作周波数からバス駆動周波数への変換
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            u8PreScaler   R   動作周波数
+ *
+ * RETURNS:
+ *     uint32：駆動周波数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC uint32 u32I2C_toFrequency(uint8 u8PreScaler) {
+	return 3200000 / (u8PreScaler + 1);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_initAsync
+ *
+ * DESCRIPTION:非同期処理の初期化処理
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * vI2C_initの後に呼び出す事
+ * SI割り込みはトランザクション実行中のみ有効にするので、
+ * キューが空の間は従来の同期処理をそのまま使用出来る
+ *****************************************************************************/
+PUBLIC void vI2C_initAsync() {
+	// キューの初期化
+	sI2C_state.psHead     = NULL;
+	sI2C_state.psTail     = NULL;
+	sI2C_state.bCompleted = FALSE;
+	// 割り込み処理と完了後の後処理を登録
+	vRegisterHwIntTask(E_AHI_DEVICE_SI, u8I2C_asyncIntTask);
+	bRegisterHwEvtTask(E_AHI_DEVICE_SI, vI2C_asyncEvtTask);
+	sI2C_state.bAsyncEnable = TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_entryTrns
+ *
+ * DESCRIPTION:非同期トランザクションの登録処理
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            psTrns        RW  トランザクション
+ *
+ * RETURNS:
+ *     TRUE ：登録した
+ *     FALSE：非同期処理が無効、もしくは登録済み
+ *
+ * NOTES:
+ * 完了時にはeStatusに結果を設定し、eCompEvtを順次実行イベントとして登録する
+ *****************************************************************************/
+PUBLIC bool_t bI2C_entryTrns(tsI2C_Trns* psTrns) {
+	if (sI2C_state.bAsyncEnable == FALSE || psTrns == NULL) {
+		return FALSE;
+	}
+	if (psTrns->eStatus == E_I2C_TRNS_STS_QUEUED || psTrns->eStatus == E_I2C_TRNS_STS_BUSY) {
+		return FALSE;
+	}
+	// キューの末尾に追加
+	psTrns->eStatus = E_I2C_TRNS_STS_QUEUED;
+	psTrns->psNext  = NULL;
+	if (sI2C_state.psTail == NULL) {
+		sI2C_state.psHead = psTrns;
+	} else {
+		sI2C_state.psTail->psNext = psTrns;
+	}
+	sI2C_state.psTail = psTrns;
+	// 実行中のトランザクションが無ければ開始
+	vI2C_asyncProceed();
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_isBusy
+ *
+ * DESCRIPTION:非同期トランザクションの実行中判定
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *     TRUE ：実行中もしくは実行待ちのトランザクションがある
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bI2C_isBusy() {
+	return (sI2C_state.psHead != NULL);
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_execTrns
+ *
+ * DESCRIPTION:トランザクションの実行処理（完了まで待機）
+ *
+ * PARAMETERS:Name          RW  Usage
+ *            psTrns        RW  トランザクション
+ *
+ * RETURNS:
+ *     I2CUTIL_STS_ACK (TRUE) ：正常終了
+ *     I2CUTIL_STS_NACK(FALSE)：NACK返信
+ *     I2CUTIL_STS_ERR (0xFF) ：通信エラー発生
+ *
+ * NOTES:
+ * 非同期処理の同期版ラッパー、先行するトランザクションの完了も待つ
+ *****************************************************************************/
+PUBLIC uint8 u8I2C_execTrns(tsI2C_Trns* psTrns) {
+	if (bI2C_entryTrns(psTrns) == FALSE) {
+		return I2CUTIL_STS_ERR;
+	}
+	// 完了待ち（割り込み処理の完了をタスク側で後処理）
+	while (psTrns->eStatus == E_I2C_TRNS_STS_QUEUED || psTrns->eStatus == E_I2C_TRNS_STS_BUSY) {
+		vI2C_asyncProceed();
+	}
+	vI2C_asyncProceed();
+	if (psTrns->eStatus == E_I2C_TRNS_STS_ACK) {
+		return I2CUTIL_STS_ACK;
+	}
+	if (psTrns->eStatus == E_I2C_TRNS_STS_NACK) {
+		return I2CUTIL_STS_NACK;
+	}
+	return I2CUTIL_STS_ERR;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_waitIdle
+ *
+ * DESCRIPTION:非同期トランザクションの完了待ち
+ *
+ * PARAMETERS:Name          RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 完了時のコールバックで登録されたトランザクションの完了も待つ
+ *****************************************************************************/
+PUBLIC void vI2C_waitIdle() {
+	while (sI2C_state.psHead != NULL) {
+		vI2C_asyncProceed();
+	}
+	vI2C_asyncProceed();
 }
 
 /****************************************************************************/
@@ -370,12 +678,37 @@ PUBLIC uint32 u32I2C_getFrequency() {
  * None.
  *****************************************************************************/
 PRIVATE void vI2C_intervalWait() {
+	// 非同期トランザクションの完了待ち
+	vI2C_waitIdle();
+	vI2C_waitInterval();
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_waitInterval
+ *
+ * DESCRIPTION:前回の通信開始からの通信間隔の待機
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vI2C_waitInterval() {
 	uint64 u64EndTime = sI2C_state.u64LastStart + I2C_INTERVAL;
 	uint64 u64NowTime;
+#ifdef I2C_USE_RECORDER
+	uint64 u64BefTime = u64TimerUtil_readUsec();
+#endif
 	do {
 		u64NowTime = u64TimerUtil_readUsec();
 	} while(u64NowTime < u64EndTime);
 	sI2C_state.u64LastStart = u64TimerUtil_readUsec();
+#ifdef I2C_USE_RECORDER
+	vI2CRec_appendWait((uint32)sI2C_state.u64LastStart, (uint32)(sI2C_state.u64LastStart - u64BefTime));
+#endif
 }
 
 /*****************************************************************************
@@ -411,6 +744,311 @@ PRIVATE bool_t bI2C_transmit(const bool_t* pbPrms) {
 	return TRUE;
 }
 
+/*****************************************************************************
+ *
+ * NAME: vI2C_asyncProceed
+ *
+ * DESCRIPTION:非同期処理：トランザクションキューの進行
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * タスクコンテキストから呼び出す事
+ * 完了したトランザクションをキューから外して完了イベントを登録し、次を開始する
+ *****************************************************************************/
+PRIVATE void vI2C_asyncProceed() {
+	tsI2C_Trns* psTrns;
+	while (sI2C_state.psHead != NULL) {
+		psTrns = sI2C_state.psHead;
+		// 完了したトランザクションの後処理
+		if (sI2C_state.bCompleted) {
+			sI2C_state.psHead = psTrns->psNext;
+			if (sI2C_state.psHead == NULL) {
+				sI2C_state.psTail = NULL;
+			}
+			psTrns->psNext = NULL;
+			sI2C_state.bCompleted = FALSE;
+#ifdef I2C_USE_RECORDER
+			vI2CRec_appendTrns((uint32)u64TimerUtil_readUsec(), psTrns->u8Address,
+				psTrns->u16WriteLen, psTrns->u16ReadLen,
+				(psTrns->eStatus == E_I2C_TRNS_STS_ACK) ? I2CUTIL_STS_ACK :
+				(psTrns->eStatus == E_I2C_TRNS_STS_NACK) ? I2CUTIL_STS_NACK : I2CUTIL_STS_ERR);
+#endif
+			// 完了通知（コールバック内での次のトランザクション登録も可）
+			if (psTrns->pfCallback != NULL) {
+				(*psTrns->pfCallback)(psTrns);
+			}
+			if (psTrns->eCompEvt != E_EVENT_FWK_EMPTY) {
+				iEntrySeqEvt(psTrns->eCompEvt);
+			}
+			continue;
+		}
+		// 次のトランザクションを開始
+		if (psTrns->eStatus == E_I2C_TRNS_STS_QUEUED) {
+			vI2C_asyncStart(psTrns);
+			continue;
+		}
+		// 実行中
+		return;
+	}
+	// キューが空になったら割り込みを無効化し、既定の周波数に戻す（同期処理はポーリングで実行）
+	if (sI2C_state.bIntEnable || sI2C_state.u8CurPreScaler != sI2C_state.u8PreScaler) {
+		vAHI_SiMasterConfigure(TRUE, FALSE, sI2C_state.u8PreScaler);
+		sI2C_state.u8CurPreScaler = sI2C_state.u8PreScaler;
+		sI2C_state.bIntEnable = FALSE;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_asyncStart
+ *
+ * DESCRIPTION:非同期処理：トランザクション開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsI2C_Trns*    psTrns          RW  トランザクション
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vI2C_asyncStart(tsI2C_Trns* psTrns) {
+	// 割り込みの有効化と周波数の切替
+	uint8 u8PreScaler = psTrns->u8PreScaler;
+	if (u8PreScaler == I2C_PRESCALER_DEFAULT) {
+		u8PreScaler = sI2C_state.u8PreScaler;
+	}
+	if (sI2C_state.bIntEnable == FALSE || sI2C_state.u8CurPreScaler != u8PreScaler) {
+		vAHI_SiMasterConfigure(TRUE, TRUE, u8PreScaler);
+		sI2C_state.u8CurPreScaler = u8PreScaler;
+		sI2C_state.bIntEnable = TRUE;
+	}
+	// 通信間隔制御
+	vI2C_waitInterval();
+	// 処理段階の初期化
+	sI2C_state.ePhase    = E_I2C_PHASE_ADDR_W;
+	sI2C_state.u16Idx    = 0;
+	sI2C_state.bStopSent = FALSE;
+	psTrns->eStatus = E_I2C_TRNS_STS_BUSY;
+	// 書き込みデータが無い場合は読み込みから開始
+	if (psTrns->u16WriteLen == 0 && psTrns->u16ReadLen > 0) {
+		sI2C_state.ePhase = E_I2C_PHASE_ADDR_R;
+		vAHI_SiMasterWriteSlaveAddr(psTrns->u8Address, TRUE);
+	} else {
+		vAHI_SiMasterWriteSlaveAddr(psTrns->u8Address, FALSE);
+	}
+	// 以降は割り込み処理で進行
+	if (bI2C_asyncCmd(I2C_ASYNC_START_WRITE) == FALSE) {
+		u8I2C_asyncFinish(E_I2C_TRNS_STS_ERR);
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: bI2C_asyncCmd
+ *
+ * DESCRIPTION:非同期処理：コマンド発行
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t*        pbPrms          R   送受信設定
+ *
+ * RETURNS:
+ *     TRUE ：コマンドを発行した
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE bool_t bI2C_asyncCmd(const bool_t* pbPrms) {
+	if (pbPrms[1] == E_AHI_SI_STOP_BIT) {
+		sI2C_state.bStopSent = TRUE;
+	}
+	return bAHI_SiMasterSetCmdReg(pbPrms[0], pbPrms[1], pbPrms[2], pbPrms[3], pbPrms[4], pbPrms[5]);
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_asyncNextWrite
+ *
+ * DESCRIPTION:非同期処理：次のデータ送信、もしくは読み込み開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsI2C_Trns*    psTrns          RW  トランザクション
+ *
+ * RETURNS:
+ *     割り込みハンドラの戻り値（FALSE：完了したのでタスク側の後処理を要求）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8I2C_asyncNextWrite(tsI2C_Trns* psTrns) {
+	// データ送信
+	if (sI2C_state.u16Idx < psTrns->u16WriteLen) {
+		vAHI_SiMasterWriteData8(psTrns->pu8WriteData[sI2C_state.u16Idx]);
+		sI2C_state.ePhase = E_I2C_PHASE_WRITE;
+		// 読み込みが無い場合は最終データと停止条件を同時に送信
+		if (sI2C_state.u16Idx + 1 >= psTrns->u16WriteLen && psTrns->u16ReadLen == 0) {
+			if (bI2C_asyncCmd(I2C_ASYNC_WRITE_STOP) == FALSE) {
+				return u8I2C_asyncFinish(E_I2C_TRNS_STS_ERR);
+			}
+		} else if (bI2C_asyncCmd(I2C_ASYNC_WRITE) == FALSE) {
+			return u8I2C_asyncStop(E_I2C_TRNS_STS_ERR);
+		}
+		return TRUE;
+	}
+	// 読み込み開始（リピートスタート）
+	if (psTrns->u16ReadLen > 0) {
+		sI2C_state.ePhase = E_I2C_PHASE_ADDR_R;
+		vAHI_SiMasterWriteSlaveAddr(psTrns->u8Address, TRUE);
+		if (bI2C_asyncCmd(I2C_ASYNC_START_WRITE) == FALSE) {
+			return u8I2C_asyncStop(E_I2C_TRNS_STS_ERR);
+		}
+		return TRUE;
+	}
+	// 送受信データ無し（アドレスのみ）
+	if (sI2C_state.bStopSent == FALSE) {
+		return u8I2C_asyncStop(E_I2C_TRNS_STS_ACK);
+	}
+	return u8I2C_asyncFinish(E_I2C_TRNS_STS_ACK);
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_asyncStop
+ *
+ * DESCRIPTION:非同期処理：停止条件を送信して終了
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   teI2C_TrnsStatus eResult       R   トランザクションの結果
+ *
+ * RETURNS:
+ *     割り込みハンドラの戻り値（FALSE：完了したのでタスク側の後処理を要求）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8I2C_asyncStop(teI2C_TrnsStatus eResult) {
+	// 停止条件送信済みの場合はそのまま終了
+	if (sI2C_state.bStopSent) {
+		return u8I2C_asyncFinish(eResult);
+	}
+	sI2C_state.ePhase  = E_I2C_PHASE_STOP;
+	sI2C_state.eResult = eResult;
+	if (bI2C_asyncCmd(I2C_ASYNC_STOP) == FALSE) {
+		return u8I2C_asyncFinish(E_I2C_TRNS_STS_ERR);
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_asyncFinish
+ *
+ * DESCRIPTION:非同期処理：トランザクション完了
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   teI2C_TrnsStatus eResult       R   トランザクションの結果
+ *
+ * RETURNS:
+ *     FALSE：タスク側の後処理（cbToCoNet_vHwEvent）を要求
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8I2C_asyncFinish(teI2C_TrnsStatus eResult) {
+	sI2C_state.psHead->eStatus = eResult;
+	sI2C_state.bCompleted = TRUE;
+	return FALSE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2C_asyncIntTask
+ *
+ * DESCRIPTION:割り込み処理：SI（1バイト転送毎に次のコマンドを発行）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *     uint32       u32DeviceId     R   デバイスID
+ *     uint32       u32ItemBitmap   R   ビットマップ
+ *
+ * RETURNS:
+ *     TRUE ：割り込み処理で完結
+ *     FALSE：トランザクションが完了したので、タスク側の後処理を要求
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8I2C_asyncIntTask(uint32 u32DeviceId, uint32 u32ItemBitmap) {
+	tsI2C_Trns* psTrns = sI2C_state.psHead;
+	if (psTrns == NULL || psTrns->eStatus != E_I2C_TRNS_STS_BUSY || sI2C_state.bCompleted) {
+		return TRUE;
+	}
+	// マルチマスタ時の通信バス調停失敗判定
+	if (bAHI_SiMasterPollArbitrationLost()) {
+		return u8I2C_asyncStop(E_I2C_TRNS_STS_ERR);
+	}
+	switch (sI2C_state.ePhase) {
+	case E_I2C_PHASE_ADDR_W:
+		if (bAHI_SiMasterCheckRxNack()) {
+			return u8I2C_asyncStop(E_I2C_TRNS_STS_NACK);
+		}
+		return u8I2C_asyncNextWrite(psTrns);
+	case E_I2C_PHASE_WRITE:
+		if (bAHI_SiMasterCheckRxNack()) {
+			return u8I2C_asyncStop(E_I2C_TRNS_STS_NACK);
+		}
+		sI2C_state.u16Idx++;
+		return u8I2C_asyncNextWrite(psTrns);
+	case E_I2C_PHASE_ADDR_R:
+		if (bAHI_SiMasterCheckRxNack()) {
+			return u8I2C_asyncStop(E_I2C_TRNS_STS_NACK);
+		}
+		sI2C_state.ePhase = E_I2C_PHASE_READ;
+		sI2C_state.u16Idx = 0;
+		break;
+	case E_I2C_PHASE_READ:
+		psTrns->pu8ReadData[sI2C_state.u16Idx] = u8AHI_SiMasterReadData8();
+		sI2C_state.u16Idx++;
+		if (sI2C_state.u16Idx >= psTrns->u16ReadLen) {
+			return u8I2C_asyncFinish(E_I2C_TRNS_STS_ACK);
+		}
+		break;
+	default:
+		// 停止条件送信の完了
+		return u8I2C_asyncFinish(sI2C_state.eResult);
+	}
+	// 次のデータ受信（最終データはNACK返信と停止条件）
+	if (sI2C_state.u16Idx + 1 >= psTrns->u16ReadLen) {
+		if (bI2C_asyncCmd(I2C_ASYNC_READ_NACK_STOP) == FALSE) {
+			return u8I2C_asyncFinish(E_I2C_TRNS_STS_ERR);
+		}
+	} else if (bI2C_asyncCmd(I2C_ASYNC_READ_ACK) == FALSE) {
+		return u8I2C_asyncStop(E_I2C_TRNS_STS_ERR);
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2C_asyncEvtTask
+ *
+ * DESCRIPTION:ハードウェアイベント処理：SI（割り込み後のタスク側の後処理）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *     uint32       u32DeviceId     R   デバイスID
+ *     uint32       u32ItemBitmap   R   ビットマップ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vI2C_asyncEvtTask(uint32 u32DeviceId, uint32 u32ItemBitmap) {
+	vI2C_asyncProceed();
+}
+
 /****************************************************************************/
 /***        END OF FILE                                                   ***/
 /****************************************************************************/
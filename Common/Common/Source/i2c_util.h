@@ -10,6 +10,9 @@
  *   I2C Utility functions (header file)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 19:00:00 割り込み駆動の非同期トランザクション処理を追加
+ * 2026/10/18 20:00:00 トランザクション完了時のコールバックと完了待ち処理を追加
+ * 2026/10/18 21:00:00 トランザクション毎の動作周波数指定と既定値の変更処理を追加
  *
  * LAST MODIFIED BY:
  *
@@ -28,6 +31,7 @@ extern "C" {
 /****************************************************************************/
 /***        Include files                                                 ***/
 /****************************************************************************/
+#include "framework.h"
 
 /****************************************************************************/
 /***        Macro Definitions                                             ***/
@@ -39,9 +43,53 @@ extern "C" {
 // I2C Execution result status : ERROR
 #define  I2CUTIL_STS_ERR         (0xFF)
 
+// I2C PreScaler : 400KHz
+#define  I2C_PRESCALER_400KHZ    (7)
+// I2C PreScaler : 100KHz
+#define  I2C_PRESCALER_100KHZ    (31)
+// I2C PreScaler : 66KHz
+#define  I2C_PRESCALER_66KHZ     (47)
+// I2C PreScaler : バスの既定値（vI2C_init/vI2C_setPreScalerで設定した値）を使用
+#define  I2C_PRESCALER_DEFAULT   (0xFF)
+
 /****************************************************************************/
 /***        Type Definitions                                              ***/
 /****************************************************************************/
+// 列挙型：非同期トランザクションの状態
+typedef enum {
+	E_I2C_TRNS_STS_IDLE = 0,	// 未登録もしくは完了通知済み
+	E_I2C_TRNS_STS_QUEUED,		// 実行待ち
+	E_I2C_TRNS_STS_BUSY,		// 実行中
+	E_I2C_TRNS_STS_ACK,			// 正常終了
+	E_I2C_TRNS_STS_NACK,		// NACK受信により中断
+	E_I2C_TRNS_STS_ERR			// 通信エラー
+} teI2C_TrnsStatus;
+
+// 構造体：非同期トランザクション
+// 書き込みデータを送信後、読み込みバイト数分を受信する（読み込みはリピートスタート）
+// 完了するまでは、呼び出し元で構造体とデータ領域を保持する事
+typedef struct tsI2C_TrnsTag {
+	// I2Cアドレス
+	uint8 u8Address;
+	// 動作周波数（I2C_PRESCALER_DEFAULTの場合はバスの既定値）
+	uint8 u8PreScaler;
+	// 書き込みデータ
+	const uint8* pu8WriteData;
+	// 書き込みバイト数
+	uint16 u16WriteLen;
+	// 読み込み先データ領域
+	uint8* pu8ReadData;
+	// 読み込みバイト数
+	uint16 u16ReadLen;
+	// 完了イベント（E_EVENT_FWK_EMPTYの場合は通知しない）
+	teFwkEvent eCompEvt;
+	// 完了時のコールバック（タスクコンテキストで実行、NULLの場合は呼び出さない）
+	void (*pfCallback)(struct tsI2C_TrnsTag* psTrns);
+	// 状態
+	volatile teI2C_TrnsStatus eStatus;
+	// 次のトランザクション（キュー内部で使用）
+	struct tsI2C_TrnsTag* psNext;
+} tsI2C_Trns;
 
 /****************************************************************************/
 /***        Exported Variables                                            ***/
@@ -76,6 +124,20 @@ PUBLIC bool_t bI2C_stopACK();
 PUBLIC bool_t bI2C_stopNACK();
 // バス駆動周波数参照
 PUBLIC uint32 u32I2C_getFrequency();
+// バス駆動周波数の既定値変更
+PUBLIC void vI2C_setPreScaler(uint8 u8PreScaler);
+// 動作周波数からバス駆動周波数への変換
+PUBLIC uint32 u32I2C_toFrequency(uint8 u8PreScaler);
+// 非同期処理の初期化処理
+PUBLIC void vI2C_initAsync();
+// 非同期トランザクションの登録処理
+PUBLIC bool_t bI2C_entryTrns(tsI2C_Trns* psTrns);
+// 非同期トランザクションの実行中判定
+PUBLIC bool_t bI2C_isBusy();
+// トランザクションの実行処理（完了まで待機）
+PUBLIC uint8 u8I2C_execTrns(tsI2C_Trns* psTrns);
+// 非同期トランザクションの完了待ち
+PUBLIC void vI2C_waitIdle();
 
 /****************************************************************************/
 /***        Local Functions                                               ***/
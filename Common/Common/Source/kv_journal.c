@@ -0,0 +1,462 @@
+/****************************************************************************
+ *
+ * MODULE :KV Journal functions source file
+ *
+ * CREATED:2026/10/19 04:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   EEPROM上のレコード（キーはEEPROMアドレス）の複数更新を
+ *   ジャーナル経由で一括して反映するキーバリューストアの関数群
+ *   KV Journal functions (source file)
+ *   ・トランザクション内で追加したレコードは、コミット時にページ単位で現在の内容と比較し、
+ *     変更されたバイト範囲だけを差分レコードとして抽出する（内容が同じページは書き込まない）
+ *   ・変更が２ページ以上に跨る場合は、差分レコードの列とCRC-16をジャーナル領域に書き込んで
+ *     コミットを確定させてから本来のアドレスに反映し、最後にジャーナルを消去する
+ *   ・変更が１ページのみの場合は、ページ書き込み自体が不可分なのでジャーナルを経由しない
+ *   ・ジャーナルはコミット中以外は常に空なので、ジャーナルを経由しない直接の書き込みと併用できる
+ *   ・電源断後はbKVJournal_recoverでCRCが一致するジャーナルを再反映し、
+ *     CRCが一致しない（書き込み途中の）ジャーナルは破棄する
+ *
+ * CHANGE HISTORY:
+ * 2026/10/19 08:00:00 復元時にジャーナルを再反映した回数の統計情報を追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <jendefs.h>
+
+#include "crc.h"
+#include "eeprom.h"
+#include "kv_journal.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 差分レコードの抽出
+PRIVATE int iKVJournal_diff(tsKVJournal* psJnl, uint16* pu16DiffLen);
+// 差分レコードの反映
+PRIVATE bool_t bKVJournal_apply(tsKVJournal* psJnl, uint16 u16DiffLen);
+// ジャーナルの消去
+PRIVATE bool_t bKVJournal_erase(tsKVJournal* psJnl);
+// ジャーナルのCRC算出
+PRIVATE uint16 u16KVJournal_crc(uint16 u16DiffLen);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// ジャーナルバッファ（ヘッダと差分レコードの列、コミットと復元の処理中のみ使用）
+PRIVATE uint8 u8KVJournal_buff[KV_JOURNAL_AREA_SIZE];
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: vKVJournal_init
+ *
+ * DESCRIPTION:初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           W   ジャーナル付きキーバリューストア
+ *   uint16         u16TopAddr      R   ジャーナル領域の先頭アドレス
+ *                                      （KV_JOURNAL_AREA_SIZEバイトを使用）
+ *   uint8          u8PageSize      R   EEPROMのページサイズ（KV_JOURNAL_PAGE_MAXまで）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * EEPROMへのアクセスは行わない、初回アクセス前にbKVJournal_recoverを呼び出す事
+ *****************************************************************************/
+PUBLIC void vKVJournal_init(tsKVJournal* psJnl, uint16 u16TopAddr, uint8 u8PageSize) {
+	memset(psJnl, 0x00, sizeof(tsKVJournal));
+	psJnl->bValid     = FALSE;
+	psJnl->u16TopAddr = u16TopAddr;
+	psJnl->u8PageSize = (u8PageSize < KV_JOURNAL_PAGE_MAX) ? u8PageSize : KV_JOURNAL_PAGE_MAX;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bKVJournal_recover
+ *
+ * DESCRIPTION:EEPROMからの復元（書き込み途中のジャーナルの反映）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           RW  ジャーナル付きキーバリューストア
+ *
+ * RETURNS:
+ *   bool_t         TRUE:復元成功
+ *
+ * NOTES:
+ * 選択中のEEPROMを参照する
+ * CRCが一致するジャーナルは反映が完了していない可能性があるので再反映する
+ * （差分レコードは書き込み後の内容なので、反映済みの場合も同じ結果になる）
+ *****************************************************************************/
+PUBLIC bool_t bKVJournal_recover(tsKVJournal* psJnl) {
+	psJnl->bValid = FALSE;
+	vKVJournal_begin(psJnl);
+	// ジャーナルヘッダの読み込み
+	uint8* pu8Buff = u8KVJournal_buff;
+	if (bEEPROM_readData(psJnl->u16TopAddr, KV_JOURNAL_HEADER_SIZE, pu8Buff) == FALSE) {
+		return FALSE;
+	}
+	uint16 u16DiffLen = ((uint16)pu8Buff[0] << 8) | pu8Buff[1];
+	uint16 u16Crc     = ((uint16)pu8Buff[2] << 8) | pu8Buff[3];
+	// ジャーナル無し
+	if (u16DiffLen == KV_JOURNAL_EMPTY && u16Crc == KV_JOURNAL_EMPTY) {
+		psJnl->bValid = TRUE;
+		return TRUE;
+	}
+	// 差分レコードの読み込みとCRC判定
+	if (u16DiffLen <= KV_JOURNAL_TRAN_SIZE) {
+		if (bEEPROM_readData(psJnl->u16TopAddr + KV_JOURNAL_HEADER_SIZE, u16DiffLen,
+							 &pu8Buff[KV_JOURNAL_HEADER_SIZE]) == FALSE) {
+			return FALSE;
+		}
+		// CRCが一致する場合は再反映
+		if (u16Crc == u16KVJournal_crc(u16DiffLen)) {
+			if (bKVJournal_apply(psJnl, u16DiffLen) == FALSE) {
+				return FALSE;
+			}
+			psJnl->u32ReplayCnt++;
+		}
+	}
+	// ジャーナルの消去（書き込み途中のジャーナルは破棄）
+	if (bKVJournal_erase(psJnl) == FALSE) {
+		return FALSE;
+	}
+	psJnl->bValid = TRUE;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vKVJournal_begin
+ *
+ * DESCRIPTION:トランザクションの開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           RW  ジャーナル付きキーバリューストア
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 未コミットのトランザクションは破棄する
+ *****************************************************************************/
+PUBLIC void vKVJournal_begin(tsKVJournal* psJnl) {
+	psJnl->bOverflow  = FALSE;
+	psJnl->u16TranLen = 0;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bKVJournal_put
+ *
+ * DESCRIPTION:レコードの追加
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           RW  ジャーナル付きキーバリューストア
+ *   uint16         u16Addr         R   キー（書き込み先のEEPROMアドレス）
+ *   uint8*         pu8Data         R   データ
+ *   uint16         u16Len          R   データ長
+ *
+ * RETURNS:
+ *   bool_t         TRUE:追加成功
+ *
+ * NOTES:
+ * EEPROMへの書き込みはコミット時に行う
+ * 同じアドレス範囲のレコードを複数追加した場合は後から追加したレコードを優先する
+ * バッファが不足した場合は、トランザクション全体をコミット時に失敗させる
+ *****************************************************************************/
+PUBLIC bool_t bKVJournal_put(tsKVJournal* psJnl, uint16 u16Addr, const uint8* pu8Data, uint16 u16Len) {
+	if (psJnl->u16TranLen + KV_JOURNAL_PUT_HEADER + u16Len > KV_JOURNAL_TRAN_SIZE) {
+		psJnl->bOverflow = TRUE;
+		return FALSE;
+	}
+	uint8* pu8Rec = &psJnl->u8TranBuff[psJnl->u16TranLen];
+	pu8Rec[0] = (uint8)(u16Addr >> 8);
+	pu8Rec[1] = (uint8)u16Addr;
+	pu8Rec[2] = (uint8)(u16Len >> 8);
+	pu8Rec[3] = (uint8)u16Len;
+	memcpy(&pu8Rec[KV_JOURNAL_PUT_HEADER], pu8Data, u16Len);
+	psJnl->u16TranLen += KV_JOURNAL_PUT_HEADER + u16Len;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bKVJournal_commit
+ *
+ * DESCRIPTION:トランザクションのコミット
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           RW  ジャーナル付きキーバリューストア
+ *
+ * RETURNS:
+ *   bool_t         TRUE:コミット成功
+ *
+ * NOTES:
+ * 選択中のEEPROMに書き込む（キャッシュ使用時は書き戻しまで行う）
+ * ジャーナルの書き込み前に失敗した場合は、EEPROMの内容は変更されない
+ * ジャーナルの書き込み後に失敗した場合は、次回のbKVJournal_recoverで反映される
+ *****************************************************************************/
+PUBLIC bool_t bKVJournal_commit(tsKVJournal* psJnl) {
+	if (psJnl->bValid == FALSE || psJnl->bOverflow) {
+		vKVJournal_begin(psJnl);
+		return FALSE;
+	}
+	// 差分レコードの抽出
+	uint16 u16DiffLen;
+	int iPageCnt = iKVJournal_diff(psJnl, &u16DiffLen);
+	vKVJournal_begin(psJnl);
+	if (iPageCnt < 0) {
+		return FALSE;
+	}
+	psJnl->u32CommitCnt++;
+	if (iPageCnt == 0) {
+		return TRUE;
+	}
+	// ジャーナルの書き込み（２ページ以上の変更時のみ）
+	bool_t bJournal = (iPageCnt > 1);
+	if (bJournal) {
+		uint16 u16Crc = u16KVJournal_crc(u16DiffLen);
+		u8KVJournal_buff[0] = (uint8)(u16DiffLen >> 8);
+		u8KVJournal_buff[1] = (uint8)u16DiffLen;
+		u8KVJournal_buff[2] = (uint8)(u16Crc >> 8);
+		u8KVJournal_buff[3] = (uint8)u16Crc;
+		if (bEEPROM_writeData(psJnl->u16TopAddr, KV_JOURNAL_HEADER_SIZE + u16DiffLen, u8KVJournal_buff) == FALSE) {
+			return FALSE;
+		}
+		// ジャーナルの確定（キャッシュの書き戻し）
+		if (bEEPROM_commit() == FALSE) {
+			return FALSE;
+		}
+		psJnl->u32JournalCnt++;
+	}
+	// 差分レコードの反映
+	if (bKVJournal_apply(psJnl, u16DiffLen) == FALSE) {
+		return FALSE;
+	}
+	psJnl->u32PageCnt += iPageCnt;
+	// ジャーナルの消去
+	if (bJournal) {
+		return bKVJournal_erase(psJnl);
+	}
+	return TRUE;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: iKVJournal_diff
+ *
+ * DESCRIPTION:差分レコードの抽出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           RW  ジャーナル付きキーバリューストア
+ *   uint16*        pu16DiffLen     W   差分レコードの合計長
+ *
+ * RETURNS:
+ *   int            変更ページ数、エラー時は-1
+ *
+ * NOTES:
+ * 追加レコードが掛かるページ毎に、現在の内容に追加レコードを重ねて比較し、
+ * 最初と最後の変更バイトの範囲をジャーナルバッファに差分レコードとして書き込む
+ *****************************************************************************/
+PRIVATE int iKVJournal_diff(tsKVJournal* psJnl, uint16* pu16DiffLen) {
+	uint8 u8Before[KV_JOURNAL_PAGE_MAX];
+	uint8 u8After[KV_JOURNAL_PAGE_MAX];
+	uint16 u16Pages[KV_JOURNAL_PAGE_CNT];
+	uint8 u8PageCnt = 0;
+	uint16 u16PageSize = psJnl->u8PageSize;
+	uint8* pu8Diff = &u8KVJournal_buff[KV_JOURNAL_HEADER_SIZE];
+	uint16 u16DiffLen = 0;
+	int iChgCnt = 0;
+	uint16 u16Pos = 0;
+	uint16 u16RecAddr;
+	uint16 u16RecLen;
+	uint16 u16Page;
+	uint16 u16PageEnd;
+	uint16 u16Chk;
+	uint16 u16From;
+	uint16 u16To;
+	uint8 u8Idx;
+	while (u16Pos < psJnl->u16TranLen) {
+		u16RecAddr = ((uint16)psJnl->u8TranBuff[u16Pos] << 8) | psJnl->u8TranBuff[u16Pos + 1];
+		u16RecLen  = ((uint16)psJnl->u8TranBuff[u16Pos + 2] << 8) | psJnl->u8TranBuff[u16Pos + 3];
+		u16Pos += KV_JOURNAL_PUT_HEADER + u16RecLen;
+		if (u16RecLen == 0) {
+			continue;
+		}
+		// レコードが掛かるページ毎の処理
+		u16PageEnd = u16RecAddr + u16RecLen;
+		for (u16Page = u16RecAddr - (u16RecAddr % u16PageSize); u16Page < u16PageEnd; u16Page += u16PageSize) {
+			// 処理済みページ判定
+			for (u8Idx = 0; u8Idx < u8PageCnt; u8Idx++) {
+				if (u16Pages[u8Idx] == u16Page) {
+					break;
+				}
+			}
+			if (u8Idx < u8PageCnt) {
+				continue;
+			}
+			if (u8PageCnt >= KV_JOURNAL_PAGE_CNT) {
+				return -1;
+			}
+			u16Pages[u8PageCnt++] = u16Page;
+			// 現在の内容に全ての追加レコードを追加順に重ねる
+			if (bEEPROM_readData(u16Page, u16PageSize, u8Before) == FALSE) {
+				return -1;
+			}
+			memcpy(u8After, u8Before, u16PageSize);
+			u16Chk = 0;
+			while (u16Chk < psJnl->u16TranLen) {
+				uint16 u16Addr = ((uint16)psJnl->u8TranBuff[u16Chk] << 8) | psJnl->u8TranBuff[u16Chk + 1];
+				uint16 u16Len  = ((uint16)psJnl->u8TranBuff[u16Chk + 2] << 8) | psJnl->u8TranBuff[u16Chk + 3];
+				uint8* pu8Data = &psJnl->u8TranBuff[u16Chk + KV_JOURNAL_PUT_HEADER];
+				u16Chk += KV_JOURNAL_PUT_HEADER + u16Len;
+				u16From = (u16Addr > u16Page) ? u16Addr : u16Page;
+				u16To   = (u16Addr + u16Len < u16Page + u16PageSize) ? u16Addr + u16Len : u16Page + u16PageSize;
+				if (u16From < u16To) {
+					memcpy(&u8After[u16From - u16Page], &pu8Data[u16From - u16Addr], u16To - u16From);
+				}
+			}
+			// 変更範囲の判定
+			u16From = 0;
+			while (u16From < u16PageSize && u8Before[u16From] == u8After[u16From]) {
+				u16From++;
+			}
+			if (u16From >= u16PageSize) {
+				psJnl->u32SkipCnt++;
+				continue;
+			}
+			u16To = u16PageSize;
+			while (u8Before[u16To - 1] == u8After[u16To - 1]) {
+				u16To--;
+			}
+			// 差分レコードの書き込み
+			if (u16DiffLen + KV_JOURNAL_DIFF_HEADER + (u16To - u16From) > KV_JOURNAL_TRAN_SIZE) {
+				return -1;
+			}
+			pu8Diff[u16DiffLen]     = (uint8)((u16Page + u16From) >> 8);
+			pu8Diff[u16DiffLen + 1] = (uint8)(u16Page + u16From);
+			pu8Diff[u16DiffLen + 2] = (uint8)(u16To - u16From);
+			memcpy(&pu8Diff[u16DiffLen + KV_JOURNAL_DIFF_HEADER], &u8After[u16From], u16To - u16From);
+			u16DiffLen += KV_JOURNAL_DIFF_HEADER + (u16To - u16From);
+			iChgCnt++;
+		}
+	}
+	*pu16DiffLen = u16DiffLen;
+	return iChgCnt;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bKVJournal_apply
+ *
+ * DESCRIPTION:差分レコードの反映
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           R   ジャーナル付きキーバリューストア
+ *   uint16         u16DiffLen      R   差分レコードの合計長
+ *
+ * RETURNS:
+ *   bool_t         TRUE:反映成功
+ *
+ * NOTES:
+ * ジャーナルバッファの差分レコードを本来のアドレスに書き込み、キャッシュを書き戻す
+ * 差分レコードはページを跨がないので、１レコードにつき１回のページ書き込みとなる
+ *****************************************************************************/
+PRIVATE bool_t bKVJournal_apply(tsKVJournal* psJnl, uint16 u16DiffLen) {
+	uint8* pu8Diff = &u8KVJournal_buff[KV_JOURNAL_HEADER_SIZE];
+	uint16 u16Pos = 0;
+	uint16 u16Addr;
+	uint8 u8Len;
+	while (u16Pos + KV_JOURNAL_DIFF_HEADER <= u16DiffLen) {
+		u16Addr = ((uint16)pu8Diff[u16Pos] << 8) | pu8Diff[u16Pos + 1];
+		u8Len   = pu8Diff[u16Pos + 2];
+		u16Pos += KV_JOURNAL_DIFF_HEADER;
+		if (u8Len > psJnl->u8PageSize || u16Pos + u8Len > u16DiffLen) {
+			return FALSE;
+		}
+		if (bEEPROM_writeData(u16Addr, u8Len, &pu8Diff[u16Pos]) == FALSE) {
+			return FALSE;
+		}
+		u16Pos += u8Len;
+	}
+	return bEEPROM_commit();
+}
+
+/*****************************************************************************
+ *
+ * NAME: bKVJournal_erase
+ *
+ * DESCRIPTION:ジャーナルの消去
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsKVJournal*   psJnl           R   ジャーナル付きキーバリューストア
+ *
+ * RETURNS:
+ *   bool_t         TRUE:消去成功
+ *
+ * NOTES:
+ * ジャーナルヘッダのみを消去する（差分レコードはCRCで無効と判定される）
+ *****************************************************************************/
+PRIVATE bool_t bKVJournal_erase(tsKVJournal* psJnl) {
+	uint8 u8Header[KV_JOURNAL_HEADER_SIZE];
+	memset(u8Header, 0xFF, KV_JOURNAL_HEADER_SIZE);
+	if (bEEPROM_writeData(psJnl->u16TopAddr, KV_JOURNAL_HEADER_SIZE, u8Header) == FALSE) {
+		return FALSE;
+	}
+	return bEEPROM_commit();
+}
+
+/*****************************************************************************
+ *
+ * NAME: u16KVJournal_crc
+ *
+ * DESCRIPTION:ジャーナルのCRC算出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16DiffLen      R   差分レコードの合計長
+ *
+ * RETURNS:
+ *   uint16         差分レコードの合計長と差分レコードの列のCRC-16
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint16 u16KVJournal_crc(uint16 u16DiffLen) {
+	uint8 u8Len[2];
+	u8Len[0] = (uint8)(u16DiffLen >> 8);
+	u8Len[1] = (uint8)u16DiffLen;
+	uint16 u16Crc = u16CRC16_update(CRC16_INIT, u8Len, 2);
+	return u16CRC16_update(u16Crc, &u8KVJournal_buff[KV_JOURNAL_HEADER_SIZE], u16DiffLen);
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * MODULE :KV Journal functions header file
+ *
+ * CREATED:2026/10/19 04:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   EEPROM上のレコード（キーはEEPROMアドレス）の複数更新を
+ *   ジャーナル経由で一括して反映するキーバリューストアの関数群
+ *   KV Journal functions (header file)
+ *
+ * CHANGE HISTORY:
+ * 2026/10/19 08:00:00 復元時にジャーナルを再反映した回数の統計情報を追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  KVJOURNAL_H_INCLUDED
+#define  KVJOURNAL_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// トランザクションバッファサイズ（追加レコードのヘッダを含む）
+#ifndef KV_JOURNAL_TRAN_SIZE
+	#define KV_JOURNAL_TRAN_SIZE   (192)
+#endif
+// トランザクション当たりの最大更新ページ数
+#ifndef KV_JOURNAL_PAGE_CNT
+	#define KV_JOURNAL_PAGE_CNT    (8)
+#endif
+// 最大ページサイズ
+#define KV_JOURNAL_PAGE_MAX    (64)
+// 追加レコードのヘッダサイズ（アドレス２バイト＋長さ２バイト）
+#define KV_JOURNAL_PUT_HEADER  (4)
+// 差分レコードのヘッダサイズ（アドレス２バイト＋長さ１バイト）
+#define KV_JOURNAL_DIFF_HEADER (3)
+// ジャーナルヘッダサイズ（差分レコードの合計長２バイト＋CRC-16の２バイト）
+#define KV_JOURNAL_HEADER_SIZE (4)
+// ジャーナル領域のサイズ
+#define KV_JOURNAL_AREA_SIZE   (KV_JOURNAL_HEADER_SIZE + KV_JOURNAL_TRAN_SIZE)
+// ジャーナル無し（消去済み）
+#define KV_JOURNAL_EMPTY       (0xFFFF)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：ジャーナル付きキーバリューストア
+typedef struct {
+	// 復元済みフラグ
+	bool_t bValid;
+	// トランザクションのバッファあふれフラグ
+	bool_t bOverflow;
+	// ジャーナル領域の先頭アドレス
+	uint16 u16TopAddr;
+	// ページサイズ
+	uint8 u8PageSize;
+	// トランザクションの使用バイト数
+	uint16 u16TranLen;
+	// トランザクションバッファ（追加レコードの列）
+	uint8 u8TranBuff[KV_JOURNAL_TRAN_SIZE];
+	// 統計情報：コミット回数
+	uint32 u32CommitCnt;
+	// 統計情報：ジャーナルを経由したコミット回数
+	uint32 u32JournalCnt;
+	// 統計情報：書き込んだページ数（ジャーナルを除く）
+	uint32 u32PageCnt;
+	// 統計情報：内容が同じ為に書き込みを省略したページ数
+	uint32 u32SkipCnt;
+	// 統計情報：復元時にジャーナルを再反映した回数（呼び出し元のキャッシュの破棄判定に使用）
+	uint32 u32ReplayCnt;
+} tsKVJournal;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/** 初期化 */
+PUBLIC void vKVJournal_init(tsKVJournal* psJnl, uint16 u16TopAddr, uint8 u8PageSize);
+/** EEPROMからの復元（書き込み途中のジャーナルの反映） */
+PUBLIC bool_t bKVJournal_recover(tsKVJournal* psJnl);
+/** トランザクションの開始 */
+PUBLIC void vKVJournal_begin(tsKVJournal* psJnl);
+/** レコードの追加 */
+PUBLIC bool_t bKVJournal_put(tsKVJournal* psJnl, uint16 u16Addr, const uint8* pu8Data, uint16 u16Len);
+/** トランザクションのコミット */
+PUBLIC bool_t bKVJournal_commit(tsKVJournal* psJnl);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* KVJOURNAL_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,428 @@
+/****************************************************************************
+ *
+ * MODULE :Log Query functions source file
+ *
+ * CREATED:2026/10/19 06:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ログリングのブロック毎の集計情報（日の範囲と分類のマップ）をRAM上に保持し、
+ *   日付や分類でログを検索する関数群
+ *   Log Query functions (source file)
+ *   ・集計情報はブロックの物理位置毎に、シーケンス番号とエントリ位置の数と、
+ *     有効なエントリの日（キーの経過日数）の最小値と最大値、分類のマップを保持する
+ *   ・検索時は集計情報で条件に一致しないブロックを読み飛ばし、一致する可能性のある
+ *     ブロックのみを１回の読み込みで取得して、ブロック内のエントリを判定する
+ *     （キーは昇順なので、ある日の最初のログは日の範囲で特定したブロック内にある）
+ *   ・集計情報は読み込んだブロックから随時作成し、シーケンス番号とエントリ位置の数が
+ *     ログリングと一致しない場合（上書き、追記、消去）は未集計として扱う
+ *   ・分類はデータの指定位置のバイトをマスクした値で、キー無効フラグが立っている
+ *     エントリは日の判定の対象外とする
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <jendefs.h>
+
+#include "log_ring.h"
+#include "log_query.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// ブロックの集計情報の参照
+PRIVATE tsLogQuerySummary* psLogQuery_summary(tsLogQuery* psQuery, uint16 u16BlockIdx);
+// 集計情報の有効判定
+PRIVATE bool_t bLogQuery_chkSummary(tsLogQuery* psQuery, tsLogQuerySummary* psSummary, uint16 u16BlockIdx);
+// 集計情報の条件判定
+PRIVATE bool_t bLogQuery_matchSummary(tsLogQuerySummary* psSummary, const tsLogQueryCond* psCond);
+// 集計情報の作成
+PRIVATE void vLogQuery_summarize(tsLogQuery* psQuery, tsLogQuerySummary* psSummary, tsLogRingBlock* psBlock);
+// ブロック内のエントリの検索
+PRIVATE int iLogQuery_findEntry(tsLogQuery* psQuery, const tsLogQueryCond* psCond, tsLogRingBlock* psBlock,
+								int iIdx, bool_t bForwardFlg);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: vLogQuery_init
+ *
+ * DESCRIPTION:初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuery*    psQuery         W   ログ検索
+ *   tsLogRing*     psRing          R   対象のログリング
+ *   uint8          u8ClassOffset   R   分類：データ内の位置
+ *   uint8          u8ClassMask     R   分類：マスク
+ *   uint8          u8KeyInvalidMask R  キー無効フラグのマスク（0:フラグ無し）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * EEPROMへのアクセスは行わない、集計情報は検索時に作成する
+ *****************************************************************************/
+PUBLIC void vLogQuery_init(tsLogQuery* psQuery, tsLogRing* psRing, uint8 u8ClassOffset, uint8 u8ClassMask, uint8 u8KeyInvalidMask) {
+	psQuery->psRing           = psRing;
+	psQuery->u8ClassOffset    = u8ClassOffset;
+	psQuery->u8ClassMask      = u8ClassMask;
+	psQuery->u8KeyInvalidMask = u8KeyInvalidMask;
+	psQuery->u32ReadCnt       = 0;
+	psQuery->u32SkipCnt       = 0;
+	vLogQuery_invalidate(psQuery);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vLogQuery_invalidate
+ *
+ * DESCRIPTION:集計情報の破棄
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuery*    psQuery         RW  ログ検索
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * EEPROMが差し替えられた場合等、ログリングを復元し直す場合に呼び出す
+ *****************************************************************************/
+PUBLIC void vLogQuery_invalidate(tsLogQuery* psQuery) {
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < LOG_QUERY_BLOCK_MAX; u8Idx++) {
+		psQuery->sSummary[u8Idx].u8Fill = LOG_QUERY_FILL_NONE;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vLogQuery_setCond
+ *
+ * DESCRIPTION:検索条件の編集
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQueryCond* psCond         W   検索条件
+ *   uint16         u16DayFrom      R   対象日（開始、LOG_QUERY_DAY_NONEの場合は日を問わない）
+ *   uint16         u16DayTo        R   対象日（終了）
+ *   uint32         u32ClassMap     R   対象の分類のマップ
+ *
+ * RETURNS:
+ *
+ *****************************************************************************/
+PUBLIC void vLogQuery_setCond(tsLogQueryCond* psCond, uint16 u16DayFrom, uint16 u16DayTo, uint32 u32ClassMap) {
+	psCond->u16DayFrom  = u16DayFrom;
+	psCond->u16DayTo    = u16DayTo;
+	psCond->u32ClassMap = u32ClassMap;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iLogQuery_find
+ *
+ * DESCRIPTION:ログの検索
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuery*    psQuery         RW  ログ検索
+ *   tsLogQueryCond* psCond         R   検索条件
+ *   uint16         u16Pos          R   探索開始エントリ位置（範囲外の場合、逆方向は最新のログから）
+ *   bool_t         bForwardFlg     R   順方向探索フラグ
+ *   uint32*        pu32Key         W   キー
+ *   uint8*         pu8Data         W   ログデータ
+ *   uint8          u8Len           R   ログデータ長
+ *   uint16*        pu16SeqNo       W   エントリのシーケンス番号（不要な場合はNULL）
+ *
+ * RETURNS:
+ *   int            一致したエントリ位置、エラー時はマイナス値
+ *                  （-1:未復元、-2:読み込みエラー、-3:対象データなし）
+ *
+ * NOTES:
+ * 選択中のEEPROMから読み込む、末尾と先頭は循環しない
+ * 集計情報が有効で条件に一致しないブロックは読み込まない
+ *****************************************************************************/
+PUBLIC int iLogQuery_find(tsLogQuery* psQuery, const tsLogQueryCond* psCond, uint16 u16Pos, bool_t bForwardFlg,
+						  uint32* pu32Key, uint8* pu8Data, uint8 u8Len, uint16* pu16SeqNo) {
+	tsLogRing* psRing = psQuery->psRing;
+	if (psRing->bValid == FALSE) {
+		return -1;
+	}
+	// 探索開始位置の判定
+	uint16 u16Cnt = psRing->u16Cnt;
+	if (u16Cnt == 0) {
+		return -3;
+	}
+	if (u16Pos >= u16Cnt) {
+		if (bForwardFlg) {
+			return -3;
+		}
+		u16Pos = u16Cnt - 1;
+	}
+	uint8 u8EntryCnt   = psRing->u8EntryCnt;
+	uint16 u16BlockIdx = u16Pos / u8EntryCnt;
+	int iIdx           = u16Pos % u8EntryCnt;
+	// ブロック単位の探索
+	tsLogRingBlock sBlock;
+	tsLogQuerySummary* psSummary;
+	int iFill;
+	while (TRUE) {
+		psSummary = psLogQuery_summary(psQuery, u16BlockIdx);
+		if (bLogQuery_chkSummary(psQuery, psSummary, u16BlockIdx) &&
+			bLogQuery_matchSummary(psSummary, psCond) == FALSE) {
+			// 集計情報で対象外と判定できるブロックは読み飛ばし
+			psQuery->u32SkipCnt++;
+		} else {
+			// I2C EEPROM Read
+			iFill = iLogRing_readBlock(psRing, u16BlockIdx, &sBlock);
+			if (iFill == -2) {
+				return -2;
+			}
+			psQuery->u32ReadCnt++;
+			if (iFill > 0) {
+				vLogQuery_summarize(psQuery, psSummary, &sBlock);
+				iIdx = iLogQuery_findEntry(psQuery, psCond, &sBlock, iIdx, bForwardFlg);
+				if (iIdx >= 0) {
+					// 一致したエントリの展開
+					*pu32Key = sBlock.u32Key[iIdx];
+					if (u8Len > psRing->u8DataSize) {
+						u8Len = psRing->u8DataSize;
+					}
+					memcpy(pu8Data, &sBlock.u8Data[psRing->u8DataSize * iIdx], u8Len);
+					if (pu16SeqNo != NULL) {
+						*pu16SeqNo = sBlock.u16SeqNo * u8EntryCnt + iIdx;
+					}
+					return u16BlockIdx * u8EntryCnt + iIdx;
+				}
+			}
+		}
+		// 次のブロック
+		if (bForwardFlg) {
+			u16BlockIdx++;
+			if (u16BlockIdx >= psRing->u16BlockUsed) {
+				break;
+			}
+			iIdx = 0;
+		} else {
+			if (u16BlockIdx == 0) {
+				break;
+			}
+			u16BlockIdx--;
+			iIdx = u8EntryCnt - 1;
+		}
+	}
+	return -3;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: psLogQuery_summary
+ *
+ * DESCRIPTION:ブロックの集計情報の参照
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuery*    psQuery         R   ログ検索
+ *   uint16         u16BlockIdx     R   ブロック位置（0が最も古いブロック）
+ *
+ * RETURNS:
+ *   tsLogQuerySummary* ブロックの物理位置の集計情報、集計対象外の場合はNULL
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE tsLogQuerySummary* psLogQuery_summary(tsLogQuery* psQuery, uint16 u16BlockIdx) {
+	tsLogRing* psRing = psQuery->psRing;
+	uint16 u16Block = (psRing->u16TailBlock + u16BlockIdx) % psRing->u16BlockCnt;
+	if (u16Block >= LOG_QUERY_BLOCK_MAX) {
+		return NULL;
+	}
+	return &psQuery->sSummary[u16Block];
+}
+
+/*****************************************************************************
+ *
+ * NAME: bLogQuery_chkSummary
+ *
+ * DESCRIPTION:集計情報の有効判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuery*    psQuery         R   ログ検索
+ *   tsLogQuerySummary* psSummary   R   集計情報
+ *   uint16         u16BlockIdx     R   ブロック位置（0が最も古いブロック）
+ *
+ * RETURNS:
+ *   bool_t         TRUE:現在のブロックの内容を集計済み
+ *
+ * NOTES:
+ * シーケンス番号が異なる場合は上書き、エントリ位置の数が異なる場合は追記されている
+ *****************************************************************************/
+PRIVATE bool_t bLogQuery_chkSummary(tsLogQuery* psQuery, tsLogQuerySummary* psSummary, uint16 u16BlockIdx) {
+	if (psSummary == NULL || psSummary->u8Fill == LOG_QUERY_FILL_NONE) {
+		return FALSE;
+	}
+	tsLogRing* psRing = psQuery->psRing;
+	uint8 u8Fill = psRing->u8EntryCnt;
+	if (u16BlockIdx == psRing->u16BlockUsed - 1) {
+		u8Fill = psRing->u8HeadFill;
+	}
+	return (psSummary->u16SeqNo == (uint16)(psRing->u16NextSeq - psRing->u16BlockUsed + u16BlockIdx) &&
+			psSummary->u8Fill == u8Fill);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bLogQuery_matchSummary
+ *
+ * DESCRIPTION:集計情報の条件判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuerySummary* psSummary   R   集計情報
+ *   tsLogQueryCond* psCond         R   検索条件
+ *
+ * RETURNS:
+ *   bool_t         TRUE:条件に一致するエントリを含む可能性がある
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE bool_t bLogQuery_matchSummary(tsLogQuerySummary* psSummary, const tsLogQueryCond* psCond) {
+	if ((psSummary->u32ClassMap & psCond->u32ClassMap) == 0) {
+		return FALSE;
+	}
+	if (psCond->u16DayFrom == LOG_QUERY_DAY_NONE) {
+		return TRUE;
+	}
+	return (psSummary->u16DayMin != LOG_QUERY_DAY_NONE &&
+			psSummary->u16DayMin <= psCond->u16DayTo && psSummary->u16DayMax >= psCond->u16DayFrom);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vLogQuery_summarize
+ *
+ * DESCRIPTION:集計情報の作成
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuery*    psQuery         R   ログ検索
+ *   tsLogQuerySummary* psSummary   W   集計情報（NULLの場合は何もしない）
+ *   tsLogRingBlock* psBlock        R   ブロックの読み込み結果
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vLogQuery_summarize(tsLogQuery* psQuery, tsLogQuerySummary* psSummary, tsLogRingBlock* psBlock) {
+	if (psSummary == NULL) {
+		return;
+	}
+	psSummary->u16SeqNo    = psBlock->u16SeqNo;
+	psSummary->u8Fill      = psBlock->u8Fill;
+	psSummary->u16DayMin   = LOG_QUERY_DAY_NONE;
+	psSummary->u16DayMax   = 0;
+	psSummary->u32ClassMap = 0;
+	uint8 u8DataSize = psQuery->psRing->u8DataSize;
+	uint8 u8Val;
+	uint16 u16Day;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < psBlock->u8Fill; u8Idx++) {
+		if ((psBlock->u16ValidMap & (0x0001 << u8Idx)) == 0) {
+			continue;
+		}
+		u8Val = psBlock->u8Data[u8DataSize * u8Idx + psQuery->u8ClassOffset];
+		psSummary->u32ClassMap |= LOG_QUERY_CLASS_BIT(u8Val & psQuery->u8ClassMask);
+		if ((u8Val & psQuery->u8KeyInvalidMask) != 0) {
+			continue;
+		}
+		u16Day = LOG_QUERY_KEY_TO_DAY(psBlock->u32Key[u8Idx]);
+		if (psSummary->u16DayMin == LOG_QUERY_DAY_NONE || u16Day < psSummary->u16DayMin) {
+			psSummary->u16DayMin = u16Day;
+		}
+		if (u16Day > psSummary->u16DayMax) {
+			psSummary->u16DayMax = u16Day;
+		}
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: iLogQuery_findEntry
+ *
+ * DESCRIPTION:ブロック内のエントリの検索
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogQuery*    psQuery         R   ログ検索
+ *   tsLogQueryCond* psCond         R   検索条件
+ *   tsLogRingBlock* psBlock        R   ブロックの読み込み結果
+ *   int            iIdx            R   探索開始のブロック内のエントリ位置
+ *   bool_t         bForwardFlg     R   順方向探索フラグ
+ *
+ * RETURNS:
+ *   int            一致したブロック内のエントリ位置、一致しない場合は-1
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE int iLogQuery_findEntry(tsLogQuery* psQuery, const tsLogQueryCond* psCond, tsLogRingBlock* psBlock,
+								int iIdx, bool_t bForwardFlg) {
+	uint8 u8DataSize = psQuery->psRing->u8DataSize;
+	int iAdd = bForwardFlg ? 1 : -1;
+	if (iIdx >= psBlock->u8Fill) {
+		iIdx = psBlock->u8Fill - 1;
+	}
+	uint8 u8Val;
+	uint16 u16Day;
+	for (; iIdx >= 0 && iIdx < psBlock->u8Fill; iIdx += iAdd) {
+		if ((psBlock->u16ValidMap & (0x0001 << iIdx)) == 0) {
+			continue;
+		}
+		// 分類判定
+		u8Val = psBlock->u8Data[u8DataSize * iIdx + psQuery->u8ClassOffset];
+		if ((psCond->u32ClassMap & LOG_QUERY_CLASS_BIT(u8Val & psQuery->u8ClassMask)) == 0) {
+			continue;
+		}
+		// 日付判定（キー無効のエントリは対象外）
+		if (psCond->u16DayFrom != LOG_QUERY_DAY_NONE) {
+			if ((u8Val & psQuery->u8KeyInvalidMask) != 0) {
+				continue;
+			}
+			u16Day = LOG_QUERY_KEY_TO_DAY(psBlock->u32Key[iIdx]);
+			if (u16Day < psCond->u16DayFrom || u16Day > psCond->u16DayTo) {
+				continue;
+			}
+		}
+		return iIdx;
+	}
+	return -1;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ * MODULE :Log Query functions header file
+ *
+ * CREATED:2026/10/19 06:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ログリングのブロック毎の集計情報（日の範囲と分類のマップ）をRAM上に保持し、
+ *   日付や分類でログを検索する関数群
+ *   Log Query functions (header file)
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  LOGQUERY_H_INCLUDED
+#define  LOGQUERY_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+#include "log_ring.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 最大ブロック数（集計情報の数）
+#ifndef LOG_QUERY_BLOCK_MAX
+	#define LOG_QUERY_BLOCK_MAX    (32)
+#endif
+// １日の秒数
+#define LOG_QUERY_DAY_SEC      (86400)
+// 日の指定無し
+#define LOG_QUERY_DAY_NONE     (0xFFFF)
+// 全ての分類
+#define LOG_QUERY_CLASS_ALL    (0xFFFFFFFF)
+// 未集計
+#define LOG_QUERY_FILL_NONE    (0xFF)
+// キー（経過秒数）から日（経過日数）への変換
+#define LOG_QUERY_KEY_TO_DAY(k)    ((uint16)((k) / LOG_QUERY_DAY_SEC))
+// 分類からマップのビットへの変換（32以上の分類は下位５ビットで重複させる）
+#define LOG_QUERY_CLASS_BIT(c)     ((uint32)0x01 << ((c) & 0x1F))
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：検索条件
+typedef struct {
+	// 対象日（開始、LOG_QUERY_DAY_NONEの場合は日を問わない）
+	uint16 u16DayFrom;
+	// 対象日（終了）
+	uint16 u16DayTo;
+	// 対象の分類のマップ
+	uint32 u32ClassMap;
+} tsLogQueryCond;
+
+// 構造体：ブロックの集計情報
+typedef struct {
+	// 集計時のブロックのシーケンス番号
+	uint16 u16SeqNo;
+	// 集計済みのエントリ位置の数（LOG_QUERY_FILL_NONE：未集計）
+	uint8 u8Fill;
+	// 有効なエントリの日の最小値（LOG_QUERY_DAY_NONE：日付のあるエントリ無し）
+	uint16 u16DayMin;
+	// 有効なエントリの日の最大値
+	uint16 u16DayMax;
+	// 有効なエントリの分類のマップ
+	uint32 u32ClassMap;
+} tsLogQuerySummary;
+
+// 構造体：ログ検索
+typedef struct {
+	// 対象のログリング
+	tsLogRing* psRing;
+	// 分類：データ内の位置
+	uint8 u8ClassOffset;
+	// 分類：マスク
+	uint8 u8ClassMask;
+	// キー無効フラグのマスク（分類と同じ位置のデータ）
+	uint8 u8KeyInvalidMask;
+	// ブロック毎の集計情報（ブロックの物理位置順）
+	tsLogQuerySummary sSummary[LOG_QUERY_BLOCK_MAX];
+	// 統計情報：ブロックの読み込み回数
+	uint32 u32ReadCnt;
+	// 統計情報：集計情報によって読み込みを省略したブロック数
+	uint32 u32SkipCnt;
+} tsLogQuery;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/** 初期化 */
+PUBLIC void vLogQuery_init(tsLogQuery* psQuery, tsLogRing* psRing, uint8 u8ClassOffset, uint8 u8ClassMask, uint8 u8KeyInvalidMask);
+/** 集計情報の破棄 */
+PUBLIC void vLogQuery_invalidate(tsLogQuery* psQuery);
+/** 検索条件の編集 */
+PUBLIC void vLogQuery_setCond(tsLogQueryCond* psCond, uint16 u16DayFrom, uint16 u16DayTo, uint32 u32ClassMap);
+/** ログの検索 */
+PUBLIC int iLogQuery_find(tsLogQuery* psQuery, const tsLogQueryCond* psCond, uint16 u16Pos, bool_t bForwardFlg,
+						  uint32* pu32Key, uint8* pu8Data, uint8 u8Len, uint16* pu16SeqNo);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* LOGQUERY_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,691 @@
+/****************************************************************************
+ *
+ * MODULE :Log Ring functions source file
+ *
+ * CREATED:2026/10/19 02:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   EEPROM上の固定長ブロック領域をリングバッファとして使用し、
+ *   ログを追記する関数群（ログ構造化リング）
+ *   Log Ring functions (source file)
+ *   ・ブロックの先頭にシーケンス番号と基準キー（時刻等）とCRC-16のヘッダを付与し、
+ *     ブロック内にはキーの差分とデータとCRC-8のエントリを順に追記する
+ *   ・件数や書き込み位置はEEPROMに保存せず、起動時にブロックのシーケンス番号を
+ *     二分探索して復元する（インデックスの書き換えが不要）
+ *   ・ブロックは先頭から順に周回して上書きするので、書き込み回数は全ページで均等になる
+ *   ・新規ブロックはヘッダと最初のエントリと消去データを１ページで書き込むので、
+ *     ブロック内に過去の周回のエントリは残らない
+ *   ・ブロックサイズはEEPROMのページサイズの約数とする事（ページ跨ぎの防止）
+ *
+ * CHANGE HISTORY:
+ * 2026/10/19 03:00:00 ブロック単位の基準キーと差分エントリによる圧縮形式に変更
+ * 2026/10/19 05:00:00 ログの先読みを追加
+ * 2026/10/19 06:00:00 ブロック単位のログの読み込みを追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <jendefs.h>
+
+#include "crc.h"
+#include "eeprom.h"
+#include "log_ring.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 読み込み結果
+#define LOG_RING_READ_ERR      (-1)		// 読み込みエラー
+#define LOG_RING_READ_NONE     (0)		// 無効（未使用、消去済み、書き込み途中）
+#define LOG_RING_READ_OK       (1)		// 有効
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// ブロックヘッダの読み込み
+PRIVATE int iLogRing_readHeader(tsLogRing* psRing, uint16 u16Block, uint16* pu16SeqNo, uint32* pu32Base);
+// ブロックヘッダの判定
+PRIVATE int iLogRing_chkHeader(uint8* pu8Buff, uint16* pu16SeqNo, uint32* pu32Base);
+// エントリの判定
+PRIVATE int iLogRing_chkEntry(tsLogRing* psRing, uint8* pu8Entry, uint16 u16SeqNo, uint8 u8Idx);
+// エントリのCRC算出
+PRIVATE uint8 u8LogRing_entryCrc(tsLogRing* psRing, uint8* pu8Entry, uint16 u16SeqNo, uint8 u8Idx);
+// エントリの編集
+PRIVATE void vLogRing_setEntry(tsLogRing* psRing, uint8* pu8Entry, uint16 u16SeqNo, uint8 u8Idx,
+								uint32 u32Offset, const uint8* pu8Data, uint8 u8Len);
+// エントリ位置の数の更新
+PRIVATE void vLogRing_updCnt(tsLogRing* psRing);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/*****************************************************************************
+ *
+ * NAME: vLogRing_init
+ *
+ * DESCRIPTION:初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          W   ログリング
+ *   uint16         u16TopAddr      R   領域の先頭アドレス
+ *   uint16         u16BlockCnt     R   ブロック数（２以上）
+ *   uint8          u8BlockSize     R   ブロックサイズ（LOG_RING_BLOCK_MAXまで）
+ *   uint8          u8DataSize      R   エントリのデータサイズ
+ *   bool_t         bAsync          R   追記時に非同期書き込みを使用する
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * EEPROMへのアクセスは行わない、初回アクセス前にbLogRing_recoverを呼び出す事
+ *****************************************************************************/
+PUBLIC void vLogRing_init(tsLogRing* psRing, uint16 u16TopAddr, uint16 u16BlockCnt, uint8 u8BlockSize, uint8 u8DataSize, bool_t bAsync) {
+	psRing->bValid       = FALSE;
+	psRing->bAsync       = bAsync;
+	psRing->u16TopAddr   = u16TopAddr;
+	psRing->u16BlockCnt  = (u16BlockCnt > 2) ? u16BlockCnt : 2;
+	psRing->u8BlockSize  = (u8BlockSize < LOG_RING_BLOCK_MAX) ? u8BlockSize : LOG_RING_BLOCK_MAX;
+	psRing->u8DataSize   = u8DataSize;
+	psRing->u8EntrySize  = u8DataSize + LOG_RING_ENTRY_EXTRA;
+	psRing->u8EntryCnt   = (psRing->u8BlockSize - LOG_RING_HEADER_SIZE) / psRing->u8EntrySize;
+	psRing->u16TailBlock = 0;
+	psRing->u16BlockUsed = 0;
+	psRing->u8HeadFill   = 0;
+	psRing->u32HeadBase  = 0;
+	psRing->u32LastKey   = 0;
+	psRing->u16NextSeq   = 0;
+	psRing->u16Cnt       = 0;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bLogRing_recover
+ *
+ * DESCRIPTION:EEPROMからの復元（先頭と末尾の探索）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          RW  ログリング
+ *
+ * RETURNS:
+ *   bool_t         TRUE:復元成功
+ *
+ * NOTES:
+ * 選択中のEEPROMを参照する
+ * 先頭ブロックからの経過ブロック数とシーケンス番号の差が一致する範囲を二分探索し、
+ * 最新のブロックの位置を求める（ブロック数Nに対してlog2(N)+3回のヘッダ読み込み）
+ * 最新のブロックは全体を読み込んで、有効なエントリ数を求める
+ * 書き込み途中で電源断したブロックとエントリはCRC不一致として除外する
+ *****************************************************************************/
+PUBLIC bool_t bLogRing_recover(tsLogRing* psRing) {
+	psRing->bValid       = FALSE;
+	psRing->u16TailBlock = 0;
+	psRing->u16BlockUsed = 0;
+	psRing->u8HeadFill   = 0;
+	psRing->u32HeadBase  = 0;
+	psRing->u32LastKey   = 0;
+	psRing->u16NextSeq   = 0;
+	psRing->u16Cnt       = 0;
+	uint16 u16BlockCnt = psRing->u16BlockCnt;
+	uint16 u16TopSeq;
+	uint16 u16LastSeq;
+	uint16 u16Seq;
+	uint32 u32Base;
+	//==========================================================================
+	// 最新ブロックの探索
+	//==========================================================================
+	// 先頭ブロックと最終ブロックのヘッダ読み込み
+	int iTopSts = iLogRing_readHeader(psRing, 0, &u16TopSeq, &u32Base);
+	if (iTopSts == LOG_RING_READ_ERR) {
+		return FALSE;
+	}
+	int iLastSts = iLogRing_readHeader(psRing, u16BlockCnt - 1, &u16LastSeq, &u32Base);
+	if (iLastSts == LOG_RING_READ_ERR) {
+		return FALSE;
+	}
+	int iSts;
+	if (iTopSts == LOG_RING_READ_NONE) {
+		// 最終ブロックも無効な場合はログ無し
+		if (iLastSts == LOG_RING_READ_NONE) {
+			psRing->bValid = TRUE;
+			return TRUE;
+		}
+		// 周回後の先頭ブロックへの書き込み途中で電源断
+		psRing->u16TailBlock = 1;
+		psRing->u16BlockUsed = u16BlockCnt - 1;
+		psRing->u16NextSeq   = u16LastSeq + 1;
+	} else {
+		// 先頭ブロックから連番が続く範囲の二分探索
+		uint16 u16Lo = 0;
+		uint16 u16Hi = u16BlockCnt;
+		uint16 u16Mid;
+		while (u16Hi - u16Lo > 1) {
+			u16Mid = (u16Lo + u16Hi) / 2;
+			iSts = iLogRing_readHeader(psRing, u16Mid, &u16Seq, &u32Base);
+			if (iSts == LOG_RING_READ_ERR) {
+				return FALSE;
+			}
+			if (iSts == LOG_RING_READ_OK && u16Seq == (uint16)(u16TopSeq + u16Mid)) {
+				u16Lo = u16Mid;
+			} else {
+				u16Hi = u16Mid;
+			}
+		}
+		// u16Hiが次の書き込み位置
+		psRing->u16NextSeq   = u16TopSeq + u16Hi;
+		psRing->u16BlockUsed = u16Hi;
+		// 周回判定（最終ブロックが先頭ブロックの直前のシーケンス番号）
+		if (u16Hi < u16BlockCnt && iLastSts == LOG_RING_READ_OK && u16LastSeq == (uint16)(u16TopSeq - 1)) {
+			// 次の書き込み位置のブロックが最も古いブロック
+			iSts = iLogRing_readHeader(psRing, u16Hi, &u16Seq, &u32Base);
+			if (iSts == LOG_RING_READ_ERR) {
+				return FALSE;
+			}
+			if (iSts == LOG_RING_READ_OK && u16Seq == (uint16)(psRing->u16NextSeq - u16BlockCnt)) {
+				psRing->u16TailBlock = u16Hi;
+				psRing->u16BlockUsed = u16BlockCnt;
+			} else {
+				// 書き込み途中のブロックは除外
+				psRing->u16TailBlock = (u16Hi + 1) % u16BlockCnt;
+				psRing->u16BlockUsed = u16BlockCnt - 1;
+			}
+		}
+	}
+	//==========================================================================
+	// 最新ブロックのエントリ数の判定
+	//==========================================================================
+	uint8 u8Buff[LOG_RING_BLOCK_MAX];
+	uint16 u16Head = (psRing->u16TailBlock + psRing->u16BlockUsed - 1) % u16BlockCnt;
+	if (bEEPROM_readData(psRing->u16TopAddr + (uint16)psRing->u8BlockSize * u16Head,
+						  psRing->u8BlockSize, u8Buff) == FALSE) {
+		return FALSE;
+	}
+	iLogRing_chkHeader(u8Buff, &u16Seq, &psRing->u32HeadBase);
+	psRing->u32LastKey = psRing->u32HeadBase;
+	uint8* pu8Entry = &u8Buff[LOG_RING_HEADER_SIZE];
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < psRing->u8EntryCnt; u8Idx++) {
+		if (iLogRing_chkEntry(psRing, pu8Entry, u16Seq, u8Idx) != LOG_RING_READ_OK) {
+			break;
+		}
+		psRing->u32LastKey = psRing->u32HeadBase +
+			(((uint32)pu8Entry[0] << 16) | ((uint32)pu8Entry[1] << 8) | pu8Entry[2]);
+		pu8Entry += psRing->u8EntrySize;
+	}
+	psRing->u8HeadFill = u8Idx;
+	vLogRing_updCnt(psRing);
+	psRing->bValid = TRUE;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iLogRing_append
+ *
+ * DESCRIPTION:ログの追記
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          RW  ログリング
+ *   uint32         u32Key          R   キー（時刻等の昇順の値、LOG_RING_KEY_NONEの場合は直前と同じ）
+ *   uint8*         pu8Data         R   ログデータ
+ *   uint8          u8Len           R   ログデータ長（エントリのデータサイズまで）
+ *
+ * RETURNS:
+ *   int            書き込みエントリ位置、エラー時はマイナス値
+ *                  （-1:未復元、-2:書き込みエラー）
+ *
+ * NOTES:
+ * 選択中のEEPROMに書き込む
+ * 最新ブロックが一杯の場合、もしくはキーの差分が最新ブロックに収まらない場合は、
+ * 次のブロックを開始する（全ブロック使用中の場合は最も古いブロックを上書きする）
+ *****************************************************************************/
+PUBLIC int iLogRing_append(tsLogRing* psRing, uint32 u32Key, const uint8* pu8Data, uint8 u8Len) {
+	if (psRing->bValid == FALSE) {
+		return -1;
+	}
+	if (u32Key == LOG_RING_KEY_NONE) {
+		u32Key = psRing->u32LastKey;
+	}
+	if (u8Len > psRing->u8DataSize) {
+		u8Len = psRing->u8DataSize;
+	}
+	uint8 u8Buff[LOG_RING_BLOCK_MAX];
+	uint16 u16Block;
+	uint16 u16Addr;
+	uint8 u8Size;
+	uint32 u32Base = psRing->u32HeadBase;
+	bool_t bNewBlock = (psRing->u16BlockUsed == 0 || psRing->u8HeadFill >= psRing->u8EntryCnt ||
+						u32Key < u32Base || (u32Key - u32Base) > LOG_RING_OFFSET_MAX);
+	if (bNewBlock) {
+		//======================================================================
+		// 新規ブロック（ヘッダと最初のエントリと消去データを１ページで書き込む）
+		//======================================================================
+		u16Block = (psRing->u16TailBlock + psRing->u16BlockUsed) % psRing->u16BlockCnt;
+		u32Base  = (u32Key > LOG_RING_BASE_MARGIN) ? u32Key - LOG_RING_BASE_MARGIN : 0;
+		memset(u8Buff, LOG_RING_ERASE_DATA, psRing->u8BlockSize);
+		u8Buff[0] = (uint8)(psRing->u16NextSeq >> 8);
+		u8Buff[1] = (uint8)psRing->u16NextSeq;
+		u8Buff[2] = (uint8)(u32Base >> 24);
+		u8Buff[3] = (uint8)(u32Base >> 16);
+		u8Buff[4] = (uint8)(u32Base >> 8);
+		u8Buff[5] = (uint8)u32Base;
+		uint16 u16Crc = u16CRC16_calc(u8Buff, 6);
+		u8Buff[6] = (uint8)(u16Crc >> 8);
+		u8Buff[7] = (uint8)u16Crc;
+		vLogRing_setEntry(psRing, &u8Buff[LOG_RING_HEADER_SIZE], psRing->u16NextSeq, 0,
+						  u32Key - u32Base, pu8Data, u8Len);
+		u16Addr = psRing->u16TopAddr + (uint16)psRing->u8BlockSize * u16Block;
+		u8Size  = psRing->u8BlockSize;
+	} else {
+		//======================================================================
+		// 最新ブロックへのエントリの追記
+		//======================================================================
+		u16Block = (psRing->u16TailBlock + psRing->u16BlockUsed - 1) % psRing->u16BlockCnt;
+		vLogRing_setEntry(psRing, u8Buff, psRing->u16NextSeq - 1, psRing->u8HeadFill,
+						  u32Key - u32Base, pu8Data, u8Len);
+		u16Addr = psRing->u16TopAddr + (uint16)psRing->u8BlockSize * u16Block +
+				  LOG_RING_HEADER_SIZE + (uint16)psRing->u8EntrySize * psRing->u8HeadFill;
+		u8Size  = psRing->u8EntrySize;
+	}
+	// I2C EEPROM Write
+	bool_t bResult;
+	if (psRing->bAsync) {
+		// 書き込み完了はイベントループで待つ
+		bResult = bEEPROM_writeAsync(u16Addr, u8Size, u8Buff, E_EVENT_FWK_EMPTY);
+	} else {
+		bResult = bEEPROM_writeData(u16Addr, u8Size, u8Buff);
+	}
+	if (bResult == FALSE) {
+		return -2;
+	}
+	// 位置情報の更新
+	if (bNewBlock) {
+		if (psRing->u16BlockUsed < psRing->u16BlockCnt) {
+			psRing->u16BlockUsed++;
+		} else {
+			psRing->u16TailBlock = (psRing->u16TailBlock + 1) % psRing->u16BlockCnt;
+		}
+		psRing->u8HeadFill  = 0;
+		psRing->u32HeadBase = u32Base;
+		psRing->u16NextSeq++;
+	}
+	psRing->u8HeadFill++;
+	psRing->u32LastKey = u32Key;
+	vLogRing_updCnt(psRing);
+	return psRing->u16Cnt - 1;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iLogRing_read
+ *
+ * DESCRIPTION:ログの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   uint16         u16Pos          R   エントリ位置（0が最も古いブロックの先頭）
+ *   uint32*        pu32Key         W   キー
+ *   uint8*         pu8Data         W   ログデータ
+ *   uint8          u8Len           R   ログデータ長
+ *   uint16*        pu16SeqNo       W   エントリのシーケンス番号（不要な場合はNULL）
+ *
+ * RETURNS:
+ *   int            読み込みエントリ位置、エラー時はマイナス値
+ *                  （-1:範囲外、-2:読み込みエラー、-3:エントリ無し）
+ *
+ * NOTES:
+ * 選択中のEEPROMから読み込む
+ * 途中で閉じたブロックの未使用エントリと、書き込み途中のエントリはエントリ無しとする
+ * エントリのシーケンス番号は、ブロックのシーケンス番号×ブロック当たりのエントリ数＋ブロック内位置
+ *****************************************************************************/
+PUBLIC int iLogRing_read(tsLogRing* psRing, uint16 u16Pos, uint32* pu32Key, uint8* pu8Data, uint8 u8Len, uint16* pu16SeqNo) {
+	if (psRing->bValid == FALSE || u16Pos >= psRing->u16Cnt) {
+		return -1;
+	}
+	// ブロックの先頭から対象エントリまでを読み込み
+	uint8 u8Buff[LOG_RING_BLOCK_MAX];
+	uint16 u16BlockIdx = u16Pos / psRing->u8EntryCnt;
+	uint8 u8Idx = u16Pos % psRing->u8EntryCnt;
+	uint16 u16Block = (psRing->u16TailBlock + u16BlockIdx) % psRing->u16BlockCnt;
+	uint8 u8Size = LOG_RING_HEADER_SIZE + psRing->u8EntrySize * (u8Idx + 1);
+	if (bEEPROM_readData(psRing->u16TopAddr + (uint16)psRing->u8BlockSize * u16Block, u8Size, u8Buff) == FALSE) {
+		return -2;
+	}
+	// ブロックヘッダ判定（書き込み後に上書きされていない事）
+	uint16 u16Seq;
+	uint32 u32Base;
+	if (iLogRing_chkHeader(u8Buff, &u16Seq, &u32Base) != LOG_RING_READ_OK ||
+		u16Seq != (uint16)(psRing->u16NextSeq - psRing->u16BlockUsed + u16BlockIdx)) {
+		return -3;
+	}
+	// エントリ判定
+	uint8* pu8Entry = &u8Buff[LOG_RING_HEADER_SIZE + psRing->u8EntrySize * u8Idx];
+	if (iLogRing_chkEntry(psRing, pu8Entry, u16Seq, u8Idx) != LOG_RING_READ_OK) {
+		return -3;
+	}
+	// デコード
+	*pu32Key = u32Base + (((uint32)pu8Entry[0] << 16) | ((uint32)pu8Entry[1] << 8) | pu8Entry[2]);
+	if (u8Len > psRing->u8DataSize) {
+		u8Len = psRing->u8DataSize;
+	}
+	memcpy(pu8Data, &pu8Entry[3], u8Len);
+	if (pu16SeqNo != NULL) {
+		*pu16SeqNo = u16Seq * psRing->u8EntryCnt + u8Idx;
+	}
+	return u16Pos;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bLogRing_clear
+ *
+ * DESCRIPTION:全ログの消去
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          RW  ログリング
+ *
+ * RETURNS:
+ *   bool_t         TRUE:消去成功
+ *
+ * NOTES:
+ * 選択中のEEPROMの全ブロックを消去する
+ * 消去前のブロックが復元時に連番と誤認されない様に、全ブロックを無効化する
+ *****************************************************************************/
+PUBLIC bool_t bLogRing_clear(tsLogRing* psRing) {
+	psRing->bValid = FALSE;
+	uint8 u8Buff[LOG_RING_BLOCK_MAX];
+	memset(u8Buff, LOG_RING_ERASE_DATA, psRing->u8BlockSize);
+	// I2C EEPROM Write
+	uint16 u16Addr = psRing->u16TopAddr;
+	uint16 u16Block;
+	for (u16Block = 0; u16Block < psRing->u16BlockCnt; u16Block++) {
+		if (bEEPROM_writeData(u16Addr, psRing->u8BlockSize, u8Buff) == FALSE) {
+			return FALSE;
+		}
+		u16Addr += psRing->u8BlockSize;
+	}
+	// シーケンス番号は継続する
+	psRing->u16TailBlock = 0;
+	psRing->u16BlockUsed = 0;
+	psRing->u8HeadFill   = 0;
+	psRing->u16Cnt       = 0;
+	psRing->bValid       = TRUE;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bLogRing_prefetch
+ *
+ * DESCRIPTION:ログの先読み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   uint16         u16Pos          R   次に読み込むエントリ位置
+ *
+ * RETURNS:
+ *   bool_t         TRUE:先読み成功もしくは先読み不要
+ *
+ * NOTES:
+ * 選択中のEEPROMのエントリ位置を含むブロックをキャッシュに読み込む
+ * 画面描画後のアイドル時等に呼び出して、次のiLogRing_readをキャッシュから行える様にする
+ *****************************************************************************/
+PUBLIC bool_t bLogRing_prefetch(tsLogRing* psRing, uint16 u16Pos) {
+	if (psRing->bValid == FALSE || u16Pos >= psRing->u16Cnt) {
+		return FALSE;
+	}
+	uint16 u16Block = (psRing->u16TailBlock + u16Pos / psRing->u8EntryCnt) % psRing->u16BlockCnt;
+	return bEEPROM_prefetch(psRing->u16TopAddr + (uint16)psRing->u8BlockSize * u16Block, psRing->u8BlockSize);
+}
+
+/*****************************************************************************
+ *
+ * NAME: iLogRing_readBlock
+ *
+ * DESCRIPTION:ブロック単位のログの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   uint16         u16BlockIdx     R   ブロック位置（0が最も古いブロック）
+ *   tsLogRingBlock* psBlock        W   ブロックの読み込み結果
+ *
+ * RETURNS:
+ *   int            読み込んだエントリ位置の数、エラー時はマイナス値
+ *                  （-1:範囲外、-2:読み込みエラー、-3:ブロック無し）
+ *
+ * NOTES:
+ * 選択中のEEPROMから、ブロックの使用中の範囲を１回で読み込んでデコードする
+ * ブロック内のエントリ位置iのエントリ位置は、u16BlockIdx×ブロック当たりのエントリ数＋i
+ * エントリのシーケンス番号は、ブロックのシーケンス番号×ブロック当たりのエントリ数＋i
+ *****************************************************************************/
+PUBLIC int iLogRing_readBlock(tsLogRing* psRing, uint16 u16BlockIdx, tsLogRingBlock* psBlock) {
+	if (psRing->bValid == FALSE || u16BlockIdx >= psRing->u16BlockUsed) {
+		return -1;
+	}
+	// ブロックの先頭から最後のエントリまでを読み込み
+	uint8 u8Buff[LOG_RING_BLOCK_MAX];
+	uint8 u8Fill = psRing->u8EntryCnt;
+	if (u16BlockIdx == psRing->u16BlockUsed - 1) {
+		u8Fill = psRing->u8HeadFill;
+	}
+	uint16 u16Block = (psRing->u16TailBlock + u16BlockIdx) % psRing->u16BlockCnt;
+	uint8 u8Size = LOG_RING_HEADER_SIZE + psRing->u8EntrySize * u8Fill;
+	if (bEEPROM_readData(psRing->u16TopAddr + (uint16)psRing->u8BlockSize * u16Block, u8Size, u8Buff) == FALSE) {
+		return -2;
+	}
+	// ブロックヘッダ判定（書き込み後に上書きされていない事）
+	uint32 u32Base;
+	if (iLogRing_chkHeader(u8Buff, &psBlock->u16SeqNo, &u32Base) != LOG_RING_READ_OK ||
+		psBlock->u16SeqNo != (uint16)(psRing->u16NextSeq - psRing->u16BlockUsed + u16BlockIdx)) {
+		return -3;
+	}
+	// エントリのデコード
+	psBlock->u8Fill      = u8Fill;
+	psBlock->u16ValidMap = 0;
+	uint8* pu8Entry = &u8Buff[LOG_RING_HEADER_SIZE];
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < u8Fill; u8Idx++) {
+		if (iLogRing_chkEntry(psRing, pu8Entry, psBlock->u16SeqNo, u8Idx) == LOG_RING_READ_OK) {
+			psBlock->u16ValidMap |= (0x0001 << u8Idx);
+			psBlock->u32Key[u8Idx] = u32Base +
+				(((uint32)pu8Entry[0] << 16) | ((uint32)pu8Entry[1] << 8) | pu8Entry[2]);
+			memcpy(&psBlock->u8Data[psRing->u8DataSize * u8Idx], &pu8Entry[3], psRing->u8DataSize);
+		}
+		pu8Entry += psRing->u8EntrySize;
+	}
+	return u8Fill;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: iLogRing_readHeader
+ *
+ * DESCRIPTION:ブロックヘッダの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   uint16         u16Block        R   ブロック位置
+ *   uint16*        pu16SeqNo       W   シーケンス番号
+ *   uint32*        pu32Base        W   基準キー
+ *
+ * RETURNS:
+ *   int            LOG_RING_READ_OK:有効、LOG_RING_READ_NONE:無効、
+ *                  LOG_RING_READ_ERR:読み込みエラー
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE int iLogRing_readHeader(tsLogRing* psRing, uint16 u16Block, uint16* pu16SeqNo, uint32* pu32Base) {
+	uint8 u8Buff[LOG_RING_HEADER_SIZE];
+	uint16 u16Addr = psRing->u16TopAddr + (uint16)psRing->u8BlockSize * u16Block;
+	if (bEEPROM_readData(u16Addr, LOG_RING_HEADER_SIZE, u8Buff) == FALSE) {
+		return LOG_RING_READ_ERR;
+	}
+	return iLogRing_chkHeader(u8Buff, pu16SeqNo, pu32Base);
+}
+
+/*****************************************************************************
+ *
+ * NAME: iLogRing_chkHeader
+ *
+ * DESCRIPTION:ブロックヘッダの判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8*         pu8Buff         R   ブロックヘッダ
+ *   uint16*        pu16SeqNo       W   シーケンス番号
+ *   uint32*        pu32Base        W   基準キー
+ *
+ * RETURNS:
+ *   int            LOG_RING_READ_OK:有効、LOG_RING_READ_NONE:無効
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE int iLogRing_chkHeader(uint8* pu8Buff, uint16* pu16SeqNo, uint32* pu32Base) {
+	// CRC判定
+	uint16 u16Crc = ((uint16)pu8Buff[6] << 8) | pu8Buff[7];
+	if (u16Crc != u16CRC16_calc(pu8Buff, 6)) {
+		return LOG_RING_READ_NONE;
+	}
+	*pu16SeqNo = ((uint16)pu8Buff[0] << 8) | pu8Buff[1];
+	*pu32Base  = ((uint32)pu8Buff[2] << 24) | ((uint32)pu8Buff[3] << 16) |
+				 ((uint32)pu8Buff[4] << 8) | pu8Buff[5];
+	return LOG_RING_READ_OK;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iLogRing_chkEntry
+ *
+ * DESCRIPTION:エントリの判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   uint8*         pu8Entry        R   エントリ
+ *   uint16         u16SeqNo        R   ブロックのシーケンス番号
+ *   uint8          u8Idx           R   ブロック内のエントリ位置
+ *
+ * RETURNS:
+ *   int            LOG_RING_READ_OK:有効、LOG_RING_READ_NONE:無効
+ *
+ * NOTES:
+ * キー差分の全ビット1は消去済みとして扱う
+ *****************************************************************************/
+PRIVATE int iLogRing_chkEntry(tsLogRing* psRing, uint8* pu8Entry, uint16 u16SeqNo, uint8 u8Idx) {
+	// 消去済み判定
+	if (pu8Entry[0] == LOG_RING_ERASE_DATA && pu8Entry[1] == LOG_RING_ERASE_DATA &&
+		pu8Entry[2] == LOG_RING_ERASE_DATA) {
+		return LOG_RING_READ_NONE;
+	}
+	// CRC判定
+	if (pu8Entry[psRing->u8EntrySize - 1] != u8LogRing_entryCrc(psRing, pu8Entry, u16SeqNo, u8Idx)) {
+		return LOG_RING_READ_NONE;
+	}
+	return LOG_RING_READ_OK;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8LogRing_entryCrc
+ *
+ * DESCRIPTION:エントリのCRC算出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   uint8*         pu8Entry        R   エントリ
+ *   uint16         u16SeqNo        R   ブロックのシーケンス番号
+ *   uint8          u8Idx           R   ブロック内のエントリ位置
+ *
+ * RETURNS:
+ *   uint8          ブロックのシーケンス番号とエントリ位置とエントリ内容のCRC-16の下位バイト
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8LogRing_entryCrc(tsLogRing* psRing, uint8* pu8Entry, uint16 u16SeqNo, uint8 u8Idx) {
+	uint8 u8Pos[3];
+	u8Pos[0] = (uint8)(u16SeqNo >> 8);
+	u8Pos[1] = (uint8)u16SeqNo;
+	u8Pos[2] = u8Idx;
+	uint16 u16Crc = u16CRC16_update(CRC16_INIT, u8Pos, 3);
+	return (uint8)u16CRC16_update(u16Crc, pu8Entry, psRing->u8EntrySize - 1);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vLogRing_setEntry
+ *
+ * DESCRIPTION:エントリの編集
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          R   ログリング
+ *   uint8*         pu8Entry        W   エントリ
+ *   uint16         u16SeqNo        R   ブロックのシーケンス番号
+ *   uint8          u8Idx           R   ブロック内のエントリ位置
+ *   uint32         u32Offset       R   キー差分
+ *   uint8*         pu8Data         R   ログデータ
+ *   uint8          u8Len           R   ログデータ長
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vLogRing_setEntry(tsLogRing* psRing, uint8* pu8Entry, uint16 u16SeqNo, uint8 u8Idx,
+								uint32 u32Offset, const uint8* pu8Data, uint8 u8Len) {
+	memset(pu8Entry, 0x00, psRing->u8EntrySize);
+	pu8Entry[0] = (uint8)(u32Offset >> 16);
+	pu8Entry[1] = (uint8)(u32Offset >> 8);
+	pu8Entry[2] = (uint8)u32Offset;
+	memcpy(&pu8Entry[3], pu8Data, u8Len);
+	pu8Entry[psRing->u8EntrySize - 1] = u8LogRing_entryCrc(psRing, pu8Entry, u16SeqNo, u8Idx);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vLogRing_updCnt
+ *
+ * DESCRIPTION:エントリ位置の数の更新
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsLogRing*     psRing          RW  ログリング
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vLogRing_updCnt(tsLogRing* psRing) {
+	if (psRing->u16BlockUsed == 0) {
+		psRing->u16Cnt = 0;
+		return;
+	}
+	psRing->u16Cnt = (psRing->u16BlockUsed - 1) * psRing->u8EntryCnt + psRing->u8HeadFill;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ * MODULE :Log Ring functions header file
+ *
+ * CREATED:2026/10/19 02:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   EEPROM上の固定長ブロック領域をリングバッファとして使用し、
+ *   ログを追記する関数群（ログ構造化リング）
+ *   Log Ring functions (header file)
+ *
+ * CHANGE HISTORY:
+ * 2026/10/19 03:00:00 ブロック単位の基準キーと差分エントリによる圧縮形式に変更
+ * 2026/10/19 05:00:00 ログの先読みを追加
+ * 2026/10/19 06:00:00 ブロック単位のログの読み込みを追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  LOGRING_H_INCLUDED
+#define  LOGRING_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// ブロックヘッダサイズ（シーケンス番号２バイト＋基準キー４バイト＋CRC-16の２バイト）
+#define LOG_RING_HEADER_SIZE   (8)
+// エントリの付加情報サイズ（キー差分３バイト＋CRC-8の１バイト）
+#define LOG_RING_ENTRY_EXTRA   (4)
+// 最大ブロックサイズ
+#define LOG_RING_BLOCK_MAX     (64)
+// ブロック当たりの最大エントリ数（データサイズが１バイトの場合）
+#define LOG_RING_ENTRY_MAX     ((LOG_RING_BLOCK_MAX - LOG_RING_HEADER_SIZE) / (LOG_RING_ENTRY_EXTRA + 1))
+// キー差分の最大値（全ビット1は消去済みデータと区別する為に使用しない）
+#define LOG_RING_OFFSET_MAX    (0x00FFFFFE)
+// 新規ブロックの基準キーの余裕（基準キーより小さいキーを同一ブロックに記録する為）
+#define LOG_RING_BASE_MARGIN   (0x00010000)
+// キー無し（直前のエントリと同じキーで記録する）
+#define LOG_RING_KEY_NONE      (0xFFFFFFFF)
+// 消去済みデータ
+#define LOG_RING_ERASE_DATA    (0xFF)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：ログリング
+typedef struct {
+	// 復元済みフラグ
+	bool_t bValid;
+	// 非同期書き込みフラグ
+	bool_t bAsync;
+	// 領域の先頭アドレス
+	uint16 u16TopAddr;
+	// ブロック数
+	uint16 u16BlockCnt;
+	// ブロックサイズ（EEPROMのページサイズ以下）
+	uint8 u8BlockSize;
+	// エントリのデータサイズ
+	uint8 u8DataSize;
+	// エントリサイズ（付加情報を含む）
+	uint8 u8EntrySize;
+	// ブロック当たりのエントリ数
+	uint8 u8EntryCnt;
+	// 最も古いブロックの位置
+	uint16 u16TailBlock;
+	// 使用中のブロック数
+	uint16 u16BlockUsed;
+	// 最新ブロックのエントリ数
+	uint8 u8HeadFill;
+	// 最新ブロックの基準キー
+	uint32 u32HeadBase;
+	// 最新エントリのキー
+	uint32 u32LastKey;
+	// 次に書き込むブロックのシーケンス番号
+	uint16 u16NextSeq;
+	// エントリ位置の数（最も古いブロックの先頭から最新エントリまで）
+	uint16 u16Cnt;
+} tsLogRing;
+
+// 構造体：ブロックの読み込み結果
+typedef struct {
+	// ブロックのシーケンス番号
+	uint16 u16SeqNo;
+	// 読み込んだエントリ位置の数
+	uint8 u8Fill;
+	// 有効なエントリのマップ（ビット位置はブロック内のエントリ位置）
+	uint16 u16ValidMap;
+	// エントリ毎のキー
+	uint32 u32Key[LOG_RING_ENTRY_MAX];
+	// エントリ毎のデータ（データサイズ毎に詰めて格納）
+	uint8 u8Data[LOG_RING_BLOCK_MAX];
+} tsLogRingBlock;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+/** 初期化 */
+PUBLIC void vLogRing_init(tsLogRing* psRing, uint16 u16TopAddr, uint16 u16BlockCnt, uint8 u8BlockSize, uint8 u8DataSize, bool_t bAsync);
+/** EEPROMからの復元（先頭と末尾の探索） */
+PUBLIC bool_t bLogRing_recover(tsLogRing* psRing);
+/** ログの追記 */
+PUBLIC int iLogRing_append(tsLogRing* psRing, uint32 u32Key, const uint8* pu8Data, uint8 u8Len);
+/** ログの読み込み */
+PUBLIC int iLogRing_read(tsLogRing* psRing, uint16 u16Pos, uint32* pu32Key, uint8* pu8Data, uint8 u8Len, uint16* pu16SeqNo);
+/** 全ログの消去 */
+PUBLIC bool_t bLogRing_clear(tsLogRing* psRing);
+/** ログの先読み */
+PUBLIC bool_t bLogRing_prefetch(tsLogRing* psRing, uint16 u16Pos);
+/** ブロック単位のログの読み込み */
+PUBLIC int iLogRing_readBlock(tsLogRing* psRing, uint16 u16BlockIdx, tsLogRingBlock* psBlock);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* LOGRING_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
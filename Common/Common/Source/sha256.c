@@ -11,6 +11,9 @@
  *             FIP180-2(http://csrc.nist.gov/publications/fips/fips180-2/fips180-2.pdf)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 32バイトメッセージ用の1ブロック高速ハッシュ生成を追加
+ * 2026/10/18 15:00:00 圧縮関数のバックエンドを差し替え可能にし、高速版を追加
+ * 2026/10/19 22:00:00 32バイトメッセージのハッシュ値をバイト順に依存せず格納
  *
  * LAST MODIFIED BY:
  *
@@ -80,6 +83,22 @@ typedef union {
  */
 PRIVATE void vSHA256_updateHashValue(SHA256_state *psState);
 
+/**
+ *	圧縮関数（参照実装）
+ *
+ *	@param pu32Hash ハッシュ値
+ *	@param pu8Block メッセージブロック
+ */
+PRIVATE void vSHA256_compressRef(uint32 *pu32Hash, const uint8 *pu8Block);
+
+/**
+ *	圧縮関数（高速実装）
+ *
+ *	@param pu32Hash ハッシュ値
+ *	@param pu8Block メッセージブロック
+ */
+PRIVATE void vSHA256_compressFast(uint32 *pu32Hash, const uint8 *pu8Block);
+
 /****************************************************************************/
 /***        Exported Variables                                            ***/
 /****************************************************************************/
@@ -101,6 +120,15 @@ PRIVATE const uint32 SHA256_K[64] = {
 	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+// 組込みのバックエンド
+PRIVATE const SHA256_backend SHA256_BACKENDS[SHA256_BACKEND_CNT] = {
+	{"REF",  vSHA256_compressRef},
+	{"FAST", vSHA256_compressFast}
+};
+
+// デフォルトバックエンド
+PRIVATE const SHA256_backend *psDefaultBackend = &SHA256_BACKENDS[SHA256_BACKEND_FAST];
+
 /****************************************************************************/
 /***        Exported Functions                                            ***/
 /****************************************************************************/
@@ -124,6 +152,8 @@ PUBLIC SHA256_state sSHA256_newState() {
 	state.u32MsgBlockIdx = 0;
 	// メッセージ長（累積値）
 	state.u32MsgLen = 0;
+	// 圧縮関数のバックエンド
+	state.psBackend = psDefaultBackend;
 	// 初期化された構造体の返却
 	return state;
 }
@@ -192,6 +222,67 @@ PUBLIC void vSHA256_generateHash(SHA256_state *psState, uint8 *pu8Hash) {
 	memcpy(conv.u8MsgBlock, pu8Hash, 32);
 }
 
+/**
+ * 32バイトのメッセージからハッシュコードの生成処理
+ * ハッシュストレッチングの様にメッセージ長が32バイト固定の場合、
+ * 終端ビットとビット長を含めて1ブロックに収まるので、
+ * メッセージの追加処理と終端処理を省略して直接ブロックを編集する
+ *
+ *	@param pu8Msg  メッセージ（32バイト）の先頭のポインタ
+ *	@param pu8Hash 結果を代入する配列へのポインタ(256bit必要です)
+ */
+PUBLIC void vSHA256_generateHash32(const uint8 *pu8Msg, uint8 *pu8Hash) {
+	SHA256_state state = sSHA256_newState();
+	// メッセージ編集
+	memcpy(state.u8MsgBlock, pu8Msg, 32);
+	// 終端ビット編集
+	state.u8MsgBlock[32] = 0x80;
+	// 文字列ビット長編集（256bit）
+	state.u8MsgBlock[62] = 0x01;
+	// 1ブロック分のハッシュ更新処理
+	vSHA256_updateHashValue(&state);
+	// 演算結果のコピー（ビッグエンディアンで格納し、ホスト環境でも実機と同じバイト列とする）
+	int i;
+	for (i = 0; i < 8; i++) {
+		pu8Hash[i * 4]     = (uint8)(state.u32Hash[i] >> 24);
+		pu8Hash[i * 4 + 1] = (uint8)(state.u32Hash[i] >> 16);
+		pu8Hash[i * 4 + 2] = (uint8)(state.u32Hash[i] >> 8);
+		pu8Hash[i * 4 + 3] = (uint8)state.u32Hash[i];
+	}
+}
+
+/**
+ * 組込みバックエンドの取得
+ *
+ *	@param eType バックエンド種別
+ *	@return バックエンド、種別が不正な場合はNULL
+ */
+PUBLIC const SHA256_backend *psSHA256_getBackend(SHA256_backendType eType) {
+	if (eType >= SHA256_BACKEND_CNT) {
+		return NULL;
+	}
+	return &SHA256_BACKENDS[eType];
+}
+
+/**
+ * デフォルトバックエンドの設定
+ *
+ *	@param psBackend バックエンド
+ */
+PUBLIC void vSHA256_setDefaultBackend(const SHA256_backend *psBackend) {
+	psDefaultBackend = psBackend;
+}
+
+/**
+ * バックエンドの設定
+ *
+ *	@param psState ハッシュコード生成処理ステータス情報
+ *	@param psBackend バックエンド
+ */
+PUBLIC void vSHA256_setBackend(SHA256_state *psState, const SHA256_backend *psBackend) {
+	psState->psBackend = psBackend;
+}
+
 /****************************************************************************/
 /***        Local Functions                                               ***/
 /****************************************************************************/
@@ -199,9 +290,23 @@ PUBLIC void vSHA256_generateHash(SHA256_state *psState, uint8 *pu8Hash) {
  * ハッシュ値の更新処理
  */
 PRIVATE void vSHA256_updateHashValue(SHA256_state *psState){
+	// バックエンドの圧縮関数でハッシュ値を更新
+	psState->psBackend->pfCompress(psState->u32Hash, psState->u8MsgBlock);
+	// ブロックの初期化
+	memset(psState->u8MsgBlock, 0, SHA256_MSGBLK_SIZE);
+	// ブロック内インデックスの初期化
+	psState->u32MsgBlockIdx = 0;
+}
+
+/**
+ * 圧縮関数（参照実装）
+ * 拡張メッセージ64ワードを展開してからラウンド処理を行う
+ * メッセージブロックはワードとして直接参照する（ビッグエンディアン前提）
+ */
+PRIVATE void vSHA256_compressRef(uint32 *pu32Hash, const uint8 *pu8Block){
 	// メッセージブロックの変換
 	SHA256_blockConv conv;
-	memcpy(conv.u8MsgBlock, psState->u8MsgBlock, SHA256_MSGBLK_SIZE);
+	memcpy(conv.u8MsgBlock, pu8Block, SHA256_MSGBLK_SIZE);
 	// 拡張分のブロック生成
 	int i;
 	for (i=16; i < 64; i++) {
@@ -210,7 +315,7 @@ PRIVATE void vSHA256_updateHashValue(SHA256_state *psState){
 	}
 	// ハッシュ値配列初期化
 	uint32 wkHash[8];
-	memcpy(wkHash, psState->u32Hash, 32);
+	memcpy(wkHash, pu32Hash, 32);
 	int idxList[] = {1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7};
 	int idx, idxA, idxB, idxC, idxD, idxE, idxF, idxG, idxH;
 	uint32 t1, t2;
@@ -234,16 +339,64 @@ PRIVATE void vSHA256_updateHashValue(SHA256_state *psState){
 		wkHash[idxH] = t1 + t2;
 	}
 	// ハッシュ値の更新
-	psState->u32Hash[0] += wkHash[0];
-	psState->u32Hash[1] += wkHash[1];
-	psState->u32Hash[2] += wkHash[2];
-	psState->u32Hash[3] += wkHash[3];
-	psState->u32Hash[4] += wkHash[4];
-	psState->u32Hash[5] += wkHash[5];
-	psState->u32Hash[6] += wkHash[6];
-	psState->u32Hash[7] += wkHash[7];
-	// ブロックの初期化
-	memset(psState->u8MsgBlock, 0, SHA256_MSGBLK_SIZE);
-	// ブロック内インデックスの初期化
-	psState->u32MsgBlockIdx = 0;
+	pu32Hash[0] += wkHash[0];
+	pu32Hash[1] += wkHash[1];
+	pu32Hash[2] += wkHash[2];
+	pu32Hash[3] += wkHash[3];
+	pu32Hash[4] += wkHash[4];
+	pu32Hash[5] += wkHash[5];
+	pu32Hash[6] += wkHash[6];
+	pu32Hash[7] += wkHash[7];
+}
+
+/**
+ * 圧縮関数（高速実装）
+ * 拡張メッセージは直近16ワードのみをリングバッファで保持してラウンド毎に生成し、
+ * 作業変数はインデックス表を介さずに直接入れ替える
+ */
+PRIVATE void vSHA256_compressFast(uint32 *pu32Hash, const uint8 *pu8Block){
+	// メッセージブロックをビッグエンディアンのワードとして読み込み
+	uint32 w[16];
+	int i;
+	for (i = 0; i < 16; i++) {
+		w[i] = ((uint32)pu8Block[i * 4] << 24) | ((uint32)pu8Block[i * 4 + 1] << 16)
+		     | ((uint32)pu8Block[i * 4 + 2] << 8) | (uint32)pu8Block[i * 4 + 3];
+	}
+	// 作業変数の初期化
+	uint32 a = pu32Hash[0];
+	uint32 b = pu32Hash[1];
+	uint32 c = pu32Hash[2];
+	uint32 d = pu32Hash[3];
+	uint32 e = pu32Hash[4];
+	uint32 f = pu32Hash[5];
+	uint32 g = pu32Hash[6];
+	uint32 h = pu32Hash[7];
+	uint32 t1, t2;
+	int round;
+	for (round = 0; round < 64; round++) {
+		if (round >= 16) {
+			// 拡張メッセージの生成（w[round & 15]には16ラウンド前のワードが残っている）
+			w[round & 15] += S_1_256(w[(round - 2) & 15]) + w[(round - 7) & 15]
+			               + S_0_256(w[(round - 15) & 15]);
+		}
+		t1 = h + S256_1(e) + Ch(e, f, g) + SHA256_K[round] + w[round & 15];
+		t2 = S256_0(a) + Maj(a, b, c);
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+	// ハッシュ値の更新
+	pu32Hash[0] += a;
+	pu32Hash[1] += b;
+	pu32Hash[2] += c;
+	pu32Hash[3] += d;
+	pu32Hash[4] += e;
+	pu32Hash[5] += f;
+	pu32Hash[6] += g;
+	pu32Hash[7] += h;
 }
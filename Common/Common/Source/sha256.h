@@ -9,6 +9,8 @@
  *             SHA256 functions (header file)
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 32バイトメッセージ用の1ブロック高速ハッシュ生成を追加
+ * 2026/10/18 15:00:00 圧縮関数のバックエンドを差し替え可能にし、高速版を追加
  *
  * LAST MODIFIED BY:
  *
@@ -35,6 +37,25 @@ extern "C" {
 /****************************************************************************/
 /***        Type Definitions                                              ***/
 /****************************************************************************/
+/**
+ * 組込みのバックエンド
+ */
+typedef enum {
+	SHA256_BACKEND_REF = 0,		// 参照実装（拡張メッセージ64ワードを展開）
+	SHA256_BACKEND_FAST,		// 高速実装（拡張メッセージを16ワードで循環）
+	SHA256_BACKEND_CNT			// バックエンド数
+} SHA256_backendType;
+
+/**
+ * 圧縮関数のバックエンド
+ */
+typedef struct {
+	// バックエンド名
+	const char *pcName;
+	// 1ブロック（64バイト）分のハッシュ値更新処理
+	void (*pfCompress)(uint32 *pu32Hash, const uint8 *pu8Block);
+} SHA256_backend;
+
 /**
  * ハッシュコード演算の中間状態値
  */
@@ -47,6 +68,8 @@ typedef struct {
 	uint32 u32MsgBlockIdx;
 	// メッセージ文字数（処理済みメッセージブロック分も含む）
 	uint32 u32MsgLen;
+	// 圧縮関数のバックエンド
+	const SHA256_backend *psBackend;
 } SHA256_state;
 
 /****************************************************************************/
@@ -81,6 +104,37 @@ PUBLIC void vSHA256_append(SHA256_state *psState, const uint8 *pu8Msg, uint32 u3
  */
 PUBLIC void vSHA256_generateHash(SHA256_state *psState, uint8 *pu8Hash);
 
+/**
+ * 32バイトのメッセージからハッシュコードの生成処理
+ *
+ *	@param pu8Msg  メッセージ（32バイト）の先頭のポインタ
+ *	@param pu8Hash 結果を代入する配列へのポインタ(256bit必要です)
+ */
+PUBLIC void vSHA256_generateHash32(const uint8 *pu8Msg, uint8 *pu8Hash);
+
+/**
+ * 組込みバックエンドの取得
+ *
+ *	@param eType バックエンド種別
+ *	@return バックエンド、種別が不正な場合はNULL
+ */
+PUBLIC const SHA256_backend *psSHA256_getBackend(SHA256_backendType eType);
+
+/**
+ * デフォルトバックエンドの設定（以降に初期化する中間状態値に適用）
+ *
+ *	@param psBackend バックエンド
+ */
+PUBLIC void vSHA256_setDefaultBackend(const SHA256_backend *psBackend);
+
+/**
+ * バックエンドの設定
+ *
+ *	@param psState ハッシュコード生成処理ステータス情報
+ *	@param psBackend バックエンド
+ */
+PUBLIC void vSHA256_setBackend(SHA256_state *psState, const SHA256_backend *psBackend);
+
 /****************************************************************************/
 /***        Local Functions                                               ***/
 /****************************************************************************/
@@ -8,6 +8,10 @@
  * DESCRIPTION:ST7032I LCD I2C draiver
  *
  * CHANGE HISTORY:
+ * 2026/10/19 09:00:00 表示内容の写しによる差分描画を追加
+ * 2026/10/19 10:00:00 コマンドのキューイングによる非同期実行を追加
+ * 2026/10/19 17:00:00 I2Cスケジューラ経由のトランザクションの送信を追加
+ * 2026/10/20 00:00:00 トランザクションバッファの境界で制御バイトとコマンドの組が分割される不具合を修正
  *
  * LAST MODIFIED BY:
  *
@@ -26,6 +30,7 @@
 
 #include "st7032i.h"
 #include "i2c_util.h"
+#include "i2c_sched.h"
 #include "timer_util.h"
 
 /****************************************************************************/
@@ -58,6 +63,14 @@
 #define ST7032i_CMD_FOLLOWER_CNTR    (0x6C)
 #define ST7032i_CMD_CONTRAST_LOW     (0x70)
 #define ST7032i_CMD_DATA_WRITE       (0x80)
+// DDRAMアドレス：行の先頭
+#define ST7032i_DD_ADDR_ROW(r)       ((uint8)(0x40 * (r)))
+// DDRAMアドレス：１行目の終端の次
+#define ST7032i_DD_ADDR_END0         (0x28)
+// DDRAMアドレス：２行目の終端の次
+#define ST7032i_DD_ADDR_END1         (0x68)
+// 差分描画：連結する一致区間の最大長（カーソル移動３バイト＋データ送信開始２バイト）
+#define ST7032i_DRAW_MERGE_GAP       (5)
 
 /****************************************************************************/
 /***        Type Definitions                                              ***/
@@ -72,6 +85,8 @@
 /****************************************************************************/
 // LCD状態
 PRIVATE ST7032i_state* stST7032i_sts;
+// I2Cスケジューラのデバイスインデックス（I2C_SCHED_DEVICE_NONE：直接通信）
+PRIVATE uint8 u8ST7032i_schedDevIdx = I2C_SCHED_DEVICE_NONE;
 
 /****************************************************************************/
 /***        Local Function Prototypes                                     ***/
@@ -84,12 +99,28 @@ PRIVATE bool_t bST7032i_writeCmd(uint8 u8Cmd);
 PRIVATE bool_t bST7032i_writeCmdStop(uint8 u8Cmd);
 // データの送信
 PRIVATE bool_t bST7032i_writeData(uint8 u8Data);
+// データ列の送信
+PRIVATE bool_t bST7032i_writeDataList(uint8* pu8Data, uint16 u16Len);
+// トランザクションバッファへの書き込み
+PRIVATE void vST7032i_writeBuff(uint8 u8Data);
+// トランザクションの確定（同期実行の場合は送信、非同期実行の場合はキューに登録）
+PRIVATE bool_t bST7032i_writeEnd();
+// トランザクションの送信
+PRIVATE bool_t bST7032i_execTrns(uint8* pu8Trns, uint8 u8Len);
+// トランザクションの送信（I2Cスケジューラ経由）
+PRIVATE bool_t bST7032i_execSched(uint8* pu8Trns, uint8 u8Len);
 // アイコンの書き込み
 PRIVATE bool_t bST7032i_writeIconData(uint8 u8Addr);
+// カーソル移動（DDRAMアドレス、移動済みの場合は送信しない）
+PRIVATE bool_t bST7032i_moveCursor(uint8 u8Addr);
+// 表示内容の写しの更新（アドレスカウンタの位置へのデータ書き込み）
+PRIVATE void vST7032i_updFrame(uint8* pu8Data, uint16 u16Len);
+// 表示内容の写しの初期化（u8Ch：初期化文字、u8Addr：アドレスカウンタ）
+PRIVATE void vST7032i_resetFrame(char cCh, uint8 u8Addr);
 // 画面制御設定（アイコン表示、コントラスト）
 PRIVATE bool_t bST7032i_writeControlEx();
 // 次回コマンド実行可能時刻（usec）取得
-PRIVATE uint32 u64ST7032i_nextExecTime(uint8 u8Cmd);
+PRIVATE uint64 u64ST7032i_nextExecTime(uint8 u8Cmd);
 // エラー終了
 PRIVATE bool_t bST7032i_errorEnd();
 
@@ -120,6 +151,24 @@ PUBLIC bool_t bST7032i_deviceSelect(ST7032i_state* psState) {
 	return TRUE;
 }
 
+/*****************************************************************************
+ *
+ * NAME: vST7032i_setSchedDevice
+ *
+ * DESCRIPTION:I2Cスケジューラのデバイスの設定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8DevIdx        R   デバイスインデックス（I2C_SCHED_DEVICE_NONE：直接通信）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 設定以降のトランザクションは、I2Cスケジューラへの要求として送信する
+ *****************************************************************************/
+PUBLIC void vST7032i_setSchedDevice(uint8 u8DevIdx) {
+	u8ST7032i_schedDevIdx = u8DevIdx;
+}
+
 /*****************************************************************************
  *
  * NAME: bST7032i_init
@@ -143,6 +192,15 @@ PUBLIC bool_t bST7032i_init() {
 	stST7032i_sts->u8Contrast = 40;
 	stST7032i_sts->bIconDispFlg = TRUE;
 	memset(stST7032i_sts->u8IconData, 0, ST7032i_ICON_DATA_SIZE);
+	vST7032i_resetFrame('\0', ST7032i_ADDR_UNKNOWN);
+	stST7032i_sts->u32TxByteCnt = 0;
+	// 同期実行（実行待ちのコマンドは破棄）
+	stST7032i_sts->bAsyncFlg = FALSE;
+	stST7032i_sts->u8TrnsLen = 0;
+	stST7032i_sts->u16QueueHead = 0;
+	stST7032i_sts->u16QueueTail = 0;
+	stST7032i_sts->u32QueueFullCnt = 0;
+	stST7032i_sts->u64nextExec = u64TimerUtil_readUsec();
 	// コマンド OR データの送信開始
 	if (!bST7032i_writeStart()) return FALSE;
 	// Function Set Default(IS=1)
@@ -160,7 +218,11 @@ PUBLIC bool_t bST7032i_init() {
 	// Display Switch On
 	if (!bST7032i_writeCmd(ST7032i_CMD_DISP_CNTR_DEF | 0x04)) return FALSE;
 	// Clear Screen
-	return bST7032i_writeCmdStop(ST7032i_CMD_CLEAR_DISP);
+	if (!bST7032i_writeCmdStop(ST7032i_CMD_CLEAR_DISP)) return FALSE;
+	// 表示内容の写しの初期化（クリア後は空白、アドレスは先頭）
+	vST7032i_resetFrame(' ', 0x00);
+	stST7032i_sts->u8DispCntrCmd = ST7032i_CMD_DISP_CNTR_DEF | 0x04;
+	return TRUE;
 }
 
 /*****************************************************************************
@@ -193,6 +255,10 @@ PUBLIC bool_t bST7032i_dispControl(bool_t bDispFlg, bool_t bCursorFlg, bool_t bB
 	cntrCmd |= (0x02 * bCursorFlg);
 	// カーソル点滅表示設定
 	cntrCmd |= (0x01 * bBlinkFlg);
+	// 設定済みの場合は送信しない
+	if (cntrCmd == stST7032i_sts->u8DispCntrCmd && bIconFlg == stST7032i_sts->bIconDispFlg) {
+		return TRUE;
+	}
 	// アイコン表示
 	stST7032i_sts->bIconDispFlg = bIconFlg;
 
@@ -204,7 +270,10 @@ PUBLIC bool_t bST7032i_dispControl(bool_t bDispFlg, bool_t bCursorFlg, bool_t bB
 	// 画面制御設定（ディスプレイON/OFF、カーソル表示、カーソル点滅）
 	if (!bST7032i_writeCmd(cntrCmd)) return FALSE;
 	// アイコン表示設定
-	return bST7032i_writeControlEx();
+	if (!bST7032i_writeControlEx()) return FALSE;
+	// 画面制御コマンドの写しを更新
+	stST7032i_sts->u8DispCntrCmd = cntrCmd;
+	return TRUE;
 }
 
 /*****************************************************************************
@@ -251,7 +320,10 @@ PUBLIC bool_t bST7032i_clearScreen() {
 	// コマンド OR データの送信開始
 	if (!bST7032i_writeStart()) return FALSE;
 	// Display Clear
-	return bST7032i_writeCmdStop(ST7032i_CMD_CLEAR_DISP);
+	if (!bST7032i_writeCmdStop(ST7032i_CMD_CLEAR_DISP)) return FALSE;
+	// 表示内容の写しの初期化（クリア後は空白、アドレスは先頭）
+	vST7032i_resetFrame(' ', 0x00);
+	return TRUE;
 }
 
 /*****************************************************************************
@@ -303,12 +375,8 @@ PUBLIC bool_t bST7032i_clearICON() {
  * None.
  *****************************************************************************/
 PUBLIC bool_t bST7032i_setCursor(uint8 u8RowNo, uint8 u8ColNo) {
-	// アドレス計算
-	uint8 cmd = ST7032i_CMD_SET_DD_ADDR | (0x40 * u8RowNo + u8ColNo);
-	// 書き込み開始処理
-	if (!bST7032i_writeStart()) return FALSE;
 	// カーソル移動（行、列）
-	return bST7032i_writeCmdStop(cmd);
+	return bST7032i_moveCursor(ST7032i_DD_ADDR_ROW(u8RowNo) + u8ColNo);
 }
 
 /*****************************************************************************
@@ -330,7 +398,10 @@ PUBLIC bool_t bST7032i_returnHome() {
 	// コマンド OR データの送信開始
 	if (!bST7032i_writeStart()) return FALSE;
 	// 画面制御設定（ディスプレイON/OFF、カーソル表示、カーソル点滅）
-	return bST7032i_writeCmdStop(ST7032i_CMD_RETURN_HOME);
+	if (!bST7032i_writeCmdStop(ST7032i_CMD_RETURN_HOME)) return FALSE;
+	// アドレスカウンタは先頭
+	stST7032i_sts->u8DDAddr = 0x00;
+	return TRUE;
 }
 
 /*****************************************************************************
@@ -351,6 +422,8 @@ PUBLIC bool_t bST7032i_returnHome() {
 PUBLIC bool_t bST7032i_cursorShiftL() {
 	// コマンド OR データの送信開始
 	if (!bST7032i_writeStart()) return FALSE;
+	// アドレスカウンタの写しは破棄
+	stST7032i_sts->u8DDAddr = ST7032i_ADDR_UNKNOWN;
 	// カーソルシフト（左）
 	return bST7032i_writeCmdStop(ST7032i_CMD_CURSOR_SHIFT_L);
 }
@@ -373,6 +446,8 @@ PUBLIC bool_t bST7032i_cursorShiftL() {
 PUBLIC bool_t bST7032i_cursorShiftR() {
 // コマンド OR データの送信開始
 	if (!bST7032i_writeStart()) return FALSE;
+	// アドレスカウンタの写しは破棄
+	stST7032i_sts->u8DDAddr = ST7032i_ADDR_UNKNOWN;
 	// カーソルシフト（右）
 	return bST7032i_writeCmdStop(ST7032i_CMD_CURSOR_SHIFT_R);
 }
@@ -398,33 +473,16 @@ PUBLIC bool_t bST7032i_charRegist(uint8 u8Ch, uint8 *pu8CgDataList) {
 	//=========================================================================
 	// 書き込み処理
 	//=========================================================================
+	// アドレスカウンタはCGRAMを指す
+	stST7032i_sts->u8DDAddr = ST7032i_ADDR_UNKNOWN;
 	// 書き込み開始処理
 	if (!bST7032i_writeStart()) return FALSE;
 	// CGアドレスの書き込み
 	if (!bST7032i_writeCmdStop(ST7032i_CMD_SET_CG_ADDR | (u8Ch << 3))) return FALSE;
 	// 書き込み開始処理
 	if (!bST7032i_writeStart()) return FALSE;
-	// 制御バイトの送信：データ
-	if (u8I2C_write(ST7032i_RS_DATA) != I2CUTIL_STS_ACK) {
-		bI2C_stopACK();
-		return FALSE;
-	}
 	// データの書き込み
-	uint8 idx;
-	for (idx = 0; idx < 7; idx++) {
-		if (u8I2C_write(pu8CgDataList[idx]) != I2CUTIL_STS_ACK) {
-			bI2C_stopACK();
-			return FALSE;
-		}
-	}
-	// 終端バイトの書き込み
-	if (u8I2C_writeStop(pu8CgDataList[7]) != I2CUTIL_STS_ACK) {
-		bI2C_stopACK();
-		return FALSE;
-	}
-	// 次回コマンド実行可能時刻を更新
-	stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(ST7032i_CMD_DATA_WRITE);
-	return TRUE;
+	return bST7032i_writeDataList(pu8CgDataList, 8);
 }
 
 /*****************************************************************************
@@ -447,7 +505,10 @@ PUBLIC bool_t bST7032i_writeChar(char cCh) {
 	// コマンド OR データの送信開始
 	if (!bST7032i_writeStart()) return FALSE;
 	// 文字データの書き込み処理
-	return bST7032i_writeData(cCh);
+	if (!bST7032i_writeData(cCh)) return FALSE;
+	// 表示内容の写しを更新
+	vST7032i_updFrame((uint8*)&cCh, 1);
+	return TRUE;
 }
 
 /*****************************************************************************
@@ -475,27 +536,10 @@ PUBLIC bool_t bST7032i_writeString(char *pcStr) {
 	if (length <= 0) return TRUE;
 	// コマンド OR データの送信開始
 	if (!bST7032i_writeStart()) return FALSE;
-	// 制御バイトの送信：データ
-	if (u8I2C_write(ST7032i_RS_DATA) != I2CUTIL_STS_ACK) {
-		bI2C_stopACK();
-		return FALSE;
-	}
 	// データの書き込み
-	while(length > 1) {
-		if (u8I2C_write(*pcStr) != I2CUTIL_STS_ACK) {
-			bI2C_stopACK();
-			return FALSE;
-		}
-		pcStr++;
-		length--;
-	}
-	// 終端バイトの書き込み
-	if (u8I2C_writeStop(*pcStr) != I2CUTIL_STS_ACK) {
-		bI2C_stopACK();
-		return FALSE;
-	}
-	// 次回コマンド実行可能時刻を更新
-	stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(ST7032i_CMD_DATA_WRITE);
+	if (!bST7032i_writeDataList((uint8*)pcStr, (uint16)length)) return FALSE;
+	// 表示内容の写しを更新
+	vST7032i_updFrame((uint8*)pcStr, (uint16)length);
 	return TRUE;
 }
 
@@ -539,6 +583,184 @@ PUBLIC bool_t bST7032i_writeIcon(uint8 u8IconNo) {
 	return bST7032i_writeIconData(addr);
 }
 
+/*****************************************************************************
+ *
+ * NAME: bST7032i_drawRow
+ *
+ * DESCRIPTION:行の描画、表示内容の写しと異なる文字のみを送信する
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8RowNo         R   描画行
+ *       char*      pcStr           R   表示文字列（先頭から表示桁数まで）
+ *
+ * RETURNS:
+ *      TRUE :描画成功
+ *      FALSE:描画失敗
+ *
+ * NOTES:
+ * 異なる文字の区間毎にカーソル移動とデータ送信を行う。区間の間の一致区間が
+ * 短い場合は区間を連結して送信し、カーソルが区間の先頭にある場合は
+ * カーソル移動を省略する。文字列より後ろの桁は書き換えない。
+ *****************************************************************************/
+PUBLIC bool_t bST7032i_drawRow(uint8 u8RowNo, char* pcStr) {
+	//=========================================================================
+	// 入力チェック
+	//=========================================================================
+	if (u8RowNo >= ST7032i_ROW_SIZE) return FALSE;
+	int length = strlen(pcStr);
+	if (length > ST7032i_COL_SIZE) {
+		length = ST7032i_COL_SIZE;
+	}
+
+	//=========================================================================
+	// 差分の送信
+	//=========================================================================
+	char* pcFrame = stST7032i_sts->cFrame[u8RowNo];
+	uint8 u8Col = 0;
+	uint8 u8End;
+	uint8 u8Idx;
+	while (u8Col < length) {
+		// 変更区間の先頭を探す
+		if (pcFrame[u8Col] == pcStr[u8Col]) {
+			u8Col++;
+			continue;
+		}
+		// 変更区間の終端を探す（短い一致区間を挟む変更区間は連結）
+		u8End = u8Col + 1;
+		for (u8Idx = u8End; u8Idx < length && u8Idx - u8End <= ST7032i_DRAW_MERGE_GAP; u8Idx++) {
+			if (pcFrame[u8Idx] != pcStr[u8Idx]) {
+				u8End = u8Idx + 1;
+			}
+		}
+		// カーソル移動
+		if (!bST7032i_moveCursor(ST7032i_DD_ADDR_ROW(u8RowNo) + u8Col)) return FALSE;
+		// 書き込み開始処理
+		if (!bST7032i_writeStart()) return FALSE;
+		// データの書き込み
+		if (!bST7032i_writeDataList((uint8*)&pcStr[u8Col], u8End - u8Col)) return FALSE;
+		// 表示内容の写しを更新
+		vST7032i_updFrame((uint8*)&pcStr[u8Col], u8End - u8Col);
+		u8Col = u8End;
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_setAsync
+ *
+ * DESCRIPTION:非同期実行の設定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      bool_t      bAsyncFlg       R   非同期実行（TRUE）、同期実行（FALSE）
+ *
+ * RETURNS:
+ *      TRUE :設定成功
+ *      FALSE:実行待ちのコマンドの送信失敗
+ *
+ * NOTES:
+ * 非同期実行の場合、各関数は送信するトランザクションをキューに登録して即座に復帰する。
+ * キューはbST7032i_asyncProceedの呼び出し毎に次回コマンド実行可能時刻を過ぎた分だけ
+ * 送信されるので、イベントループから繰り返し呼び出す事。
+ * 同期実行に戻す場合は、実行待ちのコマンドを全て送信してから戻す。
+ *****************************************************************************/
+PUBLIC bool_t bST7032i_setAsync(bool_t bAsyncFlg) {
+	bool_t bResult = TRUE;
+	// 同期実行に戻す場合は実行待ちのコマンドを送信
+	if (!bAsyncFlg) {
+		bResult = bST7032i_asyncWait();
+	}
+	stST7032i_sts->bAsyncFlg = bAsyncFlg;
+	return bResult;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_asyncProceed
+ *
+ * DESCRIPTION:非同期実行の進行
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *      TRUE :送信成功もしくは実行可能なコマンド無し
+ *      FALSE:送信失敗
+ *
+ * NOTES:
+ * 次回コマンド実行可能時刻を過ぎたトランザクションを順に送信し、
+ * 実行可能時刻まで待つ必要があるトランザクションに達したら復帰する。
+ * 実行可能時刻までの時間がST7032i_ASYNC_SPIN_USEC以下の場合はその場で待つ。
+ *****************************************************************************/
+PUBLIC bool_t bST7032i_asyncProceed() {
+	ST7032i_state* psState = stST7032i_sts;
+	bool_t bResult = TRUE;
+	uint8 u8Len;
+	while (psState->u16QueueHead < psState->u16QueueTail) {
+		// 実行可能時刻の判定
+		if (u64TimerUtil_readUsec() + ST7032i_ASYNC_SPIN_USEC < psState->u64nextExec) {
+			break;
+		}
+		// トランザクションの送信（失敗した場合も次のトランザクションに進む）
+		u8Len = psState->u8Queue[psState->u16QueueHead];
+		if (!bST7032i_execTrns(&psState->u8Queue[psState->u16QueueHead + 1], u8Len)) {
+			bResult = FALSE;
+		}
+		psState->u16QueueHead += 1 + u8Len;
+	}
+	// キューが空になった場合は先頭に戻す
+	if (psState->u16QueueHead >= psState->u16QueueTail) {
+		psState->u16QueueHead = 0;
+		psState->u16QueueTail = 0;
+	}
+	return bResult;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_asyncIsBusy
+ *
+ * DESCRIPTION:非同期実行の実行中判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *      TRUE :実行待ちのコマンド有り
+ *      FALSE:実行待ちのコマンド無し
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC bool_t bST7032i_asyncIsBusy() {
+	return (stST7032i_sts->u16QueueHead < stST7032i_sts->u16QueueTail);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_asyncWait
+ *
+ * DESCRIPTION:非同期実行の完了待ち
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *      TRUE :全ての送信成功もしくは実行待ちのコマンド無し
+ *      FALSE:送信失敗
+ *
+ * NOTES:
+ * 実行待ちのコマンドを同期的に全て送信する
+ *****************************************************************************/
+PUBLIC bool_t bST7032i_asyncWait() {
+	bool_t bResult = TRUE;
+	while (bST7032i_asyncIsBusy()) {
+		// 次回コマンド実行可能時刻まで待機
+		u32TimerUtil_waitUntil(stST7032i_sts->u64nextExec);
+		if (!bST7032i_asyncProceed()) {
+			bResult = FALSE;
+		}
+	}
+	return bResult;
+}
+
 /****************************************************************************/
 /***        Local Functions                                               ***/
 /****************************************************************************/
@@ -546,7 +768,7 @@ PUBLIC bool_t bST7032i_writeIcon(uint8 u8IconNo) {
  *
  * NAME: bST7032i_writeStart
  *
- * DESCRIPTION:コマンド OR データの送信開始
+ * DESCRIPTION:コマンド OR データの送信開始（トランザクションの構築開始）
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -555,12 +777,12 @@ PUBLIC bool_t bST7032i_writeIcon(uint8 u8IconNo) {
  *      FALSE:開始失敗
  *
  * NOTES:
- * None.
+ * 構築中のトランザクションがある場合は、先に確定する
  *****************************************************************************/
 PRIVATE bool_t bST7032i_writeStart() {
-	// 書き込み開始処理
-	if (!bI2C_startWrite(I2C_ADDR_ST7032I)) {
-		return bST7032i_errorEnd();
+	// 構築中のトランザクションを確定
+	if (stST7032i_sts->u8TrnsLen > 0) {
+		return bST7032i_writeEnd();
 	}
 	return TRUE;
 }
@@ -579,21 +801,17 @@ PRIVATE bool_t bST7032i_writeStart() {
  *      FALSE:コマンド送信失敗
  *
  * NOTES:
- * None.
+ * トランザクションバッファの空きが２バイト未満の場合は、構築中のトランザクションを確定してから書き込む
  *****************************************************************************/
 PRIVATE bool_t bST7032i_writeCmd(uint8 u8Cmd) {
-	// コマンド実行可能まで待つ
-	u32TimerUtil_waitUntil(stST7032i_sts->u64nextExec);
-	// 制御バイトの送信：コマンド
-	if (u8I2C_write(ST7032i_RS_CMD) != I2CUTIL_STS_ACK) {
-		return bST7032i_errorEnd();
-	}
-	// コマンドの送信
-	if (u8I2C_write(u8Cmd) != I2CUTIL_STS_ACK) {
-		return bST7032i_errorEnd();
+	// 制御バイトとコマンドの組が分割されない様、空きが２バイト未満の場合は先に確定
+	if (stST7032i_sts->u8TrnsLen + 2 > ST7032i_TRNS_BUFF_SIZE - 1) {
+		if (!bST7032i_writeEnd()) return FALSE;
 	}
-	// 次回コマンド実行可能時刻を更新
-	stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(u8Cmd);
+	// 制御バイト：コマンド
+	vST7032i_writeBuff(ST7032i_RS_CMD);
+	// コマンド
+	vST7032i_writeBuff(u8Cmd);
 	return TRUE;
 }
 
@@ -614,19 +832,10 @@ PRIVATE bool_t bST7032i_writeCmd(uint8 u8Cmd) {
  * None.
  *****************************************************************************/
 PRIVATE bool_t bST7032i_writeCmdStop(uint8 u8Cmd) {
-	// コマンド実行可能まで待つ
-	u32TimerUtil_waitUntil(stST7032i_sts->u64nextExec);
-	// 制御バイトの送信：コマンド
-	if (u8I2C_write(ST7032i_RS_CMD) != I2CUTIL_STS_ACK) {
-		return bST7032i_errorEnd();
-	}
-	// コマンドの送信
-	if (u8I2C_writeStop(u8Cmd) != I2CUTIL_STS_ACK) {
-		return bST7032i_errorEnd();
-	}
-	// 次回コマンド実行可能時刻を更新
-	stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(u8Cmd);
-	return TRUE;
+	// コマンドの書き込み
+	if (!bST7032i_writeCmd(u8Cmd)) return FALSE;
+	// トランザクションの確定
+	return bST7032i_writeEnd();
 }
 
 /*****************************************************************************
@@ -646,22 +855,249 @@ PRIVATE bool_t bST7032i_writeCmdStop(uint8 u8Cmd) {
  * None.
  *****************************************************************************/
 PRIVATE bool_t bST7032i_writeData(uint8 u8Data) {
-	//=========================================================================
-	// 書き込み処理
-	//=========================================================================
+	return bST7032i_writeDataList(&u8Data, 1);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_writeDataList
+ *
+ * DESCRIPTION:データ列の書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8*      pu8Data         R   データ列
+ *      uint16      u16Len          R   データ長
+ *
+ * RETURNS:
+ *      TRUE :データ送信成功
+ *      FALSE:データ送信失敗
+ *
+ * NOTES:
+ * トランザクションバッファに収まらないデータ列は複数のトランザクションに分割する
+ * （データ書き込み毎にアドレスカウンタが進むので、分割しても結果は同じ）
+ *****************************************************************************/
+PRIVATE bool_t bST7032i_writeDataList(uint8* pu8Data, uint16 u16Len) {
+	uint16 u16Size;
+	while (u16Len > 0) {
+		// 構築中のトランザクションを確定
+		if (!bST7032i_writeStart()) return FALSE;
+		// 分割サイズ
+		u16Size = ST7032i_TRNS_BUFF_SIZE - 1;
+		if (u16Size > u16Len) {
+			u16Size = u16Len;
+		}
+		// 制御バイト：データ
+		vST7032i_writeBuff(ST7032i_RS_DATA);
+		// データ列
+		memcpy(&stST7032i_sts->u8TrnsBuff[stST7032i_sts->u8TrnsLen], pu8Data, u16Size);
+		stST7032i_sts->u8TrnsLen += u16Size;
+		// トランザクションの確定
+		if (!bST7032i_writeEnd()) return FALSE;
+		pu8Data += u16Size;
+		u16Len  -= u16Size;
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vST7032i_writeBuff
+ *
+ * DESCRIPTION:トランザクションバッファへの書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Data          R   制御バイト、コマンドもしくはデータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vST7032i_writeBuff(uint8 u8Data) {
+	// 溢れる場合は構築中のトランザクションを確定
+	if (stST7032i_sts->u8TrnsLen >= ST7032i_TRNS_BUFF_SIZE - 1) {
+		bST7032i_writeEnd();
+	}
+	stST7032i_sts->u8TrnsBuff[stST7032i_sts->u8TrnsLen++] = u8Data;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_writeEnd
+ *
+ * DESCRIPTION:トランザクションの確定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *      TRUE :送信成功もしくはキューへの登録成功
+ *      FALSE:送信失敗
+ *
+ * NOTES:
+ * 非同期実行の場合はキューに登録して即座に復帰し、
+ * 同期実行の場合はその場で送信する
+ *****************************************************************************/
+PRIVATE bool_t bST7032i_writeEnd() {
+	ST7032i_state* psState = stST7032i_sts;
+	uint8 u8Len = psState->u8TrnsLen;
+	psState->u8TrnsLen = 0;
+	if (u8Len == 0) return TRUE;
+	// 同期実行
+	if (!psState->bAsyncFlg) {
+		return bST7032i_execTrns(psState->u8TrnsBuff, u8Len);
+	}
+	// キューの空き判定
+	if (psState->u16QueueTail + 1 + u8Len > ST7032i_QUEUE_SIZE) {
+		// 実行済みの領域を詰める
+		memmove(psState->u8Queue, &psState->u8Queue[psState->u16QueueHead],
+			psState->u16QueueTail - psState->u16QueueHead);
+		psState->u16QueueTail -= psState->u16QueueHead;
+		psState->u16QueueHead  = 0;
+		// 空きが無い場合は実行待ちのトランザクションを同期的に実行
+		if (psState->u16QueueTail + 1 + u8Len > ST7032i_QUEUE_SIZE) {
+			psState->u32QueueFullCnt++;
+			bST7032i_asyncWait();
+		}
+	}
+	// キューへの登録（長さ、送信データ）
+	psState->u8Queue[psState->u16QueueTail] = u8Len;
+	memcpy(&psState->u8Queue[psState->u16QueueTail + 1], psState->u8TrnsBuff, u8Len);
+	psState->u16QueueTail += 1 + u8Len;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_execTrns
+ *
+ * DESCRIPTION:トランザクションの送信
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8*      pu8Trns         R   送信データ（制御バイトとコマンドの組、
+ *                                      もしくは制御バイトとデータ列）
+ *      uint8       u8Len           R   送信データ長
+ *
+ * RETURNS:
+ *      TRUE :送信成功
+ *      FALSE:送信失敗
+ *
+ * NOTES:
+ * コマンド毎に次回コマンド実行可能時刻まで待ってから送信する
+ *****************************************************************************/
+PRIVATE bool_t bST7032i_execTrns(uint8* pu8Trns, uint8 u8Len) {
+	// I2Cスケジューラ経由の送信
+	if (u8ST7032i_schedDevIdx != I2C_SCHED_DEVICE_NONE) {
+		return bST7032i_execSched(pu8Trns, u8Len);
+	}
+	// 送信バイト数（アドレス、制御バイトとデータ）
+	stST7032i_sts->u32TxByteCnt += 1 + u8Len;
 	// コマンド実行可能まで待つ
 	u32TimerUtil_waitUntil(stST7032i_sts->u64nextExec);
-	// 制御バイトの送信：データ
-	if (u8I2C_write(ST7032i_RS_DATA) != I2CUTIL_STS_ACK) {
+	// 書き込み開始処理
+	if (!bI2C_startWrite(I2C_ADDR_ST7032I)) {
 		return bST7032i_errorEnd();
 	}
-	// データの送信
-	if (u8I2C_writeStop(u8Data) != I2CUTIL_STS_ACK) {
-		return bST7032i_errorEnd();
+	uint8 u8Idx = 0;
+	uint8 u8Cmd;
+	uint8 u8Sts;
+	while (u8Idx < u8Len) {
+		if (pu8Trns[u8Idx] == ST7032i_RS_CMD) {
+			//=================================================================
+			// コマンドの送信
+			//=================================================================
+			u8Cmd = pu8Trns[u8Idx + 1];
+			u8Idx += 2;
+			// コマンド実行可能まで待つ
+			u32TimerUtil_waitUntil(stST7032i_sts->u64nextExec);
+			// 制御バイトの送信：コマンド
+			if (u8I2C_write(ST7032i_RS_CMD) != I2CUTIL_STS_ACK) {
+				return bST7032i_errorEnd();
+			}
+			// コマンドの送信（終端の場合は停止）
+			if (u8Idx < u8Len) {
+				u8Sts = u8I2C_write(u8Cmd);
+			} else {
+				u8Sts = u8I2C_writeStop(u8Cmd);
+			}
+			if (u8Sts != I2CUTIL_STS_ACK) {
+				return bST7032i_errorEnd();
+			}
+			// 次回コマンド実行可能時刻を更新
+			stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(u8Cmd);
+		} else {
+			//=================================================================
+			// データの送信（制御バイト以降の全て）
+			//=================================================================
+			// 制御バイトの送信：データ
+			if (u8I2C_write(ST7032i_RS_DATA) != I2CUTIL_STS_ACK) {
+				return bST7032i_errorEnd();
+			}
+			u8Idx++;
+			// データの書き込み
+			while (u8Idx < u8Len - 1) {
+				if (u8I2C_write(pu8Trns[u8Idx]) != I2CUTIL_STS_ACK) {
+					return bST7032i_errorEnd();
+				}
+				u8Idx++;
+			}
+			// 終端バイトの書き込み
+			if (u8I2C_writeStop(pu8Trns[u8Idx]) != I2CUTIL_STS_ACK) {
+				return bST7032i_errorEnd();
+			}
+			u8Idx++;
+			// 次回コマンド実行可能時刻を更新
+			stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(ST7032i_CMD_DATA_WRITE);
+		}
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bST7032i_execSched
+ *
+ * DESCRIPTION:トランザクションの送信（I2Cスケジューラ経由）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8*      pu8Trns         R   送信データ（制御バイトとコマンドの組、
+ *                                      もしくは制御バイトとデータ列）
+ *      uint8       u8Len           R   送信データ長
+ *
+ * RETURNS:
+ *      TRUE :送信成功
+ *      FALSE:送信失敗
+ *
+ * NOTES:
+ * 要求の途中では待てないので、制御バイトとコマンドの組毎、もしくは制御バイト以降の
+ * データ列を１回の要求として、次回コマンド実行可能時刻まで待ってから送信する
+ *****************************************************************************/
+PRIVATE bool_t bST7032i_execSched(uint8* pu8Trns, uint8 u8Len) {
+	tsI2CSched_Req sReq;
+	uint8 u8Idx = 0;
+	uint8 u8Size;
+	uint8 u8Cmd;
+	while (u8Idx < u8Len) {
+		// 要求の範囲
+		if (pu8Trns[u8Idx] == ST7032i_RS_CMD) {
+			u8Size = 2;
+			u8Cmd  = pu8Trns[u8Idx + 1];
+		} else {
+			u8Size = u8Len - u8Idx;
+			u8Cmd  = ST7032i_CMD_DATA_WRITE;
+		}
+		// 送信バイト数（アドレス、制御バイトとコマンドもしくはデータ列）
+		stST7032i_sts->u32TxByteCnt += 1 + u8Size;
+		// コマンド実行可能まで待つ
+		u32TimerUtil_waitUntil(stST7032i_sts->u64nextExec);
+		// 送信
+		vI2CSched_editReq(&sReq, &pu8Trns[u8Idx], u8Size, NULL, 0, 0);
+		if (u8I2CSched_exec(u8ST7032i_schedDevIdx, &sReq) != I2CUTIL_STS_ACK) {
+			return bST7032i_errorEnd();
+		}
+		u8Idx += u8Size;
+		// 次回コマンド実行可能時刻を更新
+		stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(u8Cmd);
 	}
-	// 次回コマンド実行可能時刻を更新
-	stST7032i_sts->u64nextExec = u64ST7032i_nextExecTime(ST7032i_CMD_DATA_WRITE);
-	// 正常終了
 	return TRUE;
 }
 
@@ -684,6 +1120,8 @@ PRIVATE bool_t bST7032i_writeData(uint8 u8Data) {
 PRIVATE bool_t bST7032i_writeIconData(uint8 u8Addr) {
 	// 有効アドレス
 	uint8 validAdd = u8Addr & 0x0F;
+	// アドレスカウンタはアイコンRAMを指す
+	stST7032i_sts->u8DDAddr = ST7032i_ADDR_UNKNOWN;
 	// 書き込み開始処理
 	if (!bST7032i_writeStart()) return FALSE;
 	// コマンドの送信（IS=1）
@@ -741,6 +1179,102 @@ PRIVATE bool_t bST7032i_writeControlEx() {
 	return bST7032i_writeCmdStop(ST7032i_CMD_FUNC_SET_DEF);
 }
 
+/*****************************************************************************
+ *
+ * NAME: bST7032i_moveCursor
+ *
+ * DESCRIPTION:カーソル移動（DDRAMアドレス）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Addr          R   DDRAMアドレス
+ *
+ * RETURNS:
+ *      TRUE :移動成功
+ *      FALSE:移動失敗
+ *
+ * NOTES:
+ * アドレスカウンタの写しが移動先と一致する場合は送信しない
+ *****************************************************************************/
+PRIVATE bool_t bST7032i_moveCursor(uint8 u8Addr) {
+	// 移動済み判定
+	if (u8Addr == stST7032i_sts->u8DDAddr) return TRUE;
+	// 書き込み開始処理
+	if (!bST7032i_writeStart()) return FALSE;
+	// カーソル移動
+	if (!bST7032i_writeCmdStop(ST7032i_CMD_SET_DD_ADDR | u8Addr)) return FALSE;
+	// アドレスカウンタの写しを更新
+	stST7032i_sts->u8DDAddr = u8Addr;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vST7032i_updFrame
+ *
+ * DESCRIPTION:表示内容の写しの更新（アドレスカウンタの位置へのデータ書き込み）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8*      pu8Data         R   書き込んだデータ列
+ *      uint16      u16Len          R   データ長
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * アドレスカウンタが不明な場合は表示内容の写しを破棄する。
+ * アドレスカウンタは行の終端で次の行の先頭に移動する。
+ *****************************************************************************/
+PRIVATE void vST7032i_updFrame(uint8* pu8Data, uint16 u16Len) {
+	// アドレスカウンタ
+	uint8 u8Addr = stST7032i_sts->u8DDAddr;
+	// 書き込み位置が不明な場合は破棄
+	if (u8Addr == ST7032i_ADDR_UNKNOWN) {
+		vST7032i_resetFrame('\0', ST7032i_ADDR_UNKNOWN);
+		return;
+	}
+	// 表示領域の写しを更新
+	uint8 u8Col;
+	while (u16Len > 0) {
+		u8Col = u8Addr & 0x3F;
+		if (u8Col < ST7032i_COL_SIZE) {
+			stST7032i_sts->cFrame[u8Addr >> 6][u8Col] = (char)*pu8Data;
+		}
+		// アドレスカウンタの更新
+		u8Addr++;
+		if (u8Addr == ST7032i_DD_ADDR_END0) {
+			u8Addr = ST7032i_DD_ADDR_ROW(1);
+		} else if (u8Addr == ST7032i_DD_ADDR_END1) {
+			u8Addr = ST7032i_DD_ADDR_ROW(0);
+		}
+		pu8Data++;
+		u16Len--;
+	}
+	stST7032i_sts->u8DDAddr = u8Addr;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vST7032i_resetFrame
+ *
+ * DESCRIPTION:表示内容の写しの初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      char        cCh             R   初期化文字（'\0'：内容不明）
+ *      uint8       u8Addr          R   アドレスカウンタ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vST7032i_resetFrame(char cCh, uint8 u8Addr) {
+	memset(stST7032i_sts->cFrame, cCh, sizeof(stST7032i_sts->cFrame));
+	stST7032i_sts->u8DDAddr = u8Addr;
+	// 内容不明の場合は画面制御コマンドも不明
+	if (cCh == '\0') {
+		stST7032i_sts->u8DispCntrCmd = 0;
+	}
+}
+
 /*****************************************************************************
  *
  * NAME: u64ST7032i_nextExecTime
@@ -756,20 +1290,20 @@ PRIVATE bool_t bST7032i_writeControlEx() {
  * NOTES:
  * None.
  *****************************************************************************/
-PRIVATE uint32 u64ST7032i_nextExecTime(uint8 u8Cmd) {
-	// デバイスの処理待ち
-	uint32 nextTick;
+PRIVATE uint64 u64ST7032i_nextExecTime(uint8 u8Cmd) {
+	// デバイスの処理待ち（マイクロ秒）
+	uint32 nextUsec;
 	switch(u8Cmd) {
 		case ST7032i_CMD_CLEAR_DISP:
 		case ST7032i_CMD_RETURN_HOME:
 			// 1.08ミリ秒待つ
-			nextTick = 1080 * TIMER_UTIL_TICK_PER_USEC;
+			nextUsec = 1080;
 			break;
 		default:
 			// 27マイクロ秒待つ
-			nextTick = 27 * TIMER_UTIL_TICK_PER_USEC;
+			nextUsec = 27;
 	}
-	return u64TimerUtil_readUsec() + nextTick;
+	return u64TimerUtil_readUsec() + nextUsec;
 }
 
 /*****************************************************************************
@@ -787,7 +1321,12 @@ PRIVATE uint32 u64ST7032i_nextExecTime(uint8 u8Cmd) {
  * None.
  *****************************************************************************/
 PRIVATE bool_t bST7032i_errorEnd() {
-	bI2C_stopACK();
+	// 直接通信の場合は送信途中のI2C通信を完了
+	if (u8ST7032i_schedDevIdx == I2C_SCHED_DEVICE_NONE) {
+		bI2C_stopACK();
+	}
+	// 送信途中の内容は不明なので表示内容の写しを破棄
+	vST7032i_resetFrame('\0', ST7032i_ADDR_UNKNOWN);
 	return FALSE;
 }
 
@@ -8,6 +8,9 @@
  * DESCRIPTION:ST7032I LCD I2C draiver
  *
  * CHANGE HISTORY:
+ * 2026/10/19 09:00:00 表示内容の写しによる差分描画を追加
+ * 2026/10/19 10:00:00 コマンドのキューイングによる非同期実行を追加
+ * 2026/10/19 17:00:00 I2Cスケジューラのデバイスの設定を追加
  *
  * LAST MODIFIED BY:
  *
@@ -34,6 +37,24 @@ extern "C" {
 #define ST7032i_ICON_DATA_SIZE       (16)
 // Address Read/Write
 #define I2C_ADDR_ST7032I             (0x3E)
+// 表示行数
+#define ST7032i_ROW_SIZE             (2)
+// 表示桁数
+#define ST7032i_COL_SIZE             (16)
+// アドレスカウンタ：不明
+#define ST7032i_ADDR_UNKNOWN         (0xFF)
+// トランザクションバッファサイズ（制御バイトを含む）
+#ifndef ST7032i_TRNS_BUFF_SIZE
+	#define ST7032i_TRNS_BUFF_SIZE   (32)
+#endif
+// 非同期実行：コマンドキューサイズ（トランザクション毎に長さ１バイトを含む）
+#ifndef ST7032i_QUEUE_SIZE
+	#define ST7032i_QUEUE_SIZE       (128)
+#endif
+// 非同期実行：その場で待つ実行可能時刻までの最大時間（マイクロ秒）
+#ifndef ST7032i_ASYNC_SPIN_USEC
+	#define ST7032i_ASYNC_SPIN_USEC  (100)
+#endif
 
 /****************************************************************************/
 /***        Type Definitions                                              ***/
@@ -51,7 +72,29 @@ typedef struct {
 	// アイコンデータ
 	uint8 u8IconData[ST7032i_ICON_DATA_SIZE];
 	// 次回コマンド実行可能時刻
-	uint32 u64nextExec;
+	uint64 u64nextExec;
+	// 表示内容の写し（'\0'は内容不明）
+	char cFrame[ST7032i_ROW_SIZE][ST7032i_COL_SIZE];
+	// DDRAMアドレスカウンタの写し（ST7032i_ADDR_UNKNOWN：不明）
+	uint8 u8DDAddr;
+	// 画面制御コマンドの写し（0：不明）
+	uint8 u8DispCntrCmd;
+	// 統計情報：送信バイト数
+	uint32 u32TxByteCnt;
+	// 構築中のトランザクション（制御バイトとコマンドの組、もしくは制御バイトとデータ列）
+	uint8 u8TrnsBuff[ST7032i_TRNS_BUFF_SIZE];
+	// 構築中のトランザクションの長さ
+	uint8 u8TrnsLen;
+	// 非同期実行フラグ
+	bool_t bAsyncFlg;
+	// 非同期実行：コマンドキュー（長さ、送信データの順に格納）
+	uint8 u8Queue[ST7032i_QUEUE_SIZE];
+	// 非同期実行：コマンドキューの先頭（未実行のトランザクション）
+	uint16 u16QueueHead;
+	// 非同期実行：コマンドキューの末尾
+	uint16 u16QueueTail;
+	// 統計情報：キューが溢れて同期的に実行した回数
+	uint32 u32QueueFullCnt;
 } ST7032i_state;
 
 /****************************************************************************/
@@ -71,6 +114,8 @@ typedef struct {
 /****************************************************************************/
 // デバイス選択
 PUBLIC bool_t bST7032i_deviceSelect(ST7032i_state* psState);
+// I2Cスケジューラのデバイスの設定
+PUBLIC void vST7032i_setSchedDevice(uint8 u8DevIdx);
 // 初期化
 PUBLIC bool_t bST7032i_init();
 // 画面制御設定（ディスプレイON/OFF、カーソル表示、カーソル点滅、アイコン表示）
@@ -97,6 +142,16 @@ PUBLIC bool_t bST7032i_writeChar(char cCh);
 PUBLIC bool_t bST7032i_writeString(char* pcStr);
 // アイコン表示制御
 PUBLIC bool_t bST7032i_writeIcon(uint8 u8IconNo);
+// 行の描画（表示内容との差分のみ送信）
+PUBLIC bool_t bST7032i_drawRow(uint8 u8RowNo, char* pcStr);
+// 非同期実行の設定
+PUBLIC bool_t bST7032i_setAsync(bool_t bAsyncFlg);
+// 非同期実行の進行
+PUBLIC bool_t bST7032i_asyncProceed();
+// 非同期実行の実行中判定
+PUBLIC bool_t bST7032i_asyncIsBusy();
+// 非同期実行の完了待ち
+PUBLIC bool_t bST7032i_asyncWait();
 
 /****************************************************************************/
 /***        Local Functions                                               ***/
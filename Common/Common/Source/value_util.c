@@ -8,6 +8,7 @@
  * DESCRIPTION:値の変換等の値に関する基本的なユーティリティ関数群
  *
  * CHANGE HISTORY:
+ * 2026/10/19 03:00:00 基準年からの経過秒数と日時の変換関数を追加
  *
  * LAST MODIFIED BY:
  *
@@ -230,6 +231,78 @@ PUBLIC tsDate sValUtil_dayToDate(uint32 u32Days) {
 	return sDate;
 }
 
+/*****************************************************************************
+ *
+ * NAME: u32ValUtil_datetimeToSec
+ *
+ * DESCRIPTION:変換関数（基準年1月1日0時0分0秒からの経過秒数への変換）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *       uint16     u16Year         R   年（基準年以降）
+ *       uint8      u8Month         R   月(1-12)
+ *       uint8      u8Day           R   日(1-31)
+ *       uint8      u8Hour          R   時(0-23)
+ *       uint8      u8Min           R   分(0-59)
+ *       uint8      u8Sec           R   秒(0-59)
+ *
+ * RETURNS:
+ *     uint32 変換結果（基準年1月1日0時0分0秒からの経過秒数）
+ *
+ * NOTES:
+ * 日時の妥当性は呼び出し元でチェックする事
+ *****************************************************************************/
+PUBLIC uint32 u32ValUtil_datetimeToSec(uint16 u16Year, uint8 u8Month, uint8 u8Day, uint8 u8Hour, uint8 u8Min, uint8 u8Sec) {
+	// 基準年1月1日からの経過日数
+	uint32 u32Days = u32ValUtil_dateToDays(u16Year, u8Month, u8Day) -
+					 u32ValUtil_dateToDays(VAL_UTIL_EPOCH_YEAR, 1, 1);
+	return ((u32Days * 24 + u8Hour) * 60 + u8Min) * 60 + u8Sec;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vValUtil_secToDatetime
+ *
+ * DESCRIPTION:変換関数（基準年1月1日0時0分0秒からの経過秒数から日時への変換）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *       uint32     u32Sec          R   基準年1月1日0時0分0秒からの経過秒数
+ *       tsDate*    psDate          W   変換結果（日付）
+ *       tsTime*    psTime          W   変換結果（時刻）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vValUtil_secToDatetime(uint32 u32Sec, tsDate* psDate, tsTime* psTime) {
+	// 時刻の算出
+	psTime->u8Seconds = u32Sec % 60;
+	psTime->u8Minutes = (u32Sec / 60) % 60;
+	psTime->u8Hour    = (u32Sec / 3600) % 24;
+	// 年の算出
+	uint32 u32Days = u32Sec / 86400;
+	uint16 u16Year = VAL_UTIL_EPOCH_YEAR;
+	uint16 u16YearDays = bValUtil_isLeapYear(u16Year) ? 366 : 365;
+	while (u32Days >= u16YearDays) {
+		u32Days = u32Days - u16YearDays;
+		u16Year++;
+		u16YearDays = bValUtil_isLeapYear(u16Year) ? 366 : 365;
+	}
+	// 月日の算出
+	uint8 u8MonthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	if (u16YearDays == 366) {
+		u8MonthDays[1] = 29;
+	}
+	uint8 u8Idx = 0;
+	while (u32Days >= u8MonthDays[u8Idx]) {
+		u32Days = u32Days - u8MonthDays[u8Idx];
+		u8Idx++;
+	}
+	psDate->u16Year = u16Year;
+	psDate->u8Month = u8Idx + 1;
+	psDate->u8Day   = u32Days + 1;
+}
+
 /*****************************************************************************
  *
  * NAME: u16ValUtil_getRandVal
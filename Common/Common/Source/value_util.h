@@ -8,6 +8,7 @@
  * DESCRIPTION:値の変換等の値に関する基本的なユーティリティ関数群
  *
  * CHANGE HISTORY:
+ * 2026/10/19 03:00:00 基準年からの経過秒数と日時の変換関数を追加
  *
  * LAST MODIFIED BY:
  *
@@ -38,6 +39,10 @@ extern "C" {
 #ifndef IO_UTIL_DI_BUFF_SIZE
 	#define IO_UTIL_DI_BUFF_SIZE      (30)
 #endif
+/** 経過秒数の基準年（基準年1月1日0時0分0秒からの経過秒数） */
+#define VAL_UTIL_EPOCH_YEAR       (2000)
+/** 経過秒数の上限年（uint32で表現可能な上限年、当年は含まない） */
+#define VAL_UTIL_EPOCH_YEAR_LIMIT (2136)
 
 /****************************************************************************/
 /***        Type Definitions                                              ***/
@@ -92,6 +97,10 @@ PUBLIC uint32 u32ValUtil_stringToU32(char* pcStr, uint8 u8Begin, uint8 u8Length)
 PUBLIC uint32 u32ValUtil_dateToDays(uint16 u16Year, uint8 u8Month, uint8 u8Day);
 /** 紀元1月1日からの経過日数から日付への変換 */
 PUBLIC tsDate sValUtil_dayToDate(uint32 u32Days);
+/** 基準年からの経過秒数への変換 */
+PUBLIC uint32 u32ValUtil_datetimeToSec(uint16 u16Year, uint8 u8Month, uint8 u8Day, uint8 u8Hour, uint8 u8Min, uint8 u8Sec);
+/** 基準年からの経過秒数から日時への変換 */
+PUBLIC void vValUtil_secToDatetime(uint32 u32Sec, tsDate* psDate, tsTime* psTime);
 /** 生成関数：乱数 */
 PUBLIC uint16 u16ValUtil_getRandVal();
 /** 生成関数：乱数 */
@@ -9,6 +9,9 @@
  *
  * CHANGE HISTORY:
  * 2018/01/27 23:19:00 認証時の通信データをAES暗号化
+ * 2026/10/18 10:00:00 返信トークンと次回認証トークンの事前計算キャッシュを追加
+ * 2026/10/18 11:00:00 認証後の連続コマンドをセッションで認証
+ * 2026/10/18 13:00:00 受信電文の改竄検知エラーを追加
  *
  * LAST MODIFIED BY:
  *
@@ -43,6 +46,23 @@ extern "C" {
 // 温度センサー閾値（整数で扱う為に100倍の値）
 #define APP_TEMPERATURE_THRESHOLD        (5500)
 
+/** 認証事前計算：キャッシュサイズ（直近に認証したリモートデバイス数） */
+#ifndef APP_AUTH_PRECALC_SIZE
+	#define APP_AUTH_PRECALC_SIZE        (2)
+#endif
+/** 認証事前計算：イベント実行間隔（ミリ秒） */
+#ifndef APP_AUTH_PRECALC_INTERVAL
+	#define APP_AUTH_PRECALC_INTERVAL    (20)
+#endif
+/** 認証事前計算：１イベントあたりのストレッチング回数 */
+#ifndef APP_AUTH_PRECALC_ROUNDS
+	#define APP_AUTH_PRECALC_ROUNDS      (4)
+#endif
+/** 認証事前計算：アンカー（途中ハッシュ）の先行分数 */
+#ifndef APP_AUTH_PRECALC_AHEAD_MIN
+	#define APP_AUTH_PRECALC_AHEAD_MIN   (30)
+#endif
+
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/
@@ -94,7 +114,9 @@ typedef enum {
 	E_EVENT_STS_ALARM_LOG,
 	E_EVENT_STS_MST_UNLOCK,
 	E_EVENT_LCD_DRAWING,
-	E_EVENT_HASH_ST
+	E_EVENT_HASH_ST,
+	E_EVENT_AUTH_PRECALC,
+	E_EVENT_RX_SESSION
 } teAppEvent;
 
 // Application Command
@@ -103,6 +125,10 @@ typedef enum {
 	E_APP_CMD_UNLOCK     = (0x01),	// 送受信コマンド：開錠要求
 	E_APP_CMD_LOCK       = (0x02),	// 送受信コマンド：施錠要求
 	E_APP_CMD_ALERT      = (0x03),	// 送受信コマンド：警戒施錠要求
+	E_APP_CMD_SESSION    = (0x10),	// 送受信コマンド：セッションコマンド（各要求コマンドとの論理和）
+	E_APP_CMD_SES_UNLOCK = (0x11),	// 送受信コマンド：セッション開錠要求
+	E_APP_CMD_SES_LOCK   = (0x12),	// 送受信コマンド：セッション施錠要求
+	E_APP_CMD_SES_ALERT  = (0x13),	// 送受信コマンド：セッション警戒施錠要求
 	E_APP_CMD_MST_UNLOCK = (0x7F),	// 送受信コマンド：マスター開錠要求
 	E_APP_CMD_ACK        = (0x80),	// 送受信コマンド：認証なしACK
 	E_APP_CMD_AUTH_ACK   = (0x81),	// 送受信コマンド：認証ありACK
@@ -130,7 +156,8 @@ typedef enum {
 	E_MSG_CD_SERVO_ERR,						// サーボ位置エラー
 	E_MSG_CD_OPEN_SENS_ERR,					// 開放センサーエラー
 	E_MSG_CD_BUTTON_ERR,					// ボタン操作エラー
-	E_MSG_CD_IR_SENS_ERR					// 赤外線センサーエラー
+	E_MSG_CD_IR_SENS_ERR,					// 赤外線センサーエラー
+	E_MSG_CD_RX_MIC_ERR						// 受信データ改竄検知エラー
 } teAppMsgCD;
 
 // 構造体：アプリケーションステータス情報
@@ -158,6 +185,49 @@ typedef struct {
 	uint32 u32PwrOffTime;				// 5V電源オフ時刻
 } tsAppEventInfo;
 
+// 認証事前計算ステータス
+typedef enum {
+	E_APP_PRECALC_STS_EMPTY = 0,				// 未使用
+	E_APP_PRECALC_STS_INIT,						// 登録済み（アンカー未生成）
+	E_APP_PRECALC_STS_ANCHOR,					// アンカー生成中
+	E_APP_PRECALC_STS_DERIVE,					// 返信トークン生成中
+	E_APP_PRECALC_STS_READY						// 生成完了
+} teAppPrecalcStatus;
+
+// 認証事前計算の参照結果
+typedef enum {
+	E_APP_PRECALC_MISS = 0,						// ミス
+	E_APP_PRECALC_PART_HIT,						// 部分ヒット（認証トークンのみ）
+	E_APP_PRECALC_HIT,							// ヒット（返信トークンと認証トークン）
+	E_APP_PRECALC_RESULT_CNT					// 参照結果の種類数
+} teAppPrecalcResult;
+
+// 構造体：認証事前計算キャッシュ
+typedef struct {
+	teAppPrecalcStatus eStatus;					// ステータス
+	uint32 u32DeviceID;							// デバイスID
+	uint32 u32StartDateTime;					// 認証情報の利用開始日時（紀元からの分数）
+	uint8 u8SyncToken[APP_AUTH_TOKEN_SIZE];		// 同期トークン
+	uint8 u8AuthCode[APP_AUTH_TOKEN_SIZE];		// 認証コード（受信側）
+	uint8 u8RcvStretching;						// ストレッチングカウント（受信側）
+	uint8 u8AuthStCnt;							// 次回の認証ストレッチング回数（送信側）
+	uint8 u8AuthTkn[APP_AUTH_TOKEN_SIZE];		// 次回の認証トークン
+	uint32 u32AnchorMin;						// アンカーの対象分（経過分数）
+	tsAuthHashGenState sAnchorState;			// アンカー生成情報
+	tsAuthHashGenState sRespState;				// 返信トークン生成情報
+	uint32 u32RespMin;							// 返信トークンの基準分（経過分数）
+	bool_t bCurValid;							// 基準分の返信トークン有効フラグ
+	uint8 u8RespTknCur[APP_AUTH_TOKEN_SIZE];	// 返信トークン（基準分）
+	uint8 u8RespTknNext[APP_AUTH_TOKEN_SIZE];	// 返信トークン（基準分の次の分）
+} tsAppAuthPrecalc;
+
+// 構造体：認証事前計算統計情報
+typedef struct {
+	uint16 u16Cnt[E_APP_PRECALC_RESULT_CNT];		// 参照結果毎の件数
+	uint32 u32LastUsec[E_APP_PRECALC_RESULT_CNT];	// 参照結果毎の直近の応答時間（マイクロ秒）
+	uint64 u64TotalUsec[E_APP_PRECALC_RESULT_CNT];	// 参照結果毎の応答時間の合計（マイクロ秒）
+} tsAppAuthPrecalcStats;
+
 // 構造体：送受信トランザクション情報
 typedef struct {
 	DS3231_datetime sRefDatetime;				// 基準日時
@@ -173,6 +243,9 @@ typedef struct {
 	tsWirelessMsg sRxWlsMsg;					// 受信メッセージ
 	teAppEvent eRtnAppEvt;						// 復帰イベント
 	teAppEvent eOkAppEvt;						// 認証成功後イベント
+	uint64 u64BeginUsec;						// トランザクション開始時刻（マイクロ秒）
+	tsAppAuthPrecalc* psPrecalc;				// 参照した認証事前計算キャッシュ
+	teAppPrecalcResult ePrecalcResult;			// 認証事前計算の参照結果
 } tsAppTxRxTrnsInfo;
 
 /******************************************************************************/
@@ -188,6 +261,8 @@ PUBLIC tsAppStatusInfo sAppStsInfo;
 PUBLIC tsAppEventMap sAppEventMap;
 /** アプリケーションイベントパラメータ */
 PUBLIC tsAppEventInfo sAppEventInfo;
+/** 認証事前計算統計情報 */
+PUBLIC tsAppAuthPrecalcStats sAuthPrecalcStats;
 
 ///** デバッグステータス値 */
 #ifdef DEBUG
@@ -252,6 +327,14 @@ PUBLIC void vEvent_StsMstUnlock(uint32 u32EvtTimeMs);
 PUBLIC void vEvent_LCDdrawing(uint32 u32EvtTimeMs);
 // 拡張ハッシュストレッチング処理イベントプロセス
 PUBLIC void vEvent_HashStretching(uint32 u32EvtTimeMs);
+// イベント処理：認証事前計算処理
+PUBLIC void vEvent_AuthPrecalc(uint32 u32EvtTimeMs);
+// 認証事前計算キャッシュのクリア
+PUBLIC void vEvent_ClearAuthPrecalc();
+// イベント処理：セッション認証処理
+PUBLIC void vEvent_RxSession(uint32 u32EvtTimeMs);
+// セッション情報のクリア
+PUBLIC void vEvent_ClearSession();
 
 /******************************************************************************/
 /***        Local Functions                                                 ***/
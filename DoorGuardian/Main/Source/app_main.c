@@ -8,6 +8,7 @@
  * DESCRIPTION:アプリケーション特有のイベント処理を実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 19:00:00 I2Cの非同期処理を初期化
  *
  * LAST MODIFIED BY:
  *
@@ -285,6 +286,8 @@ PUBLIC void vEventStartup(tsEvent *psEv, teEvent eEvent, uint32 u32EvArg) {
 		SERIAL_vFlush(sSerStream.u8Device);
 	}
 #endif
+	// I2Cの非同期処理の初期化（割り込み処理の登録）
+	vI2C_initAsync();
 	// 外部入出力ドライバや制御タスクの初期処理
 	vAppIOInit();
 	// イベント処理の登録
@@ -316,6 +319,10 @@ PUBLIC uint8 u8EventSysCtrl(uint32 u32DeviceId, uint32 u32ItemBitmap) {
 	if (bAHI_BrownOutStatus()) {
 		// マスタートークンマスククリア
 		vEEPROMTokenMaskClear();
+		// 認証事前計算キャッシュクリア
+		vEvent_ClearAuthPrecalc();
+		// セッションクリア
+		vEvent_ClearSession();
 #ifdef DEBUG
 		vfPrintf(&sSerStream, "MS:%08d u8EventSysCtrl Brownout!\n", u32TickCount_ms);
 		SERIAL_vFlush(sSerStream.u8Device);
@@ -8,6 +8,7 @@
  * DESCRIPTION:各モジュールのデバッグコードを実装
  *
  * CHANGE HISTORY:
+ * 2026/10/19 14:00:00 AESのテストケースと性能測定のデバッグを追加
  *
  * LAST MODIFIED BY:
  *
@@ -46,6 +47,7 @@
 #include "i2c_util.h"
 #include "st7032i.h"
 #include "sha256.h"
+#include "aes_test.h"
 #include "ds3231.h"
 #include "io_util.h"
 
@@ -108,6 +110,8 @@ PUBLIC void vDEBUG_main() {
 //	vST7032I_debug();
 	// SHA256デバッグコード
 //	vSHA256_debug();
+	// AESデバッグコード
+//	vAES_debug();
 	// DS3231デバッグコード
 //	vDS3231_debug();
 	// Timer Utilデバッグコード
@@ -943,6 +947,17 @@ PUBLIC void vSHA256_debug() {
 
 }
 
+// AESデバッグ
+PUBLIC void vAES_debug() {
+	vDEBUG_dispMsg("\n\n\n");
+	vDEBUG_dispMsg("vAES_debug Start\n");
+	// 全バックエンドのテストケース
+	vAES_test();
+	// 性能測定
+	vAES_benchmark();
+	vDEBUG_dispMsg("\nvAES_debug End\n");
+}
+
 /****************************************************************************/
 /***        Local Functions                                               ***/
 /****************************************************************************/
@@ -8,6 +8,7 @@
  * DESCRIPTION:アプリケーション特有の基本的な処理を実装
  *
  * CHANGE HISTORY:
+ * 2026/10/19 14:00:00 AESのテストケースと性能測定のデバッグを追加
  *
  * LAST MODIFIED BY:
  *
@@ -58,6 +59,8 @@ PUBLIC void vST7032I_debug();
 PUBLIC void vDS3231_debug();
 // SHA256デバッグ
 PUBLIC void vSHA256_debug();
+// AESデバッグ
+PUBLIC void vAES_debug();
 // デバッグメッセージ表示処理
 PUBLIC void vDEBUG_dispMsg(const char* fmt);
 
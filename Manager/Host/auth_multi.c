@@ -0,0 +1,346 @@
+/****************************************************************************
+ *
+ * MODULE :Auth Multi-buffer Stretching functions source file
+ *
+ * CREATED:2026/10/19 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境で多数のハッシュストレッチングを並行実行する関数群
+ *   Auth Multi-buffer Stretching functions (source file)
+ *   ・１ラウンドの処理はbAuth_hashStretchingと同一（SHA-256の後にシャッフル）
+ *   ・SIMDの圧縮関数はauth_multi_sse2.c、auth_multi_avx2.cに分離し、
+ *     実行中のCPUが対応している場合のみ選択する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <string.h>
+#include <pthread.h>
+#include <jendefs.h>
+
+#include "sha256.h"
+#include "app_auth.h"
+#include "auth_multi.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// x86環境（SSE2/AVX2の実装をリンクする）
+#if defined(__x86_64__) || defined(__i386__)
+	#define AUTH_MULTI_USE_X86
+#endif
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：一括実行の状態（スレッド間で共有）
+typedef struct {
+	// 実装
+	const tsAuthMulti_backend* psBackend;
+	// ジョブ
+	tsAuthMulti_job* psJobs;
+	// ジョブ数
+	uint32 u32JobCnt;
+	// 次に取り出すジョブ（アトミックに更新）
+	uint32 u32NextIdx;
+} tsAuthMulti_ctx;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// スカラー実装のハッシュ値算出
+PRIVATE void vAuthMulti_hash32Scalar(uint8 pu8Msg[][APP_AUTH_TOKEN_SIZE]);
+// 次のジョブの取り出し
+PRIVATE tsAuthMulti_job* psAuthMulti_nextJob(tsAuthMulti_ctx* psCtx);
+// シャッフル
+PRIVATE void vAuthMulti_shuffle(uint8* pu8Code, uint32 u32ShufflePtn);
+// ワーカースレッド
+PRIVATE void* pvAuthMulti_worker(void* pvCtx);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 実装
+PRIVATE const tsAuthMulti_backend sAuthMulti_backends[] = {
+	{"scalar", 1, vAuthMulti_hash32Scalar},
+#ifdef AUTH_MULTI_USE_X86
+	{"sse2",   4, vAuthMulti_hash32SSE2},
+	{"avx2",   8, vAuthMulti_hash32AVX2},
+#endif
+};
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: psAuthMulti_getBackend
+ *
+ * DESCRIPTION:実装の取得
+ *
+ * PARAMETERS:          Name         RW  Usage
+ *   teAuthMulti_impl   eImpl        R   実装
+ *
+ * RETURNS:
+ *   tsAuthMulti_backend* 実装、実行中のCPUで利用出来ない場合はNULL
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC const tsAuthMulti_backend* psAuthMulti_getBackend(teAuthMulti_impl eImpl) {
+#ifdef AUTH_MULTI_USE_X86
+	__builtin_cpu_init();
+	bool_t bAVX2 = __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+	switch (eImpl) {
+	case E_AUTH_MULTI_SCALAR:
+		return &sAuthMulti_backends[0];
+	case E_AUTH_MULTI_SSE2:
+		return &sAuthMulti_backends[1];
+	case E_AUTH_MULTI_AVX2:
+		return bAVX2 ? &sAuthMulti_backends[2] : NULL;
+	case E_AUTH_MULTI_AUTO:
+		return bAVX2 ? &sAuthMulti_backends[2] : &sAuthMulti_backends[1];
+	default:
+		return NULL;
+	}
+#else
+	if (eImpl == E_AUTH_MULTI_SCALAR || eImpl == E_AUTH_MULTI_AUTO) {
+		return &sAuthMulti_backends[0];
+	}
+	return NULL;
+#endif
+}
+
+/*****************************************************************************
+ *
+ * NAME: vAuthMulti_setJob
+ *
+ * DESCRIPTION:ジョブの編集
+ *
+ * PARAMETERS:            Name           RW  Usage
+ *   tsAuthMulti_job*     psJob          W   ジョブ
+ *   tsAuthHashGenState*  psHashGenInfo  R   ハッシュ生成情報
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * sAuth_generateHashInfoとvAuth_setSyncTokenで編集したハッシュ生成情報を
+ * そのまま使用し、app_auth.cと同じ元コード、シャッフルパターン、回数とする
+ *****************************************************************************/
+PUBLIC void vAuthMulti_setJob(tsAuthMulti_job* psJob, const tsAuthHashGenState* psHashGenInfo) {
+	memcpy(psJob->u8Code, psHashGenInfo->u8HashCode, APP_AUTH_TOKEN_SIZE);
+	psJob->u32ShufflePtn = psHashGenInfo->u32ShufflePtn;
+	psJob->u16StCnt      = psHashGenInfo->u16StCntEnd - psHashGenInfo->u16StCntNow;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bAuthMulti_run
+ *
+ * DESCRIPTION:ジョブの一括実行
+ *
+ * PARAMETERS:            Name           RW  Usage
+ *   tsAuthMulti_backend* psBackend      R   実装
+ *   tsAuthMulti_job*     psJobs         RW  ジョブ
+ *   uint32               u32JobCnt      R   ジョブ数
+ *   uint8                u8Threads      R   スレッド数（0は1とみなす）
+ *
+ * RETURNS:
+ *   bool_t TRUE:全ジョブ完了 FALSE:実装が無い
+ *
+ * NOTES:
+ * 呼び出し元のスレッドもワーカーとして動作する
+ * スレッドを生成出来ない場合も、残りのスレッドで全ジョブを処理する
+ *****************************************************************************/
+PUBLIC bool_t bAuthMulti_run(const tsAuthMulti_backend* psBackend, tsAuthMulti_job* psJobs, uint32 u32JobCnt, uint8 u8Threads) {
+	if (psBackend == NULL) {
+		return FALSE;
+	}
+	tsAuthMulti_ctx sCtx;
+	sCtx.psBackend  = psBackend;
+	sCtx.psJobs     = psJobs;
+	sCtx.u32JobCnt  = u32JobCnt;
+	sCtx.u32NextIdx = 0;
+	// スレッドプールの起動
+	if (u8Threads > AUTH_MULTI_THREAD_MAX) {
+		u8Threads = AUTH_MULTI_THREAD_MAX;
+	}
+	pthread_t sThreads[AUTH_MULTI_THREAD_MAX];
+	uint8 u8Started = 0;
+	uint8 u8Idx;
+	for (u8Idx = 1; u8Idx < u8Threads; u8Idx++) {
+		if (pthread_create(&sThreads[u8Started], NULL, pvAuthMulti_worker, &sCtx) != 0) {
+			break;
+		}
+		u8Started++;
+	}
+	// 呼び出し元のスレッドでも処理
+	pvAuthMulti_worker(&sCtx);
+	for (u8Idx = 0; u8Idx < u8Started; u8Idx++) {
+		pthread_join(sThreads[u8Idx], NULL);
+	}
+	return TRUE;
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vAuthMulti_hash32Scalar
+ *
+ * DESCRIPTION:スカラー実装のハッシュ値算出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8[][]      pu8Msg          RW  メッセージ（1レーン）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vAuthMulti_hash32Scalar(uint8 pu8Msg[][APP_AUTH_TOKEN_SIZE]) {
+	vSHA256_generateHash32(pu8Msg[0], pu8Msg[0]);
+}
+
+/*****************************************************************************
+ *
+ * NAME: psAuthMulti_nextJob
+ *
+ * DESCRIPTION:次のジョブの取り出し
+ *
+ * PARAMETERS:          Name         RW  Usage
+ *   tsAuthMulti_ctx*   psCtx        RW  一括実行の状態
+ *
+ * RETURNS:
+ *   tsAuthMulti_job*   ジョブ、全て取り出し済みの場合はNULL
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE tsAuthMulti_job* psAuthMulti_nextJob(tsAuthMulti_ctx* psCtx) {
+	uint32 u32Idx = __atomic_fetch_add(&psCtx->u32NextIdx, 1, __ATOMIC_RELAXED);
+	if (u32Idx >= psCtx->u32JobCnt) {
+		return NULL;
+	}
+	return &psCtx->psJobs[u32Idx];
+}
+
+/*****************************************************************************
+ *
+ * NAME: vAuthMulti_shuffle
+ *
+ * DESCRIPTION:シャッフル
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8*         pu8Code         RW  ハッシュ値
+ *   uint32         u32ShufflePtn   R   シャッフルパターン
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * bAuth_hashStretchingと同一（下位ビットから順に、立っているビットの位置と
+ * 次の位置のバイトを入れ替える）
+ *****************************************************************************/
+PRIVATE void vAuthMulti_shuffle(uint8* pu8Code, uint32 u32ShufflePtn) {
+	uint8 u8Idx = 0;
+	uint8 u8WkCode;
+	while (u32ShufflePtn > 0) {
+		if ((u32ShufflePtn & 0x01) == 0x01) {
+			u8WkCode = pu8Code[u8Idx];
+			pu8Code[u8Idx] = pu8Code[(u8Idx + 1) % APP_AUTH_TOKEN_SIZE];
+			pu8Code[(u8Idx + 1) % APP_AUTH_TOKEN_SIZE] = u8WkCode;
+		}
+		u8Idx++;
+		u32ShufflePtn = u32ShufflePtn >> 1;
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: pvAuthMulti_worker
+ *
+ * DESCRIPTION:ワーカースレッド
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pvCtx           RW  一括実行の状態
+ *
+ * RETURNS:
+ *   void*          NULL固定
+ *
+ * NOTES:
+ * 空いたレーンにジョブを補充しながら、全レーンを１ラウンドずつ進める
+ * 空きレーンのハッシュ値も算出されるが、結果は使用しない
+ *****************************************************************************/
+PRIVATE void* pvAuthMulti_worker(void* pvCtx) {
+	tsAuthMulti_ctx* psCtx = (tsAuthMulti_ctx*)pvCtx;
+	const tsAuthMulti_backend* psBackend = psCtx->psBackend;
+	uint8 u8Msg[AUTH_MULTI_LANE_MAX][APP_AUTH_TOKEN_SIZE];
+	tsAuthMulti_job* psLaneJob[AUTH_MULTI_LANE_MAX];
+	uint16 u16Remain[AUTH_MULTI_LANE_MAX];
+	memset(u8Msg, 0x00, sizeof(u8Msg));
+	memset(psLaneJob, 0x00, sizeof(psLaneJob));
+	uint8 u8Lane;
+	uint8 u8Active;
+	while (TRUE) {
+		// 空きレーンへのジョブの補充
+		u8Active = 0;
+		for (u8Lane = 0; u8Lane < psBackend->u8Lanes; u8Lane++) {
+			while (psLaneJob[u8Lane] == NULL) {
+				tsAuthMulti_job* psJob = psAuthMulti_nextJob(psCtx);
+				if (psJob == NULL) {
+					break;
+				}
+				// ストレッチング回数0のジョブは元コードのまま
+				if (psJob->u16StCnt == 0) {
+					continue;
+				}
+				psLaneJob[u8Lane] = psJob;
+				u16Remain[u8Lane] = psJob->u16StCnt;
+				memcpy(u8Msg[u8Lane], psJob->u8Code, APP_AUTH_TOKEN_SIZE);
+			}
+			if (psLaneJob[u8Lane] != NULL) {
+				u8Active++;
+			}
+		}
+		if (u8Active == 0) {
+			break;
+		}
+		// 全レーンのハッシュ値算出
+		psBackend->pfHash32(u8Msg);
+		// レーン毎のシャッフルと完了判定
+		for (u8Lane = 0; u8Lane < psBackend->u8Lanes; u8Lane++) {
+			tsAuthMulti_job* psJob = psLaneJob[u8Lane];
+			if (psJob == NULL) {
+				continue;
+			}
+			vAuthMulti_shuffle(u8Msg[u8Lane], psJob->u32ShufflePtn);
+			u16Remain[u8Lane]--;
+			if (u16Remain[u8Lane] == 0) {
+				memcpy(psJob->u8Code, u8Msg[u8Lane], APP_AUTH_TOKEN_SIZE);
+				psLaneJob[u8Lane] = NULL;
+			}
+		}
+	}
+	return NULL;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
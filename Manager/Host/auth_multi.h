@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ * MODULE :Auth Multi-buffer Stretching functions header file
+ *
+ * CREATED:2026/10/19 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   ホスト環境で多数のハッシュストレッチングを並行実行する関数群
+ *   Auth Multi-buffer Stretching functions (header file)
+ *   ・SHA-256の圧縮関数をSIMD（SSE2：4レーン、AVX2：8レーン）で複数のメッセージに
+ *     同時に適用し、レーン毎にapp_auth.cと同じシャッフルを行う
+ *   ・完了したレーンには次のジョブを補充し、ストレッチング回数の異なるジョブを
+ *     無駄なく処理する
+ *   ・スレッドプールの各スレッドは共有のジョブキューから取り出して処理する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+#ifndef  AUTH_MULTI_H_INCLUDED
+#define  AUTH_MULTI_H_INCLUDED
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+#include "app_auth.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 最大レーン数（AVX2）
+#define AUTH_MULTI_LANE_MAX        (8)
+// 最大スレッド数
+#define AUTH_MULTI_THREAD_MAX      (64)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 列挙型：実装
+typedef enum {
+	E_AUTH_MULTI_SCALAR = 0,	// 1レーン（sha256.cのvSHA256_generateHash32）
+	E_AUTH_MULTI_SSE2,			// 4レーン
+	E_AUTH_MULTI_AVX2,			// 8レーン
+	E_AUTH_MULTI_AUTO			// 実行中のCPUで利用可能な最速の実装
+} teAuthMulti_impl;
+
+// 構造体：実装
+typedef struct {
+	// 実装名
+	const char* pcName;
+	// レーン数
+	uint8 u8Lanes;
+	// レーン数分の32バイトメッセージのハッシュ値算出（結果で上書き）
+	void (*pfHash32)(uint8 pu8Msg[][APP_AUTH_TOKEN_SIZE]);
+} tsAuthMulti_backend;
+
+// 構造体：ジョブ
+typedef struct {
+	// 元コード（完了時はハッシュ値で上書き）
+	uint8 u8Code[APP_AUTH_TOKEN_SIZE];
+	// シャッフルパターン
+	uint32 u32ShufflePtn;
+	// ストレッチング回数
+	uint16 u16StCnt;
+} tsAuthMulti_job;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+// 実装の取得（実行中のCPUで利用出来ない場合はNULL）
+PUBLIC const tsAuthMulti_backend* psAuthMulti_getBackend(teAuthMulti_impl eImpl);
+// ジョブの編集（app_auth.cのハッシュ生成情報から）
+PUBLIC void vAuthMulti_setJob(tsAuthMulti_job* psJob, const tsAuthHashGenState* psHashGenInfo);
+// ジョブの一括実行（スレッドプール）
+PUBLIC bool_t bAuthMulti_run(const tsAuthMulti_backend* psBackend, tsAuthMulti_job* psJobs, uint32 u32JobCnt, uint8 u8Threads);
+// SSE2実装のハッシュ値算出（auth_multi_sse2.c）
+PUBLIC void vAuthMulti_hash32SSE2(uint8 pu8Msg[][APP_AUTH_TOKEN_SIZE]);
+// AVX2実装のハッシュ値算出（auth_multi_avx2.c）
+PUBLIC void vAuthMulti_hash32AVX2(uint8 pu8Msg[][APP_AUTH_TOKEN_SIZE]);
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* AUTH_MULTI_H_INCLUDED */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ * MODULE :Auth Multi-buffer SHA-256 (SSE2) source file
+ *
+ * CREATED:2026/10/19 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   32バイトメッセージ4件のSHA-256ハッシュ値をSSE2で同時に算出する
+ *   Auth Multi-buffer SHA-256 (SSE2) (source file)
+ *   ・32バイトメッセージはパディング込みで1ブロックに収まるため、
+ *     W8〜W15は定数（0x80000000、0、…、0x00000100）となる
+ *   ・各レーンは独立したメッセージで、結果はビッグエンディアンで格納する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <jendefs.h>
+
+#include "auth_multi.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// レーン数
+#define SSE2_LANES                 (4)
+// 右ローテート
+#define SSE2_ROTR(x, n)            _mm_or_si128(_mm_srli_epi32((x), (n)), _mm_slli_epi32((x), 32 - (n)))
+// 論理関数
+#define SSE2_CH(x, y, z)           _mm_xor_si128(_mm_and_si128((x), (y)), _mm_andnot_si128((x), (z)))
+#define SSE2_MAJ(x, y, z)          _mm_or_si128(_mm_and_si128((x), (y)), _mm_and_si128((z), _mm_or_si128((x), (y))))
+#define SSE2_SIGMA0(x)             _mm_xor_si128(_mm_xor_si128(SSE2_ROTR((x), 2), SSE2_ROTR((x), 13)), SSE2_ROTR((x), 22))
+#define SSE2_SIGMA1(x)             _mm_xor_si128(_mm_xor_si128(SSE2_ROTR((x), 6), SSE2_ROTR((x), 11)), SSE2_ROTR((x), 25))
+#define SSE2_GAMMA0(x)             _mm_xor_si128(_mm_xor_si128(SSE2_ROTR((x), 7), SSE2_ROTR((x), 18)), _mm_srli_epi32((x), 3))
+#define SSE2_GAMMA1(x)             _mm_xor_si128(_mm_xor_si128(SSE2_ROTR((x), 17), SSE2_ROTR((x), 19)), _mm_srli_epi32((x), 10))
+// 加算
+#define SSE2_ADD(x, y)             _mm_add_epi32((x), (y))
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 初期ハッシュ値
+PRIVATE const uint32 u32SSE2_iv[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+	0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// ラウンド定数
+PRIVATE const uint32 u32SSE2_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vAuthMulti_hash32SSE2
+ *
+ * DESCRIPTION:SSE2実装のハッシュ値算出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8[][]      pu8Msg          RW  メッセージ（4レーン、結果で上書き）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PUBLIC void vAuthMulti_hash32SSE2(uint8 pu8Msg[][APP_AUTH_TOKEN_SIZE]) {
+	uint32 u32Wk[8][SSE2_LANES] __attribute__((aligned(16)));
+	__m128i sW[16];
+	__m128i sS[8];
+	int iIdx;
+	int iLane;
+	// メッセージ（ビッグエンディアン）をレーン方向に並べ替え
+	for (iIdx = 0; iIdx < 8; iIdx++) {
+		for (iLane = 0; iLane < SSE2_LANES; iLane++) {
+			const uint8* pu8Src = &pu8Msg[iLane][iIdx * 4];
+			u32Wk[iIdx][iLane] = ((uint32)pu8Src[0] << 24) | ((uint32)pu8Src[1] << 16) |
+				((uint32)pu8Src[2] << 8) | (uint32)pu8Src[3];
+		}
+		sW[iIdx] = _mm_load_si128((const __m128i*)u32Wk[iIdx]);
+	}
+	// パディングとメッセージ長（256ビット）
+	sW[8] = _mm_set1_epi32((int)0x80000000);
+	for (iIdx = 9; iIdx < 15; iIdx++) {
+		sW[iIdx] = _mm_setzero_si128();
+	}
+	sW[15] = _mm_set1_epi32(0x00000100);
+	// 圧縮
+	for (iIdx = 0; iIdx < 8; iIdx++) {
+		sS[iIdx] = _mm_set1_epi32((int)u32SSE2_iv[iIdx]);
+	}
+	__m128i sA = sS[0], sB = sS[1], sC = sS[2], sD = sS[3];
+	__m128i sE = sS[4], sF = sS[5], sG = sS[6], sH = sS[7];
+	for (iIdx = 0; iIdx < 64; iIdx++) {
+		__m128i sWi;
+		if (iIdx < 16) {
+			sWi = sW[iIdx];
+		} else {
+			sWi = SSE2_ADD(SSE2_ADD(SSE2_GAMMA1(sW[(iIdx - 2) & 15]), sW[(iIdx - 7) & 15]),
+				SSE2_ADD(SSE2_GAMMA0(sW[(iIdx - 15) & 15]), sW[iIdx & 15]));
+			sW[iIdx & 15] = sWi;
+		}
+		__m128i sT1 = SSE2_ADD(SSE2_ADD(SSE2_ADD(sH, SSE2_SIGMA1(sE)), SSE2_ADD(SSE2_CH(sE, sF, sG),
+			_mm_set1_epi32((int)u32SSE2_k[iIdx]))), sWi);
+		__m128i sT2 = SSE2_ADD(SSE2_SIGMA0(sA), SSE2_MAJ(sA, sB, sC));
+		sH = sG;
+		sG = sF;
+		sF = sE;
+		sE = SSE2_ADD(sD, sT1);
+		sD = sC;
+		sC = sB;
+		sB = sA;
+		sA = SSE2_ADD(sT1, sT2);
+	}
+	sS[0] = SSE2_ADD(sS[0], sA);
+	sS[1] = SSE2_ADD(sS[1], sB);
+	sS[2] = SSE2_ADD(sS[2], sC);
+	sS[3] = SSE2_ADD(sS[3], sD);
+	sS[4] = SSE2_ADD(sS[4], sE);
+	sS[5] = SSE2_ADD(sS[5], sF);
+	sS[6] = SSE2_ADD(sS[6], sG);
+	sS[7] = SSE2_ADD(sS[7], sH);
+	// 演算結果のコピー（ビッグエンディアン）
+	for (iIdx = 0; iIdx < 8; iIdx++) {
+		_mm_store_si128((__m128i*)u32Wk[iIdx], sS[iIdx]);
+		for (iLane = 0; iLane < SSE2_LANES; iLane++) {
+			uint8* pu8Dst = &pu8Msg[iLane][iIdx * 4];
+			pu8Dst[0] = (uint8)(u32Wk[iIdx][iLane] >> 24);
+			pu8Dst[1] = (uint8)(u32Wk[iIdx][iLane] >> 16);
+			pu8Dst[2] = (uint8)(u32Wk[iIdx][iLane] >> 8);
+			pu8Dst[3] = (uint8)u32Wk[iIdx][iLane];
+		}
+	}
+}
+
+#endif  /* __x86_64__ || __i386__ */
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
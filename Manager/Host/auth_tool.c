@@ -0,0 +1,454 @@
+/****************************************************************************
+ *
+ * MODULE :Auth Provisioning Tool source file
+ *
+ * CREATED:2026/10/19 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   多数のデバイスの認証情報を一括生成するホスト環境（Linux）のコマンド
+ *   Auth Provisioning Tool (source file)
+ *   ・デバイス毎に、app_process.cのペアリングと同じ手順でトークンペア
+ *     （同期トークン、認証コード、ストレッチングカウント、認証ハッシュ）と
+ *     マスターパスワードハッシュ、指定経過分数の応答ハッシュを生成する
+ *   ・ハッシュ生成情報はapp_auth.cのsAuth_generateHashInfoとvAuth_setSyncTokenで
+ *     編集し、ストレッチングはauth_multi.c（SIMD＋スレッドプール）で実行する
+ *   ・-vを指定した場合は全件をbAuth_hashStretchingで再計算して照合する
+ *
+ *   auth_tool [-n デバイス数] [-m 経過分数] [-s シード] [-t スレッド数]
+ *             [-i auto|avx2|sse2|scalar] [-v] [-b]
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <jendefs.h>
+
+#include "app_auth.h"
+#include "config.h"
+#include "auth_multi.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// デバイス毎のジョブ数
+#define AUTH_TOOL_JOB_PER_DEV      (5)
+// ジョブのインデックス
+#define AUTH_TOOL_JOB_SUB_HASH     (0)	// 認証ハッシュ（サブ→メイン）
+#define AUTH_TOOL_JOB_MAIN_HASH    (1)	// 認証ハッシュ（メイン→サブ）
+#define AUTH_TOOL_JOB_MST_PW       (2)	// マスターパスワードハッシュ
+#define AUTH_TOOL_JOB_RESP_MAIN    (3)	// 応答ハッシュ（メインの認証コード）
+#define AUTH_TOOL_JOB_RESP_SUB     (4)	// 応答ハッシュ（サブの認証コード）
+// マスターパスワードの文字種（app_process.cのvSetRandStringと同じ）
+#define AUTH_TOOL_PW_CHARS         "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ+-/*!#$%&()?_@"
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：デバイス毎の生成情報
+typedef struct {
+	// メイン側のリモートデバイス情報
+	tsAuthRemoteDevInfo sMain;
+	// サブ側のリモートデバイス情報
+	tsAuthRemoteDevInfo sSub;
+	// マスターパスワード
+	uint8 u8MstPW[APP_AUTH_TOKEN_SIZE];
+	// マスターパスワードのストレッチング回数
+	uint16 u16MstPWStretching;
+} tsAuthTool_dev;
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 乱数の初期化
+PRIVATE bool_t bAuthTool_initRand(bool_t bSeedFlg, uint64_t u64Seed);
+// 乱数の取得
+PRIVATE uint32 u32AuthTool_rand();
+// 乱数配列の編集
+PRIVATE void vAuthTool_setRandArray(uint8* pu8Buff, uint8 u8Len);
+// デバイス毎の生成情報とジョブの編集
+PRIVATE void vAuthTool_setDevice(tsAuthTool_dev* psDev, tsAuthHashGenState* psGen, uint32 u32ElapsedMin);
+// 16進数の出力
+PRIVATE void vAuthTool_printHex(const uint8* pu8Data, uint8 u8Len, char cSep);
+// 経過時間（秒）
+PRIVATE double dAuthTool_now();
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// 乱数の状態（シード指定時）
+PRIVATE uint64_t u64AuthTool_randState;
+// 乱数デバイス（シード未指定時）
+PRIVATE FILE* fpAuthTool_rand = NULL;
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+int main(int argc, char* argv[]) {
+	uint32 u32DevCnt = MAX_REMOTE_DEV_CNT;
+	uint32 u32ElapsedMin = 0;
+	uint64_t u64Seed = 0;
+	bool_t bSeedFlg = FALSE;
+	long lThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	teAuthMulti_impl eImpl = E_AUTH_MULTI_AUTO;
+	bool_t bVerifyFlg = FALSE;
+	bool_t bBenchFlg = FALSE;
+	int iOpt;
+	while ((iOpt = getopt(argc, argv, "n:m:s:t:i:vb")) != -1) {
+		switch (iOpt) {
+		case 'n':
+			u32DevCnt = (uint32)strtoul(optarg, NULL, 10);
+			break;
+		case 'm':
+			u32ElapsedMin = (uint32)strtoul(optarg, NULL, 10);
+			break;
+		case 's':
+			u64Seed = strtoull(optarg, NULL, 0);
+			bSeedFlg = TRUE;
+			break;
+		case 't':
+			lThreads = atol(optarg);
+			break;
+		case 'i':
+			if (strcmp(optarg, "auto") == 0) {
+				eImpl = E_AUTH_MULTI_AUTO;
+			} else if (strcmp(optarg, "avx2") == 0) {
+				eImpl = E_AUTH_MULTI_AVX2;
+			} else if (strcmp(optarg, "sse2") == 0) {
+				eImpl = E_AUTH_MULTI_SSE2;
+			} else if (strcmp(optarg, "scalar") == 0) {
+				eImpl = E_AUTH_MULTI_SCALAR;
+			} else {
+				fprintf(stderr, "unknown implementation: %s\n", optarg);
+				return 2;
+			}
+			break;
+		case 'v':
+			bVerifyFlg = TRUE;
+			break;
+		case 'b':
+			bBenchFlg = TRUE;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n devices] [-m elapsed-min] [-s seed] [-t threads]"
+					" [-i auto|avx2|sse2|scalar] [-v] [-b]\n", argv[0]);
+			return 2;
+		}
+	}
+	// スレッド数（1〜最大スレッド数）
+	uint8 u8Threads = (uint8)(lThreads < 1 ? 1 : (lThreads > AUTH_MULTI_THREAD_MAX ? AUTH_MULTI_THREAD_MAX : lThreads));
+	const tsAuthMulti_backend* psBackend = psAuthMulti_getBackend(eImpl);
+	if (psBackend == NULL) {
+		fprintf(stderr, "implementation not supported on this CPU\n");
+		return 1;
+	}
+	if (!bAuthTool_initRand(bSeedFlg, u64Seed)) {
+		fprintf(stderr, "cannot open /dev/urandom\n");
+		return 1;
+	}
+	//--------------------------------------------------------------------------
+	// デバイス毎の生成情報とジョブの編集
+	//--------------------------------------------------------------------------
+	uint32 u32JobCnt = u32DevCnt * AUTH_TOOL_JOB_PER_DEV;
+	tsAuthTool_dev* psDevs = calloc(u32DevCnt ? u32DevCnt : 1, sizeof(tsAuthTool_dev));
+	tsAuthHashGenState* psGens = calloc(u32JobCnt ? u32JobCnt : 1, sizeof(tsAuthHashGenState));
+	tsAuthMulti_job* psJobs = calloc(u32JobCnt ? u32JobCnt : 1, sizeof(tsAuthMulti_job));
+	if (psDevs == NULL || psGens == NULL || psJobs == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	uint32 u32Idx;
+	for (u32Idx = 0; u32Idx < u32DevCnt; u32Idx++) {
+		vAuthTool_setDevice(&psDevs[u32Idx], &psGens[u32Idx * AUTH_TOOL_JOB_PER_DEV], u32ElapsedMin);
+	}
+	for (u32Idx = 0; u32Idx < u32JobCnt; u32Idx++) {
+		vAuthMulti_setJob(&psJobs[u32Idx], &psGens[u32Idx]);
+	}
+	//--------------------------------------------------------------------------
+	// ストレッチングの一括実行
+	//--------------------------------------------------------------------------
+	uint64_t u64Rounds = 0;
+	for (u32Idx = 0; u32Idx < u32JobCnt; u32Idx++) {
+		u64Rounds += psJobs[u32Idx].u16StCnt;
+	}
+	double dBegin = dAuthTool_now();
+	bAuthMulti_run(psBackend, psJobs, u32JobCnt, u8Threads);
+	double dElapsed = dAuthTool_now() - dBegin;
+	if (bBenchFlg) {
+		fprintf(stderr, "impl=%s lanes=%u threads=%u jobs=%u rounds=%llu time=%.3fs rate=%.0f hash/s\n",
+				psBackend->pcName, psBackend->u8Lanes, u8Threads, u32JobCnt,
+				(unsigned long long)u64Rounds, dElapsed, dElapsed > 0 ? u64Rounds / dElapsed : 0.0);
+	}
+	//--------------------------------------------------------------------------
+	// app_auth.cによる照合
+	//--------------------------------------------------------------------------
+	if (bVerifyFlg) {
+		uint32 u32Mismatch = 0;
+		dBegin = dAuthTool_now();
+		for (u32Idx = 0; u32Idx < u32JobCnt; u32Idx++) {
+			while (bAuth_hashStretching(&psGens[u32Idx]) == FALSE);
+			if (memcmp(psGens[u32Idx].u8HashCode, psJobs[u32Idx].u8Code, APP_AUTH_TOKEN_SIZE) != 0) {
+				u32Mismatch++;
+			}
+		}
+		dElapsed = dAuthTool_now() - dBegin;
+		fprintf(stderr, "verify: %u/%u jobs match app_auth.c (reference %.3fs)\n",
+				u32JobCnt - u32Mismatch, u32JobCnt, dElapsed);
+		if (u32Mismatch > 0) {
+			return 1;
+		}
+	}
+	//--------------------------------------------------------------------------
+	// 結果の出力（CSV）
+	//--------------------------------------------------------------------------
+	printf("device,sync_token,main_auth_code,main_snd,main_rcv,sub_auth_code,sub_snd,sub_rcv,"
+			"main_auth_hash,sub_auth_hash,mst_pw,mst_pw_stretching,mst_pw_hash,"
+			"elapsed_min,resp_main,resp_sub\n");
+	for (u32Idx = 0; u32Idx < u32DevCnt; u32Idx++) {
+		tsAuthTool_dev* psDev = &psDevs[u32Idx];
+		tsAuthMulti_job* psDevJobs = &psJobs[u32Idx * AUTH_TOOL_JOB_PER_DEV];
+		printf("%u,", u32Idx + 1);
+		vAuthTool_printHex(psDev->sMain.u8SyncToken, APP_AUTH_TOKEN_SIZE, ',');
+		vAuthTool_printHex(psDev->sMain.u8AuthCode, APP_AUTH_TOKEN_SIZE, ',');
+		printf("%u,%u,", psDev->sMain.u8SndStretching, psDev->sMain.u8RcvStretching);
+		vAuthTool_printHex(psDev->sSub.u8AuthCode, APP_AUTH_TOKEN_SIZE, ',');
+		printf("%u,%u,", psDev->sSub.u8SndStretching, psDev->sSub.u8RcvStretching);
+		vAuthTool_printHex(psDevJobs[AUTH_TOOL_JOB_MAIN_HASH].u8Code, APP_AUTH_TOKEN_SIZE, ',');
+		vAuthTool_printHex(psDevJobs[AUTH_TOOL_JOB_SUB_HASH].u8Code, APP_AUTH_TOKEN_SIZE, ',');
+		printf("%.32s,%u,", (char*)psDev->u8MstPW, psDev->u16MstPWStretching);
+		vAuthTool_printHex(psDevJobs[AUTH_TOOL_JOB_MST_PW].u8Code, APP_AUTH_TOKEN_SIZE, ',');
+		printf("%u,", u32ElapsedMin);
+		vAuthTool_printHex(psDevJobs[AUTH_TOOL_JOB_RESP_MAIN].u8Code, APP_AUTH_TOKEN_SIZE, ',');
+		vAuthTool_printHex(psDevJobs[AUTH_TOOL_JOB_RESP_SUB].u8Code, APP_AUTH_TOKEN_SIZE, '\n');
+	}
+	free(psDevs);
+	free(psGens);
+	free(psJobs);
+	if (fpAuthTool_rand != NULL) {
+		fclose(fpAuthTool_rand);
+	}
+	return 0;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u16ValUtil_getRandVal
+ *
+ * DESCRIPTION:乱数の取得（value_util.cの代替）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint16         乱数
+ *
+ * NOTES:
+ * app_auth.cのvAuth_editOneTimeTknが参照する為に定義する（本コマンドでは未使用）
+ *****************************************************************************/
+PUBLIC uint16 u16ValUtil_getRandVal() {
+	return (uint16)u32AuthTool_rand();
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: bAuthTool_initRand
+ *
+ * DESCRIPTION:乱数の初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bSeedFlg        R   シード指定フラグ
+ *   uint64_t       u64Seed         R   シード
+ *
+ * RETURNS:
+ *   bool_t TRUE:成功 FALSE:乱数デバイスを開けない
+ *
+ * NOTES:
+ * シード指定時は再現可能な擬似乱数（xorshift64*）、未指定時は/dev/urandomを使用する
+ *****************************************************************************/
+PRIVATE bool_t bAuthTool_initRand(bool_t bSeedFlg, uint64_t u64Seed) {
+	if (bSeedFlg) {
+		u64AuthTool_randState = u64Seed ^ 0x9E3779B97F4A7C15ULL;
+		if (u64AuthTool_randState == 0) {
+			u64AuthTool_randState = 1;
+		}
+		return TRUE;
+	}
+	fpAuthTool_rand = fopen("/dev/urandom", "rb");
+	return fpAuthTool_rand != NULL;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32AuthTool_rand
+ *
+ * DESCRIPTION:乱数の取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32         乱数
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint32 u32AuthTool_rand() {
+	if (fpAuthTool_rand != NULL) {
+		uint32 u32Val;
+		if (fread(&u32Val, sizeof(u32Val), 1, fpAuthTool_rand) == 1) {
+			return u32Val;
+		}
+		fprintf(stderr, "cannot read /dev/urandom\n");
+		exit(1);
+	}
+	u64AuthTool_randState ^= u64AuthTool_randState >> 12;
+	u64AuthTool_randState ^= u64AuthTool_randState << 25;
+	u64AuthTool_randState ^= u64AuthTool_randState >> 27;
+	return (uint32)((u64AuthTool_randState * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vAuthTool_setRandArray
+ *
+ * DESCRIPTION:乱数配列の編集
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8*         pu8Buff         W   編集対象
+ *   uint8          u8Len           R   長さ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vAuthTool_setRandArray(uint8* pu8Buff, uint8 u8Len) {
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < u8Len; u8Idx++) {
+		pu8Buff[u8Idx] = (uint8)u32AuthTool_rand();
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vAuthTool_setDevice
+ *
+ * DESCRIPTION:デバイス毎の生成情報とジョブの編集
+ *
+ * PARAMETERS:            Name           RW  Usage
+ *   tsAuthTool_dev*      psDev          W   デバイス毎の生成情報
+ *   tsAuthHashGenState*  psGen          W   ハッシュ生成情報（5件）
+ *   uint32               u32ElapsedMin  R   応答ハッシュの経過分数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * app_process.cのペアリングとマスターパスワードの初期生成と同じ手順で編集する
+ *****************************************************************************/
+PRIVATE void vAuthTool_setDevice(tsAuthTool_dev* psDev, tsAuthHashGenState* psGen, uint32 u32ElapsedMin) {
+	tsAuthRemoteDevInfo* psMain = &psDev->sMain;
+	tsAuthRemoteDevInfo* psSub  = &psDev->sSub;
+	uint16 u16StCnt;
+	// メイン側のトークン
+	vAuthTool_setRandArray(psMain->u8SyncToken, APP_AUTH_TOKEN_SIZE);
+	vAuthTool_setRandArray(psMain->u8AuthCode, APP_AUTH_TOKEN_SIZE);
+	psMain->u8SndStretching =
+		(u32AuthTool_rand() % (256 - APP_HASH_STRETCHING_CNT_MIN)) + APP_HASH_STRETCHING_CNT_MIN;
+	psMain->u8RcvStretching =
+		(u32AuthTool_rand() % (256 - APP_HASH_STRETCHING_CNT_MIN)) + APP_HASH_STRETCHING_CNT_MIN;
+	// サブ側のトークン（同期トークンは共通）
+	memcpy(psSub->u8SyncToken, psMain->u8SyncToken, APP_AUTH_TOKEN_SIZE);
+	vAuthTool_setRandArray(psSub->u8AuthCode, APP_AUTH_TOKEN_SIZE);
+	psSub->u8SndStretching =
+		(u32AuthTool_rand() % (256 - APP_HASH_STRETCHING_CNT_MIN)) + APP_HASH_STRETCHING_CNT_MIN;
+	psSub->u8RcvStretching =
+		(u32AuthTool_rand() % (256 - APP_HASH_STRETCHING_CNT_MIN)) + APP_HASH_STRETCHING_CNT_MIN;
+	// 認証ハッシュ（サブ→メイン）
+	u16StCnt = psSub->u8SndStretching + psMain->u8RcvStretching + STRETCHING_CNT_BASE;
+	psGen[AUTH_TOOL_JOB_SUB_HASH] = sAuth_generateHashInfo(psMain->u8AuthCode, u16StCnt);
+	vAuth_setSyncToken(&psGen[AUTH_TOOL_JOB_SUB_HASH], psMain->u8SyncToken);
+	// 認証ハッシュ（メイン→サブ）
+	u16StCnt = psMain->u8SndStretching + psSub->u8RcvStretching + STRETCHING_CNT_BASE;
+	psGen[AUTH_TOOL_JOB_MAIN_HASH] = sAuth_generateHashInfo(psSub->u8AuthCode, u16StCnt);
+	vAuth_setSyncToken(&psGen[AUTH_TOOL_JOB_MAIN_HASH], psSub->u8SyncToken);
+	// マスターパスワード（シャッフル無し）
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < APP_AUTH_TOKEN_SIZE; u8Idx++) {
+		psDev->u8MstPW[u8Idx] = AUTH_TOOL_PW_CHARS[u32AuthTool_rand() % (sizeof(AUTH_TOOL_PW_CHARS) - 1)];
+	}
+	psDev->u16MstPWStretching = u32AuthTool_rand() % 256 + STRETCHING_CNT_BASE;
+	psGen[AUTH_TOOL_JOB_MST_PW] = sAuth_generateHashInfo(psDev->u8MstPW, psDev->u16MstPWStretching);
+	// 応答ハッシュ（経過分数に対応するストレッチング回数）
+	u16StCnt = u16Auth_convToRespStCnt(u32ElapsedMin);
+	psGen[AUTH_TOOL_JOB_RESP_MAIN] = sAuth_generateHashInfo(psMain->u8AuthCode, u16StCnt);
+	vAuth_setSyncToken(&psGen[AUTH_TOOL_JOB_RESP_MAIN], psMain->u8SyncToken);
+	psGen[AUTH_TOOL_JOB_RESP_SUB] = sAuth_generateHashInfo(psSub->u8AuthCode, u16StCnt);
+	vAuth_setSyncToken(&psGen[AUTH_TOOL_JOB_RESP_SUB], psSub->u8SyncToken);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vAuthTool_printHex
+ *
+ * DESCRIPTION:16進数の出力
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8*         pu8Data         R   出力対象
+ *   uint8          u8Len           R   長さ
+ *   char           cSep            R   末尾の区切り文字
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE void vAuthTool_printHex(const uint8* pu8Data, uint8 u8Len, char cSep) {
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < u8Len; u8Idx++) {
+		printf("%02x", pu8Data[u8Idx]);
+	}
+	putchar(cSep);
+}
+
+/*****************************************************************************
+ *
+ * NAME: dAuthTool_now
+ *
+ * DESCRIPTION:経過時間（秒）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   double         単調増加する時刻（秒）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE double dAuthTool_now() {
+	struct timespec sTime;
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+	return sTime.tv_sec + sTime.tv_nsec / 1e9;
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,727 @@
+/****************************************************************************
+ *
+ * MODULE :Storage benchmark source file
+ *
+ * CREATED:2026/10/20 01:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   EEPROMシミュレータによるManagerの保存処理の書き込み量と寿命、I2Cトランザクション数の評価
+ *   ・EEPROMシミュレータのセル毎の書き換え回数、ページ内の折り返し、論理操作の集計、
+ *     寿命の予測の確認
+ *   ・ログ追記、リモートデバイス更新（登録）、同期（認証後の認証情報の更新）を
+ *     運用時の頻度で実行し、論理操作毎の書き込みバイト数と書き込みサイクル回数、
+ *     最も書き換えたセルから予測した寿命を表示する
+ *   ・インデックス情報を毎回読み込む場合とI2Cバス毎にキャッシュする場合の
+ *     解錠とログ記録、I2Cバス切替のI2Cトランザクション数（i2c_recorderの集計）
+ *   ・app_io.cはToCoNet SDKに依存してホスト環境でビルドできないので、
+ *     app_io.cと同じ配置（config.h）とモジュール（eeprom、kv_journal、dev_dir、log_ring）の
+ *     呼び出し順で保存処理を再現する
+ *
+ * CHANGE HISTORY:
+ * 2026/10/20 02:00:00 インデックス情報のキャッシュ有無のI2Cトランザクション数の評価を追加
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <jendefs.h>
+
+#include "config.h"
+#include "timer_util.h"
+#include "i2c_util.h"
+#include "i2c_sched.h"
+#include "i2c_replay.h"
+#include "i2c_recorder.h"
+#include "eeprom.h"
+#include "eeprom_sim.h"
+#include "kv_journal.h"
+#include "dev_dir.h"
+#include "log_ring.h"
+#include "app_auth.h"
+#include "host_test.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// EEPROMシミュレータのI2Cアドレス
+#define BENCH_EEPROM_ADDRESS       (I2C_ADDR_EEPROM_0)
+// EEPROMシミュレータのメモリサイズ（24AA256）
+#define BENCH_EEPROM_SIZE          (0x8000)
+// EEPROMシミュレータのバッキングファイル
+#define BENCH_EEPROM_PATH          "bench_storage.bin"
+// 模擬する運用日数
+#ifndef BENCH_DAYS
+	#define BENCH_DAYS             (30)
+#endif
+// １日当たりの解錠回数（同期とログ追記）
+#ifndef BENCH_UNLOCK_PER_DAY
+	#define BENCH_UNLOCK_PER_DAY   (40)
+#endif
+// リモートデバイスの登録間隔（日数）
+#ifndef BENCH_PAIRING_DAYS
+	#define BENCH_PAIRING_DAYS     (7)
+#endif
+// I2Cバス切替の評価の往復回数
+#define BENCH_SWITCH_PAIRS         (4)
+// I2Cバス（主／副）
+#define BENCH_BUS_MAIN             (0)
+#define BENCH_BUS_SUB              (1)
+// 論理操作
+#define BENCH_OP_LOG               (0)
+#define BENCH_OP_PAIRING           (1)
+#define BENCH_OP_SYNC              (2)
+#define BENCH_OP_CNT               (3)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+// 構造体：インデックス情報（app_io.hのtsAppIOIndexInfoと同じ配置）
+typedef struct {
+	uint8 u8EnableCheck;				// 有効チェック（レコード有効時は0xAA）
+	uint32 u32RemoteDevMap;				// リモートデバイス領域マップ
+	uint8 u8EventLogCnt;				// イベント履歴数（未使用）
+	uint8 u8Filler[2];					// 余白
+} tsBenchIndexInfo;
+
+// 構造体：インデックス情報のキャッシュ（I2Cバス毎）
+typedef struct {
+	bool_t bValid;						// 読み込み済みフラグ
+	bool_t bDirty;						// 未書き込みの変更ありフラグ
+	tsBenchIndexInfo sInfo;				// インデックス情報
+} tsBenchIndex;
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// EEPROMシミュレータ
+PRIVATE tsEEPROMSim sBenchSim;
+// EEPROMのデバイスステータス情報
+PRIVATE tsEEPROM_status sBenchStatus;
+// ジャーナル
+PRIVATE tsKVJournal sBenchJnl;
+// イベントログリング
+PRIVATE tsLogRing sBenchRing;
+// リモートデバイスディレクトリ
+PRIVATE tsDevDir sBenchDir;
+// インデックス情報（I2Cバス毎）
+PRIVATE tsBenchIndex sBenchIndex[2];
+// 選択中のI2Cバス
+PRIVATE uint8 u8BenchBus;
+// インデックス情報のキャッシュ使用フラグ
+PRIVATE bool_t bBenchIndexCacheFlg;
+// 論理操作の名称
+PRIVATE const char* pcBenchOpName[BENCH_OP_CNT] = {"log append", "remote-device update", "sync"};
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// EEPROMシミュレータの確認
+PRIVATE void vBench_checkSim();
+// 生のI2C書き込み（メモリアドレスとデータ）
+PRIVATE bool_t bBench_rawWrite(uint16 u16Addr, const uint8* pu8Data, uint16 u16Len);
+// EEPROMシミュレータと保存処理の初期化
+PRIVATE bool_t bBench_open(bool_t bIndexCacheFlg);
+// I2Cバスの切替（app_io.cのvI2CMainConnect／vI2CSubConnect）
+PRIVATE void vBench_busSelect(uint8 u8Bus);
+// インデックス情報の参照（app_io.cのpsEEPROMLoadIndex）
+PRIVATE tsBenchIndexInfo* psBench_loadIndex();
+// インデックス情報の遅延書き込み（app_io.cのbEEPROMFlushIndex）
+PRIVATE bool_t bBench_flushIndex();
+// リモートデバイス情報の探索（app_io.cのiEEPROMIndexOfRemoteInfo）
+PRIVATE int iBench_indexOfRemote(uint32 u32DeviceID);
+// リモートデバイス情報の書き込み（app_io.cのiEEPROMWriteRemoteInfo）
+PRIVATE int iBench_writeRemote(tsAuthRemoteDevInfo* psRemoteInfo);
+// イベントログの書き込み（app_io.cのiEEPROMWriteLog、書き込み完了まで待つ）
+PRIVATE int iBench_writeLog(uint16 u16MsgCd, uint32 u32Key);
+// 解錠とログ記録
+PRIVATE bool_t bBench_unlock(tsAuthRemoteDevInfo* psRemoteInfo, uint32 u32Key);
+// 運用時の頻度での書き込み量と寿命
+PRIVATE void vBench_workload();
+// インデックス情報のI2Cトランザクション数
+PRIVATE void vBench_indexAccess(bool_t bIndexCacheFlg, uint32* pu32UnlockTrns, uint32* pu32SwitchTrns);
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+int main() {
+	srand(1);
+	vBench_checkSim();
+	vBench_workload();
+	// インデックス情報のキャッシュ無し／有り
+	uint32 u32UnlockTrns[2];
+	uint32 u32SwitchTrns[2];
+	int iMode;
+	for (iMode = 0; iMode < 2; iMode++) {
+		vBench_indexAccess(iMode != 0, &u32UnlockTrns[iMode], &u32SwitchTrns[iMode]);
+		printf("index %-12s: unlock-and-log=%u transactions, %d bus switch pairs=%u transactions\n",
+				(iMode == 0) ? "read-through" : "cached", u32UnlockTrns[iMode], BENCH_SWITCH_PAIRS, u32SwitchTrns[iMode]);
+	}
+	HOST_CHECK(u32UnlockTrns[1] <= u32UnlockTrns[0]);
+	HOST_CHECK(u32SwitchTrns[1] < u32SwitchTrns[0]);
+	unlink(BENCH_EEPROM_PATH);
+	return iHostTest_result("bench_storage");
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vBench_checkSim
+ *
+ * DESCRIPTION:EEPROMシミュレータの確認
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ・書き込んだセルのみ書き換え回数を加算する
+ * ・ページ境界を越える書き込みはページ先頭に折り返し、上書きしたバイト数を数える
+ * ・書き込みサイクル中のアドレスはNACK応答する
+ * ・論理操作毎に書き込みサイクル回数とバイト数を集計する
+ * ・寿命は評価中の最大の書き換え回数の増分から予測する
+ *****************************************************************************/
+PRIVATE void vBench_checkSim() {
+	tsEEPROMSim* psSim = &sBenchSim;
+	tsEEPROMSim_op sOp;
+	uint8 u8Data[70];
+	uint16 u16Addr;
+	int iIdx;
+	vI2CReplay_init();
+	unlink(BENCH_EEPROM_PATH);
+	HOST_CHECK(bEEPROMSim_open(psSim, BENCH_EEPROM_PATH, BENCH_EEPROM_ADDRESS,
+			BENCH_EEPROM_SIZE, EEPROM_PAGE_SIZE_64B, 2));
+	for (iIdx = 0; iIdx < sizeof(u8Data); iIdx++) {
+		u8Data[iIdx] = (uint8)iIdx;
+	}
+	memset(&sOp, 0x00, sizeof(tsEEPROMSim_op));
+	vEEPROMSim_beginOp(psSim, &sOp);
+	// セル毎の書き換え回数
+	HOST_CHECK(bBench_rawWrite(0x0102, u8Data, 4));
+	HOST_CHECK(psSim->pu32Wear[0x0101] == 0 && psSim->pu32Wear[0x0102] == 1);
+	HOST_CHECK(psSim->pu32Wear[0x0105] == 1 && psSim->pu32Wear[0x0106] == 0);
+	// 書き込みサイクル中はNACK応答
+	bI2C_startWrite(BENCH_EEPROM_ADDRESS);
+	bI2C_stopACK();
+	HOST_CHECK(psSim->sStats.u32BusyNackCnt == 1);
+	vI2CReplay_waitUntil(psSim->u64BusyEnd);
+	HOST_CHECK(bBench_rawWrite(0x0104, u8Data, 2));
+	HOST_CHECK(psSim->pu32Wear[0x0103] == 1 && psSim->pu32Wear[0x0104] == 2 && psSim->pu32Wear[0x0105] == 2);
+	HOST_CHECK(u32EEPROMSim_maxWear(psSim, &u16Addr) == 2 && u16Addr == 0x0104);
+	HOST_CHECK(psSim->sStats.u32CycleCnt == 2 && psSim->sStats.u32ByteCnt == 6);
+	vEEPROMSim_endOp(psSim, &sOp);
+	HOST_CHECK(sOp.u32OpCnt == 1 && sOp.u32CycleCnt == 2 && sOp.u32ByteCnt == 6 && sOp.u32MaxByteCnt == 6);
+	// ページ内の折り返し（0x017C〜0x017F、0x0140〜0x017F、0x0140〜0x0141の順に70バイト）
+	vI2CReplay_waitUntil(psSim->u64BusyEnd);
+	vEEPROMSim_beginOp(psSim, &sOp);
+	HOST_CHECK(bBench_rawWrite(0x017C, u8Data, 70));
+	HOST_CHECK(psSim->sStats.u32WrapCnt == 70 - EEPROM_PAGE_SIZE_64B);
+	HOST_CHECK(psSim->pu8Mem[0x017C] == 64 && psSim->pu8Mem[0x017F] == 67);
+	HOST_CHECK(psSim->pu8Mem[0x0140] == 68 && psSim->pu8Mem[0x0141] == 69 && psSim->pu8Mem[0x0142] == 6);
+	HOST_CHECK(psSim->pu32Wear[0x013F] == 0 && psSim->pu32Wear[0x0140] == 1);
+	HOST_CHECK(psSim->pu32Wear[0x017F] == 1 && psSim->pu32Wear[0x0180] == 0);
+	vEEPROMSim_endOp(psSim, &sOp);
+	HOST_CHECK(sOp.u32OpCnt == 2 && sOp.u32CycleCnt == 3);
+	HOST_CHECK(sOp.u32ByteCnt == 6 + EEPROM_PAGE_SIZE_64B && sOp.u32MaxByteCnt == EEPROM_PAGE_SIZE_64B);
+	// 寿命の予測（1日で2回書き換えた場合）
+	HOST_CHECK(u32EEPROMSim_projectLife(psSim, 86400, 0) == (EEPROM_SIM_ENDURANCE - 2) / 2);
+	HOST_CHECK(u32EEPROMSim_projectLife(psSim, 86400, 2) == EEPROM_SIM_LIFE_INFINITE);
+	// 消去
+	vEEPROMSim_erase(psSim, TRUE);
+	HOST_CHECK(u32EEPROMSim_maxWear(psSim, NULL) == 0 && psSim->pu8Mem[0x0140] == 0xFF);
+	vEEPROMSim_close(psSim);
+}
+
+/*****************************************************************************
+ *
+ * NAME: bBench_rawWrite
+ *
+ * DESCRIPTION:生のI2C書き込み（メモリアドレスとデータ）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16Addr         R   メモリアドレス
+ *   uint8*         pu8Data         R   データ
+ *   uint16         u16Len          R   データ長（1以上）
+ *
+ * RETURNS:
+ *   bool_t         TRUE:全てACK応答
+ *
+ * NOTES:
+ * eeprom.cを経由せず、ページ境界で分割しない
+ *****************************************************************************/
+PRIVATE bool_t bBench_rawWrite(uint16 u16Addr, const uint8* pu8Data, uint16 u16Len) {
+	if (!bI2C_startWrite(BENCH_EEPROM_ADDRESS)) {
+		bI2C_stopACK();
+		return FALSE;
+	}
+	bool_t bResult = (u8I2C_write((uint8)(u16Addr >> 8)) == I2CUTIL_STS_ACK);
+	bResult &= (u8I2C_write((uint8)u16Addr) == I2CUTIL_STS_ACK);
+	uint16 u16Idx;
+	for (u16Idx = 0; u16Idx < u16Len - 1; u16Idx++) {
+		bResult &= (u8I2C_write(pu8Data[u16Idx]) == I2CUTIL_STS_ACK);
+	}
+	bResult &= (u8I2C_writeStop(pu8Data[u16Idx]) == I2CUTIL_STS_ACK);
+	return bResult;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bBench_open
+ *
+ * DESCRIPTION:EEPROMシミュレータと保存処理の初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bIndexCacheFlg  R   インデックス情報のキャッシュ使用フラグ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:初期化成功
+ *
+ * NOTES:
+ * 消去状態のEEPROMにジャーナルとイベントログリングを復元し、インデックス情報を書き込む
+ * 書き換え回数と統計情報は初期化後にクリアする
+ *****************************************************************************/
+PRIVATE bool_t bBench_open(bool_t bIndexCacheFlg) {
+	vI2CReplay_init();
+	unlink(BENCH_EEPROM_PATH);
+	if (!bEEPROMSim_open(&sBenchSim, BENCH_EEPROM_PATH, BENCH_EEPROM_ADDRESS,
+			BENCH_EEPROM_SIZE, EEPROM_PAGE_SIZE_64B, 2)) {
+		return FALSE;
+	}
+	vI2CSched_init(NULL, NULL);
+	vEEPROM_setSchedDevice(I2C_SCHED_DEVICE_NONE);
+	// app_io.cのvEEPROMInitと同じ設定
+	memset(&sBenchStatus, 0x00, sizeof(tsEEPROM_status));
+	sBenchStatus.u8DevAddress  = BENCH_EEPROM_ADDRESS;
+	sBenchStatus.b2ByteAddrFlg = TRUE;
+	sBenchStatus.u8PageSize    = EEPROM_PAGE_SIZE_64B;
+	sBenchStatus.u64LastWrite  = u64TimerUtil_readUsec();
+	sBenchStatus.bCacheFlg     = TRUE;
+	if (!bEEPROM_deviceSelect(&sBenchStatus)) {
+		return FALSE;
+	}
+	vEEPROM_cacheInvalidate();
+	// app_io.cのvAppIOInitと同じ配置
+	vDevDir_init(&sBenchDir, MAX_REMOTE_DEV_CNT);
+	vLogRing_init(&sBenchRing, TOP_ADDR_EVENT_LOG, EVT_LOG_BLOCK_CNT, EVT_LOG_BLOCK_SIZE, EVT_LOG_PAYLOAD_SIZE, TRUE);
+	vKVJournal_init(&sBenchJnl, TOP_ADDR_JOURNAL, EEPROM_PAGE_SIZE_64B);
+	memset(sBenchIndex, 0x00, sizeof(sBenchIndex));
+	u8BenchBus = BENCH_BUS_MAIN;
+	bBenchIndexCacheFlg = bIndexCacheFlg;
+	if (!bKVJournal_recover(&sBenchJnl) || !bLogRing_recover(&sBenchRing)) {
+		return FALSE;
+	}
+	// インデックス情報の初期化
+	if (psBench_loadIndex() == NULL || !bBench_flushIndex() || !bEEPROM_commit()) {
+		return FALSE;
+	}
+	vI2CReplay_waitUntil(sBenchSim.u64BusyEnd);
+	memset(sBenchSim.pu32Wear, 0x00, sBenchSim.u32MemSize * sizeof(uint32));
+	vEEPROMSim_clearStats(&sBenchSim);
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vBench_busSelect
+ *
+ * DESCRIPTION:I2Cバスの切替（app_io.cのvI2CMainConnect／vI2CSubConnect）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Bus           R   I2Cバス
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 主副のEEPROMは同一アドレスの為、切り替え前にインデックス情報と非同期書き込みを完了させ、
+ * ページキャッシュを書き戻して破棄する（シミュレータは主副で同じEEPROMとする）
+ *****************************************************************************/
+PRIVATE void vBench_busSelect(uint8 u8Bus) {
+	if (u8BenchBus == u8Bus) {
+		return;
+	}
+	bBench_flushIndex();
+	bEEPROM_asyncWait();
+	bEEPROM_commit();
+	vEEPROM_cacheInvalidate();
+	vDevDir_init(&sBenchDir, MAX_REMOTE_DEV_CNT);
+	u8BenchBus = u8Bus;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psBench_loadIndex
+ *
+ * DESCRIPTION:インデックス情報の参照（app_io.cのpsEEPROMLoadIndex）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsBenchIndexInfo* インデックス情報、読み込みエラー時はNULL
+ *
+ * NOTES:
+ * キャッシュを使用しない場合は、参照毎にEEPROMから読み込む（ページキャッシュは経由する）
+ *****************************************************************************/
+PRIVATE tsBenchIndexInfo* psBench_loadIndex() {
+	tsBenchIndex* psIndex = &sBenchIndex[u8BenchBus];
+	bEEPROM_deviceSelect(&sBenchStatus);
+	if (bBenchIndexCacheFlg && psIndex->bValid) {
+		return &psIndex->sInfo;
+	}
+	// I2C EEPROM Read
+	if (!bEEPROM_readData(TOP_ADDR_INDEX, sizeof(tsBenchIndexInfo), (uint8*)&psIndex->sInfo)) {
+		return NULL;
+	}
+	psIndex->bValid = TRUE;
+	psIndex->bDirty = FALSE;
+	// レコード有効チェック
+	if (psIndex->sInfo.u8EnableCheck != 0xAA) {
+		memset(&psIndex->sInfo, 0x00, sizeof(tsBenchIndexInfo));
+		psIndex->sInfo.u8EnableCheck = 0xAA;
+		psIndex->bDirty = TRUE;
+	}
+	return &psIndex->sInfo;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bBench_flushIndex
+ *
+ * DESCRIPTION:インデックス情報の遅延書き込み（app_io.cのbEEPROMFlushIndex）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き込み成功もしくは変更無し
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE bool_t bBench_flushIndex() {
+	tsBenchIndex* psIndex = &sBenchIndex[u8BenchBus];
+	if (!psIndex->bValid || !psIndex->bDirty) {
+		return TRUE;
+	}
+	bEEPROM_deviceSelect(&sBenchStatus);
+	vKVJournal_begin(&sBenchJnl);
+	bKVJournal_put(&sBenchJnl, TOP_ADDR_INDEX, (uint8*)&psIndex->sInfo, sizeof(tsBenchIndexInfo));
+	if (!bKVJournal_commit(&sBenchJnl)) {
+		psIndex->bValid = FALSE;
+		return FALSE;
+	}
+	psIndex->bDirty = FALSE;
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iBench_indexOfRemote
+ *
+ * DESCRIPTION:リモートデバイス情報の探索（app_io.cのiEEPROMIndexOfRemoteInfo）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32DeviceID     R   デバイスID
+ *
+ * RETURNS:
+ *   int            レコードインデックス、対象レコード無しもしくはエラー時は-1
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE int iBench_indexOfRemote(uint32 u32DeviceID) {
+	tsBenchIndexInfo* psInfo = psBench_loadIndex();
+	if (psInfo == NULL) {
+		return -1;
+	}
+	if (sBenchDir.bValid == FALSE &&
+			!bDevDir_build(&sBenchDir, TOP_ADDR_REMOTE_DEV, sizeof(tsAuthRemoteDevInfo), psInfo->u32RemoteDevMap)) {
+		return -1;
+	}
+	return iDevDir_indexOf(&sBenchDir, u32DeviceID);
+}
+
+/*****************************************************************************
+ *
+ * NAME: iBench_writeRemote
+ *
+ * DESCRIPTION:リモートデバイス情報の書き込み（app_io.cのiEEPROMWriteRemoteInfo）
+ *
+ * PARAMETERS:            Name          RW  Usage
+ *   tsAuthRemoteDevInfo* psRemoteInfo  R   リモートデバイス情報
+ *
+ * RETURNS:
+ *   int            書き込みレコードインデックス、エラー時はマイナス値
+ *
+ * NOTES:
+ * 新規登録の場合はインデックス情報とレコードを１トランザクションで書き込む
+ *****************************************************************************/
+PRIVATE int iBench_writeRemote(tsAuthRemoteDevInfo* psRemoteInfo) {
+	int iIdx = iBench_indexOfRemote(psRemoteInfo->u32DeviceID);
+	tsBenchIndex* psIndex = &sBenchIndex[u8BenchBus];
+	if (psIndex->bValid == FALSE) {
+		return -1;
+	}
+	bool_t bNewFlg = (iIdx < 0);
+	if (bNewFlg) {
+		for (iIdx = 0; iIdx < MAX_REMOTE_DEV_CNT; iIdx++) {
+			if ((psIndex->sInfo.u32RemoteDevMap & (0x01 << iIdx)) == 0) {
+				break;
+			}
+		}
+		if (iIdx >= MAX_REMOTE_DEV_CNT) {
+			return -1;
+		}
+		psIndex->sInfo.u32RemoteDevMap |= (0x00000001 << iIdx);
+	}
+	vKVJournal_begin(&sBenchJnl);
+	bool_t bIndexFlg = (bNewFlg || psIndex->bDirty);
+	if (bIndexFlg) {
+		bKVJournal_put(&sBenchJnl, TOP_ADDR_INDEX, (uint8*)&psIndex->sInfo, sizeof(tsBenchIndexInfo));
+	}
+	uint16 u16Size = sizeof(tsAuthRemoteDevInfo);
+	bKVJournal_put(&sBenchJnl, TOP_ADDR_REMOTE_DEV + u16Size * iIdx, (uint8*)psRemoteInfo, u16Size);
+	bEEPROM_deviceSelect(&sBenchStatus);
+	if (!bKVJournal_commit(&sBenchJnl)) {
+		psIndex->bValid = FALSE;
+		sBenchDir.bValid = FALSE;
+		return -2;
+	}
+	if (bIndexFlg) {
+		psIndex->bDirty = FALSE;
+	}
+	if (bNewFlg) {
+		bDevDir_add(&sBenchDir, psRemoteInfo->u32DeviceID, (uint8)iIdx);
+	}
+	return iIdx;
+}
+
+/*****************************************************************************
+ *
+ * NAME: iBench_writeLog
+ *
+ * DESCRIPTION:イベントログの書き込み（app_io.cのiEEPROMWriteLog）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16         u16MsgCd        R   メッセージコード
+ *   uint32         u32Key          R   日時（基準年からの経過秒数）
+ *
+ * RETURNS:
+ *   int            書き込みエントリ位置、エラー時はマイナス値
+ *
+ * NOTES:
+ * イベントループで行う非同期書き込みの完了までを含める
+ *****************************************************************************/
+PRIVATE int iBench_writeLog(uint16 u16MsgCd, uint32 u32Key) {
+	uint8 u8LogData[EVT_LOG_PAYLOAD_SIZE] = {(uint8)u16MsgCd, 0x00, 0x00};
+	bEEPROM_deviceSelect(&sBenchStatus);
+	int iIdx = iLogRing_append(&sBenchRing, u32Key, u8LogData, EVT_LOG_PAYLOAD_SIZE);
+	if (!bEEPROM_asyncWait()) {
+		return -2;
+	}
+	return iIdx;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bBench_unlock
+ *
+ * DESCRIPTION:解錠とログ記録
+ *
+ * PARAMETERS:            Name          RW  Usage
+ *   tsAuthRemoteDevInfo* psRemoteInfo  RW  リモートデバイス情報（同期トークンを更新）
+ *   uint32               u32Key        R   日時（基準年からの経過秒数）
+ *
+ * RETURNS:
+ *   bool_t         TRUE:成功
+ *
+ * NOTES:
+ * デバイス情報とリモートデバイス情報の読み込み、認証情報の更新、ログ記録、
+ * イベントループでのインデックス情報の遅延書き込み
+ *****************************************************************************/
+PRIVATE bool_t bBench_unlock(tsAuthRemoteDevInfo* psRemoteInfo, uint32 u32Key) {
+	tsAuthDeviceInfo sDevInfo;
+	tsAuthRemoteDevInfo sReadInfo;
+	// 自デバイス情報読み込み（bEEPROMReadDevInfo）
+	bEEPROM_deviceSelect(&sBenchStatus);
+	if (!bEEPROM_readData(TOP_ADDR_DEV, sizeof(tsAuthDeviceInfo), (uint8*)&sDevInfo)) {
+		return FALSE;
+	}
+	// リモートデバイス情報の探索と読み込み
+	int iIdx = iBench_indexOfRemote(psRemoteInfo->u32DeviceID);
+	if (iIdx < 0 || !bEEPROM_readData(TOP_ADDR_REMOTE_DEV + sizeof(tsAuthRemoteDevInfo) * iIdx,
+			sizeof(tsAuthRemoteDevInfo), (uint8*)&sReadInfo)) {
+		return FALSE;
+	}
+	// 同期：認証情報の更新
+	int iByte;
+	for (iByte = 0; iByte < APP_AUTH_TOKEN_SIZE; iByte++) {
+		psRemoteInfo->u8SyncToken[iByte] ^= (uint8)rand();
+		psRemoteInfo->u8AuthHash[iByte]   = (uint8)rand();
+	}
+	psRemoteInfo->u8SndStretching = (uint8)rand();
+	if (iBench_writeRemote(psRemoteInfo) < 0) {
+		return FALSE;
+	}
+	// ログ記録
+	if (iBench_writeLog(0x01, u32Key) < 0) {
+		return FALSE;
+	}
+	// イベントループ
+	return bBench_flushIndex();
+}
+
+/*****************************************************************************
+ *
+ * NAME: vBench_workload
+ *
+ * DESCRIPTION:運用時の頻度での書き込み量と寿命
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * BENCH_PAIRING_DAYS毎にリモートデバイスを登録し、１日当たりBENCH_UNLOCK_PER_DAY回の
+ * 同期とログ追記をBENCH_DAYS日分実行して、論理操作毎に書き込み量を集計する
+ *****************************************************************************/
+PRIVATE void vBench_workload() {
+	tsEEPROMSim_op sOps[BENCH_OP_CNT];
+	tsAuthRemoteDevInfo sRemote[MAX_REMOTE_DEV_CNT];
+	uint8 u8DevCnt = 0;
+	uint32 u32Day;
+	uint32 u32Cnt;
+	int iOp;
+	int iByte;
+	memset(sOps, 0x00, sizeof(sOps));
+	HOST_CHECK(bBench_open(TRUE));
+	for (u32Day = 0; u32Day < BENCH_DAYS; u32Day++) {
+		// リモートデバイス更新（登録）
+		if (u32Day % BENCH_PAIRING_DAYS == 0 && u8DevCnt < MAX_REMOTE_DEV_CNT) {
+			tsAuthRemoteDevInfo* psRemote = &sRemote[u8DevCnt];
+			memset(psRemote, 0x00, sizeof(tsAuthRemoteDevInfo));
+			psRemote->u32DeviceID = 10000000 + u8DevCnt;
+			sprintf(psRemote->cDeviceName, "DEVICE%02d", u8DevCnt);
+			for (iByte = 0; iByte < APP_AUTH_TOKEN_SIZE; iByte++) {
+				psRemote->u8SyncToken[iByte] = (uint8)rand();
+				psRemote->u8AuthHash[iByte]  = (uint8)rand();
+				psRemote->u8AuthCode[iByte]  = (uint8)rand();
+			}
+			vEEPROMSim_beginOp(&sBenchSim, &sOps[BENCH_OP_PAIRING]);
+			HOST_CHECK(iBench_writeRemote(psRemote) == u8DevCnt);
+			HOST_CHECK(bBench_flushIndex());
+			vEEPROMSim_endOp(&sBenchSim, &sOps[BENCH_OP_PAIRING]);
+			u8DevCnt++;
+		}
+		for (u32Cnt = 0; u32Cnt < BENCH_UNLOCK_PER_DAY; u32Cnt++) {
+			tsAuthRemoteDevInfo* psRemote = &sRemote[rand() % u8DevCnt];
+			uint32 u32Key = u32Day * 86400 + u32Cnt * (86400 / BENCH_UNLOCK_PER_DAY);
+			// 同期（認証情報の更新）
+			for (iByte = 0; iByte < APP_AUTH_TOKEN_SIZE; iByte++) {
+				psRemote->u8SyncToken[iByte] ^= (uint8)rand();
+				psRemote->u8AuthHash[iByte]   = (uint8)rand();
+			}
+			psRemote->u8SndStretching = (uint8)rand();
+			vEEPROMSim_beginOp(&sBenchSim, &sOps[BENCH_OP_SYNC]);
+			HOST_CHECK(iBench_writeRemote(psRemote) >= 0);
+			vEEPROMSim_endOp(&sBenchSim, &sOps[BENCH_OP_SYNC]);
+			// ログ追記
+			vEEPROMSim_beginOp(&sBenchSim, &sOps[BENCH_OP_LOG]);
+			HOST_CHECK(iBench_writeLog(0x01, u32Key) >= 0);
+			vEEPROMSim_endOp(&sBenchSim, &sOps[BENCH_OP_LOG]);
+		}
+	}
+	HOST_CHECK(bEEPROM_commit());
+	// 論理操作毎の書き込み量
+	for (iOp = 0; iOp < BENCH_OP_CNT; iOp++) {
+		tsEEPROMSim_op* psOp = &sOps[iOp];
+		HOST_CHECK(psOp->u32OpCnt > 0 && psOp->u32ByteCnt > 0);
+		printf("%-20s: ops=%5u bytes/op=%6.1f cycles/op=%5.2f max bytes=%u\n", pcBenchOpName[iOp],
+				psOp->u32OpCnt, (double)psOp->u32ByteCnt / psOp->u32OpCnt,
+				(double)psOp->u32CycleCnt / psOp->u32OpCnt, psOp->u32MaxByteCnt);
+	}
+	HOST_CHECK(sOps[BENCH_OP_LOG].u32OpCnt == BENCH_DAYS * BENCH_UNLOCK_PER_DAY);
+	HOST_CHECK(sOps[BENCH_OP_SYNC].u32OpCnt == BENCH_DAYS * BENCH_UNLOCK_PER_DAY);
+	// 最も書き換えたセルと寿命の予測
+	uint16 u16Addr;
+	uint32 u32MaxWear = u32EEPROMSim_maxWear(&sBenchSim, &u16Addr);
+	uint32 u32Life = u32EEPROMSim_projectLife(&sBenchSim, BENCH_DAYS * 86400, 0);
+	HOST_CHECK(u32MaxWear > 0 && u32Life != EEPROM_SIM_LIFE_INFINITE);
+	printf("max wear: %u cycles at 0x%04X in %d days (%d unlocks/day)\n",
+			u32MaxWear, u16Addr, BENCH_DAYS, BENCH_UNLOCK_PER_DAY);
+	printf("projected life: %u days (%.1f years)\n", u32Life, u32Life / 365.0);
+	vEEPROMSim_close(&sBenchSim);
+}
+
+/*****************************************************************************
+ *
+ * NAME: vBench_indexAccess
+ *
+ * DESCRIPTION:インデックス情報のI2Cトランザクション数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool_t         bIndexCacheFlg  R   インデックス情報のキャッシュ使用フラグ
+ *   uint32*        pu32UnlockTrns  W   解錠とログ記録のトランザクション数
+ *   uint32*        pu32SwitchTrns  W   I2Cバス切替の往復のトランザクション数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * トランザクション数はi2c_recorderの停止条件の回数から、書き込みサイクル中のACKポーリングを除いた値
+ * 解錠とログ記録はI2Cバスの切替直後（ページキャッシュ破棄後）から計測する
+ * I2Cバス切替は切替毎にリモートデバイス情報を探索する
+ *****************************************************************************/
+PRIVATE void vBench_indexAccess(bool_t bIndexCacheFlg, uint32* pu32UnlockTrns, uint32* pu32SwitchTrns) {
+	tsAuthRemoteDevInfo sRemote;
+	uint8 u8Cnt;
+	HOST_CHECK(bBench_open(bIndexCacheFlg));
+	// リモートデバイスの登録と主副のインデックス情報の読み込み
+	memset(&sRemote, 0x00, sizeof(tsAuthRemoteDevInfo));
+	sRemote.u32DeviceID = 10000000;
+	HOST_CHECK(iBench_writeRemote(&sRemote) == 0);
+	vBench_busSelect(BENCH_BUS_SUB);
+	HOST_CHECK(iBench_indexOfRemote(sRemote.u32DeviceID) == 0);
+	vBench_busSelect(BENCH_BUS_MAIN);
+	HOST_CHECK(iBench_indexOfRemote(sRemote.u32DeviceID) == 0);
+	// 解錠とログ記録
+	vBench_busSelect(BENCH_BUS_SUB);
+	vBench_busSelect(BENCH_BUS_MAIN);
+	vI2CReplay_waitUntil(sBenchSim.u64BusyEnd);
+	uint32 u32PollCnt = sBenchSim.sStats.u32BusyNackCnt;
+	vI2CRec_start();
+	HOST_CHECK(bBench_unlock(&sRemote, 0));
+	vI2CRec_stop();
+	*pu32UnlockTrns = psI2CRec_getSummary()->u32StopCnt - (sBenchSim.sStats.u32BusyNackCnt - u32PollCnt);
+	// I2Cバス切替
+	vI2CReplay_waitUntil(sBenchSim.u64BusyEnd);
+	u32PollCnt = sBenchSim.sStats.u32BusyNackCnt;
+	vI2CRec_start();
+	for (u8Cnt = 0; u8Cnt < BENCH_SWITCH_PAIRS; u8Cnt++) {
+		vBench_busSelect(BENCH_BUS_SUB);
+		HOST_CHECK(iBench_indexOfRemote(sRemote.u32DeviceID) == 0);
+		vBench_busSelect(BENCH_BUS_MAIN);
+		HOST_CHECK(iBench_indexOfRemote(sRemote.u32DeviceID) == 0);
+	}
+	vI2CRec_stop();
+	*pu32SwitchTrns = psI2CRec_getSummary()->u32StopCnt - (sBenchSim.sStats.u32BusyNackCnt - u32PollCnt);
+	vEEPROMSim_close(&sBenchSim);
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -0,0 +1,225 @@
+/****************************************************************************
+ *
+ * MODULE :Auth Multi-buffer Stretching test source file
+ *
+ * CREATED:2026/10/19 22:00:00
+ * AUTHOR :Nakanohito
+ *
+ * DESCRIPTION:
+ *   auth_multiのホスト環境のテスト
+ *   ・32バイトメッセージのSHA-256の既知の値（sha256.cと各SIMD実装）
+ *   ・利用可能な全実装について、ランダムな元コード、同期トークン、
+ *     ストレッチング回数（0回、1回を含む）のジョブを一括実行し、
+ *     app_auth.cのbAuth_hashStretchingの結果とビット単位で比較する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ ****************************************************************************
+ * Copyright (c) 2026, Nakanohito
+ * This software is released under the BSD 2-Clause License.
+ * http://opensource.org/licenses/BSD-2-Clause
+ ****************************************************************************/
+/****************************************************************************/
+/***        Include files                                                 ***/
+/****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <jendefs.h>
+
+#include "sha256.h"
+#include "app_auth.h"
+#include "auth_multi.h"
+#include "host_test.h"
+
+/****************************************************************************/
+/***        Macro Definitions                                             ***/
+/****************************************************************************/
+// 繰り返し回数
+#ifndef TEST_AUTH_ITERATIONS
+	#define TEST_AUTH_ITERATIONS   (12)
+#endif
+// 最大ジョブ数
+#define TEST_AUTH_JOB_MAX          (97)
+
+/****************************************************************************/
+/***        Type Definitions                                              ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Function Prototypes                                     ***/
+/****************************************************************************/
+// 既知の値のテスト
+PRIVATE void vTest_knownAnswer(const tsAuthMulti_backend* psBackend);
+// app_auth.cとの比較テスト
+PRIVATE void vTest_compareRef(const tsAuthMulti_backend* psBackend);
+
+/****************************************************************************/
+/***        Exported Variables                                            ***/
+/****************************************************************************/
+
+/****************************************************************************/
+/***        Local Variables                                               ***/
+/****************************************************************************/
+// SHA-256("\0" x 32)
+PRIVATE const uint8 u8Test_zeroHash[APP_AUTH_TOKEN_SIZE] = {
+	0x66, 0x68, 0x7a, 0xad, 0xf8, 0x62, 0xbd, 0x77, 0x6c, 0x8f, 0xc1, 0x8b, 0x8e, 0x9f, 0x8e, 0x20,
+	0x08, 0x97, 0x14, 0x85, 0x6e, 0xe2, 0x33, 0xb3, 0x90, 0x2a, 0x59, 0x1d, 0x0d, 0x5f, 0x29, 0x25
+};
+
+/****************************************************************************/
+/***        Exported Functions                                            ***/
+/****************************************************************************/
+int main() {
+	const teAuthMulti_impl eImpls[] = {E_AUTH_MULTI_SCALAR, E_AUTH_MULTI_SSE2, E_AUTH_MULTI_AVX2};
+	uint8 u8Idx;
+	srand(1);
+	// sha256.c（ホスト環境でも実機と同じバイト列となること）
+	uint8 u8Hash[APP_AUTH_TOKEN_SIZE];
+	memset(u8Hash, 0x00, APP_AUTH_TOKEN_SIZE);
+	vSHA256_generateHash32(u8Hash, u8Hash);
+	HOST_CHECK(memcmp(u8Hash, u8Test_zeroHash, APP_AUTH_TOKEN_SIZE) == 0);
+	// 利用可能な全実装
+	for (u8Idx = 0; u8Idx < sizeof(eImpls) / sizeof(eImpls[0]); u8Idx++) {
+		const tsAuthMulti_backend* psBackend = psAuthMulti_getBackend(eImpls[u8Idx]);
+		if (psBackend == NULL) {
+			printf("skip: implementation %d not supported\n", eImpls[u8Idx]);
+			continue;
+		}
+		vTest_knownAnswer(psBackend);
+		vTest_compareRef(psBackend);
+		printf("%s: lanes=%u checked\n", psBackend->pcName, psBackend->u8Lanes);
+	}
+	HOST_CHECK(psAuthMulti_getBackend(E_AUTH_MULTI_AUTO) != NULL);
+	return iHostTest_result("test_auth_multi");
+}
+
+/*****************************************************************************
+ *
+ * NAME: u16ValUtil_getRandVal
+ *
+ * DESCRIPTION:乱数の取得（value_util.cの代替）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint16         乱数
+ *
+ * NOTES:
+ * app_auth.cのvAuth_editOneTimeTknが参照する為に定義する
+ *****************************************************************************/
+PUBLIC uint16 u16ValUtil_getRandVal() {
+	return (uint16)rand();
+}
+
+/****************************************************************************/
+/***        Local Functions                                               ***/
+/****************************************************************************/
+
+/*****************************************************************************
+ *
+ * NAME: vTest_knownAnswer
+ *
+ * DESCRIPTION:既知の値のテスト
+ *
+ * PARAMETERS:            Name           RW  Usage
+ *   tsAuthMulti_backend* psBackend      R   実装
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 全レーンに同じメッセージ、次にレーン毎に異なるメッセージを与え、各レーンの結果を確認する
+ *****************************************************************************/
+PRIVATE void vTest_knownAnswer(const tsAuthMulti_backend* psBackend) {
+	uint8 u8Msg[AUTH_MULTI_LANE_MAX][APP_AUTH_TOKEN_SIZE];
+	uint8 u8Lane;
+	memset(u8Msg, 0x00, sizeof(u8Msg));
+	psBackend->pfHash32(u8Msg);
+	for (u8Lane = 0; u8Lane < psBackend->u8Lanes; u8Lane++) {
+		HOST_CHECK(memcmp(u8Msg[u8Lane], u8Test_zeroHash, APP_AUTH_TOKEN_SIZE) == 0);
+	}
+	// レーン毎に異なるメッセージ（sha256.cとの比較）
+	uint8 u8Ref[APP_AUTH_TOKEN_SIZE];
+	uint8 u8Idx;
+	for (u8Lane = 0; u8Lane < AUTH_MULTI_LANE_MAX; u8Lane++) {
+		for (u8Idx = 0; u8Idx < APP_AUTH_TOKEN_SIZE; u8Idx++) {
+			u8Msg[u8Lane][u8Idx] = (uint8)rand();
+		}
+	}
+	uint8 u8Src[AUTH_MULTI_LANE_MAX][APP_AUTH_TOKEN_SIZE];
+	memcpy(u8Src, u8Msg, sizeof(u8Msg));
+	psBackend->pfHash32(u8Msg);
+	for (u8Lane = 0; u8Lane < psBackend->u8Lanes; u8Lane++) {
+		vSHA256_generateHash32(u8Src[u8Lane], u8Ref);
+		HOST_CHECK(memcmp(u8Msg[u8Lane], u8Ref, APP_AUTH_TOKEN_SIZE) == 0);
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vTest_compareRef
+ *
+ * DESCRIPTION:app_auth.cとの比較テスト
+ *
+ * PARAMETERS:            Name           RW  Usage
+ *   tsAuthMulti_backend* psBackend      R   実装
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ジョブ数とスレッド数を変えながら、レーンの補充と空きレーンを含めて確認する
+ *****************************************************************************/
+PRIVATE void vTest_compareRef(const tsAuthMulti_backend* psBackend) {
+	tsAuthHashGenState sGens[TEST_AUTH_JOB_MAX];
+	tsAuthMulti_job sJobs[TEST_AUTH_JOB_MAX];
+	uint8 u8Code[APP_AUTH_TOKEN_SIZE];
+	uint8 u8SyncToken[APP_AUTH_TOKEN_SIZE];
+	int iCnt;
+	int iJob;
+	int iIdx;
+	for (iCnt = 0; iCnt < TEST_AUTH_ITERATIONS; iCnt++) {
+		int iJobCnt = (iCnt == 0) ? 0 : 1 + rand() % TEST_AUTH_JOB_MAX;
+		uint8 u8Threads = (uint8)(rand() % 5);
+		for (iJob = 0; iJob < iJobCnt; iJob++) {
+			for (iIdx = 0; iIdx < APP_AUTH_TOKEN_SIZE; iIdx++) {
+				u8Code[iIdx] = (uint8)rand();
+				u8SyncToken[iIdx] = (uint8)rand();
+			}
+			// ストレッチング回数（0回、1回、少数、実運用相当）
+			uint16 u16StCnt;
+			switch (rand() % 8) {
+			case 0:
+				u16StCnt = 0;
+				break;
+			case 1:
+				u16StCnt = 1;
+				break;
+			case 2:
+			case 3:
+				u16StCnt = rand() % 20;
+				break;
+			default:
+				u16StCnt = APP_HASH_STRETCHING_CNT_BASE + rand() % 512;
+				break;
+			}
+			sGens[iJob] = sAuth_generateHashInfo(u8Code, u16StCnt);
+			// 同期トークン無し（マスターパスワード）を含む
+			if (rand() % 4 != 0) {
+				vAuth_setSyncToken(&sGens[iJob], u8SyncToken);
+			}
+			vAuthMulti_setJob(&sJobs[iJob], &sGens[iJob]);
+		}
+		HOST_CHECK(bAuthMulti_run(psBackend, sJobs, (uint32)iJobCnt, u8Threads));
+		for (iJob = 0; iJob < iJobCnt; iJob++) {
+			while (bAuth_hashStretching(&sGens[iJob]) == FALSE);
+			HOST_CHECK(memcmp(sGens[iJob].u8HashCode, sJobs[iJob].u8Code, APP_AUTH_TOKEN_SIZE) == 0);
+		}
+	}
+	HOST_CHECK(bAuthMulti_run(NULL, sJobs, 0, 1) == FALSE);
+}
+
+/****************************************************************************/
+/***        END OF FILE                                                   ***/
+/****************************************************************************/
@@ -8,6 +8,8 @@
  * DESCRIPTION:アカウント認証処理に関する関数群
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 複数ハッシュ値の並行ストレッチング処理を追加
+ * 2026/10/19 22:00:00 シャッフルパターンの生成をバイト順に依存しない実装に変更
  *
  * LAST MODIFIED BY:
  *
@@ -133,14 +135,14 @@ PUBLIC tsAuthHashGenState sAuth_generateHashInfo(uint8* pu8Code, uint16 u16StCnt
 PUBLIC void vAuth_setSyncToken(tsAuthHashGenState* psHashGenInfo, uint8* pu8SyncToken) {
 	// 同期トークンの編集
 	memcpy(psHashGenInfo->u8SyncToken, pu8SyncToken, APP_AUTH_TOKEN_SIZE);
-	// シャッフルパターンの生成
-	TypeConverter converter;
-	converter.u32Values[0] = 0;
+	// シャッフルパターンの生成（4バイト毎の排他的論理和をビッグエンディアンで連結）
+	uint8 u8Fold[4] = {0x00, 0x00, 0x00, 0x00};
 	uint8 u8Idx;
 	for (u8Idx = 0; u8Idx < 32; u8Idx++) {
-		converter.u8Values[u8Idx % 4] = converter.u8Values[u8Idx % 4] ^ pu8SyncToken[u8Idx];
+		u8Fold[u8Idx % 4] = u8Fold[u8Idx % 4] ^ pu8SyncToken[u8Idx];
 	}
-	psHashGenInfo->u32ShufflePtn = converter.u32Values[0];
+	psHashGenInfo->u32ShufflePtn = ((uint32)u8Fold[0] << 24) | ((uint32)u8Fold[1] << 16)
+								 | ((uint32)u8Fold[2] << 8) | (uint32)u8Fold[3];
 }
 
 /****************************************************************************
@@ -164,10 +166,8 @@ PUBLIC bool_t bAuth_hashStretching(tsAuthHashGenState* psHashGenInfo) {
 	}
 	// 処理ステータス更新
 	psHashGenInfo->eStatus = E_AUTH_HASH_PROC_RUNNING;
-	// ハッシュ関数実行
-	SHA256_state sha256State = sSHA256_newState();
-	vSHA256_append(&sha256State, psHashGenInfo->u8HashCode, APP_AUTH_TOKEN_SIZE);
-	vSHA256_generateHash(&sha256State, psHashGenInfo->u8HashCode);
+	// ハッシュ関数実行（トークンサイズ固定なので1ブロックで算出）
+	vSHA256_generateHash32(psHashGenInfo->u8HashCode, psHashGenInfo->u8HashCode);
 	// シャッフル実行
 	uint32 u32ShufflePtn = psHashGenInfo->u32ShufflePtn;
 	uint8 u8Idx = 0;
@@ -191,6 +191,35 @@ PUBLIC bool_t bAuth_hashStretching(tsAuthHashGenState* psHashGenInfo) {
 	return FALSE;
 }
 
+/****************************************************************************
+ *
+ * NAME: bAuth_hashStretchingMulti
+ *
+ * DESCRIPTION:拡張ハッシュストレッチング処理（複数並行）
+ *
+ * PARAMETERS:            Name           RW  Usage
+ *   tsAuthHashGenInfo*   psHashGenInfo  RW  ハッシュ生成情報の配列
+ *   uint8                u8Cnt          R   ハッシュ生成情報の件数
+ *
+ * RETURNS:
+ *   bool_t TRUE:全件処理完了 FALSE:処理中
+ *
+ * NOTES:
+ * 互いに独立したハッシュ値を１回の呼び出しで１ラウンドずつ進める。
+ * 個々の結果はbAuth_hashStretchingを個別に実行した場合と同一となる。
+ ****************************************************************************/
+PUBLIC bool_t bAuth_hashStretchingMulti(tsAuthHashGenState* psHashGenInfo, uint8 u8Cnt) {
+	bool_t bComplete = TRUE;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < u8Cnt; u8Idx++) {
+		// 完了済みのハッシュ値はスキップされる
+		if (bAuth_hashStretching(&psHashGenInfo[u8Idx]) == FALSE) {
+			bComplete = FALSE;
+		}
+	}
+	return bComplete;
+}
+
 /****************************************************************************
  *
  * NAME: vAuth_setMstPwInfo
@@ -268,9 +297,7 @@ PUBLIC void vAuth_editOneTimeTkn(uint8* pu8OTTkn, uint16 u16RndVal, uint32 u32Re
 		u32ShufflePtn = u32ShufflePtn >> 1;
 	}
 	// ハッシュコード（ワンタイムトークン）算出
-	SHA256_state sha256State = sSHA256_newState();
-	vSHA256_append(&sha256State, u8WkCode, APP_AUTH_TOKEN_SIZE);
-	vSHA256_generateHash(&sha256State, pu8OTTkn);
+	vSHA256_generateHash32(u8WkCode, pu8OTTkn);
 }
 
 /****************************************************************************
@@ -9,6 +9,7 @@
  *
  * CHANGE HISTORY:
  * 2018/01/23 05:40:00 通信レコードレイアウトをAES暗号化に合わせて調整
+ * 2026/10/18 12:00:00 複数ハッシュ値の並行ストレッチング処理を追加
  *
  * LAST MODIFIED BY:
  *
@@ -113,6 +114,8 @@ PUBLIC tsAuthHashGenState sAuth_generateHashInfo(uint8* pu8Code, uint16 u16StCnt
 PUBLIC void vAuth_setSyncToken(tsAuthHashGenState* psHashGenInfo, uint8* pu8SyncToken);
 /** 拡張ハッシュストレッチング処理 */
 PUBLIC bool_t bAuth_hashStretching(tsAuthHashGenState* psHashGenInfo);
+/** 拡張ハッシュストレッチング処理（複数並行） */
+PUBLIC bool_t bAuth_hashStretchingMulti(tsAuthHashGenState* psHashGenInfo, uint8 u8Cnt);
 /** デバイス情報へのマスターパスワード情報設定 */
 PUBLIC void vAuth_setMstPwInfo(tsAuthHashGenState* psHashInfo, tsAuthDeviceInfo* psDevInfo);
 /** リモートデバイス情報へのキーペア設定 */
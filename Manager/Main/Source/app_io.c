@@ -9,6 +9,23 @@
  *
  * CHANGE HISTORY:
  * 2018/01/23 05:05:00 認証時の通信内容をAES暗号化する事で保護
+ * 2026/10/18 13:00:00 電文の暗号化をAES-CCMによる認証付き暗号に変更
+ * 2026/10/18 20:00:00 I2Cスケジューラへのデバイス登録とバス切替処理を追加
+ * 2026/10/18 21:00:00 主I2CバスのEEPROMとRTCの動作周波数を自動調整
+ * 2026/10/18 23:00:00 EEPROMの書き戻しキャッシュを有効化
+ * 2026/10/19 00:00:00 イベントログの書き込みを非同期化
+ * 2026/10/19 01:00:00 リモートデバイス情報の検索をデバイスディレクトリに変更
+ * 2026/10/19 02:00:00 イベントログをログ構造化リングに変更（インデックス更新無しで周回上書き）
+ * 2026/10/19 03:00:00 イベントログを時刻の差分とメッセージコード等の３バイトの圧縮形式で記録
+ * 2026/10/19 04:00:00 デバイス情報とインデックス情報とリモートデバイス情報の更新をジャーナル経由のトランザクションに変更
+ * 2026/10/19 05:00:00 リモートデバイス情報とイベントログの先読み、画面操作の応答時間の集計を追加
+ * 2026/10/19 06:00:00 イベントログの日付とメッセージコードによる検索を追加
+ * 2026/10/19 08:00:00 インデックス情報をI2Cバス毎にRAM上へキャッシュし、書き込みをイベントループで遅延
+ * 2026/10/19 09:00:00 LCD描画を表示内容との差分のみの送信に変更
+ * 2026/10/19 10:00:00 LCDコマンドを非同期実行に変更し、進行イベントで送信
+ * 2026/10/19 16:00:00 送信パケットをスロットプールで保持し、電文をスロット内で直接編集
+ * 2026/10/19 17:00:00 I2Cスケジューラへの登録結果を判定し、EEPROMとRTCとLCDの通信をスケジューラ経由に変更
+ * 2026/10/19 18:00:00 動作周波数の自動調整前後のEEPROMの一括読み込み速度を計測
  *
  * LAST MODIFIED BY:
  *
@@ -48,12 +65,14 @@
 #include "framework.h"
 #include "timer_util.h"
 #include "i2c_util.h"
+#include "i2c_sched.h"
 #include "io_util.h"
 #include "value_util.h"
 #include "keypad.h"
 #include "st7032i.h"
 #include "eeprom.h"
 #include "melody.h"
+#include "aes.h"
 #include "app_io.h"
 
 /****************************************************************************/
@@ -69,6 +88,36 @@
 /****************************************************************************/
 // LCDのカラム制御情報更新処理
 PRIVATE bool_t bLCDUpdCursorCntr();
+// I2Cバスの切替処理
+PRIVATE void vI2CBusSelect(uint8 u8Bus);
+// 選択中のI2Cバスの参照処理
+PRIVATE uint8 u8I2CBusCurrent();
+// I2Cスケジューラへのデバイス登録処理
+PRIVATE uint8 u8I2CSchedRegist(const char* pcName, uint8 u8Address, uint8 u8Priority, uint8 u8Bus);
+// I2Cデバイス毎の動作周波数の自動調整
+PRIVATE void vI2CSchedAutotune();
+// I2C EEPROMの一括読み込み速度の計測
+PRIVATE uint32 u32EEPROMReadRate();
+// 選択中のI2Cバスのリモートデバイスディレクトリの参照処理
+PRIVATE tsDevDir* psRemoteDevDir();
+// 選択中のI2Cバスのイベントログリングの参照処理
+PRIVATE tsLogRing* psEventLogRing();
+// 選択中のI2Cバスのイベントログ検索の参照処理
+PRIVATE tsLogQuery* psEventLogQuery();
+// 選択中のI2Cバスのジャーナル付きキーバリューストアの参照処理
+PRIVATE tsKVJournal* psKVJournal();
+// EEPROMの選択とジャーナルの復元
+PRIVATE bool_t bEEPROMSelect();
+// 選択中のI2Cバスのインデックス情報のキャッシュの参照処理
+PRIVATE tsAppIOIndexCache* psIndexCache();
+// インデックス情報の参照処理（未読み込みの場合のみEEPROMから読み込む）
+PRIVATE tsAppIOIndexInfo* psEEPROMLoadIndex();
+// インデックス情報の遅延書き込み処理
+PRIVATE bool_t bEEPROMFlushIndex();
+// EEPROM先読み要求の登録処理
+PRIVATE void vEEPROMPrefetchRequest(teAppIOPrefetch eType, uint16 u16Idx, bool_t bForwardFlg);
+// イベントログ情報の展開処理
+PRIVATE void vEEPROMExpandLog(tsAppIOEventLog *psAppIOEventLog, uint32 u32Key, uint8* pu8LogData, uint16 u16SeqNo);
 
 /****************************************************************************/
 /***        Exported Variables                                            ***/
@@ -81,6 +130,14 @@ PRIVATE const char APP_IO_USE_STRING[] =
 	"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ+-/*!#$%&()?_@";
 /** 送信データフレームシーケンス */
 PRIVATE uint8 u8TxSeq = 0;
+/** 送信スロット（受信無効化時に初期化されない様に無線通信情報とは別に保持） */
+PRIVATE tsTxSlot sTxBuffer[TX_BUFFER_SIZE];
+/** 最後に確保した送信スロットのインデックス */
+PRIVATE uint8 u8TxIdx = 0;
+/** 選択中のI2Cバス */
+PRIVATE uint8 u8I2CBus = I2C_SCHED_BUS_MAIN;
+/** リモートデバイス情報の先読みバッファ */
+PRIVATE uint8 u8RemoteStreamBuff[sizeof(tsAuthRemoteDevInfo) * REMOTE_DEV_STREAM_CNT];
 
 /****************************************************************************/
 /***        Exported Functions                                            ***/
@@ -105,10 +162,42 @@ PUBLIC void vAppIOInit() {
 	vKeyPadInit();
 	// メロディ演奏機能の初期処理
 	vMelodyInit();
+	// I2Cスケジューラの初期化（LCD表示よりも認証情報の読み書きを優先）
+	vI2CSched_init(vI2CBusSelect, u8I2CBusCurrent);
+	sAppIO.u8SchedMainEEPROM =
+		u8I2CSchedRegist("EEPROM(M)", I2C_ADDR_EEPROM_0, I2C_SCHED_PRIORITY_HIGH, I2C_SCHED_BUS_MAIN);
+	sAppIO.u8SchedSubEEPROM  =
+		u8I2CSchedRegist("EEPROM(S)", I2C_ADDR_EEPROM_0, I2C_SCHED_PRIORITY_HIGH, I2C_SCHED_BUS_SUB);
+	sAppIO.u8SchedRTC =
+		u8I2CSchedRegist("RTC", I2C_ADDR_DS3231, I2C_SCHED_PRIORITY_NORMAL, I2C_SCHED_BUS_MAIN);
+	sAppIO.u8SchedLCD =
+		u8I2CSchedRegist("LCD", I2C_ADDR_ST7032I, I2C_SCHED_PRIORITY_LOW, I2C_SCHED_BUS_MAIN);
+	// RTCとLCDの通信はI2Cスケジューラ経由（EEPROMはバスの選択時に設定）
+	vDS3231_setSchedDevice(sAppIO.u8SchedRTC);
+	vST7032i_setSchedDevice(sAppIO.u8SchedLCD);
 	// 主I2Cバス選択
 	vI2CMainConnect();
 	// I2C接続EEPROM初期化処理
 	vEEPROMInit();
+	// リモートデバイスディレクトリの初期化（初回の検索時に構築）
+	vDevDir_init(&sAppIO.sMainDevDir, MAX_REMOTE_DEV_CNT);
+	vDevDir_init(&sAppIO.sSubDevDir, MAX_REMOTE_DEV_CNT);
+	// イベントログリングの初期化（初回のアクセス時に復元）
+	vLogRing_init(&sAppIO.sMainLogRing, TOP_ADDR_EVENT_LOG, EVT_LOG_BLOCK_CNT, EVT_LOG_BLOCK_SIZE, EVT_LOG_PAYLOAD_SIZE, TRUE);
+	vLogRing_init(&sAppIO.sSubLogRing, TOP_ADDR_EVENT_LOG, EVT_LOG_BLOCK_CNT, EVT_LOG_BLOCK_SIZE, EVT_LOG_PAYLOAD_SIZE, TRUE);
+	// イベントログ検索の初期化（分類はメッセージコード、集計情報は検索時に作成）
+	vLogQuery_init(&sAppIO.sMainLogQuery, &sAppIO.sMainLogRing, 0, (uint8)~EVT_LOG_TIME_INVALID, EVT_LOG_TIME_INVALID);
+	vLogQuery_init(&sAppIO.sSubLogQuery, &sAppIO.sSubLogRing, 0, (uint8)~EVT_LOG_TIME_INVALID, EVT_LOG_TIME_INVALID);
+	// ジャーナル付きキーバリューストアの初期化（初回のアクセス時に復元）
+	vKVJournal_init(&sAppIO.sMainJournal, TOP_ADDR_JOURNAL, EEPROM_PAGE_SIZE_64B);
+	vKVJournal_init(&sAppIO.sSubJournal, TOP_ADDR_JOURNAL, EEPROM_PAGE_SIZE_64B);
+	// リモートデバイス情報の先読みストリームの初期化
+	vEEPROM_streamInit(&sAppIO.sRemoteStream, TOP_ADDR_REMOTE_DEV, sizeof(tsAuthRemoteDevInfo),
+		MAX_REMOTE_DEV_CNT, u8RemoteStreamBuff, sizeof(u8RemoteStreamBuff));
+	// 画面操作の応答時間の統計情報の初期化
+	memset(&sAppIOStepStats, 0x00, sizeof(tsAppIOStepStats));
+	// I2Cデバイス毎の動作周波数の自動調整
+	vI2CSchedAutotune();
 	// デバイス情報の読み込み
 	tsAuthDeviceInfo sDevInfo;
 	if (bEEPROMReadDevInfo(&sDevInfo) == FALSE) {
@@ -199,9 +288,20 @@ PUBLIC uint8 u8ReadKeyPad() {
  * None.
  *****************************************************************************/
 PUBLIC void vI2CMainConnect() {
+	// 実行中のトランザクションの完了待ち
+	vI2C_waitIdle();
+	// 主副のEEPROMは同一アドレスの為、切り替え前にインデックス情報と非同期書き込みを完了させ、
+	// キャッシュを書き戻して破棄
+	if (u8I2CBus != I2C_SCHED_BUS_MAIN) {
+		bEEPROMFlushIndex();
+		bEEPROM_asyncWait();
+		bEEPROM_commit();
+		vEEPROM_cacheInvalidate();
+	}
 	// USB接続
-	vAHI_DioSetDirection(0x00, I2C_BUS_01 | I2C_BUS_02);
-	vAHI_DioSetOutput(I2C_BUS_01, I2C_BUS_02);
+	vI2CBusSelect(I2C_SCHED_BUS_MAIN);
+	// EEPROMの通信は主I2CバスのデバイスとしてI2Cスケジューラ経由
+	vEEPROM_setSchedDevice(sAppIO.u8SchedMainEEPROM);
 }
 
 /*****************************************************************************
@@ -218,9 +318,23 @@ PUBLIC void vI2CMainConnect() {
  * None.
  *****************************************************************************/
 PUBLIC void vI2CSubConnect() {
+	// 実行中のトランザクションの完了待ち
+	vI2C_waitIdle();
+	// 主副のEEPROMは同一アドレスの為、切り替え前にインデックス情報と非同期書き込みを完了させ、
+	// キャッシュを書き戻して破棄
+	if (u8I2CBus != I2C_SCHED_BUS_SUB) {
+		// LCDは主I2Cバスに接続されているので、実行待ちのコマンドを送信
+		bST7032i_deviceSelect(&sLCDInfo.sLCDstate);
+		bST7032i_asyncWait();
+		bEEPROMFlushIndex();
+		bEEPROM_asyncWait();
+		bEEPROM_commit();
+		vEEPROM_cacheInvalidate();
+	}
 	// USB接続
-	vAHI_DioSetDirection(0x00, I2C_BUS_01 | I2C_BUS_02);
-	vAHI_DioSetOutput(I2C_BUS_02, I2C_BUS_01);
+	vI2CBusSelect(I2C_SCHED_BUS_SUB);
+	// EEPROMの通信は副I2CバスのデバイスとしてI2Cスケジューラ経由
+	vEEPROM_setSchedDevice(sAppIO.u8SchedSubEEPROM);
 }
 
 /****************************************************************************
@@ -241,7 +355,19 @@ PUBLIC uint8 u8I2CDeviceTypeChk(DS3231_datetime* psDatetime) {
 	uint8 u8DevType = 0x00;
 	// EEPROM
 	uint8 u8Buff[1];
+	// 未書き込みのインデックス情報を確定
+	bEEPROMFlushIndex();
 	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	// キャッシュを経由せずに実デバイスへアクセスする
+	bEEPROM_commit();
+	vEEPROM_cacheInvalidate();
+	// デバイスが交換された可能性があるので、次のアクセス時にディレクトリとログリングとジャーナル、
+	// インデックス情報を再構築する
+	psRemoteDevDir()->bValid = FALSE;
+	psEventLogRing()->bValid = FALSE;
+	psKVJournal()->bValid    = FALSE;
+	psIndexCache()->bValid   = FALSE;
+	vLogQuery_invalidate(psEventLogQuery());
 	if (bEEPROM_readData(0, 1, u8Buff)) {
 		u8DevType = I2C_DEVICE_EEPROM;
 	}
@@ -308,6 +434,7 @@ PUBLIC void vEEPROMInit() {
 	sAppIO.sEEPROM_status.b2ByteAddrFlg = TRUE;
 	sAppIO.sEEPROM_status.u8PageSize    = EEPROM_PAGE_SIZE_64B;
 	sAppIO.sEEPROM_status.u64LastWrite  = u64TimerUtil_readUsec();
+	sAppIO.sEEPROM_status.bCacheFlg     = TRUE;
 }
 
 /****************************************************************************
@@ -325,7 +452,9 @@ PUBLIC void vEEPROMInit() {
  ****************************************************************************/
 PUBLIC bool_t bEEPROMReadDevInfo(tsAuthDeviceInfo *psDevInfo) {
 	// I2C EEPROM Read
-	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
 	return bEEPROM_readData(TOP_ADDR_DEV, sizeof(tsAuthDeviceInfo), (uint8 *)psDevInfo);
 }
 
@@ -344,8 +473,14 @@ PUBLIC bool_t bEEPROMReadDevInfo(tsAuthDeviceInfo *psDevInfo) {
  ****************************************************************************/
 PUBLIC bool_t bEEPROMWriteDevInfo(tsAuthDeviceInfo *psDevInfo) {
 	// I2C EEPROM Write
-	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	return bEEPROM_writeData(TOP_ADDR_DEV, sizeof(tsAuthDeviceInfo), (uint8 *)psDevInfo);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
+	// ジャーナル経由で書き込み（内容が変わらないページは書き込まない）
+	tsKVJournal* psJnl = psKVJournal();
+	vKVJournal_begin(psJnl);
+	bKVJournal_put(psJnl, TOP_ADDR_DEV, (uint8 *)psDevInfo, sizeof(tsAuthDeviceInfo));
+	return bKVJournal_commit(psJnl);
 }
 
 /****************************************************************************
@@ -360,20 +495,17 @@ PUBLIC bool_t bEEPROMWriteDevInfo(tsAuthDeviceInfo *psDevInfo) {
  * RETURNS:
  *   bool_t TRUE:読み込み成功
  *
+ * NOTES:
+ * 選択中のI2Cバスのキャッシュから参照し、EEPROMはデバイスチェック後の初回のみ読み込む
  ****************************************************************************/
 PUBLIC bool_t bEEPROMReadIndexInfo(tsAppIOIndexInfo *psIndexInfo) {
-	// I2C EEPROM Read
-	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	bool_t bResult = bEEPROM_readData(TOP_ADDR_INDEX, sizeof(tsAppIOIndexInfo), (uint8 *)psIndexInfo);
-	// レコード有効チェック
-	if (psIndexInfo->u8EnableCheck == 0xAA) {
-		return bResult;
+	// キャッシュの参照（未読み込みの場合のみI2C EEPROM Read）
+	tsAppIOIndexInfo* psIndex = psEEPROMLoadIndex();
+	if (psIndex == NULL) {
+		return FALSE;
 	}
-	// レコード初期化
-	psIndexInfo->u8EnableCheck   = 0xAA;
-	psIndexInfo->u32RemoteDevMap = 0x00;
-	psIndexInfo->u8EventLogCnt   = 0;
-	return bEEPROMWriteIndexInfo(psIndexInfo);
+	*psIndexInfo = *psIndex;
+	return TRUE;
 }
 
 /****************************************************************************
@@ -388,11 +520,20 @@ PUBLIC bool_t bEEPROMReadIndexInfo(tsAppIOIndexInfo *psIndexInfo) {
  * RETURNS:
  *   bool_t TRUE:読み込み成功
  *
+ * NOTES:
+ * キャッシュのみを更新し、EEPROMへはイベントループ（vEventEEPROMPoll）かI2Cバスの切替、
+ * デバイスチェックの前に１回の書き込みでまとめて反映する
  ****************************************************************************/
 PUBLIC bool_t bEEPROMWriteIndexInfo(tsAppIOIndexInfo *psIndexInfo) {
-	// I2C EEPROM Write
-	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	return bEEPROM_writeData(TOP_ADDR_INDEX, sizeof(tsAppIOIndexInfo), (uint8 *)psIndexInfo);
+	// キャッシュの更新（I2C EEPROM Writeはイベントループでまとめて行う）
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
+	tsAppIOIndexCache* psCache = psIndexCache();
+	psCache->sInfo  = *psIndexInfo;
+	psCache->bValid = TRUE;
+	psCache->bDirty = TRUE;
+	return TRUE;
 }
 
 
@@ -410,31 +551,21 @@ PUBLIC bool_t bEEPROMWriteIndexInfo(tsAppIOIndexInfo *psIndexInfo) {
  *
  ****************************************************************************/
 PUBLIC int iEEPROMIndexOfRemoteInfo(uint32 u32DeviceID) {
-	// インデックス情報読み込み
-	if (!bEEPROMReadIndexInfo(&sIndexInfo)) {
+	// インデックス情報参照
+	tsAppIOIndexInfo* psIndex = psEEPROMLoadIndex();
+	if (psIndex == NULL) {
 		return -1;
 	}
-	// リモートデバイス情報の探索
-	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	tsAuthRemoteDevInfo wkInfo;
-	uint32 u32Size = sizeof(tsAuthRemoteDevInfo);
-	uint8 u8Idx;
-	for (u8Idx = 0; u8Idx < MAX_REMOTE_DEV_CNT; u8Idx++) {
-		// レコード有無判定
-		if ((sIndexInfo.u32RemoteDevMap & (0x01 << u8Idx)) == 0) {
-			continue;
-		}
-		// レコード読み込み
-		if (!bEEPROM_readData(TOP_ADDR_REMOTE_DEV + u32Size * u8Idx, u32Size, (uint8*)&wkInfo)) {
+	// リモートデバイスディレクトリの構築（未構築の場合のみ）
+	tsDevDir* psDir = psRemoteDevDir();
+	if (psDir->bValid == FALSE) {
+		bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+		if (!bDevDir_build(psDir, TOP_ADDR_REMOTE_DEV, sizeof(tsAuthRemoteDevInfo), psIndex->u32RemoteDevMap)) {
 			return -1;
 		}
-		// デバイスID判定
-		if (wkInfo.u32DeviceID == u32DeviceID) {
-			return u8Idx;
-		}
 	}
-	// 対象レコード無し
-	return -1;
+	// リモートデバイス情報の探索（対象レコード無しの場合は-1）
+	return iDevDir_indexOf(psDir, u32DeviceID);
 }
 
 /****************************************************************************
@@ -453,8 +584,9 @@ PUBLIC int iEEPROMIndexOfRemoteInfo(uint32 u32DeviceID) {
  *
  ****************************************************************************/
 PUBLIC int iEEPROMReadRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo, uint8 u8Idx, bool_t bForwardFlg) {
-	// インデックス情報読み込み
-	if (!bEEPROMReadIndexInfo(&sIndexInfo)) {
+	// インデックス情報参照
+	tsAppIOIndexInfo* psIndex = psEEPROMLoadIndex();
+	if (psIndex == NULL) {
 		return -1;
 	}
 	// リモートデバイス情報のインデックス探索
@@ -467,7 +599,7 @@ PUBLIC int iEEPROMReadRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo, uint8 u8Idx,
 	uint8 u8ChkIdx = u8Idx;
 	uint8 u8Cnt;
 	for (u8Cnt = 0; u8Cnt < MAX_REMOTE_DEV_CNT; u8Cnt++) {
-		if ((sIndexInfo.u32RemoteDevMap & (0x01 << u8ChkIdx)) != 0) {
+		if ((psIndex->u32RemoteDevMap & (0x01 << u8ChkIdx)) != 0) {
 			break;
 		}
 		u8ChkIdx = (u8ChkIdx + u8Add) % MAX_REMOTE_DEV_CNT;
@@ -475,13 +607,20 @@ PUBLIC int iEEPROMReadRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo, uint8 u8Idx,
 	if (u8Cnt >= MAX_REMOTE_DEV_CNT) {
 		return -2;
 	}
-	// I2C EEPROM Read
-	uint32 u32Size = sizeof(tsAuthRemoteDevInfo);
-	uint32 u32Addr = TOP_ADDR_REMOTE_DEV + u32Size * u8ChkIdx;
+	// I2C EEPROM Read（探索方向の後続レコードをまとめて先読み）
 	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	if (!bEEPROM_readData(u32Addr, u32Size, (uint8 *)psRemoteInfo)) {
+	if (!bEEPROM_streamRead(&sAppIO.sRemoteStream, u8ChkIdx, bForwardFlg, (uint8 *)psRemoteInfo)) {
 		return -3;
 	}
+	// 次に選択されるレコードの先読み要求
+	uint8 u8NextIdx = (u8ChkIdx + u8Add) % MAX_REMOTE_DEV_CNT;
+	for (u8Cnt = 0; u8Cnt < MAX_REMOTE_DEV_CNT; u8Cnt++) {
+		if ((psIndex->u32RemoteDevMap & (0x01 << u8NextIdx)) != 0) {
+			break;
+		}
+		u8NextIdx = (u8NextIdx + u8Add) % MAX_REMOTE_DEV_CNT;
+	}
+	vEEPROMPrefetchRequest(E_APP_IO_PREFETCH_REMOTE_DEV, u8NextIdx, bForwardFlg);
 	return u8ChkIdx;
 }
 
@@ -501,30 +640,57 @@ PUBLIC int iEEPROMReadRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo, uint8 u8Idx,
 PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
 	// レコードインデックス探索
 	int iIdx = iEEPROMIndexOfRemoteInfo(psRemoteInfo->u32DeviceID);
-	if (iIdx < 0) {
+	tsAppIOIndexCache* psCache = psIndexCache();
+	if (psCache->bValid == FALSE) {
+		return -1;
+	}
+	tsAppIOIndexInfo* psIndex = &psCache->sInfo;
+	bool_t bNewFlg = (iIdx < 0);
+	if (bNewFlg) {
 		// 空き領域の有無判定
-		if (sIndexInfo.u32RemoteDevMap == 0xFFFFFFFF) {
+		if (psIndex->u32RemoteDevMap == 0xFFFFFFFF) {
 			return -1;
 		}
 		// 空き領域の探索
 		for (iIdx = 0; iIdx < MAX_REMOTE_DEV_CNT; iIdx++) {
-			if ((sIndexInfo.u32RemoteDevMap & (0x01 << iIdx)) == 0) {
+			if ((psIndex->u32RemoteDevMap & (0x01 << iIdx)) == 0) {
 				break;
 			}
 		}
-		// インデックス情報更新
-		sIndexInfo.u32RemoteDevMap = sIndexInfo.u32RemoteDevMap | (0x00000001 << iIdx);
-		if (!bEEPROMWriteIndexInfo(&sIndexInfo)) {
-			return -2;
-		}
 	}
-	// I2C EEPROM Write
+	// インデックス情報とレコードを１トランザクションで書き込み
+	// （未書き込みのインデックス情報の変更も同じトランザクションで反映する）
+	tsKVJournal* psJnl = psKVJournal();
+	vKVJournal_begin(psJnl);
+	bool_t bIndexFlg = (bNewFlg || psCache->bDirty);
+	if (bNewFlg) {
+		psIndex->u32RemoteDevMap = psIndex->u32RemoteDevMap | (0x00000001 << iIdx);
+	}
+	if (bIndexFlg) {
+		bKVJournal_put(psJnl, TOP_ADDR_INDEX, (uint8 *)psIndex, sizeof(tsAppIOIndexInfo));
+	}
 	uint32 u32Size = sizeof(tsAuthRemoteDevInfo);
 	uint32 u32Addr = TOP_ADDR_REMOTE_DEV + u32Size * iIdx;
+	bKVJournal_put(psJnl, u32Addr, (uint8 *)psRemoteInfo, u32Size);
+	// I2C EEPROM Write
 	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	if (!bEEPROM_writeData(u32Addr, u32Size, (uint8 *)psRemoteInfo)) {
+	if (!bKVJournal_commit(psJnl)) {
+		// 書き込み結果が不定なので、インデックス情報は次回のアクセス時に再読み込みする
+		psRemoteDevDir()->bValid = FALSE;
+		psCache->bValid = FALSE;
+		psCache->bDirty = FALSE;
+		if (bNewFlg) {
+			return -2;
+		}
 		return -3;
 	}
+	if (bIndexFlg) {
+		psCache->bDirty = FALSE;
+	}
+	// リモートデバイスディレクトリ更新
+	if (bNewFlg) {
+		bDevDir_add(psRemoteDevDir(), psRemoteInfo->u32DeviceID, (uint8)iIdx);
+	}
 	return iIdx;
 }
 
@@ -548,21 +714,31 @@ PUBLIC int iEEPROMDeleteRemoteInfo(uint32 u32DeviceID) {
 	if (iIdx < 0) {
 		return -1;
 	}
-	// リモートデバイス情報マップを更新
-	sIndexInfo.u32RemoteDevMap = sIndexInfo.u32RemoteDevMap & ~(0x00000001 << iIdx);
-	if (!bEEPROMWriteIndexInfo(&sIndexInfo)) {
-		return -2;
-	}
 	// 空レコード編集
 	tsAuthRemoteDevInfo sRemoteInfo;
 	memset(&sRemoteInfo, '\0', sizeof(tsAuthRemoteDevInfo));
-	// I2C EEPROM Write
+	// リモートデバイス情報マップと空レコードを１トランザクションで書き込み
+	tsAppIOIndexCache* psCache = psIndexCache();
+	tsAppIOIndexInfo* psIndex = &psCache->sInfo;
+	psIndex->u32RemoteDevMap = psIndex->u32RemoteDevMap & ~(0x00000001 << iIdx);
 	uint32 u32Size = sizeof(tsAuthRemoteDevInfo);
 	uint32 u32Addr = TOP_ADDR_REMOTE_DEV + u32Size * iIdx;
+	tsKVJournal* psJnl = psKVJournal();
+	vKVJournal_begin(psJnl);
+	bKVJournal_put(psJnl, TOP_ADDR_INDEX, (uint8 *)psIndex, sizeof(tsAppIOIndexInfo));
+	bKVJournal_put(psJnl, u32Addr, (uint8*)&sRemoteInfo, u32Size);
+	// I2C EEPROM Write
 	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	if (!bEEPROM_writeData(u32Addr, u32Size, (uint8*)&sRemoteInfo)) {
-		return -3;
+	if (!bKVJournal_commit(psJnl)) {
+		// 書き込み結果が不定なので、インデックス情報は次回のアクセス時に再読み込みする
+		psCache->bValid = FALSE;
+		psCache->bDirty = FALSE;
+		psRemoteDevDir()->bValid = FALSE;
+		return -2;
 	}
+	psCache->bDirty = FALSE;
+	// リモートデバイスディレクトリ更新
+	iDevDir_remove(psRemoteDevDir(), u32DeviceID);
 	return iIdx;
 }
 
@@ -579,16 +755,22 @@ PUBLIC int iEEPROMDeleteRemoteInfo(uint32 u32DeviceID) {
  *
  ****************************************************************************/
 PUBLIC int iEEPROMDeleteAllRemoteInfo() {
-	// インデックス情報読み込み
-	if (!bEEPROMReadIndexInfo(&sIndexInfo)) {
+	// インデックス情報参照
+	tsAppIOIndexInfo* psIndex = psEEPROMLoadIndex();
+	if (psIndex == NULL) {
 		return -1;
 	}
-	// リモートデバイス情報マップをクリア
-	sIndexInfo.u32RemoteDevMap = 0;
-	if (!bEEPROMWriteIndexInfo(&sIndexInfo)) {
+	// リモートデバイス情報マップをクリア（レコードの消去前に書き込む）
+	psIndex->u32RemoteDevMap = 0;
+	psIndexCache()->bDirty   = TRUE;
+	if (!bEEPROMFlushIndex()) {
 		return -2;
 	}
-	// 空レコード編集
+	// リモートデバイスディレクトリのクリア
+	tsDevDir* psDir = psRemoteDevDir();
+	vDevDir_init(psDir, MAX_REMOTE_DEV_CNT);
+	psDir->bValid = TRUE;
+	// 空レコード編集（マップから外れたレコードなので、ジャーナルを経由せずに直接書き込む）
 	tsAuthRemoteDevInfo sRemoteInfo;
 	memset(&sRemoteInfo, '\0', sizeof(tsAuthRemoteDevInfo));
 	// I2C EEPROM Write
@@ -602,6 +784,10 @@ PUBLIC int iEEPROMDeleteAllRemoteInfo() {
 			return -3;
 		}
 	}
+	// キャッシュの書き戻し
+	if (!bEEPROM_commit()) {
+		return -3;
+	}
 	return 1;
 }
 
@@ -611,34 +797,132 @@ PUBLIC int iEEPROMDeleteAllRemoteInfo() {
  *
  * DESCRIPTION:EEPROM読み込み（イベントログ情報）
  *
- * PARAMETERS:             Name         RW  Usage
- * tsAppIORemoteDevInfo*   psDevInfo    R   リモートデバイス情報
- * uint8                   u8Idx        R   探索開始インデックス
- * int                     iAdd         R   インデックス増分
+ * PARAMETERS:             Name             RW  Usage
+ * tsAppIOEventLog*        psAppIOEventLog  W   イベントログ情報
+ * uint8                   u8Idx            R   探索開始インデックス
+ * bool_t                  bForwardFlg      R   順方向探索フラグ
  *
  * RETURNS:
- *   int 読み込みレコードインデックス、読み込めない場合はマイナス値
+ *   int 読み込みレコードインデックス、エラー時はマイナス値(-1:ログリング復元エラー、-2:対象データなし、-3:読み込みエラー)
  *
+ * NOTES:
+ * インデックス0が最も古いログ、途中で閉じたブロックの空きエントリは読み飛ばす
+ * 末尾と先頭は循環して探索する
  ****************************************************************************/
-PUBLIC int iEEPROMReadLog(tsAppIOEventLog *psAppIOEventLog, uint8 u8Idx) {
-	// インデックス情報読み込み
-	if (!bEEPROMReadIndexInfo(&sIndexInfo)) {
+PUBLIC int iEEPROMReadLog(tsAppIOEventLog *psAppIOEventLog, uint8 u8Idx, bool_t bForwardFlg) {
+	// イベントログリングの復元（未復元の場合のみ）
+	tsLogRing* psRing = psEventLogRing();
+	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	if (psRing->bValid == FALSE && !bLogRing_recover(psRing)) {
 		return -1;
 	}
 	// ログの有無判定
-	if (sIndexInfo.u8EventLogCnt == 0) {
+	uint16 u16Cnt = psRing->u16Cnt;
+	if (u16Cnt == 0) {
 		return -2;
 	}
-	// 変数宣言
-	uint32 u32ReadIdx = u8Idx % sIndexInfo.u8EventLogCnt;
-	uint32 u32Size = sizeof(tsAppIOEventLog);
-	uint32 u32Addr = TOP_ADDR_EVENT_LOG + u32Size * u32ReadIdx;
-	// I2C EEPROM Read
+	// イベントログ情報のインデックス探索
+	uint16 u16Add;
+	if (bForwardFlg) {
+		u16Add = 1;
+	} else {
+		u16Add = u16Cnt - 1;
+	}
+	uint16 u16ChkIdx = u8Idx;
+	if (u16ChkIdx >= u16Cnt) {
+		// 範囲外の場合は順方向は最も古いログ、逆方向は最新のログから探索
+		u16ChkIdx = bForwardFlg ? 0 : u16Cnt - 1;
+	}
+	uint32 u32Key;
+	uint8 u8LogData[EVT_LOG_PAYLOAD_SIZE];
+	uint16 u16SeqNo;
+	int iResult;
+	uint16 u16Idx;
+	for (u16Idx = 0; u16Idx < u16Cnt; u16Idx++) {
+		// I2C EEPROM Read
+		iResult = iLogRing_read(psRing, u16ChkIdx, &u32Key, u8LogData, EVT_LOG_PAYLOAD_SIZE, &u16SeqNo);
+		if (iResult >= 0) {
+			break;
+		}
+		if (iResult != -3) {
+			return -3;
+		}
+		u16ChkIdx = (u16ChkIdx + u16Add) % u16Cnt;
+	}
+	if (u16Idx >= u16Cnt) {
+		return -2;
+	}
+	// イベントログ展開
+	vEEPROMExpandLog(psAppIOEventLog, u32Key, u8LogData, u16SeqNo);
+	// 次に表示されるログの先読み要求
+	vEEPROMPrefetchRequest(E_APP_IO_PREFETCH_EVENT_LOG, (u16ChkIdx + u16Add) % u16Cnt, bForwardFlg);
+	return u16ChkIdx;
+}
+
+/****************************************************************************
+ *
+ * NAME: iEEPROMQueryLog
+ *
+ * DESCRIPTION:EEPROM検索（イベントログ情報）
+ *
+ * PARAMETERS:             Name             RW  Usage
+ * tsAppIOEventLog*        psAppIOEventLog  W   イベントログ情報
+ * tsLogQueryCond*         psCond           R   検索条件（日とメッセージコードのマップ）
+ * uint16                  u16Idx           R   探索開始インデックス
+ * bool_t                  bForwardFlg      R   順方向探索フラグ
+ *
+ * RETURNS:
+ *   int 読み込みレコードインデックス、エラー時はマイナス値(-1:ログリング復元エラー、-2:対象データなし、-3:読み込みエラー)
+ *
+ * NOTES:
+ * 末尾と先頭は循環しない、範囲外のインデックスを逆方向に探索した場合は最新のログから探索する
+ * ブロック毎の集計情報で対象外のブロックは読み込まないので、１件当たりの読み込みは概ね１回
+ ****************************************************************************/
+PUBLIC int iEEPROMQueryLog(tsAppIOEventLog *psAppIOEventLog, const tsLogQueryCond *psCond, uint16 u16Idx, bool_t bForwardFlg) {
+	// イベントログリングの復元（未復元の場合のみ）
+	tsLogRing* psRing = psEventLogRing();
 	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	if (!bEEPROM_readData(u32Addr, u32Size, (uint8 *)psAppIOEventLog)) {
+	if (psRing->bValid == FALSE && !bLogRing_recover(psRing)) {
+		return -1;
+	}
+	// I2C EEPROM Read
+	uint32 u32Key;
+	uint8 u8LogData[EVT_LOG_PAYLOAD_SIZE];
+	uint16 u16SeqNo;
+	int iIdx = iLogQuery_find(psEventLogQuery(), psCond, u16Idx, bForwardFlg,
+							  &u32Key, u8LogData, EVT_LOG_PAYLOAD_SIZE, &u16SeqNo);
+	if (iIdx == -3) {
+		return -2;
+	}
+	if (iIdx < 0) {
 		return -3;
 	}
-	return u32ReadIdx;
+	// イベントログ展開
+	vEEPROMExpandLog(psAppIOEventLog, u32Key, u8LogData, u16SeqNo);
+	return iIdx;
+}
+
+/****************************************************************************
+ *
+ * NAME: u16EEPROMLogDay
+ *
+ * DESCRIPTION:イベントログ検索用の日の算出
+ *
+ * PARAMETERS:             Name             RW  Usage
+ * uint16                  u16Year          R   年
+ * uint8                   u8Month          R   月
+ * uint8                   u8Day            R   日
+ *
+ * RETURNS:
+ *   uint16 基準年からの経過日数、無効な日付の場合はLOG_QUERY_DAY_NONE
+ *
+ ****************************************************************************/
+PUBLIC uint16 u16EEPROMLogDay(uint16 u16Year, uint8 u8Month, uint8 u8Day) {
+	if (!bValUtil_validDate(u16Year, u8Month, u8Day) ||
+		u16Year < VAL_UTIL_EPOCH_YEAR || u16Year >= VAL_UTIL_EPOCH_YEAR_LIMIT) {
+		return LOG_QUERY_DAY_NONE;
+	}
+	return LOG_QUERY_KEY_TO_DAY(u32ValUtil_datetimeToSec(u16Year, u8Month, u8Day, 0, 0, 0));
 }
 
 /****************************************************************************
@@ -652,44 +936,37 @@ PUBLIC int iEEPROMReadLog(tsAppIOEventLog *psAppIOEventLog, uint8 u8Idx) {
  *   tsWirelessMsg*      psWirelessMsg     R   無線メッセージ
  *
  * RETURNS:
- *   int 書き込みレコードインデックス、読み込めない場合はマイナス値
+ *   int 書き込みエントリ位置、エラー時はマイナス値（-1:ログリング復元エラー、-2:書き込みエラー）
  *
+ * NOTES:
+ * ログが一杯の場合は最も古いログを上書きする
+ * インデックス情報は更新しない
  ****************************************************************************/
 PUBLIC int iEEPROMWriteLog(uint16 u16MsgCd, tsWirelessMsg *psWirelessMsg) {
-	// インデックス情報読み込み
-	if (!bEEPROMReadIndexInfo(&sIndexInfo)) {
+	// イベントログリングの復元（未復元の場合のみ）
+	tsLogRing* psRing = psEventLogRing();
+	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	if (psRing->bValid == FALSE && !bLogRing_recover(psRing)) {
 		return -1;
 	}
-	// ログ数の判定
-	if (sIndexInfo.u8EventLogCnt >= MAX_EVT_LOG_CNT) {
+	// イベントログ編集（日時は基準年からの経過秒数、無効な日時は直前のログと同じ時刻とする）
+	uint32 u32Key = LOG_RING_KEY_NONE;
+	uint8 u8LogData[EVT_LOG_PAYLOAD_SIZE];
+	u8LogData[0] = (uint8)u16MsgCd | EVT_LOG_TIME_INVALID;	// メッセージコード
+	u8LogData[1] = psWirelessMsg->u8Command;				// コマンド
+	u8LogData[2] = psWirelessMsg->u8StatusMap;				// ステータスマップ
+	if (bValUtil_validDate(psWirelessMsg->u16Year, psWirelessMsg->u8Month, psWirelessMsg->u8Day) &&
+		bValUtil_validTime(psWirelessMsg->u8Hour, psWirelessMsg->u8Minute, psWirelessMsg->u8Second) &&
+		psWirelessMsg->u16Year >= VAL_UTIL_EPOCH_YEAR && psWirelessMsg->u16Year < VAL_UTIL_EPOCH_YEAR_LIMIT) {
+		u32Key = u32ValUtil_datetimeToSec(psWirelessMsg->u16Year, psWirelessMsg->u8Month, psWirelessMsg->u8Day,
+										  psWirelessMsg->u8Hour, psWirelessMsg->u8Minute, psWirelessMsg->u8Second);
+		u8LogData[0] = (uint8)u16MsgCd;
+	}
+	// I2C EEPROM Write（書き込み完了はイベントループで待つ）
+	int iIdx = iLogRing_append(psRing, u32Key, u8LogData, EVT_LOG_PAYLOAD_SIZE);
+	if (iIdx < 0) {
 		return -2;
 	}
-	// インデックス情報更新
-	sIndexInfo.u8EventLogCnt++;
-	if (!bEEPROMWriteIndexInfo(&sIndexInfo)) {
-		return -3;
-	}
-	// イベントログ編集
-	tsAppIOEventLog sAppIOEventLog;
-	memset(&sAppIOEventLog, 0x00, sizeof(tsAppIOEventLog));
-	sAppIOEventLog.u8SeqNo   = sIndexInfo.u8EventLogCnt;		// シーケンス番号
-	sAppIOEventLog.u16MsgCd  = u16MsgCd;						// メッセージコード
-	sAppIOEventLog.u8Command = psWirelessMsg->u8Command;		// コマンド
-	sAppIOEventLog.u8StatusMap = psWirelessMsg->u8StatusMap;	// ステータスマップ
-	sAppIOEventLog.u16Year   = psWirelessMsg->u16Year;			// イベント発生日（年）
-	sAppIOEventLog.u8Month   = psWirelessMsg->u8Month;			// イベント発生日（月）
-	sAppIOEventLog.u8Day     = psWirelessMsg->u8Day;			// イベント発生日（日）
-	sAppIOEventLog.u8Hour    = psWirelessMsg->u8Hour;			// イベント発生時刻（時）
-	sAppIOEventLog.u8Minute  = psWirelessMsg->u8Minute;			// イベント発生時刻（分）
-	sAppIOEventLog.u8Second  = psWirelessMsg->u8Second;			// イベント発生時刻（秒）
-	// I2C EEPROM Write
-	int iIdx = sIndexInfo.u8EventLogCnt - 1;
-	uint32 u32Size = sizeof(tsAppIOEventLog);
-	uint32 u32Addr = TOP_ADDR_EVENT_LOG + u32Size * iIdx;
-	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	if (!bEEPROM_writeData(u32Addr, u32Size, (uint8*)&sAppIOEventLog)) {
-		return -4;
-	}
 	return iIdx;
 }
 
@@ -702,30 +979,23 @@ PUBLIC int iEEPROMWriteLog(uint16 u16MsgCd, tsWirelessMsg *psWirelessMsg) {
  * PARAMETERS:           Name              RW  Usage
  *
  * RETURNS:
- *   int 1:削除成功、-1:インデックス読み込みエラー、-2:インデックス更新エラー、-3:削除エラー
+ *   int 1:削除成功、-1:ログリング復元エラー、-3:削除エラー
  *
  ****************************************************************************/
 PUBLIC int iEEPROMDeleteAllLogInfo() {
-	// インデックス情報読み込み
-	if (!bEEPROMReadIndexInfo(&sIndexInfo)) {
+	// イベントログリングの復元（未復元の場合のみ）
+	tsLogRing* psRing = psEventLogRing();
+	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	if (psRing->bValid == FALSE && !bLogRing_recover(psRing)) {
 		return -1;
 	}
-	// インデックス情報更新
-	sIndexInfo.u8EventLogCnt = 0;
-	if (!bEEPROMWriteIndexInfo(&sIndexInfo)) {
-		return -2;
+	// I2C EEPROM Write（全ブロックの消去）
+	if (!bLogRing_clear(psRing)) {
+		return -3;
 	}
-	// 空データ編集
-	uint32 u32Size = sizeof(tsAppIOEventLog);
-	tsAppIOEventLog sEventLog;
-	memset(&sEventLog, 0x00, u32Size);
-	// I2C EEPROM Write
-	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
-	uint8 u8Idx;
-	for (u8Idx = 0; u8Idx < MAX_EVT_LOG_CNT; u8Idx++) {
-		if (!bEEPROM_writeData(TOP_ADDR_EVENT_LOG + u32Size * u8Idx, u32Size, (uint8 *)&sEventLog)) {
-			return -3;
-		}
+	// キャッシュの書き戻し
+	if (!bEEPROM_commit()) {
+		return -3;
 	}
 	return 1;
 }
@@ -750,6 +1020,92 @@ PUBLIC void vEventSecond(uint32 u32EvtTimeMs) {
 	// DS3231
 	bDS3231_deviceSelect(I2C_ADDR_DS3231);
 	bDS3231_getDatetime(&sAppIO.sDatetime);
+	// 書き込みサイクルが経過したEEPROMキャッシュの書き戻し
+	bEEPROM_flushIdle();
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEventEEPROMPoll
+ *
+ * DESCRIPTION:EEPROM非同期書き込みの進行処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * イベントループ毎に未書き込みのインデックス情報を書き込み、
+ * 書き込みサイクルの完了をACKポーリングで検知して、次のページを書き込む
+ *****************************************************************************/
+PUBLIC void vEventEEPROMPoll(uint32 u32EvtTimeMs) {
+	// 未書き込みのインデックス情報をまとめて書き込む
+	bEEPROMFlushIndex();
+	// 実行中の書き込みが無い場合は何もしない
+	if (bEEPROM_asyncIsBusy() == FALSE) {
+		return;
+	}
+	eEEPROM_asyncProceed();
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEventEEPROMPrefetch
+ *
+ * DESCRIPTION:EEPROM先読み処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 画面の描画後に、次の操作で読み込まれるレコードを先読みする
+ * 要求後にI2Cバスが切り替わった場合や、非同期書き込み中の場合は先読みしない
+ *****************************************************************************/
+PUBLIC void vEventEEPROMPrefetch(uint32 u32EvtTimeMs) {
+	// 先読み要求の判定
+	teAppIOPrefetch eType = sAppIO.ePrefetchType;
+	sAppIO.ePrefetchType = E_APP_IO_PREFETCH_NONE;
+	if (eType == E_APP_IO_PREFETCH_NONE || sAppIO.u8PrefetchBus != u8I2CBus || bEEPROM_asyncIsBusy()) {
+		return;
+	}
+	// 先読み
+	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	if (eType == E_APP_IO_PREFETCH_REMOTE_DEV) {
+		bEEPROM_streamPrefetch(&sAppIO.sRemoteStream, sAppIO.u16PrefetchIdx, sAppIO.bPrefetchFwdFlg);
+	} else {
+		bLogRing_prefetch(psEventLogRing(), sAppIO.u16PrefetchIdx);
+	}
+}
+
+/*****************************************************************************
+ *
+ * NAME: vStepLatencyRecord
+ *
+ * DESCRIPTION:画面操作の応答時間の集計
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   teAppIOStepType eType          R   計測種別
+ *   uint64         u64BeginUsec    R   操作の開始時刻（マイクロ秒）
+ *
+ * RETURNS:
+ *
+ *****************************************************************************/
+PUBLIC void vStepLatencyRecord(teAppIOStepType eType, uint64 u64BeginUsec) {
+	if (eType >= E_APP_IO_STEP_TYPE_CNT) {
+		return;
+	}
+	uint32 u32Usec = (uint32)(u64TimerUtil_readUsec() - u64BeginUsec);
+	sAppIOStepStats.u32LastUsec[eType] = u32Usec;
+	if (sAppIOStepStats.u32MaxUsec[eType] < u32Usec) {
+		sAppIOStepStats.u32MaxUsec[eType] = u32Usec;
+	}
+	sAppIOStepStats.u64TotalUsec[eType] += u32Usec;
+	if (sAppIOStepStats.u16Cnt[eType] < 0xFFFF) {
+		sAppIOStepStats.u16Cnt[eType]++;
+	}
 }
 
 /****************************************************************************
@@ -794,6 +1150,8 @@ PUBLIC void vLCDInit() {
 		sLCDInfo.sLCDstate.u8Contrast = u8Contrast[0];
 		bST7032i_setContrast(sLCDInfo.sLCDstate.u8Contrast);
 	}
+	// 以降のコマンドは非同期実行（vEventLCDPollで送信）
+	bST7032i_setAsync(TRUE);
 }
 
 /*****************************************************************************
@@ -821,43 +1179,55 @@ PUBLIC void vEventLCDdrawing(uint32 u32EvtTimeMs) {
 		SERIAL_vFlush(sSerStream.u8Device);
 		return;
 	}
-	if (!bST7032i_setCursor(0, 0)) {
+	if (!bST7032i_drawRow(0, sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow])) {
 		vfPrintf(&sSerStream, "2:Err.");
 		SERIAL_vFlush(sSerStream.u8Device);
 		return;
 	}
-	if (!bST7032i_writeString(sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow])) {
+	if (!bST7032i_drawRow(1, sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow + 1])) {
 		vfPrintf(&sSerStream, "3:Err.");
 		SERIAL_vFlush(sSerStream.u8Device);
 		return;
 	}
-	if (!bST7032i_setCursor(1, 0)) {
-		vfPrintf(&sSerStream, "4:Err.");
-		SERIAL_vFlush(sSerStream.u8Device);
-		return;
-	}
-	if (!bST7032i_writeString(sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow + 1])) {
-		vfPrintf(&sSerStream, "5:Err.");
-		SERIAL_vFlush(sSerStream.u8Device);
-		return;
-	}
 	// カーソル制御情報設定
 	if (!bLCDUpdCursorCntr()) {
-		vfPrintf(&sSerStream, "6:Err.");
+		vfPrintf(&sSerStream, "4:Err.");
 		SERIAL_vFlush(sSerStream.u8Device);
 		return;
 	}
 #else
 	bST7032i_deviceSelect(&sLCDInfo.sLCDstate);
-	bST7032i_setCursor(0, 0);
-	bST7032i_writeString(sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow]);
-	bST7032i_setCursor(1, 0);
-	bST7032i_writeString(sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow + 1]);
+	bST7032i_drawRow(0, sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow]);
+	bST7032i_drawRow(1, sLCDInfo.cLCDBuff[sLCDInfo.u8CurrentDispRow + 1]);
 	// カーソル制御情報設定
 	bLCDUpdCursorCntr();
 #endif
 }
 
+/*****************************************************************************
+ *
+ * NAME: vEventLCDPoll
+ *
+ * DESCRIPTION:LCDコマンドの非同期実行の進行処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 次回コマンド実行可能時刻を過ぎたコマンドを送信する
+ * 副I2Cバスの選択中は、主I2Cバスに戻るまで送信しない
+ *****************************************************************************/
+PUBLIC void vEventLCDPoll(uint32 u32EvtTimeMs) {
+	// 実行待ちのコマンドが無い場合や副I2Cバスの選択中は何もしない
+	bST7032i_deviceSelect(&sLCDInfo.sLCDstate);
+	if (bST7032i_asyncIsBusy() == FALSE || u8I2CBus != I2C_SCHED_BUS_MAIN) {
+		return;
+	}
+	bST7032i_asyncProceed();
+}
+
 /****************************************************************************
  *
  * NAME: u8LCDTypeToByte
@@ -1411,41 +1781,167 @@ PUBLIC bool_t bWirelessRxFetch(tsRxInfo* psRxInfo) {
 	return TRUE;
 }
 
-/****************************************************************************
+/*******************************************************************************
  *
- * NAME: bWirelessTx
+ * NAME: psWirelessTxAlloc
  *
- * DESCRIPTION:無線通信によるメッセージ送信処理
+ * DESCRIPTION:送信スロットの確保
  *
- * PARAMETERS:          Name        RW  Usage
- *     uint32           u32SrcAddr  R   送信元アドレス
- *     bool_t           bEncryption R   暗号化有無
- *     uint8*           u8Data      R   送信データ
- *     uint8            u8Len       R   送信データ長
+ * PARAMETERS:          Name           RW  Usage
+ *     uint32           u32SrcAddr     R   送信元アドレス
+ *     bool_t           bEncryption    R   暗号化有無
+ *
+ * RETURNS:
+ *     tsWirelessMsg*   編集対象の電文（ゼロクリア済み）、空きスロットが無い場合はNULL
+ *
+ * NOTES:
+ * 呼び出し元は返却された電文を直接編集し、暗号化とCRC編集の後に
+ * bWirelessTxCommitで送信する事。スロットは前回確保したスロットの次から順に
+ * 確保するので、送信済みの電文は次に同じスロットを確保するまで参照できる。
+ ******************************************************************************/
+PUBLIC tsWirelessMsg* psWirelessTxAlloc(uint32 u32SrcAddr, bool_t bEncryption) {
+	// 空きスロットの探索（前回確保したスロットの次から）
+	tsTxSlot* psSlot;
+	uint8 u8Cnt;
+	uint8 u8Idx = u8TxIdx;
+	for (u8Cnt = 0; u8Cnt < TX_BUFFER_SIZE; u8Cnt++) {
+		u8Idx = (u8Idx + 1) % TX_BUFFER_SIZE;
+		if (sTxBuffer[u8Idx].eStatus == E_TX_SLOT_FREE) {
+			break;
+		}
+	}
+	if (u8Cnt >= TX_BUFFER_SIZE) {
+		return NULL;
+	}
+	u8TxIdx = u8Idx;
+	psSlot = &sTxBuffer[u8Idx];
+	psSlot->eStatus = E_TX_SLOT_BUILD;
+	// 送信パケットのヘッダ編集（フレームシーケンスは送信時に編集）
+	tsTxDataApp* psTx = &psSlot->sTx;
+	psTx->u32SrcAddr = u32SrcAddr;					// 送信元アドレス
+	psTx->u32DstAddr = TOCONET_MAC_ADDR_BROADCAST;	// 送信先アドレス（ブロードキャスト）
+	psTx->bAckReq = FALSE;							// ACK返信有無
+	psTx->u8Retry = 0;								// 再送回数（なし）
+	psTx->u16RetryDur = 0;							// 再送間隔（ミリ秒単位）
+	psTx->u16DelayMin = 4;							// 遅延送信時間（最小）
+	psTx->u16DelayMax = 16;							// 遅延送信時間（最大）
+	psTx->bSecurePacket = bEncryption;				// 暗号化設定
+	psTx->u8Cmd = TOCONET_PACKET_CMD_APP_DATA;		// パケットタイプ
+	psTx->u8Len = TX_REC_SIZE;						// 送信データ長
+	// 電文のクリア
+	memset(&psSlot->sMsg, 0x00, sizeof(tsWirelessMsg));
+	return &psSlot->sMsg;
+}
+
+/*******************************************************************************
+ *
+ * NAME: bWirelessTxCommit
+ *
+ * DESCRIPTION:送信電文の確定と送信
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          R   psWirelessTxAllocで確保した電文
  *
  * RETURNS:
  *     TRUE:送信成功
  *
- ****************************************************************************/
-PUBLIC bool_t bWirelessTx(uint32 u32SrcAddr, bool_t bEncryption, uint8* u8Data, uint8 u8Len) {
-	// 送信パケット編集
-	tsTxDataApp sTx;
-	memset(&sTx, 0x00, sizeof(tsTxDataApp));
-	sTx.u32SrcAddr = u32SrcAddr;					// 送信元アドレス
-	sTx.u32DstAddr = TOCONET_MAC_ADDR_BROADCAST;	// 送信先アドレス（ブロードキャスト）
-	sTx.u8Seq = ++u8TxSeq;							// フレームシーケンス
-	sTx.u8CbId = sTx.u8Seq;							// コールバックID（フレームシーケンス指定）
-	sTx.bAckReq = FALSE;							// ACK返信有無
-	sTx.u8Retry = 0;								// 再送回数（なし）
-	sTx.u16RetryDur = 0;							// 再送間隔（ミリ秒単位）
-	sTx.u16DelayMin = 4;							// 遅延送信時間（最小）
-	sTx.u16DelayMax = 16;							// 遅延送信時間（最大）
-	sTx.bSecurePacket = bEncryption;				// 暗号化設定
-	sTx.u8Cmd = TOCONET_PACKET_CMD_APP_DATA;		// パケットタイプ
-	sTx.u8Len = u8Len;								// 送信データ長
-	memcpy(sTx.auData, u8Data, sTx.u8Len);			// 送信データ
+ * NOTES:
+ * 電文を送信パケットのペイロードに1度だけ複写して送信要求する。
+ * スロットは送信完了（vWirelessTxComplete）まで再利用しない。
+ ******************************************************************************/
+PUBLIC bool_t bWirelessTxCommit(tsWirelessMsg* psMsg) {
+	tsTxSlot* psSlot;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < TX_BUFFER_SIZE; u8Idx++) {
+		psSlot = &sTxBuffer[u8Idx];
+		if (&psSlot->sMsg == psMsg && psSlot->eStatus == E_TX_SLOT_BUILD) {
+			break;
+		}
+	}
+	if (u8Idx >= TX_BUFFER_SIZE) {
+		return FALSE;
+	}
+	// フレームシーケンスとペイロードの編集
+	psSlot->sTx.u8Seq  = ++u8TxSeq;					// フレームシーケンス
+	psSlot->sTx.u8CbId = psSlot->sTx.u8Seq;			// コールバックID（フレームシーケンス指定）
+	memcpy(psSlot->sTx.auData, psMsg, TX_REC_SIZE);	// 送信データ
 	// 送信処理
-	return ToCoNet_bMacTxReq(&sTx);
+	if (ToCoNet_bMacTxReq(&psSlot->sTx) == FALSE) {
+		psSlot->eStatus = E_TX_SLOT_FREE;
+		return FALSE;
+	}
+	psSlot->eStatus = E_TX_SLOT_IN_FLIGHT;
+	return TRUE;
+}
+
+/*******************************************************************************
+ *
+ * NAME: vWirelessTxComplete
+ *
+ * DESCRIPTION:送信スロットの送信完了処理
+ *
+ * PARAMETERS:        Name          RW  Usage
+ *       uint8        u8CbId        R   送信パケットのコールバックID
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 再送は行わないので、送信の成否に関わらずスロットを解放する
+ ******************************************************************************/
+PUBLIC void vWirelessTxComplete(uint8 u8CbId) {
+	tsTxSlot* psSlot;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < TX_BUFFER_SIZE; u8Idx++) {
+		psSlot = &sTxBuffer[u8Idx];
+		if (psSlot->eStatus == E_TX_SLOT_IN_FLIGHT && psSlot->sTx.u8CbId == u8CbId) {
+			psSlot->eStatus = E_TX_SLOT_FREE;
+			return;
+		}
+	}
+}
+
+/*******************************************************************************
+ *
+ * NAME: vWirelessEncrypt
+ *
+ * DESCRIPTION:電文の暗号化処理（AES-CCMによる認証付き暗号）
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          RW  送信電文
+ *     uint8*           pu8Key         R   暗号鍵（256bit）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 宛先アドレス・同期乱数・コマンドをノンスとして改竄検知の対象に含め、
+ * 暗号化領域の暗号化と認証タグの生成を1回の走査で行う
+ ******************************************************************************/
+PUBLIC void vWirelessEncrypt(tsWirelessMsg* psMsg, uint8* pu8Key) {
+	tsAES_state sAES_state = vAES_newCCMState(AES_KEY_LEN_256, pu8Key);
+	vAES_encryptCCM(&sAES_state, (uint8*)psMsg, TX_NONCE_SIZE, NULL, 0,
+			&psMsg->u8AuthStCnt, TX_ENC_SIZE, psMsg->u8MIC, TX_MIC_SIZE);
+}
+
+/*******************************************************************************
+ *
+ * NAME: bWirelessDecrypt
+ *
+ * DESCRIPTION:電文の復号化処理（AES-CCMによる認証付き暗号）
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          RW  受信電文
+ *     uint8*           pu8Key         R   暗号鍵（256bit）
+ *
+ * RETURNS:
+ *     TRUE:認証タグ一致
+ *
+ * NOTES:
+ * 認証タグが一致しない場合には暗号化領域はゼロクリアされる
+ ******************************************************************************/
+PUBLIC bool_t bWirelessDecrypt(tsWirelessMsg* psMsg, uint8* pu8Key) {
+	tsAES_state sAES_state = vAES_newCCMState(AES_KEY_LEN_256, pu8Key);
+	return bAES_decryptCCM(&sAES_state, (uint8*)psMsg, TX_NONCE_SIZE, NULL, 0,
+			&psMsg->u8AuthStCnt, TX_ENC_SIZE, psMsg->u8MIC, TX_MIC_SIZE);
 }
 
 /****************************************************************************
@@ -1555,6 +2051,428 @@ PRIVATE bool_t bLCDUpdCursorCntr() {
 	return bST7032i_dispControl(TRUE, bCursorFlg, bBlinkFlg, FALSE);
 }
 
+/*****************************************************************************
+ *
+ * NAME: vI2CBusSelect
+ *
+ * DESCRIPTION:I2Cバスの切替処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8          u8Bus           R   バス番号（I2C_SCHED_BUS_MAIN/SUB）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * I2Cスケジューラから呼び出されるので、トランザクションの完了待ちはしない
+ *****************************************************************************/
+PRIVATE void vI2CBusSelect(uint8 u8Bus) {
+	vAHI_DioSetDirection(0x00, I2C_BUS_01 | I2C_BUS_02);
+	if (u8Bus == I2C_SCHED_BUS_SUB) {
+		vAHI_DioSetOutput(I2C_BUS_02, I2C_BUS_01);
+	} else {
+		vAHI_DioSetOutput(I2C_BUS_01, I2C_BUS_02);
+	}
+	u8I2CBus = u8Bus;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CBusCurrent
+ *
+ * DESCRIPTION:選択中のI2Cバスの参照処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint8          バス番号（I2C_SCHED_BUS_MAIN/SUB）
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE uint8 u8I2CBusCurrent() {
+	return u8I2CBus;
+}
+
+/*****************************************************************************
+ *
+ * NAME: u8I2CSchedRegist
+ *
+ * DESCRIPTION:I2Cスケジューラへのデバイス登録処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   char*          pcName          R   デバイス名
+ *   uint8          u8Address       R   I2Cアドレス
+ *   uint8          u8Priority      R   優先度（I2C_SCHED_PRIORITY_*）
+ *   uint8          u8Bus           R   バス番号（I2C_SCHED_BUS_MAIN/SUB）
+ *
+ * RETURNS:
+ *   uint8          デバイスインデックス、登録出来ない場合はI2C_SCHED_DEVICE_NONE
+ *
+ * NOTES:
+ * 登録出来ない場合、そのデバイスはI2Cスケジューラを経由せずに直接通信する
+ *****************************************************************************/
+PRIVATE uint8 u8I2CSchedRegist(const char* pcName, uint8 u8Address, uint8 u8Priority, uint8 u8Bus) {
+	int iDevIdx = iI2CSched_registDevice(pcName, u8Address, u8Priority, u8Bus);
+	if (iDevIdx < 0 || iDevIdx >= I2C_SCHED_DEVICE_NONE) {
+		return I2C_SCHED_DEVICE_NONE;
+	}
+	return (uint8)iDevIdx;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vI2CSchedAutotune
+ *
+ * DESCRIPTION:I2Cデバイス毎の動作周波数の自動調整
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 主I2CバスのEEPROMとRTCを、内容が変化しない領域の読み込みで検証して調整する
+ * LCDは読み込み出来ないので既定値、副I2CバスのEEPROMは着脱されるので既定値とする
+ * 調整の効果として、調整前後のEEPROMの一括読み込み速度をドライバ経由で計測する
+ *****************************************************************************/
+PRIVATE void vI2CSchedAutotune() {
+	// 調整前の一括読み込み速度
+	sAppIO.u32EEPROMRateBefore = u32EEPROMReadRate();
+	uint8 u8MemAddr[2];
+	uint8 u8ReadData[I2C_SCHED_TUNE_BUFF_SIZE];
+	tsI2CSched_Req sReq;
+	memset(&sReq, 0x00, sizeof(tsI2CSched_Req));
+	sReq.sTrns.u8PreScaler  = I2C_PRESCALER_DEFAULT;
+	sReq.sTrns.pu8WriteData = u8MemAddr;
+	sReq.sTrns.pu8ReadData  = u8ReadData;
+	sReq.sTrns.eCompEvt     = E_EVENT_FWK_EMPTY;
+	// EEPROM：デバイス情報の先頭
+	u8MemAddr[0] = 0x00;
+	u8MemAddr[1] = 0x00;
+	sReq.sTrns.u16WriteLen = 2;
+	sReq.sTrns.u16ReadLen  = I2C_SCHED_TUNE_BUFF_SIZE;
+	sReq.u8MemAddrLen      = 2;
+	u8I2CSched_autotune(sAppIO.u8SchedMainEEPROM, &sReq, I2C_PRESCALER_66KHZ);
+	// RTC：アラーム設定レジスタ（0x07～0x0D）
+	u8MemAddr[0] = 0x07;
+	sReq.sTrns.u16WriteLen = 1;
+	sReq.sTrns.u16ReadLen  = 7;
+	sReq.u8MemAddrLen      = 1;
+	u8I2CSched_autotune(sAppIO.u8SchedRTC, &sReq, I2C_PRESCALER_66KHZ);
+	// 調整後の一括読み込み速度
+	sAppIO.u32EEPROMRateAfter = u32EEPROMReadRate();
+#ifdef DEBUG
+	uint8 u8PreScaler = u8I2CSched_getPreScaler(sAppIO.u8SchedMainEEPROM);
+	vfPrintf(&sSerStream, "MS:%08d I2C Autotune EEPROM:%dHz %d->%d Byte/s\n", u32TickCount_ms,
+			(u8PreScaler == I2C_PRESCALER_DEFAULT) ? u32I2C_getFrequency() : u32I2C_toFrequency(u8PreScaler),
+			sAppIO.u32EEPROMRateBefore, sAppIO.u32EEPROMRateAfter);
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
+}
+
+/*****************************************************************************
+ *
+ * NAME: u32EEPROMReadRate
+ *
+ * DESCRIPTION:I2C EEPROMの一括読み込み速度の計測
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32         読み込み速度（Byte/s）、読み込み出来ない場合は0
+ *
+ * NOTES:
+ * キャッシュを破棄してから先頭のI2C_RATE_READ_SIZEバイトを読み込むので、
+ * 運用時と同じくドライバからI2Cスケジューラ経由で実デバイスを読み込む
+ *****************************************************************************/
+PRIVATE uint32 u32EEPROMReadRate() {
+	uint8 u8Buff[I2C_RATE_READ_SIZE];
+	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	bEEPROM_commit();
+	vEEPROM_cacheInvalidate();
+	uint64 u64Before = u64TimerUtil_readUsec();
+	if (bEEPROM_readData(0, I2C_RATE_READ_SIZE, u8Buff) == FALSE) {
+		return 0;
+	}
+	uint32 u32Usec = (uint32)(u64TimerUtil_readUsec() - u64Before);
+	if (u32Usec == 0) {
+		u32Usec = 1;
+	}
+	return (uint32)((uint64)I2C_RATE_READ_SIZE * 1000000 / u32Usec);
+}
+
+/*****************************************************************************
+ *
+ * NAME: psRemoteDevDir
+ *
+ * DESCRIPTION:選択中のI2Cバスのリモートデバイスディレクトリの参照処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsDevDir*      リモートデバイスディレクトリ
+ *
+ * NOTES:
+ * 主副のEEPROMは同一アドレスなので、選択中のバスで切り替える
+ *****************************************************************************/
+PRIVATE tsDevDir* psRemoteDevDir() {
+	if (u8I2CBus == I2C_SCHED_BUS_SUB) {
+		return &sAppIO.sSubDevDir;
+	}
+	return &sAppIO.sMainDevDir;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psEventLogRing
+ *
+ * DESCRIPTION:選択中のI2Cバスのイベントログリングの参照処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsLogRing*     イベントログリング
+ *
+ * NOTES:
+ * 主副のEEPROMは同一アドレスなので、選択中のバスで切り替える
+ *****************************************************************************/
+PRIVATE tsLogRing* psEventLogRing() {
+	if (u8I2CBus == I2C_SCHED_BUS_SUB) {
+		return &sAppIO.sSubLogRing;
+	}
+	return &sAppIO.sMainLogRing;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psEventLogQuery
+ *
+ * DESCRIPTION:選択中のI2Cバスのイベントログ検索の参照処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsLogQuery*    イベントログ検索
+ *
+ * NOTES:
+ * 主副のEEPROMは同一アドレスなので、選択中のバスで切り替える
+ *****************************************************************************/
+PRIVATE tsLogQuery* psEventLogQuery() {
+	if (u8I2CBus == I2C_SCHED_BUS_SUB) {
+		return &sAppIO.sSubLogQuery;
+	}
+	return &sAppIO.sMainLogQuery;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psKVJournal
+ *
+ * DESCRIPTION:選択中のI2Cバスのジャーナル付きキーバリューストアの参照処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsKVJournal*   ジャーナル付きキーバリューストア
+ *
+ * NOTES:
+ * 主副のEEPROMは同一アドレスなので、選択中のバスで切り替える
+ *****************************************************************************/
+PRIVATE tsKVJournal* psKVJournal() {
+	if (u8I2CBus == I2C_SCHED_BUS_SUB) {
+		return &sAppIO.sSubJournal;
+	}
+	return &sAppIO.sMainJournal;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROMSelect
+ *
+ * DESCRIPTION:EEPROMの選択とジャーナルの復元
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:選択成功
+ *
+ * NOTES:
+ * 電源断等で反映途中のジャーナルが残っている場合は、初回のアクセス時に反映する
+ *****************************************************************************/
+PRIVATE bool_t bEEPROMSelect() {
+	bEEPROM_deviceSelect(&sAppIO.sEEPROM_status);
+	tsKVJournal* psJnl = psKVJournal();
+	if (psJnl->bValid == FALSE) {
+		uint32 u32ReplayCnt = psJnl->u32ReplayCnt;
+		if (!bKVJournal_recover(psJnl)) {
+			return FALSE;
+		}
+		// ジャーナルを再反映した場合は、インデックス情報が更新された可能性があるので再読み込みする
+		if (psJnl->u32ReplayCnt != u32ReplayCnt) {
+			psIndexCache()->bValid = FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psIndexCache
+ *
+ * DESCRIPTION:選択中のI2Cバスのインデックス情報のキャッシュの参照処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsAppIOIndexCache* インデックス情報のキャッシュ
+ *
+ * NOTES:
+ * None.
+ *****************************************************************************/
+PRIVATE tsAppIOIndexCache* psIndexCache() {
+	if (u8I2CBus == I2C_SCHED_BUS_SUB) {
+		return &sAppIO.sSubIndex;
+	}
+	return &sAppIO.sMainIndex;
+}
+
+/*****************************************************************************
+ *
+ * NAME: psEEPROMLoadIndex
+ *
+ * DESCRIPTION:インデックス情報の参照処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   tsAppIOIndexInfo* キャッシュ上のインデックス情報、読み込みエラー時はNULL
+ *
+ * NOTES:
+ * 未読み込みの場合のみEEPROMから読み込み、無効なレコードは初期化して遅延書き込みする
+ * 返却したインデックス情報を直接更新した場合は、ジャーナル経由で書き込むか
+ * 未書き込みの変更ありとする事
+ *****************************************************************************/
+PRIVATE tsAppIOIndexInfo* psEEPROMLoadIndex() {
+	// EEPROMの選択とジャーナルの復元（ジャーナルの再反映時はキャッシュを破棄）
+	if (!bEEPROMSelect()) {
+		return NULL;
+	}
+	tsAppIOIndexCache* psCache = psIndexCache();
+	if (psCache->bValid) {
+		psCache->u32HitCnt++;
+		return &psCache->sInfo;
+	}
+	// I2C EEPROM Read
+	if (!bEEPROM_readData(TOP_ADDR_INDEX, sizeof(tsAppIOIndexInfo), (uint8 *)&psCache->sInfo)) {
+		return NULL;
+	}
+	psCache->u32LoadCnt++;
+	psCache->bValid = TRUE;
+	psCache->bDirty = FALSE;
+	// レコード有効チェック
+	if (psCache->sInfo.u8EnableCheck != 0xAA) {
+		// レコード初期化
+		memset(&psCache->sInfo, 0x00, sizeof(tsAppIOIndexInfo));
+		psCache->sInfo.u8EnableCheck = 0xAA;
+		psCache->bDirty = TRUE;
+	}
+	return &psCache->sInfo;
+}
+
+/*****************************************************************************
+ *
+ * NAME: bEEPROMFlushIndex
+ *
+ * DESCRIPTION:インデックス情報の遅延書き込み処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:書き込み成功（未書き込みの変更無しを含む）
+ *
+ * NOTES:
+ * 選択中のI2Cバスのキャッシュに未書き込みの変更がある場合のみジャーナル経由で書き込む
+ * 書き込みに失敗した場合は、書き込み結果が不定なので次回のアクセス時に再読み込みする
+ *****************************************************************************/
+PRIVATE bool_t bEEPROMFlushIndex() {
+	tsAppIOIndexCache* psCache = psIndexCache();
+	if (psCache->bDirty == FALSE) {
+		return TRUE;
+	}
+	psCache->bDirty = FALSE;
+	// I2C EEPROM Write（内容が変わらないページは書き込まない、ジャーナルを再反映した場合は破棄）
+	if (bEEPROMSelect() && psCache->bValid) {
+		tsKVJournal* psJnl = psKVJournal();
+		vKVJournal_begin(psJnl);
+		bKVJournal_put(psJnl, TOP_ADDR_INDEX, (uint8 *)&psCache->sInfo, sizeof(tsAppIOIndexInfo));
+		if (bKVJournal_commit(psJnl)) {
+			psCache->u32FlushCnt++;
+			return TRUE;
+		}
+	}
+	psCache->bValid = FALSE;
+	psRemoteDevDir()->bValid = FALSE;
+	return FALSE;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMPrefetchRequest
+ *
+ * DESCRIPTION:EEPROM先読み要求の登録処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   teAppIOPrefetch eType          R   先読み要求の種別
+ *   uint16         u16Idx          R   先読みするインデックス
+ *   bool_t         bForwardFlg     R   順方向探索フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 要求は最新の１件のみ保持し、先読みイベントで処理する
+ *****************************************************************************/
+PRIVATE void vEEPROMPrefetchRequest(teAppIOPrefetch eType, uint16 u16Idx, bool_t bForwardFlg) {
+	sAppIO.ePrefetchType   = eType;
+	sAppIO.u8PrefetchBus   = u8I2CBus;
+	sAppIO.u16PrefetchIdx  = u16Idx;
+	sAppIO.bPrefetchFwdFlg = bForwardFlg;
+}
+
+/*****************************************************************************
+ *
+ * NAME: vEEPROMExpandLog
+ *
+ * DESCRIPTION:イベントログ情報の展開処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   tsAppIOEventLog* psAppIOEventLog W イベントログ情報
+ *   uint32         u32Key          R   キー（基準年からの経過秒数）
+ *   uint8*         pu8LogData      R   ログデータ
+ *   uint16         u16SeqNo        R   エントリのシーケンス番号
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 時刻無効フラグが立っている場合は日時無し
+ *****************************************************************************/
+PRIVATE void vEEPROMExpandLog(tsAppIOEventLog *psAppIOEventLog, uint32 u32Key, uint8* pu8LogData, uint16 u16SeqNo) {
+	tsDate sDate;
+	tsTime sTime;
+	memset(psAppIOEventLog, 0x00, sizeof(tsAppIOEventLog));
+	psAppIOEventLog->u8SeqNo     = (uint8)u16SeqNo;							// シーケンス番号
+	psAppIOEventLog->u16MsgCd    = pu8LogData[0] & ~EVT_LOG_TIME_INVALID;	// メッセージコード
+	psAppIOEventLog->u8Command   = pu8LogData[1];							// コマンド
+	psAppIOEventLog->u8StatusMap = pu8LogData[2];							// ステータスマップ
+	if ((pu8LogData[0] & EVT_LOG_TIME_INVALID) == 0) {
+		vValUtil_secToDatetime(u32Key, &sDate, &sTime);
+		psAppIOEventLog->u16Year  = sDate.u16Year;		// イベント発生日（年）
+		psAppIOEventLog->u8Month  = sDate.u8Month;		// イベント発生日（月）
+		psAppIOEventLog->u8Day    = sDate.u8Day;		// イベント発生日（日）
+		psAppIOEventLog->u8Hour   = sTime.u8Hour;		// イベント発生時刻（時）
+		psAppIOEventLog->u8Minute = sTime.u8Minutes;	// イベント発生時刻（分）
+		psAppIOEventLog->u8Second = sTime.u8Seconds;	// イベント発生時刻（秒）
+	}
+}
+
 /****************************************************************************/
 /***        END OF FILE                                                   ***/
 /****************************************************************************/
@@ -9,6 +9,21 @@
  *
  * CHANGE HISTORY:
  * 2018/01/23 05:05:00 通信レコードレイアウトをAES暗号化に合わせて調整
+ * 2026/10/18 13:00:00 電文の暗号化をAES-CCMによる認証付き暗号に変更
+ * 2026/10/18 18:00:00 CRCチェックをCRC-16に変更（FILLER02を廃止してレコード長は維持）
+ * 2026/10/18 20:00:00 I2Cスケジューラのバス番号とデバイスインデックスを追加
+ * 2026/10/19 00:00:00 EEPROM非同期書き込みの進行処理を追加
+ * 2026/10/19 01:00:00 リモートデバイスディレクトリを追加
+ * 2026/10/19 02:00:00 イベントログリングを追加し、イベント履歴のレイアウトを12バイトに詰める
+ * 2026/10/19 03:00:00 イベント履歴をイベントログリングから展開する形式に変更
+ * 2026/10/19 04:00:00 ジャーナル付きキーバリューストアを追加
+ * 2026/10/19 05:00:00 リモートデバイス情報の先読みストリームと先読み要求、画面操作の応答時間の統計情報を追加
+ * 2026/10/19 06:00:00 イベントログ検索とその集計情報を追加
+ * 2026/10/19 08:00:00 インデックス情報をI2Cバス毎にRAM上へキャッシュし、書き込みをイベントループで遅延
+ * 2026/10/19 10:00:00 LCDコマンドの非同期実行の進行イベントを追加
+ * 2026/10/19 16:00:00 送信パケットのスロットプールを追加
+ * 2026/10/19 17:00:00 I2Cスケジューラの未登録のデバイスインデックスを明記
+ * 2026/10/19 18:00:00 動作周波数の自動調整前後のEEPROMの一括読み込み速度を追加
  *
  * LAST MODIFIED BY:
  *
@@ -32,6 +47,11 @@ extern "C" {
 #include "st7032i.h"
 #include "ds3231.h"
 #include "eeprom.h"
+#include "i2c_sched.h"
+#include "dev_dir.h"
+#include "log_ring.h"
+#include "log_query.h"
+#include "kv_journal.h"
 #include "keypad.h"
 #include "app_auth.h"
 
@@ -42,11 +62,17 @@ extern "C" {
 #define I2C_BUS_01                 (0x01 << 3)
 // I2C Bus ID:02
 #define I2C_BUS_02                 (0x01 << 2)
+// I2C Scheduler Bus No:主I2Cバス
+#define I2C_SCHED_BUS_MAIN         (0x01)
+// I2C Scheduler Bus No:副I2Cバス
+#define I2C_SCHED_BUS_SUB          (0x02)
 
 // I2C Device Type:EEPROM
 #define I2C_DEVICE_EEPROM          (0x01)
 // I2C Device Type:RTC
 #define I2C_DEVICE_RTC             (0x02)
+// I2C EEPROM Bulk Read Rate Size:一括読み込み速度の計測サイズ
+#define I2C_RATE_READ_SIZE         (256)
 
 // LCD Row Size
 #define LCD_BUFF_ROW_SIZE          (7)
@@ -58,6 +84,11 @@ extern "C" {
 	#define RX_BUFFER_SIZE         (5)
 #endif
 
+// 送信スロット数
+#ifndef TX_BUFFER_SIZE
+	#define TX_BUFFER_SIZE         (2)
+#endif
+
 // 受信タイムアウト
 #ifndef RX_TIMEOUT_S
 	#define RX_TIMEOUT_S           (1000)
@@ -70,6 +101,18 @@ extern "C" {
 // 送信レコードサイズ
 #define TX_REC_SIZE                (90)
 
+// CRC算出領域サイズ（宛先アドレス～認証タグ）
+#define TX_CRC_SIZE                (88)
+
+// 暗号化領域サイズ（認証ストレッチング回数～ステータスマップ）
+#define TX_ENC_SIZE                (75)
+
+// 認証タグサイズ
+#define TX_MIC_SIZE                (4)
+
+// ノンスサイズ（宛先アドレス、同期乱数、コマンド）
+#define TX_NONCE_SIZE              (9)
+
 /****************************************************************************/
 /***        Type Definitions                                              ***/
 /****************************************************************************/
@@ -109,6 +152,46 @@ typedef struct {
 	uint8 u8CursorPosCol;
 } tsLCDInfo;
 
+// 先読み要求の種別
+typedef enum {
+	E_APP_IO_PREFETCH_NONE = 0,				// 要求無し
+	E_APP_IO_PREFETCH_REMOTE_DEV,			// リモートデバイス情報
+	E_APP_IO_PREFETCH_EVENT_LOG				// イベントログ
+} teAppIOPrefetch;
+
+// 画面操作の応答時間の計測種別
+typedef enum {
+	E_APP_IO_STEP_REMOTE_DEV = 0,			// リモートデバイス情報の選択
+	E_APP_IO_STEP_EVENT_LOG,				// イベント履歴の表示
+	E_APP_IO_STEP_TYPE_CNT					// 計測種別の種類数
+} teAppIOStepType;
+
+// 構造体：画面操作の応答時間の統計情報
+typedef struct {
+	uint16 u16Cnt[E_APP_IO_STEP_TYPE_CNT];			// 計測種別毎の件数
+	uint32 u32LastUsec[E_APP_IO_STEP_TYPE_CNT];		// 計測種別毎の直近の応答時間（マイクロ秒）
+	uint32 u32MaxUsec[E_APP_IO_STEP_TYPE_CNT];		// 計測種別毎の応答時間の最大値（マイクロ秒）
+	uint64 u64TotalUsec[E_APP_IO_STEP_TYPE_CNT];	// 計測種別毎の応答時間の合計（マイクロ秒）
+} tsAppIOStepStats;
+
+// 構造体：インデックス情報
+typedef struct {
+	uint8 u8EnableCheck;				// 有効チェック（レコード有効時は0xAA）
+	uint32 u32RemoteDevMap;				// リモートデバイス領域マップ
+	uint8 u8EventLogCnt;				// イベント履歴数（未使用、イベントログリングで管理）
+	uint8 u8Filler[2];					// 余白
+} tsAppIOIndexInfo;
+
+// 構造体：インデックス情報のキャッシュ
+typedef struct {
+	bool_t bValid;						// 読み込み済みフラグ
+	bool_t bDirty;						// 未書き込みの変更ありフラグ
+	tsAppIOIndexInfo sInfo;				// インデックス情報
+	uint32 u32HitCnt;					// 統計情報：EEPROMを読まずに参照した回数
+	uint32 u32LoadCnt;					// 統計情報：EEPROMから読み込んだ回数
+	uint32 u32FlushCnt;					// 統計情報：遅延書き込みの回数
+} tsAppIOIndexCache;
+
 // 構造体：入出力情報
 typedef struct {
 	// 主I2Cトークンのデバイスタイプ
@@ -121,29 +204,62 @@ typedef struct {
 	tsEEPROM_status sEEPROM_status;
 	// キーパッド情報
 	tsKEYPAD_status sKEYPAD_status;
+	// I2Cスケジューラのデバイスインデックス：主I2CバスEEPROM（I2C_SCHED_DEVICE_NONE：未登録）
+	uint8 u8SchedMainEEPROM;
+	// I2Cスケジューラのデバイスインデックス：副I2CバスEEPROM（I2C_SCHED_DEVICE_NONE：未登録）
+	uint8 u8SchedSubEEPROM;
+	// I2Cスケジューラのデバイスインデックス：RTC（I2C_SCHED_DEVICE_NONE：未登録）
+	uint8 u8SchedRTC;
+	// I2Cスケジューラのデバイスインデックス：LCD（I2C_SCHED_DEVICE_NONE：未登録）
+	uint8 u8SchedLCD;
+	// 主I2CバスEEPROMの一括読み込み速度（Byte/s）：動作周波数の自動調整前
+	uint32 u32EEPROMRateBefore;
+	// 主I2CバスEEPROMの一括読み込み速度（Byte/s）：動作周波数の自動調整後
+	uint32 u32EEPROMRateAfter;
+	// リモートデバイスディレクトリ：主I2CバスEEPROM
+	tsDevDir sMainDevDir;
+	// リモートデバイスディレクトリ：副I2CバスEEPROM
+	tsDevDir sSubDevDir;
+	// イベントログリング：主I2CバスEEPROM
+	tsLogRing sMainLogRing;
+	// イベントログリング：副I2CバスEEPROM
+	tsLogRing sSubLogRing;
+	// イベントログ検索：主I2CバスEEPROM
+	tsLogQuery sMainLogQuery;
+	// イベントログ検索：副I2CバスEEPROM
+	tsLogQuery sSubLogQuery;
+	// ジャーナル付きキーバリューストア：主I2CバスEEPROM
+	tsKVJournal sMainJournal;
+	// ジャーナル付きキーバリューストア：副I2CバスEEPROM
+	tsKVJournal sSubJournal;
+	// インデックス情報のキャッシュ：主I2CバスEEPROM
+	tsAppIOIndexCache sMainIndex;
+	// インデックス情報のキャッシュ：副I2CバスEEPROM
+	tsAppIOIndexCache sSubIndex;
+	// リモートデバイス情報の先読みストリーム
+	tsEEPROM_stream sRemoteStream;
+	// 先読み要求：種別
+	teAppIOPrefetch ePrefetchType;
+	// 先読み要求：I2Cバス
+	uint8 u8PrefetchBus;
+	// 先読み要求：インデックス
+	uint16 u16PrefetchIdx;
+	// 先読み要求：順方向探索フラグ
+	bool_t bPrefetchFwdFlg;
 } tsAppIO;
 
-// 構造体：インデックス情報
-typedef struct {
-	uint8 u8EnableCheck;				// 有効チェック（レコード有効時は0xAA）
-	uint32 u32RemoteDevMap;				// リモートデバイス領域マップ
-	uint8 u8EventLogCnt;				// イベント履歴数
-	uint8 u8Filler[2];					// 余白
-} tsAppIOIndexInfo;
-
-// 構造体：イベント履歴
+// 構造体：イベント履歴（EEPROMにはイベントログリングの圧縮形式で記録）
 typedef struct {
-	uint8 u8SeqNo;						// シーケンス番号
 	uint16 u16MsgCd;					// メッセージコード
+	uint16 u16Year;						// イベント発生日（年）
+	uint8 u8SeqNo;						// シーケンス番号
 	uint8 u8Command;					// コマンド
 	uint8 u8StatusMap;					// ステータスマップ
-	uint16 u16Year;						// イベント発生日（年）
 	uint8 u8Month;						// イベント発生日（月）
 	uint8 u8Day;						// イベント発生日（日）
 	uint8 u8Hour;						// イベント発生時刻（時）
 	uint8 u8Minute;						// イベント発生時刻（分）
 	uint8 u8Second;						// イベント発生時刻（秒）
-	uint8 u8Filler[4];					// 余白
 } tsAppIOEventLog;
 
 // 構造体：無線送受信メッセージ
@@ -178,10 +294,10 @@ typedef struct {
 	uint8 u8Second;
 	// ステータスマップ
 	uint8 u8StatusMap;
-	// FILLER02
-	uint8 u8Filler02[5];
-	// CRCチェック
-	uint8 u8CRC;
+	// 認証タグ
+	uint8 u8MIC[TX_MIC_SIZE];
+	// CRCチェック（CRC-16、宛先アドレス～認証タグ）
+	uint16 u16CRC;
 } tsWirelessMsg;
 
 // 構造体：受信データ
@@ -194,6 +310,23 @@ typedef struct {
 	tsWirelessMsg sMsg;
 } tsRxInfo;
 
+// 列挙型：送信スロット状態
+typedef enum {
+	E_TX_SLOT_FREE = 0,		// 未使用
+	E_TX_SLOT_BUILD,		// 電文編集中
+	E_TX_SLOT_IN_FLIGHT		// 送信中（送信完了待ち）
+} teTxSlotStatus;
+
+// 構造体：送信スロット
+typedef struct {
+	// スロット状態
+	teTxSlotStatus eStatus;
+	// 送信パケット（ヘッダはスロット確保時、ペイロードは確定時に編集）
+	tsTxDataApp sTx;
+	// 送信電文（auDataは32bit境界に配置されないので、電文は境界を揃えて保持）
+	tsWirelessMsg sMsg;
+} tsTxSlot;
+
 // 構造体：無線通信情報
 typedef struct {
 	// 宛先アドレス
@@ -223,12 +356,12 @@ PUBLIC tsAppIO sAppIO;
 PUBLIC tsLCDInfo sLCDInfo;
 /** 無線通信暗号化設定 */
 PUBLIC tsCryptDefs sCryptDefs;
-/** インデックス情報 */
-PUBLIC tsAppIOIndexInfo sIndexInfo;
 /** イベント履歴情報 */
 PUBLIC tsAppIOEventLog sEventLog;
 /** 無線通信情報 */
 PUBLIC tsWirelessInfo sWirelessInfo;
+/** 画面操作の応答時間の統計情報 */
+PUBLIC tsAppIOStepStats sAppIOStepStats;
 
 /****************************************************************************/
 /***        Local Variables                                               ***/
@@ -276,17 +409,29 @@ PUBLIC int iEEPROMDeleteRemoteInfo(uint32 u32DeviceID);
 // EEPROM全クリア（リモートデバイス情報）
 PUBLIC int iEEPROMDeleteAllRemoteInfo();
 // EEPROM読み込み（イベントログ情報）
-PUBLIC int iEEPROMReadLog(tsAppIOEventLog *psAppIOEventLog, uint8 u8Idx);
+PUBLIC int iEEPROMReadLog(tsAppIOEventLog *psAppIOEventLog, uint8 u8Idx, bool_t bForwardFlg);
+// EEPROM検索（イベントログ情報）
+PUBLIC int iEEPROMQueryLog(tsAppIOEventLog *psAppIOEventLog, const tsLogQueryCond *psCond, uint16 u16Idx, bool_t bForwardFlg);
+// イベントログ検索用の日の算出
+PUBLIC uint16 u16EEPROMLogDay(uint16 u16Year, uint8 u8Month, uint8 u8Day);
 // EEPROM書き込み（イベントログ情報）
 PUBLIC int iEEPROMWriteLog(uint16 u16MsgCd, tsWirelessMsg *psWirelessMsg);
 // EEPROMクリア（イベントログ情報）
 PUBLIC int iEEPROMDeleteAllLogInfo();
 // イベントタスク：秒間隔イベント処理
 PUBLIC void vEventSecond(uint32 u32EvtTimeMs);
+// イベントタスク：EEPROM非同期書き込みの進行処理
+PUBLIC void vEventEEPROMPoll(uint32 u32EvtTimeMs);
+// イベントタスク：EEPROM先読み処理
+PUBLIC void vEventEEPROMPrefetch(uint32 u32EvtTimeMs);
+// 画面操作の応答時間の集計
+PUBLIC void vStepLatencyRecord(teAppIOStepType eType, uint64 u64BeginUsec);
 // LCD初期処理
 PUBLIC void vLCDInit();
 // イベントタスク：LCD描画
 PUBLIC void vEventLCDdrawing(uint32 u32EvtTimeMs);
+// イベントタスク：LCDコマンドの非同期実行の進行
+PUBLIC void vEventLCDPoll(uint32 u32EvtTimeMs);
 // LCDのカラム制御情報変換
 PUBLIC uint8 u8LCDTypeToByte(teLCDcntr eType1, teLCDcntr eType2, teLCDcntr eType3, teLCDcntr eType4);
 // LCDのカーソル移動処理
@@ -317,8 +462,16 @@ PUBLIC void vWirelessRxDisabled();
 PUBLIC bool_t bWirelessRxFetch(tsRxInfo* psRxInfo);
 // 電文の受信メソッド
 PUBLIC bool_t bWirelessRx(tsRxDataApp *psRx);
-// 電文の送信メソッド
-PUBLIC bool_t bWirelessTx(uint32 u32SrcAddr, bool_t bEncryption, uint8* u8Data, uint8 u8Len);
+// 送信スロットの確保
+PUBLIC tsWirelessMsg* psWirelessTxAlloc(uint32 u32SrcAddr, bool_t bEncryption);
+// 送信電文の確定と送信
+PUBLIC bool_t bWirelessTxCommit(tsWirelessMsg* psMsg);
+// 送信スロットの送信完了処理
+PUBLIC void vWirelessTxComplete(uint8 u8CbId);
+// 電文の暗号化処理
+PUBLIC void vWirelessEncrypt(tsWirelessMsg* psMsg, uint8* pu8Key);
+// 電文の復号化処理
+PUBLIC bool_t bWirelessDecrypt(tsWirelessMsg* psMsg, uint8* pu8Key);
 // 乱数文字列生成処理
 PUBLIC void vSetRandString(char cString[], uint8 u8Len);
 // イベントタスク：メロディ初期処理
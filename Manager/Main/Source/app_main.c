@@ -8,6 +8,12 @@
  * DESCRIPTION:アプリケーション特有のイベント処理を実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 複数ハッシュ値の並行ストレッチングイベントを追加
+ * 2026/10/18 19:00:00 I2Cの非同期処理を初期化
+ * 2026/10/19 00:00:00 EEPROM非同期書き込みの進行イベントを追加
+ * 2026/10/19 05:00:00 EEPROM先読みイベントを登録
+ * 2026/10/19 10:00:00 LCDコマンドの非同期実行の進行イベントを追加
+ * 2026/10/19 16:00:00 送信完了時に送信スロットを解放
  *
  * LAST MODIFIED BY:
  *
@@ -215,6 +221,8 @@ void cbToCoNet_vNwkEvent(teEvent eEvent, uint32 u32Arg) {
  * NOTES:
  ****************************************************************************/
 PUBLIC void cbToCoNet_vTxEvent(uint8 u8CbId, uint8 u8Status) {
+	// 送信スロットの解放
+	vWirelessTxComplete(u8CbId);
 }
 
 /****************************************************************************
@@ -278,6 +286,8 @@ PUBLIC void vEventStartup(tsEvent *psEv, teEvent eEvent, uint32 u32EvArg) {
 #endif
 	// イベント処理の登録
 	vRegistEventTask();
+	// I2Cの非同期処理の初期化（割り込み処理の登録）
+	vI2C_initAsync();
 	// 外部入出力ドライバや制御タスクの初期処理
 	vAppIOInit();
 	// アプリケーションの初期化処理
@@ -411,6 +421,10 @@ PRIVATE void vRegistEventTask() {
 	bRegisterEvtTask(E_EVENT_APP_MELODY_NG, vEventMelodyNG);
 	bRegisterEvtTask(E_EVENT_APP_PROCESS, vEventProcess);
 	bRegisterEvtTask(E_EVENT_APP_HASH_ST, vEventHashStretching);
+	bRegisterEvtTask(E_EVENT_APP_HASH_ST_MULTI, vEventHashStretchingMulti);
+	bRegisterEvtTask(E_EVENT_APP_EEPROM_POLL, vEventEEPROMPoll);
+	bRegisterEvtTask(E_EVENT_APP_EEPROM_PREFETCH, vEventEEPROMPrefetch);
+	bRegisterEvtTask(E_EVENT_APP_LCD_POLL, vEventLCDPoll);
 
 	//=========================================================================
 	// スケジュールイベント登録
@@ -419,6 +433,10 @@ PRIVATE void vRegistEventTask() {
 	iEntryScheduleEvt(E_EVENT_APP_SECOND, 1000, 16, TRUE);
 	// タスク登録：画面プロセス処理
 	iEntryScheduleEvt(E_EVENT_APP_PROCESS, 50, 32, TRUE);
+	// タスク登録：EEPROM非同期書き込みの進行
+	iEntryScheduleEvt(E_EVENT_APP_EEPROM_POLL, 1, 0, TRUE);
+	// タスク登録：LCDコマンドの非同期実行の進行
+	iEntryScheduleEvt(E_EVENT_APP_LCD_POLL, 1, 0, TRUE);
 }
 
 /****************************************************************************/
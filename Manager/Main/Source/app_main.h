@@ -8,6 +8,10 @@
  * DESCRIPTION:アプリケーション特有の基本的な処理を実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 複数ハッシュ値の並行ストレッチングイベントを追加
+ * 2026/10/19 00:00:00 EEPROM非同期書き込みの進行イベントを追加
+ * 2026/10/19 05:00:00 EEPROM先読みイベントを追加
+ * 2026/10/19 10:00:00 LCDコマンドの非同期実行の進行イベントを追加
  *
  * LAST MODIFIED BY:
  *
@@ -46,7 +50,11 @@ typedef enum {
 	E_EVENT_APP_MELODY_NG,
 	E_EVENT_APP_PROCESS,
 	E_EVENT_APP_HASH_ST,
-	E_EVENT_APP_RX_MSG_CHK
+	E_EVENT_APP_HASH_ST_MULTI,
+	E_EVENT_APP_RX_MSG_CHK,
+	E_EVENT_APP_EEPROM_POLL,
+	E_EVENT_APP_EEPROM_PREFETCH,
+	E_EVENT_APP_LCD_POLL
 } teAppEvent;
 
 /****************************************************************************/
@@ -9,6 +9,14 @@
  *
  * CHANGE HISTORY:
  * 2018/01/27 23:19:00 認証時の通信データをAES暗号化
+ * 2026/10/18 12:00:00 リモートデバイス情報の同期時にハッシュ値を並行生成
+ * 2026/10/18 13:00:00 電文をAES-CCMで暗号化し、改竄された電文は復号化直後に破棄
+ * 2026/10/18 18:00:00 電文のCRCチェックをテーブル参照のCRC-16に変更
+ * 2026/10/19 03:00:00 イベント履歴の表示で空きエントリを読み飛ばす様に変更
+ * 2026/10/19 05:00:00 リモートデバイス情報の選択とイベント履歴の表示で、描画後の先読みと応答時間の計測を追加
+ * 2026/10/19 06:00:00 イベント履歴に警報、当日、直近の表示と日単位の移動を追加
+ * 2026/10/19 15:00:00 CRC-16の編集箇所のコメントを修正
+ * 2026/10/19 16:00:00 送信電文を送信スロット内で直接編集
  *
  * LAST MODIFIED BY:
  *
@@ -38,7 +46,6 @@
 #include "ToCoNet_use_mod.h"
 #include "ToCoNet.h"
 #include "ToCoNet_mod_prototype.h"
-#include "ccitt8.h"
 
 /******************************************************************************/
 /***        User Include files                                              ***/
@@ -46,9 +53,11 @@
 #include "config.h"
 #include "config_default.h"
 #include "framework.h"
+#include "timer_util.h"
 #include "io_util.h"
 #include "aes.h"
 #include "sha256.h"
+#include "crc.h"
 #include "value_util.h"
 #include "app_process.h"
 #include "app_io.h"
@@ -58,6 +67,12 @@
 /******************************************************************************/
 /***        Macro Definitions                                               ***/
 /******************************************************************************/
+// イベント履歴の警報表示の対象（ステータス異常、センサー異常、改竄検知）
+#define APP_LOG_ALARM_MAP \
+	(LOG_QUERY_CLASS_BIT(E_MSG_CD_RX_STS_ERR) | LOG_QUERY_CLASS_BIT(E_MSG_CD_RX_MIC_ERR) | \
+	 LOG_QUERY_CLASS_BIT(E_MSG_CD_TEMPERATURE_SENS_ERR) | LOG_QUERY_CLASS_BIT(E_MSG_CD_SERVO_ERR) | \
+	 LOG_QUERY_CLASS_BIT(E_MSG_CD_OPEN_SENS_ERR) | LOG_QUERY_CLASS_BIT(E_MSG_CD_BUTTON_ERR) | \
+	 LOG_QUERY_CLASS_BIT(E_MSG_CD_IR_SENS_ERR))
 
 /******************************************************************************/
 /***        Type Definitions                                                ***/
@@ -84,12 +99,21 @@ typedef struct {
 	char cDispMsg[3][17];						// メッセージ
 } tsAppScrParam;
 
+// 構造体：イベント履歴の表示条件
+typedef struct {
+	tsLogQueryCond sCond;						// 検索条件
+	bool_t bQueryFlg;							// 検索条件による表示（FALSE:全件を循環して表示）
+	bool_t bNewestFlg;							// 最新のログから表示
+	uint8 u8Limit;								// 表示件数の上限（0:無制限）
+} tsAppLogFilter;
+
 // 構造体：送受信トランザクション情報
 typedef struct {
 	uint32 u32RefMin;							// 基準時刻
 	uint32 u32OneTimeVal;						// ワンタイム乱数
 	uint8 u8OneTimeTkn[APP_AUTH_TOKEN_SIZE];	// ワンタイムトークン
-	tsWirelessMsg sWlsMsg;						// 送受信メッセージ
+	tsWirelessMsg sWlsMsg;						// 受信メッセージ
+	tsWirelessMsg* psTxMsg;						// 送信メッセージ（送信スロット内の電文）
 } tsAppTxRxTrnsInfo;
 
 /******************************************************************************/
@@ -105,6 +129,10 @@ PRIVATE void vProc_Next(teAppProcess eAppProcess);
 PRIVATE void vProc_SetMessage(char *pcMsg1, char *pcMsg2);
 // リモートデバイス選択画面への遷移パラメータ設定
 PRIVATE void vProc_SetSelectRemoteDev(teAppProcess eProcIdOk);
+// イベント履歴表示画面への遷移パラメータ設定
+PRIVATE void vProc_SetDispEventLog(uint16 u16Day, uint32 u32ClassMap, uint8 u8Limit);
+// イベント履歴の日単位の移動
+PRIVATE int iProc_JumpEventLogDay(int iIdx, bool_t bForwardFlg);
 // トークン入力画面への遷移パラメータ設定
 PRIVATE void vProc_SetInputToken(teAppProcess eProcIdOk, teAppProcess eProcIdCancel, bool_t bPrevFlg);
 // 受信メッセージ基本チェック
@@ -119,8 +147,12 @@ PUBLIC tsAppInfo sAppInfo;
 PUBLIC tsAppProcessInfo sProcessInfoList[PROCESS_LAYER_SIZE];
 /** 画面遷移用のパラメータ */
 PUBLIC tsAppScrParam sAppScrParam;
+/** イベント履歴の表示条件 */
+PUBLIC tsAppLogFilter sAppLogFilter;
 /** ハッシュ値生成情報 */
 PUBLIC tsAuthHashGenState sHashGenInfo;
+/** ハッシュ値生成情報（並行生成用） */
+PUBLIC tsAuthHashGenState sHashGenMulti[APP_HASH_MULTI_SIZE];
 /** デバイス情報 */
 PUBLIC tsAuthDeviceInfo sDevInfo;
 /** デバイス情報（編集用） */
@@ -2389,48 +2421,35 @@ PUBLIC void vProc_Synchronizing(tsAppProcessInfo *psProcInfo) {
 		//----------------------------------------------------------------------
 		// ハッシュ生成情報
 		u16StCnt = sRemoteInfoSub.u8SndStretching + sRemoteInfoMain.u8RcvStretching + STRETCHING_CNT_BASE;
-		sHashGenInfo = sAuth_generateHashInfo(sRemoteInfoMain.u8AuthCode, u16StCnt);
-		vAuth_setSyncToken(&sHashGenInfo, sRemoteInfoMain.u8SyncToken);
-		// ハッシュ化処理をバックグラウンドプロセスとして起動
-		iEntrySeqEvt(E_EVENT_APP_HASH_ST);
-		// 処理待ちに移行
-		psProcInfo->u32Param_0++;
-		return;
-	case 3:
-		// 副→主のハッシュ値生成処理の完了判定
-		if (sHashGenInfo.eStatus == E_AUTH_HASH_PROC_COMPLETE) {
-			psProcInfo->u32Param_0++;
-		}
-		return;
-	case 4:
-		//----------------------------------------------------------------------
-		// 副→主に送信時のハッシュ値編集
-		//----------------------------------------------------------------------
-		memcpy(sRemoteInfoSub.u8AuthHash, sHashGenInfo.u8HashCode, APP_AUTH_TOKEN_SIZE);
+		sHashGenMulti[APP_HASH_MULTI_IDX_SUB] = sAuth_generateHashInfo(sRemoteInfoMain.u8AuthCode, u16StCnt);
+		vAuth_setSyncToken(&sHashGenMulti[APP_HASH_MULTI_IDX_SUB], sRemoteInfoMain.u8SyncToken);
 		//----------------------------------------------------------------------
 		// 主→副に送信時のハッシュ値生成
 		//----------------------------------------------------------------------
 		// ハッシュ生成情報
 		u16StCnt = sRemoteInfoMain.u8SndStretching + sRemoteInfoSub.u8RcvStretching + STRETCHING_CNT_BASE;
-		sHashGenInfo = sAuth_generateHashInfo(sRemoteInfoSub.u8AuthCode, u16StCnt);
-		vAuth_setSyncToken(&sHashGenInfo, sRemoteInfoSub.u8SyncToken);
-		// ハッシュ化処理をバックグラウンドプロセスとして起動
-		iEntrySeqEvt(E_EVENT_APP_HASH_ST);
-		// ハッシュ生成
+		sHashGenMulti[APP_HASH_MULTI_IDX_MAIN] = sAuth_generateHashInfo(sRemoteInfoSub.u8AuthCode, u16StCnt);
+		vAuth_setSyncToken(&sHashGenMulti[APP_HASH_MULTI_IDX_MAIN], sRemoteInfoSub.u8SyncToken);
+		// 両方のハッシュ化処理を１つのバックグラウンドプロセスとして起動
+		iEntrySeqEvt(E_EVENT_APP_HASH_ST_MULTI);
+		// 処理待ちに移行
 		psProcInfo->u32Param_0++;
 		return;
-	case 5:
-		// 主→副のハッシュ値生成完了判定
-		if (sHashGenInfo.eStatus == E_AUTH_HASH_PROC_COMPLETE) {
+	case 3:
+		// 副→主と主→副のハッシュ値生成処理の完了判定
+		if (sHashGenMulti[APP_HASH_MULTI_IDX_SUB].eStatus == E_AUTH_HASH_PROC_COMPLETE &&
+				sHashGenMulti[APP_HASH_MULTI_IDX_MAIN].eStatus == E_AUTH_HASH_PROC_COMPLETE) {
 			psProcInfo->u32Param_0++;
 		}
 		return;
-	case 6:
+	case 4:
 		//----------------------------------------------------------------------
-		// 主→副に送信時のハッシュ値編集
+		// 副→主と主→副に送信時のハッシュ値編集
 		//----------------------------------------------------------------------
 		// ハッシュ値
-		memcpy(sRemoteInfoMain.u8AuthHash, sHashGenInfo.u8HashCode, APP_AUTH_TOKEN_SIZE);
+		memcpy(sRemoteInfoSub.u8AuthHash, sHashGenMulti[APP_HASH_MULTI_IDX_SUB].u8HashCode, APP_AUTH_TOKEN_SIZE);
+		memcpy(sRemoteInfoMain.u8AuthHash, sHashGenMulti[APP_HASH_MULTI_IDX_MAIN].u8HashCode, APP_AUTH_TOKEN_SIZE);
+		memset(sHashGenMulti, 0x00, sizeof(sHashGenMulti));
 
 		//----------------------------------------------------------------------
 		// 利用開始日時の編集
@@ -2713,9 +2732,9 @@ PUBLIC void vProc_EventLogMenu(tsAppProcessInfo *psProcInfo) {
 		for (u8Col = 0; u8Col < 4; u8Col++) {
 			sLCDInfo.u8LCDCntr[0][u8Col] = u8CntrDisp;
 			sLCDInfo.u8LCDCntr[1][u8Col] = u8CntrDisp;
-			sLCDInfo.u8LCDCntr[2][u8Col] = u8CntrNone;
-			sLCDInfo.u8LCDCntr[3][u8Col] = u8CntrNone;
-			sLCDInfo.u8LCDCntr[4][u8Col] = u8CntrNone;
+			sLCDInfo.u8LCDCntr[2][u8Col] = u8CntrDisp;
+			sLCDInfo.u8LCDCntr[3][u8Col] = u8CntrDisp;
+			sLCDInfo.u8LCDCntr[4][u8Col] = u8CntrDisp;
 			sLCDInfo.u8LCDCntr[5][u8Col] = u8CntrNone;
 			sLCDInfo.u8LCDCntr[6][u8Col] = u8CntrNone;
 			u8CntrDisp = u8CntrNone;
@@ -2734,16 +2753,33 @@ PUBLIC void vProc_EventLogMenu(tsAppProcessInfo *psProcInfo) {
 	// メニュー選択
 	if (u8Key == '*') {
 		// 画面遷移先判定
-		teAppProcess eAppProcess = E_PROCESS_MAIN_MENU;
+		uint16 u16Today;
 		switch (psProcInfo->u8CursorPosRow) {
 			case 0:
-				eAppProcess = E_PROCESS_DISPLAY_LOG;
+				// 全件表示
+				vProc_SetDispEventLog(LOG_QUERY_DAY_NONE, LOG_QUERY_CLASS_ALL, 0);
 				break;
 			case 1:
-				eAppProcess = E_PROCESS_LOG_CLEAR;
+				// 警報表示
+				vProc_SetDispEventLog(LOG_QUERY_DAY_NONE, APP_LOG_ALARM_MAP, 0);
+				break;
+			case 2:
+				// 当日表示
+				u16Today = u16EEPROMLogDay(sAppIO.sDatetime.u16Year, sAppIO.sDatetime.u8Month, sAppIO.sDatetime.u8Day);
+				if (u16Today == LOG_QUERY_DAY_NONE) {
+					vProc_SetMessage("Date Time Err!!!", "Event Log       ");
+					return;
+				}
+				vProc_SetDispEventLog(u16Today, LOG_QUERY_CLASS_ALL, 0);
+				break;
+			case 3:
+				// 直近表示
+				vProc_SetDispEventLog(LOG_QUERY_DAY_NONE, LOG_QUERY_CLASS_ALL, EVT_LOG_LAST_CNT);
+				break;
+			default:
+				vProc_Next(E_PROCESS_LOG_CLEAR);
 				break;
 		}
-		vProc_Next(eAppProcess);
 		return;
 	}
 	if (u8Key == '#') {
@@ -2762,7 +2798,10 @@ PUBLIC void vProc_EventLogMenu(tsAppProcessInfo *psProcInfo) {
 	//==========================================================================
 	// 画面情報設定
 	sprintf(sLCDInfo.cLCDBuff[0], "1:Display Log   ");
-	sprintf(sLCDInfo.cLCDBuff[1], "2:Log Clear     ");
+	sprintf(sLCDInfo.cLCDBuff[1], "2:Alarm Log     ");
+	sprintf(sLCDInfo.cLCDBuff[2], "3:Today's Log   ");
+	sprintf(sLCDInfo.cLCDBuff[3], "4:Last %2d Logs  ", EVT_LOG_LAST_CNT);
+	sprintf(sLCDInfo.cLCDBuff[4], "5:Log Clear     ");
 	// LCD描画イベント
 	iEntrySeqEvt(E_EVENT_APP_LCD_DRAWING);
 }
@@ -2787,8 +2826,16 @@ PUBLIC void vProc_DispEventLog(tsAppProcessInfo *psProcInfo) {
 	if (psProcInfo->eProcStatus != E_PROCESS_STATE_RUNNING) {
 		// 初期化判定
 		if (psProcInfo->eProcStatus == E_PROCESS_STATE_BEGIN) {
-			psProcInfo->u32Param_0 = 0;
-			int iIdx = iEEPROMReadLog(&sEventLog, psProcInfo->u32Param_0);
+			int iIdx;
+			if (sAppLogFilter.bNewestFlg) {
+				// 検索条件に一致する最新のログから表示
+				iIdx = iEEPROMQueryLog(&sEventLog, &sAppLogFilter.sCond, MAX_EVT_LOG_CNT, FALSE);
+			} else if (sAppLogFilter.bQueryFlg) {
+				// 検索条件に一致する最も古いログから表示
+				iIdx = iEEPROMQueryLog(&sEventLog, &sAppLogFilter.sCond, 0, TRUE);
+			} else {
+				iIdx = iEEPROMReadLog(&sEventLog, 0, TRUE);
+			}
 			if (iIdx < 0) {
 				if (iIdx == -2) {
 					vProc_SetMessage("Log Not Found!!!", "Event Log       ");
@@ -2797,6 +2844,8 @@ PUBLIC void vProc_DispEventLog(tsAppProcessInfo *psProcInfo) {
 				}
 				return;
 			}
+			psProcInfo->u32Param_0 = iIdx;
+			psProcInfo->u32Param_1 = 0;		// 最新のログから遡った件数
 			// カーソル位置初期化
 			sLCDInfo.u8CurrentDispRow    = 0;	// 表示位置
 			psProcInfo->u8CursorPosRow   = 0;	// カーソル位置（行）
@@ -2830,21 +2879,45 @@ PUBLIC void vProc_DispEventLog(tsAppProcessInfo *psProcInfo) {
 		vProc_Prev();
 		return;
 	}
-	int iIdx = 0;
-	if (u8Key == '2' || u8Key == '3') {
-		// 直前のイベントログの読み込み
-		psProcInfo->u32Param_0 = (psProcInfo->u32Param_0 + MAX_EVT_LOG_CNT - 1) % MAX_EVT_LOG_CNT;
-		iIdx = iEEPROMReadLog(&sEventLog, psProcInfo->u32Param_0);
+	uint64 u64BeginUsec = u64TimerUtil_readUsec();
+	int iIdx = psProcInfo->u32Param_0;
+	int iResult = iIdx;
+	if (sAppLogFilter.bQueryFlg) {
+		// 検索条件に一致するイベントログの読み込み（末尾と先頭は循環しない）
+		if ((u8Key == '2' || u8Key == '3') && iIdx > 0 &&
+			(sAppLogFilter.u8Limit == 0 || psProcInfo->u32Param_1 + 1 < sAppLogFilter.u8Limit)) {
+			iResult = iEEPROMQueryLog(&sEventLog, &sAppLogFilter.sCond, iIdx - 1, FALSE);
+			if (iResult >= 0) {
+				psProcInfo->u32Param_1++;
+			}
+		} else if (u8Key == '8' || u8Key == '9') {
+			iResult = iEEPROMQueryLog(&sEventLog, &sAppLogFilter.sCond, iIdx + 1, TRUE);
+			if (iResult >= 0 && psProcInfo->u32Param_1 > 0) {
+				psProcInfo->u32Param_1--;
+			}
+		}
+	} else if (u8Key == '2' || u8Key == '3') {
+		// 直前のイベントログの読み込み（空きエントリは読み飛ばす）
+		iResult = (iIdx + MAX_EVT_LOG_CNT - 1) % MAX_EVT_LOG_CNT;
+		iResult = iEEPROMReadLog(&sEventLog, iResult, FALSE);
 	} else if (u8Key == '8' || u8Key == '9') {
-		// 次のイベントログの読み込み
-		psProcInfo->u32Param_0 = (psProcInfo->u32Param_0 + 1) % MAX_EVT_LOG_CNT;
-		iIdx = iEEPROMReadLog(&sEventLog, psProcInfo->u32Param_0);
+		// 次のイベントログの読み込み（空きエントリは読み飛ばす）
+		iResult = (iIdx + 1) % MAX_EVT_LOG_CNT;
+		iResult = iEEPROMReadLog(&sEventLog, iResult, TRUE);
+	} else if (u8Key == '4' || u8Key == '6') {
+		// 前日／翌日の最初のイベントログへ移動
+		iResult = iProc_JumpEventLogDay(iIdx, (u8Key == '6'));
+	}
+	// 対象データなしの場合は表示中のイベントログのまま
+	if (iResult != -2) {
+		iIdx = iResult;
 	}
 	if (iIdx < 0) {
 		// エラーメッセージを表示してイベントログメニューへ戻る
 		vProc_SetMessage("I2C Access Err!!", "Event Log       ");
 		return;
 	}
+	psProcInfo->u32Param_0 = iIdx;
 
 	//==========================================================================
 	// 画面編集
@@ -2854,12 +2927,20 @@ PUBLIC void vProc_DispEventLog(tsAppProcessInfo *psProcInfo) {
 	sprintf(sLCDInfo.cLCDBuff[1], "%04d%02d%02d %02d%02d%02d ",
 			sEventLog.u16Year, sEventLog.u8Month, sEventLog.u8Day,
 			sEventLog.u8Hour, sEventLog.u8Minute, sEventLog.u8Second);
+	// 応答時間の集計
+	vStepLatencyRecord(E_APP_IO_STEP_EVENT_LOG, u64BeginUsec);
+#ifdef DEBUG
+	vfPrintf(&sSerStream, "vProc_DispEventLog Step:%dus\n", (int)sAppIOStepStats.u32LastUsec[E_APP_IO_STEP_EVENT_LOG]);
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
 
 	//==========================================================================
 	// LCD描画
 	//==========================================================================
 	// LCD描画イベント
 	iEntrySeqEvt(E_EVENT_APP_LCD_DRAWING);
+	// 次のイベントログの先読みイベント（描画後に実行）
+	iEntrySeqEvt(E_EVENT_APP_EEPROM_PREFETCH);
 }
 
 /*******************************************************************************
@@ -3096,6 +3177,7 @@ PUBLIC void vProc_ExecCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 	// ステータス問合せ処理
 	//==========================================================================
 	tsWirelessMsg* psWlsMsg = &sTxRxTrnsInfo.sWlsMsg;
+	tsWirelessMsg* psTxMsg  = sTxRxTrnsInfo.psTxMsg;
 	tsRxInfo sRxInfo;
 	switch (psProcInfo->u32Param_0) {
 	case 0:
@@ -3111,18 +3193,23 @@ PUBLIC void vProc_ExecCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 		//----------------------------------------------------------------------
 		// 自デバイス情報読み込み
 		bEEPROMReadDevInfo(&sDevInfo);
-		// 電文送信
-		memset(psWlsMsg, 0x00, sizeof(tsWirelessMsg));
+		// 送信スロットの確保（電文はスロット内で直接編集）
+		psTxMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+		if (psTxMsg == NULL) {
+			vProc_SetMessage("Command Exec Err", "Transmition     ");
+			return;
+		}
+		sTxRxTrnsInfo.psTxMsg = psTxMsg;
 		// 宛先アドレス
-		psWlsMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;
+		psTxMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;
 		// ステータス要求
-		psWlsMsg->u8Command = eCmd;
-		// CRC8編集
-		psWlsMsg->u8CRC = u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE);
+		psTxMsg->u8Command = eCmd;
+		// CRC16編集
+		psTxMsg->u16CRC = u16CRC16_calc((uint8*)psTxMsg, TX_CRC_SIZE);
 		// 送信
-		if (bWirelessTx(sDevInfo.u32DeviceID, FALSE, (uint8*)psWlsMsg, TX_REC_SIZE) == FALSE) {
+		if (bWirelessTxCommit(psTxMsg) == FALSE) {
 			vProc_SetMessage("Command Exec Err", "Transmition     ");
-			iEEPROMWriteLog(E_MSG_CD_TX_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_TX_ERR, psTxMsg);
 			return;
 		}
 		// 受信待ち設定
@@ -3139,7 +3226,7 @@ PUBLIC void vProc_ExecCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 		// タイムアウト判定
 		if (psProcInfo->u32Param_1 <= u32TickCount_ms) {
 			vProc_SetMessage("Command Exec Err", "Response Timeout");
-			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psTxMsg);
 			return;
 		}
 		// 受信バッファチェック
@@ -3242,7 +3329,7 @@ PUBLIC void vProc_ExecAuthCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 	uint16 u16StCnt;	// ストレッチング回数
 	tsWirelessMsg* psWlsMsg;
 	psWlsMsg = &sTxRxTrnsInfo.sWlsMsg;
-	tsAES_state sAES_state;
+	tsWirelessMsg* psTxMsg = sTxRxTrnsInfo.psTxMsg;
 	tsRxInfo sRxInfo;	// 受信データ情報
 	switch (psProcInfo->u32Param_0) {
 	case 0:
@@ -3251,16 +3338,21 @@ PUBLIC void vProc_ExecAuthCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 		//----------------------------------------------------------------------
 		// 自デバイス情報読み込み
 		bEEPROMReadDevInfo(&sDevInfo);
-		// 電文の編集と送信
-		memset(psWlsMsg, 0x00, sizeof(tsWirelessMsg));
-		psWlsMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;
-		psWlsMsg->u8Command = E_APP_CMD_CHK_STATUS;
-		// CRC8編集
-		psWlsMsg->u8CRC = u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE);
+		// 送信スロットの確保（電文はスロット内で直接編集）
+		psTxMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+		if (psTxMsg == NULL) {
+			vProc_SetMessage("Command Exec Err", "Transmition     ");
+			return;
+		}
+		sTxRxTrnsInfo.psTxMsg = psTxMsg;
+		psTxMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;
+		psTxMsg->u8Command = E_APP_CMD_CHK_STATUS;
+		// CRC16編集
+		psTxMsg->u16CRC = u16CRC16_calc((uint8*)psTxMsg, TX_CRC_SIZE);
 		// 送信
-		if (bWirelessTx(sDevInfo.u32DeviceID, FALSE, (uint8*)psWlsMsg, TX_REC_SIZE) == FALSE) {
+		if (bWirelessTxCommit(psTxMsg) == FALSE) {
 			vProc_SetMessage("Command Exec Err", "Transmition     ");
-			iEEPROMWriteLog(E_MSG_CD_TX_AUTH_CMD_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_TX_AUTH_CMD_ERR, psTxMsg);
 			return;
 		}
 		// 受信待ち設定
@@ -3279,7 +3371,7 @@ PUBLIC void vProc_ExecAuthCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 			vProc_SetMessage("Command Exec Err", "Response Timeout");
 			// 受信無効化
 			vWirelessRxDisabled();
-			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psTxMsg);
 			return;
 		}
 		// 受信バッファチェック
@@ -3364,24 +3456,28 @@ PUBLIC void vProc_ExecAuthCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 		//----------------------------------------------------------------------
 		// 認証要求コマンド送信処理
 		//----------------------------------------------------------------------
-		// 電文編集
-		memset(psWlsMsg, 0x00, sizeof(tsWirelessMsg));
-		psWlsMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;		// 宛先アドレス
-		psWlsMsg->u8Command  = eCmd;							// コマンド
-		psWlsMsg->u32SyncVal = sTxRxTrnsInfo.u32OneTimeVal;		// ワンタイム乱数
+		// 送信スロットの確保（電文はスロット内で直接編集）
+		psTxMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+		if (psTxMsg == NULL) {
+			vProc_SetMessage("Command Exec Err", "Transmition     ");
+			return;
+		}
+		sTxRxTrnsInfo.psTxMsg = psTxMsg;
+		psTxMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;		// 宛先アドレス
+		psTxMsg->u8Command  = eCmd;							// コマンド
+		psTxMsg->u32SyncVal = sTxRxTrnsInfo.u32OneTimeVal;		// ワンタイム乱数
 		// ストレッチング回数
-		psWlsMsg->u8AuthStCnt = sRemoteInfoMain.u8SndStretching;
+		psTxMsg->u8AuthStCnt = sRemoteInfoMain.u8SndStretching;
 		// 認証トークンに認証ハッシュを編集
-		memcpy(psWlsMsg->u8AuthToken, sRemoteInfoMain.u8AuthHash, APP_AUTH_TOKEN_SIZE);
+		memcpy(psTxMsg->u8AuthToken, sRemoteInfoMain.u8AuthHash, APP_AUTH_TOKEN_SIZE);
 		// 暗号化領域の暗号化
-		sAES_state = vAES_newCBCState(AES_KEY_LEN_256, sTxRxTrnsInfo.u8OneTimeTkn, sTxRxTrnsInfo.u8OneTimeTkn);
-		vAES_encrypt(&sAES_state, &psWlsMsg->u8AuthStCnt, 80);
-		// CRC8編集
-		psWlsMsg->u8CRC = u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE);
+		vWirelessEncrypt(psTxMsg, sTxRxTrnsInfo.u8OneTimeTkn);
+		// CRC16編集
+		psTxMsg->u16CRC = u16CRC16_calc((uint8*)psTxMsg, TX_CRC_SIZE);
 		// 送信
-		if (bWirelessTx(sDevInfo.u32DeviceID, FALSE, (uint8*)psWlsMsg, TX_REC_SIZE) == FALSE) {
+		if (bWirelessTxCommit(psTxMsg) == FALSE) {
 			vProc_SetMessage("Command Exec Err", "Transmition     ");
-			iEEPROMWriteLog(E_MSG_CD_TX_AUTH_CMD_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_TX_AUTH_CMD_ERR, psTxMsg);
 			return;
 		}
 		// 受信待ち設定
@@ -3401,7 +3497,7 @@ PUBLIC void vProc_ExecAuthCmd(tsAppProcessInfo *psProcInfo, teAppCommand eCmd) {
 			vWirelessRxDisabled();
 			// エラーメッセージ表示
 			vProc_SetMessage("Command Exec Err", "Response Timeout");
-			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psTxMsg);
 			return;
 		}
 		// 受信バッファチェック
@@ -3579,6 +3675,7 @@ PUBLIC void vProc_ExecMstCmd_02(tsAppProcessInfo *psProcInfo, teAppCommand eCmd)
 	// ステータス問合せ処理
 	//==========================================================================
 	tsWirelessMsg* psWlsMsg = &sTxRxTrnsInfo.sWlsMsg;
+	tsWirelessMsg* psTxMsg  = sTxRxTrnsInfo.psTxMsg;
 	tsRxInfo sRxInfo;	// 受信データ情報
 	switch (psProcInfo->u32Param_0) {
 	case 0:
@@ -3587,19 +3684,24 @@ PUBLIC void vProc_ExecMstCmd_02(tsAppProcessInfo *psProcInfo, teAppCommand eCmd)
 		//----------------------------------------------------------------------
 		// 自デバイス情報読み込み
 		bEEPROMReadDevInfo(&sDevInfo);
-		// 電文編集
-		memset(psWlsMsg, 0x00, sizeof(tsWirelessMsg));
-		psWlsMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;	// 宛先アドレス
-		psWlsMsg->u8Command  = eCmd;						// コマンド
+		// 送信スロットの確保（電文はスロット内で直接編集）
+		psTxMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+		if (psTxMsg == NULL) {
+			vProc_SetMessage("Command Exec Err", "Transmition     ");
+			return;
+		}
+		sTxRxTrnsInfo.psTxMsg = psTxMsg;
+		psTxMsg->u32DstAddr = sRemoteInfoMain.u32DeviceID;	// 宛先アドレス
+		psTxMsg->u8Command  = eCmd;						// コマンド
 		// 認証コード
-		memcpy(&psWlsMsg->u8AuthToken[0], sAppScrParam.cDispMsg[1], 16);
-		memcpy(&psWlsMsg->u8AuthToken[16], sAppScrParam.cDispMsg[2], 16);
-		// CRC8編集
-		psWlsMsg->u8CRC = u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE);
+		memcpy(&psTxMsg->u8AuthToken[0], sAppScrParam.cDispMsg[1], 16);
+		memcpy(&psTxMsg->u8AuthToken[16], sAppScrParam.cDispMsg[2], 16);
+		// CRC16編集
+		psTxMsg->u16CRC = u16CRC16_calc((uint8*)psTxMsg, TX_CRC_SIZE);
 		// 送信
-		if (bWirelessTx(sDevInfo.u32DeviceID, FALSE, (uint8*)psWlsMsg, TX_REC_SIZE) == FALSE) {
+		if (bWirelessTxCommit(psTxMsg) == FALSE) {
 			vProc_SetMessage("Command Exec Err", "Transmition     ");
-			iEEPROMWriteLog(E_MSG_CD_TX_MST_CMD_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_TX_MST_CMD_ERR, psTxMsg);
 			return;
 		}
 		// 受信待ち設定
@@ -3619,7 +3721,7 @@ PUBLIC void vProc_ExecMstCmd_02(tsAppProcessInfo *psProcInfo, teAppCommand eCmd)
 			vWirelessRxDisabled();
 			// エラーメッセージ表示
 			vProc_SetMessage("Command Exec Err", "Response Timeout");
-			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psWlsMsg);
+			iEEPROMWriteLog(E_MSG_CD_RX_TIMEOUT_ERR, psTxMsg);
 			return;
 		}
 		// 受信バッファチェック
@@ -3872,6 +3974,7 @@ PUBLIC void vProc_SelectRemoteDev(tsAppProcessInfo *psProcInfo) {
 		return;
 	}
 	// リモートデバイスの選択処理
+	uint64 u64BeginUsec = u64TimerUtil_readUsec();
 	int iIdx = psProcInfo->u32Param_0;
 	if (u8Key == '2' || u8Key == '3') {
 		// 直前のリモートデバイス情報の読み込み
@@ -3894,12 +3997,20 @@ PUBLIC void vProc_SelectRemoteDev(tsAppProcessInfo *psProcInfo) {
 	//==========================================================================
 	sprintf(sLCDInfo.cLCDBuff[0], "DevID:%08u  ", (int)sRemoteInfoMain.u32DeviceID);
 	sprintf(sLCDInfo.cLCDBuff[1], "Name :%10s", sRemoteInfoMain.cDeviceName);
+	// 応答時間の集計
+	vStepLatencyRecord(E_APP_IO_STEP_REMOTE_DEV, u64BeginUsec);
+#ifdef DEBUG
+	vfPrintf(&sSerStream, "vProc_SelectRemoteDev Step:%dus\n", (int)sAppIOStepStats.u32LastUsec[E_APP_IO_STEP_REMOTE_DEV]);
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
 
 	//==========================================================================
 	// LCD描画
 	//==========================================================================
 	// LCD描画イベント
 	iEntrySeqEvt(E_EVENT_APP_LCD_DRAWING);
+	// 次のリモートデバイス情報の先読みイベント（描画後に実行）
+	iEntrySeqEvt(E_EVENT_APP_EEPROM_PREFETCH);
 }
 
 /*******************************************************************************
@@ -4035,6 +4146,27 @@ PUBLIC void vEventHashStretching(uint32 u32EvtTimeMs) {
 	iEntrySeqEvt(E_EVENT_APP_HASH_ST);
 }
 
+/*******************************************************************************
+ *
+ * NAME: vEventHashStretchingMulti
+ *
+ * DESCRIPTION:拡張ハッシュストレッチング処理イベントプロセス（複数並行）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint32      u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+PUBLIC void vEventHashStretchingMulti(uint32 u32EvtTimeMs) {
+	// 全てのハッシュ関数を１ラウンドずつ実行
+	if (bAuth_hashStretchingMulti(sHashGenMulti, APP_HASH_MULTI_SIZE)) {
+		return;
+	}
+	// 次回ストレッチング処理
+	iEntrySeqEvt(E_EVENT_APP_HASH_ST_MULTI);
+}
+
 /******************************************************************************/
 /***        Local Functions                                                 ***/
 /******************************************************************************/
@@ -4143,6 +4275,72 @@ PRIVATE void vProc_SetSelectRemoteDev(teAppProcess eProcIdOk) {
 	vProc_Next(E_PROCESS_SELECT_REMOTE_DEV);
 }
 
+/*******************************************************************************
+ *
+ * NAME: vProc_SetDispEventLog
+ *
+ * DESCRIPTION:イベント履歴表示画面への遷移パラメータ設定
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   uint16             u16Day          R   対象日（LOG_QUERY_DAY_NONE:日を問わない）
+ *   uint32             u32ClassMap     R   対象のメッセージコードのマップ
+ *   uint8              u8Limit         R   最新のログからの表示件数（0:最も古いログから全件）
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+PRIVATE void vProc_SetDispEventLog(uint16 u16Day, uint32 u32ClassMap, uint8 u8Limit) {
+	vLogQuery_setCond(&sAppLogFilter.sCond, u16Day, u16Day, u32ClassMap);
+	sAppLogFilter.bQueryFlg  =
+		(u16Day != LOG_QUERY_DAY_NONE || u32ClassMap != LOG_QUERY_CLASS_ALL || u8Limit > 0);
+	sAppLogFilter.bNewestFlg = (u8Limit > 0);
+	sAppLogFilter.u8Limit    = u8Limit;
+	vProc_Next(E_PROCESS_DISPLAY_LOG);
+}
+
+/*******************************************************************************
+ *
+ * NAME: iProc_JumpEventLogDay
+ *
+ * DESCRIPTION:イベント履歴の日単位の移動
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   int                iIdx            R   表示中のイベントログのインデックス
+ *   bool_t             bForwardFlg     R   順方向フラグ（TRUE:翌日以降、FALSE:前日以前）
+ *
+ * RETURNS:
+ *   int 移動先の日の最初のイベントログのインデックス、エラー時はマイナス値
+ *       (-1:ログリング復元エラー、-2:対象データなし、-3:読み込みエラー)
+ *
+ * NOTES:
+ * 日時無しのイベントログは対象外、移動先はsEventLogに読み込む
+ * 日の範囲による検索なので、集計済みのブロックは読み込まずに読み飛ばす
+ ******************************************************************************/
+PRIVATE int iProc_JumpEventLogDay(int iIdx, bool_t bForwardFlg) {
+	uint16 u16Day = u16EEPROMLogDay(sEventLog.u16Year, sEventLog.u8Month, sEventLog.u8Day);
+	if (u16Day == LOG_QUERY_DAY_NONE) {
+		return -2;
+	}
+	tsLogQueryCond sCond;
+	if (bForwardFlg) {
+		// 翌日以降の最初のログ（キーは昇順なので最初に一致したログ）
+		vLogQuery_setCond(&sCond, u16Day + 1, LOG_QUERY_DAY_NONE - 1, LOG_QUERY_CLASS_ALL);
+		return iEEPROMQueryLog(&sEventLog, &sCond, iIdx + 1, TRUE);
+	}
+	// 前日以前の最後のログの日を特定して、その日の最初のログを検索
+	if (u16Day == 0 || iIdx == 0) {
+		return -2;
+	}
+	vLogQuery_setCond(&sCond, 0, u16Day - 1, LOG_QUERY_CLASS_ALL);
+	int iResult = iEEPROMQueryLog(&sEventLog, &sCond, iIdx - 1, FALSE);
+	if (iResult < 0) {
+		return iResult;
+	}
+	u16Day = u16EEPROMLogDay(sEventLog.u16Year, sEventLog.u8Month, sEventLog.u8Day);
+	vLogQuery_setCond(&sCond, u16Day, u16Day, LOG_QUERY_CLASS_ALL);
+	return iEEPROMQueryLog(&sEventLog, &sCond, 0, TRUE);
+}
+
 /*******************************************************************************
  *
  * NAME: vProc_SetInputToken
@@ -4191,9 +4389,7 @@ PRIVATE bool_t bProc_DefaultChkRx(tsWirelessMsg* psWlsMsg, uint8 u8Cmd) {
 	// レスポンスデータチェック
 	//----------------------------------------------------------------------
 	// CRCチェック
-	uint8 u8WkCRC = psWlsMsg->u8CRC;
-	psWlsMsg->u8CRC = 0;
-	if (u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE) != u8WkCRC) {
+	if (u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE) != psWlsMsg->u16CRC) {
 		vProc_SetMessage("Command Exec Err", "Data CRC Check  ");
 		iEEPROMWriteLog(E_MSG_CD_RX_CRC_ERR, psWlsMsg);
 		return FALSE;
@@ -4204,11 +4400,13 @@ PRIVATE bool_t bProc_DefaultChkRx(tsWirelessMsg* psWlsMsg, uint8 u8Cmd) {
 		iEEPROMWriteLog(E_MSG_CD_RX_CMD_ERR, psWlsMsg);
 		return FALSE;
 	}
-	// 受信メッセージの暗号化された領域を復号化
+	// 受信メッセージの暗号化された領域を復号化（認証タグの検証）
 	if (psWlsMsg->u8Command == E_APP_CMD_AUTH_ACK) {
-		tsAES_state sAES_state =
-				vAES_newCBCState(AES_KEY_LEN_256, sTxRxTrnsInfo.u8OneTimeTkn, sTxRxTrnsInfo.u8OneTimeTkn);
-		vAES_decrypt(&sAES_state, &psWlsMsg->u8AuthStCnt, 80);
+		if (bWirelessDecrypt(psWlsMsg, sTxRxTrnsInfo.u8OneTimeTkn) == FALSE) {
+			vProc_SetMessage("Command Exec Err", "Data MIC Check  ");
+			iEEPROMWriteLog(E_MSG_CD_RX_MIC_ERR, psWlsMsg);
+			return FALSE;
+		}
 	}
 	// 日付チェック
 	if (bValUtil_validDate(psWlsMsg->u16Year, psWlsMsg->u8Month, psWlsMsg->u8Day) == FALSE) {
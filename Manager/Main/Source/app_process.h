@@ -8,6 +8,8 @@
  * DESCRIPTION:各画面プロセス毎の処理を実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 リモートデバイス情報の同期時にハッシュ値を並行生成
+ * 2026/10/18 13:00:00 受信電文の改竄検知エラーを追加
  *
  * LAST MODIFIED BY:
  *
@@ -35,6 +37,13 @@ extern "C" {
 // Process Layer Size
 #define PROCESS_LAYER_SIZE               (4)
 
+// 並行ハッシュ生成数（主側と副側）
+#define APP_HASH_MULTI_SIZE              (2)
+// 並行ハッシュ生成インデックス：副→主に送信時
+#define APP_HASH_MULTI_IDX_SUB           (0)
+// 並行ハッシュ生成インデックス：主→副に送信時
+#define APP_HASH_MULTI_IDX_MAIN          (1)
+
 /****************************************************************************/
 /***        Type Definitions                                              ***/
 /****************************************************************************/
@@ -123,7 +132,8 @@ typedef enum {
 	E_MSG_CD_SERVO_ERR,						// サーボ位置エラー
 	E_MSG_CD_OPEN_SENS_ERR,					// 開放センサーエラー
 	E_MSG_CD_BUTTON_ERR,					// ボタン操作エラー
-	E_MSG_CD_IR_SENS_ERR					// 赤外線センサーエラー
+	E_MSG_CD_IR_SENS_ERR,					// 赤外線センサーエラー
+	E_MSG_CD_RX_MIC_ERR						// 受信データ改竄検知エラー
 } teAppMsgCD;
 
 // 構造体：プロセス情報
@@ -232,6 +242,8 @@ PUBLIC void vProc_SelectRemoteDev(tsAppProcessInfo *psProcInfo);
 PUBLIC void vProc_InputToken(tsAppProcessInfo *psProcInfo);
 // 拡張ハッシュストレッチング処理イベントプロセス
 PUBLIC void vEventHashStretching(uint32 u32EvtTimeMs);
+// 拡張ハッシュストレッチング処理イベントプロセス（複数並行）
+PUBLIC void vEventHashStretchingMulti(uint32 u32EvtTimeMs);
 
 /****************************************************************************/
 /***        Local Functions                                               ***/
@@ -8,6 +8,11 @@
  * DESCRIPTION:共通性の高い各種設定値を定義
  *
  * CHANGE HISTORY:
+ * 2026/10/19 02:00:00 イベントログのスロットサイズを追加
+ * 2026/10/19 03:00:00 イベントログのブロック構成を追加
+ * 2026/10/19 04:00:00 ジャーナル領域の先頭アドレスを追加
+ * 2026/10/19 05:00:00 リモートデバイス情報の先読みレコード数を追加
+ * 2026/10/19 06:00:00 イベント履歴の直近表示の件数を追加
  *
  * LAST MODIFIED BY:
  *
@@ -75,10 +80,24 @@ extern "C" {
 #define TOP_ADDR_REMOTE_DEV        (0x0080)
 // イベントログ先頭アドレス
 #define TOP_ADDR_EVENT_LOG         (0x1080)
+// 先頭アドレス：ジャーナル（KV_JOURNAL_AREA_SIZEバイト）
+#define TOP_ADDR_JOURNAL           (0x1880)
 // リモートデバイス数
 #define MAX_REMOTE_DEV_CNT         (32)
-// イベントログサイズ
-#define MAX_EVT_LOG_CNT            (128)
+// リモートデバイス情報の先読みレコード数（１回の連続読み込みで読み込むレコード数）
+#define REMOTE_DEV_STREAM_CNT      (4)
+// イベントログサイズ（エントリ位置の数）
+#define MAX_EVT_LOG_CNT            (256)
+// イベントログのブロック数
+#define EVT_LOG_BLOCK_CNT          (32)
+// イベントログのブロックサイズ（ログリングのヘッダを含む、EEPROMのページサイズの約数）
+#define EVT_LOG_BLOCK_SIZE         (64)
+// イベントログのエントリのデータサイズ（メッセージコード＋コマンド＋ステータスマップ）
+#define EVT_LOG_PAYLOAD_SIZE       (3)
+// イベントログのメッセージコードの時刻無効フラグ
+#define EVT_LOG_TIME_INVALID       (0x80)
+// イベント履歴の直近表示の件数
+#define EVT_LOG_LAST_CNT           (10)
 // Stretching Count
 #define STRETCHING_CNT_BASE        (1920)
 
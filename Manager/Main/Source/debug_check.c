@@ -8,6 +8,9 @@
  * DESCRIPTION:各モジュールのデバッグコードを実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 ハッシュストレッチングの照合デバッグを追加
+ * 2026/10/18 21:00:00 I2Cの動作周波数の自動調整とEEPROM一括読み込みの速度計測デバッグを追加
+ * 2026/10/19 00:00:00 EEPROM非同期書き込みの速度計測デバッグを追加
  *
  * LAST MODIFIED BY:
  *
@@ -44,8 +47,11 @@
 #include "framework.h"
 #include "timer_util.h"
 #include "i2c_util.h"
+#include "i2c_sched.h"
+#include "eeprom.h"
 #include "st7032i.h"
 #include "sha256.h"
+#include "app_auth.h"
 #include "ds3231.h"
 #include "io_util.h"
 
@@ -108,6 +114,8 @@ PUBLIC void vDEBUG_main() {
 //	vST7032I_debug();
 	// SHA256デバッグコード
 //	vSHA256_debug();
+	// ハッシュストレッチングデバッグコード
+//	vAuthStretching_debug();
 	// DS3231デバッグコード
 //	vDS3231_debug();
 	// Timer Utilデバッグコード
@@ -116,6 +124,10 @@ PUBLIC void vDEBUG_main() {
 //	vRandom_debug();
 	// アナログポートデバッグ
 //	vAnalogue_debug();
+	// I2Cスケジューラデバッグ
+//	vI2CSched_debug();
+	// EEPROM非同期書き込みデバッグ
+//	vEEPROMAsync_debug();
 	vDEBUG_dispMsg("vDEBUG_main End\n");
 }
 
@@ -943,6 +955,184 @@ PUBLIC void vSHA256_debug() {
 
 }
 
+// ハッシュストレッチングデバッグ
+PUBLIC void vAuthStretching_debug() {
+	//=========================================================================
+	// 照合テスト（従来のハッシュ生成手順と結果が一致する事を確認）
+	//=========================================================================
+	vfPrintf(&sSerStream, "vAuthStretching_debug Test\n");
+	u32TimerUtil_waitTickMSec(5);
+	uint8 u8SrcCode[APP_HASH_STRETCHING_CNT_MIN][APP_AUTH_TOKEN_SIZE];
+	uint8 u8SyncTkn[APP_AUTH_TOKEN_SIZE];
+	uint8 u8RefHash[APP_AUTH_TOKEN_SIZE];
+	tsAuthHashGenState sLanes[APP_HASH_STRETCHING_CNT_MIN];
+	SHA256_state hashState;
+	uint32 u32ShufflePtn;
+	uint8 u8WkCode;
+	uint32 idx, lane, round;
+	uint32 errCnt = 0;
+	randString(u8SyncTkn, APP_AUTH_TOKEN_SIZE);
+	for (lane = 0; lane < APP_HASH_STRETCHING_CNT_MIN; lane++) {
+		randString(u8SrcCode[lane], APP_AUTH_TOKEN_SIZE);
+		sLanes[lane] = sAuth_generateHashInfo(u8SrcCode[lane], APP_HASH_STRETCHING_CNT_BASE + lane);
+		vAuth_setSyncToken(&sLanes[lane], u8SyncTkn);
+	}
+	// 並行ストレッチング
+	while (bAuth_hashStretchingMulti(sLanes, APP_HASH_STRETCHING_CNT_MIN) == FALSE);
+	// 従来手順でのストレッチング
+	for (lane = 0; lane < APP_HASH_STRETCHING_CNT_MIN; lane++) {
+		memcpy(u8RefHash, u8SrcCode[lane], APP_AUTH_TOKEN_SIZE);
+		for (round = 0; round < APP_HASH_STRETCHING_CNT_BASE + lane; round++) {
+			hashState = sSHA256_newState();
+			vSHA256_append(&hashState, u8RefHash, APP_AUTH_TOKEN_SIZE);
+			vSHA256_generateHash(&hashState, u8RefHash);
+			u32ShufflePtn = sLanes[lane].u32ShufflePtn;
+			for (idx = 0; u32ShufflePtn > 0; idx++, u32ShufflePtn >>= 1) {
+				if ((u32ShufflePtn & 0x01) == 0x01) {
+					u8WkCode = u8RefHash[idx];
+					u8RefHash[idx] = u8RefHash[(idx + 1) % APP_AUTH_TOKEN_SIZE];
+					u8RefHash[(idx + 1) % APP_AUTH_TOKEN_SIZE] = u8WkCode;
+				}
+			}
+		}
+		if (memcmp(u8RefHash, sLanes[lane].u8HashCode, APP_AUTH_TOKEN_SIZE) != 0) {
+			errCnt++;
+		}
+	}
+	vfPrintf(&sSerStream, "vAuthStretching_debug Lanes:%d Err:%d\n", APP_HASH_STRETCHING_CNT_MIN, errCnt);
+	u32TimerUtil_waitTickMSec(1);
+
+	//=========================================================================
+	// 負荷テスト（1ラウンドあたりの処理時間）
+	//=========================================================================
+	uint64 u64Before = u64TimerUtil_readUsec();
+	for (round = 0; round < APP_HASH_STRETCHING_CNT_BASE; round++) {
+		hashState = sSHA256_newState();
+		vSHA256_append(&hashState, u8RefHash, APP_AUTH_TOKEN_SIZE);
+		vSHA256_generateHash(&hashState, u8RefHash);
+	}
+	uint32 u32RefUsec = (uint32)(u64TimerUtil_readUsec() - u64Before);
+	u64Before = u64TimerUtil_readUsec();
+	for (round = 0; round < APP_HASH_STRETCHING_CNT_BASE; round++) {
+		vSHA256_generateHash32(u8RefHash, u8RefHash);
+	}
+	uint32 u32FastUsec = (uint32)(u64TimerUtil_readUsec() - u64Before);
+	vfPrintf(&sSerStream, "vAuthStretching_debug Ref:%d usec Fast:%d usec\n",
+			u32RefUsec / APP_HASH_STRETCHING_CNT_BASE, u32FastUsec / APP_HASH_STRETCHING_CNT_BASE);
+	u32TimerUtil_waitTickMSec(1);
+}
+
+// I2Cスケジューラデバッグ
+PUBLIC void vI2CSched_debug() {
+	vfPrintf(&sSerStream, "vI2CSched_debug Test\n");
+	u32TimerUtil_waitTickMSec(5);
+	// 非同期処理とスケジューラの初期化
+	vI2C_initAsync();
+	vI2CSched_init(NULL, NULL);
+	int iDevIdx = iI2CSched_registDevice("EEPROM", I2C_ADDR_EEPROM_0, I2C_SCHED_PRIORITY_HIGH, I2C_SCHED_BUS_NONE);
+	uint8 u8MemAddr[2];
+	uint8 u8ReadData[I2C_SCHED_MERGE_BUFF_SIZE];
+	tsI2CSched_Req sReq;
+	memset(&sReq, 0x00, sizeof(tsI2CSched_Req));
+	sReq.sTrns.u8PreScaler  = I2C_PRESCALER_DEFAULT;
+	sReq.sTrns.pu8WriteData = u8MemAddr;
+	sReq.sTrns.u16WriteLen  = 2;
+	sReq.sTrns.pu8ReadData  = u8ReadData;
+	sReq.sTrns.eCompEvt     = E_EVENT_FWK_EMPTY;
+	sReq.u8MemAddrLen       = 2;
+	//=========================================================================
+	// 一括読み込みの速度計測（既定の周波数）
+	//=========================================================================
+	uint32 u32Usec[2];
+	uint32 u32Freq[2];
+	uint32 idx, cnt;
+	for (cnt = 0; cnt < 2; cnt++) {
+		uint8 u8PreScaler = u8I2CSched_getPreScaler(iDevIdx);
+		u32Freq[cnt] = (u8PreScaler == I2C_PRESCALER_DEFAULT) ?
+				u32I2C_getFrequency() : u32I2C_toFrequency(u8PreScaler);
+		sReq.sTrns.u16ReadLen = I2C_SCHED_MERGE_BUFF_SIZE;
+		uint64 u64Before = u64TimerUtil_readUsec();
+		for (idx = 0; idx < 32; idx++) {
+			u8MemAddr[0] = (uint8)(idx >> 2);
+			u8MemAddr[1] = (uint8)(idx << 6);
+			u8I2CSched_exec(iDevIdx, &sReq);
+		}
+		u32Usec[cnt] = (uint32)(u64TimerUtil_readUsec() - u64Before);
+		//=====================================================================
+		// 動作周波数の自動調整
+		//=====================================================================
+		if (cnt == 0) {
+			u8MemAddr[0] = 0x00;
+			u8MemAddr[1] = 0x00;
+			sReq.sTrns.u16ReadLen = I2C_SCHED_TUNE_BUFF_SIZE;
+			uint8 u8Tune = u8I2CSched_autotune(iDevIdx, &sReq, I2C_PRESCALER_66KHZ);
+			vfPrintf(&sSerStream, "vI2CSched_debug Autotune PreScaler:%d\n", u8Tune);
+			u32TimerUtil_waitTickMSec(1);
+		}
+	}
+	// 結果表示（2KB読み込み時のバイト/秒）
+	vfPrintf(&sSerStream, "vI2CSched_debug Before:%dHz %d Byte/s\n",
+			u32Freq[0], (uint32)((uint64)2048 * 1000000 / u32Usec[0]));
+	u32TimerUtil_waitTickMSec(1);
+	vfPrintf(&sSerStream, "vI2CSched_debug After :%dHz %d Byte/s Gain:%d%%\n",
+			u32Freq[1], (uint32)((uint64)2048 * 1000000 / u32Usec[1]),
+			(uint32)((uint64)u32Usec[0] * 100 / u32Usec[1]) - 100);
+	u32TimerUtil_waitTickMSec(1);
+}
+
+// EEPROM非同期書き込みデバッグ
+PUBLIC void vEEPROMAsync_debug() {
+	vfPrintf(&sSerStream, "vEEPROMAsync_debug Test\n");
+	u32TimerUtil_waitTickMSec(5);
+	tsEEPROM_status sStatus;
+	sStatus.u8DevAddress  = I2C_ADDR_EEPROM_0;
+	sStatus.b2ByteAddrFlg = TRUE;
+	sStatus.u8PageSize    = EEPROM_PAGE_SIZE_64B;
+	sStatus.u64LastWrite  = u64TimerUtil_readUsec();
+	sStatus.bCacheFlg     = FALSE;
+	bEEPROM_deviceSelect(&sStatus);
+	uint8 u8Data[EEPROM_ASYNC_BUFF_SIZE];
+	uint32 idx;
+	for (idx = 0; idx < EEPROM_ASYNC_BUFF_SIZE; idx++) {
+		u8Data[idx] = (uint8)idx;
+	}
+	//=========================================================================
+	// 同期書き込み（ACKポーリングで完了を待つ）
+	//=========================================================================
+	const tsEEPROM_writeStats* psStats = psEEPROM_getWriteStats();
+	vEEPROM_resetWriteStats();
+	uint64 u64Before = u64TimerUtil_readUsec();
+	for (idx = 0; idx < 2048 / EEPROM_ASYNC_BUFF_SIZE; idx++) {
+		bEEPROM_writeData(idx * EEPROM_ASYNC_BUFF_SIZE, EEPROM_ASYNC_BUFF_SIZE, u8Data);
+	}
+	bEEPROM_readData(0, 1, u8Data);
+	uint32 u32SyncUsec = (uint32)(u64TimerUtil_readUsec() - u64Before);
+	vfPrintf(&sSerStream, "vEEPROMAsync_debug Sync :%d Byte/s Cycle:%dus Max:%dus Reclaim:%dus\n",
+			(uint32)((uint64)2048 * 1000000 / u32SyncUsec),
+			psStats->u32CycleUsec / psStats->u32CycleCnt, psStats->u32MaxCycleUsec, psStats->u32ReclaimUsec);
+	u32TimerUtil_waitTickMSec(1);
+	//=========================================================================
+	// 非同期書き込み（進行処理以外の時間をイベントループに返却）
+	//=========================================================================
+	vEEPROM_resetWriteStats();
+	uint32 u32BusyUsec = 0;
+	uint64 u64Step;
+	u64Before = u64TimerUtil_readUsec();
+	for (idx = 0; idx < 2048 / EEPROM_ASYNC_BUFF_SIZE; idx++) {
+		bEEPROM_writeAsync(idx * EEPROM_ASYNC_BUFF_SIZE, EEPROM_ASYNC_BUFF_SIZE, u8Data, E_EVENT_FWK_EMPTY);
+		while (bEEPROM_asyncIsBusy()) {
+			u64Step = u64TimerUtil_readUsec();
+			eEEPROM_asyncProceed();
+			u32BusyUsec += (uint32)(u64TimerUtil_readUsec() - u64Step);
+		}
+	}
+	uint32 u32AsyncUsec = (uint32)(u64TimerUtil_readUsec() - u64Before);
+	vfPrintf(&sSerStream, "vEEPROMAsync_debug Async:%d Byte/s Busy:%dus Free:%dus Poll:%d\n",
+			(uint32)((uint64)2048 * 1000000 / u32AsyncUsec),
+			u32BusyUsec, u32AsyncUsec - u32BusyUsec, psStats->u32PollCnt);
+	u32TimerUtil_waitTickMSec(1);
+}
+
 /****************************************************************************/
 /***        Local Functions                                               ***/
 /****************************************************************************/
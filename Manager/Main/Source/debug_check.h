@@ -8,6 +8,9 @@
  * DESCRIPTION:各モジュールのデバッグコードを実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 12:00:00 ハッシュストレッチングの照合デバッグを追加
+ * 2026/10/18 21:00:00 I2Cスケジューラのデバッグを追加
+ * 2026/10/19 00:00:00 EEPROM非同期書き込みデバッグを追加
  *
  * LAST MODIFIED BY:
  *
@@ -58,6 +61,12 @@ PUBLIC void vST7032I_debug();
 PUBLIC void vDS3231_debug();
 // SHA256デバッグ
 PUBLIC void vSHA256_debug();
+// ハッシュストレッチングデバッグ
+PUBLIC void vAuthStretching_debug();
+// I2Cスケジューラデバッグ
+PUBLIC void vI2CSched_debug();
+// EEPROM非同期書き込みデバッグ
+PUBLIC void vEEPROMAsync_debug();
 // デバッグメッセージ表示処理
 PUBLIC void vDEBUG_dispMsg(const char* fmt);
 
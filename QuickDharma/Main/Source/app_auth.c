@@ -8,6 +8,7 @@
  * DESCRIPTION:アカウント認証処理に関する関数群
  *
  * CHANGE HISTORY:
+ * 2026/10/18 11:00:00 認証後の連続コマンド用にセッション処理を追加
  *
  * LAST MODIFIED BY:
  *
@@ -309,6 +310,119 @@ PUBLIC bool_t bAuth_isEnablePwHash(uint8* pu8HashCode, tsAuthHashGenState* psHas
 	return (memcmp(pu8HashCode, psHashInfo->u8HashCode, APP_AUTH_TOKEN_SIZE) == 0);
 }
 
+/****************************************************************************
+ *
+ * NAME: vAuth_beginSession
+ *
+ * DESCRIPTION:セッションの開始処理
+ *
+ * PARAMETERS:           Name           RW  Usage
+ *   tsAuthSessionInfo*  psSession      W   セッション情報
+ *   uint32              u32DeviceID    R   リモートデバイスID
+ *   uint8*              pu8OTTkn       R   ワンタイムトークン
+ *   uint8*              pu8SyncTkn     R   更新後の同期トークン
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 通常認証の成功直後に送信側と受信側の双方で呼び出す。
+ * セッションキーは両者しか知り得ないワンタイムトークンと更新後の同期トークンから算出する。
+ ****************************************************************************/
+PUBLIC void vAuth_beginSession(tsAuthSessionInfo* psSession, uint32 u32DeviceID, uint8* pu8OTTkn, uint8* pu8SyncTkn) {
+	// セッション情報の初期化
+	psSession->u32DeviceID = u32DeviceID;
+	psSession->u32BeginMs  = u32TickCount_ms;
+	psSession->u32Counter  = 0;
+	psSession->u8RemainCnt = APP_AUTH_SESSION_MAX_CNT;
+	// セッションキー算出
+	SHA256_state sha256State = sSHA256_newState();
+	vSHA256_append(&sha256State, pu8OTTkn, APP_AUTH_TOKEN_SIZE);
+	vSHA256_append(&sha256State, pu8SyncTkn, APP_AUTH_TOKEN_SIZE);
+	vSHA256_generateHash(&sha256State, psSession->u8SessionKey);
+}
+
+/****************************************************************************
+ *
+ * NAME: vAuth_clearSession
+ *
+ * DESCRIPTION:セッションのクリア処理
+ *
+ * PARAMETERS:           Name           RW  Usage
+ *   tsAuthSessionInfo*  psSession      W   セッション情報
+ *
+ * RETURNS:
+ *
+ ****************************************************************************/
+PUBLIC void vAuth_clearSession(tsAuthSessionInfo* psSession) {
+	memset(psSession, 0x00, sizeof(tsAuthSessionInfo));
+}
+
+/****************************************************************************
+ *
+ * NAME: bAuth_isEnableSession
+ *
+ * DESCRIPTION:セッションの有効判定
+ *
+ * PARAMETERS:           Name           RW  Usage
+ *   tsAuthSessionInfo*  psSession      R   セッション情報
+ *   uint32              u32DeviceID    R   リモートデバイスID
+ *
+ * RETURNS:
+ *   bool_t TRUE:セッション有効
+ *
+ ****************************************************************************/
+PUBLIC bool_t bAuth_isEnableSession(tsAuthSessionInfo* psSession, uint32 u32DeviceID) {
+	// セッション対象判定
+	if (psSession->u32DeviceID == 0 || psSession->u32DeviceID != u32DeviceID) {
+		return FALSE;
+	}
+	// 利用回数判定
+	if (psSession->u8RemainCnt == 0) {
+		return FALSE;
+	}
+	// 有効期間判定（Tickの桁あふれを考慮して経過時間で判定）
+	return ((u32TickCount_ms - psSession->u32BeginMs) < APP_AUTH_SESSION_WINDOW_MS);
+}
+
+/****************************************************************************
+ *
+ * NAME: vAuth_editSessionTkn
+ *
+ * DESCRIPTION:セッショントークンの生成編集処理
+ *
+ * PARAMETERS:           Name           RW  Usage
+ *   uint8*              pu8SesTkn      W   セッショントークン
+ *   tsAuthSessionInfo*  psSession      R   セッション情報
+ *   uint32              u32Addr        R   宛先アドレス
+ *   uint32              u32Counter     R   セッションカウンタ
+ *   uint8               u8Command      R   コマンド
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * セッションキーで前後を挟んだ宛先・カウンタ・コマンドのハッシュ値を
+ * 1回だけ算出する（ストレッチングなし）。
+ ****************************************************************************/
+PUBLIC void vAuth_editSessionTkn(uint8* pu8SesTkn, tsAuthSessionInfo* psSession, uint32 u32Addr, uint32 u32Counter, uint8 u8Command) {
+	// 対象データの編集
+	uint8 u8WkData[9];
+	u8WkData[0] = (uint8)(u32Addr >> 24);
+	u8WkData[1] = (uint8)(u32Addr >> 16);
+	u8WkData[2] = (uint8)(u32Addr >> 8);
+	u8WkData[3] = (uint8)u32Addr;
+	u8WkData[4] = (uint8)(u32Counter >> 24);
+	u8WkData[5] = (uint8)(u32Counter >> 16);
+	u8WkData[6] = (uint8)(u32Counter >> 8);
+	u8WkData[7] = (uint8)u32Counter;
+	u8WkData[8] = u8Command;
+	// ハッシュコード（セッショントークン）算出
+	SHA256_state sha256State = sSHA256_newState();
+	vSHA256_append(&sha256State, psSession->u8SessionKey, APP_AUTH_TOKEN_SIZE);
+	vSHA256_append(&sha256State, u8WkData, 9);
+	vSHA256_append(&sha256State, psSession->u8SessionKey, APP_AUTH_TOKEN_SIZE);
+	vSHA256_generateHash(&sha256State, pu8SesTkn);
+}
+
 /****************************************************************************/
 /***        Local Functions                                               ***/
 /****************************************************************************/
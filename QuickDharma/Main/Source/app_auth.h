@@ -9,6 +9,7 @@
  *
  * CHANGE HISTORY:
  * 2018/01/23 05:58:00 通信レコードレイアウトをAES暗号化に合わせて調整
+ * 2026/10/18 11:00:00 認証後の連続コマンド用にセッション情報を追加
  *
  * LAST MODIFIED BY:
  *
@@ -47,6 +48,18 @@ extern "C" {
 	#define APP_HASH_STRETCHING_CNT_MIN     (5)
 #endif
 
+/** セッション有効期間（ミリ秒） */
+#ifndef APP_AUTH_SESSION_WINDOW_MS
+	// 通常認証後の3分間とする
+	#define APP_AUTH_SESSION_WINDOW_MS      (180000)
+#endif
+
+/** セッション利用回数の上限 */
+#ifndef APP_AUTH_SESSION_MAX_CNT
+	// 上限は8回とする
+	#define APP_AUTH_SESSION_MAX_CNT        (8)
+#endif
+
 /****************************************************************************/
 /***        Type Definitions                                              ***/
 /****************************************************************************/
@@ -93,6 +106,15 @@ typedef struct {
 	uint8 u8Filler[9];							// 余白
 } tsAuthRemoteDevInfo;
 
+// 構造体：セッション情報
+typedef struct {
+	uint32 u32DeviceID;							// リモートデバイスID（0:セッションなし）
+	uint32 u32BeginMs;							// セッション開始時刻（Tick）
+	uint32 u32Counter;							// セッションカウンタ（最終利用値）
+	uint8 u8RemainCnt;							// 残り利用回数
+	uint8 u8SessionKey[APP_AUTH_TOKEN_SIZE];	// セッションキー
+} tsAuthSessionInfo;
+
 
 /****************************************************************************/
 /***        Exported Variables                                            ***/
@@ -123,6 +145,14 @@ PUBLIC void vAuth_editOneTimeTkn(uint8* pu8OTTkn, uint16 u16RndVal, uint32 u32Re
 PUBLIC bool_t bAuth_isEnableMstPwHash(tsAuthHashGenState* psHashInfo, tsAuthDeviceInfo* psDevInfo);
 /** パスワードハッシュの有効判定 */
 PUBLIC bool_t bAuth_isEnablePwHash(uint8* pu8HashCode, tsAuthHashGenState* psHashInfo);
+/** セッションの開始処理 */
+PUBLIC void vAuth_beginSession(tsAuthSessionInfo* psSession, uint32 u32DeviceID, uint8* pu8OTTkn, uint8* pu8SyncTkn);
+/** セッションのクリア処理 */
+PUBLIC void vAuth_clearSession(tsAuthSessionInfo* psSession);
+/** セッションの有効判定 */
+PUBLIC bool_t bAuth_isEnableSession(tsAuthSessionInfo* psSession, uint32 u32DeviceID);
+/** セッショントークンの生成編集処理 */
+PUBLIC void vAuth_editSessionTkn(uint8* pu8SesTkn, tsAuthSessionInfo* psSession, uint32 u32Addr, uint32 u32Counter, uint8 u8Command);
 
 /****************************************************************************/
 /***        Local Functions                                               ***/
@@ -8,6 +8,13 @@
  * DESCRIPTION:イベント処理を実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 10:00:00 返信トークンと次回認証トークンの事前計算キャッシュを追加
+ * 2026/10/18 11:00:00 認証後の連続コマンドをセッションで認証
+ * 2026/10/18 13:00:00 電文をAES-CCMで暗号化し、改竄された電文は復号化直後に破棄
+ * 2026/10/18 17:00:00 送信バッファを送信パケットのスロットプールに変更し、電文をスロット内で直接編集
+ * 2026/10/18 18:00:00 電文のCRCチェックをテーブル参照のCRC-16に変更
+ * 2026/10/19 11:00:00 偽装可能な電文ではセッションを破棄せず、トークン不一致時はセッション認証付きのNACKを返信
+ * 2026/10/19 15:00:00 CRC-16の編集箇所のコメントを修正
  *
  * LAST MODIFIED BY:
  *
@@ -37,7 +44,6 @@
 #include "ToCoNet_use_mod.h"
 #include "ToCoNet.h"
 #include "ToCoNet_mod_prototype.h"
-#include "ccitt8.h"
 
 /******************************************************************************/
 /***        User Include files                                              ***/
@@ -45,10 +51,12 @@
 #include "config.h"
 #include "config_default.h"
 #include "framework.h"
+#include "timer_util.h"
 #include "io_util.h"
 #include "pwm_util.h"
 #include "aes.h"
 #include "sha256.h"
+#include "crc.h"
 #include "app_event.h"
 #include "app_io.h"
 #include "app_auth.h"
@@ -70,8 +78,20 @@
 PRIVATE bool_t bEvt_RxDefaultChk(tsRxTxInfo* psRxInfo);
 // 経過時間の算出処理
 PRIVATE uint32 u32Evt_getElapsedTime(tsAuthRemoteDevInfo* psRemoteInfo, DS3231_datetime* psDateTime);
+// 紀元からの分数の算出処理
+PRIVATE uint32 u32Evt_getEpochMin(DS3231_datetime* psDateTime);
+// 認証事前計算キャッシュの登録
+PRIVATE void vEvt_PrecalcEntry(tsAuthRemoteDevInfo* psRemoteInfo, uint8 u8AuthStCnt, uint8* pu8AuthTkn);
+// 認証事前計算キャッシュの照合
+PRIVATE tsAppAuthPrecalc* psEvt_PrecalcMatch(tsAuthRemoteDevInfo* psRemoteInfo, uint8 u8AuthStCnt);
+// 認証事前計算済みの返信トークン取得
+PRIVATE bool_t bEvt_PrecalcRespTkn(tsAppAuthPrecalc* psPrecalc, uint32 u32ElapsedMin, uint8* pu8RespTkn);
+// 認証事前計算の実行
+PRIVATE void vEvt_PrecalcStep(tsAppAuthPrecalc* psPrecalc, uint32 u32NowMin, uint8 u8Rounds);
 // 返信処理
 PRIVATE bool_t bEvt_TxResponse(teAppCommand eCommand, bool_t bEncryption);
+// セッション認証付きの返信処理
+PRIVATE bool_t bEvt_TxSessionResponse(teAppCommand eCommand, uint32 u32Counter);
 // 通信トランザクション開始
 PRIVATE void vEvt_BeginTxRxTrns(tsAppTxRxTrnsInfo* psTxRxTrnsInfo, tsRxTxInfo* psRxInfo);
 // 通信トランザクション終了
@@ -92,6 +112,10 @@ PRIVATE void vConv_ToStr(uint8* pu8Src, char* pcStr, uint8 u8Size);
 PUBLIC tsAppTxRxTrnsInfo sTxRxTrnsInfo;
 /** ハッシュ値生成情報 */
 PUBLIC tsAuthHashGenState sHashGenInfo;
+/** 認証事前計算キャッシュ（先頭が直近に認証したリモートデバイス） */
+PRIVATE tsAppAuthPrecalc sAuthPrecalc[APP_AUTH_PRECALC_SIZE];
+/** セッション情報（直近に通常認証したリモートデバイス） */
+PRIVATE tsAuthSessionInfo sSessionInfo;
 
 /******************************************************************************/
 /***        Exported Functions                                              ***/
@@ -142,6 +166,8 @@ PUBLIC void vEvent_RegistTask() {
 	bRegisterEvtTask(E_EVENT_STS_ALARM_LOCK, vEvent_StsAlarmLock);
 	bRegisterEvtTask(E_EVENT_STS_MST_UNLOCK, vEvent_StsMstUnlock);
 	bRegisterEvtTask(E_EVENT_HASH_ST, vEvent_HashStretching);
+	bRegisterEvtTask(E_EVENT_AUTH_PRECALC, vEvent_AuthPrecalc);
+	bRegisterEvtTask(E_EVENT_RX_SESSION, vEvent_RxSession);
 
 	//==========================================================================
 	// スケジュールイベント登録
@@ -154,6 +180,8 @@ PUBLIC void vEvent_RegistTask() {
 	iEntryScheduleEvt(E_EVENT_SENSOR_CHK, 200, 700, TRUE);
 	// タスク登録：秒間隔処理
 	iEntryScheduleEvt(E_EVENT_SECOND, 1000, 1500, TRUE);
+	// タスク登録：認証事前計算処理
+	iEntryScheduleEvt(E_EVENT_AUTH_PRECALC, APP_AUTH_PRECALC_INTERVAL, 1700, TRUE);
 }
 
 /*******************************************************************************
@@ -313,6 +341,21 @@ PUBLIC void vEvent_RxPacketCheck(uint32 u32EvtTimeMs) {
 		sTxRxTrnsInfo.eOkAppEvt = sAppEventMap.eEvtInCautionReq;
 		eAppEvent = E_EVENT_RX_AUTH_00;
 		break;
+	case E_APP_CMD_SES_UNLOCK:
+		// 送受信コマンド：セッション開錠要求
+		sTxRxTrnsInfo.eOkAppEvt = sAppEventMap.eEvtUnlockReq;
+		eAppEvent = E_EVENT_RX_SESSION;
+		break;
+	case E_APP_CMD_SES_LOCK:
+		// 送受信コマンド：セッション施錠要求（光学センサーモード）
+		sTxRxTrnsInfo.eOkAppEvt = sAppEventMap.eEvtLockReq;
+		eAppEvent = E_EVENT_RX_SESSION;
+		break;
+	case E_APP_CMD_SES_ALERT:
+		// 送受信コマンド：セッション警戒施錠要求（フルセンサーモード）
+		sTxRxTrnsInfo.eOkAppEvt = sAppEventMap.eEvtInCautionReq;
+		eAppEvent = E_EVENT_RX_SESSION;
+		break;
 	case E_APP_CMD_MST_UNLOCK:
 		// 送受信コマンド：マスター開錠要求
 		sTxRxTrnsInfo.eOkAppEvt = sAppEventMap.eEvtMstUnlockReq;
@@ -478,18 +521,46 @@ PUBLIC void vEvent_RxAuth_01(uint32 u32EvtTimeMs) {
 	tsWirelessMsg* psRxMsg = &sTxRxTrnsInfo.sRxWlsMsg;
 	// ワンタイムトークンのコピー
 	memcpy(sTxRxTrnsInfo.u8OneTimeTkn, sHashGenInfo.u8HashCode, APP_AUTH_TOKEN_SIZE);
-	// 受信メッセージの暗号化された領域を復号化
-	tsAES_state sAES_state =
-			vAES_newCBCState(AES_KEY_LEN_256, sTxRxTrnsInfo.u8OneTimeTkn, sTxRxTrnsInfo.u8OneTimeTkn);
-	vAES_decrypt(&sAES_state, &psRxMsg->u8AuthStCnt, 80);
+	// 受信メッセージの暗号化された領域を復号化（認証タグの検証）
+	if (bWirelessDecrypt(psRxMsg, sTxRxTrnsInfo.u8OneTimeTkn) == FALSE) {
+		// 改竄検知エラー（以降の認証ハッシュ生成は行わない）
+		bEEPROMWriteDevInfo(APP_STS_MAP_AUTH_ERR);
+		iEEPROMWriteLog(E_MSG_CD_RX_MIC_ERR, psRxMsg->u8Command);
+		// NACK返信
+		bEvt_TxResponse(E_APP_CMD_NACK, TRUE);
+		// 通信トランザクション終了処理
+		vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
+		return;
+	}
 
 	//==========================================================================
 	// 返信ハッシュ生成情報
 	//==========================================================================
 	tsAuthRemoteDevInfo* psRemoteInfo = &sTxRxTrnsInfo.sRemoteInfo;
 	// 返信ストレッチング回数を算出
-	sTxRxTrnsInfo.u16RespStCnt =
-			u16Auth_convToRespStCnt(u32Evt_getElapsedTime(psRemoteInfo, &sTxRxTrnsInfo.sRefDatetime));
+	uint32 u32ElapsedMin = u32Evt_getElapsedTime(psRemoteInfo, &sTxRxTrnsInfo.sRefDatetime);
+	sTxRxTrnsInfo.u16RespStCnt = u16Auth_convToRespStCnt(u32ElapsedMin);
+
+	//==========================================================================
+	// 認証事前計算キャッシュの参照
+	//==========================================================================
+	sTxRxTrnsInfo.psPrecalc = psEvt_PrecalcMatch(psRemoteInfo, psRxMsg->u8AuthStCnt);
+	if (sTxRxTrnsInfo.psPrecalc != NULL) {
+		// 部分ヒット（認証ハッシュの生成を省略）
+		sTxRxTrnsInfo.ePrecalcResult = E_APP_PRECALC_PART_HIT;
+		// 返信トークンの参照
+		if (bEvt_PrecalcRespTkn(sTxRxTrnsInfo.psPrecalc, u32ElapsedMin, sTxRxTrnsInfo.u8ResponseTkn)) {
+			// ヒット（比較のみで認証）
+			sTxRxTrnsInfo.ePrecalcResult = E_APP_PRECALC_HIT;
+			memcpy(sHashGenInfo.u8HashCode, sTxRxTrnsInfo.psPrecalc->u8AuthTkn, APP_AUTH_TOKEN_SIZE);
+			iEntrySeqEvt(E_EVENT_RX_AUTH_03);
+			return;
+		}
+	}
+
+	//==========================================================================
+	// 返信ハッシュ生成依頼
+	//==========================================================================
 	// 返信ハッシュ生成情報
 	sHashGenInfo = sAuth_generateHashInfo(psRemoteInfo->u8AuthCode, sTxRxTrnsInfo.u16RespStCnt);
 	vAuth_setSyncToken(&sHashGenInfo, psRemoteInfo->u8SyncToken);
@@ -516,6 +587,12 @@ PUBLIC void vEvent_RxAuth_02(uint32 u32EvtTimeMs) {
 	// 返信ハッシュの退避
 	//==========================================================================
 	memcpy(sTxRxTrnsInfo.u8ResponseTkn, sHashGenInfo.u8HashCode, APP_AUTH_TOKEN_SIZE);
+	// 事前計算済みの認証ハッシュ判定
+	if (sTxRxTrnsInfo.psPrecalc != NULL) {
+		memcpy(sHashGenInfo.u8HashCode, sTxRxTrnsInfo.psPrecalc->u8AuthTkn, APP_AUTH_TOKEN_SIZE);
+		iEntrySeqEvt(E_EVENT_RX_AUTH_03);
+		return;
+	}
 
 	//==========================================================================
 	// 認証ハッシュ生成依頼
@@ -630,59 +707,75 @@ PUBLIC void vEvent_RxAuth_04(uint32 u32EvtTimeMs) {
 	SERIAL_vFlush(sSerStream.u8Device);
 #endif
 	// 返信電文の編集
-	tsWirelessMsg sTxMsg;
-	memset(&sTxMsg, 0x00, sizeof(tsWirelessMsg));
-	sTxMsg.u32DstAddr = sTxRxTrnsInfo.u32DstAddr;		// 宛先アドレス
-	sTxMsg.u8Command  = E_APP_CMD_AUTH_ACK;				// 認証ありACKコマンド
+	tsWirelessMsg* psTxMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, TRUE);
+	if (psTxMsg == NULL) {
+		// 送信エラーログ
+		bEEPROMWriteDevInfo(APP_STS_MAP_IO_ERR);
+		iEEPROMWriteLog(E_MSG_CD_TX_ERR, E_APP_CMD_AUTH_ACK);
+		// 通信トランザクション終了処理
+		vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
+		return;
+	}
+	psTxMsg->u32DstAddr = sTxRxTrnsInfo.u32DstAddr;		// 宛先アドレス
+	psTxMsg->u8Command  = E_APP_CMD_AUTH_ACK;				// 認証ありACKコマンド
 	//--------------------------------------------------------------------------
 	// レスポンス認証情報の編集
 	//--------------------------------------------------------------------------
 	// リモートデバイス情報
 	tsAuthRemoteDevInfo* psRemoteInfo = &sTxRxTrnsInfo.sRemoteInfo;
 	// ストレッチング回数
-	sTxMsg.u8AuthStCnt = psRemoteInfo->u8RcvStretching;
+	psTxMsg->u8AuthStCnt = psRemoteInfo->u8RcvStretching;
 	// レスポンストークン
-	memcpy(sTxMsg.u8AuthToken, sTxRxTrnsInfo.u8ResponseTkn, APP_AUTH_TOKEN_SIZE);
+	memcpy(psTxMsg->u8AuthToken, sTxRxTrnsInfo.u8ResponseTkn, APP_AUTH_TOKEN_SIZE);
 	//--------------------------------------------------------------------------
 	// レスポンス更新認証情報の編集
 	//--------------------------------------------------------------------------
 	// 更新ストレッチング回数
-	sTxMsg.u8UpdAuthStCnt = sTxRxTrnsInfo.u8UpdStretchingCntS;
+	psTxMsg->u8UpdAuthStCnt = sTxRxTrnsInfo.u8UpdStretchingCntS;
 	// 更新認証トークン
-	memcpy(sTxMsg.u8UpdAuthToken, sHashGenInfo.u8HashCode, APP_AUTH_TOKEN_SIZE);
+	memcpy(psTxMsg->u8UpdAuthToken, sHashGenInfo.u8HashCode, APP_AUTH_TOKEN_SIZE);
 	// 返信データ
-	sTxMsg.u16Year     = sAppIO.sDatetime.u16Year;		// 年
-	sTxMsg.u8Month     = sAppIO.sDatetime.u8Month;		// 月
-	sTxMsg.u8Day       = sAppIO.sDatetime.u8Day;		// 日
-	sTxMsg.u8Hour      = sAppIO.sDatetime.u8Hour;		// 時
-	sTxMsg.u8Minute    = sAppIO.sDatetime.u8Minutes;	// 分
-	sTxMsg.u8Second    = sAppIO.sDatetime.u8Seconds;	// 秒
-	sTxMsg.u8StatusMap = sDevInfo.u8StatusMap;			// ステータスマップ
+	psTxMsg->u16Year     = sAppIO.sDatetime.u16Year;		// 年
+	psTxMsg->u8Month     = sAppIO.sDatetime.u8Month;		// 月
+	psTxMsg->u8Day       = sAppIO.sDatetime.u8Day;		// 日
+	psTxMsg->u8Hour      = sAppIO.sDatetime.u8Hour;		// 時
+	psTxMsg->u8Minute    = sAppIO.sDatetime.u8Minutes;	// 分
+	psTxMsg->u8Second    = sAppIO.sDatetime.u8Seconds;	// 秒
+	psTxMsg->u8StatusMap = sDevInfo.u8StatusMap;			// ステータスマップ
 	// 暗号化領域の暗号化
-	tsAES_state sAES_state =
-			vAES_newCBCState(AES_KEY_LEN_256, sTxRxTrnsInfo.u8OneTimeTkn, sTxRxTrnsInfo.u8OneTimeTkn);
-	vAES_encrypt(&sAES_state, &sTxMsg.u8AuthStCnt, 80);
-	// CRC8編集
-	sTxMsg.u8CRC = u8CCITT8((uint8*)&sTxMsg, TX_REC_SIZE);
+	vWirelessEncrypt(psTxMsg, sTxRxTrnsInfo.u8OneTimeTkn);
+	// CRC16編集
+	psTxMsg->u16CRC = u16CRC16_calc((uint8*)psTxMsg, TX_CRC_SIZE);
 	//--------------------------------------------------------------------------
 	// 電文の送信
 	//--------------------------------------------------------------------------
-	if (bWirelessTxEnq(sDevInfo.u32DeviceID, TRUE, &sTxMsg) == FALSE) {
-		// 送信エラーログ
-		bEEPROMWriteDevInfo(APP_STS_MAP_IO_ERR);
-		iEEPROMWriteLog(E_MSG_CD_TX_ERR, E_APP_CMD_AUTH_ACK);
-		// 通信トランザクション終了処理
-		vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
-		return;
-	}
+	vWirelessTxCommit(psTxMsg);
 	// イベントタスク登録：レスポンス送信
 	iEntrySeqEvt(E_EVENT_TX_DATA);
+	//--------------------------------------------------------------------------
+	// 応答時間の集計
+	//--------------------------------------------------------------------------
+	teAppPrecalcResult eResult = sTxRxTrnsInfo.ePrecalcResult;
+	uint32 u32LatencyUsec = (uint32)(u64TimerUtil_readUsec() - sTxRxTrnsInfo.u64BeginUsec);
+	sAuthPrecalcStats.u16Cnt[eResult]++;
+	sAuthPrecalcStats.u32LastUsec[eResult] = u32LatencyUsec;
+	sAuthPrecalcStats.u64TotalUsec[eResult] += u32LatencyUsec;
+#ifdef DEBUG
+	vfPrintf(&sSerStream, "MS:%08d Precalc Res:%d Usec:%08d Hit:%03d Part:%03d Miss:%03d\n", u32TickCount_ms,
+			eResult, u32LatencyUsec, sAuthPrecalcStats.u16Cnt[E_APP_PRECALC_HIT],
+			sAuthPrecalcStats.u16Cnt[E_APP_PRECALC_PART_HIT], sAuthPrecalcStats.u16Cnt[E_APP_PRECALC_MISS]);
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
 	//==========================================================================
 	// 認証情報の更新
 	//==========================================================================
 	memcpy(psRemoteInfo->u8SyncToken, sTxRxTrnsInfo.u8UpdSyncTkn, APP_AUTH_TOKEN_SIZE);
 	memcpy(psRemoteInfo->u8AuthCode, sTxRxTrnsInfo.u8UpdateTkn, APP_AUTH_TOKEN_SIZE);
 	psRemoteInfo->u8RcvStretching = sTxRxTrnsInfo.u8UpdStretchingCntR;
+	// 次回の認証トークンを事前計算キャッシュに登録（書き込み時にマスキングされる為、先に登録）
+	vEvt_PrecalcEntry(psRemoteInfo, sTxRxTrnsInfo.u8UpdStretchingCntS, sHashGenInfo.u8HashCode);
+	// セッション開始（以降の連続コマンドはストレッチングなしで認証）
+	vAuth_beginSession(&sSessionInfo, psRemoteInfo->u32DeviceID, sTxRxTrnsInfo.u8OneTimeTkn, sTxRxTrnsInfo.u8UpdSyncTkn);
 	// リモートデバイス情報の書き込み
 	if (iEEPROMWriteRemoteInfo(psRemoteInfo) < 0) {
 		// 書き込みエラー
@@ -968,6 +1061,10 @@ PUBLIC void vEvent_StsAlarmUnlock(uint32 u32EvtTimeMs) {
 	//==========================================================================
 	// マスタートークンマスククリア
 	vEEPROMTokenMaskClear();
+	// 認証事前計算キャッシュクリア
+	vEvent_ClearAuthPrecalc();
+	// セッションクリア
+	vEvent_ClearSession();
 	// エラーログを出力
 	iEEPROMWriteLog(sAppEventInfo.u8LogMsgCd, 0x00);
 }
@@ -1014,6 +1111,10 @@ PUBLIC void vEvent_StsAlarmLock(uint32 u32EvtTimeMs) {
 	//==========================================================================
 	// マスタートークンマスククリア
 	vEEPROMTokenMaskClear();
+	// 認証事前計算キャッシュクリア
+	vEvent_ClearAuthPrecalc();
+	// セッションクリア
+	vEvent_ClearSession();
 	// エラーログを出力
 	iEEPROMWriteLog(sAppEventInfo.u8LogMsgCd, 0x00);
 }
@@ -1058,6 +1159,10 @@ PUBLIC void vEvent_StsMstUnlock(uint32 u32EvtTimeMs) {
 	//==========================================================================
 	// マスタートークンマスククリア
 	vEEPROMTokenMaskClear();
+	// 認証事前計算キャッシュクリア
+	vEvent_ClearAuthPrecalc();
+	// セッションクリア
+	vEvent_ClearSession();
 }
 
 /*******************************************************************************
@@ -1083,6 +1188,171 @@ PUBLIC void vEvent_HashStretching(uint32 u32EvtTimeMs) {
 	}
 }
 
+/*******************************************************************************
+ *
+ * NAME: vEvent_AuthPrecalc
+ *
+ * DESCRIPTION:イベント処理：認証事前計算処理
+ *   通信トランザクションが無いアイドル時間に、直近に認証したリモートデバイスの
+ *   現在分と次の分の返信トークンを少しずつ計算する
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint32      u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+PUBLIC void vEvent_AuthPrecalc(uint32 u32EvtTimeMs) {
+	// 通信トランザクション中は処理しない
+	if (sTxRxTrnsInfo.u32DstAddr != 0) {
+		return;
+	}
+	// 現在日時（紀元からの分数）
+	uint32 u32NowMin = u32Evt_getEpochMin(&sAppIO.sDatetime);
+	// 直近に認証したリモートデバイスから順に計算
+	tsAppAuthPrecalc* psPrecalc;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < APP_AUTH_PRECALC_SIZE; u8Idx++) {
+		psPrecalc = &sAuthPrecalc[u8Idx];
+		if (psPrecalc->eStatus == E_APP_PRECALC_STS_EMPTY) {
+			return;
+		}
+		// 計算済み判定
+		uint32 u32ElapsedMin = u32NowMin - psPrecalc->u32StartDateTime;
+		if (psPrecalc->eStatus == E_APP_PRECALC_STS_READY && psPrecalc->u32RespMin == u32ElapsedMin) {
+			continue;
+		}
+		// 今回の処理枠で計算
+		vEvt_PrecalcStep(psPrecalc, u32ElapsedMin, APP_AUTH_PRECALC_ROUNDS);
+		return;
+	}
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvent_ClearAuthPrecalc
+ *
+ * DESCRIPTION:認証事前計算キャッシュのクリア
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+PUBLIC void vEvent_ClearAuthPrecalc() {
+	memset(sAuthPrecalc, 0x00, sizeof(sAuthPrecalc));
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvent_RxSession
+ *
+ * DESCRIPTION:イベント処理：セッション認証処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint32      u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 通常認証の成功後、有効期間内の連続コマンドはハッシュストレッチングを行わずに
+ * セッションキーによる復号化とトークン比較のみで認証する。
+ * セッションが無効な場合にはNACKを返信し、送信側に通常認証での再実行を促す。
+ * 第三者が偽装・再送できる電文（セッション不一致、古いカウンタ、認証タグ不一致）では
+ * セッションを破棄せず、認証なしのNACKのみを返信する。セッションキーで復号化できた
+ * 電文のトークン不一致の場合のみ、セッション認証付きのNACKを返信してセッションを破棄する。
+ ******************************************************************************/
+PUBLIC void vEvent_RxSession(uint32 u32EvtTimeMs) {
+	//==========================================================================
+	// セッションの有効判定
+	//==========================================================================
+	tsWirelessMsg* psRxMsg = &sTxRxTrnsInfo.sRxWlsMsg;
+	if (bAuth_isEnableSession(&sSessionInfo, sTxRxTrnsInfo.u32DstAddr) == FALSE ||
+			psRxMsg->u32SyncVal <= sSessionInfo.u32Counter) {
+		// NACK返信（偽装・再送の可能性があるのでセッションは維持）
+		bEvt_TxResponse(E_APP_CMD_NACK, FALSE);
+		// 通信トランザクション終了処理
+		vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
+		return;
+	}
+
+	//==========================================================================
+	// 認証処理
+	//==========================================================================
+	// 受信メッセージの暗号化された領域を復号化（認証タグの検証）
+	if (bWirelessDecrypt(psRxMsg, sSessionInfo.u8SessionKey) == FALSE) {
+		// 改竄検知エラー
+		bEEPROMWriteDevInfo(APP_STS_MAP_AUTH_ERR);
+		iEEPROMWriteLog(E_MSG_CD_RX_MIC_ERR, psRxMsg->u8Command);
+		// NACK返信（偽装の可能性があるのでセッションは維持）
+		bEvt_TxResponse(E_APP_CMD_NACK, FALSE);
+		// 通信トランザクション終了処理
+		vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
+		return;
+	}
+	// セッショントークンの検証
+	uint8 u8SesTkn[APP_AUTH_TOKEN_SIZE];
+	vAuth_editSessionTkn(u8SesTkn, &sSessionInfo, sDevInfo.u32DeviceID, psRxMsg->u32SyncVal, psRxMsg->u8Command);
+	if (memcmp(psRxMsg->u8AuthToken, u8SesTkn, APP_AUTH_TOKEN_SIZE) != 0) {
+		// 認証エラー
+		bEEPROMWriteDevInfo(APP_STS_MAP_AUTH_ERR);
+		iEEPROMWriteLog(E_MSG_CD_RX_AUTH_TKN_ERR, psRxMsg->u8Command);
+		// セッション認証付きNACK返信（セッションキーが必要なので破棄前に編集）
+		bEvt_TxSessionResponse(E_APP_CMD_NACK, psRxMsg->u32SyncVal);
+		// セッション破棄
+		vAuth_clearSession(&sSessionInfo);
+		// 通信トランザクション終了処理
+		vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
+		return;
+	}
+	// セッションカウンタ更新
+	sSessionInfo.u32Counter = psRxMsg->u32SyncVal;
+	sSessionInfo.u8RemainCnt--;
+
+	//==========================================================================
+	// 認証結果のレスポンス処理
+	//==========================================================================
+	// 認証ありACKの返信
+	if (bEvt_TxSessionResponse(E_APP_CMD_AUTH_ACK, psRxMsg->u32SyncVal) == FALSE) {
+		// 送信エラー
+		bEEPROMWriteDevInfo(APP_STS_MAP_IO_ERR);
+		// 通信トランザクション終了処理
+		vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
+		return;
+	}
+#ifdef DEBUG
+	vfPrintf(&sSerStream, "MS:%08d Session Cnt:%03d Usec:%08d\n", u32TickCount_ms, sSessionInfo.u32Counter,
+			(uint32)(u64TimerUtil_readUsec() - sTxRxTrnsInfo.u64BeginUsec));
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
+
+	//==========================================================================
+	// 認証成功時のイベント処理
+	//==========================================================================
+	// 成功イベント
+	iEntrySeqEvt(sTxRxTrnsInfo.eOkAppEvt);
+	//==========================================================================
+	// トランザクション終了処理
+	//==========================================================================
+	// 通信トランザクション終了処理
+	vEvt_EndTxRxTrns(&sTxRxTrnsInfo);
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvent_ClearSession
+ *
+ * DESCRIPTION:セッション情報のクリア
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+PUBLIC void vEvent_ClearSession() {
+	vAuth_clearSession(&sSessionInfo);
+}
+
 /******************************************************************************/
 /***        Local Functions                                                 ***/
 /******************************************************************************/
@@ -1107,9 +1377,7 @@ PRIVATE bool_t bEvt_RxDefaultChk(tsRxTxInfo* psRxInfo) {
 	// 受信メッセージ
 	tsWirelessMsg* psWlsMsg = &psRxInfo->sMsg;
 	// CRCチェック
-	uint8 u8WkCRC = psWlsMsg->u8CRC;
-	psWlsMsg->u8CRC = 0;
-	if (u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE) != u8WkCRC) {
+	if (u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE) != psWlsMsg->u16CRC) {
 		iEEPROMWriteLog(E_MSG_CD_RX_CRC_ERR, psWlsMsg->u8Command);
 		return FALSE;
 	}
@@ -1119,6 +1387,9 @@ PRIVATE bool_t bEvt_RxDefaultChk(tsRxTxInfo* psRxInfo) {
 	case E_APP_CMD_UNLOCK:		// 送受信コマンド：開錠要求
 	case E_APP_CMD_LOCK:		// 送受信コマンド：通常施錠要求
 	case E_APP_CMD_ALERT:		// 送受信コマンド：警戒施錠要求
+	case E_APP_CMD_SES_UNLOCK:	// 送受信コマンド：セッション開錠要求
+	case E_APP_CMD_SES_LOCK:	// 送受信コマンド：セッション施錠要求
+	case E_APP_CMD_SES_ALERT:	// 送受信コマンド：セッション警戒施錠要求
 	case E_APP_CMD_MST_UNLOCK:	// 送受信コマンド：マスター開錠要求
 		break;
 	default:
@@ -1144,10 +1415,212 @@ PRIVATE bool_t bEvt_RxDefaultChk(tsRxTxInfo* psRxInfo) {
  *
  ******************************************************************************/
 PRIVATE uint32 u32Evt_getElapsedTime(tsAuthRemoteDevInfo* psRemoteInfo, DS3231_datetime* psDateTime) {
+	return u32Evt_getEpochMin(psDateTime) - psRemoteInfo->u32StartDateTime;
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32Evt_getEpochMin
+ *
+ * DESCRIPTION:紀元からの分数の算出処理
+ *
+ * PARAMETERS:           Name            RW  Usage
+ * DS3231_datetime*      psDateTime      R   日時
+ *
+ * RETURNS:
+ *   紀元からの分数
+ *
+ ******************************************************************************/
+PRIVATE uint32 u32Evt_getEpochMin(DS3231_datetime* psDateTime) {
 	uint32 u32To = u32ValUtil_dateToDays(psDateTime->u16Year, psDateTime->u8Month, psDateTime->u8Day);
 	u32To = u32To * 24 * 60;
-	u32To = u32To + psDateTime->u8Hour * 60 + psDateTime->u8Minutes;
-	return u32To - psRemoteInfo->u32StartDateTime;
+	return u32To + psDateTime->u8Hour * 60 + psDateTime->u8Minutes;
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvt_PrecalcEntry
+ *
+ * DESCRIPTION:認証事前計算キャッシュの登録
+ *   認証成功時に生成した次回の認証トークンを先頭に登録し、最も古いものを破棄する
+ *
+ * PARAMETERS:           Name            RW  Usage
+ * tsAuthRemoteDevInfo*  psRemoteInfo    R   更新後のリモートデバイス情報
+ * uint8                 u8AuthStCnt     R   次回の認証ストレッチング回数（送信側）
+ * uint8*                pu8AuthTkn      R   次回の認証トークン
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+PRIVATE void vEvt_PrecalcEntry(tsAuthRemoteDevInfo* psRemoteInfo, uint8 u8AuthStCnt, uint8* pu8AuthTkn) {
+	// 同一デバイスのエントリ、または末尾のエントリを探索
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < APP_AUTH_PRECALC_SIZE - 1; u8Idx++) {
+		if (sAuthPrecalc[u8Idx].u32DeviceID == psRemoteInfo->u32DeviceID) {
+			break;
+		}
+	}
+	// 先頭までのエントリを後ろにずらす
+	for (; u8Idx > 0; u8Idx--) {
+		sAuthPrecalc[u8Idx] = sAuthPrecalc[u8Idx - 1];
+	}
+	// 先頭エントリの編集
+	tsAppAuthPrecalc* psPrecalc = &sAuthPrecalc[0];
+	memset(psPrecalc, 0x00, sizeof(tsAppAuthPrecalc));
+	psPrecalc->eStatus          = E_APP_PRECALC_STS_INIT;
+	psPrecalc->u32DeviceID      = psRemoteInfo->u32DeviceID;
+	psPrecalc->u32StartDateTime = psRemoteInfo->u32StartDateTime;
+	memcpy(psPrecalc->u8SyncToken, psRemoteInfo->u8SyncToken, APP_AUTH_TOKEN_SIZE);
+	memcpy(psPrecalc->u8AuthCode, psRemoteInfo->u8AuthCode, APP_AUTH_TOKEN_SIZE);
+	psPrecalc->u8RcvStretching  = psRemoteInfo->u8RcvStretching;
+	psPrecalc->u8AuthStCnt      = u8AuthStCnt;
+	memcpy(psPrecalc->u8AuthTkn, pu8AuthTkn, APP_AUTH_TOKEN_SIZE);
+}
+
+/*******************************************************************************
+ *
+ * NAME: psEvt_PrecalcMatch
+ *
+ * DESCRIPTION:認証事前計算キャッシュの照合
+ *
+ * PARAMETERS:           Name            RW  Usage
+ * tsAuthRemoteDevInfo*  psRemoteInfo    R   リモートデバイス情報
+ * uint8                 u8AuthStCnt     R   受信した認証ストレッチング回数
+ *
+ * RETURNS:
+ *   一致したキャッシュ、一致しない場合はNULL
+ *
+ * NOTES:
+ *   EEPROM上の認証情報と一致しない場合には利用しない
+ ******************************************************************************/
+PRIVATE tsAppAuthPrecalc* psEvt_PrecalcMatch(tsAuthRemoteDevInfo* psRemoteInfo, uint8 u8AuthStCnt) {
+	tsAppAuthPrecalc* psPrecalc;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < APP_AUTH_PRECALC_SIZE; u8Idx++) {
+		psPrecalc = &sAuthPrecalc[u8Idx];
+		if (psPrecalc->eStatus == E_APP_PRECALC_STS_EMPTY
+				|| psPrecalc->u32DeviceID != psRemoteInfo->u32DeviceID) {
+			continue;
+		}
+		if (psPrecalc->u32StartDateTime != psRemoteInfo->u32StartDateTime
+				|| psPrecalc->u8RcvStretching != psRemoteInfo->u8RcvStretching
+				|| psPrecalc->u8AuthStCnt != u8AuthStCnt
+				|| memcmp(psPrecalc->u8SyncToken, psRemoteInfo->u8SyncToken, APP_AUTH_TOKEN_SIZE) != 0
+				|| memcmp(psPrecalc->u8AuthCode, psRemoteInfo->u8AuthCode, APP_AUTH_TOKEN_SIZE) != 0) {
+			return NULL;
+		}
+		return psPrecalc;
+	}
+	return NULL;
+}
+
+/*******************************************************************************
+ *
+ * NAME: bEvt_PrecalcRespTkn
+ *
+ * DESCRIPTION:認証事前計算済みの返信トークン取得
+ *
+ * PARAMETERS:           Name            RW  Usage
+ * tsAppAuthPrecalc*     psPrecalc       R   認証事前計算キャッシュ
+ * uint32                u32ElapsedMin   R   経過時間（分単位）
+ * uint8*                pu8RespTkn      W   返信トークン
+ *
+ * RETURNS:
+ *   TRUE:計算済み
+ *
+ ******************************************************************************/
+PRIVATE bool_t bEvt_PrecalcRespTkn(tsAppAuthPrecalc* psPrecalc, uint32 u32ElapsedMin, uint8* pu8RespTkn) {
+	if (psPrecalc->eStatus != E_APP_PRECALC_STS_READY) {
+		return FALSE;
+	}
+	// 基準分
+	if (psPrecalc->bCurValid && u32ElapsedMin == psPrecalc->u32RespMin) {
+		memcpy(pu8RespTkn, psPrecalc->u8RespTknCur, APP_AUTH_TOKEN_SIZE);
+		return TRUE;
+	}
+	// 基準分の次の分（計算後に分が切り替わった場合）
+	if (u32ElapsedMin == psPrecalc->u32RespMin + 1) {
+		memcpy(pu8RespTkn, psPrecalc->u8RespTknNext, APP_AUTH_TOKEN_SIZE);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvt_PrecalcStep
+ *
+ * DESCRIPTION:認証事前計算の実行
+ *
+ * PARAMETERS:           Name            RW  Usage
+ * tsAppAuthPrecalc*     psPrecalc       RW  認証事前計算キャッシュ
+ * uint32                u32NowMin       R   現在の経過時間（分単位）
+ * uint8                 u8Rounds        R   今回のストレッチング回数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *   分mの返信トークンは認証コードをu16Auth_convToRespStCnt(m)回ハッシュ化した値
+ *   なので、次の分のトークンを１回ハッシュ化すると現在分のトークンになる。
+ *   数分先のアンカー（途中ハッシュ）を保持し、毎分の計算をアンカーからの
+ *   差分回数だけに抑える。
+ ******************************************************************************/
+PRIVATE void vEvt_PrecalcStep(tsAppAuthPrecalc* psPrecalc, uint32 u32NowMin, uint8 u8Rounds) {
+	//==========================================================================
+	// 基準分の切り替え
+	//==========================================================================
+	uint32 u32NextMin = u32NowMin + 1;
+	uint16 u16NextCnt = u16Auth_convToRespStCnt(u32NextMin);
+	if (psPrecalc->eStatus == E_APP_PRECALC_STS_INIT
+			|| psPrecalc->eStatus == E_APP_PRECALC_STS_READY || psPrecalc->u32RespMin != u32NowMin) {
+		psPrecalc->u32RespMin = u32NowMin;
+		// アンカーの有効判定（同一周期内で、次の分より先のアンカーであること）
+		if (psPrecalc->eStatus == E_APP_PRECALC_STS_INIT
+				|| (psPrecalc->u32AnchorMin / APP_HASH_STRETCHING_CNT_BASE) != (u32NextMin / APP_HASH_STRETCHING_CNT_BASE)
+				|| u16NextCnt < psPrecalc->sAnchorState.u16StCntEnd) {
+			// アンカーの対象分（周期を跨がない範囲）
+			uint32 u32AnchorMin = u32NextMin + APP_AUTH_PRECALC_AHEAD_MIN;
+			if ((u32AnchorMin / APP_HASH_STRETCHING_CNT_BASE) != (u32NextMin / APP_HASH_STRETCHING_CNT_BASE)) {
+				u32AnchorMin = u32NextMin - (u32NextMin % APP_HASH_STRETCHING_CNT_BASE) + APP_HASH_STRETCHING_CNT_BASE - 1;
+			}
+			psPrecalc->u32AnchorMin = u32AnchorMin;
+			psPrecalc->sAnchorState =
+				sAuth_generateHashInfo(psPrecalc->u8AuthCode, u16Auth_convToRespStCnt(u32AnchorMin));
+			vAuth_setSyncToken(&psPrecalc->sAnchorState, psPrecalc->u8SyncToken);
+		}
+		psPrecalc->eStatus = E_APP_PRECALC_STS_ANCHOR;
+	}
+
+	//==========================================================================
+	// ストレッチング処理
+	//==========================================================================
+	tsAuthHashGenState* psRespState = &psPrecalc->sRespState;
+	for (; u8Rounds > 0; u8Rounds--) {
+		if (psPrecalc->eStatus == E_APP_PRECALC_STS_ANCHOR) {
+			// アンカー生成
+			if (bAuth_hashStretching(&psPrecalc->sAnchorState)) {
+				// アンカーから次の分の返信トークンを生成
+				*psRespState = sAuth_generateHashInfo(psPrecalc->sAnchorState.u8HashCode,
+						u16NextCnt - psPrecalc->sAnchorState.u16StCntEnd);
+				vAuth_setSyncToken(psRespState, psPrecalc->u8SyncToken);
+				psPrecalc->eStatus = E_APP_PRECALC_STS_DERIVE;
+			}
+			continue;
+		}
+		// 返信トークン生成
+		if (bAuth_hashStretching(psRespState)) {
+			memcpy(psPrecalc->u8RespTknNext, psRespState->u8HashCode, APP_AUTH_TOKEN_SIZE);
+			// 現在分の返信トークン（周期の境界を跨ぐ場合は生成しない）
+			psPrecalc->bCurValid = ((u32NextMin % APP_HASH_STRETCHING_CNT_BASE) != 0);
+			if (psPrecalc->bCurValid) {
+				psRespState->u16StCntEnd++;
+				bAuth_hashStretching(psRespState);
+				memcpy(psPrecalc->u8RespTknCur, psRespState->u8HashCode, APP_AUTH_TOKEN_SIZE);
+			}
+			psPrecalc->eStatus = E_APP_PRECALC_STS_READY;
+			return;
+		}
+	}
 }
 
 /*******************************************************************************
@@ -1165,25 +1638,73 @@ PRIVATE uint32 u32Evt_getElapsedTime(tsAuthRemoteDevInfo* psRemoteInfo, DS3231_d
  ******************************************************************************/
 PRIVATE bool_t bEvt_TxResponse(teAppCommand eCommand, bool_t bEncryption) {
 	// 電文の編集
-	tsWirelessMsg sWlsMsg;
-	memset(&sWlsMsg, 0x00, sizeof(tsWirelessMsg));
-	sWlsMsg.u32DstAddr  = sTxRxTrnsInfo.u32DstAddr;		// 宛先アドレス
-	sWlsMsg.u8Command   = eCommand;						// ACK/NACKコマンド
-	sWlsMsg.u16Year     = sAppIO.sDatetime.u16Year;		// 年
-	sWlsMsg.u8Month     = sAppIO.sDatetime.u8Month;		// 月
-	sWlsMsg.u8Day       = sAppIO.sDatetime.u8Day;		// 日
-	sWlsMsg.u8Hour      = sAppIO.sDatetime.u8Hour;		// 時
-	sWlsMsg.u8Minute    = sAppIO.sDatetime.u8Minutes;	// 分
-	sWlsMsg.u8Second    = sAppIO.sDatetime.u8Seconds;	// 秒
-	sWlsMsg.u8StatusMap = sDevInfo.u8StatusMap;			// ステータスマップ
-	// CRC8編集
-	sWlsMsg.u8CRC = u8CCITT8((uint8*)&sWlsMsg, TX_REC_SIZE);
+	tsWirelessMsg* psWlsMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, bEncryption);
+	if (psWlsMsg == NULL) {
+		// エラー処理
+		iEEPROMWriteLog(E_MSG_CD_TX_ERR, eCommand);
+		return FALSE;
+	}
+	psWlsMsg->u32DstAddr  = sTxRxTrnsInfo.u32DstAddr;		// 宛先アドレス
+	psWlsMsg->u8Command   = eCommand;						// ACK/NACKコマンド
+	psWlsMsg->u16Year     = sAppIO.sDatetime.u16Year;		// 年
+	psWlsMsg->u8Month     = sAppIO.sDatetime.u8Month;		// 月
+	psWlsMsg->u8Day       = sAppIO.sDatetime.u8Day;		// 日
+	psWlsMsg->u8Hour      = sAppIO.sDatetime.u8Hour;		// 時
+	psWlsMsg->u8Minute    = sAppIO.sDatetime.u8Minutes;	// 分
+	psWlsMsg->u8Second    = sAppIO.sDatetime.u8Seconds;	// 秒
+	psWlsMsg->u8StatusMap = sDevInfo.u8StatusMap;			// ステータスマップ
+	// CRC16編集
+	psWlsMsg->u16CRC = u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE);
 	// 電文の送信
-	if (bWirelessTxEnq(sDevInfo.u32DeviceID, bEncryption, &sWlsMsg) ==  FALSE) {
+	vWirelessTxCommit(psWlsMsg);
+	// イベントタスク登録：メッセージ送信
+	return (iEntrySeqEvt(E_EVENT_TX_DATA) >= 0);
+}
+
+/*******************************************************************************
+ *
+ * NAME: bEvt_TxSessionResponse
+ *
+ * DESCRIPTION:セッション認証付きのACK/NACK返信送信
+ *
+ * PARAMETERS:        Name            RW  Usage
+ *   teAppCommand     eCommand        R   返信コマンド
+ *   uint32           u32Counter      R   セッションカウンタ
+ *
+ * RETURNS:
+ *   TRUE:返信成功
+ *
+ * NOTES:
+ * 返信コマンドとカウンタに対するセッショントークンを編集し、セッションキーで暗号化する。
+ * 送信側はセッションキーで検証できたNACKの場合のみセッションを破棄する。
+ ******************************************************************************/
+PRIVATE bool_t bEvt_TxSessionResponse(teAppCommand eCommand, uint32 u32Counter) {
+	// 電文の編集
+	tsWirelessMsg* psWlsMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, TRUE);
+	if (psWlsMsg == NULL) {
 		// エラー処理
 		iEEPROMWriteLog(E_MSG_CD_TX_ERR, eCommand);
 		return FALSE;
 	}
+	psWlsMsg->u32DstAddr  = sTxRxTrnsInfo.u32DstAddr;		// 宛先アドレス
+	psWlsMsg->u32SyncVal  = u32Counter;						// セッションカウンタ
+	psWlsMsg->u8Command   = eCommand;						// ACK/NACKコマンド
+	// レスポンストークン
+	vAuth_editSessionTkn(psWlsMsg->u8AuthToken, &sSessionInfo, sTxRxTrnsInfo.u32DstAddr, u32Counter, eCommand);
+	// 返信データ
+	psWlsMsg->u16Year     = sAppIO.sDatetime.u16Year;		// 年
+	psWlsMsg->u8Month     = sAppIO.sDatetime.u8Month;		// 月
+	psWlsMsg->u8Day       = sAppIO.sDatetime.u8Day;		// 日
+	psWlsMsg->u8Hour      = sAppIO.sDatetime.u8Hour;		// 時
+	psWlsMsg->u8Minute    = sAppIO.sDatetime.u8Minutes;	// 分
+	psWlsMsg->u8Second    = sAppIO.sDatetime.u8Seconds;	// 秒
+	psWlsMsg->u8StatusMap = sDevInfo.u8StatusMap;			// ステータスマップ
+	// 暗号化領域の暗号化
+	vWirelessEncrypt(psWlsMsg, sSessionInfo.u8SessionKey);
+	// CRC16編集
+	psWlsMsg->u16CRC = u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE);
+	// 電文の送信
+	vWirelessTxCommit(psWlsMsg);
 	// イベントタスク登録：メッセージ送信
 	return (iEntrySeqEvt(E_EVENT_TX_DATA) >= 0);
 }
@@ -1207,6 +1728,7 @@ PRIVATE void vEvt_BeginTxRxTrns(tsAppTxRxTrnsInfo* psTxRxTrnsInfo, tsRxTxInfo* p
 	psTxRxTrnsInfo->sRefDatetime = sAppIO.sDatetime;	// 基準時刻
 	psTxRxTrnsInfo->u32DstAddr   = psRxInfo->u32Addr;	// 送信元アドレス
 	psTxRxTrnsInfo->sRxWlsMsg    = psRxInfo->sMsg;		// 受信メッセージ
+	psTxRxTrnsInfo->u64BeginUsec = u64TimerUtil_readUsec();	// 開始時刻
 }
 
 /*******************************************************************************
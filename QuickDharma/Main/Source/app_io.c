@@ -8,6 +8,13 @@
  * DESCRIPTION:画面表示やキー入力等の基本的な入出力機能のヘッダファイル
  *
  * CHANGE HISTORY:
+ * 2026/10/18 13:00:00 電文の暗号化をAES-CCMによる認証付き暗号に変更
+ * 2026/10/18 17:00:00 送信バッファを送信パケットのスロットプールに変更し、電文をスロット内で直接編集
+ * 2026/10/19 01:00:00 リモートデバイス情報の検索を共通のデバイスディレクトリに変更
+ * 2026/10/19 02:00:00 イベントログをログ構造化リングに変更（インデックス更新無しで周回上書き）
+ * 2026/10/19 03:00:00 イベントログを時刻の差分とメッセージコード等の３バイトの圧縮形式で記録
+ * 2026/10/19 04:00:00 デバイス情報とインデックス情報とリモートデバイス情報の更新をジャーナル経由のトランザクションに変更
+ * 2026/10/19 16:00:00 送信中のスロットを再送せず、送信失敗時のみ送信待ちに戻して再送
  *
  * LAST MODIFIED BY:
  *
@@ -54,6 +61,7 @@
 #include "eeprom.h"
 #include "adxl345.h"
 #include "s11059_02dt.h"
+#include "aes.h"
 #include "app_io.h"
 
 /******************************************************************************/
@@ -71,6 +79,8 @@
 PRIVATE bool_t bEEPROMReadIndexInfo();
 // EEPROM書き込み（インデックス情報）
 PRIVATE bool_t bEEPROMWriteIndexInfo();
+// EEPROMの選択とジャーナルの復元
+PRIVATE bool_t bEEPROMSelect();
 // EEPROM読み込み（リモートデバイス情報の初期処理）
 PRIVATE int iEEPROMRemoteInfoInit();
 
@@ -235,6 +245,10 @@ PUBLIC void vEEPROMInit() {
 	sEEPROM_status.b2ByteAddrFlg = TRUE;
 	sEEPROM_status.u8PageSize    = EEPROM_PAGE_SIZE_64B;
 	sEEPROM_status.u64LastWrite  = u64TimerUtil_readUsec();
+	// イベントログリングの初期化（初回の書き込み時に復元）
+	vLogRing_init(&sAppIOEventLogRing, TOP_ADDR_EVENT_LOG, EVT_LOG_BLOCK_CNT, EVT_LOG_BLOCK_SIZE, EVT_LOG_PAYLOAD_SIZE, FALSE);
+	// ジャーナル付きキーバリューストアの初期化（初回のアクセス時に復元）
+	vKVJournal_init(&sAppIOJournal, TOP_ADDR_JOURNAL, EEPROM_PAGE_SIZE_64B);
 }
 
 /*******************************************************************************
@@ -251,7 +265,9 @@ PUBLIC void vEEPROMInit() {
  ******************************************************************************/
 PUBLIC bool_t bEEPROMReadDevInfo() {
 	// I2C EEPROM Read
-	bEEPROM_deviceSelect(&sEEPROM_status);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
 	return bEEPROM_readData(TOP_ADDR_DEV, sizeof(tsAuthDeviceInfo), (uint8*)&sDevInfo);
 }
 
@@ -276,8 +292,13 @@ PUBLIC bool_t bEEPROMWriteDevInfo(uint8 u8StatusMapMask) {
 	// ステータスマップの更新
 	sDevInfo.u8StatusMap = sDevInfo.u8StatusMap | u8StatusMapMask;
 	// I2C EEPROM Write
-	bEEPROM_deviceSelect(&sEEPROM_status);
-	return bEEPROM_writeData(TOP_ADDR_DEV, sizeof(tsAuthDeviceInfo), (uint8*)&sDevInfo);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
+	// ジャーナル経由で書き込み（内容が変わらないページは書き込まない）
+	vKVJournal_begin(&sAppIOJournal);
+	bKVJournal_put(&sAppIOJournal, TOP_ADDR_DEV, (uint8*)&sDevInfo, sizeof(tsAuthDeviceInfo));
+	return bKVJournal_commit(&sAppIOJournal);
 }
 
 /*******************************************************************************
@@ -294,15 +315,8 @@ PUBLIC bool_t bEEPROMWriteDevInfo(uint8 u8StatusMapMask) {
  *
  ******************************************************************************/
 PUBLIC int iEEPROMIndexOfRemoteInfo(uint32 u32DeviceID) {
-	// ローカルインデックスキャッシュ探索
-	uint8 u8Idx;
-	for (u8Idx = 0; u8Idx < sAppIOIndexCache.u8RemoteDevCnt; u8Idx++) {
-		if (sAppIOIndexCache.u32RemoteDevID[u8Idx] == u32DeviceID) {
-			return sAppIOIndexCache.u8RemoteDevIdx[u8Idx];
-		}
-	}
-	// 対象レコード無し
-	return -1;
+	// デバイスディレクトリ探索（対象レコード無しの場合は-1）
+	return iDevDir_indexOf(&sAppIODevDir, u32DeviceID);
 }
 
 /*******************************************************************************
@@ -367,7 +381,8 @@ PUBLIC int iEEPROMReadRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo, uint8 u8Idx)
 PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
 	// レコードインデックス探索
 	int iIdx = iEEPROMIndexOfRemoteInfo(psRemoteInfo->u32DeviceID);
-	if (iIdx < 0) {
+	bool_t bNewFlg = (iIdx < 0);
+	if (bNewFlg) {
 		// 空き領域の有無判定
 		if (sIndexInfo.u32RemoteDevMap == 0xFFFFFFFF) {
 			return -1;
@@ -378,15 +393,6 @@ PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
 				break;
 			}
 		}
-		// インデックス情報更新
-		sIndexInfo.u32RemoteDevMap = sIndexInfo.u32RemoteDevMap | (0x00000001 << iIdx);
-		if (!bEEPROMWriteIndexInfo(&sIndexInfo)) {
-			return -2;
-		}
-		// ローカルインデックスキャッシュ更新
-		sAppIOIndexCache.u8RemoteDevIdx[sAppIOIndexCache.u8RemoteDevCnt] = iIdx;
-		sAppIOIndexCache.u32RemoteDevID[sAppIOIndexCache.u8RemoteDevCnt] = psRemoteInfo->u32DeviceID;
-		sAppIOIndexCache.u8RemoteDevCnt++;
 	}
 	// マスキング処理
 	vValUtil_masking(psRemoteInfo->u8AuthCode, sAppIO.u8MstTokenMask, APP_AUTH_TOKEN_SIZE);
@@ -396,13 +402,27 @@ PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
 			u8ValUtil_masking(psRemoteInfo->u8SndStretching, sAppIO.u8MstTokenMask, APP_AUTH_TOKEN_SIZE);
 	psRemoteInfo->u8RcvStretching =
 			u8ValUtil_masking(psRemoteInfo->u8RcvStretching, sAppIO.u8MstTokenMask, APP_AUTH_TOKEN_SIZE);
-	// I2C EEPROM Write
+	// インデックス情報とレコードを１トランザクションで書き込み
+	vKVJournal_begin(&sAppIOJournal);
+	if (bNewFlg) {
+		sIndexInfo.u32RemoteDevMap = sIndexInfo.u32RemoteDevMap | (0x00000001 << iIdx);
+		bKVJournal_put(&sAppIOJournal, TOP_ADDR_INDEX, (uint8 *)&sIndexInfo, sizeof(tsAppIOIndexInfo));
+	}
 	uint32 u32Size = sizeof(tsAuthRemoteDevInfo);
 	uint32 u32Addr = TOP_ADDR_REMOTE_DEV + u32Size * iIdx;
-	bEEPROM_deviceSelect(&sEEPROM_status);
-	if (!bEEPROM_writeData(u32Addr, u32Size, (uint8 *)psRemoteInfo)) {
+	bKVJournal_put(&sAppIOJournal, u32Addr, (uint8 *)psRemoteInfo, u32Size);
+	// I2C EEPROM Write
+	if (!bEEPROMSelect() || !bKVJournal_commit(&sAppIOJournal)) {
+		if (bNewFlg) {
+			sIndexInfo.u32RemoteDevMap = sIndexInfo.u32RemoteDevMap & ~(0x00000001 << iIdx);
+			return -2;
+		}
 		return -3;
 	}
+	// デバイスディレクトリ更新
+	if (bNewFlg) {
+		bDevDir_add(&sAppIODevDir, psRemoteInfo->u32DeviceID, (uint8)iIdx);
+	}
 	return iIdx;
 }
 
@@ -417,40 +437,37 @@ PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
  *   uint8               u8Cmd             R   コマンド
  *
  * RETURNS:
- *   int 書き込みレコードインデックス、読み込めない場合はマイナス値
+ *   int 書き込みエントリ位置、エラー時はマイナス値（-1:ログリング復元エラー、-2:書き込みエラー）
  *
+ * NOTES:
+ * ログが一杯の場合は最も古いログを上書きする
+ * インデックス情報は更新しない
  ******************************************************************************/
 PUBLIC int iEEPROMWriteLog(uint16 u16MsgCd, uint8 u8Cmd) {
-	// ログ数の判定
-	if (sIndexInfo.u8EventLogCnt >= MAX_EVT_LOG_CNT) {
+	// イベントログリングの復元（未復元の場合のみ）
+	bEEPROM_deviceSelect(&sEEPROM_status);
+	if (sAppIOEventLogRing.bValid == FALSE && bLogRing_recover(&sAppIOEventLogRing) == FALSE) {
 		return -1;
 	}
-	// インデックス情報更新
-	sIndexInfo.u8EventLogCnt++;
-	if (bEEPROMWriteIndexInfo(&sIndexInfo) == FALSE) {
-		return -2;
+	// イベントログ編集（日時は基準年からの経過秒数、無効な日時は直前のログと同じ時刻とする）
+	uint32 u32Key = LOG_RING_KEY_NONE;
+	uint8 u8LogData[EVT_LOG_PAYLOAD_SIZE];
+	u8LogData[0] = (uint8)u16MsgCd | EVT_LOG_TIME_INVALID;	// メッセージコード
+	u8LogData[1] = u8Cmd;	// コマンド
+	u8LogData[2] = sDevInfo.u8StatusMap;	// ステータスマップ
+	if (bValUtil_validDate(sAppIO.sDatetime.u16Year, sAppIO.sDatetime.u8Month, sAppIO.sDatetime.u8Day) &&
+		bValUtil_validTime(sAppIO.sDatetime.u8Hour, sAppIO.sDatetime.u8Minutes, sAppIO.sDatetime.u8Seconds) &&
+		sAppIO.sDatetime.u16Year >= VAL_UTIL_EPOCH_YEAR && sAppIO.sDatetime.u16Year < VAL_UTIL_EPOCH_YEAR_LIMIT) {
+		u32Key = u32ValUtil_datetimeToSec(sAppIO.sDatetime.u16Year, sAppIO.sDatetime.u8Month, sAppIO.sDatetime.u8Day,
+										  sAppIO.sDatetime.u8Hour, sAppIO.sDatetime.u8Minutes, sAppIO.sDatetime.u8Seconds);
+		u8LogData[0] = (uint8)u16MsgCd;
 	}
-	// イベントログ編集
-	tsAppIOEventLog sAppIOEventLog;
-	memset(&sAppIOEventLog, 0x00, sizeof(tsAppIOEventLog));
-	sAppIOEventLog.u8SeqNo     = sIndexInfo.u8EventLogCnt - 1;	// シーケンス番号
-	sAppIOEventLog.u16MsgCd    = u16MsgCd;						// メッセージコード
-	sAppIOEventLog.u8Command   = u8Cmd;							// コマンド
-	sAppIOEventLog.u8StatusMap = sDevInfo.u8StatusMap;			// ステータスマップ
-	sAppIOEventLog.u16Year     = sAppIO.sDatetime.u16Year;		// イベント発生日（年）
-	sAppIOEventLog.u8Month     = sAppIO.sDatetime.u8Month;		// イベント発生日（月）
-	sAppIOEventLog.u8Day       = sAppIO.sDatetime.u8Day;		// イベント発生日（日）
-	sAppIOEventLog.u8Hour      = sAppIO.sDatetime.u8Hour;		// イベント発生時刻（時）
-	sAppIOEventLog.u8Minute    = sAppIO.sDatetime.u8Minutes;	// イベント発生時刻（分）
-	sAppIOEventLog.u8Second    = sAppIO.sDatetime.u8Seconds;	// イベント発生時刻（秒）
 	// I2C EEPROM Write
-	uint32 u32Size = sizeof(tsAppIOEventLog);
-	uint32 u32Addr = TOP_ADDR_EVENT_LOG + u32Size * sAppIOEventLog.u8SeqNo;
-	bEEPROM_deviceSelect(&sEEPROM_status);
-	if (bEEPROM_writeData(u32Addr, u32Size, (uint8*)&sAppIOEventLog) == FALSE) {
-		return -3;
+	int iIdx = iLogRing_append(&sAppIOEventLogRing, u32Key, u8LogData, EVT_LOG_PAYLOAD_SIZE);
+	if (iIdx < 0) {
+		return -2;
 	}
-	return sAppIOEventLog.u8SeqNo;
+	return iIdx;
 }
 
 /*******************************************************************************
@@ -680,35 +697,75 @@ PUBLIC bool_t bWirelessRxDeq(tsRxTxInfo* psRxInfo) {
 
 /*******************************************************************************
  *
- * NAME: bWirelessTxEnq
+ * NAME: psWirelessTxAlloc
  *
- * DESCRIPTION:無線通信によるメッセージ送信電文バッファリング
+ * DESCRIPTION:送信スロットの確保
  *
  * PARAMETERS:          Name           RW  Usage
  *     uint32           u32SrcAddr     R   送信元アドレス
  *     bool_t           bEncryption    R   暗号化有無（事前にパスワード設定が必要？）
- *     tsWirelessMsg*   psMsg          R   送信データ
  *
  * RETURNS:
- *     TRUE:送信成功
+ *     tsWirelessMsg*   編集対象の電文（ゼロクリア済み）、空きスロットが無い場合はNULL
  *
+ * NOTES:
+ * 呼び出し元は返却された電文を直接編集し、暗号化とCRC編集の後に
+ * vWirelessTxCommitで確定する事
  ******************************************************************************/
-PUBLIC bool_t bWirelessTxEnq(uint32 u32SrcAddr, bool_t bEncryption, tsWirelessMsg* psMsg) {
+PUBLIC tsWirelessMsg* psWirelessTxAlloc(uint32 u32SrcAddr, bool_t bEncryption) {
 	// バッファサイズ判定
 	if (sWirelessInfo.u8TxSize >= TX_BUFFER_SIZE) {
-		return FALSE;
+		return NULL;
 	}
-	// 送信データエンキュー
+	// 送信スロットの確保
 	if (sWirelessInfo.u8TxSize > 0) {
 		sWirelessInfo.u8TxToIdx = (sWirelessInfo.u8TxToIdx + 1) % TX_BUFFER_SIZE;
 	}
 	sWirelessInfo.u8TxSize++;
-	// バッファ編集
-	tsRxTxInfo* pTxInfo;
-	pTxInfo = &sWirelessInfo.sTxBuffer[sWirelessInfo.u8TxToIdx];
-	pTxInfo->u32Addr    = u32SrcAddr;	// 送信元アドレス
-	pTxInfo->sMsg       = *psMsg;		// 電文
-	return TRUE;
+	tsTxSlot* psSlot = &sWirelessInfo.sTxBuffer[sWirelessInfo.u8TxToIdx];
+	psSlot->eStatus = E_TX_SLOT_BUILD;
+	// 送信パケットのヘッダ編集（フレームシーケンスは送信試行毎に編集）
+	tsTxDataApp* psTx = &psSlot->sTx;
+	psTx->u32SrcAddr = u32SrcAddr;					// 送信元アドレス
+	psTx->u32DstAddr = TOCONET_MAC_ADDR_BROADCAST;	// 送信先アドレス（ブロードキャスト）
+	psTx->u8Cmd = TOCONET_PACKET_CMD_APP_DATA;		// パケットタイプ
+	psTx->u8Len = TX_REC_SIZE;						// 送信データ長
+	psTx->bAckReq = FALSE;							// ACK返信有無
+	psTx->bSecurePacket = FALSE;					// 暗号化設定（未実装なのでTRUEにすると暗号化送信のふりをする）
+	psTx->u8Retry = 0x81;							// 再送回数（再送しない）
+	psTx->u16DelayMin = 0;							// 遅延送信時間（最小）
+	psTx->u16DelayMax = 0;							// 遅延送信時間（最大）
+	psTx->u16RetryDur = 0;							// 再送間隔（ミリ秒単位）
+	// 電文のクリア
+	memset(&psSlot->sMsg, 0x00, sizeof(tsWirelessMsg));
+	return &psSlot->sMsg;
+}
+
+/*******************************************************************************
+ *
+ * NAME: vWirelessTxCommit
+ *
+ * DESCRIPTION:送信電文の確定
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          R   psWirelessTxAllocで確保した電文
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 電文を送信パケットのペイロードに1度だけ複写し、以降の送信試行では複写しない
+ ******************************************************************************/
+PUBLIC void vWirelessTxCommit(tsWirelessMsg* psMsg) {
+	tsTxSlot* psSlot;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < TX_BUFFER_SIZE; u8Idx++) {
+		psSlot = &sWirelessInfo.sTxBuffer[u8Idx];
+		if (&psSlot->sMsg == psMsg && psSlot->eStatus == E_TX_SLOT_BUILD) {
+			memcpy(psSlot->sTx.auData, psMsg, TX_REC_SIZE);
+			psSlot->eStatus = E_TX_SLOT_READY;
+			return;
+		}
+	}
 }
 
 /*******************************************************************************
@@ -720,35 +777,44 @@ PUBLIC bool_t bWirelessTxEnq(uint32 u32SrcAddr, bool_t bEncryption, tsWirelessMs
  * PARAMETERS:        Name          RW  Usage
  *
  * RETURNS:
- *   TRUE:送信試行
+ *   TRUE:送信待ちまたは送信中の電文あり（再試行が必要）
  *
+ * NOTES:
+ * 送信待ちの電文を先頭から順に全て送信要求する（編集中の電文以降は次回）。
+ * 送信中の電文は送信完了の通知を待ち、別のコールバックIDで重複して送信しない。
  ******************************************************************************/
 PUBLIC bool_t bWirelessTxTry() {
-	// バッファサイズ判定
-	if (sWirelessInfo.u8TxSize == 0) {
-		return FALSE;
+	bool_t bResult = FALSE;
+	tsTxSlot* psSlot;
+	uint8 u8Cnt;
+	uint8 u8Idx = sWirelessInfo.u8TxFromIdx;
+	for (u8Cnt = 0; u8Cnt < sWirelessInfo.u8TxSize; u8Cnt++) {
+		psSlot = &sWirelessInfo.sTxBuffer[u8Idx];
+		u8Idx = (u8Idx + 1) % TX_BUFFER_SIZE;
+		// 送信完了済みのスロットは対象外
+		if (psSlot->eStatus == E_TX_SLOT_FREE) {
+			continue;
+		}
+		// 編集中の電文を追い越して送信しない
+		if (psSlot->eStatus == E_TX_SLOT_BUILD) {
+			break;
+		}
+		// 送信待ちまたは送信中の電文あり
+		bResult = TRUE;
+		// 送信中の電文は送信完了を待つ（別のコールバックIDで重複送信しない）
+		if (psSlot->eStatus == E_TX_SLOT_IN_FLIGHT) {
+			continue;
+		}
+		// フレームシーケンスの編集
+		psSlot->sTx.u8Seq  = sWirelessInfo.u8TxSeq++;	// フレームシーケンス
+		psSlot->sTx.u8CbId = psSlot->sTx.u8Seq;			// コールバックID（フレームシーケンス指定）
+		// 送信処理
+		if (ToCoNet_bMacTxReq(&psSlot->sTx) == FALSE) {
+			break;
+		}
+		psSlot->eStatus = E_TX_SLOT_IN_FLIGHT;
 	}
-	// バッファ先頭の参照
-	tsRxTxInfo* psTxInfo;
-	psTxInfo = &sWirelessInfo.sTxBuffer[sWirelessInfo.u8RxFromIdx];
-	// 送信パケット編集
-	tsTxDataApp sTx;
-	memset(&sTx, 0x00, sizeof(tsTxDataApp));
-	sTx.u32SrcAddr = psTxInfo->u32Addr;				// 送信元アドレス
-	sTx.u32DstAddr = TOCONET_MAC_ADDR_BROADCAST;	// 送信先アドレス（ブロードキャスト）
-	sTx.u8Cmd = TOCONET_PACKET_CMD_APP_DATA;		// パケットタイプ
-	sTx.u8Seq = sWirelessInfo.u8TxSeq++;			// フレームシーケンス
-	sTx.u8Len = TX_REC_SIZE;						// 送信データ長
-	sTx.u8CbId = sTx.u8Seq;							// コールバックID（フレームシーケンス指定）
-	memcpy(sTx.auData, &psTxInfo->sMsg, sTx.u8Len);	// 送信データ
-	sTx.bAckReq = FALSE;							// ACK返信有無
-	sTx.bSecurePacket = FALSE;						// 暗号化設定（未実装なのでTRUEにすると暗号化送信のふりをする）
-	sTx.u8Retry = 0x81;								// 再送回数（再送しない）
-	sTx.u16DelayMin = 0;							// 遅延送信時間（最小）
-	sTx.u16DelayMax = 0;							// 遅延送信時間（最大）
-	sTx.u16RetryDur = 0;							// 再送間隔（ミリ秒単位）
-	// 送信処理
-	return ToCoNet_bMacTxReq(&sTx);
+	return bResult;
 }
 
 /*******************************************************************************
@@ -762,27 +828,89 @@ PUBLIC bool_t bWirelessTxTry() {
  *       uint8        u8Status      R   送信ステータス、(u8Status & 0x01)が1:成功、0:失敗
  *
  * RETURNS:
- *   TRUE:送信試行
+ *   TRUE:送信完了
  *
+ * NOTES:
+ * 送信失敗時はスロットを送信待ちに戻し、次回の送信試行で再送する
  ******************************************************************************/
 PUBLIC bool_t bWirelessTxComplete(uint8 u8CbId, uint8 u8Status) {
-	// 送信完了判定
-	if ((u8Status & 0x01) == 0x00) {
+	// コールバックIDに対応する送信中のスロットを探索
+	tsTxSlot* psSlot;
+	uint8 u8Cnt;
+	uint8 u8Idx = sWirelessInfo.u8TxFromIdx;
+	for (u8Cnt = 0; u8Cnt < sWirelessInfo.u8TxSize; u8Cnt++) {
+		psSlot = &sWirelessInfo.sTxBuffer[u8Idx];
+		if (psSlot->eStatus == E_TX_SLOT_IN_FLIGHT && psSlot->sTx.u8CbId == u8CbId) {
+			break;
+		}
+		u8Idx = (u8Idx + 1) % TX_BUFFER_SIZE;
+	}
+	if (u8Cnt >= sWirelessInfo.u8TxSize) {
 		return FALSE;
 	}
-	// コールバックIDチェック
-	if (u8CbId != (sWirelessInfo.u8TxSeq - sWirelessInfo.u8TxSize)) {
+	// 送信失敗時は再送対象に戻す
+	if ((u8Status & 0x01) == 0x00) {
+		psSlot->eStatus = E_TX_SLOT_READY;
 		return FALSE;
 	}
-	// 送信キューの更新
-	sWirelessInfo.u8TxSize--;
-	if (sWirelessInfo.u8TxSize > 0) {
-		sWirelessInfo.u8RxFromIdx = (sWirelessInfo.u8RxFromIdx + 1) % TX_BUFFER_SIZE;
+	// スロットを解放
+	psSlot->eStatus = E_TX_SLOT_FREE;
+	// 先頭から解放済みのスロットを送信キューから除外
+	while (sWirelessInfo.u8TxSize > 0
+			&& sWirelessInfo.sTxBuffer[sWirelessInfo.u8TxFromIdx].eStatus == E_TX_SLOT_FREE) {
+		sWirelessInfo.u8TxSize--;
+		if (sWirelessInfo.u8TxSize > 0) {
+			sWirelessInfo.u8TxFromIdx = (sWirelessInfo.u8TxFromIdx + 1) % TX_BUFFER_SIZE;
+		}
 	}
 	// 送信完了
 	return TRUE;
 }
 
+/*******************************************************************************
+ *
+ * NAME: vWirelessEncrypt
+ *
+ * DESCRIPTION:電文の暗号化処理（AES-CCMによる認証付き暗号）
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          RW  送信電文
+ *     uint8*           pu8Key         R   暗号鍵（256bit）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 宛先アドレス・同期乱数・コマンドをノンスとして改竄検知の対象に含め、
+ * 暗号化領域の暗号化と認証タグの生成を1回の走査で行う
+ ******************************************************************************/
+PUBLIC void vWirelessEncrypt(tsWirelessMsg* psMsg, uint8* pu8Key) {
+	tsAES_state sAES_state = vAES_newCCMState(AES_KEY_LEN_256, pu8Key);
+	vAES_encryptCCM(&sAES_state, (uint8*)psMsg, TX_NONCE_SIZE, NULL, 0,
+			&psMsg->u8AuthStCnt, TX_ENC_SIZE, psMsg->u8MIC, TX_MIC_SIZE);
+}
+
+/*******************************************************************************
+ *
+ * NAME: bWirelessDecrypt
+ *
+ * DESCRIPTION:電文の復号化処理（AES-CCMによる認証付き暗号）
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          RW  受信電文
+ *     uint8*           pu8Key         R   暗号鍵（256bit）
+ *
+ * RETURNS:
+ *     TRUE:認証タグ一致
+ *
+ * NOTES:
+ * 認証タグが一致しない場合には暗号化領域はゼロクリアされる
+ ******************************************************************************/
+PUBLIC bool_t bWirelessDecrypt(tsWirelessMsg* psMsg, uint8* pu8Key) {
+	tsAES_state sAES_state = vAES_newCCMState(AES_KEY_LEN_256, pu8Key);
+	return bAES_decryptCCM(&sAES_state, (uint8*)psMsg, TX_NONCE_SIZE, NULL, 0,
+			&psMsg->u8AuthStCnt, TX_ENC_SIZE, psMsg->u8MIC, TX_MIC_SIZE);
+}
+
 /*******************************************************************************
  *
  * NAME: vAccelerationInit
@@ -1035,7 +1163,9 @@ PUBLIC bool_t bColorChange() {
  ******************************************************************************/
 PRIVATE bool_t bEEPROMReadIndexInfo() {
 	// I2C EEPROM Read
-	bEEPROM_deviceSelect(&sEEPROM_status);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
 	bool_t bResult = bEEPROM_readData(TOP_ADDR_INDEX, sizeof(tsAppIOIndexInfo), (uint8*)&sIndexInfo);
 	// レコード有効チェック
 	if (sIndexInfo.u8EnableCheck != 0xAA) {
@@ -1062,8 +1192,35 @@ PRIVATE bool_t bEEPROMReadIndexInfo() {
  ******************************************************************************/
 PRIVATE bool_t bEEPROMWriteIndexInfo() {
 	// I2C EEPROM Write
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
+	// ジャーナル経由で書き込み（内容が変わらないページは書き込まない）
+	vKVJournal_begin(&sAppIOJournal);
+	bKVJournal_put(&sAppIOJournal, TOP_ADDR_INDEX, (uint8 *)&sIndexInfo, sizeof(tsAppIOIndexInfo));
+	return bKVJournal_commit(&sAppIOJournal);
+}
+
+/*******************************************************************************
+ *
+ * NAME: bEEPROMSelect
+ *
+ * DESCRIPTION:EEPROMの選択とジャーナルの復元
+ *
+ * PARAMETERS:          Name         RW  Usage
+ *
+ * RETURNS:
+ *   bool_t TRUE:選択成功
+ *
+ * NOTES:
+ * 電源断等で反映途中のジャーナルが残っている場合は、初回のアクセス時に反映する
+ ******************************************************************************/
+PRIVATE bool_t bEEPROMSelect() {
 	bEEPROM_deviceSelect(&sEEPROM_status);
-	return bEEPROM_writeData(TOP_ADDR_INDEX, sizeof(tsAppIOIndexInfo), (uint8 *)&sIndexInfo);
+	if (sAppIOJournal.bValid == FALSE && !bKVJournal_recover(&sAppIOJournal)) {
+		return FALSE;
+	}
+	return TRUE;
 }
 
 /*******************************************************************************
@@ -1089,8 +1246,8 @@ PRIVATE int iEEPROMRemoteInfoInit() {
 	//==========================================================================
 	// リモートデバイス情報のキャッシュ編集とマスキング
 	//==========================================================================
-	// 構造体の初期化
-	memset(&sAppIOIndexCache, 0x00, sizeof(tsAppIOIndexCache));
+	// デバイスディレクトリの初期化
+	vDevDir_init(&sAppIODevDir, MAX_REMOTE_DEV_CNT);
 	// リモートデバイス情報の読み込み
 	bEEPROM_deviceSelect(&sEEPROM_status);
 	tsAuthRemoteDevInfo wkInfo;
@@ -1109,16 +1266,13 @@ PRIVATE int iEEPROMRemoteInfoInit() {
 			// リトライ
 			continue;
 		}
-		// ローカルインデックスキャッシュ更新
-		sAppIOIndexCache.u8RemoteDevIdx[sAppIOIndexCache.u8RemoteDevCnt] = (uint8)iIdx;
-		sAppIOIndexCache.u32RemoteDevID[sAppIOIndexCache.u8RemoteDevCnt] = wkInfo.u32DeviceID;
+		// デバイスディレクトリ更新
+		bDevDir_add(&sAppIODevDir, wkInfo.u32DeviceID, (uint8)iIdx);
 #ifdef DEBUG
 	vfPrintf(&sSerStream, "MS:%08d iEEPROMRemoteInfoInit Idx:%02d ID:%010d\n", u32TickCount_ms,
-			sAppIOIndexCache.u8RemoteDevIdx[sAppIOIndexCache.u8RemoteDevCnt],
-			sAppIOIndexCache.u32RemoteDevID[sAppIOIndexCache.u8RemoteDevCnt]);
+			iIdx, wkInfo.u32DeviceID);
 	SERIAL_vFlush(sSerStream.u8Device);
 #endif
-		sAppIOIndexCache.u8RemoteDevCnt++;
 		// リモートデバイス情報の書き込み
 		iEEPROMWriteRemoteInfo(&wkInfo);
 		// インデックス更新
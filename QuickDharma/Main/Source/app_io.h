@@ -8,6 +8,13 @@
  * DESCRIPTION:センサー等との基本的な入出力機能のヘッダファイル
  *
  * CHANGE HISTORY:
+ * 2026/10/18 13:00:00 電文の暗号化をAES-CCMによる認証付き暗号に変更
+ * 2026/10/18 17:00:00 送信バッファを送信パケットのスロットプールに変更し、電文をスロット内で直接編集
+ * 2026/10/18 18:00:00 CRCチェックをCRC-16に変更（FILLER02を廃止してレコード長は維持）
+ * 2026/10/19 01:00:00 インデックス情報キャッシュを共通のデバイスディレクトリに変更
+ * 2026/10/19 02:00:00 イベントログリングを追加し、イベント履歴のレイアウトを12バイトに詰める
+ * 2026/10/19 03:00:00 イベント履歴をイベントログリングから展開する形式に変更
+ * 2026/10/19 04:00:00 ジャーナル付きキーバリューストアを追加
  *
  * LAST MODIFIED BY:
  *
@@ -31,6 +38,9 @@ extern "C" {
 #include "io_util.h"
 #include "ds3231.h"
 #include "eeprom.h"
+#include "log_ring.h"
+#include "kv_journal.h"
+#include "dev_dir.h"
 #include "adxl345.h"
 #include "s11059_02dt.h"
 
@@ -72,6 +82,18 @@ extern "C" {
 // 送信レコードサイズ
 #define TX_REC_SIZE                  (90)
 
+// CRC算出領域サイズ（宛先アドレス～認証タグ）
+#define TX_CRC_SIZE                  (88)
+
+// 暗号化領域サイズ（認証ストレッチング回数～ステータスマップ）
+#define TX_ENC_SIZE                  (75)
+
+// 認証タグサイズ
+#define TX_MIC_SIZE                  (4)
+
+// ノンスサイズ（宛先アドレス、同期乱数、コマンド）
+#define TX_NONCE_SIZE                (9)
+
 // 温度センサー閾値（整数で扱う為に100倍の値）
 #ifndef TEMPERATURE_THRESHOLD
 	#define TEMPERATURE_THRESHOLD      (5500)
@@ -132,33 +154,22 @@ typedef struct {
 typedef struct {
 	uint8 u8EnableCheck;				// 有効チェック（レコード有効時は0xAA）
 	uint32 u32RemoteDevMap;				// リモートデバイス領域マップ
-	uint8 u8EventLogCnt;				// イベント履歴数
+	uint8 u8EventLogCnt;				// イベント履歴数（未使用、イベントログリングで管理）
 	uint8 u8Filler[2];					// 余白
 } tsAppIOIndexInfo;
 
-// 構造体：インデックス情報バッファ
+// 構造体：イベント履歴（EEPROMにはイベントログリングの圧縮形式で記録）
 typedef struct {
-	// リモートデバイス情報数
-	uint8  u8RemoteDevCnt;
-	// リモートデバイス情報インデックスリスト
-	uint8  u8RemoteDevIdx[MAX_REMOTE_DEV_CNT];
-	// リモートデバイスIDリスト
-	uint32 u32RemoteDevID[MAX_REMOTE_DEV_CNT];
-} tsAppIOIndexCache;
-
-// 構造体：イベント履歴
-typedef struct {
-	uint8 u8SeqNo;						// シーケンス番号
 	uint16 u16MsgCd;					// メッセージコード
+	uint16 u16Year;						// イベント発生日（年）
+	uint8 u8SeqNo;						// シーケンス番号
 	uint8 u8Command;					// コマンド
 	uint8 u8StatusMap;					// ステータスマップ
-	uint16 u16Year;						// イベント発生日（年）
 	uint8 u8Month;						// イベント発生日（月）
 	uint8 u8Day;						// イベント発生日（日）
 	uint8 u8Hour;						// イベント発生時刻（時）
 	uint8 u8Minute;						// イベント発生時刻（分）
 	uint8 u8Second;						// イベント発生時刻（秒）
-	uint8 u8Filler[4];					// 余白
 } tsAppIOEventLog;
 
 // 構造体：無線送受信メッセージ
@@ -193,10 +204,10 @@ typedef struct {
 	uint8 u8Second;
 	// ステータスマップ
 	uint8 u8StatusMap;
-	// FILLER02
-	uint8 u8Filler02[5];
-	// CRCチェック
-	uint8 u8CRC;
+	// 認証タグ
+	uint8 u8MIC[TX_MIC_SIZE];
+	// CRCチェック（CRC-16、宛先アドレス～認証タグ）
+	uint16 u16CRC;
 } tsWirelessMsg;
 
 // 構造体：送受信データ
@@ -207,6 +218,24 @@ typedef struct {
 	tsWirelessMsg sMsg;
 } tsRxTxInfo;
 
+// 列挙型：送信スロット状態
+typedef enum {
+	E_TX_SLOT_FREE = 0,		// 未使用
+	E_TX_SLOT_BUILD,		// 電文編集中
+	E_TX_SLOT_READY,		// 送信待ち
+	E_TX_SLOT_IN_FLIGHT		// 送信中（送信完了待ち）
+} teTxSlotStatus;
+
+// 構造体：送信スロット
+typedef struct {
+	// スロット状態
+	teTxSlotStatus eStatus;
+	// 送信パケット（ヘッダはスロット確保時、ペイロードは確定時に編集）
+	tsTxDataApp sTx;
+	// 送信電文（auDataは32bit境界に配置されないので、電文は境界を揃えて保持）
+	tsWirelessMsg sMsg;
+} tsTxSlot;
+
 // 構造体：無線通信情報
 typedef struct {
 	// 宛先アドレス（自デバイス）
@@ -230,7 +259,7 @@ typedef struct {
 	// 送信バッファバッファリングサイズ
 	uint8 u8TxSize;
 	// 送信バッファ
-	tsRxTxInfo sTxBuffer[TX_BUFFER_SIZE];
+	tsTxSlot sTxBuffer[TX_BUFFER_SIZE];
 } tsWirelessInfo;
 
 /******************************************************************************/
@@ -242,14 +271,18 @@ typedef struct {
 /******************************************************************************/
 /** 入出力情報 */
 PUBLIC tsAppIOInfo sAppIO;
-/** 構造体：インデックス情報キャッシュ */
-PUBLIC tsAppIOIndexCache sAppIOIndexCache;
+/** 構造体：リモートデバイスディレクトリ */
+PUBLIC tsDevDir sAppIODevDir;
 /** 無線通信情報 */
 PUBLIC tsWirelessInfo sWirelessInfo;
 /** デバイス情報 */
 PUBLIC tsAuthDeviceInfo sDevInfo;
 /** イベント履歴情報 */
 PUBLIC tsAppIOEventLog sEventLog;
+/** イベントログリング */
+PUBLIC tsLogRing sAppIOEventLogRing;
+/** ジャーナル付きキーバリューストア */
+PUBLIC tsKVJournal sAppIOJournal;
 /** I2C EEPROM情報 */
 PUBLIC tsEEPROM_status sEEPROM_status;
 
@@ -294,12 +327,18 @@ PUBLIC void vWirelessRxDisabled();
 PUBLIC bool_t bWirelessRxEnq(tsRxDataApp *psRx);
 // 受信電文の取り出し
 PUBLIC bool_t bWirelessRxDeq(tsRxTxInfo* psRxInfo);
-// 送信電文のバッファリング
-PUBLIC bool_t bWirelessTxEnq(uint32 u32SrcAddr, bool_t bEncryption, tsWirelessMsg* psMsg);
+// 送信スロットの確保
+PUBLIC tsWirelessMsg* psWirelessTxAlloc(uint32 u32SrcAddr, bool_t bEncryption);
+// 送信電文の確定
+PUBLIC void vWirelessTxCommit(tsWirelessMsg* psMsg);
 // 送信試行
 PUBLIC bool_t bWirelessTxTry();
 // 送信完了
 PUBLIC bool_t bWirelessTxComplete(uint8 u8CbId, uint8 u8Status);
+// 電文の暗号化処理
+PUBLIC void vWirelessEncrypt(tsWirelessMsg* psMsg, uint8* pu8Key);
+// 電文の復号化処理
+PUBLIC bool_t bWirelessDecrypt(tsWirelessMsg* psMsg, uint8* pu8Key);
 // 加速度センサー初期処理
 PUBLIC bool_t bAccelerationInit();
 // 加速度データバッファの更新
@@ -9,6 +9,12 @@
  *
  * CHANGE HISTORY:
  * 2018/01/24 18:48:00 認証時の通信データをAES暗号化
+ * 2026/10/18 11:00:00 認証後の連続コマンドをセッションで実行、往復時間を計測
+ * 2026/10/18 13:00:00 電文をAES-CCMで暗号化し、改竄された電文は復号化直後に破棄
+ * 2026/10/18 18:00:00 電文のCRCチェックをテーブル参照のCRC-16に変更
+ * 2026/10/19 11:00:00 セッションキーで認証できたNACKとトークン不一致の場合のみセッションを破棄
+ * 2026/10/19 15:00:00 CRC-16の編集箇所のコメントを修正
+ * 2026/10/19 16:00:00 送信電文を送信スロット内で直接編集
  *
  * LAST MODIFIED BY:
  *
@@ -38,7 +44,6 @@
 #include "ToCoNet_use_mod.h"
 #include "ToCoNet.h"
 #include "ToCoNet_mod_prototype.h"
-#include "ccitt8.h"
 
 /******************************************************************************/
 /***        User Include files                                              ***/
@@ -46,9 +51,11 @@
 #include "config.h"
 #include "config_default.h"
 #include "framework.h"
+#include "timer_util.h"
 #include "io_util.h"
 #include "aes.h"
 #include "sha256.h"
+#include "crc.h"
 #include "app_event.h"
 #include "app_io.h"
 #include "app_auth.h"
@@ -70,6 +77,10 @@
 PRIVATE void vEvt_InitEvtMap();
 // 受信メッセージ基本チェック
 PRIVATE bool_t bEvt_DefaultMsgChk(tsWirelessMsg* psWlsMsg, teAppCommand eCmd, tsAuthRemoteDevInfo* psRmtDevInfo);
+// セッションNACKの認証
+PRIVATE bool_t bEvt_SessionNackChk(tsWirelessMsg* psWlsMsg);
+// 往復時間の集計
+PRIVATE void vEvt_RecordRtt(teAppRttType eType);
 
 /******************************************************************************/
 /***        Exported Variables                                              ***/
@@ -78,6 +89,8 @@ PRIVATE bool_t bEvt_DefaultMsgChk(tsWirelessMsg* psWlsMsg, teAppCommand eCmd, ts
 /******************************************************************************/
 /***        Local Variables                                                 ***/
 /******************************************************************************/
+/** セッション情報 */
+PRIVATE tsAuthSessionInfo sSessionInfo;
 
 /******************************************************************************/
 /***        Exported Functions                                              ***/
@@ -122,6 +135,8 @@ PUBLIC void vEvent_RegistTask() {
 	bRegisterEvtTask(E_EVENT_EXEC_AUTH_CMD_3, vEvent_Exec_AuthCmd_3);
 	bRegisterEvtTask(E_EVENT_EXEC_AUTH_CMD_4, vEvent_Exec_AuthCmd_4);
 	bRegisterEvtTask(E_EVENT_EXEC_AUTH_CMD_5, vEvent_Exec_AuthCmd_5);
+	bRegisterEvtTask(E_EVENT_EXEC_SES_CMD_0, vEvent_Exec_SesCmd_0);
+	bRegisterEvtTask(E_EVENT_EXEC_SES_CMD_1, vEvent_Exec_SesCmd_1);
 	bRegisterEvtTask(E_EVENT_RX_TIMEOUT, vEvent_RxTimeout);
 	bRegisterEvtTask(E_EVENT_HASH_ST, vEvent_HashStretching);
 
@@ -417,20 +432,25 @@ PUBLIC void vEvent_Exec_Cmd_0(uint32 u32EvtTimeMs) {
 	//==========================================================================
 	// ステータス要求コマンド送信処理
 	//==========================================================================
+	// 送信スロットの確保（電文はスロット内で直接編集）
+	tsWirelessMsg* psWlsMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+	if (psWlsMsg == NULL) {
+		// メッセージ表示
+		vLCDdrawing("Cmd Err ", "Transmit");
+		return;
+	}
 	// 宛先アドレス
-	tsWirelessMsg sWlsMsg;
-	memset(&sWlsMsg, 0x00, sizeof(tsWirelessMsg));
 	sWirelessInfo.u32TgtAddr = sAppTxRxTrns.sRemoteInfo.u32DeviceID;
-	sWlsMsg.u32DstAddr = sAppTxRxTrns.sRemoteInfo.u32DeviceID;
+	psWlsMsg->u32DstAddr = sAppTxRxTrns.sRemoteInfo.u32DeviceID;
 	// コマンド
-	sWlsMsg.u8Command = (uint8)sAppTxRxTrns.eCommand;
-	// CRC8編集
-	sWlsMsg.u8CRC = u8CCITT8((uint8*)&sWlsMsg, TX_REC_SIZE);
+	psWlsMsg->u8Command = (uint8)sAppTxRxTrns.eCommand;
+	// CRC16編集
+	psWlsMsg->u16CRC = u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE);
 	// 送信
-	if (bWirelessTx(sDevInfo.u32DeviceID, FALSE, (uint8*)&sWlsMsg, TX_REC_SIZE) == FALSE) {
+	if (bWirelessTxCommit(psWlsMsg) == FALSE) {
 		// メッセージ表示
 		vLCDdrawing("Cmd Err ", "Transmit");
-		iEEPROMWriteLog(E_MSG_CD_TX_ERR, &sWlsMsg);
+		iEEPROMWriteLog(E_MSG_CD_TX_ERR, psWlsMsg);
 		return;
 	}
 	// 受信待ち設定
@@ -511,6 +531,15 @@ PUBLIC void vEvent_Exec_AuthCmd_0(uint32 u32EvtTimeMs) {
 	//==========================================================================
 	// 初期処理
 	//==========================================================================
+	// コマンド開始時刻
+	sAppTxRxTrns.u64BeginUsec = u64TimerUtil_readUsec();
+	// 有効なセッションがある場合にはセッションコマンドで実行（抑止指定は今回のみ有効）
+	bool_t bSkipSession = sAppTxRxTrns.bSkipSession;
+	sAppTxRxTrns.bSkipSession = FALSE;
+	if (bSkipSession == FALSE && bAuth_isEnableSession(&sSessionInfo, sAppTxRxTrns.sRemoteInfo.u32DeviceID)) {
+		iEntrySeqEvt(E_EVENT_EXEC_SES_CMD_0);
+		return;
+	}
 	// イベントマップ設定
 	sAppEventMap.eEvtBtn_0    = 0x00;
 	sAppEventMap.eEvtBtn_1    = 0x00;
@@ -522,20 +551,27 @@ PUBLIC void vEvent_Exec_AuthCmd_0(uint32 u32EvtTimeMs) {
 	//==========================================================================
 	// ステータス要求コマンド送信処理
 	//==========================================================================
+	// 送信スロットの確保（電文はスロット内で直接編集）
+	tsWirelessMsg* psWlsMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+	if (psWlsMsg == NULL) {
+		// メッセージ表示
+		vLCDdrawing("Cmd Err ", "Transmit");
+		// リモートデバイス選択へ
+		vEvt_InitEvtMap();
+		return;
+	}
 	// 宛先アドレス
-	tsWirelessMsg sWlsMsg;
-	memset(&sWlsMsg, 0x00, sizeof(tsWirelessMsg));
 	sWirelessInfo.u32TgtAddr = sAppTxRxTrns.sRemoteInfo.u32DeviceID;
-	sWlsMsg.u32DstAddr = sAppTxRxTrns.sRemoteInfo.u32DeviceID;
+	psWlsMsg->u32DstAddr = sAppTxRxTrns.sRemoteInfo.u32DeviceID;
 	// コマンド
-	sWlsMsg.u8Command = (uint8)E_APP_CMD_CHK_STATUS;
-	// CRC8編集
-	sWlsMsg.u8CRC = u8CCITT8((uint8*)&sWlsMsg, TX_REC_SIZE);
+	psWlsMsg->u8Command = (uint8)E_APP_CMD_CHK_STATUS;
+	// CRC16編集
+	psWlsMsg->u16CRC = u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE);
 	// 送信
-	if (bWirelessTx(sDevInfo.u32DeviceID, FALSE, (uint8*)&sWlsMsg, TX_REC_SIZE) == FALSE) {
+	if (bWirelessTxCommit(psWlsMsg) == FALSE) {
 		// メッセージ表示
 		vLCDdrawing("Cmd Err ", "Transmit");
-		iEEPROMWriteLog(E_MSG_CD_TX_ERR, &sWlsMsg);
+		iEEPROMWriteLog(E_MSG_CD_TX_ERR, psWlsMsg);
 		// リモートデバイス選択へ
 		vEvt_InitEvtMap();
 		return;
@@ -685,8 +721,13 @@ PUBLIC void vEvent_Exec_AuthCmd_3(uint32 u32EvtTimeMs) {
 	//==========================================================================
 	// 電文編集
 	tsAuthRemoteDevInfo* psRmtDevInfo = &sAppTxRxTrns.sRemoteInfo;
-	tsWirelessMsg* psWlsMsg = &sAppTxRxTrns.sTxMsg;
-	memset(psWlsMsg, 0x00, sizeof(tsWirelessMsg));
+	tsWirelessMsg* psWlsMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+	if (psWlsMsg == NULL) {
+		vLCDdrawing("Cmd Err!", "Transmit");
+		// リモートデバイス選択へ
+		vEvt_InitEvtMap();
+		return;
+	}
 	psWlsMsg->u32DstAddr = psRmtDevInfo->u32DeviceID;		// 宛先アドレス
 	psWlsMsg->u8Command  = (uint8)sAppTxRxTrns.eCommand;	// コマンド
 	psWlsMsg->u32SyncVal = sAppTxRxTrns.u32OneTimeVal;		// ワンタイム乱数
@@ -695,15 +736,13 @@ PUBLIC void vEvent_Exec_AuthCmd_3(uint32 u32EvtTimeMs) {
 	// 認証トークンに認証ハッシュを編集
 	memcpy(psWlsMsg->u8AuthToken, psRmtDevInfo->u8AuthHash, APP_AUTH_TOKEN_SIZE);
 	// FILLERに乱数を設定
-	vValUtil_setU8RandArray(&psWlsMsg->u8UpdAuthStCnt, 47);
+	vValUtil_setU8RandArray(&psWlsMsg->u8UpdAuthStCnt, 43);
 	// 暗号化領域の暗号化
-	tsAES_state sAES_state =
-			vAES_newCBCState(AES_KEY_LEN_256, sAppTxRxTrns.u8OneTimeTkn, sAppTxRxTrns.u8OneTimeTkn);
-	vAES_encrypt(&sAES_state, &psWlsMsg->u8AuthStCnt, 80);
-	// CRC8編集
-	psWlsMsg->u8CRC = u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE);
+	vWirelessEncrypt(psWlsMsg, sAppTxRxTrns.u8OneTimeTkn);
+	// CRC16編集
+	psWlsMsg->u16CRC = u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE);
 	// 送信
-	if (bWirelessTx(sDevInfo.u32DeviceID, FALSE, (uint8*)psWlsMsg, TX_REC_SIZE) == FALSE) {
+	if (bWirelessTxCommit(psWlsMsg) == FALSE) {
 		vLCDdrawing("Cmd Err!", "Transmit");
 		iEEPROMWriteLog(E_MSG_CD_TX_AUTH_CMD_ERR, psWlsMsg);
 		// リモートデバイス選択へ
@@ -825,6 +864,8 @@ PUBLIC void vEvent_Exec_AuthCmd_5(uint32 u32EvtTimeMs) {
 	psRmtDevInfo->u8SndStretching = psWlsMsg->u8UpdAuthStCnt;
 	memcpy(psRmtDevInfo->u8AuthHash, psWlsMsg->u8UpdAuthToken, APP_AUTH_TOKEN_SIZE);
 	vValUtil_masking(psRmtDevInfo->u8SyncToken, sAppTxRxTrns.u8OneTimeTkn, APP_AUTH_TOKEN_SIZE);
+	// セッション開始（以降の連続コマンドはストレッチングなしで実行）
+	vAuth_beginSession(&sSessionInfo, psRmtDevInfo->u32DeviceID, sAppTxRxTrns.u8OneTimeTkn, psRmtDevInfo->u8SyncToken);
 	// 認証情報を書き込み
 	if (iEEPROMWriteRemoteInfo(psRmtDevInfo) < 0) {
 		// エラーメッセージ表示
@@ -834,6 +875,177 @@ PUBLIC void vEvent_Exec_AuthCmd_5(uint32 u32EvtTimeMs) {
 		vEvt_InitEvtMap();
 		return;
 	}
+	// 往復時間の集計
+	vEvt_RecordRtt(E_APP_RTT_AUTH);
+
+	//==========================================================================
+	// メッセージ表示
+	//==========================================================================
+	// ステータス情報を表示
+	char cMsgLine0[LCD_BUFF_COL_SIZE + 1];
+	char cMsgLine1[LCD_BUFF_COL_SIZE + 1];
+	sprintf(cMsgLine0, "%04d%02d%02d", psWlsMsg->u16Year % 10000, psWlsMsg->u8Month, psWlsMsg->u8Day);
+	sprintf(cMsgLine1, "%02d:%02d %02X", psWlsMsg->u8Hour, psWlsMsg->u8Minute, psWlsMsg->u8StatusMap);
+	vLCDdrawing(cMsgLine0, cMsgLine1);
+	// イベントマップの初期化
+	vEvt_InitEvtMap();
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvent_Exec_SesCmd_0
+ *
+ * DESCRIPTION:セッションコマンド（ステップ０）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 通常認証の成功後、有効期間内の連続コマンドはストレッチングを行わずに
+ * セッションキーによるトークン生成と暗号化のみで送信する。
+ ******************************************************************************/
+PUBLIC void vEvent_Exec_SesCmd_0(uint32 u32EvtTimeMs) {
+#ifdef DEBUG
+	vfPrintf(&sSerStream, "MS:%08d vEvent_Exec_SesCmd_0\n", u32TickCount_ms);
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
+	//==========================================================================
+	// 初期処理
+	//==========================================================================
+	// イベントマップ設定
+	sAppEventMap.eEvtBtn_0    = 0x00;
+	sAppEventMap.eEvtBtn_1    = 0x00;
+	sAppEventMap.eEvtBtn_2    = 0x00;
+	sAppEventMap.eEvtBtn_3    = 0x00;
+	sAppEventMap.eEvtComplete = E_EVENT_EXEC_SES_CMD_1;
+	sAppEventMap.eEvtTimeout  = E_EVENT_RX_TIMEOUT;
+	// セッションカウンタ更新
+	sSessionInfo.u32Counter++;
+	sSessionInfo.u8RemainCnt--;
+
+	//==========================================================================
+	// セッションコマンド送信処理
+	//==========================================================================
+	// 電文編集
+	tsAuthRemoteDevInfo* psRmtDevInfo = &sAppTxRxTrns.sRemoteInfo;
+	tsWirelessMsg* psWlsMsg = psWirelessTxAlloc(sDevInfo.u32DeviceID, FALSE);
+	if (psWlsMsg == NULL) {
+		vLCDdrawing("Cmd Err!", "Transmit");
+		// リモートデバイス選択へ
+		vEvt_InitEvtMap();
+		return;
+	}
+	sWirelessInfo.u32TgtAddr = psRmtDevInfo->u32DeviceID;
+	psWlsMsg->u32DstAddr = psRmtDevInfo->u32DeviceID;								// 宛先アドレス
+	psWlsMsg->u8Command  = (uint8)(sAppTxRxTrns.eCommand | E_APP_CMD_SESSION);	// コマンド
+	psWlsMsg->u32SyncVal = sSessionInfo.u32Counter;								// セッションカウンタ
+	// 認証トークンにセッショントークンを編集
+	vAuth_editSessionTkn(psWlsMsg->u8AuthToken, &sSessionInfo,
+			psWlsMsg->u32DstAddr, psWlsMsg->u32SyncVal, psWlsMsg->u8Command);
+	// FILLERに乱数を設定
+	vValUtil_setU8RandArray(&psWlsMsg->u8UpdAuthStCnt, 43);
+	// 返信の復号化にも利用する為、セッションキーをワンタイムトークンとして保持
+	memcpy(sAppTxRxTrns.u8OneTimeTkn, sSessionInfo.u8SessionKey, APP_AUTH_TOKEN_SIZE);
+	// 暗号化領域の暗号化
+	vWirelessEncrypt(psWlsMsg, sAppTxRxTrns.u8OneTimeTkn);
+	// CRC16編集
+	psWlsMsg->u16CRC = u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE);
+	// 送信
+	if (bWirelessTxCommit(psWlsMsg) == FALSE) {
+		vLCDdrawing("Cmd Err!", "Transmit");
+		iEEPROMWriteLog(E_MSG_CD_TX_AUTH_CMD_ERR, psWlsMsg);
+		// リモートデバイス選択へ
+		vEvt_InitEvtMap();
+		return;
+	}
+	// 受信待ち設定
+	vWirelessRxEnabled(psRmtDevInfo->u32DeviceID, &sAppTxRxTrns.sRxMsg);
+	// タイムアウトタスク登録
+	sAppTxRxTrns.iTimeoutEvtID = iEntryScheduleEvt(E_EVENT_RX_TIMEOUT, 0, RX_TIMEOUT_S, FALSE);
+
+	//==========================================================================
+	// メッセージ表示
+	//==========================================================================
+	vLCDdrawing("Exec Cmd", "........");
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvent_Exec_SesCmd_1
+ *
+ * DESCRIPTION:セッションコマンド（ステップ１）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32         u32EvtTimeMs    R   イベント発生時刻
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 相手側でセッションが無効な場合にはNACKが返信されるので、通常認証で再実行する。
+ * セッションを破棄するのはセッションキーで認証できたNACKを受信した場合と、
+ * セッションキーで復号化できた返信のトークンが一致しない場合のみとし、
+ * 偽装されたNACKや返信によってセッションが切断されない様にする。
+ ******************************************************************************/
+PUBLIC void vEvent_Exec_SesCmd_1(uint32 u32EvtTimeMs) {
+#ifdef DEBUG
+	vfPrintf(&sSerStream, "MS:%08d vEvent_Exec_SesCmd_1\n", u32TickCount_ms);
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
+	//==========================================================================
+	// 初期処理
+	//==========================================================================
+	// タイムアウトタスクキャンセル
+	bCancelScheduleEvt(sAppTxRxTrns.iTimeoutEvtID);
+	// イベントマップ設定
+	sAppEventMap.eEvtComplete = 0x00;
+	sAppEventMap.eEvtTimeout  = 0x00;
+
+	//==========================================================================
+	// レスポンスデータチェック
+	//==========================================================================
+	tsAuthRemoteDevInfo* psRmtDevInfo = &sAppTxRxTrns.sRemoteInfo;
+	tsWirelessMsg* psWlsMsg = &sAppTxRxTrns.sRxMsg;
+	// セッション無効判定
+	if (psWlsMsg->u8Command == E_APP_CMD_NACK) {
+		if (bEvt_SessionNackChk(psWlsMsg)) {
+			// 認証済みのNACKなのでセッション破棄
+			vAuth_clearSession(&sSessionInfo);
+		} else {
+			// 未認証のNACKなのでセッションを維持したまま今回のみ通常認証で実行
+			sAppTxRxTrns.bSkipSession = TRUE;
+		}
+		// 通常認証を遅延実行（ダブルタップ返信により誤受信しない為）
+		iEntryScheduleEvt(E_EVENT_EXEC_AUTH_CMD_0, 0, 100, FALSE);
+		return;
+	}
+	// デフォルトチェック（暗号化領域の復号化）
+	if (bEvt_DefaultMsgChk(psWlsMsg, E_APP_CMD_AUTH_ACK, psRmtDevInfo) == FALSE) {
+		// 偽装の可能性があるのでセッションは維持
+		// リモートデバイス選択へ
+		vEvt_InitEvtMap();
+		return;
+	}
+
+	//==========================================================================
+	// 認証処理
+	//==========================================================================
+	// セッショントークンの検証
+	uint8 u8SesTkn[APP_AUTH_TOKEN_SIZE];
+	vAuth_editSessionTkn(u8SesTkn, &sSessionInfo, sDevInfo.u32DeviceID, sSessionInfo.u32Counter, E_APP_CMD_AUTH_ACK);
+	if (psWlsMsg->u32SyncVal != sSessionInfo.u32Counter ||
+			memcmp(psWlsMsg->u8AuthToken, u8SesTkn, APP_AUTH_TOKEN_SIZE) != 0) {
+		vAuth_clearSession(&sSessionInfo);
+		// エラーメッセージ表示
+		vLCDdrawing("Cmd Err!", "Auth Err ");
+		iEEPROMWriteLog(E_MSG_CD_RX_AUTH_TKN_ERR, psWlsMsg);
+		// リモートデバイス選択へ
+		vEvt_InitEvtMap();
+		return;
+	}
+	// 往復時間の集計
+	vEvt_RecordRtt(E_APP_RTT_SESSION);
 
 	//==========================================================================
 	// メッセージ表示
@@ -868,6 +1080,8 @@ PUBLIC void vEvent_RxTimeout(uint32 u32EvtTimeMs) {
 	vWirelessRxDisabled(sDevInfo.u32DeviceID);
 	// タイムアウトタスクを初期化
 	sAppTxRxTrns.iTimeoutEvtID = -1;
+	// 相手側とカウンタがずれている可能性があるので次回は通常認証で実行
+	vAuth_clearSession(&sSessionInfo);
 	// イベントマップの初期化
 	vEvt_InitEvtMap();
 
@@ -944,9 +1158,7 @@ PRIVATE bool_t bEvt_DefaultMsgChk(tsWirelessMsg* psWlsMsg, teAppCommand eCmd, ts
 	// レスポンスデータチェック
 	//----------------------------------------------------------------------
 	// CRCチェック
-	uint8 u8WkCRC = psWlsMsg->u8CRC;
-	psWlsMsg->u8CRC = 0;
-	if (u8CCITT8((uint8*)psWlsMsg, TX_REC_SIZE) != u8WkCRC) {
+	if (u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE) != psWlsMsg->u16CRC) {
 		vLCDdrawing("ExecErr ", "CRC Chk ");
 		iEEPROMWriteLog(E_MSG_CD_RX_CRC_ERR, psWlsMsg);
 		return FALSE;
@@ -960,11 +1172,13 @@ PRIVATE bool_t bEvt_DefaultMsgChk(tsWirelessMsg* psWlsMsg, teAppCommand eCmd, ts
 		iEEPROMWriteLog(E_MSG_CD_RX_CMD_ERR, psWlsMsg);
 		return FALSE;
 	}
-	// 受信メッセージの暗号化された領域を復号化
+	// 受信メッセージの暗号化された領域を復号化（認証タグの検証）
 	if (psWlsMsg->u8Command == E_APP_CMD_AUTH_ACK) {
-		tsAES_state sAES_state =
-				vAES_newCBCState(AES_KEY_LEN_256, sAppTxRxTrns.u8OneTimeTkn, sAppTxRxTrns.u8OneTimeTkn);
-		vAES_decrypt(&sAES_state, &psWlsMsg->u8AuthStCnt, 80);
+		if (bWirelessDecrypt(psWlsMsg, sAppTxRxTrns.u8OneTimeTkn) == FALSE) {
+			vLCDdrawing("ExecErr ", "MIC Chk ");
+			iEEPROMWriteLog(E_MSG_CD_RX_MIC_ERR, psWlsMsg);
+			return FALSE;
+		}
 	}
 	// 日付チェック
 	if (bValUtil_validDate(psWlsMsg->u16Year, psWlsMsg->u8Month, psWlsMsg->u8Day) == FALSE) {
@@ -988,6 +1202,62 @@ PRIVATE bool_t bEvt_DefaultMsgChk(tsWirelessMsg* psWlsMsg, teAppCommand eCmd, ts
 	return TRUE;
 }
 
+/*******************************************************************************
+ *
+ * NAME: bEvt_SessionNackChk
+ *
+ * DESCRIPTION:セッションNACKの認証
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   tsWirelessMsg*     psWlsMsg        RW  受信メッセージ
+ *
+ * RETURNS:
+ *   TRUE:セッションキーで認証できたNACK
+ *
+ * NOTES:
+ * 認証なしのNACKは誰でも送信できるので、セッションキーによる復号化と
+ * 現在のカウンタに対するNACKのセッショントークンが一致した場合のみ認証済みとする。
+ ******************************************************************************/
+PRIVATE bool_t bEvt_SessionNackChk(tsWirelessMsg* psWlsMsg) {
+	// CRCチェック
+	if (u16CRC16_calc((uint8*)psWlsMsg, TX_CRC_SIZE) != psWlsMsg->u16CRC) {
+		return FALSE;
+	}
+	// 受信メッセージの暗号化された領域を復号化（認証タグの検証）
+	if (bWirelessDecrypt(psWlsMsg, sSessionInfo.u8SessionKey) == FALSE) {
+		return FALSE;
+	}
+	// セッショントークンの検証
+	uint8 u8SesTkn[APP_AUTH_TOKEN_SIZE];
+	vAuth_editSessionTkn(u8SesTkn, &sSessionInfo, sDevInfo.u32DeviceID, sSessionInfo.u32Counter, E_APP_CMD_NACK);
+	return (psWlsMsg->u32SyncVal == sSessionInfo.u32Counter &&
+			memcmp(psWlsMsg->u8AuthToken, u8SesTkn, APP_AUTH_TOKEN_SIZE) == 0);
+}
+
+/*******************************************************************************
+ *
+ * NAME: vEvt_RecordRtt
+ *
+ * DESCRIPTION:往復時間の集計
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   teAppRttType       eType           R   計測種別
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+PRIVATE void vEvt_RecordRtt(teAppRttType eType) {
+	uint32 u32RttUsec = (uint32)(u64TimerUtil_readUsec() - sAppTxRxTrns.u64BeginUsec);
+	sAppRttStats.u16Cnt[eType]++;
+	sAppRttStats.u32LastUsec[eType] = u32RttUsec;
+	sAppRttStats.u64TotalUsec[eType] += u32RttUsec;
+#ifdef DEBUG
+	vfPrintf(&sSerStream, "MS:%08d RTT Type:%d Usec:%08d Auth:%03d Ses:%03d\n", u32TickCount_ms,
+			eType, u32RttUsec, sAppRttStats.u16Cnt[E_APP_RTT_AUTH], sAppRttStats.u16Cnt[E_APP_RTT_SESSION]);
+	SERIAL_vFlush(sSerStream.u8Device);
+#endif
+}
+
 /******************************************************************************/
 /***        END OF FILE                                                     ***/
 /******************************************************************************/
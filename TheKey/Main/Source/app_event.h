@@ -9,6 +9,10 @@
  *
  * CHANGE HISTORY:
  * 2018/01/21 06:10:00 認証時の通信データをAES暗号化
+ * 2026/10/18 11:00:00 認証後の連続コマンドをセッションで実行、往復時間を計測
+ * 2026/10/18 13:00:00 受信電文の改竄検知エラーを追加
+ * 2026/10/19 11:00:00 未認証のNACK受信時にセッションを維持したまま通常認証を行う為のフラグを追加
+ * 2026/10/19 16:00:00 送信メッセージは送信スロット内で編集する為、送受信トランザクション情報から削除
  *
  * LAST MODIFIED BY:
  *
@@ -64,6 +68,8 @@ typedef enum {
 	E_EVENT_EXEC_AUTH_CMD_3,
 	E_EVENT_EXEC_AUTH_CMD_4,
 	E_EVENT_EXEC_AUTH_CMD_5,
+	E_EVENT_EXEC_SES_CMD_0,
+	E_EVENT_EXEC_SES_CMD_1,
 	E_EVENT_RX_TIMEOUT,
 	E_EVENT_HASH_ST
 } teAppEvent;
@@ -74,6 +80,10 @@ typedef enum {
 	E_APP_CMD_UNLOCK     = (0x01),	// 送受信コマンド：開錠要求
 	E_APP_CMD_LOCK       = (0x02),	// 送受信コマンド：施錠要求
 	E_APP_CMD_ALERT      = (0x03),	// 送受信コマンド：警戒施錠要求
+	E_APP_CMD_SESSION    = (0x10),	// 送受信コマンド：セッションコマンド（各要求コマンドとの論理和）
+	E_APP_CMD_SES_UNLOCK = (0x11),	// 送受信コマンド：セッション開錠要求
+	E_APP_CMD_SES_LOCK   = (0x12),	// 送受信コマンド：セッション施錠要求
+	E_APP_CMD_SES_ALERT  = (0x13),	// 送受信コマンド：セッション警戒施錠要求
 	E_APP_CMD_MST_UNLOCK = (0x7F),	// 送受信コマンド：マスター開錠要求
 	E_APP_CMD_ACK        = (0x80),	// 送受信コマンド：認証なしACK
 	E_APP_CMD_AUTH_ACK   = (0x81),	// 送受信コマンド：認証ありACK
@@ -100,7 +110,8 @@ typedef enum {
 	E_MSG_CD_SERVO_ERR,						// サーボ位置エラー
 	E_MSG_CD_OPEN_SENS_ERR,					// 開放センサーエラー
 	E_MSG_CD_BUTTON_ERR,					// ボタン操作エラー
-	E_MSG_CD_IR_SENS_ERR					// 赤外線センサーエラー
+	E_MSG_CD_IR_SENS_ERR,					// 赤外線センサーエラー
+	E_MSG_CD_RX_MIC_ERR						// 受信データ改竄検知エラー
 } teAppMsgCD;
 
 // 構造体：アプリケーションイベントマップ
@@ -123,9 +134,24 @@ typedef struct {
 	uint32 u32OneTimeVal;						// ワンタイム乱数
 	uint8 u8OneTimeTkn[APP_AUTH_TOKEN_SIZE];	// ワンタイムトークン
 	tsWirelessMsg sRxMsg;						// 受信メッセージ
-	tsWirelessMsg sTxMsg;						// 送信メッセージ
+	uint64 u64BeginUsec;						// コマンド開始時刻（マイクロ秒）
+	bool_t bSkipSession;						// 次回コマンドのセッション利用抑止
 } tsAppTxRxTrnsInfo;
 
+// 往復時間の計測種別
+typedef enum {
+	E_APP_RTT_AUTH = 0,							// 通常認証
+	E_APP_RTT_SESSION,							// セッション
+	E_APP_RTT_TYPE_CNT							// 計測種別の種類数
+} teAppRttType;
+
+// 構造体：往復時間の統計情報
+typedef struct {
+	uint16 u16Cnt[E_APP_RTT_TYPE_CNT];			// 計測種別毎の件数
+	uint32 u32LastUsec[E_APP_RTT_TYPE_CNT];		// 計測種別毎の直近の往復時間（マイクロ秒）
+	uint64 u64TotalUsec[E_APP_RTT_TYPE_CNT];	// 計測種別毎の往復時間の合計（マイクロ秒）
+} tsAppRttStats;
+
 /******************************************************************************/
 /***        Local Function Prototypes                                       ***/
 /******************************************************************************/
@@ -139,6 +165,8 @@ PUBLIC tsAppEventMap sAppEventMap;
 PUBLIC tsAppTxRxTrnsInfo sAppTxRxTrns;
 /** ハッシュ値生成情報 */
 PUBLIC tsAuthHashGenState sHashGenInfo;
+/** 往復時間の統計情報 */
+PUBLIC tsAppRttStats sAppRttStats;
 
 ///** デバッグステータス値 */
 #ifdef DEBUG
@@ -183,6 +211,10 @@ PUBLIC void vEvent_Exec_AuthCmd_3(uint32 u32EvtTimeMs);
 PUBLIC void vEvent_Exec_AuthCmd_4(uint32 u32EvtTimeMs);
 // イベント処理：認証コマンド（ステップ５）
 PUBLIC void vEvent_Exec_AuthCmd_5(uint32 u32EvtTimeMs);
+// イベント処理：セッションコマンド（ステップ０）
+PUBLIC void vEvent_Exec_SesCmd_0(uint32 u32EvtTimeMs);
+// イベント処理：セッションコマンド（ステップ１）
+PUBLIC void vEvent_Exec_SesCmd_1(uint32 u32EvtTimeMs);
 // イベント処理：無線パケット受信タイムアウト
 PUBLIC void vEvent_RxTimeout(uint32 u32EvtTimeMs);
 // 拡張ハッシュストレッチング処理イベントプロセス
@@ -9,6 +9,13 @@
  *
  * CHANGE HISTORY:
  * 2018/01/24 19:04:00 認証時の通信内容をAES暗号化する事で保護
+ * 2026/10/18 13:00:00 電文の暗号化をAES-CCMによる認証付き暗号に変更
+ * 2026/10/19 02:00:00 イベントログをログ構造化リングに変更（インデックス更新無しで周回上書き）
+ * 2026/10/19 03:00:00 イベントログを時刻の差分とメッセージコード等の３バイトの圧縮形式で記録
+ * 2026/10/19 04:00:00 デバイス情報とインデックス情報とリモートデバイス情報の更新をジャーナル経由のトランザクションに変更
+ * 2026/10/19 05:00:00 リモートデバイス情報の読み込みを先読みストリーム経由に変更
+ * 2026/10/19 09:00:00 LCD描画を表示内容との差分のみの送信に変更
+ * 2026/10/19 16:00:00 送信パケットをスロットプールで保持し、電文をスロット内で直接編集
  *
  * LAST MODIFIED BY:
  *
@@ -54,6 +61,7 @@
 #include "st7032i.h"
 #include "ds3231.h"
 #include "eeprom.h"
+#include "aes.h"
 #include "app_io.h"
 
 /******************************************************************************/
@@ -73,6 +81,8 @@ PRIVATE int iEEPROMIndexOfRemoteInfo(uint32 u32DeviceID);
 PRIVATE bool_t bEEPROMReadIndexInfo();
 // EEPROM書き込み（インデックス情報）
 PRIVATE bool_t bEEPROMWriteIndexInfo();
+// EEPROMの選択とジャーナルの復元
+PRIVATE bool_t bEEPROMSelect();
 
 /******************************************************************************/
 /***        Exported Variables                                              ***/
@@ -87,6 +97,12 @@ PRIVATE int const BTN_ADC_VAL[] = {915, 688, 395, 256};
 PRIVATE int const BTN_NO[] = {BTN_NO_0, BTN_NO_1, BTN_NO_2, BTN_NO_3};
 /** インデックス情報 */
 PRIVATE tsAppIOIndexInfo sIndexInfo;
+/** リモートデバイス情報の先読みバッファ */
+PRIVATE uint8 u8RemoteStreamBuff[sizeof(tsAuthRemoteDevInfo) * REMOTE_DEV_STREAM_CNT];
+/** 送信スロット */
+PRIVATE tsTxSlot sTxBuffer[TX_BUFFER_SIZE];
+/** 最後に確保した送信スロットのインデックス */
+PRIVATE uint8 u8TxIdx = 0;
 
 
 /******************************************************************************/
@@ -224,6 +240,13 @@ PUBLIC void vEEPROMInit() {
 	sEEPROM_status.b2ByteAddrFlg = TRUE;
 	sEEPROM_status.u8PageSize    = EEPROM_PAGE_SIZE_64B;
 	sEEPROM_status.u64LastWrite  = u64TimerUtil_readUsec();
+	// イベントログリングの初期化（初回の書き込み時に復元）
+	vLogRing_init(&sAppIOEventLogRing, TOP_ADDR_EVENT_LOG, EVT_LOG_BLOCK_CNT, EVT_LOG_BLOCK_SIZE, EVT_LOG_PAYLOAD_SIZE, FALSE);
+	// ジャーナル付きキーバリューストアの初期化（初回のアクセス時に復元）
+	vKVJournal_init(&sAppIOJournal, TOP_ADDR_JOURNAL, EEPROM_PAGE_SIZE_64B);
+	// リモートデバイス情報の先読みストリームの初期化
+	vEEPROM_streamInit(&sAppIORemoteStream, TOP_ADDR_REMOTE_DEV, sizeof(tsAuthRemoteDevInfo),
+		MAX_REMOTE_DEV_CNT, u8RemoteStreamBuff, sizeof(u8RemoteStreamBuff));
 }
 
 /*******************************************************************************
@@ -240,7 +263,9 @@ PUBLIC void vEEPROMInit() {
  ******************************************************************************/
 PUBLIC bool_t bEEPROMReadDevInfo() {
 	// I2C EEPROM Read
-	bEEPROM_deviceSelect(&sEEPROM_status);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
 	return bEEPROM_readData(TOP_ADDR_DEV, sizeof(tsAuthDeviceInfo), (uint8*)&sDevInfo);
 }
 
@@ -265,8 +290,13 @@ PUBLIC bool_t bEEPROMWriteDevInfo(uint8 u8StatusMapMask) {
 	// ステータスマップの更新
 	sDevInfo.u8StatusMap = sDevInfo.u8StatusMap | u8StatusMapMask;
 	// I2C EEPROM Write
-	bEEPROM_deviceSelect(&sEEPROM_status);
-	return bEEPROM_writeData(TOP_ADDR_DEV, sizeof(tsAuthDeviceInfo), (uint8*)&sDevInfo);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
+	// ジャーナル経由で書き込み（内容が変わらないページは書き込まない）
+	vKVJournal_begin(&sAppIOJournal);
+	bKVJournal_put(&sAppIOJournal, TOP_ADDR_DEV, (uint8*)&sDevInfo, sizeof(tsAuthDeviceInfo));
+	return bKVJournal_commit(&sAppIOJournal);
 }
 
 
@@ -304,12 +334,9 @@ PUBLIC int iEEPROMReadRemoteInfo(tsAuthRemoteDevInfo* psRemoteInfo, uint8 u8Idx,
 	if (u8Cnt >= MAX_REMOTE_DEV_CNT) {
 		return -2;
 	}
-	// I2C EEPROM Read
-	uint32 u32Size = sizeof(tsAuthRemoteDevInfo);
-	uint32 u32Addr = TOP_ADDR_REMOTE_DEV + u32Size * u8ChkIdx;
-	// I2C EEPROM Read
+	// I2C EEPROM Read（探索方向の後続レコードをまとめて先読み）
 	bEEPROM_deviceSelect(&sEEPROM_status);
-	if (!bEEPROM_readData(u32Addr, u32Size, (uint8*)psRemoteInfo)) {
+	if (!bEEPROM_streamRead(&sAppIORemoteStream, u8ChkIdx, bForwardFlg, (uint8*)psRemoteInfo)) {
 		return -3;
 	}
 	return u8ChkIdx;
@@ -331,7 +358,8 @@ PUBLIC int iEEPROMReadRemoteInfo(tsAuthRemoteDevInfo* psRemoteInfo, uint8 u8Idx,
 PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
 	// レコードインデックス探索
 	int iIdx = iEEPROMIndexOfRemoteInfo(psRemoteInfo->u32DeviceID);
-	if (iIdx < 0) {
+	bool_t bNewFlg = (iIdx < 0);
+	if (bNewFlg) {
 		// 空き領域の有無判定
 		if (sIndexInfo.u32RemoteDevMap == 0xFFFFFFFF) {
 			return -1;
@@ -342,17 +370,22 @@ PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
 				break;
 			}
 		}
-		// インデックス情報更新
+	}
+	// インデックス情報とレコードを１トランザクションで書き込み
+	vKVJournal_begin(&sAppIOJournal);
+	if (bNewFlg) {
 		sIndexInfo.u32RemoteDevMap = sIndexInfo.u32RemoteDevMap | (0x00000001 << iIdx);
-		if (!bEEPROMWriteIndexInfo(&sIndexInfo)) {
-			return -2;
-		}
+		bKVJournal_put(&sAppIOJournal, TOP_ADDR_INDEX, (uint8 *)&sIndexInfo, sizeof(tsAppIOIndexInfo));
 	}
-	// I2C EEPROM Write
 	uint32 u32Size = sizeof(tsAuthRemoteDevInfo);
 	uint32 u32Addr = TOP_ADDR_REMOTE_DEV + u32Size * iIdx;
-	bEEPROM_deviceSelect(&sEEPROM_status);
-	if (!bEEPROM_writeData(u32Addr, u32Size, (uint8 *)psRemoteInfo)) {
+	bKVJournal_put(&sAppIOJournal, u32Addr, (uint8 *)psRemoteInfo, u32Size);
+	// I2C EEPROM Write
+	if (!bEEPROMSelect() || !bKVJournal_commit(&sAppIOJournal)) {
+		if (bNewFlg) {
+			sIndexInfo.u32RemoteDevMap = sIndexInfo.u32RemoteDevMap & ~(0x00000001 << iIdx);
+			return -2;
+		}
 		return -3;
 	}
 	return iIdx;
@@ -369,39 +402,35 @@ PUBLIC int iEEPROMWriteRemoteInfo(tsAuthRemoteDevInfo *psRemoteInfo) {
  *   tsWirelessMsg*      psMsg             R   受信メッセージ
  *
  * RETURNS:
- *   int 書き込みレコードインデックス、読み込めない場合はマイナス値
+ *   int 書き込みエントリ位置、エラー時はマイナス値（-1:ログリング復元エラー、-2:書き込みエラー）
  *
+ * NOTES:
+ * ログが一杯の場合は最も古いログを上書きする
+ * インデックス情報は更新しない
  ******************************************************************************/
 PUBLIC int iEEPROMWriteLog(uint16 u16MsgCd, tsWirelessMsg* psMsg) {
-	// ログ数の判定
-	if (sIndexInfo.u8EventLogCnt >= MAX_EVT_LOG_CNT) {
+	// イベントログリングの復元（未復元の場合のみ）
+	bEEPROM_deviceSelect(&sEEPROM_status);
+	if (sAppIOEventLogRing.bValid == FALSE && bLogRing_recover(&sAppIOEventLogRing) == FALSE) {
 		return -1;
 	}
-	// インデックス情報更新
-	sIndexInfo.u8EventLogCnt++;
-	if (bEEPROMWriteIndexInfo(&sIndexInfo) == FALSE) {
-		return -2;
+	// イベントログ編集（日時は基準年からの経過秒数、無効な日時は直前のログと同じ時刻とする）
+	uint32 u32Key = LOG_RING_KEY_NONE;
+	uint8 u8LogData[EVT_LOG_PAYLOAD_SIZE];
+	u8LogData[0] = (uint8)u16MsgCd | EVT_LOG_TIME_INVALID;	// メッセージコード
+	u8LogData[1] = psMsg->u8Command;	// コマンド
+	u8LogData[2] = psMsg->u8StatusMap;	// ステータスマップ
+	if (bValUtil_validDate(psMsg->u16Year, psMsg->u8Month, psMsg->u8Day) &&
+		bValUtil_validTime(psMsg->u8Hour, psMsg->u8Minute, psMsg->u8Second) &&
+		psMsg->u16Year >= VAL_UTIL_EPOCH_YEAR && psMsg->u16Year < VAL_UTIL_EPOCH_YEAR_LIMIT) {
+		u32Key = u32ValUtil_datetimeToSec(psMsg->u16Year, psMsg->u8Month, psMsg->u8Day,
+										  psMsg->u8Hour, psMsg->u8Minute, psMsg->u8Second);
+		u8LogData[0] = (uint8)u16MsgCd;
 	}
-	// イベントログ編集
-	tsAppIOEventLog sAppIOEventLog;
-	memset(&sAppIOEventLog, 0x00, sizeof(tsAppIOEventLog));
-	sAppIOEventLog.u8SeqNo   = sIndexInfo.u8EventLogCnt - 1;// シーケンス番号
-	sAppIOEventLog.u16MsgCd  = u16MsgCd;					// メッセージコード
-	sAppIOEventLog.u8Command = psMsg->u8Command;			// コマンド
-	sAppIOEventLog.u8StatusMap = psMsg->u8StatusMap;		// ステータスマップ
-	sAppIOEventLog.u16Year   = psMsg->u16Year;				// イベント発生日（年）
-	sAppIOEventLog.u8Month   = psMsg->u8Month;				// イベント発生日（月）
-	sAppIOEventLog.u8Day     = psMsg->u8Day;				// イベント発生日（日）
-	sAppIOEventLog.u8Hour    = psMsg->u8Hour;				// イベント発生時刻（時）
-	sAppIOEventLog.u8Minute  = psMsg->u8Minute;				// イベント発生時刻（分）
-	sAppIOEventLog.u8Second  = psMsg->u8Second;				// イベント発生時刻（秒）
 	// I2C EEPROM Write
-	int iIdx = sIndexInfo.u8EventLogCnt - 1;
-	uint32 u32Size = sizeof(tsAppIOEventLog);
-	uint32 u32Addr = TOP_ADDR_EVENT_LOG + u32Size * iIdx;
-	bEEPROM_deviceSelect(&sEEPROM_status);
-	if (bEEPROM_writeData(u32Addr, u32Size, (uint8*)&sAppIOEventLog) == FALSE) {
-		return -3;
+	int iIdx = iLogRing_append(&sAppIOEventLogRing, u32Key, u8LogData, EVT_LOG_PAYLOAD_SIZE);
+	if (iIdx < 0) {
+		return -2;
 	}
 	return iIdx;
 }
@@ -449,36 +478,24 @@ PUBLIC void vLCDdrawing(char* pcMsg0, char* pcMsg1) {
 	// LCD描画
 #ifndef DEBUG
 	bST7032i_deviceSelect(&sLCDstate);
-	bST7032i_setCursor(0, 0);
-	bST7032i_writeString(pcMsg0);
-	bST7032i_setCursor(1, 0);
-	bST7032i_writeString(pcMsg1);
+	bST7032i_drawRow(0, pcMsg0);
+	bST7032i_drawRow(1, pcMsg1);
 #else
 	if (!bST7032i_deviceSelect(&sLCDstate)) {
 		vfPrintf(&sSerStream, "1:Err.");
 		SERIAL_vFlush(sSerStream.u8Device);
 		return;
 	}
-	if (!bST7032i_setCursor(0, 0)) {
+	if (!bST7032i_drawRow(0, pcMsg0)) {
 		vfPrintf(&sSerStream, "2:Err.");
 		SERIAL_vFlush(sSerStream.u8Device);
 		return;
 	}
-	if (!bST7032i_writeString(pcMsg0)) {
+	if (!bST7032i_drawRow(1, pcMsg1)) {
 		vfPrintf(&sSerStream, "3:Err.");
 		SERIAL_vFlush(sSerStream.u8Device);
 		return;
 	}
-	if (!bST7032i_setCursor(1, 0)) {
-		vfPrintf(&sSerStream, "4:Err.");
-		SERIAL_vFlush(sSerStream.u8Device);
-		return;
-	}
-	if (!bST7032i_writeString(pcMsg1)) {
-		vfPrintf(&sSerStream, "5:Err.");
-		SERIAL_vFlush(sSerStream.u8Device);
-		return;
-	}
 #endif
 }
 
@@ -599,41 +616,167 @@ PUBLIC bool_t bWirelessRxPkt(tsRxDataApp *psRx) {
 	return TRUE;
 }
 
-/****************************************************************************
+/*******************************************************************************
  *
- * NAME: bWirelessTx
+ * NAME: psWirelessTxAlloc
  *
- * DESCRIPTION:無線通信によるメッセージ送信処理
+ * DESCRIPTION:送信スロットの確保
  *
- * PARAMETERS:          Name        RW  Usage
- *     uint32           u32SrcAddr  R   送信元アドレス
- *     bool_t           bEncryption R   暗号化有無
- *     uint8*           u8Data      R   送信データ
- *     uint8            u8Len       R   送信データ長
+ * PARAMETERS:          Name           RW  Usage
+ *     uint32           u32SrcAddr     R   送信元アドレス
+ *     bool_t           bEncryption    R   暗号化有無
+ *
+ * RETURNS:
+ *     tsWirelessMsg*   編集対象の電文（ゼロクリア済み）、空きスロットが無い場合はNULL
+ *
+ * NOTES:
+ * 呼び出し元は返却された電文を直接編集し、暗号化とCRC編集の後に
+ * bWirelessTxCommitで送信する事。スロットは前回確保したスロットの次から順に
+ * 確保するので、送信済みの電文は次に同じスロットを確保するまで参照できる。
+ ******************************************************************************/
+PUBLIC tsWirelessMsg* psWirelessTxAlloc(uint32 u32SrcAddr, bool_t bEncryption) {
+	// 空きスロットの探索（前回確保したスロットの次から）
+	tsTxSlot* psSlot;
+	uint8 u8Cnt;
+	uint8 u8Idx = u8TxIdx;
+	for (u8Cnt = 0; u8Cnt < TX_BUFFER_SIZE; u8Cnt++) {
+		u8Idx = (u8Idx + 1) % TX_BUFFER_SIZE;
+		if (sTxBuffer[u8Idx].eStatus == E_TX_SLOT_FREE) {
+			break;
+		}
+	}
+	if (u8Cnt >= TX_BUFFER_SIZE) {
+		return NULL;
+	}
+	u8TxIdx = u8Idx;
+	psSlot = &sTxBuffer[u8Idx];
+	psSlot->eStatus = E_TX_SLOT_BUILD;
+	// 送信パケットのヘッダ編集（フレームシーケンスは送信時に編集）
+	tsTxDataApp* psTx = &psSlot->sTx;
+	psTx->u32SrcAddr = u32SrcAddr;					// 送信元アドレス
+	psTx->u32DstAddr = TOCONET_MAC_ADDR_BROADCAST;	// 送信先アドレス（ブロードキャスト）
+	psTx->bAckReq = FALSE;							// ACK返信有無
+	psTx->u8Retry = 0;								// 再送回数（なし）
+	psTx->u16RetryDur = 0;							// 再送間隔（ミリ秒単位）
+	psTx->u16DelayMin = 4;							// 遅延送信時間（最小）
+	psTx->u16DelayMax = 16;							// 遅延送信時間（最大）
+	psTx->bSecurePacket = bEncryption;				// 暗号化設定
+	psTx->u8Cmd = TOCONET_PACKET_CMD_APP_DATA;		// パケットタイプ
+	psTx->u8Len = TX_REC_SIZE;						// 送信データ長
+	// 電文のクリア
+	memset(&psSlot->sMsg, 0x00, sizeof(tsWirelessMsg));
+	return &psSlot->sMsg;
+}
+
+/*******************************************************************************
+ *
+ * NAME: bWirelessTxCommit
+ *
+ * DESCRIPTION:送信電文の確定と送信
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          R   psWirelessTxAllocで確保した電文
  *
  * RETURNS:
  *     TRUE:送信成功
  *
- ****************************************************************************/
-PUBLIC bool_t bWirelessTx(uint32 u32SrcAddr, bool_t bEncryption, uint8* u8Data, uint8 u8Len) {
-	// 送信パケット編集
-	tsTxDataApp sTx;
-	memset(&sTx, 0x00, sizeof(tsTxDataApp));
-	sTx.u32SrcAddr = u32SrcAddr;					// 送信元アドレス
-	sTx.u32DstAddr = TOCONET_MAC_ADDR_BROADCAST;	// 送信先アドレス（ブロードキャスト）
-	sTx.u8Seq = sWirelessInfo.u8TxSeq++;			// フレームシーケンス
-	sTx.u8CbId = sTx.u8Seq;							// コールバックID（フレームシーケンス指定）
-	sTx.bAckReq = FALSE;							// ACK返信有無
-	sTx.u8Retry = 0;								// 再送回数（なし）
-	sTx.u16RetryDur = 0;							// 再送間隔（ミリ秒単位）
-	sTx.u16DelayMin = 4;							// 遅延送信時間（最小）
-	sTx.u16DelayMax = 16;							// 遅延送信時間（最大）
-	sTx.bSecurePacket = bEncryption;				// 暗号化設定
-	sTx.u8Cmd = TOCONET_PACKET_CMD_APP_DATA;		// パケットタイプ
-	sTx.u8Len = u8Len;								// 送信データ長
-	memcpy(sTx.auData, u8Data, sTx.u8Len);			// 送信データ
+ * NOTES:
+ * 電文を送信パケットのペイロードに1度だけ複写して送信要求する。
+ * スロットは送信完了（vWirelessTxComplete）まで再利用しない。
+ ******************************************************************************/
+PUBLIC bool_t bWirelessTxCommit(tsWirelessMsg* psMsg) {
+	tsTxSlot* psSlot;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < TX_BUFFER_SIZE; u8Idx++) {
+		psSlot = &sTxBuffer[u8Idx];
+		if (&psSlot->sMsg == psMsg && psSlot->eStatus == E_TX_SLOT_BUILD) {
+			break;
+		}
+	}
+	if (u8Idx >= TX_BUFFER_SIZE) {
+		return FALSE;
+	}
+	// フレームシーケンスとペイロードの編集
+	psSlot->sTx.u8Seq  = ++sWirelessInfo.u8TxSeq;					// フレームシーケンス
+	psSlot->sTx.u8CbId = psSlot->sTx.u8Seq;			// コールバックID（フレームシーケンス指定）
+	memcpy(psSlot->sTx.auData, psMsg, TX_REC_SIZE);	// 送信データ
 	// 送信処理
-	return ToCoNet_bMacTxReq(&sTx);
+	if (ToCoNet_bMacTxReq(&psSlot->sTx) == FALSE) {
+		psSlot->eStatus = E_TX_SLOT_FREE;
+		return FALSE;
+	}
+	psSlot->eStatus = E_TX_SLOT_IN_FLIGHT;
+	return TRUE;
+}
+
+/*******************************************************************************
+ *
+ * NAME: vWirelessTxComplete
+ *
+ * DESCRIPTION:送信スロットの送信完了処理
+ *
+ * PARAMETERS:        Name          RW  Usage
+ *       uint8        u8CbId        R   送信パケットのコールバックID
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 再送は行わないので、送信の成否に関わらずスロットを解放する
+ ******************************************************************************/
+PUBLIC void vWirelessTxComplete(uint8 u8CbId) {
+	tsTxSlot* psSlot;
+	uint8 u8Idx;
+	for (u8Idx = 0; u8Idx < TX_BUFFER_SIZE; u8Idx++) {
+		psSlot = &sTxBuffer[u8Idx];
+		if (psSlot->eStatus == E_TX_SLOT_IN_FLIGHT && psSlot->sTx.u8CbId == u8CbId) {
+			psSlot->eStatus = E_TX_SLOT_FREE;
+			return;
+		}
+	}
+}
+
+/*******************************************************************************
+ *
+ * NAME: vWirelessEncrypt
+ *
+ * DESCRIPTION:電文の暗号化処理（AES-CCMによる認証付き暗号）
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          RW  送信電文
+ *     uint8*           pu8Key         R   暗号鍵（256bit）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 宛先アドレス・同期乱数・コマンドをノンスとして改竄検知の対象に含め、
+ * 暗号化領域の暗号化と認証タグの生成を1回の走査で行う
+ ******************************************************************************/
+PUBLIC void vWirelessEncrypt(tsWirelessMsg* psMsg, uint8* pu8Key) {
+	tsAES_state sAES_state = vAES_newCCMState(AES_KEY_LEN_256, pu8Key);
+	vAES_encryptCCM(&sAES_state, (uint8*)psMsg, TX_NONCE_SIZE, NULL, 0,
+			&psMsg->u8AuthStCnt, TX_ENC_SIZE, psMsg->u8MIC, TX_MIC_SIZE);
+}
+
+/*******************************************************************************
+ *
+ * NAME: bWirelessDecrypt
+ *
+ * DESCRIPTION:電文の復号化処理（AES-CCMによる認証付き暗号）
+ *
+ * PARAMETERS:          Name           RW  Usage
+ *     tsWirelessMsg*   psMsg          RW  受信電文
+ *     uint8*           pu8Key         R   暗号鍵（256bit）
+ *
+ * RETURNS:
+ *     TRUE:認証タグ一致
+ *
+ * NOTES:
+ * 認証タグが一致しない場合には暗号化領域はゼロクリアされる
+ ******************************************************************************/
+PUBLIC bool_t bWirelessDecrypt(tsWirelessMsg* psMsg, uint8* pu8Key) {
+	tsAES_state sAES_state = vAES_newCCMState(AES_KEY_LEN_256, pu8Key);
+	return bAES_decryptCCM(&sAES_state, (uint8*)psMsg, TX_NONCE_SIZE, NULL, 0,
+			&psMsg->u8AuthStCnt, TX_ENC_SIZE, psMsg->u8MIC, TX_MIC_SIZE);
 }
 
 /******************************************************************************/
@@ -691,7 +834,9 @@ PRIVATE int iEEPROMIndexOfRemoteInfo(uint32 u32DeviceID) {
  ******************************************************************************/
 PRIVATE bool_t bEEPROMReadIndexInfo() {
 	// I2C EEPROM Read
-	bEEPROM_deviceSelect(&sEEPROM_status);
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
 	bool_t bResult = bEEPROM_readData(TOP_ADDR_INDEX, sizeof(tsAppIOIndexInfo), (uint8*)&sIndexInfo);
 	// レコード有効チェック
 	if (sIndexInfo.u8EnableCheck != 0xAA) {
@@ -718,8 +863,35 @@ PRIVATE bool_t bEEPROMReadIndexInfo() {
  ******************************************************************************/
 PRIVATE bool_t bEEPROMWriteIndexInfo() {
 	// I2C EEPROM Write
+	if (!bEEPROMSelect()) {
+		return FALSE;
+	}
+	// ジャーナル経由で書き込み（内容が変わらないページは書き込まない）
+	vKVJournal_begin(&sAppIOJournal);
+	bKVJournal_put(&sAppIOJournal, TOP_ADDR_INDEX, (uint8 *)&sIndexInfo, sizeof(tsAppIOIndexInfo));
+	return bKVJournal_commit(&sAppIOJournal);
+}
+
+/*******************************************************************************
+ *
+ * NAME: bEEPROMSelect
+ *
+ * DESCRIPTION:EEPROMの選択とジャーナルの復元
+ *
+ * PARAMETERS:          Name         RW  Usage
+ *
+ * RETURNS:
+ *   bool_t TRUE:選択成功
+ *
+ * NOTES:
+ * 電源断等で反映途中のジャーナルが残っている場合は、初回のアクセス時に反映する
+ ******************************************************************************/
+PRIVATE bool_t bEEPROMSelect() {
 	bEEPROM_deviceSelect(&sEEPROM_status);
-	return bEEPROM_writeData(TOP_ADDR_INDEX, sizeof(tsAppIOIndexInfo), (uint8 *)&sIndexInfo);
+	if (sAppIOJournal.bValid == FALSE && !bKVJournal_recover(&sAppIOJournal)) {
+		return FALSE;
+	}
+	return TRUE;
 }
 
 /******************************************************************************/
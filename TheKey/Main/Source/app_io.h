@@ -9,6 +9,13 @@
  *
  * CHANGE HISTORY:
  * 2018/01/20 21:47:00 認証時の通信内容をAES暗号化する事で保護
+ * 2026/10/18 13:00:00 電文の暗号化をAES-CCMによる認証付き暗号に変更
+ * 2026/10/18 18:00:00 CRCチェックをCRC-16に変更（FILLER02を廃止してレコード長は維持）
+ * 2026/10/19 02:00:00 イベントログリングを追加し、イベント履歴のレイアウトを12バイトに詰める
+ * 2026/10/19 03:00:00 イベント履歴をイベントログリングから展開する形式に変更
+ * 2026/10/19 04:00:00 ジャーナル付きキーバリューストアを追加
+ * 2026/10/19 05:00:00 リモートデバイス情報の先読みストリームを追加
+ * 2026/10/19 16:00:00 送信パケットのスロットプールを追加
  *
  * LAST MODIFIED BY:
  *
@@ -33,6 +40,8 @@ extern "C" {
 #include "st7032i.h"
 #include "ds3231.h"
 #include "eeprom.h"
+#include "log_ring.h"
+#include "kv_journal.h"
 
 /******************************************************************************/
 /***        Macro Definitions                                               ***/
@@ -61,6 +70,23 @@ extern "C" {
 // 送信レコードサイズ
 #define TX_REC_SIZE                  (90)
 
+// CRC算出領域サイズ（宛先アドレス～認証タグ）
+#define TX_CRC_SIZE                  (88)
+
+// 暗号化領域サイズ（認証ストレッチング回数～ステータスマップ）
+#define TX_ENC_SIZE                  (75)
+
+// 認証タグサイズ
+#define TX_MIC_SIZE                  (4)
+
+// ノンスサイズ（宛先アドレス、同期乱数、コマンド）
+#define TX_NONCE_SIZE                (9)
+
+// 送信スロット数
+#ifndef TX_BUFFER_SIZE
+	#define TX_BUFFER_SIZE           (2)
+#endif
+
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/
@@ -76,23 +102,22 @@ typedef struct {
 typedef struct {
 	uint8 u8EnableCheck;				// 有効チェック（レコード有効時は0xAA）
 	uint32 u32RemoteDevMap;				// リモートデバイス領域マップ
-	uint8 u8EventLogCnt;				// イベント履歴数
+	uint8 u8EventLogCnt;				// イベント履歴数（未使用、イベントログリングで管理）
 	uint8 u8Filler[2];					// 余白
 } tsAppIOIndexInfo;
 
-// 構造体：イベント履歴
+// 構造体：イベント履歴（EEPROMにはイベントログリングの圧縮形式で記録）
 typedef struct {
-	uint8 u8SeqNo;						// シーケンス番号
 	uint16 u16MsgCd;					// メッセージコード
+	uint16 u16Year;						// イベント発生日（年）
+	uint8 u8SeqNo;						// シーケンス番号
 	uint8 u8Command;					// コマンド
 	uint8 u8StatusMap;					// ステータスマップ
-	uint16 u16Year;						// イベント発生日（年）
 	uint8 u8Month;						// イベント発生日（月）
 	uint8 u8Day;						// イベント発生日（日）
 	uint8 u8Hour;						// イベント発生時刻（時）
 	uint8 u8Minute;						// イベント発生時刻（分）
 	uint8 u8Second;						// イベント発生時刻（秒）
-	uint8 u8Filler[4];					// 余白
 } tsAppIOEventLog;
 
 // 構造体：無線送受信メッセージ
@@ -127,10 +152,10 @@ typedef struct {
 	uint8 u8Second;
 	// ステータスマップ
 	uint8 u8StatusMap;
-	// FILLER02
-	uint8 u8Filler02[5];
-	// CRCチェック
-	uint8 u8CRC;
+	// 認証タグ
+	uint8 u8MIC[TX_MIC_SIZE];
+	// CRCチェック（CRC-16、宛先アドレス～認証タグ）
+	uint16 u16CRC;
 } tsWirelessMsg;
 
 // 構造体：送受信データ
@@ -141,6 +166,23 @@ typedef struct {
 	tsWirelessMsg sMsg;
 } tsRxTxInfo;
 
+// 列挙型：送信スロット状態
+typedef enum {
+	E_TX_SLOT_FREE = 0,		// 未使用
+	E_TX_SLOT_BUILD,		// 電文編集中
+	E_TX_SLOT_IN_FLIGHT		// 送信中（送信完了待ち）
+} teTxSlotStatus;
+
+// 構造体：送信スロット
+typedef struct {
+	// スロット状態
+	teTxSlotStatus eStatus;
+	// 送信パケット（ヘッダはスロット確保時、ペイロードは確定時に編集）
+	tsTxDataApp sTx;
+	// 送信電文（auDataは32bit境界に配置されないので、電文は境界を揃えて保持）
+	tsWirelessMsg sMsg;
+} tsTxSlot;
+
 // 構造体：無線通信情報
 typedef struct {
 	// 通信対象アドレス
@@ -178,6 +220,12 @@ PUBLIC tsEEPROM_status sEEPROM_status;
 PUBLIC tsAuthDeviceInfo sDevInfo;
 /** イベント履歴情報 */
 PUBLIC tsAppIOEventLog sEventLog;
+/** イベントログリング */
+PUBLIC tsLogRing sAppIOEventLogRing;
+/** ジャーナル付きキーバリューストア */
+PUBLIC tsKVJournal sAppIOJournal;
+/** リモートデバイス情報の先読みストリーム */
+PUBLIC tsEEPROM_stream sAppIORemoteStream;
 /** I2C LCD制御情報 */
 PUBLIC ST7032i_state sLCDstate;
 
@@ -218,8 +266,16 @@ PUBLIC void vWirelessRxEnabled(uint32 u32SrcAddr, tsWirelessMsg* psWlsMsg);
 PUBLIC void vWirelessRxDisabled();
 // 受信処理
 PUBLIC bool_t bWirelessRxPkt(tsRxDataApp *psRx);
-// メッセージ送信
-PUBLIC bool_t bWirelessTx(uint32 u32SrcAddr, bool_t bEncryption, uint8* u8Data, uint8 u8Len);
+// 送信スロットの確保
+PUBLIC tsWirelessMsg* psWirelessTxAlloc(uint32 u32SrcAddr, bool_t bEncryption);
+// 送信電文の確定と送信
+PUBLIC bool_t bWirelessTxCommit(tsWirelessMsg* psMsg);
+// 送信スロットの送信完了処理
+PUBLIC void vWirelessTxComplete(uint8 u8CbId);
+// 電文の暗号化処理
+PUBLIC void vWirelessEncrypt(tsWirelessMsg* psMsg, uint8* pu8Key);
+// 電文の復号化処理
+PUBLIC bool_t bWirelessDecrypt(tsWirelessMsg* psMsg, uint8* pu8Key);
 
 /******************************************************************************/
 /***        Local Functions                                                 ***/
@@ -8,6 +8,8 @@
  * DESCRIPTION:アプリケーション特有のイベント処理を実装
  *
  * CHANGE HISTORY:
+ * 2026/10/18 19:00:00 I2Cの非同期処理を初期化
+ * 2026/10/19 16:00:00 送信完了時に送信スロットを解放
  *
  * LAST MODIFIED BY:
  *
@@ -214,6 +216,8 @@ PUBLIC void cbToCoNet_vTxEvent(uint8 u8CbId, uint8 u8Status) {
 	vfPrintf(&sSerStream, "MS:%08d cbToCoNet_vTxEvent\n", u32TickCount_ms);
 	SERIAL_vFlush(sSerStream.u8Device);
 #endif
+	// 送信スロットの解放
+	vWirelessTxComplete(u8CbId);
 }
 
 /****************************************************************************
@@ -281,6 +285,8 @@ PUBLIC void vEventStartup(tsEvent *psEv, teEvent eEvent, uint32 u32EvArg) {
 		SERIAL_vFlush(sSerStream.u8Device);
 	}
 #endif
+	// I2Cの非同期処理の初期化（割り込み処理の登録）
+	vI2C_initAsync();
 	// 外部入出力ドライバや制御タスクの初期処理
 	vAppIOInit();
 	// イベント処理の登録